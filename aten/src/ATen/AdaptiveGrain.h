@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace at {
+
+// Note [Adaptive grain size]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// internal::GRAIN_SIZE is one number for every kernel: ~32k elements per
+// task. At roughly a nanosecond per element that is a sensible task, but
+// transcendentals like erf or pow cost an order of magnitude more per
+// element -- tasks balloon and big machines leave cores idle on exactly
+// the ops that need them -- while trivial kernels would rather take
+// coarser tasks. A GrainSizeTracker measures the per-element cost of its
+// kernel family as an exponential moving average and sizes tasks to a
+// fixed time budget. Measurement happens inside each worker chunk, so the
+// recorded cost is serial cost even when the op runs parallel, and the
+// two clock reads per chunk are amortized over at least a thousand
+// elements. Setting ATEN_GRAIN_SIZE_<NAME> (name uppercased) pins the
+// grain for a family and bypasses measurement entirely.
+
+class GrainSizeTracker {
+ public:
+  explicit GrainSizeTracker(const char* name) : femto_per_elem_(0) {
+    std::string env_name = "ATEN_GRAIN_SIZE_";
+    for (const char* p = name; *p != '\0'; p++) {
+      env_name += (*p >= 'a' && *p <= 'z') ? static_cast<char>(*p - 'a' + 'A')
+                                           : *p;
+    }
+    const char* pin = getenv(env_name.c_str());
+    pinned_ = pin != nullptr ? strtoll(pin, nullptr, 10) : 0;
+  }
+
+  // The grain size to pass to parallel_for: the pinned value if set, the
+  // global default until a cost has been observed, and the task time
+  // budget divided by the measured per-element cost afterwards.
+  int64_t grain() const {
+    if (pinned_ > 0) {
+      return pinned_;
+    }
+    const int64_t cost = femto_per_elem_.load(std::memory_order_relaxed);
+    if (cost <= 0) {
+      return internal::GRAIN_SIZE;
+    }
+    const int64_t grain = kTaskBudgetNs * 1000000 / cost;
+    return std::min(kMaxGrain, std::max(kMinGrain, grain));
+  }
+
+  // Records one timed chunk of `numel` elements. Updates race benignly:
+  // a lost update only drops a sample from the moving average.
+  void record(int64_t numel, int64_t ns) {
+    if (pinned_ > 0 || numel <= 0 || ns <= 0) {
+      return;
+    }
+    const int64_t sample = ns * 1000000 / numel;
+    const int64_t prev = femto_per_elem_.load(std::memory_order_relaxed);
+    femto_per_elem_.store(
+        prev == 0 ? sample : (prev * 7 + sample) / 8,
+        std::memory_order_relaxed);
+  }
+
+ private:
+  // ~100us of work per task; GRAIN_SIZE at a nanosecond per element lands
+  // in the same ballpark.
+  static constexpr int64_t kTaskBudgetNs = 100000;
+  static constexpr int64_t kMinGrain = 1024;
+  static constexpr int64_t kMaxGrain = int64_t(1) << 22;
+
+  int64_t pinned_;
+  // Measured per-element cost in femtoseconds (1ns/elem == 1e6).
+  std::atomic<int64_t> femto_per_elem_;
+};
+
+// parallel_for with the tracker's grain, timing each worker chunk to feed
+// the tracker's cost estimate.
+template <typename F>
+inline void adaptive_parallel_for(
+    GrainSizeTracker& tracker,
+    int64_t begin,
+    int64_t end,
+    const F& f) {
+  at::parallel_for(
+      begin, end, tracker.grain(), [&](int64_t chunk_begin, int64_t chunk_end) {
+        const auto start = std::chrono::steady_clock::now();
+        f(chunk_begin, chunk_end);
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        tracker.record(chunk_end - chunk_begin, ns);
+      });
+}
+
+} // namespace at
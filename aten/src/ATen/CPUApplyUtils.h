@@ -332,6 +332,53 @@ apply_op(int64_t numel, int64_t offset, const Op& op, Args... iters) {
 }
 
 
+/*
+  Note [CPU apply fast paths]
+  ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  The generic apply_op above advances every iterator element by element,
+  which defeats auto-vectorization. The overwhelmingly common cases are much
+  simpler, so CPU_tensor_apply* dispatches them to specialized loops before
+  falling back:
+
+  1. All operands contiguous: a flat loop over bare pointers, which the
+     compiler unrolls and vectorizes like any hand-written kernel.
+  2. All operands collapse to a single strided dimension (e.g. a transposed
+     matrix, or an expanded column): a flat loop with one constant stride
+     per operand, vectorizable with gathers where profitable.
+
+  This gives the long tail of ops still routed through these templates SIMD
+  for free until they are ported to TensorIterator.
+*/
+
+inline bool _all_contiguous(ArrayRef<Tensor> tensors) {
+  for (auto& t : tensors) {
+    if (!t.is_contiguous()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Op, typename... scalars>
+inline void apply_contiguous_op(int64_t numel, const Op& op, scalars*... data) {
+  for (int64_t i = 0; i < numel; ++i) {
+    op(data[i]...);
+  }
+}
+
+// Runs the flat single-strided loop if every iterator collapsed to one
+// dimension; returns false (leaving the iterators untouched) otherwise.
+template <typename Op, typename... Args>
+inline bool apply_op_collapsed_1d(int64_t numel, const Op& op, Args&... iters) {
+  if (max_dim(iters...) != 1) {
+    return false;
+  }
+  for (int64_t i = 0; i < numel; ++i) {
+    op(iters.data_[i * iters.strides_[0]]...);
+  }
+  return true;
+}
+
 inline void apply_kernel(){};
 
 // TODO: Deal elegantly with 0-dim tensors. iters.strides_ of 0-dim
@@ -408,12 +455,15 @@ template <typename scalar1, typename Op>
 inline void CPU_tensor_apply1(Tensor tensor1, const Op op) {
   if (!_apply_preamble({tensor1}))
     return;
+  if (_all_contiguous({tensor1})) {
+    apply_contiguous_op(tensor1.numel(), op, tensor1.data<scalar1>());
+    return;
+  }
   if (tensor1.ndimension() < 8) {
-    apply_op(
-        tensor1.numel(),
-        0,
-        op,
-        strided_tensor_iter_fixed<scalar1, 8>(tensor1, true));
+    strided_tensor_iter_fixed<scalar1, 8> iter1(tensor1, true);
+    if (apply_op_collapsed_1d(tensor1.numel(), op, iter1))
+      return;
+    apply_op(tensor1.numel(), 0, op, std::move(iter1));
   } else {
     apply_op(tensor1.numel(), 0, op, strided_tensor_iter<scalar1>(tensor1));
   }
@@ -423,13 +473,17 @@ template <typename scalar1, typename scalar2, typename Op>
 inline void CPU_tensor_apply2(Tensor tensor1, Tensor tensor2, const Op op) {
   if (!_apply_preamble({tensor1, tensor2}))
     return;
+  if (_all_contiguous({tensor1, tensor2})) {
+    apply_contiguous_op(
+        tensor1.numel(), op, tensor1.data<scalar1>(), tensor2.data<scalar2>());
+    return;
+  }
   if (_max_dim_tensors({tensor1, tensor2}) <= 8) {
-    apply_op(
-        tensor1.numel(),
-        0,
-        op,
-        strided_tensor_iter_fixed<scalar1, 8>(tensor1),
-        strided_tensor_iter_fixed<scalar2, 8>(tensor2));
+    strided_tensor_iter_fixed<scalar1, 8> iter1(tensor1);
+    strided_tensor_iter_fixed<scalar2, 8> iter2(tensor2);
+    if (apply_op_collapsed_1d(tensor1.numel(), op, iter1, iter2))
+      return;
+    apply_op(tensor1.numel(), 0, op, std::move(iter1), std::move(iter2));
   } else {
     apply_op(
         tensor1.numel(),
@@ -445,14 +499,28 @@ inline void
 CPU_tensor_apply3(Tensor tensor1, Tensor tensor2, Tensor tensor3, const Op op) {
   if (!_apply_preamble({tensor1, tensor2, tensor3}))
     return;
+  if (_all_contiguous({tensor1, tensor2, tensor3})) {
+    apply_contiguous_op(
+        tensor1.numel(),
+        op,
+        tensor1.data<scalar1>(),
+        tensor2.data<scalar2>(),
+        tensor3.data<scalar3>());
+    return;
+  }
   if (_max_dim_tensors({tensor1, tensor2, tensor3}) <= 8) {
+    strided_tensor_iter_fixed<scalar1, 8> iter1(tensor1);
+    strided_tensor_iter_fixed<scalar2, 8> iter2(tensor2);
+    strided_tensor_iter_fixed<scalar3, 8> iter3(tensor3);
+    if (apply_op_collapsed_1d(tensor1.numel(), op, iter1, iter2, iter3))
+      return;
     apply_op(
         tensor1.numel(),
         0,
         op,
-        strided_tensor_iter_fixed<scalar1, 8>(tensor1),
-        strided_tensor_iter_fixed<scalar2, 8>(tensor2),
-        strided_tensor_iter_fixed<scalar3, 8>(tensor3));
+        std::move(iter1),
+        std::move(iter2),
+        std::move(iter3));
   } else {
     apply_op(
         tensor1.numel(),
@@ -478,15 +546,31 @@ inline void CPU_tensor_apply4(
     const Op op) {
   if (!_apply_preamble({tensor1, tensor2, tensor3, tensor4}))
     return;
+  if (_all_contiguous({tensor1, tensor2, tensor3, tensor4})) {
+    apply_contiguous_op(
+        tensor1.numel(),
+        op,
+        tensor1.data<scalar1>(),
+        tensor2.data<scalar2>(),
+        tensor3.data<scalar3>(),
+        tensor4.data<scalar4>());
+    return;
+  }
   if (_max_dim_tensors({tensor1, tensor2, tensor3, tensor4}) <= 8) {
+    strided_tensor_iter_fixed<scalar1, 8> iter1(tensor1);
+    strided_tensor_iter_fixed<scalar2, 8> iter2(tensor2);
+    strided_tensor_iter_fixed<scalar3, 8> iter3(tensor3);
+    strided_tensor_iter_fixed<scalar4, 8> iter4(tensor4);
+    if (apply_op_collapsed_1d(tensor1.numel(), op, iter1, iter2, iter3, iter4))
+      return;
     apply_op(
         tensor1.numel(),
         0,
         op,
-        strided_tensor_iter_fixed<scalar1, 8>(tensor1),
-        strided_tensor_iter_fixed<scalar2, 8>(tensor2),
-        strided_tensor_iter_fixed<scalar3, 8>(tensor3),
-        strided_tensor_iter_fixed<scalar4, 8>(tensor4));
+        std::move(iter1),
+        std::move(iter2),
+        std::move(iter3),
+        std::move(iter4));
   } else {
     apply_op(
         tensor1.numel(),
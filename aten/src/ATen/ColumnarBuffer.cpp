@@ -0,0 +1,135 @@
+#include <ATen/ColumnarBuffer.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/TensorUtils.h>
+
+#include <atomic>
+#include <limits>
+#include <utility>
+
+namespace at {
+
+namespace {
+
+// Owner node shared by every column of a batch. The last column's storage
+// to be released runs the caller's deleter.
+struct SharedBatchOwner {
+  std::atomic<int64_t> refcount;
+  void* ctx;
+  DeleterFnPtr deleter;
+};
+
+void releaseSharedBatchOwner(void* p) {
+  auto* owner = static_cast<SharedBatchOwner*>(p);
+  if (--owner->refcount == 0) {
+    if (owner->deleter) {
+      owner->deleter(owner->ctx);
+    }
+    delete owner;
+  }
+}
+
+Tensor wrapBuffer(
+    void* data,
+    IntArrayRef sizes,
+    IntArrayRef strides,
+    DataPtr data_ptr,
+    const TensorOptions& options) {
+  auto storage = Storage(
+      options.dtype(),
+      detail::computeStorageSize(sizes, strides),
+      std::move(data_ptr),
+      /*allocator=*/nullptr,
+      /*resizable=*/false);
+  return at::empty({0}, options).set_(storage, 0, sizes, strides);
+}
+
+} // namespace
+
+Tensor from_external_buffer(
+    void* data,
+    IntArrayRef sizes,
+    IntArrayRef strides,
+    void* deleter_ctx,
+    DeleterFnPtr deleter,
+    const TensorOptions& options) {
+  return wrapBuffer(
+      data,
+      sizes,
+      strides,
+      DataPtr(data, deleter_ctx, deleter, options.device()),
+      options);
+}
+
+std::vector<Tensor> from_external_columns(
+    ArrayRef<ExternalColumn> columns,
+    void* deleter_ctx,
+    DeleterFnPtr deleter,
+    Device device,
+    bool materialize_nulls) {
+  AT_CHECK(
+      !columns.empty(), "from_external_columns: expected at least one column");
+  auto* owner = new SharedBatchOwner{
+      {static_cast<int64_t>(columns.size())}, deleter_ctx, deleter};
+  std::vector<Tensor> tensors;
+  tensors.reserve(columns.size());
+  for (const auto& column : columns) {
+    AT_CHECK(
+        column.data != nullptr,
+        "from_external_columns: column ",
+        tensors.size(),
+        " has a null data pointer");
+    const auto strides = column.strides.empty()
+        ? detail::defaultStrides(column.sizes)
+        : column.strides;
+    const auto options = at::device(device).dtype(column.dtype);
+    Tensor tensor = wrapBuffer(
+        column.data,
+        column.sizes,
+        strides,
+        DataPtr(column.data, owner, &releaseSharedBatchOwner, device),
+        options);
+    if (materialize_nulls && column.null_mask != nullptr) {
+      materialize_null_mask_(tensor, column.null_mask, column.null_mask_offset);
+    }
+    tensors.push_back(std::move(tensor));
+  }
+  return tensors;
+}
+
+void materialize_null_mask_(
+    Tensor& column,
+    const uint8_t* null_mask,
+    int64_t bit_offset) {
+  AT_CHECK(
+      null_mask != nullptr, "materialize_null_mask_: null_mask is required");
+  AT_CHECK(
+      column.device().is_cpu(),
+      "materialize_null_mask_: only CPU columns are supported, got ",
+      column.device());
+  AT_CHECK(
+      column.is_contiguous(),
+      "materialize_null_mask_: column must be contiguous");
+  AT_CHECK(
+      at::isFloatingType(column.scalar_type()),
+      "materialize_null_mask_: only floating-point columns can represent "
+      "nulls as NaN, got ",
+      column.scalar_type());
+  const int64_t numel = column.numel();
+  AT_DISPATCH_FLOATING_TYPES(
+      column.scalar_type(), "materialize_null_mask_", [&] {
+        scalar_t* data = column.data<scalar_t>();
+        const scalar_t nan = std::numeric_limits<scalar_t>::quiet_NaN();
+        at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            const int64_t bit = bit_offset + i;
+            if (!(null_mask[bit >> 3] & (uint8_t(1) << (bit & 7)))) {
+              data[i] = nan;
+            }
+          }
+        });
+      });
+}
+
+} // namespace at
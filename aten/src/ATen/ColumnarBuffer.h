@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Tensor.h>
+
+#include <vector>
+
+// Zero-copy ingestion of caller-owned columnar buffers (e.g. Arrow arrays
+// or record batches). Unlike at::from_blob, which wraps the deleter in a
+// std::function and heap-allocates a context per tensor, these entry points
+// pass a raw (context, deleter) pair straight into the DataPtr, and a whole
+// batch of columns can share a single owner whose deleter fires once, when
+// the last wrapping tensor is released.
+
+namespace at {
+
+// One column of a caller-owned batch.
+struct ExternalColumn {
+  void* data = nullptr;
+  std::vector<int64_t> sizes;
+  // Empty means contiguous (row-major over sizes), in elements.
+  std::vector<int64_t> strides;
+  ScalarType dtype = ScalarType::Float;
+  // Optional Arrow-style validity bitmap: LSB-first, a set bit means the
+  // slot is valid. Only consulted when from_external_columns is asked to
+  // materialize nulls.
+  const uint8_t* null_mask = nullptr;
+  // Bit offset of the column's first element within null_mask (Arrow
+  // slices share their parent's bitmap).
+  int64_t null_mask_offset = 0;
+};
+
+// Wraps a single caller-owned buffer. deleter(deleter_ctx) runs when the
+// tensor's storage is released; either may be null for unowned memory.
+CAFFE2_API Tensor from_external_buffer(
+    void* data,
+    IntArrayRef sizes,
+    IntArrayRef strides,
+    void* deleter_ctx,
+    DeleterFnPtr deleter,
+    const TensorOptions& options = {});
+
+// Wraps every column of a caller-owned batch. The columns share ownership:
+// deleter(deleter_ctx) runs once, after the last of the returned tensors
+// releases its storage. If materialize_nulls is set, floating-point columns
+// with a null_mask have their null slots rewritten to NaN, in place.
+CAFFE2_API std::vector<Tensor> from_external_columns(
+    ArrayRef<ExternalColumn> columns,
+    void* deleter_ctx,
+    DeleterFnPtr deleter,
+    Device device = at::kCPU,
+    bool materialize_nulls = false);
+
+// Rewrites the slots of a contiguous floating-point CPU tensor whose
+// validity bit is clear to NaN, in place. bit_offset is the bit position of
+// the tensor's first element within the bitmap.
+CAFFE2_API void materialize_null_mask_(
+    Tensor& column,
+    const uint8_t* null_mask,
+    int64_t bit_offset = 0);
+
+} // namespace at
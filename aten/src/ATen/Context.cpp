@@ -112,6 +112,56 @@ bool Context::setFlushDenormal(bool on) {
   return at::cpu::set_flush_denormal(on);
 }
 
+// See Note [Backend warmup] in Context.h.
+void Context::registerWarmupHook(std::function<void()> hook) {
+  std::lock_guard<std::mutex> lock(warmup_mutex_);
+  warmup_hooks_.emplace_back(std::move(hook));
+}
+
+void Context::warmup() {
+  // The core lazy initialization is idempotent (call_once), so warming up
+  // more than once is harmless.
+  if (hasCUDA()) {
+    lazyInitCUDA();
+  }
+  if (hasHIP()) {
+    lazyInitHIP();
+  }
+  // Run any hooks that have not run yet, outside the lock so that a hook
+  // may register further hooks (they run on the next warmup() call).
+  while (true) {
+    std::function<void()> hook;
+    {
+      std::lock_guard<std::mutex> lock(warmup_mutex_);
+      if (warmup_hooks_run_ == warmup_hooks_.size()) {
+        break;
+      }
+      hook = warmup_hooks_[warmup_hooks_run_++];
+    }
+    hook();
+  }
+}
+
+void Context::warmupAsync() {
+  std::lock_guard<std::mutex> lock(warmup_mutex_);
+  if (warmup_future_.valid()) {
+    return; // already in flight (or finished and awaiting a wait)
+  }
+  warmup_future_ = std::async(std::launch::async, [this] { warmup(); });
+}
+
+void Context::waitForWarmup() {
+  std::future<void> future;
+  {
+    std::lock_guard<std::mutex> lock(warmup_mutex_);
+    if (!warmup_future_.valid()) {
+      return;
+    }
+    future = std::move(warmup_future_);
+  }
+  future.get();
+}
+
 TypeExtendedInterface& getType(TensorOptions options) {
   return globalContext().getType(
             options.backend(), typeMetaToScalarType(options.dtype()), options.is_variable());
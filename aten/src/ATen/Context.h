@@ -16,9 +16,12 @@
 #include <c10/util/Exception.h>
 #include <c10/core/impl/DeviceGuardImplInterface.h>
 
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
-#include <cstdint>
+#include <vector>
 
 namespace at {
 
@@ -120,6 +123,26 @@ class CAFFE2_API Context {
   }
   bool setFlushDenormal(bool on);
 
+  // Note [Backend warmup]
+  // ~~~~~~~~~~~~~~~~~~~~~
+  // Backend state is initialized lazily, which keeps binary startup cheap
+  // but moves the cost (THC state, cuDNN/cuBLAS handles, allocator pools,
+  // the MKL-DNN engine) inline with the first op that needs it -- for a
+  // serving process, straight into the first request's latency. warmup()
+  // forces the core lazy initialization eagerly and then runs every
+  // registered warmup hook; libraries that own expensive first-call state
+  // register a hook so one warmup() call covers them too. warmupAsync()
+  // runs the same work on a background thread so it can overlap the rest
+  // of process startup; waitForWarmup() joins it (and rethrows anything
+  // the warmup raised) before traffic is admitted.
+  //
+  // Hooks run at most once each, in registration order; a hook registered
+  // after warmup() has already run executes on the next warmup() call.
+  void registerWarmupHook(std::function<void()> hook);
+  void warmup();
+  void warmupAsync();
+  void waitForWarmup();
+
   // NB: This method is *purely* whether or not a user requested
   // that CuDNN was enabled, it doesn't actually say anything about
   // whether or not CuDNN is actually usable.  Use cudnn_is_acceptable
@@ -151,6 +174,10 @@ private:
   std::once_flag thc_init;
   std::once_flag thh_init;
   std::once_flag complex_init_;
+  std::mutex warmup_mutex_;
+  std::vector<std::function<void()>> warmup_hooks_;
+  size_t warmup_hooks_run_ = 0;
+  std::future<void> warmup_future_;
   bool enabled_cudnn = true;
   bool deterministic_cudnn = false;
   bool benchmark_cudnn = false;
@@ -251,6 +278,23 @@ static inline bool hasMKLDNN() {
   return globalContext().hasMKLDNN();
 }
 
+// See Note [Backend warmup].
+static inline void registerWarmupHook(std::function<void()> hook) {
+  globalContext().registerWarmupHook(std::move(hook));
+}
+
+static inline void warmup() {
+  globalContext().warmup();
+}
+
+static inline void warmupAsync() {
+  globalContext().warmupAsync();
+}
+
+static inline void waitForWarmup() {
+  globalContext().waitForWarmup();
+}
+
 static inline void manual_seed(uint64_t seed) {
   globalContext().defaultGenerator(DeviceType::CPU).manualSeed(seed);
   // NB: Sometimes we build with CUDA, but we don't have any GPUs
@@ -11,6 +11,54 @@
     return __VA_ARGS__();                          \
   }
 
+// Note [Selective dtype dispatch]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The dispatch macros below stamp the kernel body once per dtype case, so
+// every AT_DISPATCH_ALL_TYPES site instantiates seven kernels even when a
+// deployment only ever runs one of them. Binary-size-sensitive builds can
+// opt in to selective dispatch by defining AT_SELECTIVE_DTYPE_DISPATCH to
+// the (quoted) path of an allowlist header, typically produced by
+// gen_selective_dispatch.py:
+//
+//   -DAT_SELECTIVE_DTYPE_DISPATCH='"my_dtype_allowlist.h"'
+//
+// The allowlist header defines AT_SELECTIVE_DTYPE_<Name> (with the exact
+// expansion the generator emits) for each ScalarType that should survive;
+// every standard case not on the list is preprocessed away entirely -- no
+// instantiation, no switch case. When a single case survives, the switch
+// degenerates to one comparison and a direct call, which the compiler
+// folds further when the dtype is provable. Dispatching a dtype that was
+// stamped out reports the usual "not implemented" error at runtime.
+//
+// The detection below is the classic second-argument probe: an enabled
+// dtype's macro expands to "0," which shifts a 1 into the second argument
+// slot of AT_DTYPE_PROBE_SECOND; an undefined macro stays a single token
+// and the 0 default is picked instead.
+//
+// The explicit SCALARTYPE arguments of the ..._AND/..._AND2 variants are
+// passed as enum values, not names, so they cannot be filtered here; they
+// remain under the caller's control and are always stamped.
+#if defined(AT_SELECTIVE_DTYPE_DISPATCH)
+#include AT_SELECTIVE_DTYPE_DISPATCH
+#define AT_DTYPE_IS_ENABLED(name) AT_DTYPE_PROBE(AT_SELECTIVE_DTYPE_##name)
+#define AT_DTYPE_PROBE(x) AT_DTYPE_PROBE_(x)
+#define AT_DTYPE_PROBE_(...) AT_DTYPE_PROBE_SECOND(__VA_ARGS__ 1, 0)
+#define AT_DTYPE_PROBE_SECOND(...) AT_DTYPE_PROBE_SECOND_(__VA_ARGS__, )
+#define AT_DTYPE_PROBE_SECOND_(a, b, ...) b
+#else
+#define AT_DTYPE_IS_ENABLED(name) 1
+#endif
+
+#define AT_PRIVATE_CASE(name, type, ...) \
+  AT_PRIVATE_CASE_IMPL(AT_DTYPE_IS_ENABLED(name), name, type, __VA_ARGS__)
+#define AT_PRIVATE_CASE_IMPL(enabled, name, type, ...) \
+  AT_PRIVATE_CASE_IMPL_(enabled, name, type, __VA_ARGS__)
+#define AT_PRIVATE_CASE_IMPL_(enabled, name, type, ...) \
+  AT_PRIVATE_CASE_##enabled(name, type, __VA_ARGS__)
+#define AT_PRIVATE_CASE_1(name, type, ...) \
+  AT_PRIVATE_CASE_TYPE(at::ScalarType::name, type, __VA_ARGS__)
+#define AT_PRIVATE_CASE_0(name, type, ...)
+
 namespace detail {
 
 template <at::ScalarType N>
@@ -70,8 +118,8 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -83,9 +131,23 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Half, at::Half, __VA_ARGS__)      \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Half, at::Half, __VA_ARGS__)                            \
+      default:                                                               \
+        AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
+    }                                                                        \
+  }()
+
+#define AT_DISPATCH_FLOATING_TYPES_AND_BFLOAT16(TYPE, NAME, ...)             \
+  [&] {                                                                      \
+    const auto& the_type = TYPE;                                             \
+    (void)the_type;                                                          \
+    at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
+    switch (_st) {                                                           \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(BFloat16, at::BFloat16, __VA_ARGS__)                    \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -97,15 +159,12 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Half, at::Half, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)  \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)    \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexHalf, std::complex<at::Half>, __VA_ARGS__)  \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Half, at::Half, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(ComplexDouble, std::complex<double>, __VA_ARGS__)       \
+      AT_PRIVATE_CASE(ComplexFloat, std::complex<float>, __VA_ARGS__)         \
+      AT_PRIVATE_CASE(ComplexHalf, std::complex<at::Half>, __VA_ARGS__)       \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -117,11 +176,11 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -134,14 +193,14 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Half, at::Half, __VA_ARGS__)      \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Half, at::Half, __VA_ARGS__)                            \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -153,13 +212,13 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -171,10 +230,8 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)    \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)  \
+      AT_PRIVATE_CASE(ComplexFloat, std::complex<float>, __VA_ARGS__)         \
+      AT_PRIVATE_CASE(ComplexDouble, std::complex<double>, __VA_ARGS__)       \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -186,17 +243,15 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)    \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)  \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(ComplexFloat, std::complex<float>, __VA_ARGS__)         \
+      AT_PRIVATE_CASE(ComplexDouble, std::complex<double>, __VA_ARGS__)       \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'"); \
     }                                                                        \
@@ -209,18 +264,16 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     (void)the_type;                                                          \
     at::ScalarType _st = ::detail::scalar_type(TYPE);                        \
     switch (_st) {                                                           \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)        \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Half, at::Half, __VA_ARGS__)      \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)    \
-      AT_PRIVATE_CASE_TYPE(                                                  \
-          at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)  \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Half, at::Half, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(ComplexFloat, std::complex<float>, __VA_ARGS__)         \
+      AT_PRIVATE_CASE(ComplexDouble, std::complex<double>, __VA_ARGS__)       \
       default:                                                               \
         AT_ERROR(#NAME, " not implemented for '", toString(_st), "'");       \
     }                                                                        \
@@ -229,13 +282,13 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND(SCALARTYPE, TYPE, NAME, ...)                                            \
   [&] {                                                                                                   \
     switch (TYPE) {                                                                                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                    \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                   \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                    \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                   \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE, decltype(::detail::ScalarTypeToCType<SCALARTYPE>::t), __VA_ARGS__) \
       default:                                                                                            \
         AT_ERROR(#NAME, " not implemented for '", toString(TYPE), "'");                                   \
@@ -245,13 +298,13 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND2(SCALARTYPE1, SCALARTYPE2, TYPE, NAME, ...)                               \
   [&] {                                                                                                     \
     switch (TYPE) {                                                                                         \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                     \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE1, decltype(::detail::ScalarTypeToCType<SCALARTYPE1>::t), __VA_ARGS__) \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE2, decltype(::detail::ScalarTypeToCType<SCALARTYPE2>::t), __VA_ARGS__) \
       default:                                                                                              \
@@ -262,19 +315,17 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
 #define AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(SCALARTYPE1, SCALARTYPE2, TYPE, NAME, ...)                    \
   [&] {                                                                                                     \
     switch (TYPE) {                                                                                         \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Byte, uint8_t, __VA_ARGS__)                                      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Char, int8_t, __VA_ARGS__)                                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Double, double, __VA_ARGS__)                                     \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Float, float, __VA_ARGS__)                                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Int, int32_t, __VA_ARGS__)                                       \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Long, int64_t, __VA_ARGS__)                                      \
-      AT_PRIVATE_CASE_TYPE(at::ScalarType::Short, int16_t, __VA_ARGS__)                                     \
+      AT_PRIVATE_CASE(Byte, uint8_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Char, int8_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Double, double, __VA_ARGS__)                            \
+      AT_PRIVATE_CASE(Float, float, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Int, int32_t, __VA_ARGS__)                              \
+      AT_PRIVATE_CASE(Long, int64_t, __VA_ARGS__)                             \
+      AT_PRIVATE_CASE(Short, int16_t, __VA_ARGS__)                            \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE1, decltype(::detail::ScalarTypeToCType<SCALARTYPE1>::t), __VA_ARGS__) \
       AT_PRIVATE_CASE_TYPE(SCALARTYPE2, decltype(::detail::ScalarTypeToCType<SCALARTYPE2>::t), __VA_ARGS__) \
-      AT_PRIVATE_CASE_TYPE(                                                                                 \
-          at::ScalarType::ComplexFloat, std::complex<float>, __VA_ARGS__)                                   \
-      AT_PRIVATE_CASE_TYPE(                                                                                 \
-          at::ScalarType::ComplexDouble, std::complex<double>, __VA_ARGS__)                                 \
+      AT_PRIVATE_CASE(ComplexFloat, std::complex<float>, __VA_ARGS__)         \
+      AT_PRIVATE_CASE(ComplexDouble, std::complex<double>, __VA_ARGS__)       \
       default:                                                                                              \
         AT_ERROR(#NAME, " not implemented for '", TYPE, "'");                                               \
     }                                                                                                       \
@@ -29,7 +29,7 @@ std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b) {
   return expandedSizes;
 }
 
-std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
+std::tuple<DimVector, DimVector> inferExpandGeometry(
     IntArrayRef tensor_sizes,
     IntArrayRef tensor_strides,
     IntArrayRef sizes) {
@@ -37,12 +37,11 @@ std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
   int64_t tensor_dim = tensor_sizes.size();
 
   if (tensor_dim == 0) {
-    std::vector<int64_t> expandedStrides(ndim, 0);
-    return std::tuple<std::vector<int64_t>, std::vector<int64_t>>(
-        sizes.vec(), expandedStrides);
+    return std::tuple<DimVector, DimVector>(
+        DimVector(sizes.begin(), sizes.end()), DimVector(ndim, 0));
   }
-  std::vector<int64_t> expandedSizes(ndim);
-  std::vector<int64_t> expandedStrides(ndim);
+  DimVector expandedSizes(ndim);
+  DimVector expandedStrides(ndim);
 
   // create a new geometry for the tensors
   for (int64_t i = ndim - 1; i >= 0; --i) {
@@ -80,8 +79,8 @@ std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
     expandedSizes[i] = size;
     expandedStrides[i] = stride;
   }
-  return std::tuple<std::vector<int64_t>, std::vector<int64_t>>(
-      expandedSizes, expandedStrides);
+  return std::tuple<DimVector, DimVector>(
+      std::move(expandedSizes), std::move(expandedStrides));
 }
 
 } // namespace at
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ATen/Tensor.h>
+#include <ATen/core/DimVector.h>
 #include <c10/util/Exception.h>
 
 #include <functional>
@@ -9,9 +10,12 @@
 
 namespace at {
 
+// infer_size returns std::vector because several JIT callers move the
+// result straight into an IValue int list; the expand geometry below is
+// only ever consumed as IntArrayRef, so it uses DimVector and stays off
+// the heap for the common rank <= 5 case.
 CAFFE2_API std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b);
-CAFFE2_API std::tuple<std::vector<int64_t>, std::vector<int64_t>>
-inferExpandGeometry(
+CAFFE2_API std::tuple<DimVector, DimVector> inferExpandGeometry(
     IntArrayRef tensor_sizes,
     IntArrayRef tensor_strides,
     IntArrayRef sizes);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ATen/core/DimVector.h>
 #include <c10/core/ScalarType.h>
 #include <c10/util/Optional.h>
 #include <sstream>
@@ -9,8 +10,12 @@ namespace at {
 
 // Infers the size of a dim with size -1, if it exists. Also checks that new
 // shape is compatible with the number of elements.
-static std::vector<int64_t> infer_size(IntArrayRef shape, int64_t numel) {
-  auto res = shape.vec();
+//
+// Returns a DimVector: view shapes feed straight into as_strided /
+// setStorage as IntArrayRef, so the common rank <= 5 case never touches
+// the heap.
+static DimVector infer_size(IntArrayRef shape, int64_t numel) {
+  DimVector res(shape.begin(), shape.end());
   int64_t newsize = 1;
   auto infer_dim = c10::optional<int64_t>();
   for (int64_t dim = 0, ndim = shape.size(); dim != ndim; dim++) {
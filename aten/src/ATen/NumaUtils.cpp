@@ -0,0 +1,44 @@
+#include <ATen/NumaUtils.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/numa.h>
+
+namespace at {
+
+int pin_to_numa_node(const Tensor& tensor, int numa_node_id) {
+  AT_CHECK(
+      tensor.device().type() == at::kCPU,
+      "pin_to_numa_node: expected a CPU tensor, got ", tensor.device());
+  AT_CHECK(
+      !tensor.is_sparse(),
+      "pin_to_numa_node: expected a dense tensor");
+  if (!c10::IsNUMAEnabled()) {
+    return -1;
+  }
+  AT_CHECK(
+      numa_node_id >= 0 && numa_node_id < c10::GetNumNUMANodes(),
+      "pin_to_numa_node: invalid NUMA node ", numa_node_id,
+      " (have ", c10::GetNumNUMANodes(), " nodes)");
+  const auto& storage = tensor.storage();
+  if (storage.capacity() == 0) {
+    return -1;
+  }
+  // Moving the whole storage (rather than the tensor's view of it) keeps
+  // every alias on the same node.
+  c10::NUMAMove(storage.data(), storage.capacity(), numa_node_id);
+  return c10::GetNUMANode(storage.data());
+}
+
+int numa_node_of(const Tensor& tensor) {
+  if (!c10::IsNUMAEnabled() || tensor.device().type() != at::kCPU ||
+      tensor.is_sparse()) {
+    return -1;
+  }
+  const auto& storage = tensor.storage();
+  if (storage.capacity() == 0) {
+    return -1;
+  }
+  return c10::GetNUMANode(storage.data());
+}
+
+} // namespace at
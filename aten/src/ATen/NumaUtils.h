@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+
+namespace at {
+
+// Moves the pages backing `tensor`'s storage to the given NUMA node and
+// returns the node the storage resides on afterwards. Returns -1 when NUMA
+// is unavailable or the storage is empty. Useful on multi-socket machines
+// to co-locate a tensor with the threads that consume it.
+CAFFE2_API int pin_to_numa_node(const Tensor& tensor, int numa_node_id);
+
+// NUMA node currently backing `tensor`'s storage, or -1 when NUMA is
+// unavailable or the storage is empty.
+CAFFE2_API int numa_node_of(const Tensor& tensor);
+
+} // namespace at
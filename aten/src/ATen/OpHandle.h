@@ -0,0 +1,75 @@
+#pragma once
+
+#include <ATen/Context.h>
+#include <ATen/core/Tensor.h>
+#include <ATen/core/Type.h>
+#include <c10/core/Backend.h>
+#include <c10/util/Exception.h>
+
+#include <utility>
+
+namespace at {
+
+// Note [Pre-resolved op handles]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// An eager call like at::add re-resolves its dispatch target on every
+// invocation: the Variable layer records autograd state and the
+// backend/dtype Type is looked up again, even when serving code calls the
+// same op on the same device and dtype millions of times. An OpHandle
+// binds the concrete non-Variable Type once at setup; invoking the handle
+// afterwards is a single indirect call into the backend implementation.
+//
+// The caller takes over the checks the dispatcher would have done, and
+// they are not re-verified in release builds:
+//  * every tensor argument must live on the bound backend with the bound
+//    dtype;
+//  * no input may require grad -- the handle deliberately skips the
+//    VariableType layer, so nothing is recorded for backward.
+//
+// The bound signature selects the Type overload, e.g.:
+//
+//   auto add = at::OpHandle<Tensor(const Tensor&, const Tensor&, Scalar)>
+//       ::bind(&Type::add, example);
+//   for (...) { out = add(a, b, 1); }
+
+template <typename F>
+class OpHandle;
+
+template <typename Ret, typename... Args>
+class OpHandle<Ret(Args...)> {
+ public:
+  using Method = Ret (Type::*)(Args...) const;
+
+  /// Resolves against the backend and dtype of `example`.
+  static OpHandle bind(Method method, const Tensor& example) {
+    AT_CHECK(
+        example.defined(), "OpHandle::bind requires a defined example tensor");
+    return bind(
+        method,
+        tensorTypeIdToBackend(example.type_id()),
+        example.scalar_type());
+  }
+
+  static OpHandle bind(Method method, Backend backend, ScalarType scalar_type) {
+    return OpHandle(
+        method, globalContext().getNonVariableType(backend, scalar_type));
+  }
+
+  Ret operator()(Args... args) const {
+    return (type_->*method_)(std::forward<Args>(args)...);
+  }
+
+  /// The resolved backend Type; useful for asserting compatibility of
+  /// inputs in caller-side debug checks.
+  const Type& type() const {
+    return *type_;
+  }
+
+ private:
+  OpHandle(Method method, Type& type) : method_(method), type_(&type) {}
+
+  Method method_;
+  Type* type_;
+};
+
+} // namespace at
@@ -1,11 +1,22 @@
 #include <ATen/Parallel.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #ifdef TH_BLAS_MKL
 #include <mkl.h>
 #endif
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 namespace at {
 
 namespace {
@@ -13,6 +24,141 @@ namespace {
 std::atomic<int> num_threads(-1);
 }
 
+namespace internal {
+namespace {
+
+// Set while a pool worker (or the caller participating in the region) is
+// executing chunks of a task-pool parallel_for.
+thread_local bool in_taskpool_region_ = false;
+
+// Pool selected by an IntraOpPoolGuard on this thread; parallel regions
+// fall back to the shared intra-op pool when unset. See
+// Note [Named intra-op pools] in Parallel.h.
+thread_local PTThreadPool* current_intraop_pool_ = nullptr;
+
+PTThreadPool& get_intraop_pool() {
+  static PTThreadPool pool(get_num_threads());
+  return pool;
+}
+
+// Shared between the launching thread and the pool workers; kept alive by
+// shared_ptr so that a straggling worker that loses the race for the last
+// chunk can still touch the state after the launcher has returned.
+struct TaskPoolState {
+  TaskPoolState(
+      int64_t begin,
+      int64_t end,
+      int64_t num_chunks,
+      const std::function<void(int64_t, int64_t)>& f)
+      : begin(begin),
+        end(end),
+        num_chunks(num_chunks),
+        chunk_size(divup(end - begin, num_chunks)),
+        remaining(num_chunks),
+        f(f) {}
+
+  const int64_t begin;
+  const int64_t end;
+  const int64_t num_chunks;
+  const int64_t chunk_size;
+  std::atomic<int64_t> next_chunk{0};
+  std::atomic<int64_t> remaining;
+  std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
+  std::exception_ptr eptr;
+  std::mutex mutex;
+  std::condition_variable complete;
+  const std::function<void(int64_t, int64_t)> f;
+};
+
+void run_chunks(const std::shared_ptr<TaskPoolState>& state) {
+  bool prev_in_region = in_taskpool_region_;
+  in_taskpool_region_ = true;
+  while (true) {
+    int64_t chunk = state->next_chunk++;
+    if (chunk >= state->num_chunks) {
+      break;
+    }
+    int64_t chunk_begin = state->begin + chunk * state->chunk_size;
+    int64_t chunk_end = std::min(state->end, chunk_begin + state->chunk_size);
+    if (chunk_begin < chunk_end) {
+      try {
+        state->f(chunk_begin, chunk_end);
+      } catch (...) {
+        if (!state->err_flag.test_and_set()) {
+          state->eptr = std::current_exception();
+        }
+      }
+    }
+    if (--state->remaining == 0) {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->complete.notify_one();
+    }
+  }
+  in_taskpool_region_ = prev_in_region;
+}
+
+} // namespace
+
+bool use_taskpool_backend() {
+  static bool result = []() {
+    auto envar = std::getenv("ATEN_PARALLEL_BACKEND");
+    if (envar) {
+      if (strcmp(envar, "taskpool") == 0) {
+        return true;
+      }
+      if (strcmp(envar, "openmp") != 0) {
+        AT_WARN("ignoring invalid value for ATEN_PARALLEL_BACKEND: ", envar);
+      }
+    }
+    return false;
+  }();
+  return result;
+}
+
+bool in_taskpool_region() {
+  return in_taskpool_region_;
+}
+
+bool deterministic_reduce() {
+  static bool result = []() {
+    auto envar = std::getenv("ATEN_DETERMINISTIC_REDUCE");
+    return envar != nullptr && strcmp(envar, "0") != 0;
+  }();
+  return result;
+}
+
+void _run_with_taskpool(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    const std::function<void(int64_t, int64_t)>& f) {
+  auto& pool = current_intraop_pool_ != nullptr ? *current_intraop_pool_
+                                                : get_intraop_pool();
+  // Chunks are deliberately smaller than a per-thread static partition so
+  // that threads which finish early keep pulling work; four chunks per
+  // thread keeps the scheduling overhead amortized over grain_size.
+  int64_t max_chunks = static_cast<int64_t>(pool.size()) * 4;
+  int64_t num_chunks =
+      std::min(std::max(divup(end - begin, grain_size), (int64_t)1), max_chunks);
+  auto state = std::make_shared<TaskPoolState>(begin, end, num_chunks, f);
+  int64_t num_helpers =
+      std::min(num_chunks - 1, static_cast<int64_t>(pool.size()));
+  for (int64_t i = 0; i < num_helpers; i++) {
+    pool.run([state]() { run_chunks(state); });
+  }
+  // The launching thread participates instead of blocking.
+  run_chunks(state);
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->complete.wait(lock, [&]() { return state->remaining == 0; });
+  }
+  if (state->eptr) {
+    std::rethrow_exception(state->eptr);
+  }
+}
+
+} // namespace internal
+
 void init_num_threads() {
   auto nthreads = num_threads.load();
   if (nthreads > 0) {
@@ -72,6 +218,100 @@ void PTThreadPool::init_thread() {
 
 namespace {
 
+// Registry for Note [Named intra-op pools]. Pools are never erased, so the
+// PTThreadPool pointers handed out to guards stay valid for the process
+// lifetime.
+std::mutex& named_pools_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, std::unique_ptr<PTThreadPool>>&
+named_pools() {
+  static std::unordered_map<std::string, std::unique_ptr<PTThreadPool>> pools;
+  return pools;
+}
+
+// Restricts every worker's affinity mask to cpu_ids. One barrier task is
+// queued per worker, and each task holds its worker until all tasks have
+// been claimed, so no worker is pinned twice and none escapes unpinned.
+void pin_pool_threads(c10::ThreadPool& pool, const std::vector<int>& cpu_ids) {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const int cpu : cpu_ids) {
+    AT_CHECK(
+        cpu >= 0 && cpu < CPU_SETSIZE,
+        "invalid cpu id for thread pool affinity: ", cpu);
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  struct Barrier {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t remaining;
+  };
+  auto barrier = std::make_shared<Barrier>();
+  barrier->remaining = pool.size();
+  for (size_t i = 0; i < pool.size(); i++) {
+    pool.run([barrier, cpu_set]() {
+      sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set);
+      std::unique_lock<std::mutex> lock(barrier->mutex);
+      if (--barrier->remaining == 0) {
+        barrier->cv.notify_all();
+      } else {
+        barrier->cv.wait(lock, [&]() { return barrier->remaining == 0; });
+      }
+    });
+  }
+  std::unique_lock<std::mutex> lock(barrier->mutex);
+  barrier->cv.wait(lock, [&]() { return barrier->remaining == 0; });
+#else
+  (void)pool;
+  (void)cpu_ids;
+#endif
+}
+
+} // namespace
+
+void define_thread_pool(
+    const std::string& name,
+    size_t num_threads,
+    const std::vector<int>& cpu_ids) {
+  AT_CHECK(num_threads > 0, "thread pool '", name, "' needs at least one thread");
+  std::lock_guard<std::mutex> lock(named_pools_mutex());
+  AT_CHECK(
+      named_pools().count(name) == 0,
+      "thread pool '", name, "' is already defined");
+  std::unique_ptr<PTThreadPool> pool(new PTThreadPool(num_threads));
+  if (!cpu_ids.empty()) {
+    pin_pool_threads(*pool, cpu_ids);
+  }
+  named_pools().emplace(name, std::move(pool));
+}
+
+IntraOpPoolGuard::IntraOpPoolGuard(const std::string& name)
+    : prev_(internal::current_intraop_pool_) {
+  PTThreadPool* pool = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(named_pools_mutex());
+    auto it = named_pools().find(name);
+    if (it != named_pools().end()) {
+      pool = it->second.get();
+    }
+  }
+  AT_CHECK(
+      pool != nullptr,
+      "no thread pool named '", name, "'; define it with at::define_thread_pool");
+  internal::current_intraop_pool_ = pool;
+}
+
+IntraOpPoolGuard::~IntraOpPoolGuard() {
+  internal::current_intraop_pool_ = prev_;
+}
+
+namespace {
+
 std::shared_ptr<TaskThreadPoolBase> createC10ThreadPool(
     int device_id,
     int pool_size,
@@ -1,10 +1,14 @@
 #pragma once
 #include <ATen/ATen.h>
+#include <c10/core/thread_budget.h>
 #include <c10/core/thread_pool.h>
 
 #include <atomic>
 #include <cstddef>
 #include <exception>
+#include <functional>
+#include <string>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -18,6 +22,33 @@ namespace internal {
 // no parallel algorithm (such as parallel_reduce) should split work into
 // smaller than GRAIN_SIZE chunks.
 constexpr int64_t GRAIN_SIZE = 32768;
+
+// Returns true if the task-pool backend was selected via
+// ATEN_PARALLEL_BACKEND=taskpool. With this backend, parallel_for runs its
+// chunks on a shared PTThreadPool instead of forking an OpenMP team. Workers
+// pull chunks off a shared counter, so concurrent and nested parallel_for
+// calls interleave on the same threads instead of oversubscribing the
+// machine with per-region OpenMP teams.
+CAFFE2_API bool use_taskpool_backend();
+
+// Whether the current thread is executing a task-pool parallel region.
+CAFFE2_API bool in_taskpool_region();
+
+// Runs f over [begin, end) on the shared intra-op task pool, splitting the
+// range into at most 4 * pool-size chunks of at least grain_size elements.
+// The calling thread participates in the work.
+CAFFE2_API void _run_with_taskpool(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    const std::function<void(int64_t, int64_t)>& f);
+
+// Returns true if ATEN_DETERMINISTIC_REDUCE is set. Parallel reductions
+// then use chunk boundaries and a combination tree that depend only on the
+// problem size, so floating point results are bitwise identical across
+// runs and thread counts; see Note [Deterministic parallel reduction] in
+// native/TensorIteratorReduce.cpp.
+CAFFE2_API bool deterministic_reduce();
 } // namespace internal
 
 inline int64_t divup(int64_t x, int64_t y) {
@@ -44,6 +75,9 @@ inline int get_thread_num() {
 }
 
 inline bool in_parallel_region() {
+  if (internal::in_taskpool_region()) {
+    return true;
+  }
 #ifdef _OPENMP
   return omp_in_parallel();
 #else
@@ -57,10 +91,29 @@ inline void parallel_for(
     const int64_t end,
     const int64_t grain_size,
     const F& f) {
+  if (internal::use_taskpool_backend()) {
+    if (begin >= end) {
+      return;
+    }
+    // Nested parallel_for calls run inline on the worker thread; the outer
+    // region already occupies the pool, and serial chunks of an inner loop
+    // compose instead of deadlocking.
+    if ((end - begin) < grain_size || in_parallel_region()) {
+      f(begin, end);
+      return;
+    }
+    internal::_run_with_taskpool(begin, end, grain_size, f);
+    return;
+  }
 #ifdef _OPENMP
   std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
   std::exception_ptr eptr;
-#pragma omp parallel if (!omp_in_parallel() && ((end - begin) >= grain_size))
+  // With concurrent inter-op tasks, split the cores between their teams
+  // instead of forking a full team per task; see
+  // Note [Cooperative thread budget] in c10/core/thread_budget.cpp.
+  const int64_t team_size =
+      c10::thread_budget::recommended_team_size(omp_get_max_threads());
+#pragma omp parallel num_threads(team_size) if (!omp_in_parallel() && ((end - begin) >= grain_size))
   {
     int64_t num_threads = omp_get_num_threads();
     int64_t tid = omp_get_thread_num();
@@ -127,13 +180,33 @@ inline scalar_t parallel_reduce(
     const scalar_t ident,
     const F f,
     const SF sf) {
-  if (get_num_threads() == 1) {
+  // The chunk boundaries and the std::accumulate order below depend only on
+  // the range and grain size, so the chunked path is already reproducible
+  // across thread counts. Under deterministic reductions a single-thread run
+  // must match it bitwise, so only then is the whole-range shortcut skipped
+  // (the chunk loop simply runs serially).
+  if (get_num_threads() == 1 && !internal::deterministic_reduce()) {
     return f(begin, end, ident);
   } else {
     const int64_t num_results = divup((end - begin), grain_size);
     std::vector<scalar_t> results(num_results);
     scalar_t* results_data = results.data();
-#pragma omp parallel for if ((end - begin) >= grain_size)
+    if (internal::use_taskpool_backend()) {
+      parallel_for(0, num_results, 1, [&](int64_t begin_id, int64_t end_id) {
+        for (int64_t id = begin_id; id < end_id; id++) {
+          int64_t i = begin + id * grain_size;
+          results_data[id] = f(i, i + std::min(end - i, grain_size), ident);
+        }
+      });
+      return std::accumulate(
+          results_data, results_data + results.size(), ident, sf);
+    }
+#ifdef _OPENMP
+    // See Note [Cooperative thread budget] in c10/core/thread_budget.cpp
+    const int64_t team_size =
+        c10::thread_budget::recommended_team_size(omp_get_max_threads());
+#pragma omp parallel for num_threads(team_size) if ((end - begin) >= grain_size)
+#endif
     for (int64_t id = 0; id < num_results; id++) {
       int64_t i = begin + id * grain_size;
       results_data[id] = f(i, i + std::min(end - i, grain_size), ident);
@@ -152,4 +225,42 @@ class CAFFE2_API PTThreadPool : public c10::ThreadPool {
   void init_thread() override;
 };
 
+// Note [Named intra-op pools]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With the task-pool backend (ATEN_PARALLEL_BACKEND=taskpool), all
+// parallel_for calls share one process-wide pool, so two concurrent
+// requests' intra-op work contends for the same cores. For partitioned
+// serving, define_thread_pool creates additional named pools whose workers
+// are optionally pinned to a CPU core set, and IntraOpPoolGuard routes the
+// parallel_for/parallel_reduce chunks issued in its scope to one of them.
+// Pinning disjoint core sets to different pools keeps one request's
+// parallelism from stomping another's.
+//
+// The calling thread still participates in the region from whatever core
+// it runs on; latency-sensitive callers typically pin their request thread
+// to the same set. Pools live for the process lifetime. With the OpenMP
+// backend the guard has no effect (OpenMP owns its own thread team).
+
+// Creates a pool with num_threads workers. If cpu_ids is non-empty, every
+// worker's affinity mask is restricted to those cores (Linux only; a no-op
+// elsewhere). Throws if the name is already defined.
+CAFFE2_API void define_thread_pool(
+    const std::string& name,
+    size_t num_threads,
+    const std::vector<int>& cpu_ids = {});
+
+// Routes task-pool parallel regions in this scope to the named pool.
+// Throws if no such pool was defined. See Note [Named intra-op pools].
+class CAFFE2_API IntraOpPoolGuard {
+ public:
+  explicit IntraOpPoolGuard(const std::string& name);
+  ~IntraOpPoolGuard();
+
+  IntraOpPoolGuard(const IntraOpPoolGuard&) = delete;
+  IntraOpPoolGuard& operator=(const IntraOpPoolGuard&) = delete;
+
+ private:
+  PTThreadPool* prev_;
+};
+
 } // namespace at
@@ -0,0 +1,299 @@
+#include <ATen/RawTensorFile.h>
+
+#include <ATen/ColumnarBuffer.h>
+#include <ATen/TensorUtils.h>
+#include <TH/THAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace at {
+
+namespace {
+
+// File layout (all fields native byte order):
+//   u64 magic, i64 version, i64 ntensors
+//   per tensor: i32 scalar_type, i32 ndim, i64 sizes[ndim],
+//               i64 strides[ndim], i64 payload_offset, i64 payload_nbytes
+// Every payload_offset is a multiple of kPayloadAlignment, so payloads can
+// be handed to the kernel page cache and to mmap without copying. Every
+// field is 8-byte aligned by construction (the two i32s pack into 8 bytes).
+constexpr uint64_t kRawTensorFileMagic = 0x313057415254505fULL; // "_PTRAW01"
+constexpr int64_t kRawTensorFileVersion = 1;
+constexpr size_t kPayloadAlignment = 4096;
+
+size_t alignUp(size_t offset) {
+  return (offset + kPayloadAlignment - 1) & ~(kPayloadAlignment - 1);
+}
+
+template <typename T>
+void appendScalar(std::vector<char>& buffer, T value) {
+  const auto old_size = buffer.size();
+  buffer.resize(old_size + sizeof(T));
+  std::memcpy(buffer.data() + old_size, &value, sizeof(T));
+}
+
+template <typename T>
+T readScalar(const char* base, size_t nbytes, size_t& cursor) {
+  AT_CHECK(
+      cursor + sizeof(T) <= nbytes,
+      "read_raw_tensor_file: truncated header");
+  T value;
+  std::memcpy(&value, base + cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+// One scatter/gather chunk of the output file, in file order.
+struct WriteChunk {
+  const void* data;
+  size_t nbytes;
+};
+
+#ifndef _WIN32
+void writeChunks(const std::string& filename, std::vector<WriteChunk>& chunks) {
+  const int fd = ::open(
+      filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  AT_CHECK(fd != -1, "write_raw_tensor_file: unable to open ", filename);
+
+  std::vector<struct iovec> iov;
+  iov.reserve(chunks.size());
+  for (const auto& chunk : chunks) {
+    if (chunk.nbytes == 0) {
+      continue;
+    }
+    struct iovec v;
+    v.iov_base = const_cast<void*>(chunk.data);
+    v.iov_len = chunk.nbytes;
+    iov.push_back(v);
+  }
+
+  size_t idx = 0;
+  while (idx < iov.size()) {
+    const auto count = std::min<size_t>(iov.size() - idx, IOV_MAX);
+    const ssize_t written =
+        ::writev(fd, iov.data() + idx, static_cast<int>(count));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      const int err = errno;
+      ::close(fd);
+      AT_ERROR(
+          "write_raw_tensor_file: write to ",
+          filename,
+          " failed: ",
+          strerror(err));
+    }
+    // Advance past fully written chunks; trim a partially written one.
+    auto remaining = static_cast<size_t>(written);
+    while (idx < iov.size() && remaining >= iov[idx].iov_len) {
+      remaining -= iov[idx].iov_len;
+      ++idx;
+    }
+    if (remaining > 0) {
+      iov[idx].iov_base = static_cast<char*>(iov[idx].iov_base) + remaining;
+      iov[idx].iov_len -= remaining;
+    }
+  }
+
+  AT_CHECK(
+      ::close(fd) == 0, "write_raw_tensor_file: unable to close ", filename);
+}
+#else
+void writeChunks(const std::string& filename, std::vector<WriteChunk>& chunks) {
+  FILE* f = std::fopen(filename.c_str(), "wb");
+  AT_CHECK(f != nullptr, "write_raw_tensor_file: unable to open ", filename);
+  for (const auto& chunk : chunks) {
+    if (chunk.nbytes == 0) {
+      continue;
+    }
+    if (std::fwrite(chunk.data, 1, chunk.nbytes, f) != chunk.nbytes) {
+      std::fclose(f);
+      AT_ERROR("write_raw_tensor_file: write to ", filename, " failed");
+    }
+  }
+  AT_CHECK(
+      std::fclose(f) == 0,
+      "write_raw_tensor_file: unable to close ",
+      filename);
+}
+#endif
+
+size_t fileSize(const std::string& filename) {
+  FILE* f = std::fopen(filename.c_str(), "rb");
+  AT_CHECK(f != nullptr, "read_raw_tensor_file: unable to open ", filename);
+  std::fseek(f, 0, SEEK_END);
+  const auto size = std::ftell(f);
+  std::fclose(f);
+  AT_CHECK(size >= 0, "read_raw_tensor_file: unable to stat ", filename);
+  return static_cast<size_t>(size);
+}
+
+void deleteMapping(void* ctx) {
+  delete static_cast<DataPtr*>(ctx);
+}
+
+} // namespace
+
+void write_raw_tensor_file(
+    const std::string& filename,
+    ArrayRef<Tensor> tensors) {
+  // Contiguous CPU copies; they must stay alive until the write completes.
+  std::vector<Tensor> payloads;
+  payloads.reserve(tensors.size());
+  for (const auto& tensor : tensors) {
+    AT_CHECK(
+        tensor.device().is_cpu(),
+        "write_raw_tensor_file: only CPU tensors are supported, got ",
+        tensor.device());
+    AT_CHECK(
+        !tensor.is_sparse(),
+        "write_raw_tensor_file: sparse tensors are not supported");
+    payloads.push_back(tensor.contiguous());
+  }
+
+  // Builds the header, leaving payload offsets to fill in once the header
+  // size (and thus the first aligned offset) is known.
+  std::vector<char> header;
+  std::vector<size_t> offset_fields;
+  appendScalar<uint64_t>(header, kRawTensorFileMagic);
+  appendScalar<int64_t>(header, kRawTensorFileVersion);
+  appendScalar<int64_t>(header, static_cast<int64_t>(payloads.size()));
+  for (const auto& payload : payloads) {
+    appendScalar<int32_t>(header, static_cast<int32_t>(payload.scalar_type()));
+    appendScalar<int32_t>(header, static_cast<int32_t>(payload.dim()));
+    for (const auto size : payload.sizes()) {
+      appendScalar<int64_t>(header, size);
+    }
+    for (const auto stride : payload.strides()) {
+      appendScalar<int64_t>(header, stride);
+    }
+    offset_fields.push_back(header.size());
+    appendScalar<int64_t>(header, 0); // payload_offset, patched below
+    appendScalar<int64_t>(
+        header,
+        static_cast<int64_t>(
+            payload.numel() * elementSize(payload.scalar_type())));
+  }
+
+  size_t offset = alignUp(header.size());
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    const auto signed_offset = static_cast<int64_t>(offset);
+    std::memcpy(
+        header.data() + offset_fields[i], &signed_offset, sizeof(int64_t));
+    offset += payloads[i].numel() * elementSize(payloads[i].scalar_type());
+    offset = alignUp(offset);
+  }
+
+  // Gathers header, alignment padding, and payloads into one scatter list.
+  static const std::array<char, kPayloadAlignment> zeros{};
+  std::vector<WriteChunk> chunks;
+  chunks.reserve(1 + 2 * payloads.size());
+  chunks.push_back({header.data(), header.size()});
+  size_t written = header.size();
+  for (const auto& payload : payloads) {
+    chunks.push_back({zeros.data(), alignUp(written) - written});
+    written = alignUp(written);
+    const size_t nbytes = payload.numel() * elementSize(payload.scalar_type());
+    chunks.push_back({payload.data_ptr(), nbytes});
+    written += nbytes;
+  }
+
+  writeChunks(filename, chunks);
+}
+
+std::vector<Tensor> read_raw_tensor_file(
+    const std::string& filename,
+    bool shared) {
+  const size_t nbytes = fileSize(filename);
+  const int flags = TH_ALLOCATOR_MAPPED_NOCREATE |
+      (shared ? TH_ALLOCATOR_MAPPED_SHARED : 0);
+  DataPtr mapping =
+      THMapAllocator::makeDataPtr(filename.c_str(), flags, nbytes, nullptr);
+  const char* base = static_cast<const char*>(mapping.get());
+  AT_CHECK(base != nullptr, "read_raw_tensor_file: unable to map ", filename);
+
+  size_t cursor = 0;
+  const auto magic = readScalar<uint64_t>(base, nbytes, cursor);
+  AT_CHECK(
+      magic == kRawTensorFileMagic,
+      "read_raw_tensor_file: ",
+      filename,
+      " is not a raw tensor file");
+  const auto version = readScalar<int64_t>(base, nbytes, cursor);
+  AT_CHECK(
+      version == kRawTensorFileVersion,
+      "read_raw_tensor_file: unsupported version ",
+      version);
+  const auto ntensors = readScalar<int64_t>(base, nbytes, cursor);
+  AT_CHECK(ntensors >= 0, "read_raw_tensor_file: corrupt tensor count");
+  if (ntensors == 0) {
+    return {};
+  }
+
+  std::vector<ExternalColumn> columns;
+  columns.reserve(ntensors);
+  for (int64_t i = 0; i < ntensors; ++i) {
+    const auto scalar_type_int = readScalar<int32_t>(base, nbytes, cursor);
+    AT_CHECK(
+        scalar_type_int >= 0 &&
+            scalar_type_int <
+                static_cast<int32_t>(ScalarType::NumOptions),
+        "read_raw_tensor_file: corrupt dtype for tensor ",
+        i);
+    const auto scalar_type = static_cast<ScalarType>(scalar_type_int);
+    const auto ndim = readScalar<int32_t>(base, nbytes, cursor);
+    AT_CHECK(ndim >= 0, "read_raw_tensor_file: corrupt rank for tensor ", i);
+
+    ExternalColumn column;
+    column.dtype = scalar_type;
+    column.sizes.reserve(ndim);
+    column.strides.reserve(ndim);
+    for (int32_t d = 0; d < ndim; ++d) {
+      column.sizes.push_back(readScalar<int64_t>(base, nbytes, cursor));
+    }
+    for (int32_t d = 0; d < ndim; ++d) {
+      column.strides.push_back(readScalar<int64_t>(base, nbytes, cursor));
+    }
+    const auto payload_offset = readScalar<int64_t>(base, nbytes, cursor);
+    const auto payload_nbytes = readScalar<int64_t>(base, nbytes, cursor);
+    AT_CHECK(
+        payload_offset >= 0 && payload_nbytes >= 0 &&
+            static_cast<size_t>(payload_offset) + payload_nbytes <= nbytes,
+        "read_raw_tensor_file: payload for tensor ",
+        i,
+        " is out of bounds");
+    AT_CHECK(
+        detail::computeStorageSize(column.sizes, column.strides) *
+                elementSize(scalar_type) ==
+            static_cast<size_t>(payload_nbytes),
+        "read_raw_tensor_file: payload size mismatch for tensor ",
+        i);
+    column.data = const_cast<char*>(base) + payload_offset;
+    columns.push_back(std::move(column));
+  }
+
+  // The columns share the mapping; it is released when the last one is.
+  auto owner = std::unique_ptr<DataPtr>(new DataPtr(std::move(mapping)));
+  auto tensors =
+      from_external_columns(columns, owner.get(), &deleteMapping, at::kCPU);
+  owner.release();
+  return tensors;
+}
+
+} // namespace at
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Tensor.h>
+
+#include <string>
+#include <vector>
+
+// A schema-free bulk container for intermediate tensor artifacts: a single
+// header (dtype/shape/strides/offset table) followed by page-aligned
+// payload regions. Unlike the pickle-based serialization in
+// torch/csrc/jit/export.cpp, there is no per-element metadata and no
+// framing around the payload, so restore is a single mmap with zero-copy
+// tensor views over it. Only dense CPU tensors are supported; non-contiguous
+// tensors are written as contiguous copies.
+//
+// The format is an implementation detail, not an interchange format: it
+// uses native byte order and may change between releases. It is intended
+// for scratch checkpoints written and read by the same build.
+
+namespace at {
+
+// Writes tensors to filename, replacing any existing file. Payload regions
+// are page-aligned and written with vectored I/O.
+CAFFE2_API void write_raw_tensor_file(
+    const std::string& filename,
+    ArrayRef<Tensor> tensors);
+
+// Maps filename and returns zero-copy tensors over the mapped payloads.
+// The mapping stays alive until the last returned tensor is released.
+// With shared=false the file is mapped copy-on-write: the tensors are
+// writable but modifications are not written back. With shared=true
+// modifications persist to the file.
+CAFFE2_API std::vector<Tensor> read_raw_tensor_file(
+    const std::string& filename,
+    bool shared = false);
+
+} // namespace at
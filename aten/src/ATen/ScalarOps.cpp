@@ -0,0 +1,51 @@
+#include <ATen/ScalarOps.h>
+
+#include <ATen/ATen.h>
+
+#include <vector>
+
+namespace c10 {
+namespace detail {
+
+namespace {
+
+// Number of scalar tensors each thread keeps around for reuse. Mixed
+// tensor-scalar arithmetic rarely has more than a couple of scalar
+// wrappers alive at once, so a handful of slots is enough to make the
+// steady state allocation-free.
+constexpr size_t kScalarTensorPoolSize = 8;
+
+} // namespace
+
+at::Tensor scalar_tensor_cpu_pooled(Scalar s, at::ScalarType dtype) {
+  // The pool retains one reference to each slot. A slot may be reused
+  // when nothing else can observe it anymore: no other reference to the
+  // TensorImpl, no weak reference, and - as in input_buffer.cpp - no
+  // other reference to the storage either, since a view taken off the
+  // wrapper (scalar_to_tensor(x).view({1})) keeps the storage alive
+  // after the wrapper itself is dropped and must not see a later fill_.
+  // Reuse then rewinds what a caller may have done to the impl: the
+  // wrapped-number flag (set by wrapped_scalar_tensor in BinaryOps.cpp
+  // and SparseTensorMath.cpp, and observed by type promotion) is
+  // cleared so the slot hands out the same plain 0-dim tensor a fresh
+  // allocation would, and a slot that is no longer scalar-shaped is
+  // simply not reused.
+  static thread_local std::vector<at::Tensor> pool;
+  for (auto& slot : pool) {
+    if (slot.scalar_type() == dtype && slot.use_count() == 1 &&
+        slot.weak_use_count() == 1 && slot.storage().use_count() == 1 &&
+        slot.dim() == 0) {
+      slot.unsafeGetTensorImpl()->set_wrapped_number(false);
+      slot.fill_(s);
+      return slot;
+    }
+  }
+  auto tensor = at::scalar_tensor(s, at::device(at::kCPU).dtype(dtype));
+  if (pool.size() < kScalarTensorPoolSize) {
+    pool.push_back(tensor);
+  }
+  return tensor;
+}
+
+} // namespace detail
+} // namespace c10
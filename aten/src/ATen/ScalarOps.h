@@ -6,14 +6,21 @@
 // This is in the c10 namespace because we use ADL to find the functions in it.
 namespace c10 {
 
+namespace detail {
+// Implemented in ScalarOps.cpp. Hands out scalar CPU tensors from a small
+// thread-local pool of recycled TensorImpl/StorageImpl pairs, so wrapping
+// a C++ scalar does not hit the heap in steady state.
+CAFFE2_API at::Tensor scalar_tensor_cpu_pooled(Scalar s, at::ScalarType dtype);
+} // namespace detail
+
 // FIXME: this should be (and was) Scalar::toTensor, but there is currently no way
 // to implement this without going through Derived Types (which are not part of core).
 inline at::Tensor scalar_to_tensor(Scalar s) {
   if (s.isFloatingPoint()) {
-    return at::scalar_tensor(s, at::device(at::kCPU).dtype(at::kDouble));
+    return detail::scalar_tensor_cpu_pooled(s, at::kDouble);
   } else {
     AT_ASSERT(s.isIntegral());
-    return at::scalar_tensor(s, at::device(at::kCPU).dtype(at::kLong));
+    return detail::scalar_tensor_cpu_pooled(s, at::kLong);
   }
 }
 
@@ -123,6 +123,34 @@ void SparseTensorImpl::set_indices_and_values_unsafe(const Tensor& indices, cons
   AT_ASSERT(values_.device() == indices_.device());
 
   coalesced_ = false;
+  csr_row_pointers_ = Tensor();
+}
+
+const Tensor& SparseTensorImpl::csr_row_pointers() {
+  AT_ASSERT(coalesced_);
+  AT_ASSERT(sparse_dim_ == 2);
+  if (!csr_row_pointers_.defined()) {
+    const int64_t rows = sizes_[0];
+    const int64_t nnz = indices_.size(1);
+    // Coalesced tensors keep their indices sorted, so a single counting
+    // pass over the row indices followed by a prefix sum suffices.
+    auto crow = at::zeros({rows + 1}, indices_.options());
+    auto indices_accessor = indices_.accessor<int64_t, 2>();
+    auto crow_accessor = crow.accessor<int64_t, 1>();
+    for (int64_t i = 0; i < nnz; i++) {
+      int64_t row = indices_accessor[0][i];
+      AT_CHECK(
+          row >= 0 && row < rows,
+          "csr_row_pointers: row index out of bound: ", row,
+          " not between 0 and ", rows - 1);
+      crow_accessor[row + 1]++;
+    }
+    for (int64_t i = 0; i < rows; i++) {
+      crow_accessor[i + 1] += crow_accessor[i];
+    }
+    csr_row_pointers_ = std::move(crow);
+  }
+  return csr_row_pointers_;
 }
 
 
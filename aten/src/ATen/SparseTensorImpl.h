@@ -29,6 +29,11 @@ struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   // because many algorithms proceed by merging two sorted lists (of indices).
   bool coalesced_ = false;
 
+  // Lazily built CSR row pointer array for 2-dimensional coalesced tensors;
+  // see csr_row_pointers(). Dropped whenever the indices, values, sizes or
+  // coalesce state change.
+  Tensor csr_row_pointers_;
+
 public:
   // Public for now...
   explicit SparseTensorImpl(at::TensorTypeId, const caffe2::TypeMeta&);
@@ -40,6 +45,12 @@ public:
   Tensor indices() const { return indices_; }
   Tensor values() const { return values_; }
 
+  // Returns the CSR row pointer array of a 2-dimensional coalesced sparse
+  // tensor: row i's entries occupy positions [crow[i], crow[i + 1]) of
+  // indices/values. Built on first use and cached until the tensor's
+  // indices, values, sizes or coalesce state change.
+  const Tensor& csr_row_pointers();
+
   IntArrayRef strides() const override;
   bool is_contiguous() const override;
   int64_t stride(int64_t d) const override;
@@ -61,6 +72,7 @@ public:
     sizes_ = size.vec();
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
+    csr_row_pointers_ = Tensor();
     refresh_numel();
   }
 
@@ -140,6 +152,7 @@ public:
     sizes_ = size.vec();
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
+    csr_row_pointers_ = Tensor();
     refresh_numel();
   }
 
@@ -164,6 +177,7 @@ public:
   void set_coalesced(bool coalesced) {
     AT_CHECK(allow_tensor_metadata_change(), "set_coalesced is not allowed on Tensor created from .data or .detach()");
     coalesced_ = coalesced;
+    csr_row_pointers_ = Tensor();
   }
 
   // NOTE: this function is only used internally and not exposed to Python frontend
@@ -172,6 +186,7 @@ public:
     AT_ASSERT(new_nnz <= nnz());
     indices_ = indices_.narrow(1, 0, new_nnz);
     values_ = values_.narrow(0, 0, new_nnz);
+    csr_row_pointers_ = Tensor();
   }
 
   // Takes indices and values and directly puts them into the sparse tensor, no copy.
@@ -211,6 +226,7 @@ public:
     impl->values_ = values();
     impl->device_opt_ = device();
     impl->coalesced_ = coalesced();
+    impl->csr_row_pointers_ = csr_row_pointers_;
     impl->refresh_numel();
     return impl;
   }
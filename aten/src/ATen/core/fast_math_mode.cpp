@@ -0,0 +1,15 @@
+#include <ATen/core/fast_math_mode.h>
+
+namespace at {
+
+thread_local bool FastMathMode_enabled = false;
+
+bool FastMathMode::is_enabled() {
+  return FastMathMode_enabled;
+}
+
+void FastMathMode::set_enabled(bool enabled) {
+  FastMathMode_enabled = enabled;
+}
+
+} // namespace at
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+namespace at {
+
+// Note [Fast math tier]
+// ~~~~~~~~~~~~~~~~~~~~~
+// The transcendental kernels aim for libm-faithful accuracy, but many
+// inference workloads tolerate a few ulp in exchange for cheaper
+// polynomials. FastMathMode is a thread-local opt-in: while enabled,
+// kernels that have a reduced-accuracy variant (currently exp, tanh and
+// sigmoid on float CPU tensors, plus the same functions in fuser
+// generated code) use approximations good to roughly 12 significant
+// bits, with underflow flushed to zero instead of producing denormals.
+// Everything without a fast variant is unaffected, as are double
+// tensors. The mode follows the GradMode pattern: scope it with
+// AutoFastMathMode around the model (or layers) that tolerate it.
+struct CAFFE2_API FastMathMode {
+  static bool is_enabled();
+  static void set_enabled(bool enabled);
+};
+
+// A RAII, thread local guard that selects the accuracy tier upon
+// construction, and sets it back to the original value upon destruction.
+struct CAFFE2_API AutoFastMathMode {
+  AutoFastMathMode(bool enabled) : prev_mode(FastMathMode::is_enabled()) {
+    FastMathMode::set_enabled(enabled);
+  }
+  ~AutoFastMathMode() {
+    FastMathMode::set_enabled(prev_mode);
+  }
+  bool prev_mode;
+};
+
+} // namespace at
@@ -19,6 +19,13 @@ const std::string& domain_prefix() {
 }
 
 Symbol InternedStrings::symbol(const std::string& s) {
+  // Builtin symbols resolve through an immutable table without taking
+  // the lock; see Note [Builtin symbol fast path] in
+  // register_symbols.cpp. Only custom symbols reach the map below.
+  const auto builtin = detail::lookup_builtin_symbol(s);
+  if (builtin) {
+    return *builtin;
+  }
   std::lock_guard<std::mutex> guard(mutex_);
   return _symbol(s);
 }
@@ -86,6 +86,7 @@ namespace c10 {
   _(prim, fork)                    \
   _(prim, RaiseException)          \
   _(prim, Function)                \
+  _(prim, CallFunction)            \
   _(prim, CreateObject)            \
   _(prim, SetAttr)                 \
   _(prim, GetAttr)                 \
@@ -183,7 +184,8 @@ namespace c10 {
   _(attr, beg)                     \
   _(attr, idx)                     \
   _(attr, split)                   \
-  _(attr, slot)
+  _(attr, slot)                    \
+  _(attr, fn)
 #else
 #define FORALL_NS_SYMBOLS(_) \
   _(namespaces, prim)              \
@@ -8,9 +8,17 @@
 #include <vector>
 #include <ATen/core/interned_strings.h>
 #include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
 
 namespace c10 {
 
+namespace detail {
+// Lock-free lookup of a builtin symbol by its qualified name; nullopt
+// for strings that are not builtins. See Note [Builtin symbol fast
+// path] in register_symbols.cpp.
+CAFFE2_API c10::optional<Symbol> lookup_builtin_symbol(const std::string& s);
+} // namespace detail
+
 struct CAFFE2_API InternedStrings {
   InternedStrings();
   Symbol symbol(const std::string& s);
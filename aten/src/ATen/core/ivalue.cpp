@@ -11,6 +11,84 @@ CAFFE2_API c10::intrusive_ptr<ConstantString> ConstantString::create(
   return c10::make_intrusive<ConstantString>(std::move(str_));
 }
 
+namespace {
+
+// See Note [Small tuple recycling] in ivalue.h. Both pools are bounded and
+// thread-local; cross-thread tuples simply retire into whichever thread
+// destroys them.
+constexpr size_t kSmallTupleSize = 4;
+constexpr size_t kTuplePoolCapacity = 128;
+
+struct TuplePool {
+  std::vector<void*> blocks;
+  std::vector<std::vector<IValue>> buffers;
+  ~TuplePool() {
+    for (void* block : blocks) {
+      ::operator delete(block);
+    }
+  }
+};
+
+TuplePool& tuplePool() {
+  static thread_local TuplePool pool;
+  return pool;
+}
+
+} // namespace
+
+void* Tuple::operator new(size_t size) {
+  // Tuple is final, so every block that retires through our operator
+  // delete has exactly this size.
+  auto& pool = tuplePool();
+  if (size == sizeof(Tuple) && !pool.blocks.empty()) {
+    void* ptr = pool.blocks.back();
+    pool.blocks.pop_back();
+    return ptr;
+  }
+  return ::operator new(size);
+}
+
+void Tuple::operator delete(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto& pool = tuplePool();
+  if (pool.blocks.size() < kTuplePoolCapacity) {
+    pool.blocks.push_back(ptr);
+    return;
+  }
+  ::operator delete(ptr);
+}
+
+void Tuple::release_resources() {
+  auto& elems = elements();
+  auto& pool = tuplePool();
+  if (elems.capacity() > 0 && elems.capacity() <= kSmallTupleSize &&
+      pool.buffers.size() < kTuplePoolCapacity) {
+    // Destroy the contained values now (that is this method's contract)
+    // but keep the buffer for the next small tuple.
+    elems.clear();
+    pool.buffers.emplace_back(std::move(elems));
+  } else {
+    std::vector<IValue>().swap(elems);
+  }
+}
+
+c10::intrusive_ptr<Tuple> Tuple::create(IValue* elements, size_t num) {
+  std::vector<IValue> elems;
+  auto& pool = tuplePool();
+  if (num <= kSmallTupleSize && !pool.buffers.empty()) {
+    elems = std::move(pool.buffers.back());
+    pool.buffers.pop_back();
+  } else {
+    elems.reserve(num);
+  }
+  for (size_t i = 0; i < num; i++) {
+    elems.emplace_back(std::move(elements[i]));
+  }
+  return create(std::move(elems));
+}
+
 } // namespace ivalue
 
 namespace {
@@ -84,11 +84,32 @@ using UnorderedMap = std::unordered_map<IValue, IValue, DictHash, DictEqualTo>;
 struct Future;
 struct GenericDict;
 
-struct CAFFE2_API Tuple : public List<IValue> {
+// Note [Small tuple recycling]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// TorchScript shuffles 2-4 element tuples on practically every op call,
+// and each one used to cost two heap round trips: the Tuple object and
+// its element vector's buffer. Storing small payloads inline in IValue
+// itself is off the table -- IValue is a 16-byte tagged union and
+// toTuple() hands out intrusive_ptrs that must stay valid independently
+// of the IValue -- so instead both allocations are recycled through
+// bounded thread-local pools: operator new/delete below reuse Tuple-sized
+// blocks, and release_resources() donates small element buffers (their
+// capacity intact) for the pointer-range create() overload to pick up.
+// After warmup, constructing and destroying small tuples never touches
+// the allocator.
+struct CAFFE2_API Tuple final : public List<IValue> {
   using List<IValue>::List;
   static c10::intrusive_ptr<Tuple> create(std::vector<IValue> elements_) {
     return c10::make_intrusive<Tuple>(std::move(elements_));
   }
+  // Moves [elements, elements + num) into the tuple, reusing a pooled
+  // element buffer when num is small. This is the interpreter's path for
+  // building tuples straight off the stack.
+  static c10::intrusive_ptr<Tuple> create(IValue* elements, size_t num);
+
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+  void release_resources() override;
 };
 using IntList = List<int64_t>;
 using TensorList = List<at::Tensor>;
@@ -186,6 +207,19 @@ struct CAFFE2_API IValue final {
     std::swap(tag, rhs.tag);
   }
 
+  // Transfers ownership of the held heap object (if any) to the caller
+  // without touching its refcount and leaves this IValue as None. The
+  // interpreter uses this to retire a whole register file with one
+  // refcount update per distinct object: pair every non-null result with
+  // c10::raw::intrusive_ptr::decref_n, or reclaim it into a smart
+  // pointer.
+  c10::intrusive_ptr_target* unsafeReleaseIntrusivePtr() {
+    c10::intrusive_ptr_target* p =
+        is_intrusive_ptr ? payload.as_intrusive_ptr : nullptr;
+    clearToNone();
+    return p;
+  }
+
   // Accessors for subtypes are arranged together below
   // While some of these accessors could be generated through templates,
   // we prefer to write them manually for clarity
@@ -1,5 +1,7 @@
 #include <ATen/core/interned_strings_class.h>
 
+#include <algorithm>
+
 namespace c10 {
 
 namespace {
@@ -18,8 +20,82 @@ constexpr Entry entries[] = {
 #undef SYMBOL_ENTRY
 };
 
+// Note [Builtin symbol fast path]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Symbol::fromQualString is on the hot path of graph construction --
+// attribute lookup and schema matching both intern their strings -- and
+// it used to funnel every call through a mutex-protected
+// unordered_map<std::string, Symbol>. The full builtin symbol set is
+// known at compile time (it is exactly `entries` above, expanded from
+// FORALL_NS_SYMBOLS), so we build a fixed open-addressed table over it
+// once during static initialization and probe it without taking any
+// lock: the table is immutable after construction, and a miss -- a
+// custom symbol -- falls back to the locked map. The table is sized to
+// the power of two at least twice the symbol count, which keeps linear
+// probe chains short.
+
+constexpr size_t kSymbolCount = sizeof(entries) / sizeof(entries[0]);
+
+constexpr size_t round_up_pow2(size_t min, size_t candidate = 1) {
+  return candidate >= min ? candidate : round_up_pow2(min, candidate * 2);
+}
+
+constexpr size_t kTableSize = round_up_pow2(kSymbolCount * 2);
+
+// FNV-1a over the qualified name
+uint64_t hash_qual_name(const char* s) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (; *s != '\0'; ++s) {
+    h = (h ^ static_cast<uint8_t>(*s)) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+struct BuiltinSymbolTable {
+  const Entry* slots[kTableSize];
+
+  BuiltinSymbolTable() {
+    std::fill(slots, slots + kTableSize, nullptr);
+    for (const auto& entry : entries) {
+      size_t idx = hash_qual_name(entry.qual_name) & (kTableSize - 1);
+      while (slots[idx] != nullptr) {
+        idx = (idx + 1) & (kTableSize - 1);
+      }
+      slots[idx] = &entry;
+    }
+  }
+
+  const Entry* find(const char* qual_name) const {
+    size_t idx = hash_qual_name(qual_name) & (kTableSize - 1);
+    while (slots[idx] != nullptr) {
+      if (strcmp(slots[idx]->qual_name, qual_name) == 0) {
+        return slots[idx];
+      }
+      idx = (idx + 1) & (kTableSize - 1);
+    }
+    return nullptr;
+  }
+};
+
+const BuiltinSymbolTable& builtinSymbolTable() {
+  static const BuiltinSymbolTable table;
+  return table;
+}
+
 } // namespace
 
+namespace detail {
+
+c10::optional<Symbol> lookup_builtin_symbol(const std::string& s) {
+  const Entry* entry = builtinSymbolTable().find(s.c_str());
+  if (entry == nullptr) {
+    return c10::nullopt;
+  }
+  return entry->sym;
+}
+
+} // namespace detail
+
 InternedStrings::InternedStrings()
     : sym_to_info_(static_cast<size_t>(_keys::num_symbols)) {
   // Instead of a loop, this could be done by expanding the
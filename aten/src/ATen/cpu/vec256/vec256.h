@@ -4,8 +4,14 @@
 
 #include <ATen/cpu/vec256/vec256_base.h>
 #include <ATen/cpu/vec256/vec256_float.h>
+#include <ATen/cpu/vec256/vec256_bfloat16.h>
+#include <ATen/cpu/vec256/vec256_half.h>
 #include <ATen/cpu/vec256/vec256_double.h>
 #include <ATen/cpu/vec256/vec256_int.h>
+#ifdef CPU_CAPABILITY_AVX512
+#include <ATen/cpu/vec256/vec512_base.h>
+#include <ATen/cpu/vec256/vec512_float.h>
+#endif
 
 #include <algorithm>
 #include <cstddef>
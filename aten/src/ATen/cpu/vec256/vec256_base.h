@@ -1,11 +1,14 @@
 #pragma once
 
 #include <cstring>
+#include <cstdint>
 #include <functional>
 #include <cmath>
 #include <type_traits>
 #include <bitset>
 
+#include <ATen/cpu/vec256/intrinsics.h>
+
 #include <ATen/Utils.h>
 #include <ATen/native/Copy.h>
 #include <ATen/NumericUtils.h>
@@ -153,6 +156,14 @@ public:
   void store(void* ptr, int count = size()) const {
     std::memcpy(ptr, values, count * sizeof(T));
   }
+  // Streaming store for destinations that won't be re-read soon. The base
+  // version is an ordinary store; the ISA headers use true non-temporal
+  // stores when the pointer is aligned and the store is full width. A
+  // kernel issuing these must call store_fence() before its results may
+  // be read.
+  void store_nontemporal(void* ptr, int count = size()) const {
+    store(ptr, count);
+  }
   const T& operator[](int idx) const {
     return values[idx];
   }
@@ -254,6 +265,13 @@ public:
   Vec256<T> rsqrt() const {
     return map([](T x) { return 1 / std::sqrt(x); });
   }
+  Vec256<T> atan2(const Vec256<T> &exp) const {
+    Vec256<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = std::atan2(values[i], exp[i]);
+    }
+    return ret;
+  }
   Vec256<T> pow(const Vec256<T> &exp) const {
     Vec256<T> ret;
     for (int64_t i = 0; i < size(); i++) {
@@ -283,6 +301,23 @@ public:
 
 };
 
+// Software prefetch and the fence required after non-temporal stores.
+// Plain functions (not members) because they are about addresses, not
+// lanes. The x86 versions are available from SSE on, which every AVX
+// capability implies; elsewhere they are no-ops, matching the base
+// store_nontemporal falling back to a plain store.
+#if defined(__SSE__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+inline void prefetch(const void* addr) {
+  _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0);
+}
+inline void store_fence() {
+  _mm_sfence();
+}
+#else
+inline void prefetch(const void* /*addr*/) {}
+inline void store_fence() {}
+#endif
+
 template <class T> Vec256<T> inline operator+(const Vec256<T> &a, const Vec256<T> &b) {
   Vec256<T> c = Vec256<T>();
   for (int i = 0; i != Vec256<T>::size(); i++) {
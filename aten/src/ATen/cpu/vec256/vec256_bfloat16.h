@@ -0,0 +1,303 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#include <ATen/cpu/vec256/vec256_float.h>
+#include <c10/util/BFloat16.h>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(__AVX2__) && !defined(_MSC_VER)
+
+// Conversion between a register of 16 bfloat16 values and two registers of
+// 8 float values.  A bfloat16 is the upper half of a float32, so widening is
+// a shift and narrowing is a shift with a round-to-nearest-even bias; both
+// stay entirely in vector registers.  Kernels instantiated for BFloat16 do
+// their arithmetic in float and only touch memory in bfloat16, which is where
+// the bandwidth savings come from.
+
+static inline void cvtbf16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
+  __m128i lo = _mm256_extractf128_si256(a, 0);
+  __m128i hi = _mm256_extractf128_si256(a, 1);
+  o1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(lo), 16));
+  o2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(hi), 16));
+}
+
+static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
+  __m256i lo = _mm256_castps_si256(a);
+  __m256i hi = _mm256_castps_si256(b);
+  __m256i nan = _mm256_set1_epi32(0xffff);
+  __m256i mask_lo = _mm256_castps_si256(_mm256_cmp_ps(a, a, _CMP_ORD_Q));
+  __m256i mask_hi = _mm256_castps_si256(_mm256_cmp_ps(b, b, _CMP_ORD_Q));
+  __m256i ones = _mm256_set1_epi32(0x1);
+  __m256i vec_bias = _mm256_set1_epi32(0x7fff);
+  // uint32_t lsb = (input >> 16) & 1;
+  __m256i t_lo = _mm256_and_si256(_mm256_srli_epi32(lo, 16), ones);
+  __m256i t_hi = _mm256_and_si256(_mm256_srli_epi32(hi, 16), ones);
+  // uint32_t rounding_bias = 0x7fff + lsb;
+  t_lo = _mm256_add_epi32(t_lo, vec_bias);
+  t_hi = _mm256_add_epi32(t_hi, vec_bias);
+  // input += rounding_bias;
+  t_lo = _mm256_add_epi32(t_lo, lo);
+  t_hi = _mm256_add_epi32(t_hi, hi);
+  // input = input >> 16;
+  t_lo = _mm256_srli_epi32(t_lo, 16);
+  t_hi = _mm256_srli_epi32(t_hi, 16);
+  // Check NaN before converting back to bf16
+  t_lo = _mm256_blendv_epi8(nan, t_lo, mask_lo);
+  t_hi = _mm256_blendv_epi8(nan, t_hi, mask_hi);
+
+  t_lo = _mm256_packus_epi32(t_lo, t_hi); // t_hi[4-7] t_lo[4-7] t_hi[0-4] t_lo[0-4]
+  return _mm256_permute4x64_epi64(t_lo, 0xd8); // 11 01 10 00
+}
+
+template <> class Vec256<BFloat16> {
+private:
+  __m256i values;
+public:
+  static constexpr int size() {
+    return 16;
+  }
+  Vec256() {}
+  Vec256(__m256i v) : values(v) {}
+  Vec256(BFloat16 val) {
+    values = _mm256_set1_epi16(val.x);
+  }
+  operator __m256i() const {
+    return values;
+  }
+  static Vec256<BFloat16> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    __at_align32__ int16_t tmp_values[size()] = {0};
+    std::memcpy(tmp_values, ptr, count * sizeof(BFloat16));
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tmp_values));
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), values);
+    } else if (count > 0) {
+      __at_align32__ int16_t tmp_values[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp_values), values);
+      std::memcpy(ptr, tmp_values, count * sizeof(BFloat16));
+    }
+  }
+  static Vec256<BFloat16> blendv(const Vec256<BFloat16>& a,
+                                 const Vec256<BFloat16>& b,
+                                 const Vec256<BFloat16>& mask) {
+    return _mm256_blendv_epi8(a.values, b.values, mask.values);
+  }
+  static Vec256<BFloat16> set(const Vec256<BFloat16>& a,
+                              const Vec256<BFloat16>& b,
+                              int64_t count = size()) {
+    __at_align32__ int16_t tmp_values[size()];
+    a.store(tmp_values);
+    __at_align32__ int16_t b_values[size()];
+    b.store(b_values);
+    for (int64_t i = 0; i < count; i++) {
+      tmp_values[i] = b_values[i];
+    }
+    return loadu(tmp_values);
+  }
+  const BFloat16& operator[](int idx) const  = delete;
+  BFloat16& operator[](int idx) = delete;
+  Vec256<BFloat16> map(Vec256<float> (*vop)(Vec256<float>)) const {
+    __m256 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = vop(Vec256<float>(lo));
+    auto o2 = vop(Vec256<float>(hi));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> abs() const {
+    // bfloat16 shares the float32 layout, so clearing the sign bit of the
+    // 16-bit pattern is exact and avoids the float round trip.
+    return _mm256_andnot_si256(_mm256_set1_epi16((int16_t)0x8000), values);
+  }
+  Vec256<BFloat16> neg() const {
+    return _mm256_xor_si256(_mm256_set1_epi16((int16_t)0x8000), values);
+  }
+  Vec256<BFloat16> acos() const {
+    return map([](Vec256<float> x) { return x.acos(); });
+  }
+  Vec256<BFloat16> asin() const {
+    return map([](Vec256<float> x) { return x.asin(); });
+  }
+  Vec256<BFloat16> atan() const {
+    return map([](Vec256<float> x) { return x.atan(); });
+  }
+  Vec256<BFloat16> erf() const {
+    return map([](Vec256<float> x) { return x.erf(); });
+  }
+  Vec256<BFloat16> erfc() const {
+    return map([](Vec256<float> x) { return x.erfc(); });
+  }
+  Vec256<BFloat16> exp() const {
+    return map([](Vec256<float> x) { return x.exp(); });
+  }
+  Vec256<BFloat16> expm1() const {
+    return map([](Vec256<float> x) { return x.expm1(); });
+  }
+  Vec256<BFloat16> log() const {
+    return map([](Vec256<float> x) { return x.log(); });
+  }
+  Vec256<BFloat16> log2() const {
+    return map([](Vec256<float> x) { return x.log2(); });
+  }
+  Vec256<BFloat16> log10() const {
+    return map([](Vec256<float> x) { return x.log10(); });
+  }
+  Vec256<BFloat16> log1p() const {
+    return map([](Vec256<float> x) { return x.log1p(); });
+  }
+  Vec256<BFloat16> sin() const {
+    return map([](Vec256<float> x) { return x.sin(); });
+  }
+  Vec256<BFloat16> sinh() const {
+    return map([](Vec256<float> x) { return x.sinh(); });
+  }
+  Vec256<BFloat16> cos() const {
+    return map([](Vec256<float> x) { return x.cos(); });
+  }
+  Vec256<BFloat16> cosh() const {
+    return map([](Vec256<float> x) { return x.cosh(); });
+  }
+  Vec256<BFloat16> ceil() const {
+    return map([](Vec256<float> x) { return x.ceil(); });
+  }
+  Vec256<BFloat16> floor() const {
+    return map([](Vec256<float> x) { return x.floor(); });
+  }
+  Vec256<BFloat16> round() const {
+    return map([](Vec256<float> x) { return x.round(); });
+  }
+  Vec256<BFloat16> tan() const {
+    return map([](Vec256<float> x) { return x.tan(); });
+  }
+  Vec256<BFloat16> tanh() const {
+    return map([](Vec256<float> x) { return x.tanh(); });
+  }
+  Vec256<BFloat16> trunc() const {
+    return map([](Vec256<float> x) { return x.trunc(); });
+  }
+  Vec256<BFloat16> sqrt() const {
+    return map([](Vec256<float> x) { return x.sqrt(); });
+  }
+  Vec256<BFloat16> reciprocal() const {
+    return map([](Vec256<float> x) { return x.reciprocal(); });
+  }
+  Vec256<BFloat16> rsqrt() const {
+    return map([](Vec256<float> x) { return x.rsqrt(); });
+  }
+  Vec256<BFloat16> frac() const;
+  Vec256<BFloat16> pow(const Vec256<BFloat16>& b) const;
+  Vec256<BFloat16> operator==(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> operator!=(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> operator<(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> operator<=(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> operator>(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> operator>=(const Vec256<BFloat16>& other) const;
+};
+
+template <typename Op>
+Vec256<BFloat16> inline bfloat16_binary_op_as_fp32(
+    const Vec256<BFloat16>& a, const Vec256<BFloat16>& b, Op op) {
+  __m256 a_lo, a_hi;
+  __m256 b_lo, b_hi;
+  cvtbf16_fp32(__m256i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m256i(b), b_lo, b_hi);
+  auto o1 = op(Vec256<float>(a_lo), Vec256<float>(b_lo));
+  auto o2 = op(Vec256<float>(a_hi), Vec256<float>(b_hi));
+  return cvtfp32_bf16(o1, o2);
+}
+
+template <>
+Vec256<BFloat16> inline operator+(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x + y; });
+}
+
+template <>
+Vec256<BFloat16> inline operator-(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x - y; });
+}
+
+template <>
+Vec256<BFloat16> inline operator*(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x * y; });
+}
+
+template <>
+Vec256<BFloat16> inline operator/(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x / y; });
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::frac() const {
+  return *this - this->trunc();
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::pow(const Vec256<BFloat16>& b) const {
+  return bfloat16_binary_op_as_fp32(*this, b, [](Vec256<float> x, Vec256<float> y) { return x.pow(y); });
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::operator==(const Vec256<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x == y; });
+}
+Vec256<BFloat16> Vec256<BFloat16>::operator!=(const Vec256<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x != y; });
+}
+Vec256<BFloat16> Vec256<BFloat16>::operator<(const Vec256<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x < y; });
+}
+Vec256<BFloat16> Vec256<BFloat16>::operator<=(const Vec256<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x <= y; });
+}
+Vec256<BFloat16> Vec256<BFloat16>::operator>(const Vec256<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x > y; });
+}
+Vec256<BFloat16> Vec256<BFloat16>::operator>=(const Vec256<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x >= y; });
+}
+
+template <>
+Vec256<BFloat16> inline maximum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return maximum(x, y); });
+}
+
+template <>
+Vec256<BFloat16> inline minimum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return minimum(x, y); });
+}
+
+template <>
+void convert(const BFloat16* src, float* dst, int64_t n) {
+  int64_t i;
+  for (i = 0; i + Vec256<BFloat16>::size() <= n; i += Vec256<BFloat16>::size()) {
+    __m256 lo, hi;
+    cvtbf16_fp32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), lo, hi);
+    _mm256_storeu_ps(dst + i, lo);
+    _mm256_storeu_ps(dst + i + 8, hi);
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+void convert(const float* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+  for (i = 0; i + Vec256<BFloat16>::size() <= n; i += Vec256<BFloat16>::size()) {
+    __m256i bf = cvtfp32_bf16(
+        _mm256_loadu_ps(src + i), _mm256_loadu_ps(src + i + 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), bf);
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<BFloat16>(src[i]);
+  }
+}
+
+#endif
+
+}}}
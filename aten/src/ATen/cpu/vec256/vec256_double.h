@@ -76,6 +76,14 @@ public:
       std::memcpy(ptr, tmp_values, count * sizeof(double));
     }
   }
+  void store_nontemporal(void* ptr, int count = size()) const {
+    if (count == size() &&
+        (reinterpret_cast<uintptr_t>(ptr) & 0x1F) == 0) {
+      _mm256_stream_pd(reinterpret_cast<double*>(ptr), values);
+    } else {
+      store(ptr, count);
+    }
+  }
   const double& operator[](int idx) const  = delete;
   double& operator[](int idx) = delete;
   Vec256<double> map(double (*f)(double)) const {
@@ -124,16 +132,16 @@ public:
     return Vec256<double>(Sleef_log1pd4_u10(values));
   }
   Vec256<double> sin() const {
-    return map(std::sin);
+    return Vec256<double>(Sleef_sind4_u10(values));
   }
   Vec256<double> sinh() const {
-    return map(std::sinh);
+    return Vec256<double>(Sleef_sinhd4_u10(values));
   }
   Vec256<double> cos() const {
-    return map(std::cos);
+    return Vec256<double>(Sleef_cosd4_u10(values));
   }
   Vec256<double> cosh() const {
-    return map(std::cos);
+    return Vec256<double>(Sleef_coshd4_u10(values));
   }
   Vec256<double> ceil() const {
     return _mm256_ceil_pd(values);
@@ -149,7 +157,7 @@ public:
     return _mm256_round_pd(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
   }
   Vec256<double> tan() const {
-    return map(std::tan);
+    return Vec256<double>(Sleef_tand4_u10(values));
   }
   Vec256<double> tanh() const {
     return Vec256<double>(Sleef_tanhd4_u10(values));
@@ -166,6 +174,9 @@ public:
   Vec256<double> rsqrt() const {
     return _mm256_div_pd(_mm256_set1_pd(1), _mm256_sqrt_pd(values));
   }
+  Vec256<double> atan2(const Vec256<double> &b) const {
+    return Vec256<double>(Sleef_atan2d4_u10(values, b));
+  }
   Vec256<double> pow(const Vec256<double> &b) const {
     return Vec256<double>(Sleef_powd4_u10(values, b));
   }
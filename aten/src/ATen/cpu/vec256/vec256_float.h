@@ -84,6 +84,14 @@ public:
       std::memcpy(ptr, tmp_values, count * sizeof(float));
     }
   }
+  void store_nontemporal(void* ptr, int64_t count = size()) const {
+    if (count == size() &&
+        (reinterpret_cast<uintptr_t>(ptr) & 0x1F) == 0) {
+      _mm256_stream_ps(reinterpret_cast<float*>(ptr), values);
+    } else {
+      store(ptr, count);
+    }
+  }
   const float& operator[](int idx) const  = delete;
   float& operator[](int idx) = delete;
   Vec256<float> map(float (*f)(float)) const {
@@ -133,16 +141,16 @@ public:
   }
   Vec256<float> frac() const;
   Vec256<float> sin() const {
-    return map(std::sin);
+    return Vec256<float>(Sleef_sinf8_u10(values));
   }
   Vec256<float> sinh() const {
-    return map(std::sinh);
+    return Vec256<float>(Sleef_sinhf8_u10(values));
   }
   Vec256<float> cos() const {
-    return map(std::cos);
+    return Vec256<float>(Sleef_cosf8_u10(values));
   }
   Vec256<float> cosh() const {
-    return map(std::cosh);
+    return Vec256<float>(Sleef_coshf8_u10(values));
   }
   Vec256<float> ceil() const {
     return _mm256_ceil_ps(values);
@@ -157,7 +165,7 @@ public:
     return _mm256_round_ps(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
   }
   Vec256<float> tan() const {
-    return map(std::tan);
+    return Vec256<float>(Sleef_tanf8_u10(values));
   }
   Vec256<float> tanh() const {
     return Vec256<float>(Sleef_tanhf8_u10(values));
@@ -174,6 +182,9 @@ public:
   Vec256<float> rsqrt() const {
     return _mm256_div_ps(_mm256_set1_ps(1), _mm256_sqrt_ps(values));
   }
+  Vec256<float> atan2(const Vec256<float> &b) const {
+    return Vec256<float>(Sleef_atan2f8_u10(values, b));
+  }
   Vec256<float> pow(const Vec256<float> &b) const {
     return Vec256<float>(Sleef_powf8_u10(values, b));
   }
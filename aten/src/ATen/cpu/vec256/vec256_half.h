@@ -0,0 +1,282 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#include <ATen/cpu/vec256/vec256_float.h>
+#include <c10/util/Half.h>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(__AVX2__) && defined(__F16C__) && !defined(_MSC_VER)
+
+// Conversion between a register of 16 fp16 values and two registers of 8
+// float values.  Unlike bfloat16 this is not a shift: VCVTPH2PS/VCVTPS2PH
+// (F16C, available on every AVX2 part) do the full IEEE widen/narrow in
+// hardware, including denormals and NaN, with round-to-nearest-even on the
+// way down.  Kernels instantiated for Half compute in float between these
+// conversions, so fp16 tensors get fp32 arithmetic at half the memory
+// traffic instead of the scalar bit-twiddling path in c10/util/Half-inl.h.
+
+static inline void cvtfp16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
+  __m128i lo = _mm256_extractf128_si256(a, 0);
+  __m128i hi = _mm256_extractf128_si256(a, 1);
+  o1 = _mm256_cvtph_ps(lo);
+  o2 = _mm256_cvtph_ps(hi);
+}
+
+static inline __m256i cvtfp32_fp16(const __m256& a, const __m256& b) {
+  __m128i lo = _mm256_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT);
+  __m128i hi = _mm256_cvtps_ph(b, _MM_FROUND_TO_NEAREST_INT);
+  return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+template <> class Vec256<Half> {
+private:
+  __m256i values;
+public:
+  static constexpr int size() {
+    return 16;
+  }
+  Vec256() {}
+  Vec256(__m256i v) : values(v) {}
+  Vec256(Half val) {
+    values = _mm256_set1_epi16(val.x);
+  }
+  operator __m256i() const {
+    return values;
+  }
+  static Vec256<Half> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    __at_align32__ int16_t tmp_values[size()] = {0};
+    std::memcpy(tmp_values, ptr, count * sizeof(Half));
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tmp_values));
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), values);
+    } else if (count > 0) {
+      __at_align32__ int16_t tmp_values[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp_values), values);
+      std::memcpy(ptr, tmp_values, count * sizeof(Half));
+    }
+  }
+  static Vec256<Half> blendv(const Vec256<Half>& a,
+                             const Vec256<Half>& b,
+                             const Vec256<Half>& mask) {
+    return _mm256_blendv_epi8(a.values, b.values, mask.values);
+  }
+  static Vec256<Half> set(const Vec256<Half>& a,
+                          const Vec256<Half>& b,
+                          int64_t count = size()) {
+    __at_align32__ int16_t tmp_values[size()];
+    a.store(tmp_values);
+    __at_align32__ int16_t b_values[size()];
+    b.store(b_values);
+    for (int64_t i = 0; i < count; i++) {
+      tmp_values[i] = b_values[i];
+    }
+    return loadu(tmp_values);
+  }
+  const Half& operator[](int idx) const  = delete;
+  Half& operator[](int idx) = delete;
+  Vec256<Half> map(Vec256<float> (*vop)(Vec256<float>)) const {
+    __m256 lo, hi;
+    cvtfp16_fp32(values, lo, hi);
+    auto o1 = vop(Vec256<float>(lo));
+    auto o2 = vop(Vec256<float>(hi));
+    return cvtfp32_fp16(o1, o2);
+  }
+  Vec256<Half> abs() const {
+    // fp16 is sign-magnitude like fp32, so masking off the top bit of the
+    // 16-bit pattern is exact; no conversion needed.
+    return _mm256_andnot_si256(_mm256_set1_epi16((int16_t)0x8000), values);
+  }
+  Vec256<Half> neg() const {
+    return _mm256_xor_si256(_mm256_set1_epi16((int16_t)0x8000), values);
+  }
+  Vec256<Half> acos() const {
+    return map([](Vec256<float> x) { return x.acos(); });
+  }
+  Vec256<Half> asin() const {
+    return map([](Vec256<float> x) { return x.asin(); });
+  }
+  Vec256<Half> atan() const {
+    return map([](Vec256<float> x) { return x.atan(); });
+  }
+  Vec256<Half> erf() const {
+    return map([](Vec256<float> x) { return x.erf(); });
+  }
+  Vec256<Half> erfc() const {
+    return map([](Vec256<float> x) { return x.erfc(); });
+  }
+  Vec256<Half> exp() const {
+    return map([](Vec256<float> x) { return x.exp(); });
+  }
+  Vec256<Half> expm1() const {
+    return map([](Vec256<float> x) { return x.expm1(); });
+  }
+  Vec256<Half> log() const {
+    return map([](Vec256<float> x) { return x.log(); });
+  }
+  Vec256<Half> log2() const {
+    return map([](Vec256<float> x) { return x.log2(); });
+  }
+  Vec256<Half> log10() const {
+    return map([](Vec256<float> x) { return x.log10(); });
+  }
+  Vec256<Half> log1p() const {
+    return map([](Vec256<float> x) { return x.log1p(); });
+  }
+  Vec256<Half> sin() const {
+    return map([](Vec256<float> x) { return x.sin(); });
+  }
+  Vec256<Half> sinh() const {
+    return map([](Vec256<float> x) { return x.sinh(); });
+  }
+  Vec256<Half> cos() const {
+    return map([](Vec256<float> x) { return x.cos(); });
+  }
+  Vec256<Half> cosh() const {
+    return map([](Vec256<float> x) { return x.cosh(); });
+  }
+  Vec256<Half> ceil() const {
+    return map([](Vec256<float> x) { return x.ceil(); });
+  }
+  Vec256<Half> floor() const {
+    return map([](Vec256<float> x) { return x.floor(); });
+  }
+  Vec256<Half> round() const {
+    return map([](Vec256<float> x) { return x.round(); });
+  }
+  Vec256<Half> tan() const {
+    return map([](Vec256<float> x) { return x.tan(); });
+  }
+  Vec256<Half> tanh() const {
+    return map([](Vec256<float> x) { return x.tanh(); });
+  }
+  Vec256<Half> trunc() const {
+    return map([](Vec256<float> x) { return x.trunc(); });
+  }
+  Vec256<Half> sqrt() const {
+    return map([](Vec256<float> x) { return x.sqrt(); });
+  }
+  Vec256<Half> reciprocal() const {
+    return map([](Vec256<float> x) { return x.reciprocal(); });
+  }
+  Vec256<Half> rsqrt() const {
+    return map([](Vec256<float> x) { return x.rsqrt(); });
+  }
+  Vec256<Half> frac() const;
+  Vec256<Half> pow(const Vec256<Half>& b) const;
+  Vec256<Half> operator==(const Vec256<Half>& other) const;
+  Vec256<Half> operator!=(const Vec256<Half>& other) const;
+  Vec256<Half> operator<(const Vec256<Half>& other) const;
+  Vec256<Half> operator<=(const Vec256<Half>& other) const;
+  Vec256<Half> operator>(const Vec256<Half>& other) const;
+  Vec256<Half> operator>=(const Vec256<Half>& other) const;
+};
+
+template <typename Op>
+Vec256<Half> inline half_binary_op_as_fp32(
+    const Vec256<Half>& a, const Vec256<Half>& b, Op op) {
+  __m256 a_lo, a_hi;
+  __m256 b_lo, b_hi;
+  cvtfp16_fp32(__m256i(a), a_lo, a_hi);
+  cvtfp16_fp32(__m256i(b), b_lo, b_hi);
+  auto o1 = op(Vec256<float>(a_lo), Vec256<float>(b_lo));
+  auto o2 = op(Vec256<float>(a_hi), Vec256<float>(b_hi));
+  return cvtfp32_fp16(o1, o2);
+}
+
+template <>
+Vec256<Half> inline operator+(const Vec256<Half>& a, const Vec256<Half>& b) {
+  return half_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x + y; });
+}
+
+template <>
+Vec256<Half> inline operator-(const Vec256<Half>& a, const Vec256<Half>& b) {
+  return half_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x - y; });
+}
+
+template <>
+Vec256<Half> inline operator*(const Vec256<Half>& a, const Vec256<Half>& b) {
+  return half_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x * y; });
+}
+
+template <>
+Vec256<Half> inline operator/(const Vec256<Half>& a, const Vec256<Half>& b) {
+  return half_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return x / y; });
+}
+
+Vec256<Half> Vec256<Half>::frac() const {
+  return *this - this->trunc();
+}
+
+Vec256<Half> Vec256<Half>::pow(const Vec256<Half>& b) const {
+  return half_binary_op_as_fp32(*this, b, [](Vec256<float> x, Vec256<float> y) { return x.pow(y); });
+}
+
+Vec256<Half> Vec256<Half>::operator==(const Vec256<Half>& other) const {
+  return half_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x == y; });
+}
+Vec256<Half> Vec256<Half>::operator!=(const Vec256<Half>& other) const {
+  return half_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x != y; });
+}
+Vec256<Half> Vec256<Half>::operator<(const Vec256<Half>& other) const {
+  return half_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x < y; });
+}
+Vec256<Half> Vec256<Half>::operator<=(const Vec256<Half>& other) const {
+  return half_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x <= y; });
+}
+Vec256<Half> Vec256<Half>::operator>(const Vec256<Half>& other) const {
+  return half_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x > y; });
+}
+Vec256<Half> Vec256<Half>::operator>=(const Vec256<Half>& other) const {
+  return half_binary_op_as_fp32(*this, other, [](Vec256<float> x, Vec256<float> y) { return x >= y; });
+}
+
+template <>
+Vec256<Half> inline maximum(const Vec256<Half>& a, const Vec256<Half>& b) {
+  return half_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return maximum(x, y); });
+}
+
+template <>
+Vec256<Half> inline minimum(const Vec256<Half>& a, const Vec256<Half>& b) {
+  return half_binary_op_as_fp32(a, b, [](Vec256<float> x, Vec256<float> y) { return minimum(x, y); });
+}
+
+template <>
+void convert(const Half* src, float* dst, int64_t n) {
+  int64_t i;
+  for (i = 0; i + Vec256<Half>::size() <= n; i += Vec256<Half>::size()) {
+    __m256 lo, hi;
+    cvtfp16_fp32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), lo, hi);
+    _mm256_storeu_ps(dst + i, lo);
+    _mm256_storeu_ps(dst + i + 8, hi);
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+void convert(const float* src, Half* dst, int64_t n) {
+  int64_t i;
+  for (i = 0; i + Vec256<Half>::size() <= n; i += Vec256<Half>::size()) {
+    __m256i f16 = cvtfp32_fp16(
+        _mm256_loadu_ps(src + i), _mm256_loadu_ps(src + i + 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), f16);
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<Half>(src[i]);
+  }
+}
+
+#endif
+
+}}}
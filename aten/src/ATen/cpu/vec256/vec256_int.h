@@ -88,6 +88,14 @@ struct Vec256<int64_t> : public Vec256i {
       std::memcpy(ptr, tmp_values, count * sizeof(int64_t));
     }
   }
+  void store_nontemporal(void* ptr, int count = size()) const {
+    if (count == size() &&
+        (reinterpret_cast<uintptr_t>(ptr) & 0x1F) == 0) {
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(ptr), values);
+    } else {
+      store(ptr, count);
+    }
+  }
   const int64_t& operator[](int idx) const  = delete;
   int64_t& operator[](int idx)  = delete;
   Vec256<int64_t> abs() const {
@@ -182,6 +190,14 @@ struct Vec256<int32_t> : public Vec256i {
       std::memcpy(ptr, tmp_values, count * sizeof(int32_t));
     }
   }
+  void store_nontemporal(void* ptr, int count = size()) const {
+    if (count == size() &&
+        (reinterpret_cast<uintptr_t>(ptr) & 0x1F) == 0) {
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(ptr), values);
+    } else {
+      store(ptr, count);
+    }
+  }
   const int32_t& operator[](int idx) const  = delete;
   int32_t& operator[](int idx)  = delete;
   Vec256<int32_t> abs() const {
@@ -368,6 +384,14 @@ struct Vec256<int16_t> : public Vec256i {
       std::memcpy(ptr, tmp_values, count * sizeof(int16_t));
     }
   }
+  void store_nontemporal(void* ptr, int count = size()) const {
+    if (count == size() &&
+        (reinterpret_cast<uintptr_t>(ptr) & 0x1F) == 0) {
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(ptr), values);
+    } else {
+      store(ptr, count);
+    }
+  }
   const int16_t& operator[](int idx) const  = delete;
   int16_t& operator[](int idx)  = delete;
   Vec256<int16_t> abs() const {
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+
+#include <ATen/Utils.h>
+#include <c10/util/C++17.h>
+
+// A 512-bit sibling of Vec256.  Vec512<T> holds twice as many lanes as
+// Vec256<T> and is only profitable on CPUs with AVX-512; kernels that want the
+// wider registers opt in explicitly under CPU_CAPABILITY_AVX512.  The
+// fallback implementation below mirrors vec256_base.h: a plain array that the
+// compiler may (but is not required to) auto-vectorize.
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+template <class T>
+struct Vec512 {
+private:
+  T values[64 / sizeof(T)] = {0};
+public:
+  static constexpr int size() {
+    return 64 / sizeof(T);
+  }
+  Vec512() {}
+  Vec512(T val) {
+    for (int i = 0; i != size(); i++) {
+      values[i] = val;
+    }
+  }
+  static Vec512<T> loadu(const void* ptr, int64_t count = size()) {
+    Vec512 vec;
+    std::memcpy(vec.values, ptr, count * sizeof(T));
+    return vec;
+  }
+  void store(void* ptr, int count = size()) const {
+    std::memcpy(ptr, values, count * sizeof(T));
+  }
+  const T& operator[](int idx) const {
+    return values[idx];
+  }
+  T& operator[](int idx) {
+    return values[idx];
+  }
+  Vec512<T> map(T (*f)(T)) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i != size(); i++) {
+      ret[i] = f(values[i]);
+    }
+    return ret;
+  }
+  Vec512<T> abs() const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = values[i] < 0 ? -values[i] : values[i];
+    }
+    return ret;
+  }
+  Vec512<T> exp() const {
+    return map(std::exp);
+  }
+  Vec512<T> log() const {
+    return map(std::log);
+  }
+  Vec512<T> neg() const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = -values[i];
+    }
+    return ret;
+  }
+  Vec512<T> sqrt() const {
+    return map(std::sqrt);
+  }
+  Vec512<T> tanh() const {
+    return map(std::tanh);
+  }
+};
+
+#define DEFINE_VEC512_BINARY_OP(op)                                        \
+template <class T> Vec512<T> inline operator op(                           \
+    const Vec512<T>& a, const Vec512<T>& b) {                              \
+  Vec512<T> c;                                                             \
+  for (int i = 0; i != Vec512<T>::size(); i++) {                           \
+    c[i] = a[i] op b[i];                                                   \
+  }                                                                        \
+  return c;                                                                \
+}
+
+DEFINE_VEC512_BINARY_OP(+)
+DEFINE_VEC512_BINARY_OP(-)
+DEFINE_VEC512_BINARY_OP(*)
+DEFINE_VEC512_BINARY_OP(/)
+
+#undef DEFINE_VEC512_BINARY_OP
+
+template <class T>
+Vec512<T> inline maximum(const Vec512<T>& a, const Vec512<T>& b) {
+  Vec512<T> c;
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (a[i] > b[i]) ? a[i] : b[i];
+    if (std::is_floating_point<T>::value && std::isnan(a[i])) {
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+template <class T>
+Vec512<T> inline minimum(const Vec512<T>& a, const Vec512<T>& b) {
+  Vec512<T> c;
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (a[i] < b[i]) ? a[i] : b[i];
+    if (std::is_floating_point<T>::value && std::isnan(a[i])) {
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+template <class T>
+Vec512<T> inline fmadd(const Vec512<T>& a, const Vec512<T>& b, const Vec512<T>& c) {
+  return a * b + c;
+}
+
+}}} // namespace at::vec256::<anonymous>
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ATen/AdaptiveGrain.h>
 #include <ATen/Config.h>
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/functional.h>
@@ -55,7 +56,10 @@ using namespace vec256;
 
 template <typename scalar_t>
 inline void vrsqrt(scalar_t* out, scalar_t* in, int64_t size) {
-  parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) {
+  // See Note [Adaptive grain size]: one tracker per op family, so cheap
+  // and expensive functions stop sharing one grain.
+  static GrainSizeTracker tracker("vrsqrt");
+  adaptive_parallel_for(tracker, 0, size, [out, in](int64_t begin, int64_t end) {
     map(
         [](const Vec256<scalar_t>& x) {
           return Vec256<scalar_t>((scalar_t)(1)) / x.sqrt();
@@ -74,27 +78,31 @@ inline void vrsqrt(scalar_t* out, scalar_t* in, int64_t size) {
 // this. This duplication is also necessary since not all functions (e.g. rsqrt)
 // might be part of cmath.
 
-#define IMPLEMENT_VML_BUG(op)                                          \
-  template <typename scalar_t>                                          \
-  inline void v##op(scalar_t* out, const scalar_t* in, int64_t size) {  \
-    DL_RUNTIME_BUG(op, scalar_t)                                        \
-    parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) { \
-      map([](const Vec256<scalar_t>& x) { return x.op(); },             \
-          out + begin,                                                  \
-          in + begin,                                                   \
-          end - begin);                                                 \
-    });                                                                 \
+#define IMPLEMENT_VML_BUG(op)                                                \
+  template <typename scalar_t>                                               \
+  inline void v##op(scalar_t* out, const scalar_t* in, int64_t size) {       \
+    DL_RUNTIME_BUG(op, scalar_t)                                             \
+    static GrainSizeTracker tracker("v" #op);                                \
+    adaptive_parallel_for(                                                   \
+        tracker, 0, size, [out, in](int64_t begin, int64_t end) {            \
+          map([](const Vec256<scalar_t>& x) { return x.op(); },              \
+              out + begin,                                                   \
+              in + begin,                                                    \
+              end - begin);                                                  \
+        });                                                                  \
   }
 
-#define IMPLEMENT_VML(op)                                              \
-  template <typename scalar_t>                                          \
-  inline void v##op(scalar_t* out, const scalar_t* in, int64_t size) {  \
-    parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) { \
-      map([](const Vec256<scalar_t>& x) { return x.op(); },             \
-          out + begin,                                                  \
-          in + begin,                                                   \
-          end - begin);                                                 \
-    });                                                                 \
+#define IMPLEMENT_VML(op)                                                    \
+  template <typename scalar_t>                                               \
+  inline void v##op(scalar_t* out, const scalar_t* in, int64_t size) {       \
+    static GrainSizeTracker tracker("v" #op);                                \
+    adaptive_parallel_for(                                                   \
+        tracker, 0, size, [out, in](int64_t begin, int64_t end) {            \
+          map([](const Vec256<scalar_t>& x) { return x.op(); },              \
+              out + begin,                                                   \
+              in + begin,                                                    \
+              end - begin);                                                  \
+        });                                                                  \
   }
 
 IMPLEMENT_VML_BUG(abs)
@@ -0,0 +1,192 @@
+#include <ATen/cuda/BatchedCopy.h>
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/CUDAEvent.h>
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace at {
+namespace cuda {
+namespace {
+
+// Beyond this size a tensor is bandwidth-bound on its own and packing only
+// adds a round trip through the staging buffers.
+constexpr int64_t kMaxPackedCopyBytes = 1 << 20;
+constexpr int kPackBlockSize = 256;
+
+struct CopySegment {
+  const char* src;
+  char* dst;
+  int64_t nbytes;
+};
+
+// One block per segment; the segments are small, so a single block's worth
+// of 16-byte loads covers a segment in a few iterations.
+__global__ void copy_segments_kernel(const CopySegment* segments) {
+  const CopySegment seg = segments[blockIdx.x];
+  const auto addr_bits = reinterpret_cast<uintptr_t>(seg.src) |
+      reinterpret_cast<uintptr_t>(seg.dst) |
+      static_cast<uintptr_t>(seg.nbytes);
+  if ((addr_bits & 15) == 0) {
+    const auto* src = reinterpret_cast<const ulonglong2*>(seg.src);
+    auto* dst = reinterpret_cast<ulonglong2*>(seg.dst);
+    for (int64_t i = threadIdx.x; i < seg.nbytes / 16; i += blockDim.x) {
+      dst[i] = src[i];
+    }
+  } else {
+    for (int64_t i = threadIdx.x; i < seg.nbytes; i += blockDim.x) {
+      seg.dst[i] = seg.src[i];
+    }
+  }
+}
+
+// Uploads the segment table to `device_buffer` and runs the segment copy
+// kernel. The source of the host-to-device memcpy is pageable, which makes
+// the memcpy synchronous with respect to the host, so `segments` may die as
+// soon as this returns.
+void launch_segment_copies(
+    const std::vector<CopySegment>& segments,
+    Tensor& device_buffer,
+    CUDAStream stream) {
+  AT_CUDA_CHECK(cudaMemcpyAsync(
+      device_buffer.data_ptr(),
+      segments.data(),
+      segments.size() * sizeof(CopySegment),
+      cudaMemcpyHostToDevice,
+      stream));
+  copy_segments_kernel<<<segments.size(), kPackBlockSize, 0, stream>>>(
+      static_cast<const CopySegment*>(device_buffer.data_ptr()));
+  AT_CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace
+
+void batched_copy_(TensorList dsts, TensorList srcs) {
+  AT_CHECK(
+      dsts.size() == srcs.size(),
+      "batched_copy_: expected as many sources as destinations, got ",
+      srcs.size(), " sources and ", dsts.size(), " destinations");
+  if (dsts.empty()) {
+    return;
+  }
+
+  const Device dst_device = dsts[0].device();
+  const Device src_device = srcs[0].device();
+  for (size_t i = 0; i < dsts.size(); ++i) {
+    AT_CHECK(
+        srcs[i].is_cuda() && !srcs[i].is_sparse() && dsts[i].is_cuda() &&
+            !dsts[i].is_sparse(),
+        "batched_copy_: expected dense CUDA tensors");
+    AT_CHECK(
+        srcs[i].device() == src_device && dsts[i].device() == dst_device,
+        "batched_copy_: all sources must live on one device and all "
+        "destinations on one device");
+    AT_CHECK(
+        srcs[i].scalar_type() == dsts[i].scalar_type() &&
+            srcs[i].sizes().equals(dsts[i].sizes()),
+        "batched_copy_: pair ", i, " does not match in dtype or shape");
+  }
+
+  // Split the batch: only small contiguous same-device-pair copies profit
+  // from packing, everything else takes the regular copy path.
+  std::vector<size_t> packed;
+  std::vector<size_t> direct;
+  const bool cross_device = src_device != dst_device;
+  for (size_t i = 0; i < dsts.size(); ++i) {
+    const int64_t nbytes = srcs[i].numel() * srcs[i].element_size();
+    if (cross_device && srcs[i].is_contiguous() && dsts[i].is_contiguous() &&
+        nbytes > 0 && nbytes <= kMaxPackedCopyBytes) {
+      packed.push_back(i);
+    } else {
+      direct.push_back(i);
+    }
+  }
+
+  for (const auto i : direct) {
+    auto dst = dsts[i];
+    dst.copy_(srcs[i], /*non_blocking=*/true);
+  }
+  if (packed.size() < 2) {
+    for (const auto i : packed) {
+      auto dst = dsts[i];
+      dst.copy_(srcs[i], /*non_blocking=*/true);
+    }
+    return;
+  }
+
+  // 16-byte aligned layout of the staging buffers, so the segment kernel
+  // takes its vectorized path (the caching allocator over-aligns the
+  // buffers themselves).
+  std::vector<int64_t> offsets(packed.size());
+  int64_t total = 0;
+  for (size_t p = 0; p < packed.size(); ++p) {
+    offsets[p] = total;
+    const auto& src = srcs[packed[p]];
+    total += (src.numel() * src.element_size() + 15) / 16 * 16;
+  }
+
+  CUDAGuard device_guard(dst_device);
+  CUDAStream dst_stream = getCurrentCUDAStream(dst_device.index());
+  CUDAStream src_stream = getCurrentCUDAStream(src_device.index());
+
+  // As in the generic cross-device copy, the packed transfer runs on the
+  // source device's current stream after a two-way barrier with the
+  // destination stream, so pending work on the destination is ordered
+  // before the unpack overwrites it.
+  CUDAEvent dst_ready;
+  dst_ready.record(dst_stream);
+  device_guard.set_device(src_device);
+  dst_ready.block(src_stream);
+
+  const auto byte_options = at::device(src_device).dtype(at::kByte);
+  Tensor src_staging = at::empty({total}, byte_options);
+  Tensor src_table = at::empty(
+      {static_cast<int64_t>(packed.size() * sizeof(CopySegment))},
+      byte_options);
+  std::vector<CopySegment> segments(packed.size());
+  for (size_t p = 0; p < packed.size(); ++p) {
+    const auto& src = srcs[packed[p]];
+    segments[p] = {
+        static_cast<const char*>(src.data_ptr()),
+        static_cast<char*>(src_staging.data_ptr()) + offsets[p],
+        src.numel() * src.element_size()};
+  }
+  launch_segment_copies(segments, src_table, src_stream);
+
+  // One peer transfer for the whole batch. The destination staging buffer
+  // is only ever read on the destination stream after `packed_event`, so
+  // its stream-ordered reuse by the caching allocator is safe even though
+  // this write is enqueued on the source stream.
+  const auto dst_byte_options = at::device(dst_device).dtype(at::kByte);
+  Tensor dst_staging = at::empty({total}, dst_byte_options);
+  AT_CUDA_CHECK(cudaMemcpyPeerAsync(
+      dst_staging.data_ptr(),
+      dst_device.index(),
+      src_staging.data_ptr(),
+      src_device.index(),
+      total,
+      src_stream));
+  CUDAEvent packed_event;
+  packed_event.record(src_stream);
+
+  device_guard.set_device(dst_device);
+  packed_event.block(dst_stream);
+  Tensor dst_table = at::empty(
+      {static_cast<int64_t>(packed.size() * sizeof(CopySegment))},
+      dst_byte_options);
+  for (size_t p = 0; p < packed.size(); ++p) {
+    segments[p] = {
+        static_cast<const char*>(dst_staging.data_ptr()) + offsets[p],
+        static_cast<char*>(dsts[packed[p]].data_ptr()),
+        segments[p].nbytes};
+  }
+  launch_segment_copies(segments, dst_table, dst_stream);
+}
+
+} // namespace cuda
+} // namespace at
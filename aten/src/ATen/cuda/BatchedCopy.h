@@ -0,0 +1,27 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/ATenCUDAGeneral.h>
+
+namespace at {
+namespace cuda {
+
+/// Copies `srcs[i]` into `dsts[i]` for every pair, coalescing small
+/// device-to-device transfers between a single pair of GPUs into one packed
+/// peer transfer: the sources are packed into a staging buffer on the source
+/// device, moved with a single `cudaMemcpyPeerAsync`, and unpacked on the
+/// destination device. This turns thousands of launch-bound small copies
+/// into three launches, which matters when per-transfer launch overhead
+/// dominates bandwidth.
+///
+/// All sources must live on one CUDA device and all destinations on another;
+/// pairs must have matching dtypes and sizes. Pairs that do not profit from
+/// packing (large, non-contiguous, or dtype-converting copies, or copies
+/// within one device) fall back to the regular `Tensor::copy_` path.
+///
+/// The copy is asynchronous with respect to the host and is ordered on the
+/// current streams of both devices, like a regular cross-device `copy_`.
+AT_CUDA_API void batched_copy_(TensorList dsts, TensorList srcs);
+
+} // namespace cuda
+} // namespace at
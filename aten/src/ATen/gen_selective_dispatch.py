@@ -0,0 +1,68 @@
+import argparse
+
+# Generates the dtype allowlist header consumed by the selective dispatch
+# machinery in Dispatch.h (see Note [Selective dtype dispatch]). Point the
+# build at the generated file:
+#
+#   python gen_selective_dispatch.py -o my_dtype_allowlist.h Float Long
+#   ... -DAT_SELECTIVE_DTYPE_DISPATCH='"my_dtype_allowlist.h"'
+#
+# Every standard case of the AT_DISPATCH_* macros whose ScalarType is not
+# listed is then preprocessed out of the binary.
+
+# Keep in sync with the ScalarType names the dispatch macros stamp; these
+# are the short names used in AT_PRIVATE_CASE invocations.
+KNOWN_SCALAR_TYPES = [
+    'Byte',
+    'Char',
+    'Double',
+    'Float',
+    'Int',
+    'Long',
+    'Short',
+    'Half',
+    'BFloat16',
+    'Bool',
+    'ComplexHalf',
+    'ComplexFloat',
+    'ComplexDouble',
+]
+
+HEADER = """\
+#pragma once
+
+// @generated by aten/src/ATen/gen_selective_dispatch.py
+// Dtype allowlist for selective dispatch; see Note [Selective dtype
+// dispatch] in ATen/Dispatch.h. The "0," expansion is what the probe
+// there detects -- do not change it.
+
+"""
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generate a dtype allowlist header for selective dispatch')
+    parser.add_argument(
+        'dtypes',
+        nargs='+',
+        help='ScalarType short names to keep (e.g. Float Long)')
+    parser.add_argument(
+        '-o',
+        '--output',
+        required=True,
+        help='path of the header to write')
+    options = parser.parse_args()
+
+    for dtype in options.dtypes:
+        if dtype not in KNOWN_SCALAR_TYPES:
+            parser.error('unknown ScalarType {}; expected one of {}'.format(
+                dtype, ', '.join(KNOWN_SCALAR_TYPES)))
+
+    with open(options.output, 'w') as f:
+        f.write(HEADER)
+        for dtype in options.dtypes:
+            f.write('#define AT_SELECTIVE_DTYPE_{} 0,\n'.format(dtype))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,228 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+
+// Note [Beam search decoding primitives]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Beam search decoders written as TorchScript loops spend much of each
+// step in dispatch overhead rather than compute: a reshape + topk + div
+// + fmod to pick the next beams, an index_select per cached key/value
+// tensor to reorder decoder state, and a cat per cache to append the
+// new step. The ops in this file collapse those patterns:
+//  - _beam_topk fuses candidate flattening, selection and the
+//    decomposition of flat indices into (beam, token) pairs, without
+//    materializing the reshaped view or the intermediate index math;
+//  - _beam_gather_cache_ reorders a cache tensor along its beam
+//    dimension in place, so surviving-beam reordering is one op per
+//    cache instead of an index_select allocating a fresh tensor;
+//  - _beam_cache_append_ writes one decode step into a preallocated
+//    ring-buffer slot, replacing the cat that reallocates and copies
+//    the whole cache every step.
+// All three are inference primitives and do not participate in
+// autograd.
+
+namespace {
+
+// Descending insertion selection: k is the beam width (single digits in
+// practice), so a sorted array beats a heap and matches topk's
+// lower-index-wins tie behavior via the strict comparison.
+template <typename scalar_t>
+void beam_topk_row(
+    const scalar_t* row,
+    int64_t n,
+    int64_t k,
+    scalar_t* values,
+    int64_t* indices) {
+  int64_t filled = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    const scalar_t v = row[i];
+    if (filled == k && !(v > values[k - 1])) {
+      continue;
+    }
+    int64_t pos = filled < k ? filled : k - 1;
+    while (pos > 0 && v > values[pos - 1]) {
+      values[pos] = values[pos - 1];
+      indices[pos] = indices[pos - 1];
+      --pos;
+    }
+    values[pos] = v;
+    indices[pos] = i;
+    if (filled < k) {
+      ++filled;
+    }
+  }
+}
+
+} // namespace
+
+std::tuple<Tensor, Tensor, Tensor> beam_topk_cpu(
+    const Tensor& scores,
+    int64_t beam_size) {
+  AT_CHECK(
+      scores.dim() == 3,
+      "_beam_topk: expected scores of shape (batch, beam, vocab), got a ",
+      scores.dim(),
+      "-d tensor");
+  const int64_t batch = scores.size(0);
+  const int64_t beam = scores.size(1);
+  const int64_t vocab = scores.size(2);
+  const int64_t candidates = beam * vocab;
+  AT_CHECK(
+      beam_size > 0 && beam_size <= candidates,
+      "_beam_topk: beam_size ",
+      beam_size,
+      " out of range for ",
+      candidates,
+      " candidates");
+  auto scores_ = scores.contiguous();
+  auto values = at::empty({batch, beam_size}, scores.options());
+  auto tokens = at::empty({batch, beam_size}, scores.options().dtype(kLong));
+  auto beams = at::empty({batch, beam_size}, scores.options().dtype(kLong));
+  AT_DISPATCH_FLOATING_TYPES(scores.scalar_type(), "_beam_topk", [&] {
+    const scalar_t* scores_data = scores_.data<scalar_t>();
+    scalar_t* values_data = values.data<scalar_t>();
+    int64_t* tokens_data = tokens.data<int64_t>();
+    int64_t* beams_data = beams.data<int64_t>();
+    parallel_for(0, batch, 1, [&](int64_t begin, int64_t end) {
+      std::vector<int64_t> flat(beam_size);
+      for (int64_t b = begin; b < end; ++b) {
+        beam_topk_row(
+            scores_data + b * candidates,
+            candidates,
+            beam_size,
+            values_data + b * beam_size,
+            flat.data());
+        for (int64_t j = 0; j < beam_size; ++j) {
+          tokens_data[b * beam_size + j] = flat[j] % vocab;
+          beams_data[b * beam_size + j] = flat[j] / vocab;
+        }
+      }
+    });
+  });
+  return std::make_tuple(values, tokens, beams);
+}
+
+Tensor& beam_gather_cache_cpu_(Tensor& cache, const Tensor& beams) {
+  AT_CHECK(
+      cache.dim() >= 2,
+      "_beam_gather_cache_: expected cache of shape (batch, beam, ...), got a ",
+      cache.dim(),
+      "-d tensor");
+  AT_CHECK(
+      cache.is_contiguous(), "_beam_gather_cache_: cache must be contiguous");
+  AT_CHECK(
+      beams.scalar_type() == kLong && beams.dim() == 2 &&
+          beams.size(0) == cache.size(0) && beams.size(1) == cache.size(1),
+      "_beam_gather_cache_: beams must be a Long tensor of shape (batch, beam)");
+  const int64_t batch = cache.size(0);
+  const int64_t beam = cache.size(1);
+  if (cache.numel() == 0) {
+    return cache;
+  }
+  const int64_t row_bytes =
+      cache.numel() / (batch * beam) * cache.element_size();
+  auto beams_ = beams.contiguous();
+  const int64_t* sel = beams_.data<int64_t>();
+  for (int64_t i = 0; i < batch * beam; ++i) {
+    AT_CHECK(
+        sel[i] >= 0 && sel[i] < beam,
+        "_beam_gather_cache_: beam index ",
+        sel[i],
+        " out of range for ",
+        beam,
+        " beams");
+  }
+  char* data = static_cast<char*>(cache.data_ptr());
+  parallel_for(0, batch, 1, [&](int64_t begin, int64_t end) {
+    // selections may repeat a parent beam, so rows are staged in a
+    // scratch slab rather than permuted in place
+    std::vector<char> staged(beam * row_bytes);
+    for (int64_t b = begin; b < end; ++b) {
+      const int64_t* batch_sel = sel + b * beam;
+      bool identity = true;
+      for (int64_t k = 0; k < beam; ++k) {
+        identity = identity && batch_sel[k] == k;
+      }
+      if (identity) {
+        continue;
+      }
+      char* slab = data + b * beam * row_bytes;
+      for (int64_t k = 0; k < beam; ++k) {
+        std::memcpy(
+            staged.data() + k * row_bytes,
+            slab + batch_sel[k] * row_bytes,
+            row_bytes);
+      }
+      std::memcpy(slab, staged.data(), beam * row_bytes);
+    }
+  });
+  return cache;
+}
+
+Tensor& beam_cache_append_cpu_(
+    Tensor& cache,
+    const Tensor& step,
+    int64_t pos) {
+  AT_CHECK(
+      cache.dim() >= 3,
+      "_beam_cache_append_: expected cache of shape ",
+      "(batch, beam, capacity, ...), got a ",
+      cache.dim(),
+      "-d tensor");
+  AT_CHECK(
+      step.dim() == cache.dim() - 1 && step.size(0) == cache.size(0) &&
+          step.size(1) == cache.size(1),
+      "_beam_cache_append_: step must match the cache with the capacity ",
+      "dimension removed");
+  for (int64_t d = 2; d < step.dim(); ++d) {
+    AT_CHECK(
+        step.size(d) == cache.size(d + 1),
+        "_beam_cache_append_: step size ",
+        step.size(d),
+        " at dim ",
+        d,
+        " does not match cache size ",
+        cache.size(d + 1));
+  }
+  AT_CHECK(
+      step.scalar_type() == cache.scalar_type(),
+      "_beam_cache_append_: step dtype ",
+      step.scalar_type(),
+      " does not match cache dtype ",
+      cache.scalar_type());
+  AT_CHECK(
+      cache.is_contiguous(), "_beam_cache_append_: cache must be contiguous");
+  AT_CHECK(pos >= 0, "_beam_cache_append_: step position must be >= 0");
+  if (step.numel() == 0) {
+    return cache;
+  }
+  const int64_t batch = cache.size(0);
+  const int64_t beam = cache.size(1);
+  const int64_t capacity = cache.size(2);
+  const int64_t slot = pos % capacity;
+  const int64_t row_bytes =
+      step.numel() / (batch * beam) * step.element_size();
+  auto step_ = step.contiguous();
+  const char* src = static_cast<const char*>(step_.data_ptr());
+  char* dst = static_cast<char*>(cache.data_ptr());
+  const int64_t grain =
+      std::max(int64_t(1), internal::GRAIN_SIZE / row_bytes);
+  parallel_for(0, batch * beam, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t q = begin; q < end; ++q) {
+      std::memcpy(
+          dst + (q * capacity + slot) * row_bytes,
+          src + q * row_bytes,
+          row_bytes);
+    }
+  });
+  return cache;
+}
+
+} // namespace native
+} // namespace at
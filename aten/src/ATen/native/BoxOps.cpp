@@ -0,0 +1,60 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+#include <ATen/native/BoxOps.h>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(box_iou_stub);
+DEFINE_DISPATCH(nms_stub);
+
+namespace {
+
+void check_boxes(const char* name, const char* arg, const Tensor& boxes) {
+  AT_CHECK(boxes.dim() == 2 && boxes.size(1) == 4,
+      name, " expects ", arg, " to have shape [N, 4] with boxes as "
+      "(x1, y1, x2, y2), got sizes ", boxes.sizes());
+  AT_CHECK(at::isFloatingType(boxes.scalar_type()),
+      name, " only supports floating-point dtypes, ", arg, " got: ",
+      boxes.scalar_type());
+}
+
+} // namespace
+
+// Pairwise intersection-over-union between two box sets, returned as an
+// [N, M] matrix. Boxes are (x1, y1, x2, y2) corner coordinates.
+Tensor box_iou_cpu(const Tensor& boxes1, const Tensor& boxes2) {
+  check_boxes("box_iou", "boxes1", boxes1);
+  check_boxes("box_iou", "boxes2", boxes2);
+  AT_CHECK(boxes1.scalar_type() == boxes2.scalar_type(),
+      "box_iou expects both box sets to have the same dtype, got ",
+      boxes1.scalar_type(), " and ", boxes2.scalar_type());
+  Tensor result = at::empty({boxes1.size(0), boxes2.size(0)},
+      boxes1.options());
+  if (result.numel() > 0) {
+    box_iou_stub(kCPU, result, boxes1.contiguous(), boxes2.contiguous());
+  }
+  return result;
+}
+
+// Greedy non-maximum suppression. Returns the indices of the kept boxes,
+// sorted by decreasing score: a box is suppressed when its IoU with an
+// already-kept, higher-scoring box exceeds iou_threshold. Class-aware
+// suppression composes on top of this by offsetting each class's boxes
+// into a disjoint coordinate range before the call.
+Tensor nms_cpu(const Tensor& boxes, const Tensor& scores, double iou_threshold) {
+  check_boxes("nms", "boxes", boxes);
+  AT_CHECK(scores.dim() == 1 && scores.size(0) == boxes.size(0),
+      "nms expects scores to have shape [N] matching boxes, got sizes ",
+      scores.sizes(), " for ", boxes.size(0), " boxes");
+  AT_CHECK(boxes.scalar_type() == scores.scalar_type(),
+      "nms expects boxes and scores to have the same dtype, got ",
+      boxes.scalar_type(), " and ", scores.scalar_type());
+  if (boxes.size(0) == 0) {
+    return at::empty({0}, boxes.options().dtype(kLong));
+  }
+  return nms_stub(kCPU, boxes.contiguous(), scores.contiguous(),
+      iou_threshold);
+}
+
+}}  // namespace at::native
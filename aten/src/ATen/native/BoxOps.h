@@ -0,0 +1,14 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+using box_iou_fn = void(*)(Tensor&, const Tensor&, const Tensor&);
+using nms_fn = Tensor(*)(const Tensor&, const Tensor&, double);
+
+DECLARE_DISPATCH(box_iou_fn, box_iou_stub);
+DECLARE_DISPATCH(nms_fn, nms_stub);
+
+}} // namespace at::native
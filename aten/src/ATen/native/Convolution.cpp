@@ -1,5 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/core/grad_mode.h>
+#include <ATen/native/cpu/DirectConvKernel.h>
 
 #include <ATen/Config.h>
 #if AT_NNPACK_ENABLED()
@@ -33,9 +35,18 @@ struct ConvParams {
   bool use_miopen(const at::Tensor& input) const;
   bool use_mkldnn(const at::Tensor& input) const;
   bool use_nnpack(const at::Tensor& input) const;
+  bool use_direct(
+      const at::Tensor& input,
+      const at::Tensor& weight,
+      const at::Tensor& bias) const;
+  bool prefer_grouped_direct(
+      const at::Tensor& input,
+      const at::Tensor& weight) const;
   bool is_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
 };
 
+DEFINE_DISPATCH(direct_conv2d_stub);
+
 std::ostream& operator<<(std::ostream & out, const ConvParams& params) {
   out << "ConvParams {"
       << "  stride = " << IntArrayRef{params.stride}
@@ -172,6 +183,97 @@ auto ConvParams::use_nnpack(const at::Tensor& input) const -> bool {
   return false;
 }
 
+// Forward-only direct CPU kernel for the cases the vendor backends skip
+// (double precision, dilation, groups, builds without MKL-DNN); see
+// Note [Direct convolution] in cpu/DirectConvKernel.cpp. It is not an
+// ATen op, so nothing records a backward graph through it: callers must
+// additionally check that no argument requires grad.
+auto ConvParams::use_direct(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const at::Tensor& bias) const -> bool {
+  if (input.type().backend() != at::Backend::CPU || transposed ||
+      input.ndimension() != 4 || weight.ndimension() != 4) {
+    return false;
+  }
+  if (input.scalar_type() != kFloat && input.scalar_type() != kDouble) {
+    return false;
+  }
+  if (weight.scalar_type() != input.scalar_type() ||
+      (bias.defined() && bias.scalar_type() != input.scalar_type())) {
+    return false;
+  }
+  for (const auto s : stride) {
+    if (s <= 0) {
+      return false;
+    }
+  }
+  for (const auto d : dilation) {
+    if (d <= 0) {
+      return false;
+    }
+  }
+  // Degenerate output sizes fall through to THNN's shape errors.
+  for (int i = 0; i < 2; ++i) {
+    const int64_t k = dilation[i] * (weight.size(i + 2) - 1) + 1;
+    if ((input.size(i + 2) + 2 * padding[i] - k) / stride[i] + 1 <= 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether a grouped convolution is better served by the direct kernel
+// than by a backend that runs one GEMM per group. The backends amortize
+// their im2col and packing work over the GEMM; with many groups and a
+// tiny per-group problem (MobileNet-style blocks sit at 32-128 groups
+// with single-digit channels per group) each GEMM is too small to use
+// the cores, while the direct kernel schedules all N * OC output planes
+// of every group as one task pool. The cutoffs key on exactly that
+// product: enough groups for the per-group dispatch to dominate, and a
+// per-group reduction small enough that a GEMM cannot win it back.
+auto ConvParams::prefer_grouped_direct(
+    const at::Tensor& input,
+    const at::Tensor& weight) const -> bool {
+  if (groups < 8) {
+    return false;
+  }
+  // Per-group GEMM: [OCg, ICg*KH*KW] x [ICg*KH*KW, OH*OW]. Small here
+  // means the reduction and output-channel extents that a GEMM would
+  // block over, independent of the spatial size.
+  const int64_t ocg = weight.size(0) / groups;
+  const int64_t reduction = weight.size(1) * weight.size(2) * weight.size(3);
+  return ocg * reduction <= 1024;
+}
+
+static at::Tensor direct_conv2d(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    const ConvParams& params) {
+  auto in = input.contiguous();
+  auto w = weight.contiguous();
+  auto b = bias.defined() ? bias.contiguous() : bias;
+  std::vector<int64_t> output_size{in.size(0), w.size(0)};
+  for (int i = 0; i < 2; ++i) {
+    const int64_t k = params.dilation[i] * (w.size(i + 2) - 1) + 1;
+    output_size.push_back(
+        (in.size(i + 2) + 2 * params.padding[i] - k) / params.stride[i] + 1);
+  }
+  auto output = at::empty(output_size, in.options());
+  direct_conv2d_stub(
+      kCPU,
+      output,
+      in,
+      w,
+      b,
+      params.stride,
+      params.padding,
+      params.dilation,
+      params.groups);
+  return output;
+}
+
 // We currently only have depthwise support for the case where groups ==
 // nInputPlane and nInputPlane == nOutputPlane (the latter due to the lack of
 // a depthwise multiplier)
@@ -435,6 +537,16 @@ at::Tensor _convolution(
           input, weight, bias,
           params.padding, params.stride, params.dilation, params.groups, params.benchmark, params.deterministic);
     }
+  } else if (params.use_direct(input, weight, bias) &&
+             params.prefer_grouped_direct(input, weight) &&
+             !GradMode::is_enabled() && !input.requires_grad() &&
+             !weight.requires_grad() &&
+             !(bias.defined() && bias.requires_grad())) {
+    // Many tiny groups: the backends below run one GEMM per group and
+    // leave the cores idle, while the direct kernel batches every
+    // group's output planes into one task pool. See
+    // ConvParams::prefer_grouped_direct.
+    output = direct_conv2d(input, weight, bias, params);
   } else if (params.use_mkldnn(input)) {
 #if AT_MKLDNN_ENABLED()
     AT_CHECK(input.type() == weight.type(),
@@ -446,6 +558,11 @@ at::Tensor _convolution(
     output = at::mkldnn_convolution(input, weight.contiguous(), bias.defined() ? bias.contiguous() : bias,
                                     params.padding, params.stride, params.dilation, params.groups);
 #endif
+  } else if (params.use_direct(input, weight, bias) &&
+             !GradMode::is_enabled() && !input.requires_grad() &&
+             !weight.requires_grad() &&
+             !(bias.defined() && bias.requires_grad())) {
+    output = direct_conv2d(input, weight, bias, params);
   } else {
     if (params.groups == 1) {
       output = at::_convolution_nogroup(
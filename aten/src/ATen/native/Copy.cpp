@@ -6,14 +6,25 @@
 #include <ATen/ExpandUtils.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/cpu/CopyKernel.h>
+#include <ATen/native/cpu/TransposeKernel.h>
 
 namespace {
 
 bool copy_transpose_valid(const at::Tensor& self, const at::Tensor& src) {
   const int MIN_SZ = 60 * 60;
-  return self.is_contiguous() && src.numel() != 0 && src.dim() == 2 &&
-      src.stride(0) == 1 && src.stride(1) == src.size(0) &&
-      self.numel() >= MIN_SZ;
+  if (!self.is_contiguous() || src.numel() == 0 || self.numel() < MIN_SZ) {
+    return false;
+  }
+  if (src.dim() == 2) {
+    return src.stride(0) == 1 && src.stride(1) == src.size(0);
+  }
+  // A batch of transposed matrices, i.e. a permute(0, 2, 1) view being
+  // materialized; the kernel runs the blocked transpose per batch entry.
+  if (src.dim() == 3) {
+    return src.stride(1) == 1 && src.stride(2) == src.size(1) &&
+        src.stride(0) == src.size(1) * src.size(2);
+  }
+  return false;
 }
 
 } // namespace
@@ -49,57 +60,11 @@ Tensor& _s_copy__cpu(Tensor& self, const Tensor& src, bool non_blocking) {
   return self;
 }
 
-// special case copy where tensor is contiguous and src is a transposed matrix
-// This can be generalized to most copies, but it's tricker
+// special case copy where tensor is contiguous and src is a transposed
+// matrix (or a batch of them); see Note [Blocked transpose kernel] in
+// cpu/TransposeKernel.cpp.
 void _copy_same_type_transpose_(Tensor& self, const Tensor& src) {
-  int64_t BLOCK_SZ;
-  if (self.scalar_type() == kByte) {
-    BLOCK_SZ = 120;
-  } else {
-    BLOCK_SZ = 60;
-  }
-  Tensor buf = empty({BLOCK_SZ, BLOCK_SZ}, self.options());
-
-  AT_DISPATCH_ALL_TYPES_AND(
-    at::ScalarType::Half, self.scalar_type(), "_copy_same_type_transpose_", [&]() {
-        scalar_t* sp = src.data<scalar_t>();
-        scalar_t* rp = self.data<scalar_t>();
-        scalar_t* bp = buf.data<scalar_t>();
-
-        int64_t NR = src.size(0);
-        int64_t NC = src.size(1);
-        for (int64_t R = 0; R < NR; R += BLOCK_SZ) {
-          for (int64_t C = 0; C < NC; C += BLOCK_SZ) {
-            scalar_t* spo = sp + R + C * NR;
-            scalar_t* rpo = rp + C + R * NC;
-
-            int nr = std::min(NR - R, BLOCK_SZ);
-            int nc = std::min(NC - C, BLOCK_SZ);
-
-            // 1. copy columns from src to buf
-            for (int c = 0; c < nc; c++) {
-              memcpy(bp + c * BLOCK_SZ, spo + c * NR, nr * sizeof(scalar_t));
-            }
-
-            // 2. transpose buf in place
-            int rc_max = std::max(nr, nc);
-            int rc_min = std::min(nr, nc);
-            for (int r = 0; r < rc_max; r++) {
-              int end = std::min(r, rc_min);
-              for (int c = 0; c < end; c++) {
-                scalar_t tmp = bp[r + BLOCK_SZ * c];
-                bp[r + BLOCK_SZ * c] = bp[r * BLOCK_SZ + c];
-                bp[r * BLOCK_SZ + c] = tmp;
-              }
-            }
-
-            // 3. copy rows from buf to dst
-            for (int r = 0; r < nr; r++) {
-              memcpy(rpo + r * NC, bp + r * BLOCK_SZ, nc * sizeof(scalar_t));
-            }
-          }
-        }
-      });
+  transpose_copy_kernel(kCPU, self, src);
 }
 
 void _copy_same_type__cpu(Tensor& self, const Tensor& src) {
@@ -114,8 +79,26 @@ void _copy_same_type__cpu(Tensor& self, const Tensor& src) {
   copy_kernel_same_type(kCPU, self, src);
 }
 
+Tensor& copy_convert_and_scale_(Tensor& self, const Tensor& src, double scale) {
+  AT_CHECK(
+      isFloatingType(self.scalar_type()),
+      "copy_convert_and_scale_ expects a floating point destination, got ",
+      self.scalar_type());
+  if (self.type_id() != CPUTensorId() || src.type_id() != CPUTensorId()) {
+    // Fall back to two passes off CPU; the fusion only exists as a CPU
+    // kernel.
+    self.copy_(src);
+    return self.mul_(scale);
+  }
+  AT_CHECK(self.numel() == src.numel(), "sizes do not match");
+  copy_scale_kernel(kCPU, self, src, scale);
+  return self;
+}
+
 DEFINE_DISPATCH(copy_kernel_cast);
 DEFINE_DISPATCH(copy_kernel_same_type);
+DEFINE_DISPATCH(copy_scale_kernel);
+DEFINE_DISPATCH(transpose_copy_kernel);
 
 } // namespace native
 } // namespace at
@@ -43,5 +43,14 @@ struct inter_copy_type<uint8_t> {
 template <typename T>
 using inter_copy_type_t = typename inter_copy_type<T>::type;
 
+// Writes `src` converted to self's (floating point) dtype and multiplied by
+// `scale` into `self` in a single pass over memory, i.e. a fused
+// self.copy_(src).mul_(scale). See Note [Specialized dtype conversion
+// kernels] in cpu/CopyKernel.cpp for the fast paths.
+CAFFE2_API Tensor& copy_convert_and_scale_(
+    Tensor& self,
+    const Tensor& src,
+    double scale);
+
 } // namespace native
 } // namespace at
@@ -10,6 +10,7 @@ DEFINE_DISPATCH(pdist_forward_stub);
 DEFINE_DISPATCH(pdist_backward_stub);
 DEFINE_DISPATCH(cdist_stub);
 DEFINE_DISPATCH(cdist_backward_stub);
+DEFINE_DISPATCH(cdist_topk_stub);
 
 Tensor pairwise_distance(const Tensor& x1, const Tensor& x2, double p, double eps, bool keepdim) {
   return at::norm(x1 - x2 + eps, p, 1, keepdim);
@@ -53,6 +54,36 @@ Tensor cdist(const Tensor& x1, const Tensor& x2, const double p) {
   return result;
 }
 
+// Nearest-neighbor primitive: the k smallest distances (and their row
+// indices in x2) per row of x1, without ever materializing the full
+// r1 x r2 distance matrix the cdist + topk composition writes out and
+// immediately reduces away. No derivative; this is a search op.
+std::tuple<Tensor, Tensor> cdist_topk(const Tensor& x1, const Tensor& x2, int64_t k, const double p) {
+  AT_CHECK(x1.dim() == 2, "cdist_topk only supports 2D tensors, X1 got: ", x1.dim(), "D");
+  AT_CHECK(x2.dim() == 2, "cdist_topk only supports 2D tensors, X2 got: ", x2.dim(), "D");
+  AT_CHECK(at::isFloatingType(x1.scalar_type()), "cdist_topk only supports floating-point dtypes, X1 got: ", x1.scalar_type());
+  AT_CHECK(x1.size(-1) == x2.size(-1), "X1 and X2 must have the same number of columns. X1: ", x1.size(-1), " X2: ", x2.size(-1));
+  AT_CHECK(p >= 0, "cdist_topk only supports non-negative p values");
+  AT_CHECK(k >= 1 && k <= x2.size(0), "selected k out of range: got ", k, " with ", x2.size(0), " database rows");
+
+  const int64_t r1 = x1.size(0);
+  const int64_t d = x1.size(1);
+  const bool can_use_fused = x1.device().type() == kCPU &&
+      x2.device().type() == kCPU && !x1.is_sparse() && !x2.is_sparse() &&
+      x1.scalar_type() == x2.scalar_type() &&
+      (x1.scalar_type() == kFloat || x1.scalar_type() == kDouble) &&
+      (p == 1 || p == 2) && r1 > 0 && d > 0;
+  if (can_use_fused) {
+    Tensor values = at::empty({r1, k}, x1.options());
+    Tensor indices = at::empty({r1, k}, x1.options().dtype(kLong));
+    cdist_topk_stub(
+        kCPU, values, indices, x1.contiguous(), x2.contiguous(), k, p);
+    return std::make_tuple(values, indices);
+  }
+  auto dist = at::cdist(x1, x2, p);
+  return dist.topk(k, /*dim=*/-1, /*largest=*/false, /*sorted=*/true);
+}
+
 Tensor _cdist_backward(const Tensor& grad, const Tensor& x1, const Tensor& x2, const double p, const Tensor& cdist) {
   AT_CHECK(x1.is_contiguous(), "_cdist_backward requires X1 to be contiguous");
   AT_CHECK(x2.is_contiguous(), "_cdist_backward requires X2 to be contiguous");
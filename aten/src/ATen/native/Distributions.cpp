@@ -8,6 +8,8 @@
 
 #include <ATen/CPUGenerator.h>
 #include <ATen/CheckGenerator.h>
+#include <ATen/LegacyTHFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/Generator.h>
 #include <ATen/native/Distributions.h>
 #include <ATen/native/DispatchStub.h>
@@ -15,6 +17,9 @@
 
 #include <type_traits>
 #include <functional>
+#include <algorithm>
+#include <mutex>
+#include <vector>
 #include <assert.h>
 #include <cpuinfo.h>
 
@@ -151,6 +156,7 @@ Tensor& bernoulli_tensor_cpu_(Tensor& self, const Tensor& p_, Generator* gen) {
 }
 
 DEFINE_DISPATCH(bernoulli_mkl_stub);
+DEFINE_DISPATCH(bernoulli_philox_stub);
 
 Tensor& bernoulli_scalar_cpu_(Tensor& self, double p, Generator* gen) {
   AT_CHECK(0 <= p && p <= 1, "bernoulli_ expects p to be in [0, 1], but got p=", p);
@@ -160,6 +166,13 @@ Tensor& bernoulli_scalar_cpu_(Tensor& self, double p, Generator* gen) {
     return self;
   }
 #endif
+  // See Note [Philox CPU streams] in cpu/PhiloxRNG.h: the counter-based
+  // generator draws one seed from `gen` and then samples in parallel,
+  // instead of serializing every element on the generator mutex.
+  if (self.is_contiguous()) {
+    bernoulli_philox_stub(kCPU, self, p, gen);
+    return self;
+  }
   AT_DISPATCH_ALL_TYPES(self.scalar_type(), "bernoulli_scalar_cpu_", [&] {
     THGenerator* generator = get_generator(gen);
     std::lock_guard<std::mutex> lock(generator->mutex);
@@ -265,4 +278,156 @@ Tensor _s_dirichlet_cpu(const Tensor& alpha, Generator *gen) {
   });
   return ret;
 }
+
+namespace {
+
+// Counter-based per-sample random stream for the alias draw below: each
+// sample index derives its own 64-bit state from one seed taken off the
+// generator, so draws are lock-free, order-independent, and identical for
+// any thread count (splitmix64 finalizer).
+inline uint64_t alias_draw_mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// 53-bit uniform in [0, 1).
+inline double alias_draw_uniform(uint64_t bits) {
+  return (bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace
+
+// Note [Alias method sampling]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// multinomial() builds a CDF and binary-searches it per sample, which is
+// O(log K) per draw and rebuilds the CDF on every call. For repeated draws
+// from the same categorical distribution, _multinomial_alias_setup builds
+// Vose's alias table once in O(K) -- q[i] is the probability of keeping
+// bucket i, J[i] the alias drawn otherwise -- and _multinomial_alias_draw
+// then samples in O(1) per draw: pick a bucket uniformly, flip a biased
+// coin. Draws are parallelized with a counter-based stream per sample (see
+// above), so the hot path takes no generator lock; only one seed is drawn
+// from the generator per call. The CPU tables pair with the CPU draw;
+// CUDA tensors take the existing TH path, and tables are not
+// interchangeable across the two (they never were across devices).
+std::tuple<Tensor, Tensor> _multinomial_alias_setup(const Tensor& probs) {
+  if (probs.is_cuda()) {
+    return at::legacy::th::_th_multinomial_alias_setup(probs);
+  }
+  AT_CHECK(
+      probs.dim() == 1,
+      "expected 1-D probability tensor, got ",
+      probs.dim(),
+      "-D probability tensor instead");
+  const int64_t K = probs.numel();
+  AT_CHECK(K > 0, "cannot build an alias table from an empty distribution");
+  Tensor J = at::empty({K}, probs.options().dtype(kLong));
+  Tensor q = at::empty({K}, probs.options());
+  AT_DISPATCH_FLOATING_TYPES(probs.scalar_type(), "multinomial_alias_setup", [&] {
+    Tensor probs_c = probs.contiguous();
+    const scalar_t* p = probs_c.data<scalar_t>();
+    int64_t* J_data = J.data<int64_t>();
+    scalar_t* q_data = q.data<scalar_t>();
+
+    double sum = 0;
+    for (int64_t i = 0; i < K; i++) {
+      AT_CHECK(p[i] >= 0, "invalid multinomial distribution (encountering probability entry < 0)");
+      sum += p[i];
+    }
+    AT_CHECK(sum > 0, "invalid multinomial distribution (sum of probabilities <= 0)");
+
+    // Vose's algorithm: pair each under-full bucket with an over-full one.
+    std::vector<double> scaled(K);
+    std::vector<int64_t> small;
+    std::vector<int64_t> large;
+    small.reserve(K);
+    large.reserve(K);
+    for (int64_t i = 0; i < K; i++) {
+      scaled[i] = p[i] * K / sum;
+      J_data[i] = i;
+      (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      const int64_t s = small.back();
+      small.pop_back();
+      const int64_t l = large.back();
+      large.pop_back();
+      q_data[s] = static_cast<scalar_t>(scaled[s]);
+      J_data[s] = l;
+      scaled[l] -= 1.0 - scaled[s];
+      (scaled[l] < 1.0 ? small : large).push_back(l);
+    }
+    // Leftovers are exactly full up to rounding; they keep themselves.
+    for (const int64_t i : small) {
+      q_data[i] = 1;
+    }
+    for (const int64_t i : large) {
+      q_data[i] = 1;
+    }
+  });
+  return std::make_tuple(J, q);
+}
+
+Tensor _multinomial_alias_draw(
+    const Tensor& q,
+    const Tensor& J,
+    int64_t num_samples,
+    Generator* gen) {
+  if (q.is_cuda()) {
+    return at::legacy::th::_th_multinomial_alias_draw(q, J, num_samples, gen);
+  }
+  AT_CHECK(
+      q.dim() == 1,
+      "expected 1-D probability table, got ",
+      q.dim(),
+      "-D probability table instead");
+  AT_CHECK(
+      J.dim() == 1,
+      "expected 1-D alias table, got ",
+      J.dim(),
+      "-D alias table instead");
+  AT_CHECK(
+      J.scalar_type() == ScalarType::Long,
+      "expected an alias table of dtype Long");
+  AT_CHECK(
+      q.numel() == J.numel(),
+      "probability and alias tables disagree on the number of categories");
+  AT_CHECK(num_samples > 0, "cannot sample <= 0 samples");
+  const int64_t K = J.numel();
+  Tensor result = at::empty({num_samples}, J.options());
+
+  // One generator interaction per call; the per-sample streams derive from
+  // this seed. See Note [Alias method sampling].
+  THGenerator* generator = get_generator(gen);
+  uint64_t seed;
+  {
+    std::lock_guard<std::mutex> lock(generator->mutex);
+    seed = THRandom_random(generator);
+  }
+
+  AT_DISPATCH_FLOATING_TYPES(q.scalar_type(), "multinomial_alias_draw", [&] {
+    Tensor q_c = q.contiguous();
+    Tensor J_c = J.contiguous();
+    const scalar_t* q_data = q_c.data<scalar_t>();
+    const int64_t* J_data = J_c.data<int64_t>();
+    int64_t* out = result.data<int64_t>();
+    at::parallel_for(
+        0, num_samples, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            const uint64_t bits = alias_draw_mix(seed + static_cast<uint64_t>(i));
+            int64_t bucket =
+                static_cast<int64_t>(alias_draw_uniform(bits) * K);
+            bucket = std::min(bucket, K - 1);
+            const double coin = alias_draw_uniform(alias_draw_mix(bits));
+            out[i] = coin < static_cast<double>(q_data[bucket])
+                ? bucket
+                : J_data[bucket];
+          }
+        });
+  });
+  return result;
+}
+
 }} // namespace at::native
@@ -1,9 +1,14 @@
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/NativeFunctions.h>
 
+#include <TH/THBlasUtils.h>
+
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <vector>
 
@@ -14,6 +19,44 @@
 
 namespace at { namespace native {
 
+namespace {
+
+// LSD radix sort of `keys` (all in [0, max_key]) with `vals` permuted
+// alongside. Runs in O(passes * n) with 8-bit digits, where the number of
+// passes depends only on the magnitude of max_key, so sorting a batch of
+// embedding indices is cheap relative to the accumulation it enables.
+void radix_sort_by_key(
+    std::vector<int64_t>& keys,
+    std::vector<int64_t>& vals,
+    int64_t max_key) {
+  const int64_t n = keys.size();
+  std::vector<int64_t> keys_tmp(n);
+  std::vector<int64_t> vals_tmp(n);
+  int64_t count[256];
+  for (int shift = 0; (max_key >> shift) > 0; shift += 8) {
+    std::memset(count, 0, sizeof(count));
+    for (int64_t i = 0; i < n; i++) {
+      count[(keys[i] >> shift) & 0xff]++;
+    }
+    int64_t pos = 0;
+    for (int bucket = 0; bucket < 256; bucket++) {
+      int64_t c = count[bucket];
+      count[bucket] = pos;
+      pos += c;
+    }
+    for (int64_t i = 0; i < n; i++) {
+      int64_t bucket = (keys[i] >> shift) & 0xff;
+      keys_tmp[count[bucket]] = keys[i];
+      vals_tmp[count[bucket]] = vals[i];
+      count[bucket]++;
+    }
+    keys.swap(keys_tmp);
+    vals.swap(vals_tmp);
+  }
+}
+
+} // namespace
+
 Tensor embedding(const Tensor & weight, const Tensor & indices,
                  int64_t padding_idx, bool scale_grad_by_freq, bool sparse) {
   auto indices_arg = TensorArg(indices, "indices", 1);
@@ -105,6 +148,58 @@ Tensor embedding_dense_backward_cpu(
   auto grad = grad_.contiguous().view({numel, grad_.size(-1)});
   auto grad_weight = at::zeros({num_weights, grad_.size(-1)}, grad_.options());
 
+  // Sort-by-destination path: order the indices (carrying their source row
+  // along), then hand runs of equal indices out to the worker threads. Each
+  // destination row is owned by exactly one run, so the accumulation needs
+  // no atomics and every thread walks only its share of the input, unlike
+  // the vocabulary-partitioned fallback below where every thread scans all
+  // indices.
+  if (numel > 1000 &&
+      (grad.scalar_type() == kFloat || grad.scalar_type() == kDouble)) {
+    const int64_t ddim = grad_.size(-1);
+    std::vector<int64_t> sorted_keys(indices_data, indices_data + numel);
+    std::vector<int64_t> sorted_pos(numel);
+    std::iota(sorted_pos.begin(), sorted_pos.end(), 0);
+    radix_sort_by_key(sorted_keys, sorted_pos, num_weights - 1);
+
+    AT_DISPATCH_FLOATING_TYPES(
+        grad.scalar_type(), "embedding_dense_backward_cpu", [&]() {
+      auto grad_data = grad.data<scalar_t>();
+      auto grad_weight_data = grad_weight.data<scalar_t>();
+      at::parallel_for(0, numel, 1000, [&](int64_t begin, int64_t end) {
+        int64_t i = begin;
+        // A run that started in the previous chunk is processed in full by
+        // that chunk's owner; skip our partial view of it.
+        if (begin > 0) {
+          int64_t prev = sorted_keys[begin - 1];
+          while (i < end && sorted_keys[i] == prev) {
+            i++;
+          }
+        }
+        while (i < end) {
+          int64_t k = sorted_keys[i];
+          int64_t run_end = i + 1;
+          while (run_end < numel && sorted_keys[run_end] == k) {
+            run_end++;
+          }
+          if (k != padding_idx) {
+            scalar_t scale = 1;
+            if (scale_grad_by_freq) {
+              scale = static_cast<scalar_t>(1.0 / counts[k]);
+            }
+            scalar_t* dst = grad_weight_data + k * ddim;
+            for (int64_t j = i; j < run_end; j++) {
+              THBlas_axpy<scalar_t>(
+                  ddim, scale, grad_data + sorted_pos[j] * ddim, 1, dst, 1);
+            }
+          }
+          i = run_end;
+        }
+      });
+    });
+    return grad_weight;
+  }
+
 #ifdef _OPENMP
   if (numel > 1000) {
     // The strategy is to parallelize over sections of the vocabulary, so that
@@ -7,6 +7,7 @@
 
 #include <caffe2/perfkernels/embedding_lookup.h>
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -35,6 +36,17 @@ static void make_offset2bag(const Tensor &offsets, const Tensor &indices, Tensor
 
 namespace {
 
+// Hint the hardware prefetcher at the embedding row needed on the next
+// iteration. Rows of large tables are effectively random accesses, so
+// without this the gather-then-reduce loops stall on cache misses.
+inline void prefetch_row(const void* row) {
+#if defined(__GNUC__)
+  __builtin_prefetch(row, /*rw=*/0, /*locality=*/1);
+#else
+  (void)row;
+#endif
+}
+
 bool isFastPathIndexSelect(const Tensor& src, Tensor& output) {
   return src.scalar_type() == kFloat && src.stride(1) == 1 && output.stride(1) == 1;
 }
@@ -65,6 +77,9 @@ void index_select_add(const Tensor &select_indices,
   auto output_stride1 = output.stride(1);
 
   for (int64_t i = 0; i < numel; i++) {
+    if (i + 1 < numel) {
+      prefetch_row(src_data + src_stride0 * select_indices_data[i + 1]);
+    }
     THBlas_axpy<T>(ddim, 1,
             src_data + src_stride0 * select_indices_data[i], src_stride1,
             output_data + output_stride0 * add_indices_data[i], output_stride1);
@@ -93,19 +108,36 @@ void index_select_add<float>(const Tensor &select_indices,
     }
     lengths.push_back(select_indices.numel() - lower);
 
-    caffe2::EmbeddingLookup(
-      /*block_size=*/ddim,
-      /*output_size=*/lengths.size(),
-      /*index_size=*/select_indices.numel(),
-      /*data_size=*/src.size(0),
-      /*input=*/src_data,
-      /*indices=*/select_indices_data,
-      /*lengths=*/lengths.data(),
-      /*weights=*/nullptr,
-      /*scale_bias=*/nullptr,
-      /*normalize_by_lengths=*/false,
-      /*out=*/output_data
-    );
+    // Bags write disjoint output rows, so they can be processed in
+    // parallel; each worker hands its contiguous range of bags to the
+    // vectorized perfkernel. The grain keeps per-task work above roughly
+    // a few thousand accumulated floats so small bags do not drown in
+    // scheduling overhead.
+    const int64_t output_size = lengths.size();
+    const int64_t grain = std::max<int64_t>(1, 4096 / std::max<int64_t>(1, ddim));
+    at::parallel_for(0, output_size, grain, [&](int64_t begin, int64_t end) {
+      int64_t index_start = 0;
+      for (int64_t b = 0; b < begin; b++) {
+        index_start += lengths[b];
+      }
+      int64_t index_count = 0;
+      for (int64_t b = begin; b < end; b++) {
+        index_count += lengths[b];
+      }
+      caffe2::EmbeddingLookup(
+        /*block_size=*/ddim,
+        /*output_size=*/end - begin,
+        /*index_size=*/index_count,
+        /*data_size=*/src.size(0),
+        /*input=*/src_data,
+        /*indices=*/select_indices_data + index_start,
+        /*lengths=*/lengths.data() + begin,
+        /*weights=*/nullptr,
+        /*scale_bias=*/nullptr,
+        /*normalize_by_lengths=*/false,
+        /*out=*/output_data + begin * ddim
+      );
+    });
   } else {
     AT_ASSERT(select_indices.numel() == add_indices.numel());
     auto add_indices_data = add_indices.data<int64_t>();
@@ -115,6 +147,9 @@ void index_select_add<float>(const Tensor &select_indices,
     auto output_stride1 = output.stride(1);
     auto numel = add_indices.numel();
     for (int64_t i = 0; i < numel; i++) {
+      if (i + 1 < numel) {
+        prefetch_row(src_data + src_stride0 * select_indices_data[i + 1]);
+      }
       THBlas_axpy<float>(ddim, 1,
               src_data + src_stride0 * select_indices_data[i], src_stride1,
               output_data + output_stride0 * add_indices_data[i], output_stride1);
@@ -149,6 +184,9 @@ static void index_select_scale_add(const Tensor &select_indices,
   auto scale_stride = scale.stride(0);
 
   for (int64_t i = 0; i < numel; i++) {
+    if (i + 1 < numel) {
+      prefetch_row(src_data + src_stride0 * select_indices_data[i + 1]);
+    }
     auto* src_base = src_data + src_stride0 * select_indices_data[i];
     auto* output_base = output_data + output_stride0 * add_indices_data[i];
     auto scale = scale_data[i * scale_stride];
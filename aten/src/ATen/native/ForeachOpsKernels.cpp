@@ -0,0 +1,75 @@
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+namespace {
+
+void check_foreach_args(TensorList tensors) {
+  AT_CHECK(tensors.size() > 0, "Tensor list must have at least one tensor.");
+}
+
+void check_foreach_args(TensorList tensors1, TensorList tensors2) {
+  check_foreach_args(tensors1);
+  AT_CHECK(
+      tensors1.size() == tensors2.size(),
+      "Tensor lists must have the same number of tensors, got ",
+      tensors1.size(),
+      " and ",
+      tensors2.size());
+}
+
+} // namespace
+
+void _foreach_add_(TensorList self, Scalar scalar) {
+  check_foreach_args(self);
+  for (size_t i = 0; i < self.size(); i++) {
+    // Tensor handles share the underlying TensorImpl, so updating the copy
+    // updates the caller's tensor.
+    auto t = self[i];
+    t.add_(scalar);
+  }
+}
+
+void _foreach_add_(TensorList self, TensorList other, Scalar alpha) {
+  check_foreach_args(self, other);
+  for (size_t i = 0; i < self.size(); i++) {
+    auto t = self[i];
+    t.add_(other[i], alpha);
+  }
+}
+
+void _foreach_mul_(TensorList self, Scalar scalar) {
+  check_foreach_args(self);
+  for (size_t i = 0; i < self.size(); i++) {
+    auto t = self[i];
+    t.mul_(scalar);
+  }
+}
+
+void _foreach_addcmul_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_args(self, tensor1);
+  check_foreach_args(self, tensor2);
+  for (size_t i = 0; i < self.size(); i++) {
+    auto t = self[i];
+    t.addcmul_(tensor1[i], tensor2[i], value);
+  }
+}
+
+void _foreach_addcdiv_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_args(self, tensor1);
+  check_foreach_args(self, tensor2);
+  for (size_t i = 0; i < self.size(); i++) {
+    auto t = self[i];
+    t.addcdiv_(tensor1[i], tensor2[i], value);
+  }
+}
+
+}} // namespace at::native
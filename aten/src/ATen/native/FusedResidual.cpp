@@ -0,0 +1,113 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/cpu/FusedResidualKernel.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(fused_dropout_add_stub);
+DEFINE_DISPATCH(fused_add_layer_norm_stub);
+DEFINE_DISPATCH(fused_bias_gelu_stub);
+
+namespace {
+
+// The fused kernels only cover the contiguous CPU float case; everything
+// else composes out of existing ops, which is also what keeps the ops
+// usable on CUDA.
+bool can_use_fused_residual(const Tensor& t) {
+  return t.defined() && !t.is_sparse() && t.device().type() == at::kCPU &&
+      (t.scalar_type() == kFloat || t.scalar_type() == kDouble) &&
+      t.is_contiguous();
+}
+
+} // namespace
+
+Tensor fused_dropout_add(
+    const Tensor& self,
+    const Tensor& other,
+    double p,
+    bool train) {
+  AT_CHECK(
+      p >= 0 && p <= 1,
+      "dropout probability has to be between 0 and 1, but got ", p);
+  AT_CHECK(
+      self.sizes().equals(other.sizes()),
+      "fused_dropout_add expects same-sized tensors, got ", self.sizes(),
+      " and ", other.sizes());
+  if (p == 0 || !train) {
+    return self + other;
+  }
+  if (can_use_fused_residual(self) && can_use_fused_residual(other) &&
+      self.scalar_type() == other.scalar_type() && p < 1) {
+    auto mask = at::empty_like(self);
+    mask.bernoulli_(1 - p);
+    auto out = at::empty_like(self);
+    fused_dropout_add_stub(kCPU, out, self, mask, other, 1.0 / (1.0 - p));
+    return out;
+  }
+  return at::dropout(self, p, train) + other;
+}
+
+Tensor fused_add_layer_norm(
+    const Tensor& self,
+    const Tensor& other,
+    IntArrayRef normalized_shape,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double eps) {
+  AT_CHECK(
+      self.sizes().equals(other.sizes()),
+      "fused_add_layer_norm expects same-sized tensors, got ", self.sizes(),
+      " and ", other.sizes());
+  const int64_t normalized_ndim = normalized_shape.size();
+  // The fused kernel needs both affine tensors or neither; layer_norm
+  // itself checks the shapes.
+  const bool affine_ok = weight.defined() == bias.defined() &&
+      (!weight.defined() ||
+       (can_use_fused_residual(weight) && can_use_fused_residual(bias) &&
+        weight.scalar_type() == self.scalar_type() &&
+        bias.scalar_type() == self.scalar_type()));
+  if (can_use_fused_residual(self) && can_use_fused_residual(other) &&
+      self.scalar_type() == other.scalar_type() && affine_ok &&
+      self.dim() >= normalized_ndim && normalized_ndim >= 1 &&
+      self.sizes()
+          .slice(self.dim() - normalized_ndim)
+          .equals(normalized_shape)) {
+    int64_t N = 1;
+    for (auto size : normalized_shape) {
+      N *= size;
+    }
+    const int64_t M = self.numel() / std::max<int64_t>(1, N);
+    if (N > 0 && M > 0) {
+      auto out = at::empty_like(self);
+      fused_add_layer_norm_stub(
+          kCPU, out, self, other, M, N, weight, bias, eps);
+      return out;
+    }
+  }
+  return at::layer_norm(
+      self + other, normalized_shape, weight, bias, eps,
+      /*cudnn_enable=*/true);
+}
+
+Tensor fused_bias_gelu(const Tensor& self, const Tensor& bias) {
+  AT_CHECK(
+      bias.dim() == 1 && self.dim() >= 1 &&
+          self.size(self.dim() - 1) == bias.size(0),
+      "fused_bias_gelu expects a 1-d bias matching the last dimension of "
+      "the input, got input of size ", self.sizes(), " and bias of size ",
+      bias.sizes());
+  if (can_use_fused_residual(self) && can_use_fused_residual(bias) &&
+      self.scalar_type() == bias.scalar_type() && self.numel() > 0) {
+    auto out = at::empty_like(self);
+    fused_bias_gelu_stub(kCPU, out, self, bias);
+    return out;
+  }
+  // gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
+  auto x = self + bias;
+  return x * 0.5 * (at::erf(x * M_SQRT1_2) + 1);
+}
+
+}} // namespace at::native
@@ -550,6 +550,71 @@ grid_sampler_2d_backward_cpu(const Tensor& grad_output, const Tensor& input, con
 
 DEFINE_DISPATCH(grid_sampler_2d_backward_cpu_kernel);
 
+// Precomputes a sampling plan from `grid` for an input plane of
+// `input_size` = {H, W}: per output pixel, four flattened corner offsets
+// (int64) and their interpolation weights (grid's dtype), each shaped
+// [N, H_out, W_out, 4]. Out-of-bounds corners carry weight zero, so the
+// padding mode is folded into the plan. The plan can then be applied to
+// any number of inputs sampled on the same grid with
+// grid_sampler_2d_apply_plan, skipping the per-plane weight computation.
+std::tuple<Tensor, Tensor>
+grid_sampler_2d_make_plan_cpu(const Tensor& grid, IntArrayRef input_size,
+                              int64_t interpolation_mode, int64_t padding_mode) {
+  AT_CHECK(
+    grid.dim() == 4 && grid.size(-1) == 2,
+    "grid_sampler_2d_make_plan(): expected 4D grid with size 2 in last "
+    "dimension, but got grid with sizes ", grid.sizes());
+  AT_CHECK(
+    input_size.size() == 2 && input_size[0] > 0 && input_size[1] > 0,
+    "grid_sampler_2d_make_plan(): expected input_size to be two positive "
+    "dimensions {H, W}, but got ", input_size);
+  auto indices = at::empty(
+    {grid.size(0), grid.size(1), grid.size(2), 4}, grid.options().dtype(kLong));
+  auto weights = at::empty(
+    {grid.size(0), grid.size(1), grid.size(2), 4}, grid.options());
+  grid_sampler_2d_plan_cpu_kernel(
+    kCPU, indices, weights, grid, input_size[0], input_size[1],
+    interpolation_mode, padding_mode);
+  return std::make_tuple(indices, weights);
+}
+
+DEFINE_DISPATCH(grid_sampler_2d_plan_cpu_kernel);
+
+// Applies a plan produced by grid_sampler_2d_make_plan to `input`. A plan
+// with batch size one is shared across the whole input batch, which is the
+// many-frames-one-grid case the plan API exists for.
+Tensor grid_sampler_2d_apply_plan_cpu(const Tensor& input,
+                                      const Tensor& indices,
+                                      const Tensor& weights) {
+  AT_CHECK(
+    input.dim() == 4,
+    "grid_sampler_2d_apply_plan(): expected 4D input, but got input with "
+    "sizes ", input.sizes());
+  AT_CHECK(
+    indices.dim() == 4 && indices.size(-1) == 4 &&
+      indices.scalar_type() == kLong && indices.sizes() == weights.sizes(),
+    "grid_sampler_2d_apply_plan(): expected matching [N, H, W, 4] long "
+    "indices and weights, but got indices with sizes ", indices.sizes(),
+    " and weights with sizes ", weights.sizes());
+  AT_CHECK(
+    weights.scalar_type() == input.scalar_type(),
+    "grid_sampler_2d_apply_plan(): expected weights and input to have same "
+    "dtype, but weights has ", weights.scalar_type(), " and input has ",
+    input.scalar_type());
+  AT_CHECK(
+    indices.size(0) == input.size(0) || indices.size(0) == 1,
+    "grid_sampler_2d_apply_plan(): expected plan batch size to be 1 or to "
+    "match input, but got plan batch ", indices.size(0), " for input batch ",
+    input.size(0));
+  auto output = at::empty(
+    {input.size(0), input.size(1), indices.size(1), indices.size(2)},
+    input.options());
+  grid_sampler_2d_apply_plan_cpu_kernel(kCPU, output, input, indices, weights);
+  return output;
+}
+
+DEFINE_DISPATCH(grid_sampler_2d_apply_plan_cpu_kernel);
+
 // No shape checking needed here. See # NOTE [ grid_sampler Native Functions ].
 std::tuple<Tensor, Tensor>
 grid_sampler_3d_backward_cpu(const Tensor& grad_output, const Tensor& input, const Tensor& grid,
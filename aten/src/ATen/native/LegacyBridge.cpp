@@ -3,6 +3,7 @@
 #include <ATen/LegacyTHFunctions.h>
 #include <ATen/core/SparseTensorRef.h>
 #include <ATen/ExpandUtils.h>
+#include <ATen/native/SmallGemm.h>
 
 namespace at { namespace native {
 
@@ -57,6 +58,10 @@ Tensor& addmm_out(Tensor& result, const Tensor& self, const Tensor& mat1, const
     std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm_out");
     return s_native_addmm_out(result, b_self, mat1, mat2, beta, alpha);
   } else {
+    // See Note [Cached small GEMM]
+    if (try_small_gemm_addmm_out(result, self, mat1, mat2, beta, alpha)) {
+      return result;
+    }
     return legacy::th::_th_addmm_out(result, self, mat1, mat2, beta, alpha);
   }
 }
@@ -69,6 +74,11 @@ Tensor addmm(const Tensor& self, const Tensor& mat1, const Tensor& mat2, Scalar
     std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm");
     return s_native_addmm(b_self, mat1, mat2, beta, alpha);
   } else {
+    // See Note [Cached small GEMM]
+    Tensor result = try_small_gemm_addmm(self, mat1, mat2, beta, alpha);
+    if (result.defined()) {
+      return result;
+    }
     return legacy::th::_th_addmm(self, mat1, mat2, beta, alpha);
   }
 }
@@ -1,6 +1,9 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/LegacyTHFunctions.h>
+#include <ATen/native/StreamCompaction.h>
+#include <ATen/native/cpu/SortKernel.h>
+#include <ATen/native/cpu/TopKKernel.h>
 
 namespace at { namespace native {
 
@@ -377,18 +380,36 @@ Tensor index_select(const Tensor & self, int64_t dim, const Tensor & index) {
 }
 
 Tensor & masked_select_out(Tensor & result, const Tensor & self, const Tensor & mask) {
+  // See Note [Parallel stream compaction]
+  if (try_masked_select_compact(result, self, mask)) {
+    return result;
+  }
   return at::legacy::th::_th_masked_select_out(result, self, mask);
 }
 
 Tensor masked_select(const Tensor & self, const Tensor & mask) {
+  // See Note [Parallel stream compaction]
+  Tensor result = at::empty({0}, self.options());
+  if (try_masked_select_compact(result, self, mask)) {
+    return result;
+  }
   return at::legacy::th::_th_masked_select(self, mask);
 }
 
 Tensor & nonzero_out(Tensor & result, const Tensor & self) {
+  // See Note [Parallel stream compaction]
+  if (try_nonzero_compact(result, self)) {
+    return result;
+  }
   return at::legacy::th::_th_nonzero_out(result, self);
 }
 
 Tensor nonzero(const Tensor & self) {
+  // See Note [Parallel stream compaction]
+  Tensor result = at::empty({0}, self.options().dtype(kLong));
+  if (try_nonzero_compact(result, self)) {
+    return result;
+  }
   return at::legacy::th::_th_nonzero(self);
 }
 
@@ -504,14 +525,6 @@ Tensor lu_solve(const Tensor & self, const Tensor & LU_data, const Tensor & LU_p
   return at::legacy::th::_th_btrisolve(self, LU_data, LU_pivots);
 }
 
-std::tuple<Tensor,Tensor> _multinomial_alias_setup(const Tensor & probs) {
-  return at::legacy::th::_th_multinomial_alias_setup(probs);
-}
-
-Tensor _multinomial_alias_draw(const Tensor & q, const Tensor & J, int64_t num_samples, Generator * generator) {
-  return at::legacy::th::_th_multinomial_alias_draw(q, J, num_samples, generator);
-}
-
 Tensor & multinomial_out(Tensor & result, const Tensor & self, int64_t num_samples, bool replacement, Generator * generator) {
   return at::legacy::th::_th_multinomial_out(result, self, num_samples, replacement, generator);
 }
@@ -563,14 +576,6 @@ Tensor atan2(const Tensor & self, const Tensor & other) {
   return at::legacy::th::_th_atan2(self, other);
 }
 
-Tensor & _histc_out_cpu(Tensor & result, const Tensor & self, int64_t bins, Scalar min, Scalar max) {
-  return at::legacy::th::_th_histc_out(result, self, bins, min, max);
-}
-
-Tensor _histc_cpu(const Tensor & self, int64_t bins, Scalar min, Scalar max) {
-  return at::legacy::th::_th_histc(self, bins, min, max);
-}
-
 Tensor & sign_out(Tensor & result, const Tensor & self) {
   return at::legacy::th::_th_sign_out(result, self);
 }
@@ -635,22 +640,42 @@ Tensor max(const Tensor & self) {
 }
 
 std::tuple<Tensor &,Tensor &> sort_out(Tensor & values, Tensor & indices, const Tensor & self, int64_t dim, bool descending) {
+  if (can_use_adaptive_sort(self, dim)) {
+    adaptive_sort_stub(kCPU, values, indices, self, descending);
+    return std::forward_as_tuple(values, indices);
+  }
   return at::legacy::th::_th_sort_out(values, indices, self, dim, descending);
 }
 
 std::tuple<Tensor,Tensor> sort(const Tensor & self, int64_t dim, bool descending) {
+  if (can_use_adaptive_sort(self, dim)) {
+    Tensor values = at::empty({0}, self.options());
+    Tensor indices = at::empty({0}, self.options().dtype(kLong));
+    adaptive_sort_stub(kCPU, values, indices, self, descending);
+    return std::make_tuple(values, indices);
+  }
   return at::legacy::th::_th_sort(self, dim, descending);
 }
 
 Tensor argsort(const Tensor & self, int64_t dim, bool descending) {
-  return std::get<1>(at::legacy::th::_th_sort(self, dim, descending));
+  return std::get<1>(at::sort(self, dim, descending));
 }
 
 std::tuple<Tensor &,Tensor &> topk_out(Tensor & values, Tensor & indices, const Tensor & self, int64_t k, int64_t dim, bool largest, bool sorted) {
+  if (can_use_small_k_topk(self, k, dim)) {
+    topk_small_k_stub(kCPU, values, indices, self, k, largest, sorted);
+    return std::forward_as_tuple(values, indices);
+  }
   return at::legacy::th::_th_topk_out(values, indices, self, k, dim, largest, sorted);
 }
 
 std::tuple<Tensor,Tensor> topk(const Tensor & self, int64_t k, int64_t dim, bool largest, bool sorted) {
+  if (can_use_small_k_topk(self, k, dim)) {
+    Tensor values = at::empty({0}, self.options());
+    Tensor indices = at::empty({0}, self.options().dtype(kLong));
+    topk_small_k_stub(kCPU, values, indices, self, k, largest, sorted);
+    return std::make_tuple(values, indices);
+  }
   return at::legacy::th::_th_topk(self, k, dim, largest, sorted);
 }
 
@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/WrapDimUtilsMulti.h>
+#include <ATen/native/Workspace.h>
 
 #include <array>
 #include <cctype>
@@ -23,6 +24,65 @@ Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
   return output;
 }
 
+// See Note [Caller-provided workspaces] in Workspace.h. The only
+// internal temporary linear needs is a contiguous copy of the input so
+// higher-rank inputs can flatten to 2d for the gemm; 2d or contiguous
+// inputs need none.
+int64_t _linear_workspace_size(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias) {
+  if (input.dim() == 2 || input.is_contiguous()) {
+    return 0;
+  }
+  return workspace_align(input.numel() * input.element_size());
+}
+
+Tensor& _linear_with_workspace(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    Tensor& workspace,
+    Tensor& out) {
+  AT_CHECK(
+      input.dim() >= 2,
+      "_linear_with_workspace: input must have at least 2 dimensions");
+  const int64_t in_features = input.size(-1);
+  AT_CHECK(
+      weight.dim() == 2 && weight.size(1) == in_features,
+      "_linear_with_workspace: weight of shape ",
+      weight.sizes(),
+      " does not match input of shape ",
+      input.sizes());
+
+  std::vector<int64_t> output_sizes(input.sizes().begin(), input.sizes().end());
+  output_sizes.back() = weight.size(0);
+  out.resize_(output_sizes);
+  AT_CHECK(
+      out.is_contiguous(), "_linear_with_workspace: out must be contiguous");
+  if (out.numel() == 0) {
+    return out;
+  }
+
+  int64_t offset = 0;
+  Tensor input2d;
+  if (input.is_contiguous()) {
+    input2d = input.view({-1, in_features});
+  } else {
+    Tensor staged =
+        take_workspace(workspace, offset, input.sizes(), input.scalar_type());
+    staged.copy_(input);
+    input2d = staged.view({-1, in_features});
+  }
+  auto out2d = out.view({-1, weight.size(0)});
+  if (bias.defined()) {
+    at::addmm_out(out2d, bias, input2d, weight.t());
+  } else {
+    at::mm_out(out2d, input2d, weight.t());
+  }
+  return out;
+}
+
 // sumproduct_pair computes `(left*right).sum(sumdims)` by means of permutation and
 // batch matrix multiplication
 // its main purpose is to provide a pairwise reduction for einsum
@@ -226,7 +226,7 @@ inline void baddbmm_cpu_kernel(const Tensor& result, const Tensor& self, const T
   auto s0 = self.accessor<scalar_t, 3>();
   auto m0 = mat2.accessor<scalar_t, 3>();
 
-  int64_t grain_size = std::min(internal::GRAIN_SIZE / (is * js * ks), (int64_t)1);
+  int64_t grain_size = std::max(internal::GRAIN_SIZE / (is * js * ks), (int64_t)1);
   parallel_for(0, bs, grain_size, [&](int64_t b_begin, int64_t b_end) {
       for (int64_t b = b_begin; b < b_end; b++) {
         auto r1 = r0[b];
@@ -317,14 +317,42 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
             && self_or_result.is_contiguous()) {
     at::native::_baddbmm_mkl_(self_or_result, batch1, batch2, beta, alpha);
   } else { // split along batch dimension
+    // A serial loop over per-batch GEMMs runs effectively single-threaded
+    // when the matrices are too small for BLAS to parallelize internally
+    // (e.g. attention workloads: batch 512 of 64x64). In that regime,
+    // partition the batch across threads instead; BLAS libraries run
+    // sequentially inside a parallel region, so the per-matrix calls do
+    // not oversubscribe. For large matrices keep the serial loop so BLAS
+    // can use its own (better-blocked) internal threading.
+    const int64_t kSmallGemmThreshold = int64_t(1) << 18; // ~64^3 madds
+    const bool parallelize_over_batch = bs > 1 &&
+        contraction_size * res_rows * res_cols <= kSmallGemmThreshold &&
+        !at::in_parallel_region();
     if (is_bmm_out) {
-      for (int64_t b = 0; b < bs; b++) {
-        auto r = self_or_result.select(0, b);
-        at::native::mm_out(r, batch1.select(0, b), batch2.select(0, b));
+      if (parallelize_over_batch) {
+        at::parallel_for(0, bs, 1, [&](int64_t b_begin, int64_t b_end) {
+          for (int64_t b = b_begin; b < b_end; b++) {
+            auto r = self_or_result.select(0, b);
+            at::native::mm_out(r, batch1.select(0, b), batch2.select(0, b));
+          }
+        });
+      } else {
+        for (int64_t b = 0; b < bs; b++) {
+          auto r = self_or_result.select(0, b);
+          at::native::mm_out(r, batch1.select(0, b), batch2.select(0, b));
+        }
       }
     } else {
-      for (int64_t b = 0; b < bs; b++) {
-        self_or_result.select(0, b).addmm_(batch1.select(0, b), batch2.select(0, b), beta, alpha);
+      if (parallelize_over_batch) {
+        at::parallel_for(0, bs, 1, [&](int64_t b_begin, int64_t b_end) {
+          for (int64_t b = b_begin; b < b_end; b++) {
+            self_or_result.select(0, b).addmm_(batch1.select(0, b), batch2.select(0, b), beta, alpha);
+          }
+        });
+      } else {
+        for (int64_t b = 0; b < bs; b++) {
+          self_or_result.select(0, b).addmm_(batch1.select(0, b), batch2.select(0, b), beta, alpha);
+        }
       }
     }
   }
@@ -5,14 +5,20 @@
 #include <ATen/Parallel.h>
 #include <ATen/Config.h>
 
+#include <ATen/core/grad_mode.h>
 #include <ATen/detail/CUDAHooksInterface.h>
+#include <ATen/native/Workspace.h>
+#include <ATen/native/cpu/RowwiseNormKernel.h>
 
+#include <algorithm>
 #include <vector>
 
 static const int MIOPEN_DIM_MAX = 4;
 
 namespace at { namespace native {
 
+DEFINE_DISPATCH(rowwise_norm_stub);
+
 namespace {
   void check_dims_match_num_input_features(const char* arg_name, int64_t expected, int64_t actual){
     AT_CHECK(actual == expected,
@@ -25,6 +31,35 @@ namespace {
     }
     return t;
   }
+
+  // The rowwise_norm fast path for layer_norm/group_norm computes the
+  // statistics and the normalize directly instead of round-tripping
+  // through batch_norm's reduction machinery; it produces no autograd
+  // graph, so it is restricted to inference.
+  static bool can_use_rowwise_norm(const Tensor& t) {
+    return !t.defined() ||
+        (!t.requires_grad() && !t.is_sparse() &&
+         t.device().type() == at::kCPU &&
+         (t.scalar_type() == kFloat || t.scalar_type() == kDouble));
+  }
+
+  static bool can_use_rowwise_norm(
+      const Tensor& input,
+      const Tensor& weight,
+      const Tensor& bias) {
+    if (GradMode::is_enabled() || !input.defined() ||
+        !can_use_rowwise_norm(input) || !can_use_rowwise_norm(weight) ||
+        !can_use_rowwise_norm(bias)) {
+      return false;
+    }
+    if (weight.defined() && weight.scalar_type() != input.scalar_type()) {
+      return false;
+    }
+    if (bias.defined() && bias.scalar_type() != input.scalar_type()) {
+      return false;
+    }
+    return true;
+  }
 }
 
 // TensorAccessor when it is defined to work around undefined...
@@ -502,6 +537,25 @@ Tensor layer_norm(const Tensor& input, IntArrayRef normalized_shape,
       n *= input_shape[i];
     }
 
+    // For inference on CPU, compute the per-row statistics and the
+    // normalize-scale-shift in one fused kernel; the batch_norm path below
+    // pays a TensorIterator reduction setup per row that dominates for the
+    // short rows layer norm typically sees.
+    if (can_use_rowwise_norm(input, weight, bias)) {
+      const int64_t row_len = input.numel() / std::max<int64_t>(1, n);
+      if (n > 0 && row_len > 0) {
+        auto input_contiguous = input.contiguous();
+        auto weight_contiguous =
+            weight.defined() ? weight.contiguous() : weight;
+        auto bias_contiguous = bias.defined() ? bias.contiguous() : bias;
+        auto out = at::empty_like(input_contiguous);
+        rowwise_norm_stub(
+            kCPU, out, input_contiguous, n, row_len, weight_contiguous,
+            bias_contiguous, eps);
+        return out;
+      }
+    }
+
     // Apply layer norm
     auto input_reshaped = input.contiguous().view({1, n, -1});
 
@@ -520,6 +574,93 @@ Tensor layer_norm(const Tensor& input, IntArrayRef normalized_shape,
     }
 }
 
+// See Note [Caller-provided workspaces] in Workspace.h. The workspace
+// variant runs the rowwise inference fast path, whose only temporaries
+// are contiguous copies of non-contiguous arguments.
+int64_t _layer_norm_workspace_size(
+    const Tensor& input,
+    IntArrayRef normalized_shape,
+    const Tensor& weight,
+    const Tensor& bias) {
+  int64_t bytes = 0;
+  if (!input.is_contiguous()) {
+    bytes += workspace_align(input.numel() * input.element_size());
+  }
+  if (weight.defined() && !weight.is_contiguous()) {
+    bytes += workspace_align(weight.numel() * weight.element_size());
+  }
+  if (bias.defined() && !bias.is_contiguous()) {
+    bytes += workspace_align(bias.numel() * bias.element_size());
+  }
+  return bytes;
+}
+
+Tensor& _layer_norm_with_workspace(
+    const Tensor& input,
+    IntArrayRef normalized_shape,
+    const Tensor& weight,
+    const Tensor& bias,
+    double eps,
+    Tensor& workspace,
+    Tensor& out) {
+  const int64_t normalized_ndim = normalized_shape.size();
+  AT_CHECK(
+      normalized_ndim >= 1,
+      "_layer_norm_with_workspace: expected normalized_shape to be at least "
+      "1-dimensional, but got normalized_shape=",
+      normalized_shape);
+  AT_CHECK(
+      input.dim() >= normalized_ndim &&
+          input.sizes()
+              .slice(input.dim() - normalized_ndim)
+              .equals(normalized_shape),
+      "_layer_norm_with_workspace: given normalized_shape=",
+      normalized_shape,
+      ", got input of size ",
+      input.sizes());
+  AT_CHECK(!weight.defined() || weight.sizes().equals(normalized_shape),
+      "_layer_norm_with_workspace: weight of shape ", weight.sizes(),
+      " does not match normalized_shape=", normalized_shape);
+  AT_CHECK(!bias.defined() || bias.sizes().equals(normalized_shape),
+      "_layer_norm_with_workspace: bias of shape ", bias.sizes(),
+      " does not match normalized_shape=", normalized_shape);
+  // Restricting to the rowwise path keeps the temporaries enumerable;
+  // the batch_norm path allocates inside ops this function cannot reach.
+  AT_CHECK(
+      can_use_rowwise_norm(input, weight, bias),
+      "_layer_norm_with_workspace: requires the CPU inference fast path "
+      "(float/double CPU tensors outside autograd); use at::layer_norm "
+      "instead");
+
+  out.resize_(input.sizes());
+  AT_CHECK(
+      out.is_contiguous(),
+      "_layer_norm_with_workspace: out must be contiguous");
+
+  int64_t n = 1;
+  for (int64_t i = 0; i < input.dim() - normalized_ndim; i++) {
+    n *= input.size(i);
+  }
+  const int64_t row_len = input.numel() / std::max<int64_t>(1, n);
+  if (n == 0 || row_len == 0) {
+    return out;
+  }
+
+  int64_t offset = 0;
+  auto stage = [&](const Tensor& t) -> Tensor {
+    if (!t.defined() || t.is_contiguous()) {
+      return t;
+    }
+    Tensor staged =
+        take_workspace(workspace, offset, t.sizes(), t.scalar_type());
+    staged.copy_(t);
+    return staged;
+  };
+  rowwise_norm_stub(
+      kCPU, out, stage(input), n, row_len, stage(weight), stage(bias), eps);
+  return out;
+}
+
 Tensor group_norm(const Tensor& input, int64_t num_groups,
     const Tensor& weight /* optional */, const Tensor& bias /* optional */,
     double eps, bool cudnn_enabled) {
@@ -545,8 +686,19 @@ Tensor group_norm(const Tensor& input, int64_t num_groups,
     // Apply group norm
     auto input_reshaped = input.contiguous().view({1, b * num_groups, -1});
 
-    auto out = at::batch_norm(input_reshaped, {}, {}, {}, {}, true, 0, eps,
-                              cudnn_enabled);
+    Tensor out;
+    // Same fast path as layer_norm, for the statistics and normalize only:
+    // the per-channel affine below is applied with broadcast ops either way.
+    if (can_use_rowwise_norm(input, weight, bias) && input.numel() > 0) {
+      const int64_t rows = b * num_groups;
+      const int64_t row_len = input.numel() / rows;
+      out = at::empty_like(input_reshaped);
+      rowwise_norm_stub(
+          kCPU, out, input_reshaped, rows, row_len, Tensor(), Tensor(), eps);
+    } else {
+      out = at::batch_norm(input_reshaped, {}, {}, {}, {}, true, 0, eps,
+                           cudnn_enabled);
+    }
     out = out.view(input_shape);
 
     if (!weight.defined() && !bias.defined()) {
@@ -38,19 +38,33 @@ std::tuple<Tensor, Tensor> _pack_padded_sequence(const Tensor& _input, const Ten
     }
   }
 
-  std::vector<at::Tensor> steps;
-  steps.reserve(batch_size);
   at::Tensor batch_sizes_t = at::empty(lengths[0], _lengths.options());
   int64_t * batch_sizes = batch_sizes_t.data<int64_t>();
 
-  std::vector<int64_t> step_shape; // == [-1, *input.shape[2:]]
+  // The packed output is preallocated and each block is copied into its
+  // final rows directly. The previous implementation materialized every
+  // block with .contiguous() and then concatenated them, copying all the
+  // data twice; copy_ also handles the strided source in one pass, so no
+  // intermediate index tensors or gathers are involved.
+  int64_t total_rows = 0;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    total_rows += lengths[i];
+  }
+
+  std::vector<int64_t> output_shape; // == [total_rows, *input.shape[2:]]
+  std::vector<int64_t> block_shape; // == [time, batch, *input.shape[2:]]
   {
     auto input_sizes = input.sizes();
-    step_shape.reserve(input_sizes.size());
     auto s_input_sizes = input_sizes.slice(2);
-    step_shape.push_back(-1);
-    step_shape.insert(step_shape.end(), s_input_sizes.begin(), s_input_sizes.end());
+    output_shape.reserve(input_sizes.size() - 1);
+    output_shape.push_back(total_rows);
+    output_shape.insert(output_shape.end(), s_input_sizes.begin(), s_input_sizes.end());
+    block_shape.reserve(input_sizes.size());
+    block_shape.push_back(-1);
+    block_shape.push_back(-1);
+    block_shape.insert(block_shape.end(), s_input_sizes.begin(), s_input_sizes.end());
   }
+  at::Tensor output = at::empty(output_shape, input.options());
 
   // To understand what's going on in this loop imagine that the input is a padded 2D
   // array that looks like this (x = valid entry, . = padding)
@@ -73,11 +87,18 @@ std::tuple<Tensor, Tensor> _pack_padded_sequence(const Tensor& _input, const Ten
   // more elements below in our column, we lower the counter (prev_l), and append the new
   // block to the output.
   int64_t prev_l = 0;
+  int64_t out_offset = 0;
   for (int64_t i = 0; i < batch_size; ++i) {
     int64_t l = lengths[batch_size - 1 - i];
     if (l > prev_l) {
       auto current_batch_size = batch_size - i;
-      steps.push_back(input.slice(0, prev_l, l).slice(1, 0, current_batch_size).contiguous().view(step_shape));
+      int64_t rows = (l - prev_l) * current_batch_size;
+      block_shape[0] = l - prev_l;
+      block_shape[1] = current_batch_size;
+      output.narrow(0, out_offset, rows)
+          .view(block_shape)
+          .copy_(input.slice(0, prev_l, l).slice(1, 0, current_batch_size));
+      out_offset += rows;
       for (int64_t j = 0; j < (l - prev_l); ++j) {
         (*batch_sizes++) = current_batch_size;
       }
@@ -86,7 +107,7 @@ std::tuple<Tensor, Tensor> _pack_padded_sequence(const Tensor& _input, const Ten
     AT_CHECK(l >= prev_l);
   }
 
-  return std::make_tuple(at::cat(steps), batch_sizes_t);
+  return std::make_tuple(output, batch_sizes_t);
 }
 
 // `grad` could be on arbitrary device and of arbitrary dtype, but `_batch_sizes`
@@ -2,6 +2,11 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/grad_mode.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <cmath>
 
 namespace at { namespace native {
 
@@ -248,6 +253,86 @@ struct SimpleCell : Cell<Tensor, cell_params> {
   }
 };
 
+// For the hidden sizes typical of LSTM cells, the eight dispatched pointwise
+// ops below (chunk, sigmoid x3, tanh x2, mul x3, add x2) cost as much as the
+// gate GEMMs. When no autograd graph is needed we can instead make a single
+// pass over the gate matrices, summing the input and hidden gates and
+// applying the activations and state update in registers, parallelized
+// across the batch.
+inline bool can_use_fused_lstm_cell_cpu(
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& cx) {
+  return !GradMode::is_enabled() && !igates.requires_grad() &&
+      !hgates.requires_grad() && !cx.requires_grad() && cx.dim() == 2 &&
+      igates.scalar_type() == kFloat && igates.is_contiguous() &&
+      hgates.is_contiguous() && cx.is_contiguous();
+}
+
+std::tuple<Tensor, Tensor> fused_lstm_cell_cpu(
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& cx) {
+  const int64_t batch_size = cx.size(0);
+  const int64_t hidden_size = cx.size(1);
+  auto hy = at::empty_like(cx);
+  auto cy = at::empty_like(cx);
+
+  const float* igates_data = igates.data<float>();
+  const float* hgates_data = hgates.data<float>();
+  const float* cx_data = cx.data<float>();
+  float* hy_data = hy.data<float>();
+  float* cy_data = cy.data<float>();
+
+  using Vec = vec256::Vec256<float>;
+  const auto sigmoid = [](Vec x) {
+    return Vec(1.0f) / (Vec(1.0f) + x.neg().exp());
+  };
+
+  at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      // Gate layout matches chunk(4, 1): input, forget, cell, output.
+      const float* ig = igates_data + b * 4 * hidden_size;
+      const float* hg = hgates_data + b * 4 * hidden_size;
+      const float* c = cx_data + b * hidden_size;
+      float* hy_row = hy_data + b * hidden_size;
+      float* cy_row = cy_data + b * hidden_size;
+
+      int64_t d = 0;
+      for (; d + Vec::size() <= hidden_size; d += Vec::size()) {
+        Vec in_gate = sigmoid(Vec::loadu(ig + d) + Vec::loadu(hg + d));
+        Vec forget_gate = sigmoid(
+            Vec::loadu(ig + hidden_size + d) +
+            Vec::loadu(hg + hidden_size + d));
+        Vec cell_gate = (Vec::loadu(ig + 2 * hidden_size + d) +
+                         Vec::loadu(hg + 2 * hidden_size + d))
+                            .tanh();
+        Vec out_gate = sigmoid(
+            Vec::loadu(ig + 3 * hidden_size + d) +
+            Vec::loadu(hg + 3 * hidden_size + d));
+        Vec new_cell = forget_gate * Vec::loadu(c + d) + in_gate * cell_gate;
+        new_cell.store(cy_row + d);
+        (out_gate * new_cell.tanh()).store(hy_row + d);
+      }
+      for (; d < hidden_size; d++) {
+        float in_gate = 1.0f / (1.0f + std::exp(-(ig[d] + hg[d])));
+        float forget_gate = 1.0f /
+            (1.0f + std::exp(-(ig[hidden_size + d] + hg[hidden_size + d])));
+        float cell_gate =
+            std::tanh(ig[2 * hidden_size + d] + hg[2 * hidden_size + d]);
+        float out_gate = 1.0f /
+            (1.0f +
+             std::exp(-(ig[3 * hidden_size + d] + hg[3 * hidden_size + d])));
+        float new_cell = forget_gate * c[d] + in_gate * cell_gate;
+        cy_row[d] = new_cell;
+        hy_row[d] = out_gate * std::tanh(new_cell);
+      }
+    }
+  });
+
+  return std::make_tuple(hy, cy);
+}
+
 // TODO: can use inplace ops?
 template <typename cell_params>
 struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
@@ -264,7 +349,13 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
       return std::make_tuple(std::get<0>(result), std::get<1>(result));
     }
 
-    auto gates = params.linear_ih(input) + params.linear_hh(hx);
+    auto igates = params.linear_ih(input);
+    auto hgates = params.linear_hh(hx);
+    if (can_use_fused_lstm_cell_cpu(igates, hgates, cx)) {
+      return fused_lstm_cell_cpu(igates, hgates, cx);
+    }
+
+    auto gates = igates + hgates;
     auto chunked_gates = gates.chunk(4, 1);
 
     auto ingate = chunked_gates[0].sigmoid();
@@ -11,6 +11,7 @@
 #include <ATen/native/TensorIterator.h>
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <numeric>
@@ -86,6 +87,33 @@ static Tensor review_reduce_result(const Tensor& result, int ndim, DimMask mask,
   return result.as_strided(shape, stride);
 }
 
+// Note [Widened accumulation for CPU reductions]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When the reduction dtype differs from the input dtype, make_reduction
+// historically materialized an upcast copy of the whole input - a full
+// extra pass over memory - before reducing, except for the Half->Float
+// pair on CUDA. The CPU sum/prod kernels now read the input at its own
+// dtype and carry a widened accumulator (the AccumulateType mapping: Half
+// accumulates in float, the integral types in int64_t), so the pairs
+// listed here can hand the raw input straight to the kernel. The same
+// machinery lets a dtype-less sum over a Half tensor keep its Half result
+// while still reducing in float registers, instead of overflowing or
+// paying for an upcast copy.
+static bool can_accumulate_in_kernel(
+    const char* name, const Tensor& self, ScalarType dtype) {
+  const ScalarType src_type = self.scalar_type();
+  if (self.is_cuda()) {
+    return src_type == kHalf && dtype == kFloat;
+  }
+  // Only the CPU sum and prod kernels read the input at its own dtype; the
+  // other families still expect the input to arrive at the output dtype.
+  if (strcmp(name, "sum") != 0 && strcmp(name, "prod") != 0) {
+    return false;
+  }
+  return (src_type == kHalf && dtype == kFloat) ||
+      (at::isIntegralType(src_type) && dtype == kLong);
+}
+
 static std::unique_ptr<TensorIterator> make_reduction(
     const char* name, Tensor& result, const Tensor& self, IntArrayRef dim,
     bool keepdim, ScalarType dtype)
@@ -108,7 +136,7 @@ static std::unique_ptr<TensorIterator> make_reduction(
   // not generalize this to common mismatched input/output types to avoid cross
   // product of templated kernel launches.
   if (self.scalar_type() == dtype ||
-      (self.is_cuda() && self.scalar_type() == kHalf && dtype == kFloat)) {
+      can_accumulate_in_kernel(name, self, dtype)) {
     return TensorIterator::reduce_op(viewed_result, self);
   }
   return TensorIterator::reduce_op(viewed_result, self.to(dtype));
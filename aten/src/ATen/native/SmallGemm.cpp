@@ -0,0 +1,232 @@
+#include <ATen/native/SmallGemm.h>
+
+#include <ATen/native/cpu/SmallGemmKernel.h>
+
+#include <c10/core/TensorImpl.h>
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(small_gemm_stub);
+
+namespace {
+
+// Note [Cached small GEMM]
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// For fully-connected layers with small batches (m <= 8) and weights of at
+// most ~1MB, the fixed cost of the BLAS path - dispatch, threading decisions
+// and internal packing of the weight on every call - is comparable to or
+// larger than the GEMM itself. When PYTORCH_CACHED_SMALL_GEMM=1 is set,
+// addmm routes qualifying float CPU products through a register-blocked
+// Vec256 kernel instead, fed from a cache of pre-packed weight panels.
+//
+// Cache entries are keyed by the weight's data pointer and validated
+// against its version counter (bumped by every in-place mutation, see
+// c10/core/TensorImpl.h), sizes and strides, so an updated or reshaped
+// weight is transparently repacked. The pathological case - writes that
+// bypass the version counter by poking at the raw storage - is the same
+// caveat the cuDNN plan caches live with, and is one reason the path is
+// opt-in. Entries are dropped only when the cache is full; the steady-state
+// weight set of an inference service is small and stable, so a modest cap
+// suffices.
+
+bool small_gemm_enabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("PYTORCH_CACHED_SMALL_GEMM");
+    return env && env[0] == '1';
+  }();
+  return enabled;
+}
+
+struct PackedWeight {
+  uint32_t version;
+  std::vector<int64_t> sizes;
+  std::vector<int64_t> strides;
+  // [ceil(n / kSmallGemmPanel), k, kSmallGemmPanel], zero-padded
+  std::vector<float> panels;
+};
+
+std::mutex cache_mutex;
+std::unordered_map<const void*, std::shared_ptr<const PackedWeight>>
+    packed_weight_cache;
+constexpr size_t kMaxCachedWeights = 64;
+
+std::shared_ptr<const PackedWeight> pack_weight(const Tensor& mat2) {
+  const int64_t k = mat2.size(0);
+  const int64_t n = mat2.size(1);
+  const int64_t panels = (n + kSmallGemmPanel - 1) / kSmallGemmPanel;
+  auto packed = std::make_shared<PackedWeight>();
+  packed->version = mat2.unsafeGetTensorImpl()->version_counter().current_version();
+  packed->sizes = mat2.sizes().vec();
+  packed->strides = mat2.strides().vec();
+  packed->panels.assign(panels * k * kSmallGemmPanel, 0.f);
+  const float* b = mat2.data<float>();
+  const int64_t s0 = mat2.stride(0);
+  const int64_t s1 = mat2.stride(1);
+  for (int64_t p = 0; p < panels; p++) {
+    const int64_t col = p * kSmallGemmPanel;
+    const int64_t count = std::min(kSmallGemmPanel, n - col);
+    float* out = packed->panels.data() + p * k * kSmallGemmPanel;
+    for (int64_t kk = 0; kk < k; kk++) {
+      for (int64_t j = 0; j < count; j++) {
+        out[kk * kSmallGemmPanel + j] = b[kk * s0 + (col + j) * s1];
+      }
+    }
+  }
+  return packed;
+}
+
+std::shared_ptr<const PackedWeight> get_packed_weight(const Tensor& mat2) {
+  const void* key = mat2.data_ptr();
+  const uint32_t version =
+      mat2.unsafeGetTensorImpl()->version_counter().current_version();
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = packed_weight_cache.find(key);
+    if (it != packed_weight_cache.end() && it->second->version == version &&
+        mat2.sizes().equals(it->second->sizes) &&
+        mat2.strides().equals(it->second->strides)) {
+      return it->second;
+    }
+  }
+  auto packed = pack_weight(mat2);
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = packed_weight_cache.find(key);
+  if (it != packed_weight_cache.end()) {
+    it->second = packed;
+  } else if (packed_weight_cache.size() < kMaxCachedWeights) {
+    packed_weight_cache.emplace(key, packed);
+  }
+  // At capacity with a new weight, the packed panels are used once and
+  // discarded rather than evicting an established entry.
+  return packed;
+}
+
+bool is_plain_cpu_float(const Tensor& t) {
+  return !t.is_cuda() && !t.is_sparse() && t.scalar_type() == kFloat;
+}
+
+bool small_gemm_viable(
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta) {
+  if (!small_gemm_enabled()) {
+    return false;
+  }
+  if (mat1.dim() != 2 || mat2.dim() != 2 ||
+      mat1.size(1) != mat2.size(0)) {
+    return false;
+  }
+  const int64_t m = mat1.size(0);
+  const int64_t n = mat2.size(1);
+  const int64_t k = mat1.size(1);
+  if (m < 1 || m > kSmallGemmMaxRows || n < 1 || k < 1) {
+    return false;
+  }
+  // The pack-once-run-many trade only pays off for weights that stay
+  // cache-resident; larger products belong to BLAS anyway.
+  if (mat2.numel() * static_cast<int64_t>(sizeof(float)) > (1 << 20)) {
+    return false;
+  }
+  if (!is_plain_cpu_float(mat1) || !is_plain_cpu_float(mat2) ||
+      !mat1.is_contiguous()) {
+    return false;
+  }
+  if (beta.to<float>() != 0.f) {
+    // The kernel adds self row-wise: either one broadcast row of n
+    // elements or a full [m, n] matrix. Anything else (including the
+    // shape errors _th_addmm would diagnose) falls through.
+    if (!is_plain_cpu_float(self) || !self.is_contiguous()) {
+      return false;
+    }
+    if (self.dim() == 1) {
+      if (self.size(0) != n) {
+        return false;
+      }
+    } else if (self.dim() != 2 || self.size(0) != m || self.size(1) != n) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void run_small_gemm(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha) {
+  const int64_t m = mat1.size(0);
+  const int64_t n = mat2.size(1);
+  const int64_t k = mat1.size(1);
+  auto packed = get_packed_weight(mat2);
+  const float beta_val = beta.to<float>();
+  const float* self_data = nullptr;
+  int64_t self_row_stride = 0;
+  if (beta_val != 0.f) {
+    self_data = self.data<float>();
+    self_row_stride = self.dim() == 2 ? n : 0;
+  }
+  small_gemm_stub(
+      kCPU,
+      result.data<float>(),
+      self_data,
+      self_row_stride,
+      mat1.data<float>(),
+      /*mat1_row_stride=*/k,
+      packed->panels.data(),
+      m,
+      n,
+      k,
+      alpha.to<float>(),
+      beta_val);
+}
+
+} // namespace
+
+bool try_small_gemm_addmm_out(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha) {
+  if (!small_gemm_viable(self, mat1, mat2, beta)) {
+    return false;
+  }
+  if (result.is_cuda() || result.is_sparse() ||
+      result.scalar_type() != kFloat) {
+    return false;
+  }
+  // _th_addmm_out resizes the result the same way, so this is not
+  // observable on the fallback path.
+  result.resize_({mat1.size(0), mat2.size(1)});
+  if (!result.is_contiguous()) {
+    return false;
+  }
+  run_small_gemm(result, self, mat1, mat2, beta, alpha);
+  return true;
+}
+
+Tensor try_small_gemm_addmm(
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha) {
+  if (!small_gemm_viable(self, mat1, mat2, beta)) {
+    return Tensor();
+  }
+  Tensor result = at::empty({mat1.size(0), mat2.size(1)}, mat1.options());
+  run_small_gemm(result, self, mat1, mat2, beta, alpha);
+  return result;
+}
+
+}} // namespace at::native
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+// Opt-in fast path for small fully-connected products; see
+// Note [Cached small GEMM] in SmallGemm.cpp. Both entry points return
+// a "not taken" value (false / an undefined Tensor) when the inputs do
+// not qualify, in which case the caller must fall through to the
+// regular addmm implementation.
+bool try_small_gemm_addmm_out(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha);
+
+Tensor try_small_gemm_addmm(
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha);
+
+}} // namespace at::native
@@ -228,6 +228,86 @@ Tensor log_softmax_backward_cpu(
   return grad_input;
 }
 
+// Masked softmax over the last dimension. `mask` is broadcast against
+// the input; nonzero entries mark positions to exclude (the masked_fill
+// convention) and receive weight exactly 0. Padded-tail masks - the
+// common attention case - skip computation over the tail entirely
+// instead of masking it; see the kernel. This replaces the
+// masked_fill(-inf) + softmax idiom in one pass (the JIT rewrites that
+// idiom to this op, see peephole.cpp); the one behavioral difference is
+// that fully masked rows produce zeros rather than NaNs.
+Tensor masked_softmax_cpu(const Tensor& self_, const Tensor& mask_) {
+  AT_CHECK(
+      self_.dim() >= 1, "_masked_softmax: input must have at least 1 dimension");
+  AT_CHECK(
+      mask_.scalar_type() == ScalarType::Byte,
+      "_masked_softmax: expected mask of scalar type Byte but got ",
+      mask_.scalar_type());
+  auto self = self_.contiguous();
+  auto mask = mask_.expand_as(self_).contiguous();
+  Tensor output = at::native::empty_like(self);
+  if (self.numel() == 0) {
+    return output;
+  }
+  masked_softmax_lastdim_kernel(kCPU, output, self, mask);
+  return output;
+}
+
+// Fused softmax + cross entropy over the last dimension with class-index
+// targets. Computes, per row, loss = logsumexp(x) - x[target] without ever
+// materializing the softmax output; for large-vocabulary heads this halves
+// the memory traffic of log_softmax followed by nll_loss. Returns the
+// per-row losses; reduce with mean()/sum() as needed.
+Tensor softmax_cross_entropy_cpu(const Tensor& self_, const Tensor& target_) {
+  AT_CHECK(
+      self_.dim() >= 1, "softmax_cross_entropy: input must have at least 1 dimension");
+  AT_CHECK(
+      target_.scalar_type() == ScalarType::Long,
+      "softmax_cross_entropy: expected target of scalar type Long but got ",
+      target_.scalar_type());
+  auto self = self_.contiguous();
+  auto target = target_.contiguous();
+  const int64_t dim_size = self.size(-1);
+  AT_CHECK(
+      target.sizes().equals(self.sizes().slice(0, self.dim() - 1)),
+      "softmax_cross_entropy: target sizes must match input sizes without the class dimension");
+  Tensor loss = at::empty(target.sizes(), self.options());
+  if (loss.numel() == 0) {
+    return loss;
+  }
+  AT_CHECK(dim_size > 0, "softmax_cross_entropy: input has no classes");
+  AT_CHECK(
+      target.min().item<int64_t>() >= 0 &&
+          target.max().item<int64_t>() < dim_size,
+      "softmax_cross_entropy: target values must be in [0, ", dim_size, ")");
+  softmax_cross_entropy_lastdim_kernel(kCPU, loss, self, target);
+  return loss;
+}
+
+Tensor softmax_cross_entropy_backward_cpu(
+    const Tensor& grad_,
+    const Tensor& self_,
+    const Tensor& target_) {
+  auto self = self_.contiguous();
+  auto grad = grad_.contiguous();
+  auto target = target_.contiguous();
+  AT_CHECK(
+      grad.sizes().equals(target.sizes()),
+      "softmax_cross_entropy_backward: grad_output sizes must match target sizes");
+  Tensor grad_input = at::native::empty_like(self);
+  if (grad_input.numel() == 0) {
+    return grad_input;
+  }
+  const int64_t dim_size = self.size(-1);
+  AT_CHECK(
+      target.min().item<int64_t>() >= 0 &&
+          target.max().item<int64_t>() < dim_size,
+      "softmax_cross_entropy_backward: target values must be in [0, ", dim_size, ")");
+  softmax_cross_entropy_backward_lastdim_kernel(
+      kCPU, grad_input, grad, self, target);
+  return grad_input;
+}
+
 Tensor softmax(const Tensor& input_, const int64_t dim_) {
   return at::_softmax(input_, dim_, false);
 }
@@ -253,9 +333,12 @@ Tensor log_softmax(const Tensor& input_, const int64_t dim_, ScalarType dtype) {
 }
 
 DEFINE_DISPATCH(softmax_lastdim_kernel);
+DEFINE_DISPATCH(masked_softmax_lastdim_kernel);
 DEFINE_DISPATCH(log_softmax_lastdim_kernel);
 DEFINE_DISPATCH(softmax_backward_lastdim_kernel);
 DEFINE_DISPATCH(log_softmax_backward_lastdim_kernel);
+DEFINE_DISPATCH(softmax_cross_entropy_lastdim_kernel);
+DEFINE_DISPATCH(softmax_cross_entropy_backward_lastdim_kernel);
 
 }
 }
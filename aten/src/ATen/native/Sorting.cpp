@@ -3,10 +3,48 @@
 #include <ATen/Parallel.h>
 #include <ATen/WrapDimUtils.h>
 #include <ATen/native/SortingUtils.h>
+#include <ATen/native/cpu/SortKernel.h>
+#include <ATen/native/cpu/TopKKernel.h>
 
 namespace at {
 namespace native {
 
+DEFINE_DISPATCH(topk_small_k_stub);
+DEFINE_DISPATCH(adaptive_sort_stub);
+
+bool can_use_small_k_topk(const Tensor& self, int64_t k, int64_t dim) {
+  if (!self.defined() || self.is_sparse() ||
+      self.device().type() != at::kCPU) {
+    return false;
+  }
+  if (self.dim() == 0 || self.numel() == 0) {
+    return false;
+  }
+  // The kernel dispatches over AT_DISPATCH_ALL_TYPES.
+  if (self.scalar_type() == kHalf) {
+    return false;
+  }
+  const int64_t wrapped = maybe_wrap_dim(dim, self.dim());
+  return wrapped == self.dim() - 1 && self.is_contiguous() && k > 0 &&
+      k <= kMaxSmallTopK && k <= self.size(wrapped);
+}
+
+bool can_use_adaptive_sort(const Tensor& self, int64_t dim) {
+  if (!self.defined() || self.is_sparse() ||
+      self.device().type() != at::kCPU) {
+    return false;
+  }
+  if (self.dim() == 0 || self.numel() == 0) {
+    return false;
+  }
+  // The kernel dispatches over AT_DISPATCH_ALL_TYPES.
+  if (self.scalar_type() == kHalf) {
+    return false;
+  }
+  const int64_t wrapped = maybe_wrap_dim(dim, self.dim());
+  return wrapped == self.dim() - 1 && self.is_contiguous();
+}
+
 namespace {
 
 // maybe these days, one should define a random access iterator and use
@@ -0,0 +1,222 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/NativeFunctions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+// Note [Fused sparse Adagrad]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Applying Adagrad to a sparse embedding gradient through generic tensor ops
+// costs a coalesce (sort + reduce of the gradient), an index_select of the
+// state rows, several temporaries of nnz * dim floats, and an index_add back
+// into the parameter. These kernels instead walk the (indices, values) pair
+// directly against the dense parameter and state tensors: gradient entries
+// are grouped by destination row, duplicates are summed on the fly (the
+// mathematically correct treatment, and what coalescing achieved before),
+// and each unique row is read and written exactly once. Work is parallelized
+// over unique rows, which are guaranteed disjoint, so no synchronization is
+// needed on the parameter or state.
+
+struct RowSegments {
+  // entry positions into indices/grad, grouped by destination row
+  std::vector<int64_t> order;
+  // [start, end) offsets into `order`, one per unique row
+  std::vector<std::pair<int64_t, int64_t>> segments;
+};
+
+RowSegments group_by_row(const Tensor& indices, int64_t num_rows) {
+  auto indices_contig = indices.contiguous();
+  const int64_t* idx = indices_contig.data<int64_t>();
+  const int64_t nnz = indices.numel();
+
+  RowSegments result;
+  result.order.resize(nnz);
+  std::iota(result.order.begin(), result.order.end(), 0);
+  std::sort(
+      result.order.begin(),
+      result.order.end(),
+      [idx](int64_t a, int64_t b) { return idx[a] < idx[b]; });
+
+  for (int64_t i = 0; i < nnz; i++) {
+    const int64_t row = idx[result.order[i]];
+    AT_CHECK(
+        row >= 0 && row < num_rows,
+        "index out of range in sparse_adagrad_step_: index ",
+        row,
+        " is out of bounds for parameter with ",
+        num_rows,
+        " rows");
+    if (result.segments.empty() ||
+        idx[result.order[result.segments.back().first]] != row) {
+      result.segments.emplace_back(i, i + 1);
+    } else {
+      result.segments.back().second = i + 1;
+    }
+  }
+  return result;
+}
+
+void check_sparse_adagrad_inputs(
+    const Tensor& param,
+    const Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad,
+    bool rowwise) {
+  AT_CHECK(
+      param.dim() == 2, "param must be 2-d, but got ", param.dim(), "-d");
+  AT_CHECK(
+      indices.dim() == 1 && indices.scalar_type() == kLong,
+      "indices must be a 1-d long tensor");
+  AT_CHECK(
+      grad.dim() == 2 && grad.size(0) == indices.numel() &&
+          grad.size(1) == param.size(1),
+      "grad must have shape [",
+      indices.numel(),
+      ", ",
+      param.size(1),
+      "], but got ",
+      grad.sizes());
+  if (rowwise) {
+    AT_CHECK(
+        state_sum.dim() == 1 && state_sum.size(0) == param.size(0),
+        "state_sum must have one entry per parameter row");
+  } else {
+    AT_CHECK(
+        state_sum.sizes().equals(param.sizes()),
+        "state_sum must have the same shape as param");
+  }
+  AT_CHECK(
+      param.is_contiguous() && state_sum.is_contiguous(),
+      "param and state_sum must be contiguous");
+  AT_CHECK(
+      param.scalar_type() == state_sum.scalar_type() &&
+          param.scalar_type() == grad.scalar_type(),
+      "param, state_sum and grad must have the same dtype");
+}
+
+} // namespace
+
+Tensor& sparse_adagrad_step_cpu_(
+    Tensor& param,
+    Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad,
+    double lr,
+    double eps) {
+  check_sparse_adagrad_inputs(param, state_sum, indices, grad, /*rowwise=*/false);
+  if (indices.numel() == 0) {
+    return param;
+  }
+  const int64_t dim = param.size(1);
+  auto grouped = group_by_row(indices, param.size(0));
+  auto grad_contig = grad.contiguous();
+  auto indices_contig = indices.contiguous();
+
+  AT_DISPATCH_FLOATING_TYPES(param.scalar_type(), "sparse_adagrad_step_", [&] {
+    scalar_t* param_data = param.data<scalar_t>();
+    scalar_t* state_data = state_sum.data<scalar_t>();
+    const scalar_t* grad_data = grad_contig.data<scalar_t>();
+    const int64_t* idx = indices_contig.data<int64_t>();
+
+    at::parallel_for(
+        0, grouped.segments.size(), 0, [&](int64_t begin, int64_t end) {
+          std::vector<scalar_t> summed;
+          for (int64_t s = begin; s < end; s++) {
+            const auto segment = grouped.segments[s];
+            const int64_t row = idx[grouped.order[segment.first]];
+            const scalar_t* g = grad_data + grouped.order[segment.first] * dim;
+            if (segment.second - segment.first > 1) {
+              // duplicate indices: sum their gradient rows first
+              summed.assign(g, g + dim);
+              for (int64_t e = segment.first + 1; e < segment.second; e++) {
+                const scalar_t* other =
+                    grad_data + grouped.order[e] * dim;
+                for (int64_t d = 0; d < dim; d++) {
+                  summed[d] += other[d];
+                }
+              }
+              g = summed.data();
+            }
+            scalar_t* p = param_data + row * dim;
+            scalar_t* state = state_data + row * dim;
+            for (int64_t d = 0; d < dim; d++) {
+              state[d] += g[d] * g[d];
+              p[d] -= static_cast<scalar_t>(lr) * g[d] /
+                  (std::sqrt(state[d]) + static_cast<scalar_t>(eps));
+            }
+          }
+        });
+  });
+  return param;
+}
+
+Tensor& rowwise_sparse_adagrad_step_cpu_(
+    Tensor& param,
+    Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad,
+    double lr,
+    double eps) {
+  check_sparse_adagrad_inputs(param, state_sum, indices, grad, /*rowwise=*/true);
+  if (indices.numel() == 0) {
+    return param;
+  }
+  const int64_t dim = param.size(1);
+  auto grouped = group_by_row(indices, param.size(0));
+  auto grad_contig = grad.contiguous();
+  auto indices_contig = indices.contiguous();
+
+  AT_DISPATCH_FLOATING_TYPES(
+      param.scalar_type(), "rowwise_sparse_adagrad_step_", [&] {
+        scalar_t* param_data = param.data<scalar_t>();
+        scalar_t* state_data = state_sum.data<scalar_t>();
+        const scalar_t* grad_data = grad_contig.data<scalar_t>();
+        const int64_t* idx = indices_contig.data<int64_t>();
+
+        at::parallel_for(
+            0, grouped.segments.size(), 0, [&](int64_t begin, int64_t end) {
+              std::vector<scalar_t> summed;
+              for (int64_t s = begin; s < end; s++) {
+                const auto segment = grouped.segments[s];
+                const int64_t row = idx[grouped.order[segment.first]];
+                const scalar_t* g =
+                    grad_data + grouped.order[segment.first] * dim;
+                if (segment.second - segment.first > 1) {
+                  summed.assign(g, g + dim);
+                  for (int64_t e = segment.first + 1; e < segment.second; e++) {
+                    const scalar_t* other =
+                        grad_data + grouped.order[e] * dim;
+                    for (int64_t d = 0; d < dim; d++) {
+                      summed[d] += other[d];
+                    }
+                  }
+                  g = summed.data();
+                }
+                // One moment scalar per row: accumulate the mean squared
+                // gradient, then apply a single scale to the whole row.
+                scalar_t sq_sum = 0;
+                for (int64_t d = 0; d < dim; d++) {
+                  sq_sum += g[d] * g[d];
+                }
+                state_data[row] += sq_sum / static_cast<scalar_t>(dim);
+                const scalar_t step = static_cast<scalar_t>(lr) /
+                    (std::sqrt(state_data[row]) + static_cast<scalar_t>(eps));
+                scalar_t* p = param_data + row * dim;
+                for (int64_t d = 0; d < dim; d++) {
+                  p[d] -= step * g[d];
+                }
+              }
+            });
+      });
+  return param;
+}
+
+}} // namespace at::native
@@ -0,0 +1,80 @@
+#include <ATen/native/StreamCompaction.h>
+
+#include <ATen/native/cpu/StreamCompactionKernel.h>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(masked_select_compact_stub);
+DEFINE_DISPATCH(nonzero_compact_stub);
+
+namespace {
+
+// Note [Parallel stream compaction]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The TH implementations of masked_select and nonzero walk the input with a
+// single thread and a data-dependent branch per element, which is far from
+// memory bandwidth on the large, sparse-hit tensors produced by detection
+// post-processing. The kernels in cpu/StreamCompactionKernel.cpp compact in
+// two passes instead: a parallel branch-free counting pass over fixed-size
+// chunks, a cheap serial scan of the chunk counts to assign each chunk its
+// output offset, and a parallel scatter in which every chunk writes its
+// selections into a disjoint slice. Output order matches the serial scan
+// exactly, so the result is indistinguishable from TH's.
+//
+// Vec256 has no 8-bit lane type in this tree, so the inner loops are written
+// as branch-free scalar loops that the compiler's vectorizer compacts; they
+// are stamped per CPU capability like every other cpu/ kernel.
+
+bool is_plain_cpu(const Tensor& t) {
+  return t.defined() && !t.is_cuda() && !t.is_sparse();
+}
+
+// AT_DISPATCH_ALL_TYPES covers everything except Half.
+bool has_compactable_dtype(const Tensor& t) {
+  return isIntegralType(t.scalar_type()) ||
+      (isFloatingType(t.scalar_type()) && t.scalar_type() != kHalf);
+}
+
+// The kernels resize `result`; a stale same-sized but non-contiguous result
+// would survive the resize, so such outputs fall back.
+bool is_compactable_output(const Tensor& result, ScalarType dtype) {
+  return is_plain_cpu(result) && result.scalar_type() == dtype &&
+      (result.numel() == 0 || result.is_contiguous());
+}
+
+} // namespace
+
+bool try_masked_select_compact(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask) {
+  if (!is_plain_cpu(self) || !is_plain_cpu(mask) ||
+      !has_compactable_dtype(self)) {
+    return false;
+  }
+  // Broadcasting masks (and the deprecation warning TH raises for them)
+  // stay on the TH path.
+  if (mask.scalar_type() != kByte || !self.sizes().equals(mask.sizes())) {
+    return false;
+  }
+  if (!self.is_contiguous() || !mask.is_contiguous() ||
+      !is_compactable_output(result, self.scalar_type())) {
+    return false;
+  }
+  masked_select_compact_stub(kCPU, result, self, mask);
+  return true;
+}
+
+bool try_nonzero_compact(Tensor& result, const Tensor& self) {
+  if (!is_plain_cpu(self) || !has_compactable_dtype(self) ||
+      self.dim() == 0 || !self.is_contiguous()) {
+    return false;
+  }
+  if (!is_compactable_output(result, kLong)) {
+    return false;
+  }
+  nonzero_compact_stub(kCPU, result, self);
+  return true;
+}
+
+}} // namespace at::native
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+// Fast CPU paths for masked_select and nonzero; see
+// Note [Parallel stream compaction] in StreamCompaction.cpp. Each returns
+// false when the inputs do not qualify, in which case the caller falls
+// through to the TH implementation unchanged.
+bool try_masked_select_compact(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask);
+
+bool try_nonzero_compact(Tensor& result, const Tensor& self);
+
+}} // namespace at::native
@@ -2,14 +2,63 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 
 #include <tuple>
+#include <vector>
 
 namespace at { namespace native {
 
-///////////////// bincount /////////////////
 namespace {
 
+// Shared accumulation loop for bincount and histc. `get_bin` maps an element
+// index to its bin (or -1 to drop the element), `get_weight` supplies the
+// increment. Scatter updates into one shared array do not parallelize, so
+// large inputs with a small bin count accumulate into a privatized histogram
+// per thread and the partials are merged bin-parallel afterwards. Many-bin or
+// small inputs keep the serial loop, where privatization would cost more in
+// zeroing and merging than it saves.
+template <typename acc_t, typename bin_f, typename weight_f>
+void histogram_parallel_accumulate(
+    int64_t n,
+    acc_t* output_p,
+    int64_t nbins,
+    const bin_f& get_bin,
+    const weight_f& get_weight) {
+  constexpr int64_t kMaxPrivatizedBins = 1 << 16;
+  if (n < internal::GRAIN_SIZE || nbins > kMaxPrivatizedBins ||
+      at::get_num_threads() == 1 || at::in_parallel_region()) {
+    for (int64_t i = 0; i < n; i++) {
+      int64_t bin = get_bin(i);
+      if (bin >= 0) {
+        output_p[bin] += get_weight(i);
+      }
+    }
+    return;
+  }
+  int max_threads = at::get_num_threads();
+  std::vector<acc_t> partials((size_t)max_threads * nbins, acc_t(0));
+  at::parallel_for(0, n, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    acc_t* local = partials.data() + (size_t)at::get_thread_num() * nbins;
+    for (int64_t i = begin; i < end; i++) {
+      int64_t bin = get_bin(i);
+      if (bin >= 0) {
+        local[bin] += get_weight(i);
+      }
+    }
+  });
+  at::parallel_for(0, nbins, 4096, [&](int64_t begin, int64_t end) {
+    for (int t = 0; t < max_threads; t++) {
+      const acc_t* local = partials.data() + (size_t)t * nbins;
+      for (int64_t b = begin; b < end; b++) {
+        output_p[b] += local[b];
+      }
+    }
+  });
+}
+
+///////////////// bincount /////////////////
+
 template <typename input_t, typename weights_t>
 Tensor _bincount_cpu_template(
     const Tensor& self,
@@ -35,19 +84,23 @@ Tensor _bincount_cpu_template(
   nbins = std::max(nbins, minlength); // at least minlength # of bins
 
   const input_t* self_p = self.data<input_t>();
+  const int64_t n = self.size(0);
+  auto get_bin = [self_p](int64_t i) -> int64_t {
+    return static_cast<int64_t>(self_p[i]);
+  };
   if (has_weights) {
     output = native::zeros({nbins}, weights.options());
     weights_t* output_p = output.data<weights_t>();
     const weights_t* weights_p = weights.data<weights_t>();
-    for (int64_t i = 0; i < self.size(0); i++) {
-      output_p[self_p[i]] += weights_p[i];
-    }
+    histogram_parallel_accumulate<weights_t>(
+        n, output_p, nbins, get_bin,
+        [weights_p](int64_t i) { return weights_p[i]; });
   } else {
     output = native::zeros({nbins}, kLong);
     int64_t* output_p = output.data<int64_t>();
-    for (int64_t i = 0; i < self.size(0); i++) {
-      output_p[self_p[i]] += 1L;
-    }
+    histogram_parallel_accumulate<int64_t>(
+        n, output_p, nbins, get_bin,
+        [](int64_t) { return int64_t(1); });
   }
   return output;
 }
@@ -64,4 +117,54 @@ _bincount_cpu(const Tensor& self, const Tensor& weights, int64_t minlength) {
   });
 }
 
+///////////////// histc /////////////////
+
+// Same semantics as the TH kernel this replaces: when min == max the range
+// comes from the data, a degenerate range is widened by one on each side,
+// values outside [min, max] are dropped, and the top edge lands in the last
+// bin.
+Tensor& _histc_out_cpu(
+    Tensor& result,
+    const Tensor& self,
+    int64_t bins,
+    Scalar min,
+    Scalar max) {
+  AT_CHECK(bins > 0, "bins must be > 0");
+  result.resize_({bins});
+  result.zero_();
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    auto minval = min.to<scalar_t>();
+    auto maxval = max.to<scalar_t>();
+    if (minval == maxval) {
+      minval = *self.min().data<scalar_t>();
+      maxval = *self.max().data<scalar_t>();
+    }
+    if (minval == maxval) {
+      minval = minval - 1;
+      maxval = maxval + 1;
+    }
+    auto contig = self.contiguous();
+    const scalar_t* self_p = contig.data<scalar_t>();
+    scalar_t* output_p = result.data<scalar_t>();
+    const scalar_t range = maxval - minval;
+    histogram_parallel_accumulate<scalar_t>(
+        contig.numel(), output_p, bins,
+        [=](int64_t i) -> int64_t {
+          scalar_t value = self_p[i];
+          if (!(value >= minval && value <= maxval)) {
+            return -1;
+          }
+          int64_t bin = static_cast<int64_t>((value - minval) / range * bins);
+          return std::min(bin, bins - 1);
+        },
+        [](int64_t) { return scalar_t(1); });
+  });
+  return result;
+}
+
+Tensor _histc_cpu(const Tensor& self, int64_t bins, Scalar min, Scalar max) {
+  Tensor result = native::empty({0}, self.options());
+  return _histc_out_cpu(result, self, bins, min, max);
+}
+
 }} // namespace at::native
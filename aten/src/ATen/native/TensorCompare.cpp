@@ -1,5 +1,4 @@
 #include <ATen/ATen.h>
-#include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/NativeFunctions.h>
@@ -8,45 +7,11 @@
 #include <c10/util/Exception.h>
 #include <ATen/native/cpu/TensorCompareKernel.h>
 
-namespace {
-template <typename scalar_t>
-void where_cpu(
-    at::Tensor& ret,
-    const at::Tensor& condition,
-    const at::Tensor& self,
-    const at::Tensor& other) {
-  if (condition.scalar_type() == at::ScalarType::Byte) {
-    at::CPU_tensor_apply4<scalar_t, uint8_t, scalar_t, scalar_t>(
-        ret,
-        condition,
-        self,
-        other,
-        [](scalar_t& ret_val,
-           const uint8_t& cond_val,
-           const scalar_t& self_val,
-           const scalar_t& other_val) {
-          ret_val = cond_val ? self_val : other_val;
-        });
-    } else {
-      at::CPU_tensor_apply4<scalar_t, bool, scalar_t, scalar_t>(
-          ret,
-          condition,
-          self,
-          other,
-          [](scalar_t& ret_val,
-             const bool& cond_val,
-             const scalar_t& self_val,
-             const scalar_t& other_val) {
-            ret_val = cond_val ? self_val : other_val;
-          });
-    }
-}
-} // namespace
-
 namespace at { namespace native {
 
 DEFINE_DISPATCH(max_kernel);
 DEFINE_DISPATCH(min_kernel);
+DEFINE_DISPATCH(where_kernel);
 
 bool allclose(const Tensor& self, const Tensor& other, double rtol, double atol, bool equal_nan) {
   return at::isclose(self, other, rtol, atol, equal_nan).all().item<uint8_t>();
@@ -105,9 +70,7 @@ Tensor where(const Tensor& condition, const Tensor& self, const Tensor& other) {
 
 Tensor _s_where_cpu(const Tensor& condition, const Tensor& self, const Tensor& other) {
   Tensor ret = at::empty(self.sizes(), self.options());
-  AT_DISPATCH_ALL_TYPES(ret.scalar_type(), "where_cpu", [&] {
-    where_cpu<scalar_t>(ret, condition, self, other);
-  });
+  where_kernel(kCPU, ret, condition, self, other);
   return ret;
 }
 
@@ -26,8 +26,16 @@
 #include <cctype>
 #include <cmath>
 #include <cstddef>
+#include <cstdlib>
 #include <string>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
 namespace at {
 namespace native {
 namespace {
@@ -572,7 +580,139 @@ Tensor triu_indices_cpu(
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ zeros ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+namespace {
+
+#ifndef _WIN32
+
+// Note [Virtual zeros from anonymous pages]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// at::zeros used to memset its whole allocation even when the caller
+// immediately overwrites it (grad buffer init) or only ever touches a few
+// rows (attention masks). For large dense CPU results we instead back the
+// storage with a fresh anonymous mapping: the kernel points every page at
+// its shared zero page and copies one only on first write, so the tensor
+// reads as zeros immediately, nothing is memset, and untouched pages never
+// consume physical memory. This is copy-on-write materialization at page
+// granularity, enforced by the MMU, so every existing write path works
+// unchanged and no TensorImpl state is needed.
+//
+// Small allocations keep the eager memset: an mmap syscall plus per-page
+// soft faults only beats a memset once the buffer spans many pages. The
+// storage is created with a real allocator (MmapZerosAllocator below), so
+// the result stays resizable like any other dense CPU tensor.
+constexpr size_t kMmapZerosThreshold = 4 * 1024 * 1024;
+
+struct MmapZerosCtx {
+  void* addr;
+  size_t length;
+};
+
+void deleteMmapZeros(void* ptr) {
+  auto* ctx = static_cast<MmapZerosCtx*>(ptr);
+  munmap(ctx->addr, ctx->length);
+  delete ctx;
+}
+
+// The storage behind a mapped zeros tensor carries this allocator, so it
+// stays resizable exactly like a stock zeros() result: resize_ past
+// capacity reallocates through here (mapping again when the new size
+// qualifies, plain CPU memory otherwise) instead of tripping the
+// non-resizable-storage error.
+struct MmapZerosAllocator : public c10::Allocator {
+  c10::DataPtr allocate(size_t nbytes) const override {
+    if (nbytes >= kMmapZerosThreshold) {
+      void* addr = mmap(
+          nullptr,
+          nbytes,
+          PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS,
+          -1,
+          0);
+      if (addr != MAP_FAILED) {
+        return {addr,
+                new MmapZerosCtx{addr, nbytes},
+                &deleteMmapZeros,
+                at::DeviceType::CPU};
+      }
+    }
+    return at::getCPUAllocator()->allocate(nbytes);
+  }
+};
+
+MmapZerosAllocator* mmapZerosAllocator() {
+  static MmapZerosAllocator allocator;
+  return &allocator;
+}
+
+bool mmapZerosEnabled() {
+  // Kill switch for allocation-latency-sensitive deployments: the mapping
+  // shifts the fill cost from zeros() to whoever writes each page first.
+  static const bool enabled = []() {
+    const char* env = getenv("TORCH_MMAP_ZEROS");
+    return env == nullptr || env[0] != '0';
+  }();
+  return enabled;
+}
+
+// Returns an undefined tensor when the request does not qualify (or the
+// mapping fails); the caller falls back to the eager path.
+Tensor try_mmap_zeros(IntArrayRef size, const TensorOptions& options) {
+  if (!mmapZerosEnabled() || options.device().type() != at::kCPU ||
+      options.layout() != at::kStrided || options.pinned_memory()) {
+    return Tensor();
+  }
+  int64_t numel = 1;
+  for (const auto s : size) {
+    if (s < 0) {
+      return Tensor(); // let at::empty raise the usual error
+    }
+    numel *= s;
+  }
+  const size_t nbytes = numel * options.dtype().itemsize();
+  if (nbytes < kMmapZerosThreshold) {
+    return Tensor();
+  }
+  void* addr = mmap(
+      nullptr,
+      nbytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (addr == MAP_FAILED) {
+    return Tensor(); // e.g. vm.max_map_count exhausted; memset instead
+  }
+  // Built like empty_cpu, with the mapping as the initial allocation:
+  // the storage keeps a real allocator and stays resizable.
+  auto storage_impl = c10::make_intrusive<StorageImpl>(
+      options.dtype(),
+      numel,
+      c10::DataPtr(
+          addr,
+          new MmapZerosCtx{addr, nbytes},
+          &deleteMmapZeros,
+          at::DeviceType::CPU),
+      mmapZerosAllocator(),
+      /*resizeable=*/true);
+  auto tensor = detail::make_tensor<TensorImpl>(storage_impl, at::CPUTensorId());
+  if (size.size() != 1 || size[0] != 0) {
+    tensor.unsafeGetTensorImpl()->set_sizes_contiguous(size);
+  }
+  return tensor;
+}
+
+#endif // !_WIN32
+
+} // namespace
+
 Tensor zeros(IntArrayRef size, const TensorOptions& options) {
+#ifndef _WIN32
+  // See Note [Virtual zeros from anonymous pages] above.
+  Tensor virtual_result = try_mmap_zeros(size, options);
+  if (virtual_result.defined()) {
+    return virtual_result;
+  }
+#endif
   auto result = at::empty(size, options);
   return result.zero_();
 }
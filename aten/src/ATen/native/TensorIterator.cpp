@@ -1,5 +1,6 @@
 #include <ATen/native/TensorIterator.h>
 
+#include <algorithm>
 #include <array>
 #include <ATen/ExpandUtils.h>
 #include <ATen/Parallel.h>
@@ -380,6 +381,94 @@ void TensorIterator::serial_for_each(const loop_t& loop, Range range) const {
   serial_for_each(loop_wrapper(loop), range);
 }
 
+namespace {
+
+// Note [Rank-specialized strided iteration]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The generic DimCounter walk rebuilds every operand pointer from the
+// base with two nested loops (dims x operands) before each 2-D step, so
+// for rank-3/4 non-contiguous iterators -- permuted-layout elementwise
+// ops collapse to exactly this shape -- index arithmetic rivals the
+// work in the loop body. These instantiations keep one running pointer
+// per operand instead: each step advances the counters by the step just
+// taken and bumps the pointers by the hoisted per-dim strides, and the
+// compile-time rank bounds the carry loop so it unrolls. The stepping
+// itself matches DimCounter: full inner rows are batched along dim 1
+// into one 2-D call, partial rows at a chunk boundary go out one at a
+// time. Rank <= 1 takes a single call and rank >= 5 is rare enough to
+// stay on the generic counter.
+template <int kRank>
+void ranked_serial_for_each(
+    int ntensors,
+    const int64_t* shape,
+    const int64_t* strides, // [dim][arg], as laid out by get_strides()
+    const SmallVector<char*, 4>& base_ptrs,
+    const loop2d_t& loop,
+    Range range) {
+  int64_t counter[kRank];
+  int64_t linear = range.begin;
+  for (int dim = 0; dim < kRank; dim++) {
+    counter[dim] = linear % shape[dim];
+    linear /= shape[dim];
+  }
+
+  auto ptrs = base_ptrs;
+  for (int dim = 0; dim < kRank; dim++) {
+    for (int arg = 0; arg < ntensors; arg++) {
+      ptrs[arg] += counter[dim] * strides[dim * ntensors + arg];
+    }
+  }
+
+  // Carries counter[dim] into the dims above it, keeping ptrs in sync.
+  auto carry_from = [&](int dim) {
+    for (; dim < kRank - 1; dim++) {
+      if (counter[dim] < shape[dim]) {
+        break;
+      }
+      counter[dim] = 0;
+      counter[dim + 1]++;
+      for (int arg = 0; arg < ntensors; arg++) {
+        ptrs[arg] += strides[(dim + 1) * ntensors + arg] -
+            shape[dim] * strides[dim * ntensors + arg];
+      }
+    }
+  };
+
+  // Some loop bodies advance the pointer array they are handed, so the
+  // running pointers go out through a scratch copy.
+  SmallVector<char*, 4> call_ptrs(ptrs);
+
+  int64_t remaining = range.size();
+  while (remaining > 0) {
+    const int64_t size0 = std::min(shape[0] - counter[0], remaining);
+    int64_t size1 = 1;
+    if (counter[0] == 0 && size0 == shape[0]) {
+      size1 = std::min(shape[1] - counter[1], remaining / shape[0]);
+    }
+    std::copy(ptrs.begin(), ptrs.end(), call_ptrs.begin());
+    loop(ntensors, call_ptrs.data(), strides, size0, size1);
+    remaining -= size0 * size1;
+    if (remaining == 0) {
+      break;
+    }
+    if (size1 > 1) {
+      counter[1] += size1;
+      for (int arg = 0; arg < ntensors; arg++) {
+        ptrs[arg] += size1 * strides[ntensors + arg];
+      }
+      carry_from(1);
+    } else {
+      counter[0] += size0;
+      for (int arg = 0; arg < ntensors; arg++) {
+        ptrs[arg] += size0 * strides[arg];
+      }
+      carry_from(0);
+    }
+  }
+}
+
+} // namespace
+
 void TensorIterator::serial_for_each(const loop2d_t& loop, Range range) const {
   if (range.size() == 0) {
     return;
@@ -393,6 +482,16 @@ void TensorIterator::serial_for_each(const loop2d_t& loop, Range range) const {
   if (ndim() <= 1) {
     auto ptrs = get_data_ptrs(base_ptrs, { range.begin });
     loop(ntensors(), ptrs.data(), strides.data(), range.size(), 1);
+  } else if (ndim() == 2) {
+    // See Note [Rank-specialized strided iteration]
+    ranked_serial_for_each<2>(
+        ntensors(), shape_.data(), strides.data(), base_ptrs, loop, range);
+  } else if (ndim() == 3) {
+    ranked_serial_for_each<3>(
+        ntensors(), shape_.data(), strides.data(), base_ptrs, loop, range);
+  } else if (ndim() == 4) {
+    ranked_serial_for_each<4>(
+        ntensors(), shape_.data(), strides.data(), base_ptrs, loop, range);
   } else {
     auto counter = DimCounter(shape_, range);
     while (!counter.is_done()) {
@@ -631,21 +730,71 @@ SplitUntil32Bit TensorIterator::with_32bit_indexing() const {
   return SplitUntil32Bit(*this);
 }
 
+bool TensorIterator::fast_set_up() {
+  // The broadcast / reorder / coalesce pipeline below exists to handle
+  // arbitrary stride permutations, but the overwhelmingly common case for
+  // repeated elementwise calls is "every operand is contiguous with the same
+  // shape". For that case the final iterator state is known up front: a
+  // single coalesced dimension with dense strides. Recognizing it here skips
+  // the per-call shape inference, dimension reordering and coalescing.
+  if (is_reduction_) {
+    return false;
+  }
+  IntArrayRef common_shape;
+  bool has_defined_tensor = false;
+  for (auto& op : operands_) {
+    if (!op.tensor.defined()) {
+      // undefined outputs are allocated contiguously below
+      continue;
+    }
+    if (!op.tensor.is_contiguous()) {
+      return false;
+    }
+    if (!has_defined_tensor) {
+      common_shape = op.tensor.sizes();
+      has_defined_tensor = true;
+    } else if (!op.tensor.sizes().equals(common_shape)) {
+      return false;
+    }
+  }
+  if (!has_defined_tensor) {
+    return false;
+  }
+
+  int64_t numel = 1;
+  for (int64_t size : common_shape) {
+    numel *= size;
+  }
+  shape_ = {numel};
+  for (auto& op : operands_) {
+    if (!op.tensor.defined()) {
+      AT_ASSERTM(op.is_type_defined(), "no type for operand");
+      op.tensor = at::empty(common_shape, op.options());
+    }
+    op.stride_bytes = {static_cast<int64_t>(elementSize(op.dtype))};
+  }
+  has_coalesced_dimensions_ = true;
+  return true;
+}
+
 std::unique_ptr<TensorIterator> TensorIterator::Builder::build() {
   // set is_output and is_read_write flags on appropriate tensors
   iter_->mark_outputs();
-  // compute the broadcasted shape
-  iter_->compute_shape();
-  // compute each tensor's stride after broadcasting
-  iter_->compute_strides();
-  // re-order dimensions to improve coalescing
-  iter_->reorder_dimensions();
   // compute the result dtype and backend
   iter_->compute_types();
-  // allocate the output tensor if it's not provided
-  iter_->allocate_outputs();
-  // coalesce adjacent dimensions when possible
-  iter_->coalesce_dimensions();
+  // fast path: all operands contiguous with identical shapes
+  if (!iter_->fast_set_up()) {
+    // compute the broadcasted shape
+    iter_->compute_shape();
+    // compute each tensor's stride after broadcasting
+    iter_->compute_strides();
+    // re-order dimensions to improve coalescing
+    iter_->reorder_dimensions();
+    // allocate the output tensor if it's not provided
+    iter_->allocate_outputs();
+    // coalesce adjacent dimensions when possible
+    iter_->coalesce_dimensions();
+  }
 
   for (auto& op : iter_->operands_) {
     AT_ASSERT(op.tensor.defined());
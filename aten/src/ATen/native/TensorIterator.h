@@ -247,6 +247,7 @@ struct CAFFE2_API TensorIterator {
 
 protected:
   void mark_outputs();
+  bool fast_set_up();
   void compute_shape();
   void compute_strides();
   void reorder_dimensions();
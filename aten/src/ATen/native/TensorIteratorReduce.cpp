@@ -2,6 +2,8 @@
 #include <ATen/Parallel.h>
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 /// Contains the implementation of parallel reductions in TensorIterator.
 
@@ -9,27 +11,129 @@ namespace at {
 
 using loop2d_t = TensorIterator::loop2d_t;
 
-static bool use_two_pass_reduction(TensorIterator& iter);
 static void two_pass_reduction(TensorIterator& iter, const loop2d_t& loop);
-static void parallel_dim_reduction(TensorIterator& iter, const loop2d_t& loop);
+static void deterministic_two_pass_reduction(TensorIterator& iter, const loop2d_t& loop);
+static void parallel_dim_reduction(TensorIterator& iter, const loop2d_t& loop, int dim);
+static int find_split_dim(TensorIterator& iter, int num_lanes);
+
+namespace {
+
+// Note [Cached reduction strategy]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// parallel_reduce and foreach_reduced_elt re-derive their strategy (two-pass
+// vs. parallel-dim, and which dimension to split) on every call. The inputs
+// to that decision -- shape, strides, element sizes and the thread count --
+// are identical across the repeated fixed-shape reductions issued by
+// normalization layers, so the answer is memoized here. The cache is
+// thread-local (no locking on the hot path) and keyed by the raw bytes of
+// the iterator geometry, so a hit is a hash lookup instead of a walk over
+// the dimensions.
+struct ReductionStrategy {
+  bool two_pass;
+  int split_dim;
+};
+
+constexpr size_t kReductionStrategyCacheMaxEntries = 512;
+
+std::string reduction_strategy_key(TensorIterator& iter) {
+  std::string key;
+  auto append = [&](const int64_t* data, size_t n) {
+    key.append(reinterpret_cast<const char*>(data), n * sizeof(int64_t));
+  };
+  auto shape = iter.shape();
+  append(shape.data(), shape.size());
+  for (int arg = 0; arg < iter.ntensors(); arg++) {
+    auto strides = iter.strides(arg);
+    append(strides.data(), strides.size());
+  }
+  int64_t extra[] = {
+      static_cast<int64_t>(iter.element_size(0)),
+      static_cast<int64_t>(iter.element_size(1)),
+      static_cast<int64_t>(at::get_num_threads())};
+  append(extra, 3);
+  return key;
+}
+
+bool use_two_pass_reduction(TensorIterator& iter, int split_dim, int num_lanes) {
+  int64_t out_numel = iter.tensor(0).numel();
+  if (out_numel == 1) {
+    return true;
+  }
+  // Small outer dim: if the best splittable dimension has fewer columns
+  // than we have threads, parallel-dim reduction leaves cores idle.
+  // Reduce into per-thread buffers instead, as long as the output is
+  // small enough that the buffers (and the final pass over them) are
+  // cheap relative to the input.
+  return iter.shape()[split_dim] < num_lanes &&
+      out_numel <= at::internal::GRAIN_SIZE / num_lanes;
+}
+
+// Stand-in for the thread count in the strategy heuristics under
+// deterministic reductions; see Note [Deterministic parallel reduction].
+constexpr int kDeterministicLanes = 16;
+
+// See Note [Cached reduction strategy]
+ReductionStrategy reduction_strategy(TensorIterator& iter) {
+  static thread_local std::unordered_map<std::string, ReductionStrategy> cache;
+  std::string key = reduction_strategy_key(iter);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  // The two-pass vs. parallel-dim choice feeds the result (the two orders
+  // round differently), so under deterministic reductions it is made with a
+  // fixed lane count instead of the machine's thread count. The split
+  // dimension and scheduling stay performance-only choices: parallel-dim
+  // reduction accumulates each output element serially within one chunk.
+  int num_lanes = at::internal::deterministic_reduce()
+      ? kDeterministicLanes
+      : at::get_num_threads();
+  ReductionStrategy strategy;
+  strategy.split_dim = find_split_dim(iter, num_lanes);
+  strategy.two_pass =
+      use_two_pass_reduction(iter, strategy.split_dim, num_lanes);
+  if (cache.size() >= kReductionStrategyCacheMaxEntries) {
+    cache.clear();
+  }
+  cache.emplace(std::move(key), strategy);
+  return strategy;
+}
+
+} // namespace
 
 void TensorIterator::parallel_reduce(const loop2d_t& loop) {
   AT_CHECK(ntensors() == 2, "parallel_reduce only supports one input and one output");
   int64_t numel = this->numel();
-  if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
-      at::in_parallel_region()) {
+  // Under deterministic reductions only the problem size may route to the
+  // serial path: a single-thread machine (or a nested invocation inside a
+  // parallel region) must produce the same chunked result as the parallel
+  // one, and both strategies below degenerate gracefully to running their
+  // fixed chunks in order on the calling thread.
+  bool serial = numel < at::internal::GRAIN_SIZE;
+  if (!at::internal::deterministic_reduce()) {
+    serial = serial || at::get_num_threads() == 1 || at::in_parallel_region();
+  }
+  if (serial) {
     serial_for_each(loop, {0, numel});
-  } else if (use_two_pass_reduction(*this)) {
-    two_pass_reduction(*this, loop);
+    return;
+  }
+  auto strategy = reduction_strategy(*this);
+  if (strategy.two_pass) {
+    if (at::internal::deterministic_reduce()) {
+      deterministic_two_pass_reduction(*this, loop);
+    } else {
+      two_pass_reduction(*this, loop);
+    }
   } else {
-    parallel_dim_reduction(*this, loop);
+    parallel_dim_reduction(*this, loop, strategy.split_dim);
   }
 }
 
-static bool use_two_pass_reduction(TensorIterator& iter) {
-  return iter.tensor(0).numel() == 1;
-}
-
+// Reduces into one private buffer slice per thread, then reduces the
+// buffer into the destination. This also handles non-scalar outputs (the
+// small-outer-dim case, see use_two_pass_reduction): every thread's
+// sub-iterator linearizes the input identically, so the [begin, end)
+// ranges partition the input no matter what shape the output has.
 static void two_pass_reduction(TensorIterator& iter, const loop2d_t& loop) {
   int max_threads = at::get_num_threads();
 
@@ -63,16 +167,83 @@ static void two_pass_reduction(TensorIterator& iter, const loop2d_t& loop) {
   final_reduce->for_each(loop);
 }
 
+// Note [Deterministic parallel reduction]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Floating point addition does not associate, so the ordinary two-pass
+// reduction -- whose chunk boundaries and per-thread partials follow the
+// thread count -- gives bitwise different answers from run to run and from
+// machine to machine. With ATEN_DETERMINISTIC_REDUCE set
+// (at::internal::deterministic_reduce), reductions instead derive every
+// ordering decision from the problem size alone:
+//
+//  - chunk boundaries come from the grain size and a fixed chunk cap,
+//    never from the thread count; threads only pick up whole chunks, and
+//    each chunk's partial is accumulated serially in index order;
+//  - the partials are then combined by a fixed-shape pairwise tree (slice
+//    i absorbs slice i + stride each round), so the combination order is a
+//    function of the chunk count only, no matter how the pairs were
+//    scheduled across threads;
+//  - the two-pass vs. parallel-dim strategy choice uses a fixed lane count
+//    (see reduction_strategy), and the serial fallback is taken only on
+//    size grounds.
+//
+// Parallel-dim reduction needs no ordering changes: each output element is
+// accumulated serially inside the single chunk that owns its column.
+// The mode costs one extra pass over the partial buffer relative to the
+// free-running order; all cores still participate in the first pass.
+static void deterministic_two_pass_reduction(
+    TensorIterator& iter,
+    const loop2d_t& loop) {
+  // Caps the partial-results buffer at kMaxChunks * output elements while
+  // leaving plenty of chunks to spread across cores.
+  constexpr int64_t kMaxChunks = 256;
+  int64_t numel = iter.numel();
+  int64_t chunk_size =
+      std::max(at::internal::GRAIN_SIZE, divup(numel, kMaxChunks));
+  int64_t num_chunks = divup(numel, chunk_size);
+
+  auto& dst = iter.tensor(0);
+  auto buffer_shape = DimVector(dst.sizes());
+  buffer_shape.insert(buffer_shape.begin(), num_chunks);
+  auto buffer = at::empty(buffer_shape, dst.options());
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t chunk = chunk_begin; chunk < chunk_end; chunk++) {
+      auto slice = buffer[chunk];
+      slice.copy_(dst);
+
+      auto sub_iter = TensorIterator::reduce_op(slice, iter.tensor(1));
+      int64_t begin = chunk * chunk_size;
+      sub_iter->serial_for_each(loop, {begin, std::min(numel, begin + chunk_size)});
+    }
+  });
+
+  // Fixed-shape combination tree over the partials.
+  for (int64_t stride = 1; stride < num_chunks; stride *= 2) {
+    int64_t num_pairs = divup(num_chunks - stride, 2 * stride);
+    at::parallel_for(0, num_pairs, 1, [&](int64_t pair_begin, int64_t pair_end) {
+      for (int64_t pair = pair_begin; pair < pair_end; pair++) {
+        int64_t i = pair * 2 * stride;
+        auto acc = buffer[i].unsqueeze(0);
+        auto sub_iter =
+            TensorIterator::reduce_op(acc, buffer.narrow(0, i + stride, 1));
+        sub_iter->serial_for_each(loop, {0, sub_iter->numel()});
+      }
+    });
+  }
+  dst.copy_(buffer[0]);
+}
+
 /// Chooses a dimension over which to parallelize. Prefers the outer-most
-/// dimension thats larger than the number of available threads.
-static int find_split_dim(TensorIterator& iter) {
-  int num_threads = at::get_num_threads();
+/// dimension thats larger than the number of lanes the reduction will be
+/// split into (normally the thread count).
+static int find_split_dim(TensorIterator& iter, int num_lanes) {
   auto shape = iter.shape();
 
   // start with the outer-most dimension
   int best_dim = iter.ndim() - 1;
   for (int dim = best_dim; dim >= 0 && !iter.is_dim_reduced(dim); dim--) {
-    if (shape[dim] >= num_threads) {
+    if (shape[dim] >= num_lanes) {
       return dim;
     } else if (shape[dim] > shape[best_dim]) {
       best_dim = dim;
@@ -93,9 +264,8 @@ round_columns(TensorIterator& iter, int dim, int multiple, int64_t begin, int64_
   return std::make_tuple(begin, end);
 }
 
-static void parallel_dim_reduction(TensorIterator& iter, const loop2d_t& loop) {
+static void parallel_dim_reduction(TensorIterator& iter, const loop2d_t& loop, int dim) {
   AT_ASSERT(iter.ndim() >= 1);
-  int dim = find_split_dim(iter);
   int64_t cols = iter.shape()[dim];
   int element_size = iter.element_size(/*arg=*/1);
 
@@ -145,7 +315,8 @@ void TensorIterator::foreach_reduced_elt(const loop_subiter_t &loop, bool parall
     }
   }
   else {
-    int dim = find_split_dim(*this);
+    // See Note [Cached reduction strategy]
+    int dim = reduction_strategy(*this).split_dim;
     int64_t cols = shape[dim];
     at::parallel_for(0, cols, 1, [&](int64_t begin, int64_t end) {
       if (begin == end) {
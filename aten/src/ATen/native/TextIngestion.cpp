@@ -0,0 +1,287 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <c10/util/Exception.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+// Note [SWAR text ingestion]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// csv_to_tensor / json_to_tensor parse a whole batch of textual records
+// straight into a pre-allocated tensor, so a TorchScript serving graph never
+// has to leave the interpreter (or copy through an intermediate container) to
+// materialize feature rows. Delimiter and newline scanning processes eight
+// bytes per step with the classic SWAR has-zero-byte trick -- no intrinsics,
+// so the same code is correct on every CPU this file is compiled for -- and
+// numbers take a fast path that assembles the mantissa in an integer and
+// applies an exactly-representable power-of-ten scale. Anything the fast path
+// cannot reproduce bit-for-bit (more than 15 significant digits, exponents
+// past +/-22, inf/nan) falls back to strtod. Records are independent, so rows
+// parse in parallel.
+
+constexpr uint64_t kSwarOnes = 0x0101010101010101ULL;
+constexpr uint64_t kSwarHighs = 0x8080808080808080ULL;
+
+// First occurrence of `target` in [p, end), or end.
+const char* find_byte(const char* p, const char* end, char target) {
+  const uint64_t pattern = kSwarOnes * static_cast<uint8_t>(target);
+  while (p + sizeof(uint64_t) <= end) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    word ^= pattern; // matching bytes become zero
+    if (((word - kSwarOnes) & ~word & kSwarHighs) != 0) {
+      break; // some byte of this word matches; pinpoint it below
+    }
+    p += sizeof(uint64_t);
+  }
+  for (; p < end; ++p) {
+    if (*p == target) {
+      return p;
+    }
+  }
+  return end;
+}
+
+// Powers of ten a double holds exactly; a mantissa of up to 15 digits scaled
+// by one of these rounds identically to strtod.
+const double kPow10[23] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                           1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                           1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parses the numeric field in [begin, end); surrounding whitespace is
+// allowed, anything else in the field is an error.
+bool parse_field(const char* begin, const char* end, double* out) {
+  while (begin < end && is_space(*begin)) {
+    ++begin;
+  }
+  while (end > begin && is_space(end[-1])) {
+    --end;
+  }
+  if (begin == end) {
+    return false;
+  }
+
+  const char* p = begin;
+  bool negative = false;
+  if (*p == '+' || *p == '-') {
+    negative = *p == '-';
+    ++p;
+  }
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int frac_digits = 0;
+  for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+    mantissa = mantissa * 10 + (*p - '0');
+    digits++;
+  }
+  if (p < end && *p == '.') {
+    ++p;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+      mantissa = mantissa * 10 + (*p - '0');
+      digits++;
+      frac_digits++;
+    }
+  }
+  int64_t exponent = 0;
+  if (digits > 0 && p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool exp_negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+      exp_negative = *p == '-';
+      ++p;
+    }
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+      if (exponent < 10000) { // clamped values miss the fast path below
+        exponent = exponent * 10 + (*p - '0');
+      }
+    }
+    if (exp_negative) {
+      exponent = -exponent;
+    }
+  }
+  const int64_t scale = exponent - frac_digits;
+  if (digits > 0 && p == end && digits <= 15 && scale >= -22 && scale <= 22) {
+    double value = static_cast<double>(mantissa);
+    value = scale < 0 ? value / kPow10[-scale] : value * kPow10[scale];
+    *out = negative ? -value : value;
+    return true;
+  }
+
+  // Slow path: inf/nan, long mantissas, large exponents, or junk (which
+  // strtod rejects by not consuming the whole token).
+  std::string token(begin, end - begin);
+  char* token_end = nullptr;
+  const double value = std::strtod(token.c_str(), &token_end);
+  if (token_end != token.c_str() + token.size()) {
+    return false;
+  }
+  *out = value;
+  return true;
+}
+
+// One (begin, end) pair per newline-separated record; a trailing newline does
+// not produce an empty record, and CR before LF is dropped.
+std::vector<std::pair<const char*, const char*>> split_records(
+    const std::string& records) {
+  std::vector<std::pair<const char*, const char*>> rows;
+  const char* p = records.data();
+  const char* end = p + records.size();
+  while (p < end) {
+    const char* eol = find_byte(p, end, '\n');
+    const char* row_end = eol;
+    if (row_end > p && row_end[-1] == '\r') {
+      --row_end;
+    }
+    rows.emplace_back(p, row_end);
+    p = eol == end ? end : eol + 1;
+  }
+  return rows;
+}
+
+// Exceptions must not escape the parallel region, so workers publish the
+// smallest failing record index instead of throwing.
+void record_bad(std::atomic<int64_t>& first_bad, int64_t row) {
+  int64_t current = first_bad.load();
+  while ((current == -1 || row < current) &&
+         !first_bad.compare_exchange_weak(current, row)) {
+  }
+}
+
+template <typename scalar_t>
+void parse_rows(
+    scalar_t* out,
+    int64_t cols,
+    const std::vector<std::pair<const char*, const char*>>& rows,
+    char delimiter,
+    bool json,
+    std::atomic<int64_t>& first_bad) {
+  parallel_for(0, rows.size(), 1, [&](int64_t begin_row, int64_t end_row) {
+    for (int64_t row = begin_row; row < end_row; row++) {
+      const char* p = rows[row].first;
+      const char* row_end = rows[row].second;
+      if (json) {
+        while (p < row_end && is_space(*p)) {
+          ++p;
+        }
+        while (row_end > p && is_space(row_end[-1])) {
+          --row_end;
+        }
+        if (row_end - p < 2 || *p != '[' || row_end[-1] != ']') {
+          record_bad(first_bad, row);
+          continue;
+        }
+        ++p;
+        --row_end;
+      }
+      scalar_t* out_row = out + row * cols;
+      int64_t col = 0;
+      bool ok = true;
+      while (true) {
+        const char* field_end = find_byte(p, row_end, delimiter);
+        double value;
+        if (col >= cols || !parse_field(p, field_end, &value)) {
+          ok = false;
+          break;
+        }
+        out_row[col++] = static_cast<scalar_t>(value);
+        if (field_end == row_end) {
+          break;
+        }
+        p = field_end + 1;
+      }
+      if (!ok || col != cols) {
+        record_bad(first_bad, row);
+      }
+    }
+  });
+}
+
+void check_ingestion_out(const Tensor& out, int64_t rows, const char* name) {
+  AT_CHECK(!out.is_cuda(), name, ": output must be a CPU tensor");
+  AT_CHECK(
+      out.dim() == 2 && out.is_contiguous(),
+      name,
+      ": output must be a contiguous 2-d tensor");
+  AT_CHECK(
+      out.size(0) == rows,
+      name,
+      ": got ",
+      rows,
+      " records for an output with ",
+      out.size(0),
+      " rows");
+}
+
+} // namespace
+
+Tensor& csv_to_tensor_out_cpu(
+    Tensor& out,
+    std::string records,
+    std::string delimiter) {
+  AT_CHECK(
+      delimiter.size() == 1,
+      "csv_to_tensor: delimiter must be a single character, got \"",
+      delimiter,
+      "\"");
+  auto rows = split_records(records);
+  check_ingestion_out(out, rows.size(), "csv_to_tensor");
+  std::atomic<int64_t> first_bad(-1);
+  AT_DISPATCH_FLOATING_TYPES(out.scalar_type(), "csv_to_tensor", [&] {
+    parse_rows<scalar_t>(
+        out.data<scalar_t>(),
+        out.size(1),
+        rows,
+        delimiter[0],
+        /*json=*/false,
+        first_bad);
+  });
+  AT_CHECK(
+      first_bad.load() == -1,
+      "csv_to_tensor: record ",
+      first_bad.load(),
+      " is not ",
+      out.size(1),
+      " numeric fields separated by '",
+      delimiter,
+      "'");
+  return out;
+}
+
+Tensor& json_to_tensor_out_cpu(Tensor& out, std::string records) {
+  auto rows = split_records(records);
+  check_ingestion_out(out, rows.size(), "json_to_tensor");
+  std::atomic<int64_t> first_bad(-1);
+  AT_DISPATCH_FLOATING_TYPES(out.scalar_type(), "json_to_tensor", [&] {
+    parse_rows<scalar_t>(
+        out.data<scalar_t>(),
+        out.size(1),
+        rows,
+        ',',
+        /*json=*/true,
+        first_bad);
+  });
+  AT_CHECK(
+      first_bad.load() == -1,
+      "json_to_tensor: record ",
+      first_bad.load(),
+      " is not a flat JSON array of ",
+      out.size(1),
+      " numbers");
+  return out;
+}
+
+}} // namespace at::native
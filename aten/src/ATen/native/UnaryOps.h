@@ -41,6 +41,7 @@ DECLARE_DISPATCH(unary_fn, tanh_stub);
 DECLARE_DISPATCH(unary_fn, trunc_stub);
 
 DECLARE_DISPATCH(void(*)(Tensor&, const double, Generator *), bernoulli_mkl_stub);
+DECLARE_DISPATCH(void(*)(Tensor&, const double, Generator *), bernoulli_philox_stub);
 
 // Missing unary functions
 // digamma
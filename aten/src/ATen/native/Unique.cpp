@@ -2,17 +2,321 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <set>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace at {
 namespace native{
 
 namespace {
 
+// Note [Adaptive parallel unique]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The hash-set path below is serial, which is seconds per call on the
+// hundreds-of-millions-of-ids inputs that precede embedding lookups. For
+// large integer inputs we instead pick between two parallel strategies
+// based on a sampled cardinality estimate:
+//
+//  - low cardinality (at least half of a strided sample is duplicated):
+//    per-chunk hash maps built in parallel and merged serially; the merge
+//    only touches the distinct values, which is what makes it cheap.
+//  - high cardinality: parallel LSD radix sort on bias-corrected keys
+//    (per-chunk histograms, serial 256-entry prefix, stable parallel
+//    scatter), carrying the original index when return_inverse is
+//    requested so the inverse falls out of the sort's permutation. Byte
+//    passes whose histogram is a single bin are skipped, so int64 ids
+//    that fit in 32 bits pay only half the passes.
+//
+// Floating types keep the serial path: NaN breaks both radix ordering
+// and hash equality, exactly why the serial path is hash-based too.
+constexpr int64_t kParallelUniqueMinNumel = 1 << 20;
+constexpr int64_t kCardinalitySampleSize = 1024;
+
+int64_t parallel_unique_num_chunks(int64_t numel) {
+  const int64_t chunk = std::max<int64_t>(
+      internal::GRAIN_SIZE, divup(numel, (int64_t)get_num_threads() * 4));
+  return divup(numel, chunk);
+}
+
+template <typename scalar_t, bool is_integral = std::is_integral<scalar_t>::value>
+struct ParallelUnique {
+  static bool applicable(int64_t /*numel*/) {
+    return false;
+  }
+  static std::tuple<Tensor, Tensor, Tensor> run(
+      const Tensor& /*input*/,
+      const bool /*sorted*/,
+      const bool /*return_inverse*/,
+      const bool /*return_counts*/) {
+    AT_ERROR("parallel unique is only implemented for integral types");
+  }
+};
+
+template <typename scalar_t>
+struct ParallelUnique<scalar_t, true> {
+  using unsigned_t = typename std::make_unsigned<scalar_t>::type;
+
+  static bool applicable(int64_t numel) {
+    return numel >= kParallelUniqueMinNumel && get_num_threads() > 1 &&
+        !in_parallel_region();
+  }
+
+  // Maps values to keys whose unsigned order matches the signed order.
+  static unsigned_t to_key(scalar_t value) {
+    unsigned_t key = static_cast<unsigned_t>(value);
+    if (std::is_signed<scalar_t>::value) {
+      key ^= unsigned_t(1) << (8 * sizeof(unsigned_t) - 1);
+    }
+    return key;
+  }
+
+  static scalar_t from_key(unsigned_t key) {
+    if (std::is_signed<scalar_t>::value) {
+      key ^= unsigned_t(1) << (8 * sizeof(unsigned_t) - 1);
+    }
+    return static_cast<scalar_t>(key);
+  }
+
+  static bool low_cardinality_sample(const scalar_t* data, int64_t numel) {
+    const int64_t sample = std::min(numel, kCardinalitySampleSize);
+    const int64_t stride = numel / sample;
+    std::unordered_set<scalar_t> seen;
+    seen.reserve(sample);
+    for (int64_t i = 0; i < sample; ++i) {
+      seen.insert(data[i * stride]);
+    }
+    return static_cast<int64_t>(seen.size()) * 2 <= sample;
+  }
+
+  // One stable counting pass over the current byte. Returns false (and
+  // writes nothing) when every key shares this byte, so the caller keeps
+  // reading from the input buffer.
+  static bool radix_pass(
+      const unsigned_t* keys_in,
+      unsigned_t* keys_out,
+      const int64_t* idx_in,
+      int64_t* idx_out,
+      int64_t numel,
+      int shift,
+      bool with_idx) {
+    const int64_t nchunks = parallel_unique_num_chunks(numel);
+    const int64_t chunk = divup(numel, nchunks);
+    std::vector<int64_t> hist(nchunks * 256, 0);
+    parallel_for(0, nchunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (int64_t c = cbegin; c < cend; ++c) {
+        int64_t* h = hist.data() + c * 256;
+        const int64_t begin = c * chunk;
+        const int64_t end = std::min(numel, begin + chunk);
+        for (int64_t i = begin; i < end; ++i) {
+          h[(keys_in[i] >> shift) & 0xff]++;
+        }
+      }
+    });
+
+    for (int64_t bin = 0; bin < 256; ++bin) {
+      int64_t total = 0;
+      for (int64_t c = 0; c < nchunks; ++c) {
+        total += hist[c * 256 + bin];
+      }
+      if (total == numel) {
+        return false;
+      }
+    }
+
+    // Exclusive offsets, bin-major with chunks in order inside each bin;
+    // this is what makes the scatter stable.
+    std::vector<int64_t> offsets(nchunks * 256);
+    int64_t running = 0;
+    for (int64_t bin = 0; bin < 256; ++bin) {
+      for (int64_t c = 0; c < nchunks; ++c) {
+        offsets[c * 256 + bin] = running;
+        running += hist[c * 256 + bin];
+      }
+    }
+
+    parallel_for(0, nchunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (int64_t c = cbegin; c < cend; ++c) {
+        int64_t* off = offsets.data() + c * 256;
+        const int64_t begin = c * chunk;
+        const int64_t end = std::min(numel, begin + chunk);
+        for (int64_t i = begin; i < end; ++i) {
+          const int64_t bin = (keys_in[i] >> shift) & 0xff;
+          keys_out[off[bin]] = keys_in[i];
+          if (with_idx) {
+            idx_out[off[bin]] = idx_in[i];
+          }
+          off[bin]++;
+        }
+      }
+    });
+    return true;
+  }
+
+  static std::tuple<Tensor, Tensor, Tensor> run_sort(
+      const Tensor& input,
+      const bool return_inverse,
+      const bool return_counts) {
+    const scalar_t* input_data = input.data<scalar_t>();
+    const int64_t numel = input.numel();
+    const bool with_idx = return_inverse;
+
+    std::vector<unsigned_t> keys(numel), keys_tmp(numel);
+    std::vector<int64_t> idx, idx_tmp;
+    if (with_idx) {
+      idx.resize(numel);
+      idx_tmp.resize(numel);
+    }
+    parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        keys[i] = to_key(input_data[i]);
+        if (with_idx) {
+          idx[i] = i;
+        }
+      }
+    });
+
+    unsigned_t* k_in = keys.data();
+    unsigned_t* k_out = keys_tmp.data();
+    int64_t* i_in = with_idx ? idx.data() : nullptr;
+    int64_t* i_out = with_idx ? idx_tmp.data() : nullptr;
+    for (size_t shift = 0; shift < 8 * sizeof(unsigned_t); shift += 8) {
+      if (radix_pass(k_in, k_out, i_in, i_out, numel, shift, with_idx)) {
+        std::swap(k_in, k_out);
+        std::swap(i_in, i_out);
+      }
+    }
+
+    Tensor output = at::empty({numel}, input.options());
+    Tensor inverse_indices = at::empty({0}, input.options().dtype(kLong));
+    Tensor counts = at::empty({0}, input.options().dtype(kLong));
+    scalar_t* output_data = output.data<scalar_t>();
+    int64_t* inverse_data = nullptr;
+    int64_t* counts_data = nullptr;
+    if (return_inverse) {
+      inverse_indices.resize_(input.sizes());
+      inverse_data = inverse_indices.data<int64_t>();
+    }
+    if (return_counts) {
+      counts.resize_({numel});
+      counts_data = counts.data<int64_t>();
+    }
+
+    // Single bandwidth-bound pass over the sorted keys; group boundaries
+    // give the output, the carried original indices give the inverse.
+    int64_t num_unique = 0;
+    for (int64_t i = 0; i < numel; ++i) {
+      if (i == 0 || k_in[i] != k_in[i - 1]) {
+        output_data[num_unique] = from_key(k_in[i]);
+        if (return_counts) {
+          counts_data[num_unique] = 0;
+        }
+        num_unique++;
+      }
+      if (return_inverse) {
+        inverse_data[i_in[i]] = num_unique - 1;
+      }
+      if (return_counts) {
+        counts_data[num_unique - 1]++;
+      }
+    }
+    output.resize_({num_unique});
+    if (return_counts) {
+      counts.resize_({num_unique});
+    }
+    return std::make_tuple(output, inverse_indices, counts);
+  }
+
+  static std::tuple<Tensor, Tensor, Tensor> run_hash(
+      const Tensor& input,
+      const bool sorted,
+      const bool return_inverse,
+      const bool return_counts) {
+    const scalar_t* input_data = input.data<scalar_t>();
+    const int64_t numel = input.numel();
+    const int64_t nchunks = parallel_unique_num_chunks(numel);
+    const int64_t chunk = divup(numel, nchunks);
+
+    std::vector<std::unordered_map<scalar_t, int64_t>> chunk_counts(nchunks);
+    parallel_for(0, nchunks, 1, [&](int64_t cbegin, int64_t cend) {
+      for (int64_t c = cbegin; c < cend; ++c) {
+        auto& map = chunk_counts[c];
+        const int64_t begin = c * chunk;
+        const int64_t end = std::min(numel, begin + chunk);
+        for (int64_t i = begin; i < end; ++i) {
+          map[input_data[i]]++;
+        }
+      }
+    });
+
+    // Merging only touches distinct values, which the sampling gate has
+    // established are few.
+    auto& merged = chunk_counts[0];
+    for (int64_t c = 1; c < nchunks; ++c) {
+      for (const auto& kv : chunk_counts[c]) {
+        merged[kv.first] += kv.second;
+      }
+    }
+
+    std::vector<scalar_t> values;
+    values.reserve(merged.size());
+    for (const auto& kv : merged) {
+      values.push_back(kv.first);
+    }
+    if (sorted) {
+      std::sort(values.begin(), values.end());
+    }
+
+    Tensor output =
+        at::empty({static_cast<int64_t>(values.size())}, input.options());
+    Tensor inverse_indices = at::empty({0}, input.options().dtype(kLong));
+    Tensor counts = at::empty({0}, input.options().dtype(kLong));
+    std::copy(values.begin(), values.end(), output.data<scalar_t>());
+
+    if (return_counts) {
+      counts.resize_({output.numel()});
+      int64_t* counts_data = counts.data<int64_t>();
+      for (size_t i = 0; i < values.size(); ++i) {
+        counts_data[i] = merged.at(values[i]);
+      }
+    }
+    if (return_inverse) {
+      inverse_indices.resize_(input.sizes());
+      int64_t* inverse_data = inverse_indices.data<int64_t>();
+      std::unordered_map<scalar_t, int64_t> value_to_pos;
+      value_to_pos.reserve(values.size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        value_to_pos[values[i]] = i;
+      }
+      const auto& pos = value_to_pos;
+      parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          inverse_data[i] = pos.find(input_data[i])->second;
+        }
+      });
+    }
+    return std::make_tuple(output, inverse_indices, counts);
+  }
+
+  static std::tuple<Tensor, Tensor, Tensor> run(
+      const Tensor& input,
+      const bool sorted,
+      const bool return_inverse,
+      const bool return_counts) {
+    if (low_cardinality_sample(input.data<scalar_t>(), input.numel())) {
+      return run_hash(input, sorted, return_inverse, return_counts);
+    }
+    return run_sort(input, return_inverse, return_counts);
+  }
+};
+
 template <typename scalar_t>
 std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
     const Tensor& self,
@@ -22,6 +326,13 @@ std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
   const Tensor& input = self.contiguous();
   const scalar_t* input_data = input.data<scalar_t>();
   int64_t numel = input.numel();
+
+  // See Note [Adaptive parallel unique]
+  if (ParallelUnique<scalar_t>::applicable(numel)) {
+    return ParallelUnique<scalar_t>::run(
+        input, sorted, return_inverse, return_counts);
+  }
+
   Tensor output;
   Tensor inverse_indices = at::empty({0}, self.options().dtype(kLong));
   Tensor counts = at::empty({0}, self.options().dtype(kLong));
@@ -2,6 +2,9 @@
 
 #include <ATen/ATen.h>
 
+#include <array>
+#include <vector>
+
 namespace at {
 namespace native {
 
@@ -246,5 +249,101 @@ static inline scalar_t cubic_interp1d(
   return x0 * coeffs[0] + x1 * coeffs[1] + x2 * coeffs[2] + x3 * coeffs[3];
 }
 
+// Note [Precomputed interpolation tables]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Source indices and interpolation weights depend only on the output
+// coordinate along one axis, so the CPU kernels compute them once per
+// call into small per-axis tables instead of once per output element.
+// The tap offsets are pre-multiplied by the axis stride (in elements),
+// so the inner loops reduce to table lookups plus multiply-adds, and
+// per-tap clamping happens at table build time rather than per pixel.
+
+template <typename scalar_t>
+struct UpsampleLinearTable {
+  std::vector<int64_t> offset0; // lower tap, pre-scaled by stride
+  std::vector<int64_t> offset1; // upper tap (clamped), pre-scaled by stride
+  std::vector<scalar_t> lambda0; // weight of the lower tap
+  std::vector<scalar_t> lambda1; // weight of the upper tap
+};
+
+template <typename scalar_t>
+static inline UpsampleLinearTable<scalar_t> linear_upsample_table(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    int64_t stride) {
+  UpsampleLinearTable<scalar_t> table;
+  table.offset0.resize(output_size);
+  table.offset1.resize(output_size);
+  table.lambda0.resize(output_size);
+  table.lambda1.resize(output_size);
+  const scalar_t scale = linear_upsample_compute_scale<scalar_t>(
+      input_size, output_size, align_corners);
+  for (int64_t i = 0; i < output_size; ++i) {
+    const scalar_t rindex = linear_upsample_compute_source_index<scalar_t>(
+        scale, i, align_corners);
+    const int64_t index = rindex;
+    const int64_t indexp = (index < input_size - 1) ? index + 1 : index;
+    table.offset0[i] = index * stride;
+    table.offset1[i] = indexp * stride;
+    table.lambda1[i] = rindex - index;
+    table.lambda0[i] = static_cast<scalar_t>(1.) - table.lambda1[i];
+  }
+  return table;
+}
+
+static inline std::vector<int64_t> nearest_upsample_table(
+    int64_t input_size,
+    int64_t output_size,
+    int64_t stride) {
+  std::vector<int64_t> table(output_size);
+  const float scale = (float)input_size / (float)output_size;
+  for (int64_t i = 0; i < output_size; ++i) {
+    table[i] =
+        nearest_neighbor_compute_source_index(scale, i, input_size) * stride;
+  }
+  return table;
+}
+
+template <typename scalar_t>
+struct UpsampleCubicTable {
+  // Four taps per output coordinate, clamped to the input range and
+  // pre-scaled by stride.
+  std::array<std::vector<int64_t>, 4> offsets;
+  std::array<std::vector<scalar_t>, 4> coeffs;
+};
+
+// NB: uses `scale * dst_index` as the source coordinate in both
+// align_corners modes, matching the per-pixel computation in
+// UpSampleBicubic2d.cpp that these tables replace.
+template <typename scalar_t>
+static inline UpsampleCubicTable<scalar_t> cubic_upsample_table(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    int64_t stride) {
+  UpsampleCubicTable<scalar_t> table;
+  for (int64_t tap = 0; tap < 4; ++tap) {
+    table.offsets[tap].resize(output_size);
+    table.coeffs[tap].resize(output_size);
+  }
+  const scalar_t scale = linear_upsample_compute_scale<scalar_t>(
+      input_size, output_size, align_corners);
+  for (int64_t i = 0; i < output_size; ++i) {
+    const scalar_t real_index = scale * i;
+    const int64_t index = real_index;
+    const scalar_t t = real_index - index;
+    scalar_t coeffs[4];
+    get_cubic_upsample_coefficients<scalar_t>(coeffs, t);
+    for (int64_t tap = 0; tap < 4; ++tap) {
+      const int64_t access = std::max(
+          std::min(index - 1 + tap, input_size - 1), static_cast<int64_t>(0));
+      table.offsets[tap][i] = access * stride;
+      table.coeffs[tap][i] = coeffs[tap];
+    }
+  }
+  return table;
+}
+
 } // namespace native
 } // namespace at
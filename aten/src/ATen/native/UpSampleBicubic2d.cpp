@@ -1,6 +1,10 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/UpSample.h>
+#include <ATen/native/cpu/UpSampleKernel.h>
+
+#include <cstring>
 
 namespace at {
 namespace native {
@@ -98,67 +102,47 @@ static void upsample_bicubic2d_backward_out_frame(
     int64_t channels,
     bool align_corners) {
   channels = channels * nbatch;
+  const int64_t input_plane = input_height * input_width;
+  const int64_t output_plane = output_height * output_width;
 
   // Special case: input/output same size, just copy
   if (input_height == output_height && input_width == output_width) {
-    for (int64_t output_y = 0; output_y < output_height; output_y++) {
-      for (int64_t output_x = 0; output_x < output_width; output_x++) {
-        scalar_t* in = &idata[output_y * input_width + output_x];
-        scalar_t* out = &odata[output_y * output_width + output_x];
-        for (int64_t c = 0; c < channels; ++c) {
-          in[0] = out[0];
-          in += input_width * input_height;
-          out += output_width * output_height;
-        }
+    at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; ++c) {
+        std::memcpy(
+            idata + c * input_plane,
+            odata + c * output_plane,
+            input_plane * sizeof(scalar_t));
       }
-    }
+    });
     return;
   }
 
-  const scalar_t height_scale = linear_upsample_compute_scale<scalar_t>(
-      input_height, output_height, align_corners);
-  const scalar_t width_scale = linear_upsample_compute_scale<scalar_t>(
-      input_width, output_width, align_corners);
-
-  for (int64_t output_y = 0; output_y < output_height; output_y++) {
-    for (int64_t output_x = 0; output_x < output_width; output_x++) {
-      scalar_t* in = idata;
-      scalar_t* out = odata;
-
-      scalar_t real_x = width_scale * output_x;
-      int64_t input_x = real_x;
-      scalar_t t_x = real_x - input_x;
-
-      scalar_t real_y = height_scale * output_y;
-      int64_t input_y = real_y;
-      scalar_t t_y = real_y - input_y;
-
-      scalar_t x_coeffs[4];
-      scalar_t y_coeffs[4];
-
-      get_cubic_upsample_coefficients<scalar_t>(x_coeffs, t_x);
-      get_cubic_upsample_coefficients<scalar_t>(y_coeffs, t_y);
-
-      for (int64_t c = 0; c < channels; c++) {
-        scalar_t out_value = out[output_y * output_width + output_x];
-
-        for (int64_t i = 0; i < 4; i++) {
-          for (int64_t j = 0; j < 4; j++) {
-            upsample_increment_value_bounded<scalar_t>(
-                in,
-                input_width,
-                input_height,
-                input_x - 1 + i,
-                input_y - 1 + j,
-                out_value * y_coeffs[j] * x_coeffs[i]);
+  const auto htable = cubic_upsample_table<scalar_t>(
+      input_height, output_height, align_corners, input_width);
+  const auto wtable = cubic_upsample_table<scalar_t>(
+      input_width, output_width, align_corners, 1);
+
+  // Gradients of neighboring output pixels scatter into shared input
+  // taps, so each task owns whole channel planes.
+  at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; ++c) {
+      scalar_t* in = idata + c * input_plane;
+      const scalar_t* out = odata + c * output_plane;
+      for (int64_t output_y = 0; output_y < output_height; output_y++) {
+        for (int64_t output_x = 0; output_x < output_width; output_x++) {
+          const scalar_t out_value = out[output_y * output_width + output_x];
+          for (int64_t i = 0; i < 4; i++) {
+            for (int64_t j = 0; j < 4; j++) {
+              in[htable.offsets[j][output_y] + wtable.offsets[i][output_x]] +=
+                  out_value * htable.coeffs[j][output_y] *
+                  wtable.coeffs[i][output_x];
+            }
           }
         }
-
-        in += input_width * input_height;
-        out += output_width * output_height;
       }
     }
-  }
+  });
 }
 
 static void upsample_bicubic2d_out_cpu_template(
@@ -192,6 +176,14 @@ static void upsample_bicubic2d_out_cpu_template(
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
+
+  if (input.scalar_type() == kFloat || input.scalar_type() == kDouble) {
+    // Vectorized parallel path; it writes every output element, so the
+    // zero fill is skipped. See Note [Separable upsampling on CPU].
+    upsample_bicubic2d_cpu_kernel(
+        kCPU, output, input, output_height, output_width, align_corners);
+    return;
+  }
   output.zero_();
 
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bicubic2d", [&] {
@@ -269,6 +261,8 @@ static void upsample_bicubic2d_backward_out_cpu_template(
 }
 } // namespace
 
+DEFINE_DISPATCH(upsample_bicubic2d_cpu_kernel);
+
 Tensor& upsample_bicubic2d_out_cpu(
     Tensor& output,
     const Tensor& input,
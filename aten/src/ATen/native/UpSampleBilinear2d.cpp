@@ -3,7 +3,9 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/UpSample.h>
+#include <ATen/native/cpu/UpSampleKernel.h>
 
 namespace at {
 namespace native {
@@ -93,65 +95,51 @@ static void upsample_bilinear2d_backward_out_frame(
     int64_t channels,
     bool align_corners) {
   channels = channels * nbatch;
+  const int64_t input_plane = input_height * input_width;
+  const int64_t output_plane = output_height * output_width;
 
   // special case: same-size matching grids
   if (input_height == output_height && input_width == output_width) {
-    for (int64_t h2 = 0; h2 < output_height; ++h2) {
-      const int64_t h1 = h2;
-      for (int64_t w2 = 0; w2 < output_width; ++w2) {
-        const int64_t w1 = w2;
-        scalar_t* pos1 = &idata[h1 * input_width + w1];
-        const scalar_t* pos2 = &odata[h2 * output_width + w2];
-
-        for (int64_t c = 0; c < channels; ++c) {
-          pos1[0] += pos2[0];
-          pos1 += input_width * input_height;
-          pos2 += output_width * output_height;
+    at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; ++c) {
+        scalar_t* pos1 = idata + c * input_plane;
+        const scalar_t* pos2 = odata + c * output_plane;
+        for (int64_t i = 0; i < input_plane; ++i) {
+          pos1[i] += pos2[i];
         }
       }
-    }
+    });
     return;
   }
 
-  const scalar_t rheight = linear_upsample_compute_scale<scalar_t>(
-      input_height, output_height, align_corners);
-  const scalar_t rwidth = linear_upsample_compute_scale<scalar_t>(
-      input_width, output_width, align_corners);
-
-  for (int64_t h2 = 0; h2 < output_height; ++h2) {
-    const scalar_t h1r = linear_upsample_compute_source_index<scalar_t>(
-        rheight, h2, align_corners);
-
-    const int64_t h1 = h1r;
-    const int64_t h1p = (h1 < input_height - 1) ? 1 : 0;
-
-    const scalar_t h1lambda = h1r - h1;
-    const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
-
-    for (int64_t w2 = 0; w2 < output_width; ++w2) {
-      const scalar_t w1r = linear_upsample_compute_source_index<scalar_t>(
-          rwidth, w2, align_corners);
-
-      const int64_t w1 = w1r;
-      const int64_t w1p = (w1 < input_width - 1) ? 1 : 0;
-
-      const scalar_t w1lambda = w1r - w1;
-      const scalar_t w0lambda = static_cast<scalar_t>(1.) - w1lambda;
-
-      scalar_t* pos1 = &idata[h1 * input_width + w1];
-
-      const scalar_t* pos2 = &odata[h2 * output_width + w2];
-
-      for (int64_t c = 0; c < channels; ++c) {
-        pos1[0] += h0lambda * w0lambda * pos2[0];
-        pos1[w1p] += h0lambda * w1lambda * pos2[0];
-        pos1[h1p * input_width] += h1lambda * w0lambda * pos2[0];
-        pos1[h1p * input_width + w1p] += h1lambda * w1lambda * pos2[0];
-        pos1 += input_width * input_height;
-        pos2 += output_width * output_height;
+  const auto htable = linear_upsample_table<scalar_t>(
+      input_height, output_height, align_corners, input_width);
+  const auto wtable = linear_upsample_table<scalar_t>(
+      input_width, output_width, align_corners, 1);
+
+  // Gradients of neighboring output rows scatter into shared input rows,
+  // so each task owns whole channel planes rather than output rows.
+  at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; ++c) {
+      scalar_t* pos1 = idata + c * input_plane;
+      const scalar_t* pos2 = odata + c * output_plane;
+      for (int64_t h2 = 0; h2 < output_height; ++h2) {
+        const int64_t h0 = htable.offset0[h2];
+        const int64_t h1 = htable.offset1[h2];
+        const scalar_t h0lambda = htable.lambda0[h2];
+        const scalar_t h1lambda = htable.lambda1[h2];
+        for (int64_t w2 = 0; w2 < output_width; ++w2) {
+          const int64_t w0 = wtable.offset0[w2];
+          const int64_t w1 = wtable.offset1[w2];
+          const scalar_t grad = pos2[h2 * output_width + w2];
+          pos1[h0 + w0] += h0lambda * wtable.lambda0[w2] * grad;
+          pos1[h0 + w1] += h0lambda * wtable.lambda1[w2] * grad;
+          pos1[h1 + w0] += h1lambda * wtable.lambda0[w2] * grad;
+          pos1[h1 + w1] += h1lambda * wtable.lambda1[w2] * grad;
+        }
       }
     }
-  }
+  });
 }
 
 static void upsample_bilinear2d_out_cpu_template(
@@ -185,12 +173,20 @@ static void upsample_bilinear2d_out_cpu_template(
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
-  output.zero_();
 
   AT_ASSERT(
       input_height > 0 && input_width > 0 && output_height > 0 &&
       output_width > 0);
 
+  if (input.scalar_type() == kFloat || input.scalar_type() == kDouble) {
+    // Vectorized parallel path; it writes every output element, so the
+    // zero fill is skipped. See Note [Separable upsampling on CPU].
+    upsample_bilinear2d_cpu_kernel(
+        kCPU, output, input, output_height, output_width, align_corners);
+    return;
+  }
+  output.zero_();
+
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bilinear2d", [&] {
     auto* idata = input.data<scalar_t>();
     auto* odata = output.data<scalar_t>();
@@ -266,6 +262,8 @@ static void upsample_bilinear2d_backward_out_cpu_template(
 }
 } // namespace
 
+DEFINE_DISPATCH(upsample_bilinear2d_cpu_kernel);
+
 Tensor& upsample_bilinear2d_out_cpu(
     Tensor& output,
     const Tensor& input,
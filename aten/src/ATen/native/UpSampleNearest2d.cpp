@@ -1,7 +1,10 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/UpSample.h>
 
+#include <cstring>
+
 namespace at {
 namespace native {
 namespace {
@@ -16,49 +19,48 @@ static void upsample_nearest2d_out_frame(
     int64_t output_width,
     int64_t nbatch,
     int64_t channels) {
-  const float height_scale = (float)input_height / (float)output_height;
-  const float width_scale = (float)input_width / (float)output_width;
-
   channels = channels * nbatch;
+  const int64_t input_plane = input_height * input_width;
+  const int64_t output_plane = output_height * output_width;
 
   // special case: just copy
   if (input_height == output_height && input_width == output_width) {
-    for (int64_t h2 = 0; h2 < output_height; ++h2) {
-      const int64_t h1 = h2;
-
-      for (int64_t w2 = 0; w2 < output_width; ++w2) {
-        const int64_t w1 = w2;
-        const scalar_t* pos1 = &idata[h1 * input_width + w1];
-        scalar_t* pos2 = &odata[h2 * output_width + w2];
-
-        for (int64_t c = 0; c < channels; ++c) {
-          pos2[0] = pos1[0];
-          pos1 += input_height * input_width;
-          pos2 += output_height * output_width;
-        }
+    at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; ++c) {
+        std::memcpy(
+            odata + c * output_plane,
+            idata + c * input_plane,
+            input_plane * sizeof(scalar_t));
       }
-    }
+    });
     return;
   }
 
-  for (int64_t h2 = 0; h2 < output_height; ++h2) {
-    const int64_t h1 =
-        nearest_neighbor_compute_source_index(height_scale, h2, input_height);
-
-    for (int64_t w2 = 0; w2 < output_width; ++w2) {
-      const int64_t w1 =
-          nearest_neighbor_compute_source_index(width_scale, w2, input_width);
-
-      const scalar_t* pos1 = &idata[h1 * input_width + w1];
-      scalar_t* pos2 = &odata[h2 * output_width + w2];
-
-      for (int64_t c = 0; c < channels; ++c) {
-        pos2[0] = pos1[0];
-        pos1 += input_height * input_width;
-        pos2 += output_height * output_width;
-      }
-    }
-  }
+  // Source indices come from per-axis tables (see
+  // Note [Precomputed interpolation tables] in UpSample.h) and each task
+  // owns whole output rows of one channel plane, so the inner loop is a
+  // contiguous gather from a single input row.
+  const auto htable =
+      nearest_upsample_table(input_height, output_height, input_width);
+  const auto wtable = nearest_upsample_table(input_width, output_width, 1);
+
+  at::parallel_for(
+      0,
+      channels * output_height,
+      std::max(
+          static_cast<int64_t>(1),
+          at::internal::GRAIN_SIZE / std::max(output_width, static_cast<int64_t>(1))),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t index = begin; index < end; ++index) {
+          const int64_t c = index / output_height;
+          const int64_t h2 = index % output_height;
+          const scalar_t* pos1 = idata + c * input_plane + htable[h2];
+          scalar_t* pos2 = odata + c * output_plane + h2 * output_width;
+          for (int64_t w2 = 0; w2 < output_width; ++w2) {
+            pos2[w2] = pos1[wtable[w2]];
+          }
+        }
+      });
 }
 
 template <typename scalar_t>
@@ -71,48 +73,41 @@ static void upsample_nearest2d_backward_out_frame(
     int64_t output_width,
     int64_t nbatch,
     int64_t channels) {
-  const float height_scale = (float)input_height / (float)output_height;
-  const float width_scale = (float)input_width / (float)output_width;
-
   channels = channels * nbatch;
+  const int64_t input_plane = input_height * input_width;
+  const int64_t output_plane = output_height * output_width;
 
   // special case: just copy
   if (input_height == output_height && input_width == output_width) {
-    for (int64_t h2 = 0; h2 < output_height; ++h2) {
-      const int64_t h1 = h2;
-
-      for (int64_t w2 = 0; w2 < output_width; ++w2) {
-        const int64_t w1 = w2;
-        scalar_t* pos1 = &idata[h1 * input_width + w1];
-        const scalar_t* pos2 = &odata[h2 * output_width + w2];
-
-        for (int64_t c = 0; c < channels; ++c) {
-          pos1[0] = pos2[0];
-          pos1 += input_height * input_width;
-          pos2 += output_height * output_width;
-        }
+    at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; ++c) {
+        std::memcpy(
+            idata + c * input_plane,
+            odata + c * output_plane,
+            input_plane * sizeof(scalar_t));
       }
-    }
+    });
     return;
   }
 
-  for (int64_t h2 = 0; h2 < output_height; ++h2) {
-    const int64_t h1 =
-        nearest_neighbor_compute_source_index(height_scale, h2, input_height);
-
-    for (int64_t w2 = 0; w2 < output_width; ++w2) {
-      const int64_t w1 =
-          nearest_neighbor_compute_source_index(width_scale, w2, input_width);
-      scalar_t* pos1 = &idata[h1 * input_width + w1];
-      const scalar_t* pos2 = &odata[h2 * output_width + w2];
-
-      for (int64_t c = 0; c < channels; ++c) {
-        pos1[0] += pos2[0];
-        pos1 += input_height * input_width;
-        pos2 += output_height * output_width;
+  const auto htable =
+      nearest_upsample_table(input_height, output_height, input_width);
+  const auto wtable = nearest_upsample_table(input_width, output_width, 1);
+
+  // Gradients of neighboring output pixels scatter into shared input
+  // pixels, so each task owns whole channel planes.
+  at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; ++c) {
+      scalar_t* pos1 = idata + c * input_plane;
+      const scalar_t* pos2 = odata + c * output_plane;
+      for (int64_t h2 = 0; h2 < output_height; ++h2) {
+        const int64_t h1 = htable[h2];
+        for (int64_t w2 = 0; w2 < output_width; ++w2) {
+          pos1[h1 + wtable[w2]] += pos2[h2 * output_width + w2];
+        }
       }
     }
-  }
+  });
 }
 
 static void upsample_nearest2d_out_cpu_template(
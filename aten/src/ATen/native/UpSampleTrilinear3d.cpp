@@ -3,8 +3,11 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/UpSample.h>
 
+#include <cstring>
+
 namespace at {
 namespace native {
 namespace {
@@ -23,97 +26,76 @@ static void upsample_trilinear3d_out_frame(
     int64_t channels,
     bool align_corners) {
   channels = channels * nbatch;
+  const int64_t input_plane = input_depth * input_height * input_width;
+  const int64_t output_plane = output_depth * output_height * output_width;
 
   // special case: just copy
   if (input_depth == output_depth && input_height == output_height &&
       input_width == output_width) {
-    for (int64_t t2 = 0; t2 < output_depth; ++t2) {
-      const int64_t t1 = t2;
-
-      for (int64_t h2 = 0; h2 < output_height; ++h2) {
-        const int64_t h1 = h2;
-
-        for (int64_t w2 = 0; w2 < output_width; ++w2) {
-          const int64_t w1 = w2;
-          const scalar_t* pos1 =
-              &idata[t1 * input_height * input_width + h1 * input_width + w1];
-          scalar_t* pos2 =
-              &odata
-                  [t2 * output_height * output_width + h2 * output_width + w2];
-
-          for (int64_t c = 0; c < channels; ++c) {
-            pos2[0] = pos1[0];
-            pos1 += input_width * input_height * input_depth;
-            pos2 += output_width * output_height * output_depth;
-          }
-        }
+    at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; ++c) {
+        std::memcpy(
+            odata + c * output_plane,
+            idata + c * input_plane,
+            input_plane * sizeof(scalar_t));
       }
-    }
+    });
     return;
   }
-  const scalar_t rdepth = linear_upsample_compute_scale<scalar_t>(
-      input_depth, output_depth, align_corners);
-  const scalar_t rheight = linear_upsample_compute_scale<scalar_t>(
-      input_height, output_height, align_corners);
-  const scalar_t rwidth = linear_upsample_compute_scale<scalar_t>(
-      input_width, output_width, align_corners);
-  for (int64_t t2 = 0; t2 < output_depth; ++t2) {
-    const scalar_t t1r = linear_upsample_compute_source_index<scalar_t>(
-        rdepth, t2, align_corners);
-
-    const int64_t t1 = t1r;
-    const int64_t t1p = (t1 < input_depth - 1) ? 1 : 0;
-    const scalar_t t1lambda = t1r - t1;
-    const scalar_t t0lambda = static_cast<scalar_t>(1.) - t1lambda;
-
-    for (int64_t h2 = 0; h2 < output_height; ++h2) {
-      const scalar_t h1r = linear_upsample_compute_source_index<scalar_t>(
-          rheight, h2, align_corners);
-
-      const int64_t h1 = h1r;
-      const int64_t h1p = (h1 < input_height - 1) ? 1 : 0;
-      const scalar_t h1lambda = h1r - h1;
-      const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
-
-      for (int64_t w2 = 0; w2 < output_width; ++w2) {
-        const scalar_t w1r = linear_upsample_compute_source_index<scalar_t>(
-            rwidth, w2, align_corners);
-
-        const int64_t w1 = w1r;
-        const int64_t w1p = (w1 < input_width - 1) ? 1 : 0;
-        const scalar_t w1lambda = w1r - w1;
-        const scalar_t w0lambda = static_cast<scalar_t>(1.) - w1lambda;
-        const scalar_t* pos1 =
-            &idata[t1 * input_height * input_width + h1 * input_width + w1];
-        scalar_t* pos2 =
-            &odata[t2 * output_height * output_width + h2 * output_width + w2];
-
-        for (int64_t c = 0; c < channels; ++c) {
-          pos2[0] = t0lambda *
-                  (h0lambda * (w0lambda * pos1[0] + w1lambda * pos1[w1p]) +
-                   h1lambda *
-                       (w0lambda * pos1[h1p * input_width] +
-                        w1lambda * pos1[h1p * input_width + w1p])) +
-              t1lambda *
-                  (h0lambda *
-                       (w0lambda * pos1[t1p * input_height * input_width] +
-                        w1lambda *
-                            pos1[t1p * input_height * input_width + w1p]) +
-                   h1lambda *
-                       (w0lambda *
-                            pos1
-                                [t1p * input_height * input_width +
-                                 h1p * input_width] +
-                        w1lambda *
-                            pos1
-                                [t1p * input_height * input_width +
-                                 h1p * input_width + w1p]));
-          pos1 += input_width * input_height * input_depth;
-          pos2 += output_width * output_height * output_depth;
+
+  // Per-axis taps and weights come from precomputed tables (see
+  // Note [Precomputed interpolation tables] in UpSample.h); each task
+  // owns whole output rows of one channel volume, so the eight-tap blend
+  // reads two contiguous segments of four source rows.
+  const auto ttable = linear_upsample_table<scalar_t>(
+      input_depth, output_depth, align_corners, input_height * input_width);
+  const auto htable = linear_upsample_table<scalar_t>(
+      input_height, output_height, align_corners, input_width);
+  const auto wtable = linear_upsample_table<scalar_t>(
+      input_width, output_width, align_corners, 1);
+
+  const int64_t output_rows = output_depth * output_height;
+  at::parallel_for(
+      0,
+      channels * output_rows,
+      std::max(
+          static_cast<int64_t>(1),
+          at::internal::GRAIN_SIZE /
+              std::max(static_cast<int64_t>(8) * output_width,
+                       static_cast<int64_t>(1))),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t index = begin; index < end; ++index) {
+          const int64_t c = index / output_rows;
+          const int64_t t2 = (index % output_rows) / output_height;
+          const int64_t h2 = index % output_height;
+
+          const scalar_t* volume = idata + c * input_plane;
+          const scalar_t* line00 = volume + ttable.offset0[t2] + htable.offset0[h2];
+          const scalar_t* line01 = volume + ttable.offset0[t2] + htable.offset1[h2];
+          const scalar_t* line10 = volume + ttable.offset1[t2] + htable.offset0[h2];
+          const scalar_t* line11 = volume + ttable.offset1[t2] + htable.offset1[h2];
+
+          const scalar_t t0lambda = ttable.lambda0[t2];
+          const scalar_t t1lambda = ttable.lambda1[t2];
+          const scalar_t h0lambda = htable.lambda0[h2];
+          const scalar_t h1lambda = htable.lambda1[h2];
+
+          scalar_t* pos2 = odata + c * output_plane +
+              t2 * output_height * output_width + h2 * output_width;
+          for (int64_t w2 = 0; w2 < output_width; ++w2) {
+            const int64_t w0 = wtable.offset0[w2];
+            const int64_t w1 = wtable.offset1[w2];
+            const scalar_t w0lambda = wtable.lambda0[w2];
+            const scalar_t w1lambda = wtable.lambda1[w2];
+            pos2[w2] = t0lambda *
+                    (h0lambda * (w0lambda * line00[w0] + w1lambda * line00[w1]) +
+                     h1lambda * (w0lambda * line01[w0] + w1lambda * line01[w1])) +
+                t1lambda *
+                    (h0lambda * (w0lambda * line10[w0] + w1lambda * line10[w1]) +
+                     h1lambda * (w0lambda * line11[w0] + w1lambda * line11[w1]));
+          }
         }
-      }
-    }
-  }
+      });
 }
 
 template <typename scalar_t>
@@ -130,91 +112,68 @@ static void upsample_trilinear3d_backward_out_frame(
     int64_t channels,
     bool align_corners) {
   channels = channels * nbatch;
+  const int64_t input_plane = input_depth * input_height * input_width;
+  const int64_t output_plane = output_depth * output_height * output_width;
 
   // special case: same-size matching grids
   if (input_depth == output_depth && input_height == output_height &&
       input_width == output_width) {
-    for (int64_t t2 = 0; t2 < output_depth; ++t2) {
-      const int64_t t1 = t2;
-
-      for (int64_t h2 = 0; h2 < output_height; ++h2) {
-        const int64_t h1 = h2;
-
-        for (int64_t w2 = 0; w2 < output_width; ++w2) {
-          const int64_t w1 = w2;
-          scalar_t* pos1 =
-              &idata[t1 * input_height * input_width + h1 * input_width + w1];
-          const scalar_t* pos2 =
-              &odata
-                  [t2 * output_height * output_width + h2 * output_width + w2];
-
-          for (int64_t c = 0; c < channels; ++c) {
-            pos1[0] += pos2[0];
-            pos1 += input_width * input_height * input_depth;
-            pos2 += output_width * output_height * output_depth;
-          }
+    at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; ++c) {
+        scalar_t* pos1 = idata + c * input_plane;
+        const scalar_t* pos2 = odata + c * output_plane;
+        for (int64_t i = 0; i < input_plane; ++i) {
+          pos1[i] += pos2[i];
         }
       }
-    }
+    });
     return;
   }
-  const scalar_t rdepth = linear_upsample_compute_scale<scalar_t>(
-      input_depth, output_depth, align_corners);
-
-  const scalar_t rheight = linear_upsample_compute_scale<scalar_t>(
-      input_height, output_height, align_corners);
-
-  const scalar_t rwidth = linear_upsample_compute_scale<scalar_t>(
-      input_width, output_width, align_corners);
-
-  for (int64_t t2 = 0; t2 < output_depth; ++t2) {
-    const scalar_t t1r = linear_upsample_compute_source_index<scalar_t>(
-        rdepth, t2, align_corners);
-    const int64_t t1 = t1r;
-    const int64_t t1p = (t1 < input_depth - 1) ? 1 : 0;
-    const scalar_t t1lambda = t1r - t1;
-    const scalar_t t0lambda = static_cast<scalar_t>(1.) - t1lambda;
-
-    for (int64_t h2 = 0; h2 < output_height; ++h2) {
-      const scalar_t h1r = linear_upsample_compute_source_index<scalar_t>(
-          rheight, h2, align_corners);
-      const int64_t h1 = h1r;
-      const int64_t h1p = (h1 < input_height - 1) ? 1 : 0;
-      const scalar_t h1lambda = h1r - h1;
-      const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
-
-      for (int64_t w2 = 0; w2 < output_width; ++w2) {
-        const scalar_t w1r = linear_upsample_compute_source_index<scalar_t>(
-            rwidth, w2, align_corners);
-        const int64_t w1 = w1r;
-        const int64_t w1p = (w1 < input_width - 1) ? 1 : 0;
-        const scalar_t w1lambda = w1r - w1;
-        const scalar_t w0lambda = static_cast<scalar_t>(1.) - w1lambda;
-        scalar_t* pos1 =
-            &idata[t1 * input_height * input_width + h1 * input_width + w1];
-        const scalar_t* pos2 =
-            &odata[t2 * output_height * output_width + h2 * output_width + w2];
-
-        for (int64_t c = 0; c < channels; ++c) {
-          pos1[0] += t0lambda * h0lambda * w0lambda * pos2[0];
-          pos1[w1p] += t0lambda * h0lambda * w1lambda * pos2[0];
-          pos1[h1p * input_width] += t0lambda * h1lambda * w0lambda * pos2[0];
-          pos1[h1p * input_width + w1p] +=
-              t0lambda * h1lambda * w1lambda * pos2[0];
-          pos1[t1p * input_height * input_width] +=
-              t1lambda * h0lambda * w0lambda * pos2[0];
-          pos1[t1p * input_height * input_width + w1p] +=
-              t1lambda * h0lambda * w1lambda * pos2[0];
-          pos1[t1p * input_height * input_width + h1p * input_width] +=
-              t1lambda * h1lambda * w0lambda * pos2[0];
-          pos1[t1p * input_height * input_width + h1p * input_width + w1p] +=
-              t1lambda * h1lambda * w1lambda * pos2[0];
-          pos1 += input_width * input_height * input_depth;
-          pos2 += output_width * output_height * output_depth;
+
+  const auto ttable = linear_upsample_table<scalar_t>(
+      input_depth, output_depth, align_corners, input_height * input_width);
+  const auto htable = linear_upsample_table<scalar_t>(
+      input_height, output_height, align_corners, input_width);
+  const auto wtable = linear_upsample_table<scalar_t>(
+      input_width, output_width, align_corners, 1);
+
+  // Gradients of neighboring output voxels scatter into shared input
+  // taps, so each task owns whole channel volumes.
+  at::parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; ++c) {
+      scalar_t* pos1 = idata + c * input_plane;
+      const scalar_t* pos2 = odata + c * output_plane;
+      for (int64_t t2 = 0; t2 < output_depth; ++t2) {
+        const int64_t t0 = ttable.offset0[t2];
+        const int64_t t1 = ttable.offset1[t2];
+        const scalar_t t0lambda = ttable.lambda0[t2];
+        const scalar_t t1lambda = ttable.lambda1[t2];
+        for (int64_t h2 = 0; h2 < output_height; ++h2) {
+          const int64_t h0 = htable.offset0[h2];
+          const int64_t h1 = htable.offset1[h2];
+          const scalar_t h0lambda = htable.lambda0[h2];
+          const scalar_t h1lambda = htable.lambda1[h2];
+          const scalar_t* grad_row = pos2 +
+              t2 * output_height * output_width + h2 * output_width;
+          for (int64_t w2 = 0; w2 < output_width; ++w2) {
+            const int64_t w0 = wtable.offset0[w2];
+            const int64_t w1 = wtable.offset1[w2];
+            const scalar_t w0lambda = wtable.lambda0[w2];
+            const scalar_t w1lambda = wtable.lambda1[w2];
+            const scalar_t grad = grad_row[w2];
+            pos1[t0 + h0 + w0] += t0lambda * h0lambda * w0lambda * grad;
+            pos1[t0 + h0 + w1] += t0lambda * h0lambda * w1lambda * grad;
+            pos1[t0 + h1 + w0] += t0lambda * h1lambda * w0lambda * grad;
+            pos1[t0 + h1 + w1] += t0lambda * h1lambda * w1lambda * grad;
+            pos1[t1 + h0 + w0] += t1lambda * h0lambda * w0lambda * grad;
+            pos1[t1 + h0 + w1] += t1lambda * h0lambda * w1lambda * grad;
+            pos1[t1 + h1 + w0] += t1lambda * h1lambda * w0lambda * grad;
+            pos1[t1 + h1 + w1] += t1lambda * h1lambda * w1lambda * grad;
+          }
         }
       }
     }
-  }
+  });
 }
 
 static void upsample_trilinear3d_out_cpu_template(
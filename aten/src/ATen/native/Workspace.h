@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at {
+namespace native {
+
+// Note [Caller-provided workspaces]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Composite ops allocate internal temporaries their callers cannot see,
+// which defeats serving setups that want a zero-allocation steady state
+// for fixed-shape models. Ops participating in the workspace protocol
+// come in pairs, following the cuDNN convention:
+//
+//   _<op>_workspace_size(args...)                  -> bytes needed
+//   _<op>_with_workspace(args..., workspace, out)  -> out
+//
+// The caller queries the size once per op at model-load time (the
+// requirement depends only on shapes, dtypes and layouts, so for a
+// fixed-shape model it never changes), allocates one Byte tensor of at
+// least that size, and the _with_workspace variant carves its
+// temporaries out of that arena with take_workspace instead of hitting
+// the allocator. Carved tensors alias the arena and own nothing: they
+// are only valid while the arena is alive, and the arena may be reused
+// for the next op as soon as the call returns. Every carve is rounded
+// up to kWorkspaceAlignment so chunks stay vector-aligned regardless of
+// carving order.
+
+constexpr int64_t kWorkspaceAlignment = 64;
+
+static inline int64_t workspace_align(int64_t bytes) {
+  return (bytes + kWorkspaceAlignment - 1) / kWorkspaceAlignment *
+      kWorkspaceAlignment;
+}
+
+// Carves a `sizes`-shaped contiguous tensor of type `dtype` out of
+// `workspace` at byte `offset`, advancing `offset` past the (aligned)
+// chunk.
+static inline Tensor take_workspace(
+    const Tensor& workspace,
+    int64_t& offset,
+    IntArrayRef sizes,
+    ScalarType dtype) {
+  AT_CHECK(
+      workspace.scalar_type() == ScalarType::Byte && workspace.is_contiguous(),
+      "workspace must be a contiguous Byte tensor");
+  int64_t numel = 1;
+  for (auto size : sizes) {
+    numel *= size;
+  }
+  const int64_t bytes = numel * static_cast<int64_t>(elementSize(dtype));
+  AT_CHECK(
+      offset + bytes <= workspace.numel(),
+      "workspace too small: need at least ",
+      offset + bytes,
+      " bytes but got ",
+      workspace.numel(),
+      "; size the arena with the op's _workspace_size query");
+  auto chunk = at::from_blob(
+      static_cast<uint8_t*>(workspace.data_ptr()) + offset,
+      sizes,
+      workspace.options().dtype(dtype));
+  offset += workspace_align(bytes);
+  return chunk;
+}
+
+} // namespace native
+} // namespace at
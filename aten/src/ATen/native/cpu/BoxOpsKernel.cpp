@@ -0,0 +1,148 @@
+#include <ATen/native/BoxOps.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at { namespace native { namespace {
+
+// Boxes arrive as [N, 4] rows of (x1, y1, x2, y2), which interleaves the
+// coordinates and defeats vector loads. Both kernels first deinterleave
+// into contiguous per-coordinate arrays (and precompute areas); the inner
+// IoU loops are then straight-line Vec256 arithmetic over full lanes.
+template <typename scalar_t>
+struct BoxColumns {
+  BoxColumns(const scalar_t* boxes, int64_t n)
+      : x1(n), y1(n), x2(n), y2(n), area(n) {
+    for (int64_t i = 0; i < n; i++) {
+      x1[i] = boxes[i * 4 + 0];
+      y1[i] = boxes[i * 4 + 1];
+      x2[i] = boxes[i * 4 + 2];
+      y2[i] = boxes[i * 4 + 3];
+      area[i] = (x2[i] - x1[i]) * (y2[i] - y1[i]);
+    }
+  }
+  std::vector<scalar_t> x1, y1, x2, y2, area;
+};
+
+// IoU of one box against cols[j] for j in [begin, end), written to out[j].
+template <typename scalar_t>
+void iou_one_to_many(
+    scalar_t bx1, scalar_t by1, scalar_t bx2, scalar_t by2, scalar_t barea,
+    const BoxColumns<scalar_t>& cols,
+    int64_t begin, int64_t end,
+    scalar_t* out) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const Vec vx1(bx1), vy1(by1), vx2(bx2), vy2(by2), varea(barea), zero(0);
+  int64_t j = begin;
+  for (; j + Vec::size() <= end; j += Vec::size()) {
+    const Vec iw = vec256::maximum(
+        vec256::minimum(vx2, Vec::loadu(cols.x2.data() + j)) -
+            vec256::maximum(vx1, Vec::loadu(cols.x1.data() + j)),
+        zero);
+    const Vec ih = vec256::maximum(
+        vec256::minimum(vy2, Vec::loadu(cols.y2.data() + j)) -
+            vec256::maximum(vy1, Vec::loadu(cols.y1.data() + j)),
+        zero);
+    const Vec inter = iw * ih;
+    const Vec iou =
+        inter / (varea + Vec::loadu(cols.area.data() + j) - inter);
+    iou.store(out + j);
+  }
+  for (; j < end; j++) {
+    const scalar_t iw = std::max(
+        std::min(bx2, cols.x2[j]) - std::max(bx1, cols.x1[j]), scalar_t(0));
+    const scalar_t ih = std::max(
+        std::min(by2, cols.y2[j]) - std::max(by1, cols.y1[j]), scalar_t(0));
+    const scalar_t inter = iw * ih;
+    out[j] = inter / (barea + cols.area[j] - inter);
+  }
+}
+
+static void box_iou_kernel(
+    Tensor& result,
+    const Tensor& boxes1,
+    const Tensor& boxes2) {
+  AT_DISPATCH_FLOATING_TYPES(boxes1.scalar_type(), "box_iou_cpu", [&] {
+    const int64_t n = boxes1.size(0);
+    const int64_t m = boxes2.size(0);
+    const scalar_t* b1 = boxes1.data<scalar_t>();
+    scalar_t* out = result.data<scalar_t>();
+    const BoxColumns<scalar_t> cols(boxes2.data<scalar_t>(), m);
+    const int64_t grain =
+        std::max(int64_t(1), internal::GRAIN_SIZE / std::max(int64_t(1), m));
+    at::parallel_for(0, n, grain, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const scalar_t* box = b1 + i * 4;
+        const scalar_t area =
+            (box[2] - box[0]) * (box[3] - box[1]);
+        iou_one_to_many(
+            box[0], box[1], box[2], box[3], area, cols, 0, m, out + i * m);
+      }
+    });
+  });
+}
+
+static Tensor nms_kernel(
+    const Tensor& boxes,
+    const Tensor& scores,
+    double iou_threshold) {
+  std::vector<int64_t> keep;
+  AT_DISPATCH_FLOATING_TYPES(boxes.scalar_type(), "nms_cpu", [&] {
+    const int64_t n = boxes.size(0);
+    const scalar_t* score_data = scores.data<scalar_t>();
+
+    std::vector<int64_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return score_data[a] > score_data[b];
+    });
+
+    // Permute the coordinate columns into score order so the suppression
+    // sweep below walks them contiguously.
+    std::vector<scalar_t> sorted(n * 4);
+    const scalar_t* box_data = boxes.data<scalar_t>();
+    for (int64_t i = 0; i < n; i++) {
+      const scalar_t* src = box_data + order[i] * 4;
+      std::copy(src, src + 4, sorted.data() + i * 4);
+    }
+    const BoxColumns<scalar_t> cols(sorted.data(), n);
+
+    std::vector<char> suppressed(n, 0);
+    std::vector<scalar_t> iou(n);
+    const scalar_t threshold = static_cast<scalar_t>(iou_threshold);
+    for (int64_t i = 0; i < n; i++) {
+      if (suppressed[i]) {
+        continue;
+      }
+      keep.push_back(order[i]);
+      if (i + 1 == n) {
+        break;
+      }
+      iou_one_to_many(
+          cols.x1[i], cols.y1[i], cols.x2[i], cols.y2[i], cols.area[i],
+          cols, i + 1, n, iou.data());
+      for (int64_t j = i + 1; j < n; j++) {
+        if (!suppressed[j] && iou[j] > threshold) {
+          suppressed[j] = 1;
+        }
+      }
+    }
+  });
+  Tensor result =
+      at::empty({static_cast<int64_t>(keep.size())},
+          boxes.options().dtype(kLong));
+  std::copy(keep.begin(), keep.end(), result.data<int64_t>());
+  return result;
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(box_iou_stub, &box_iou_kernel);
+REGISTER_DISPATCH(nms_stub, &nms_kernel);
+
+}} // namespace at::native
@@ -7,9 +7,11 @@ namespace at {
 namespace native {
 
 using forward_fn = void (*)(Tensor&, const Tensor&);
+using copy_scale_fn = void (*)(Tensor&, const Tensor&, double);
 
 DECLARE_DISPATCH(forward_fn, copy_kernel_same_type);
 DECLARE_DISPATCH(forward_fn, copy_kernel_cast);
+DECLARE_DISPATCH(copy_scale_fn, copy_scale_kernel);
 
 } // namespace native
 } // namespace at
@@ -0,0 +1,209 @@
+#include <ATen/native/cpu/DirectConvKernel.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+
+namespace at { namespace native { namespace {
+
+// Note [Direct convolution]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The THNN fallback lowers convolution to im2col + GEMM: it writes an
+// [IC*KH*KW, OH*OW] patch matrix to memory only to read it straight back,
+// tripling memory traffic, and with groups it additionally slices and
+// re-concatenates the tensors once per group. This kernel computes output
+// values directly instead. Each task owns one (image, output channel)
+// plane; for a tile of kOwTile output columns it keeps the accumulators
+// in registers across the whole in-channel x kernel-window reduction,
+// broadcasting one weight and FMAing it against contiguous input taps.
+// The only memory traffic is a streaming read of the taps and one write
+// of the finished tile.
+//
+// Columns whose taps all land inside the input (the interior, which is
+// nearly everything at typical paddings) take the vector path. Columns
+// near the borders -- and every column when stride_w != 1, since the taps
+// are then not contiguous -- use a scalar loop with per-tap bounds
+// checks. Groups only select which slice of the input channels a task
+// reduces over, so depthwise convolution is simply the ICg == 1 case.
+
+template <typename scalar_t>
+void direct_conv2d_impl(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  using Vec = vec256::Vec256<scalar_t>;
+  constexpr int64_t kVec = Vec::size();
+  // Four live accumulators per tile; with the loads and the broadcast this
+  // stays within 16 vector registers on every capability we build for.
+  constexpr int64_t kOwTile = 4 * kVec;
+
+  const int64_t N = input.size(0);
+  const int64_t IC = input.size(1);
+  const int64_t IH = input.size(2);
+  const int64_t IW = input.size(3);
+  const int64_t OC = weight.size(0);
+  const int64_t ICg = weight.size(1);
+  const int64_t KH = weight.size(2);
+  const int64_t KW = weight.size(3);
+  const int64_t OH = output.size(2);
+  const int64_t OW = output.size(3);
+  const int64_t OCg = OC / groups;
+  const int64_t sh = stride[0];
+  const int64_t sw = stride[1];
+  const int64_t ph = padding[0];
+  const int64_t pw = padding[1];
+  const int64_t dh = dilation[0];
+  const int64_t dw = dilation[1];
+
+  const scalar_t* in = input.data<scalar_t>();
+  const scalar_t* wt = weight.data<scalar_t>();
+  const scalar_t* bs = bias.defined() ? bias.data<scalar_t>() : nullptr;
+  scalar_t* out = output.data<scalar_t>();
+
+  // Interior columns: every kw tap of every column in [ow_lo, ow_hi) lies
+  // inside the input row.
+  const int64_t ow_lo = std::min(OW, (pw + sw - 1) / sw);
+  const int64_t last_tap = IW - 1 + pw - (KW - 1) * dw;
+  const int64_t ow_hi =
+      last_tap < 0 ? ow_lo : std::max(ow_lo, std::min(OW, last_tap / sw + 1));
+
+  const int64_t plane_cost = std::max<int64_t>(OH * OW * ICg * KH * KW, 1);
+  const int64_t grain = std::max<int64_t>(1, internal::GRAIN_SIZE / plane_cost);
+
+  parallel_for(0, N * OC, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      const int64_t n = task / OC;
+      const int64_t oc = task % OC;
+      const int64_t g = oc / OCg;
+      const scalar_t* in_n = in + (n * IC + g * ICg) * IH * IW;
+      const scalar_t* w_oc = wt + oc * ICg * KH * KW;
+      scalar_t* out_plane = out + task * OH * OW;
+      const scalar_t bias_v = bs ? bs[oc] : scalar_t(0);
+
+      for (int64_t oh = 0; oh < OH; oh++) {
+        scalar_t* out_row = out_plane + oh * OW;
+        const int64_t ih0 = oh * sh - ph;
+
+        auto scalar_cols = [&](int64_t ow_begin, int64_t ow_end) {
+          for (int64_t ow = ow_begin; ow < ow_end; ow++) {
+            scalar_t acc = bias_v;
+            const int64_t iw0 = ow * sw - pw;
+            for (int64_t ic = 0; ic < ICg; ic++) {
+              const scalar_t* in_c = in_n + ic * IH * IW;
+              const scalar_t* w_c = w_oc + ic * KH * KW;
+              for (int64_t kh = 0; kh < KH; kh++) {
+                const int64_t ih = ih0 + kh * dh;
+                if (ih < 0 || ih >= IH) {
+                  continue;
+                }
+                const scalar_t* in_row = in_c + ih * IW;
+                const scalar_t* w_row = w_c + kh * KW;
+                for (int64_t kw = 0; kw < KW; kw++) {
+                  const int64_t iw = iw0 + kw * dw;
+                  if (iw < 0 || iw >= IW) {
+                    continue;
+                  }
+                  acc += in_row[iw] * w_row[kw];
+                }
+              }
+            }
+            out_row[ow] = acc;
+          }
+        };
+
+        if (sw != 1) {
+          scalar_cols(0, OW);
+          continue;
+        }
+
+        scalar_cols(0, ow_lo);
+        int64_t ow = ow_lo;
+        const int64_t tile_end = ow_lo + ((ow_hi - ow_lo) / kOwTile) * kOwTile;
+        for (; ow < tile_end; ow += kOwTile) {
+          Vec acc0(bias_v);
+          Vec acc1(bias_v);
+          Vec acc2(bias_v);
+          Vec acc3(bias_v);
+          // sw == 1, so the column's first tap is at iw = ow - pw and the
+          // taps of adjacent columns are adjacent.
+          const scalar_t* in_base = in_n + (ow - pw);
+          for (int64_t ic = 0; ic < ICg; ic++) {
+            const scalar_t* in_c = in_base + ic * IH * IW;
+            const scalar_t* w_c = w_oc + ic * KH * KW;
+            for (int64_t kh = 0; kh < KH; kh++) {
+              const int64_t ih = ih0 + kh * dh;
+              if (ih < 0 || ih >= IH) {
+                continue;
+              }
+              const scalar_t* in_row = in_c + ih * IW;
+              const scalar_t* w_row = w_c + kh * KW;
+              for (int64_t kw = 0; kw < KW; kw++) {
+                const Vec wv(w_row[kw]);
+                const scalar_t* tap = in_row + kw * dw;
+                acc0 = vec256::fmadd(Vec::loadu(tap), wv, acc0);
+                acc1 = vec256::fmadd(Vec::loadu(tap + kVec), wv, acc1);
+                acc2 = vec256::fmadd(Vec::loadu(tap + 2 * kVec), wv, acc2);
+                acc3 = vec256::fmadd(Vec::loadu(tap + 3 * kVec), wv, acc3);
+              }
+            }
+          }
+          acc0.store(out_row + ow);
+          acc1.store(out_row + ow + kVec);
+          acc2.store(out_row + ow + 2 * kVec);
+          acc3.store(out_row + ow + 3 * kVec);
+        }
+        for (; ow + kVec <= ow_hi; ow += kVec) {
+          Vec acc(bias_v);
+          const scalar_t* in_base = in_n + (ow - pw);
+          for (int64_t ic = 0; ic < ICg; ic++) {
+            const scalar_t* in_c = in_base + ic * IH * IW;
+            const scalar_t* w_c = w_oc + ic * KH * KW;
+            for (int64_t kh = 0; kh < KH; kh++) {
+              const int64_t ih = ih0 + kh * dh;
+              if (ih < 0 || ih >= IH) {
+                continue;
+              }
+              const scalar_t* in_row = in_c + ih * IW;
+              const scalar_t* w_row = w_c + kh * KW;
+              for (int64_t kw = 0; kw < KW; kw++) {
+                acc = vec256::fmadd(
+                    Vec::loadu(in_row + kw * dw), Vec(w_row[kw]), acc);
+              }
+            }
+          }
+          acc.store(out_row + ow);
+        }
+        // Interior leftover narrower than a vector, then the right border.
+        scalar_cols(ow, OW);
+      }
+    }
+  });
+}
+
+void direct_conv2d_kernel(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "direct_conv2d", [&] {
+    direct_conv2d_impl<scalar_t>(
+        output, input, weight, bias, stride, padding, dilation, groups);
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(direct_conv2d_stub, &direct_conv2d_kernel);
+
+}} // namespace at::native
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Direct NCHW 2-d convolution. output must be preallocated, contiguous,
+// [N, OC, OH, OW]; input, weight and bias must be contiguous (bias may be
+// undefined). Groups are handled inside the kernel, so grouped and
+// depthwise convolutions run without the per-group slice-and-cat that
+// _convolution otherwise performs. Forward only; see
+// Note [Direct convolution] in DirectConvKernel.cpp.
+using direct_conv2d_fn = void (*)(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups);
+
+DECLARE_DISPATCH(direct_conv2d_fn, direct_conv2d_stub);
+
+}} // namespace at::native
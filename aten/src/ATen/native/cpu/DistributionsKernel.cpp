@@ -0,0 +1,59 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+
+#include <ATen/native/Distributions.h>
+#include <ATen/native/UnaryOps.h>
+#include <ATen/native/cpu/PhiloxRNG.h>
+
+#include <TH/THGenerator.hpp>
+#include <TH/THRandom.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace at { namespace native {
+namespace {
+
+// See Note [Philox CPU streams] in cpu/PhiloxRNG.h. The bound generator is
+// only touched once, to derive the stream seed; after that every block of
+// four elements is a pure function of (seed, block index), so the range
+// splits freely across threads. One parallel_for index covers four
+// elements, i.e. one Philox block.
+void bernoulli_philox_kernel(Tensor& self, const double p, Generator* gen) {
+  THGenerator* generator = get_generator(gen);
+  uint64_t seed;
+  {
+    std::lock_guard<std::mutex> lock(generator->mutex);
+    seed = THRandom_random(generator);
+  }
+  const int64_t n = self.numel();
+  if (n == 0) {
+    return;
+  }
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "bernoulli_scalar_cpu_", [&] {
+    scalar_t* self_ptr = self.data<scalar_t>();
+    const float p_val = static_cast<float>(p);
+    at::parallel_for(
+        0, (n + 3) / 4, /* grain_size= */ 200, [&](int64_t begin, int64_t end) {
+          for (int64_t block = begin; block < end; block++) {
+            philox::Philox4x32 engine(seed, static_cast<uint64_t>(block));
+            uint32_t bits[4];
+            engine.next4(bits);
+            const int64_t base = block * 4;
+            const int64_t len = std::min<int64_t>(4, n - base);
+            for (int64_t i = 0; i < len; i++) {
+              self_ptr[base + i] = static_cast<scalar_t>(
+                  philox::uniform_float(bits[i]) < p_val ? 1 : 0);
+            }
+          }
+        });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(bernoulli_philox_stub, &bernoulli_philox_kernel);
+
+}} // namespace at::native
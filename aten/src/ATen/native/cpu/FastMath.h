@@ -0,0 +1,62 @@
+#pragma once
+
+// Reduced-accuracy float transcendentals for the fast math tier; see
+// Note [Fast math tier] in ATen/core/fast_math_mode.h. These are plain
+// scalar functions with branch-free interiors so the vectorizer turns
+// the unary_kernel loops over them into packed code.
+//
+// The fuser emits textually equivalent definitions into generated
+// kernels (torch/csrc/jit/fuser/codegen.cpp); keep the two in sync so
+// eager and fused results match bit for bit.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace at { namespace native { namespace fastmath {
+
+// exp(x) as 2^(x*log2(e)), splitting into integer exponent and a cubic
+// for the fractional part. The cubic's trailing coefficient is chosen so
+// the polynomial is exact at both ends of [0, 1); relative error stays
+// below ~6e-4 (about 11-12 significant bits). Inputs that would
+// produce denormals flush to zero.
+inline float fast_expf(float x) {
+  constexpr float kLog2e = 1.442695041f;
+  const float t = x * kLog2e;
+  if (t <= -126.0f) {
+    return 0.0f;
+  }
+  if (t >= 128.0f) {
+    return std::numeric_limits<float>::infinity();
+  }
+  const float fi = std::floor(t);
+  const float f = t - fi;
+  const float p =
+      1.0f + f * (0.693147180f + f * (0.240226507f + f * 0.066626312f));
+  const uint32_t bits = static_cast<uint32_t>(
+      (static_cast<int32_t>(fi) + 127) << 23);
+  float scale;
+  std::memcpy(&scale, &bits, sizeof(scale));
+  return p * scale;
+}
+
+inline float fast_sigmoidf(float x) {
+  // fast_expf saturates cleanly at both ends: exp(-x) -> 0 gives 1,
+  // exp(-x) -> inf gives 0.
+  return 1.0f / (1.0f + fast_expf(-x));
+}
+
+inline float fast_tanhf(float x) {
+  // Saturate before exp(2x) can overflow to inf and produce inf/inf.
+  if (x > 9.0f) {
+    return 1.0f;
+  }
+  if (x < -9.0f) {
+    return -1.0f;
+  }
+  const float e = fast_expf(2.0f * x);
+  return (e - 1.0f) / (e + 1.0f);
+}
+
+}}} // namespace at::native::fastmath
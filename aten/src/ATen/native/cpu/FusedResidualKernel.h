@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// out = self * mask * scale + other, all tensors contiguous and same-sized.
+using fused_dropout_add_fn = void (*)(
+    Tensor& out,
+    const Tensor& self,
+    const Tensor& mask,
+    const Tensor& other,
+    double scale);
+
+// out = layer_norm(self + other) over M rows of N elements, with optional
+// affine weight/bias of N elements (both defined or both undefined).
+using fused_add_layer_norm_fn = void (*)(
+    Tensor& out,
+    const Tensor& self,
+    const Tensor& other,
+    int64_t M,
+    int64_t N,
+    const Tensor& weight,
+    const Tensor& bias,
+    double eps);
+
+// out = gelu(self + bias), bias broadcast along the last dimension.
+using fused_bias_gelu_fn = void (*)(
+    Tensor& out,
+    const Tensor& self,
+    const Tensor& bias);
+
+DECLARE_DISPATCH(fused_dropout_add_fn, fused_dropout_add_stub);
+DECLARE_DISPATCH(fused_add_layer_norm_fn, fused_add_layer_norm_stub);
+DECLARE_DISPATCH(fused_bias_gelu_fn, fused_bias_gelu_stub);
+
+}} // namespace at::native
@@ -13,6 +13,7 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <type_traits>
 
@@ -895,10 +896,128 @@ grid_sampler_2d_backward_cpu_kernel_impl(const Tensor& grad_output_,
   return std::make_tuple(grad_input, grad_grid);
 }
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~ Plan-based sampling ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When the same grid is applied to many channels or frames, recomputing the
+// corner weights and padding logic per plane is pure overhead. The plan
+// kernel runs that logic once per output pixel, emitting four flattened
+// corner offsets into an input plane plus their interpolation weights
+// (nearest interpolation uses one corner with weight one). Out-of-bounds
+// corners get weight zero, which folds the padding mode into the weights:
+// zeros padding drops the corner outright, while border and reflection have
+// already mapped the coordinate inside the plane. Applying the plan is then
+// a branch-free gather-multiply-accumulate per plane.
+
+template<typename scalar_t>
+inline scalar_t plan_reflect_coord(scalar_t in, scalar_t max_val) {
+  if (max_val <= 0) {
+    return 0;
+  }
+  scalar_t double_max = 2 * max_val;
+  scalar_t extra = std::fmod(std::fabs(in), double_max);
+  return extra > max_val ? double_max - extra : extra;
+}
+
+static void grid_sampler_2d_plan_kernel_impl(
+    Tensor& indices, Tensor& weights, const Tensor& grid,
+    int64_t inp_H, int64_t inp_W,
+    int64_t interpolation_mode, int64_t padding_mode) {
+  auto interp = static_cast<GridSamplerInterpolation>(interpolation_mode);
+  auto padding = static_cast<GridSamplerPadding>(padding_mode);
+  int64_t count = grid.size(0) * grid.size(1) * grid.size(2);
+  AT_DISPATCH_FLOATING_TYPES(grid.scalar_type(), "grid_sampler_2d_plan_cpu_kernel_impl", [&] {
+    auto grid_contig = grid.contiguous();
+    const scalar_t* grid_p = grid_contig.data<scalar_t>();
+    int64_t* idx_p = indices.data<int64_t>();
+    scalar_t* w_p = weights.data<scalar_t>();
+    const scalar_t max_x = static_cast<scalar_t>(inp_W - 1);
+    const scalar_t max_y = static_cast<scalar_t>(inp_H - 1);
+    at::parallel_for(0, count, 4096, [&](int64_t begin, int64_t end) {
+      for (int64_t p = begin; p < end; p++) {
+        scalar_t x = (grid_p[2 * p] + 1) * max_x / 2;
+        scalar_t y = (grid_p[2 * p + 1] + 1) * max_y / 2;
+        if (padding == GridSamplerPadding::Reflection) {
+          x = plan_reflect_coord(x, max_x);
+          y = plan_reflect_coord(y, max_y);
+        }
+        if (padding != GridSamplerPadding::Zeros) {
+          x = std::min(max_x, std::max(x, static_cast<scalar_t>(0)));
+          y = std::min(max_y, std::max(y, static_cast<scalar_t>(0)));
+        }
+        int64_t* idx = idx_p + 4 * p;
+        scalar_t* w = w_p + 4 * p;
+        if (interp == GridSamplerInterpolation::Nearest) {
+          int64_t ix = static_cast<int64_t>(std::round(x));
+          int64_t iy = static_cast<int64_t>(std::round(y));
+          bool in_bounds =
+              ix >= 0 && ix < inp_W && iy >= 0 && iy < inp_H;
+          idx[0] = in_bounds ? iy * inp_W + ix : 0;
+          w[0] = in_bounds ? static_cast<scalar_t>(1) : static_cast<scalar_t>(0);
+          idx[1] = idx[2] = idx[3] = 0;
+          w[1] = w[2] = w[3] = 0;
+          continue;
+        }
+        int64_t ix0 = static_cast<int64_t>(std::floor(x));
+        int64_t iy0 = static_cast<int64_t>(std::floor(y));
+        scalar_t wx1 = x - ix0;
+        scalar_t wy1 = y - iy0;
+        scalar_t wx0 = 1 - wx1;
+        scalar_t wy0 = 1 - wy1;
+        const int64_t corner_x[4] = {ix0, ix0 + 1, ix0, ix0 + 1};
+        const int64_t corner_y[4] = {iy0, iy0, iy0 + 1, iy0 + 1};
+        const scalar_t corner_w[4] = {
+            wx0 * wy0, wx1 * wy0, wx0 * wy1, wx1 * wy1};
+        for (int k = 0; k < 4; k++) {
+          bool in_bounds = corner_x[k] >= 0 && corner_x[k] < inp_W &&
+              corner_y[k] >= 0 && corner_y[k] < inp_H;
+          idx[k] = in_bounds ? corner_y[k] * inp_W + corner_x[k] : 0;
+          w[k] = in_bounds ? corner_w[k] : static_cast<scalar_t>(0);
+        }
+      }
+    });
+  });
+}
+
+static void grid_sampler_2d_apply_plan_kernel_impl(
+    Tensor& output, const Tensor& input,
+    const Tensor& indices, const Tensor& weights) {
+  int64_t N = input.size(0);
+  int64_t C = input.size(1);
+  int64_t P = indices.size(1) * indices.size(2);
+  int64_t inp_plane = input.size(2) * input.size(3);
+  // A plan with batch size one is shared across the whole input batch.
+  bool shared_plan = indices.size(0) == 1;
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler_2d_apply_plan_cpu_kernel_impl", [&] {
+    auto inp_contig = input.contiguous();
+    auto idx_contig = indices.contiguous();
+    auto w_contig = weights.contiguous();
+    const scalar_t* inp_p = inp_contig.data<scalar_t>();
+    const int64_t* idx_p = idx_contig.data<int64_t>();
+    const scalar_t* w_p = w_contig.data<scalar_t>();
+    scalar_t* out_p = output.data<scalar_t>();
+    at::parallel_for(0, N * C, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t nc = begin; nc < end; nc++) {
+        int64_t n = nc / C;
+        const int64_t* idx = idx_p + (shared_plan ? 0 : n * P * 4);
+        const scalar_t* w = w_p + (shared_plan ? 0 : n * P * 4);
+        const scalar_t* in_plane = inp_p + nc * inp_plane;
+        scalar_t* out = out_p + nc * P;
+        for (int64_t p = 0; p < P; p++) {
+          const int64_t* i4 = idx + 4 * p;
+          const scalar_t* w4 = w + 4 * p;
+          out[p] = w4[0] * in_plane[i4[0]] + w4[1] * in_plane[i4[1]] +
+              w4[2] * in_plane[i4[2]] + w4[3] * in_plane[i4[3]];
+        }
+      }
+    });
+  });
+}
+
 }
 
 REGISTER_DISPATCH(grid_sampler_2d_cpu_kernel, &grid_sampler_2d_cpu_kernel_impl);
 REGISTER_DISPATCH(grid_sampler_2d_backward_cpu_kernel, &grid_sampler_2d_backward_cpu_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_2d_plan_cpu_kernel, &grid_sampler_2d_plan_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_2d_apply_plan_cpu_kernel, &grid_sampler_2d_apply_plan_kernel_impl);
 
 
 }}  // namespace at::native
@@ -12,7 +12,11 @@ namespace at { namespace native {
 
 using forward_2d_fn = Tensor(*)(const Tensor &, const Tensor &, int64_t, int64_t);
 using backward_2d_fn = std::tuple<Tensor, Tensor>(*)(const Tensor &, const Tensor &, const Tensor &, int64_t, int64_t);
+using plan_2d_fn = void(*)(Tensor &, Tensor &, const Tensor &, int64_t, int64_t, int64_t, int64_t);
+using apply_plan_2d_fn = void(*)(Tensor &, const Tensor &, const Tensor &, const Tensor &);
 DECLARE_DISPATCH(forward_2d_fn, grid_sampler_2d_cpu_kernel);
 DECLARE_DISPATCH(backward_2d_fn, grid_sampler_2d_backward_cpu_kernel);
+DECLARE_DISPATCH(plan_2d_fn, grid_sampler_2d_plan_cpu_kernel);
+DECLARE_DISPATCH(apply_plan_2d_fn, grid_sampler_2d_apply_plan_cpu_kernel);
 
 }}  // namespace at::native
@@ -1,6 +1,7 @@
 #include <ATen/native/Indexing.h>
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
@@ -57,9 +58,17 @@ static bool is_constant_index(int ntensor, const int64_t* strides) {
   return true;
 }
 
-template <typename scalar_t, typename func_t>
+// `f` handles one element at a time; `block_f` handles a whole inner row
+// sharing a single index offset when both operands are contiguous along
+// it, so gathers with a large trailing dimension become one block copy
+// per index instead of an elementwise loop. The TensorIterator setup in
+// Indexing.cpp already makes the trailing dimension the inner loop (with
+// zero index strides along it), so no extra shape analysis is needed
+// here; iter.for_each supplies the parallelism over indices.
+template <typename scalar_t, typename func_t, typename block_func_t>
 void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride,
-                      const func_t& f, bool serial_execution=false)
+                      const func_t& f, const block_func_t& block_f,
+                      bool serial_execution=false)
 {
   auto loop = [&](int ntensor, char** data, const int64_t* strides, int64_t n) {
     auto indexer = Indexer(ntensor - 2, &data[2], &strides[2], index_size, index_stride);
@@ -69,9 +78,7 @@ void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
       // specialization for when every element uses the same index
       int64_t offset = indexer.get(0);
       if (strides[0] == sizeof(scalar_t) && strides[1] == sizeof(scalar_t)) {
-        for (int64_t i = 0; i < n; i++) {
-          f(dst + strides[0] * i, src + strides[1] * i, offset);
-        }
+        block_f(dst, src, offset, n);
       } else {
         for (int64_t i = 0; i < n; i++) {
           f(dst + strides[0] * i, src + strides[1] * i, offset);
@@ -93,9 +100,14 @@ void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
 
 void index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride) {
   AT_DISPATCH_ALL_TYPES_AND2(at::ScalarType::Half, at::ScalarType::Bool, iter.dtype(), "index_cpu", [&] {
-    cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-      *(scalar_t*)dst = *(scalar_t*)(src + offset);
-    });
+    cpu_index_kernel<scalar_t>(iter, index_size, index_stride,
+      [](char* dst, char* src, int64_t offset) {
+        *(scalar_t*)dst = *(scalar_t*)(src + offset);
+      },
+      [](char* dst, char* src, int64_t offset, int64_t n) {
+        // row gather: one block copy per index
+        memcpy(dst, src + offset, n * sizeof(scalar_t));
+      });
   });
 }
 
@@ -105,13 +117,26 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
     if (accumulate) {
       // TODO: investigate parallelization of the accumulate kernel. Unlike the non-accumulate case,
       // this needs to be thread-safe.
-      cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-        *(scalar_t*)(dst + offset) += *(scalar_t*)src;
-      }, /*serial_execution=*/true);
+      cpu_index_kernel<scalar_t>(iter, index_size, index_stride,
+        [](char* dst, char* src, int64_t offset) {
+          *(scalar_t*)(dst + offset) += *(scalar_t*)src;
+        },
+        [](char* dst, char* src, int64_t offset, int64_t n) {
+          scalar_t* out = (scalar_t*)(dst + offset);
+          scalar_t* in = (scalar_t*)src;
+          for (int64_t i = 0; i < n; i++) {
+            out[i] += in[i];
+          }
+        }, /*serial_execution=*/true);
     } else {
-      cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-        *(scalar_t*)(dst + offset) = *(scalar_t*)src;
-      });
+      cpu_index_kernel<scalar_t>(iter, index_size, index_stride,
+        [](char* dst, char* src, int64_t offset) {
+          *(scalar_t*)(dst + offset) = *(scalar_t*)src;
+        },
+        [](char* dst, char* src, int64_t offset, int64_t n) {
+          // row scatter: one block copy per index
+          memcpy(dst + offset, src, n * sizeof(scalar_t));
+        });
     }
   });
 }
@@ -105,18 +105,41 @@ static inline void unary_loop(char** data, const int64_t* strides, int64_t i, in
   }
 }
 
+// Note [Streaming stores in vectorized loops]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When an output is much larger than the last-level cache, ordinary
+// stores evict useful lines for data that will be flushed before anyone
+// reads it. Kernels whose results are typically consumed once (copy) can
+// opt in to non-temporal stores; the opt-in only takes effect once the
+// whole output is past this byte threshold, so cache-resident outputs
+// keep the fast path. Each vectorized slice ends with a store_fence() to
+// order the streamed data before the next op's loads.
+constexpr int64_t kNonTemporalThresholdBytes = 4 * 1024 * 1024;
+
 // computes out = op(in1)
 template <typename func_t, typename vec_func_t>
-static inline void vectorized_unary_loop(char** data, int64_t n, func_t op, vec_func_t vop) {
+static inline void vectorized_unary_loop(char** data, int64_t n, func_t op, vec_func_t vop, bool stream = false) {
   UNARY_VEC_LOOP_HEADER(func_t, data)
   int64_t i = 0;
-  for (; i <= n - 2 * Vec::size(); i += 2 * Vec::size()) {
-    auto a1 = Vec::loadu(in1_ptr + i * sizeof(scalar_t));
-    auto a2 = Vec::loadu(in1_ptr + (i + Vec::size()) * sizeof(scalar_t));
-    auto out1 = vop(a1);
-    auto out2 = vop(a2);
-    out1.store(out_ptr + i * sizeof(scalar_t));
-    out2.store(out_ptr + (i + Vec::size()) * sizeof(scalar_t));
+  if (stream) {
+    for (; i <= n - 2 * Vec::size(); i += 2 * Vec::size()) {
+      auto a1 = Vec::loadu(in1_ptr + i * sizeof(scalar_t));
+      auto a2 = Vec::loadu(in1_ptr + (i + Vec::size()) * sizeof(scalar_t));
+      auto out1 = vop(a1);
+      auto out2 = vop(a2);
+      out1.store_nontemporal(out_ptr + i * sizeof(scalar_t));
+      out2.store_nontemporal(out_ptr + (i + Vec::size()) * sizeof(scalar_t));
+    }
+    store_fence();
+  } else {
+    for (; i <= n - 2 * Vec::size(); i += 2 * Vec::size()) {
+      auto a1 = Vec::loadu(in1_ptr + i * sizeof(scalar_t));
+      auto a2 = Vec::loadu(in1_ptr + (i + Vec::size()) * sizeof(scalar_t));
+      auto out1 = vop(a1);
+      auto out2 = vop(a2);
+      out1.store(out_ptr + i * sizeof(scalar_t));
+      out2.store(out_ptr + (i + Vec::size()) * sizeof(scalar_t));
+    }
   }
   int64_t strides[] = { sizeof(scalar_t), sizeof(scalar_t) };
   unary_loop(data, strides, i, n, op);
@@ -137,18 +160,32 @@ static inline void binary_loop(char** data, const int64_t* strides, int64_t i, i
 
 // computes out = op(in1, in2)
 template <typename func_t, typename vec_func_t>
-static inline void vectorized_binary_loop(char** data, int64_t n, func_t op, vec_func_t vop) {
+static inline void vectorized_binary_loop(char** data, int64_t n, func_t op, vec_func_t vop, bool stream = false) {
   VEC_LOOP_HEADER(func_t, data)
   int64_t i = 0;
-  for (; i <= n - 2 * Vec::size(); i += 2 * Vec::size()) {
-    auto a1 = Vec::loadu(in1_ptr + i * sizeof(scalar_t));
-    auto a2 = Vec::loadu(in1_ptr + (i + Vec::size()) * sizeof(scalar_t));
-    auto b1 = Vec::loadu(in2_ptr + i * sizeof(scalar_t));
-    auto b2 = Vec::loadu(in2_ptr + (i + Vec::size()) * sizeof(scalar_t));
-    auto out1 = vop(a1, b1);
-    auto out2 = vop(a2, b2);
-    out1.store(out_ptr + i * sizeof(scalar_t));
-    out2.store(out_ptr + (i + Vec::size()) * sizeof(scalar_t));
+  if (stream) {
+    for (; i <= n - 2 * Vec::size(); i += 2 * Vec::size()) {
+      auto a1 = Vec::loadu(in1_ptr + i * sizeof(scalar_t));
+      auto a2 = Vec::loadu(in1_ptr + (i + Vec::size()) * sizeof(scalar_t));
+      auto b1 = Vec::loadu(in2_ptr + i * sizeof(scalar_t));
+      auto b2 = Vec::loadu(in2_ptr + (i + Vec::size()) * sizeof(scalar_t));
+      auto out1 = vop(a1, b1);
+      auto out2 = vop(a2, b2);
+      out1.store_nontemporal(out_ptr + i * sizeof(scalar_t));
+      out2.store_nontemporal(out_ptr + (i + Vec::size()) * sizeof(scalar_t));
+    }
+    store_fence();
+  } else {
+    for (; i <= n - 2 * Vec::size(); i += 2 * Vec::size()) {
+      auto a1 = Vec::loadu(in1_ptr + i * sizeof(scalar_t));
+      auto a2 = Vec::loadu(in1_ptr + (i + Vec::size()) * sizeof(scalar_t));
+      auto b1 = Vec::loadu(in2_ptr + i * sizeof(scalar_t));
+      auto b2 = Vec::loadu(in2_ptr + (i + Vec::size()) * sizeof(scalar_t));
+      auto out1 = vop(a1, b1);
+      auto out2 = vop(a2, b2);
+      out1.store(out_ptr + i * sizeof(scalar_t));
+      out2.store(out_ptr + (i + Vec::size()) * sizeof(scalar_t));
+    }
   }
   int64_t strides[] = { sizeof(scalar_t), sizeof(scalar_t), sizeof(scalar_t) };
   binary_loop(data, strides, i, n, op);
@@ -285,16 +322,22 @@ void unary_kernel(TensorIterator& iter, func_t op) {
 }
 
 template <typename func_t, typename vec_func_t>
-void unary_kernel_vec(TensorIterator& iter, func_t op, vec_func_t vop) {
+void unary_kernel_vec(TensorIterator& iter, func_t op, vec_func_t vop,
+                      bool allow_streaming_stores = false) {
   using traits = unary_function_traits<func_t>;
   static_assert(
     std::is_same<typename traits::result_type, typename traits::arg1_t>::value,
     "all types must match");
 
+  // See Note [Streaming stores in vectorized loops]
+  const bool stream = allow_streaming_stores &&
+      iter.numel() * static_cast<int64_t>(sizeof(typename traits::result_type)) >=
+          kNonTemporalThresholdBytes;
+
   iter.for_each(
       [&](int ntensor, char** data, const int64_t* strides, int64_t n) {
         if (is_unary_contiguous<traits>(strides)) {
-          vectorized_unary_loop(data, n, op, vop);
+          vectorized_unary_loop(data, n, op, vop, stream);
         } else if (is_unary_contiguous_s1<traits>(strides)) {
           unary_loop(data, strides, 0, n, op);
         } else {
@@ -322,7 +365,8 @@ void binary_kernel(TensorIterator& iter, func_t op) {
 }
 
 template <typename func_t, typename vec_func_t>
-void binary_kernel_vec(TensorIterator& iter, func_t op, vec_func_t vop) {
+void binary_kernel_vec(TensorIterator& iter, func_t op, vec_func_t vop,
+                       bool allow_streaming_stores = false) {
   using traits = binary_function_traits<func_t>;
   static_assert(
     std::is_same<typename traits::result_type, typename traits::arg1_t>::value,
@@ -331,9 +375,14 @@ void binary_kernel_vec(TensorIterator& iter, func_t op, vec_func_t vop) {
     std::is_same<typename traits::result_type, typename traits::arg2_t>::value,
     "all types must match");
 
+  // See Note [Streaming stores in vectorized loops]
+  const bool stream = allow_streaming_stores &&
+      iter.numel() * static_cast<int64_t>(sizeof(typename traits::result_type)) >=
+          kNonTemporalThresholdBytes;
+
   iter.for_each([&](int ntensor, char** data, const int64_t* strides, int64_t n) {
     if (is_binary_contiguous<traits>(strides)) {
-      vectorized_binary_loop(data, n, op, vop);
+      vectorized_binary_loop(data, n, op, vop, stream);
     } else if (is_binary_contiguous_s1<traits>(strides)) {
       vectorized_binary_loop_s1(data, n, op, vop);
     } else if (is_binary_contiguous_s2<traits>(strides)) {
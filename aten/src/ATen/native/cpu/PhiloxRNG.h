@@ -0,0 +1,109 @@
+#pragma once
+
+// Note [Philox CPU streams]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The TH Mersenne Twister carries 2.5 KiB of state behind a mutex, so every
+// CPU sampling kernel serializes on the generator lock and draws scalars
+// one at a time. Philox4x32-10 is counter-based: the 128-bit output block
+// is a pure function of (seed, counter), so a kernel can draw one 64-bit
+// seed from the bound generator under the lock and then hand disjoint
+// counter ranges to parallel_for workers -- no shared state, and identical
+// results regardless of how the range is split across threads. This
+// mirrors what the CUDA sampling kernels already do with curand's Philox
+// and what the MKL bernoulli path does with skip-ahead streams.
+
+#include <cmath>
+#include <cstdint>
+
+namespace at {
+namespace native {
+namespace philox {
+
+class Philox4x32 {
+ public:
+  // Every counter value yields an independent 128-bit block; consecutive
+  // next4() calls advance the counter internally.
+  Philox4x32(uint64_t seed, uint64_t counter) {
+    key_[0] = static_cast<uint32_t>(seed);
+    key_[1] = static_cast<uint32_t>(seed >> 32);
+    ctr_[0] = static_cast<uint32_t>(counter);
+    ctr_[1] = static_cast<uint32_t>(counter >> 32);
+    ctr_[2] = 0;
+    ctr_[3] = 0;
+  }
+
+  // Runs the ten bijection rounds on the current counter, writes the four
+  // 32-bit outputs, and bumps the counter.
+  void next4(uint32_t out[4]) {
+    uint32_t ctr0 = ctr_[0];
+    uint32_t ctr1 = ctr_[1];
+    uint32_t ctr2 = ctr_[2];
+    uint32_t ctr3 = ctr_[3];
+    uint32_t key0 = key_[0];
+    uint32_t key1 = key_[1];
+    for (int round = 0; round < 10; round++) {
+      if (round > 0) {
+        key0 += kWeyl0;
+        key1 += kWeyl1;
+      }
+      uint32_t hi0, lo0, hi1, lo1;
+      mulhilo(kMul0, ctr0, hi0, lo0);
+      mulhilo(kMul1, ctr2, hi1, lo1);
+      const uint32_t next0 = hi1 ^ ctr1 ^ key0;
+      const uint32_t next2 = hi0 ^ ctr3 ^ key1;
+      ctr1 = lo1;
+      ctr3 = lo0;
+      ctr0 = next0;
+      ctr2 = next2;
+    }
+    out[0] = ctr0;
+    out[1] = ctr1;
+    out[2] = ctr2;
+    out[3] = ctr3;
+    if (++ctr_[0] == 0 && ++ctr_[1] == 0 && ++ctr_[2] == 0) {
+      ++ctr_[3];
+    }
+  }
+
+ private:
+  static constexpr uint32_t kMul0 = 0xD2511F53;
+  static constexpr uint32_t kMul1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+  static void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+    const uint64_t product = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(product >> 32);
+    lo = static_cast<uint32_t>(product);
+  }
+
+  uint32_t key_[2];
+  uint32_t ctr_[4];
+};
+
+// Maps 32 random bits to [0, 1) with 24 bits of resolution.
+inline float uniform_float(uint32_t x) {
+  return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+}
+
+// Maps 64 random bits to [0, 1) with 53 bits of resolution.
+inline double uniform_double(uint32_t hi, uint32_t lo) {
+  const uint64_t bits = (static_cast<uint64_t>(hi) << 32) | lo;
+  return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Box-Muller: maps two 32-bit draws to two standard normal samples. The
+// first uniform is shifted into (0, 1] so the log is finite.
+inline void normal_pair_float(uint32_t a, uint32_t b, float& n1, float& n2) {
+  const float u1 =
+      (static_cast<float>(a >> 8) + 1.0f) * (1.0f / 16777216.0f);
+  const float u2 = uniform_float(b);
+  const float radius = std::sqrt(-2.0f * std::log(u1));
+  const float theta = 6.283185307179586f * u2;
+  n1 = radius * std::cos(theta);
+  n2 = radius * std::sin(theta);
+}
+
+} // namespace philox
+} // namespace native
+} // namespace at
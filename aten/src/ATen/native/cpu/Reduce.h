@@ -64,7 +64,13 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
   using c_traits = binary_function_traits<cf_t>;
   using p_traits = unary_function_traits<pf_t>;
   using acc_t = typename p_traits::arg1_t;
+  // The type read from the input (reduce's data argument) and the type
+  // written to the output (project's result) may differ, so that
+  // low-precision inputs can reduce with widened accumulators without a
+  // materialized upcast; see Note [Widened accumulation for CPU reductions]
+  // in ReduceOps.cpp.
   using data_t = typename p_traits::result_type;
+  using load_t = typename r_traits::arg2_t;
   static_assert(
     all_same<
       acc_t,
@@ -75,9 +81,6 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
       typename c_traits::arg2_t,
       typename c_traits::result_type>::value,
     "all accumulate types must match");
-  static_assert(
-    std::is_same<data_t, typename r_traits::arg2_t>::value,
-    "all data types must match");
   static_assert(
     std::is_default_constructible<acc_t>::value,
     "the accumulate type must be default-constructible"
@@ -89,7 +92,7 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
         char *in = data[1];
         int64_t stride = strides[1];
         for (int64_t i = 0; i < size; ++i) {
-          acc = ops.reduce(acc, *(data_t*)in);
+          acc = ops.reduce(acc, *(load_t*)in);
           in += stride;
         }
       }, {begin, end});
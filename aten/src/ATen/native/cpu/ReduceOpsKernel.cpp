@@ -2,6 +2,7 @@
 #include <iterator>
 #include <algorithm>
 
+#include <ATen/AccumulateType.h>
 #include <ATen/Dispatch.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/ReduceOps.h>
@@ -14,7 +15,57 @@ namespace at { namespace native { namespace {
 
 using namespace vec256;
 
+// Reduce ops that read scalar_t from the input, accumulate in acc_t, and
+// store out_t; see Note [Widened accumulation for CPU reductions] in
+// ReduceOps.cpp.
+template <typename scalar_t, typename acc_t, typename out_t = acc_t>
+struct CastSumOps {
+  inline acc_t reduce(acc_t a, scalar_t b) const {
+    return a + static_cast<acc_t>(b);
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a + b;
+  }
+  inline out_t project(acc_t a) const {
+    return static_cast<out_t>(a);
+  }
+};
+
+template <typename scalar_t, typename acc_t, typename out_t = acc_t>
+struct CastProdOps {
+  inline acc_t reduce(acc_t a, scalar_t b) const {
+    return a * static_cast<acc_t>(b);
+  }
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a * b;
+  }
+  inline out_t project(acc_t a) const {
+    return static_cast<out_t>(a);
+  }
+};
+
 static void sum_kernel_impl(TensorIterator& iter) {
+  // See Note [Widened accumulation for CPU reductions] in ReduceOps.cpp
+  if (iter.dtype(1) == kHalf) {
+    using acc_t = at::acc_type<Half, false>;
+    if (iter.dtype() == kHalf) {
+      binary_kernel_reduce(iter, CastSumOps<Half, acc_t, Half>(), acc_t(0));
+    } else {
+      AT_ASSERT(iter.dtype() == kFloat);
+      binary_kernel_reduce(iter, CastSumOps<Half, acc_t>(), acc_t(0));
+    }
+    return;
+  }
+  if (iter.dtype(1) != iter.dtype()) {
+    // integral input accumulating straight into int64 registers, without a
+    // materialized upcast of the input
+    AT_ASSERT(iter.dtype() == kLong);
+    AT_DISPATCH_INTEGRAL_TYPES(iter.dtype(1), "sum_cpu", [&] {
+      using acc_t = at::acc_type<scalar_t, false>;
+      binary_kernel_reduce(iter, CastSumOps<scalar_t, acc_t>(), acc_t(0));
+    });
+    return;
+  }
   AT_DISPATCH_ALL_TYPES(iter.dtype(), "sum_cpu", [&] {
     binary_kernel_reduce_vec(
       iter,
@@ -45,6 +96,25 @@ static void std_var_kernel_impl(TensorIterator &iter, bool unbiased, bool take_s
 }
 
 static void prod_kernel_impl(TensorIterator& iter) {
+  // See Note [Widened accumulation for CPU reductions] in ReduceOps.cpp
+  if (iter.dtype(1) == kHalf) {
+    using acc_t = at::acc_type<Half, false>;
+    if (iter.dtype() == kHalf) {
+      binary_kernel_reduce(iter, CastProdOps<Half, acc_t, Half>(), acc_t(1));
+    } else {
+      AT_ASSERT(iter.dtype() == kFloat);
+      binary_kernel_reduce(iter, CastProdOps<Half, acc_t>(), acc_t(1));
+    }
+    return;
+  }
+  if (iter.dtype(1) != iter.dtype()) {
+    AT_ASSERT(iter.dtype() == kLong);
+    AT_DISPATCH_INTEGRAL_TYPES(iter.dtype(1), "prod_cpu", [&] {
+      using acc_t = at::acc_type<scalar_t, false>;
+      binary_kernel_reduce(iter, CastProdOps<scalar_t, acc_t>(), acc_t(1));
+    });
+    return;
+  }
   AT_DISPATCH_ALL_TYPES(iter.dtype(), "prod_cpu", [&] {
     binary_kernel_reduce_vec(
       iter,
@@ -0,0 +1,126 @@
+#include <ATen/native/cpu/RowwiseNormKernel.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace at { namespace native { namespace {
+
+// Chan's update: folds the aggregate (n_b, mean_b, m2_b) into
+// (n_a, mean_a, m2_a).
+template <typename scalar_t>
+inline void welford_combine(
+    scalar_t& n_a,
+    scalar_t& mean_a,
+    scalar_t& m2_a,
+    scalar_t n_b,
+    scalar_t mean_b,
+    scalar_t m2_b) {
+  if (n_b == scalar_t(0)) {
+    return;
+  }
+  const scalar_t n = n_a + n_b;
+  const scalar_t delta = mean_b - mean_a;
+  mean_a = mean_a + delta * (n_b / n);
+  m2_a = m2_a + m2_b + delta * delta * (n_a * n_b / n);
+  n_a = n;
+}
+
+// Row statistics via Welford accumulation carried in Vec256 lanes: each
+// lane runs an independent Welford recurrence over every size()-th
+// element, the lane aggregates are merged with Chan's formula, and the
+// normalize-scale-shift is applied in a second pass while the row is
+// still in cache. For the short rows this kernel targets (hundreds of
+// elements) this beats the generic mean/var reductions, whose per-row
+// TensorIterator setup costs more than the arithmetic.
+static void rowwise_norm_kernel(
+    Tensor& out,
+    const Tensor& self,
+    int64_t M,
+    int64_t N,
+    const Tensor& weight,
+    const Tensor& bias,
+    double eps) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "rowwise_norm_cpu", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    const scalar_t* self_data = self.data<scalar_t>();
+    const scalar_t* weight_data =
+        weight.defined() ? weight.data<scalar_t>() : nullptr;
+    const scalar_t* bias_data =
+        bias.defined() ? bias.data<scalar_t>() : nullptr;
+    scalar_t* out_data = out.data<scalar_t>();
+    const int64_t grain =
+        std::max(int64_t(1), internal::GRAIN_SIZE / std::max(int64_t(1), N));
+    at::parallel_for(0, M, grain, [&](int64_t row_begin, int64_t row_end) {
+      for (int64_t row = row_begin; row < row_end; row++) {
+        const scalar_t* x = self_data + row * N;
+        scalar_t* y = out_data + row * N;
+
+        Vec vmean(scalar_t(0));
+        Vec vm2(scalar_t(0));
+        int64_t i = 0;
+        int64_t steps = 0;
+        for (; i + Vec::size() <= N; i += Vec::size()) {
+          steps++;
+          auto v = Vec::loadu(x + i);
+          auto delta = v - vmean;
+          vmean = vmean + delta * Vec(scalar_t(1) / steps);
+          vm2 = vm2 + delta * (v - vmean);
+        }
+
+        scalar_t count = 0;
+        scalar_t mean = 0;
+        scalar_t m2 = 0;
+        scalar_t mean_buf[Vec::size()];
+        scalar_t m2_buf[Vec::size()];
+        vmean.store(mean_buf);
+        vm2.store(m2_buf);
+        const scalar_t lane_count = static_cast<scalar_t>(steps);
+        for (int j = 0; j < Vec::size(); j++) {
+          welford_combine(count, mean, m2, lane_count, mean_buf[j], m2_buf[j]);
+        }
+        for (; i < N; i++) {
+          count += scalar_t(1);
+          const scalar_t delta = x[i] - mean;
+          mean += delta / count;
+          m2 += delta * (x[i] - mean);
+        }
+
+        const scalar_t rstd =
+            scalar_t(1) / std::sqrt(m2 / N + static_cast<scalar_t>(eps));
+        const Vec vrow_mean(mean);
+        const Vec vrstd(rstd);
+        i = 0;
+        for (; i + Vec::size() <= N; i += Vec::size()) {
+          auto v = (Vec::loadu(x + i) - vrow_mean) * vrstd;
+          if (weight_data != nullptr) {
+            v = v * Vec::loadu(weight_data + i);
+          }
+          if (bias_data != nullptr) {
+            v = v + Vec::loadu(bias_data + i);
+          }
+          v.store(y + i);
+        }
+        for (; i < N; i++) {
+          scalar_t v = (x[i] - mean) * rstd;
+          if (weight_data != nullptr) {
+            v *= weight_data[i];
+          }
+          if (bias_data != nullptr) {
+            v += bias_data[i];
+          }
+          y[i] = v;
+        }
+      }
+    });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(rowwise_norm_stub, &rowwise_norm_kernel);
+
+}} // namespace at::native
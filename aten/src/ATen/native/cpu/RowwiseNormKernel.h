@@ -0,0 +1,23 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// out = (self - mean) * rstd [* weight + bias] over M rows of N contiguous
+// elements, with the per-row statistics computed by Welford accumulation
+// and the normalize-scale-shift fused into the same kernel. weight/bias
+// are flat N-element tensors and may each be undefined.
+using rowwise_norm_fn = void (*)(
+    Tensor& out,
+    const Tensor& self,
+    int64_t M,
+    int64_t N,
+    const Tensor& weight,
+    const Tensor& bias,
+    double eps);
+
+DECLARE_DISPATCH(rowwise_norm_fn, rowwise_norm_stub);
+
+}} // namespace at::native
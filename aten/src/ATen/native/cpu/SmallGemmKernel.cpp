@@ -0,0 +1,64 @@
+#include <ATen/native/cpu/SmallGemmKernel.h>
+
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+
+namespace at { namespace native { namespace {
+
+// Register-blocked micro-kernel for tall-and-skinny products: m <= 8 output
+// rows against a pre-packed weight. For each 8-wide output panel it keeps
+// one accumulator register per row, broadcasts a single mat1 element, and
+// FMAs it against the packed panel row, so the weight is streamed exactly
+// once and all accumulation stays in registers.
+void small_gemm_kernel(
+    float* result,
+    const float* self,
+    int64_t self_row_stride,
+    const float* mat1,
+    int64_t mat1_row_stride,
+    const float* packed_b,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    float alpha,
+    float beta) {
+  using Vec = vec256::Vec256<float>;
+  static_assert(
+      Vec::size() == kSmallGemmPanel,
+      "packed panel width must match the float vector width");
+  AT_ASSERT(m >= 1 && m <= kSmallGemmMaxRows);
+
+  const int64_t panels = (n + kSmallGemmPanel - 1) / kSmallGemmPanel;
+  const Vec valpha(alpha);
+  const Vec vbeta(beta);
+  for (int64_t p = 0; p < panels; p++) {
+    const float* b_panel = packed_b + p * k * kSmallGemmPanel;
+    Vec acc[kSmallGemmMaxRows];
+    for (int64_t i = 0; i < m; i++) {
+      acc[i] = Vec(0.f);
+    }
+    for (int64_t kk = 0; kk < k; kk++) {
+      const Vec b = Vec::loadu(b_panel + kk * kSmallGemmPanel);
+      for (int64_t i = 0; i < m; i++) {
+        acc[i] = vec256::fmadd(Vec(mat1[i * mat1_row_stride + kk]), b, acc[i]);
+      }
+    }
+    const int64_t col = p * kSmallGemmPanel;
+    const int64_t count = std::min(kSmallGemmPanel, n - col);
+    for (int64_t i = 0; i < m; i++) {
+      Vec out = acc[i] * valpha;
+      if (beta != 0.f) {
+        const Vec s = Vec::loadu(self + i * self_row_stride + col, count);
+        out = vec256::fmadd(vbeta, s, out);
+      }
+      out.store(result + i * n + col, count);
+    }
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(small_gemm_stub, &small_gemm_kernel);
+
+}} // namespace at::native
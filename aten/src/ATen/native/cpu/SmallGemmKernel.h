@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Width of one packed weight panel, in floats. This is fixed (rather than
+// derived from the vector width of the kernel that happens to run) so that
+// the packed layout produced by the cache in SmallGemm.cpp is valid for
+// every CPU capability; it matches Vec256<float>::size() on all of them.
+constexpr int64_t kSmallGemmPanel = 8;
+
+// Largest number of output rows the register-blocked kernel handles; one
+// Vec256 accumulator is kept live per row.
+constexpr int64_t kSmallGemmMaxRows = 8;
+
+// result[m, n] = beta * self + alpha * (mat1 @ B), where B has been packed
+// into ceil(n / kSmallGemmPanel) panels of [k, kSmallGemmPanel] floats with
+// the trailing panel zero-padded. `result` is contiguous; `self` may be
+// nullptr when beta == 0, and a self_row_stride of 0 broadcasts a single
+// n-element row over all m output rows.
+using small_gemm_fn = void (*)(
+    float* result,
+    const float* self,
+    int64_t self_row_stride,
+    const float* mat1,
+    int64_t mat1_row_stride,
+    const float* packed_b,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    float alpha,
+    float beta);
+
+DECLARE_DISPATCH(small_gemm_fn, small_gemm_stub);
+
+}} // namespace at::native
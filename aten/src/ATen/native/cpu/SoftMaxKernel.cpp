@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <numeric>
 
 #include <ATen/Dispatch.h>
@@ -178,6 +179,181 @@ inline void _vec_host_softmax_backward_lastdim(
       });
 }
 
+// Fused softmax + cross entropy: the loss only needs, per row, the
+// log-sum-exp and the logit of the target class, so the softmax output is
+// never materialized. For a large vocabulary that halves the memory traffic
+// of the separate log_softmax + nll passes.
+template <typename scalar_t>
+inline void _vec_softmax_cross_entropy_lastdim(
+    scalar_t* input_data_base,
+    int64_t* target_data,
+    scalar_t* loss_data,
+    int64_t outer_size,
+    int64_t dim_size) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  parallel_for(
+      0,
+      outer_size,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          scalar_t* input_data = input_data_base + i * dim_size;
+          scalar_t max_input = vec256::reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+              input_data,
+              dim_size);
+          scalar_t tmp_sum = vec256::map_reduce_all<scalar_t>(
+              [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+              [](Vec x, Vec y) { return x + y; },
+              input_data,
+              dim_size);
+          // See [Note AVX-SSE transitions] for why the log goes through
+          // Vec256 even for a single element.
+          scalar_t log_sum[Vec::size()];
+          Vec(tmp_sum).log().store(log_sum);
+          loss_data[i] =
+              log_sum[0] + max_input - input_data[target_data[i]];
+        }
+      });
+}
+
+template <typename scalar_t>
+inline void _vec_softmax_cross_entropy_backward_lastdim(
+    scalar_t* grad_input_data_base,
+    scalar_t* grad_data,
+    scalar_t* input_data_base,
+    int64_t* target_data,
+    int64_t outer_size,
+    int64_t dim_size) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  parallel_for(
+      0,
+      outer_size,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          scalar_t* grad_input_data = grad_input_data_base + i * dim_size;
+          scalar_t* input_data = input_data_base + i * dim_size;
+          // d loss / d input_j = grad * (softmax_j - delta_{j == target}).
+          // The softmax is recomputed from the logits, which costs a second
+          // read of the row but avoids keeping a vocabulary-sized
+          // activation alive from the forward pass.
+          scalar_t max_input = vec256::reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+              input_data,
+              dim_size);
+          scalar_t tmp_sum = vec256::map_reduce_all<scalar_t>(
+              [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+              [](Vec x, Vec y) { return x + y; },
+              input_data,
+              dim_size);
+          scalar_t scale = grad_data[i] / tmp_sum;
+          vec256::map(
+              [max_input, scale](Vec x) {
+                return (x - Vec(max_input)).exp() * Vec(scale);
+              },
+              grad_input_data,
+              input_data,
+              dim_size);
+          grad_input_data[target_data[i]] -= grad_data[i];
+        }
+      });
+}
+
+// Padding-aware masked softmax. Attention masks overwhelmingly mask a
+// contiguous tail of each row (the padded key positions), so every row
+// is first scanned for that pattern: when it holds, the max / exp / sum
+// passes run over the valid prefix only and the tail is zero-filled,
+// skipping the padded work entirely instead of computing exp(-inf) over
+// it. Rows with masked holes in the middle blend the masked positions
+// to -inf into the output buffer and run the ordinary passes in place,
+// which still saves the separate full-tensor masked_fill. Masked
+// positions get weight exactly 0 either way.
+template <typename scalar_t>
+inline void _vec_masked_softmax_lastdim(
+    scalar_t* input_data_base,
+    uint8_t* mask_data_base,
+    scalar_t* output_data_base,
+    int64_t outer_size,
+    int64_t dim_size) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  parallel_for(
+      0,
+      outer_size,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          scalar_t* input_data = input_data_base + i * dim_size;
+          uint8_t* mask_data = mask_data_base + i * dim_size;
+          scalar_t* output_data = output_data_base + i * dim_size;
+
+          int64_t valid_len = dim_size;
+          while (valid_len > 0 && mask_data[valid_len - 1]) {
+            valid_len--;
+          }
+          if (valid_len == 0) {
+            // Fully masked row: the masked_fill(-inf) idiom yields NaNs
+            // here; all-zero weights are the useful answer for a fully
+            // padded row.
+            for (int64_t d = 0; d < dim_size; d++)
+              output_data[d] = 0;
+            continue;
+          }
+          bool prefix_only = true;
+          for (int64_t d = 0; d < valid_len; d++) {
+            if (mask_data[d]) {
+              prefix_only = false;
+              break;
+            }
+          }
+
+          if (!prefix_only) {
+            // exp(-inf - max) is exactly 0, so the blended row needs no
+            // further special-casing; this also keeps exp() inside
+            // Vec256, see [Note AVX-SSE transitions].
+            for (int64_t d = 0; d < dim_size; d++)
+              output_data[d] = mask_data[d]
+                  ? -std::numeric_limits<scalar_t>::infinity()
+                  : input_data[d];
+            input_data = output_data;
+            valid_len = dim_size;
+          }
+
+          scalar_t max_input = vec256::reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+              input_data,
+              valid_len);
+          vec256::map(
+              [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+              output_data,
+              input_data,
+              valid_len);
+          scalar_t tmp_sum = vec256::reduce_all<scalar_t>(
+              [](Vec x, Vec y) { return x + y; }, output_data, valid_len);
+          tmp_sum = 1 / tmp_sum;
+          vec256::map(
+              [tmp_sum](Vec x) { return x * Vec(tmp_sum); },
+              output_data,
+              output_data,
+              valid_len);
+          for (int64_t d = valid_len; d < dim_size; d++)
+            output_data[d] = 0;
+        }
+      });
+}
+
 template <typename scalar_t, bool LogSoftMax>
 struct vec_host_softmax_lastdim {
   static void apply(Tensor& output, const Tensor& input) {
@@ -254,9 +430,70 @@ static void log_softmax_backward_lastdim_kernel_impl(
       });
 }
 
+static void masked_softmax_lastdim_kernel_impl(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask) {
+  int64_t outer_size = self.numel() / self.size(-1);
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "masked_softmax_lastdim_kernel_impl", [&] {
+        _vec_masked_softmax_lastdim<scalar_t>(
+            self.data<scalar_t>(),
+            mask.data<uint8_t>(),
+            result.data<scalar_t>(),
+            outer_size,
+            self.size(-1));
+      });
+}
+
+static void softmax_cross_entropy_lastdim_kernel_impl(
+    Tensor& loss,
+    const Tensor& self,
+    const Tensor& target) {
+  int64_t outer_size = self.numel() / self.size(-1);
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "softmax_cross_entropy_lastdim_kernel_impl", [&] {
+        _vec_softmax_cross_entropy_lastdim<scalar_t>(
+            self.data<scalar_t>(),
+            target.data<int64_t>(),
+            loss.data<scalar_t>(),
+            outer_size,
+            self.size(-1));
+      });
+}
+
+static void softmax_cross_entropy_backward_lastdim_kernel_impl(
+    Tensor& grad_input,
+    const Tensor& grad,
+    const Tensor& self,
+    const Tensor& target) {
+  int64_t outer_size = self.numel() / self.size(-1);
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(),
+      "softmax_cross_entropy_backward_lastdim_kernel_impl",
+      [&] {
+        _vec_softmax_cross_entropy_backward_lastdim<scalar_t>(
+            grad_input.data<scalar_t>(),
+            grad.data<scalar_t>(),
+            self.data<scalar_t>(),
+            target.data<int64_t>(),
+            outer_size,
+            self.size(-1));
+      });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(softmax_lastdim_kernel, &softmax_lastdim_kernel_impl);
+REGISTER_DISPATCH(
+    masked_softmax_lastdim_kernel,
+    &masked_softmax_lastdim_kernel_impl);
+REGISTER_DISPATCH(
+    softmax_cross_entropy_lastdim_kernel,
+    &softmax_cross_entropy_lastdim_kernel_impl);
+REGISTER_DISPATCH(
+    softmax_cross_entropy_backward_lastdim_kernel,
+    &softmax_cross_entropy_backward_lastdim_kernel_impl);
 REGISTER_DISPATCH(log_softmax_lastdim_kernel, &log_softmax_lastdim_kernel_impl);
 REGISTER_DISPATCH(
     softmax_backward_lastdim_kernel,
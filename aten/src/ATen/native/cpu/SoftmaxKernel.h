@@ -8,11 +8,20 @@ namespace native {
 
 using forward_fn = void(*)(Tensor &, const Tensor &);
 using backward_fn = void(*)(Tensor &, const Tensor &, const Tensor&);
+using ce_forward_fn = void (*)(Tensor&, const Tensor&, const Tensor&);
+using ce_backward_fn =
+    void (*)(Tensor&, const Tensor&, const Tensor&, const Tensor&);
+using masked_forward_fn = void (*)(Tensor&, const Tensor&, const Tensor&);
 
 DECLARE_DISPATCH(forward_fn, softmax_lastdim_kernel);
+DECLARE_DISPATCH(masked_forward_fn, masked_softmax_lastdim_kernel);
 DECLARE_DISPATCH(forward_fn, log_softmax_lastdim_kernel);
 DECLARE_DISPATCH(backward_fn, softmax_backward_lastdim_kernel);
 DECLARE_DISPATCH(backward_fn, log_softmax_backward_lastdim_kernel);
+DECLARE_DISPATCH(ce_forward_fn, softmax_cross_entropy_lastdim_kernel);
+DECLARE_DISPATCH(
+    ce_backward_fn,
+    softmax_cross_entropy_backward_lastdim_kernel);
 
 }
 }
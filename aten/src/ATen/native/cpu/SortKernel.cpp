@@ -0,0 +1,319 @@
+#include <ATen/native/cpu/SortKernel.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+// Timsort-style threshold: only after one run has won this many elements
+// in a row does the merge switch to galloping (binary-search block copy).
+constexpr int kMinGallop = 7;
+
+// Rows at or below this length go straight to insertion sort; both the run
+// detector and std::stable_sort lose to it at these sizes.
+constexpr int64_t kSmallRowSort = 32;
+
+// "x sorts strictly before y" in ascending order. NaN ranks above every
+// number, matching quick_select_template in Sorting.cpp and numpy.
+template <typename scalar_t>
+inline bool lt_nan_last(scalar_t x, scalar_t y) {
+  return (_isnan<scalar_t>(y) && !_isnan<scalar_t>(x)) || (x < y);
+}
+
+template <typename scalar_t>
+inline bool gt_nan_first(scalar_t x, scalar_t y) {
+  return (_isnan<scalar_t>(x) && !_isnan<scalar_t>(y)) || (x > y);
+}
+
+template <typename scalar_t>
+struct AscendingComp {
+  bool operator()(scalar_t x, scalar_t y) const {
+    return lt_nan_last(x, y);
+  }
+};
+
+template <typename scalar_t>
+struct DescendingComp {
+  bool operator()(scalar_t x, scalar_t y) const {
+    return gt_nan_first(x, y);
+  }
+};
+
+// Stable insertion sort of vals/idxs[0, n).
+template <typename scalar_t, typename comp_t>
+void insertion_sort(
+    scalar_t* vals,
+    int64_t* idxs,
+    int64_t n,
+    const comp_t& lt) {
+  for (int64_t i = 1; i < n; ++i) {
+    const scalar_t v = vals[i];
+    const int64_t ix = idxs[i];
+    int64_t j = i;
+    for (; j > 0 && lt(v, vals[j - 1]); --j) {
+      vals[j] = vals[j - 1];
+      idxs[j] = idxs[j - 1];
+    }
+    vals[j] = v;
+    idxs[j] = ix;
+  }
+}
+
+// Merges the sorted runs vals/idxs[a_begin, a_end) and [b_begin, b_end)
+// into buf_v/buf_i starting at out. Ties go to the left run, keeping the
+// merge stable. After kMinGallop consecutive takes from one side the merge
+// gallops: an exponential-then-binary search finds how far that side keeps
+// winning and the whole span is copied at once, which is where
+// nearly-sorted inputs win.
+template <typename scalar_t, typename comp_t>
+void gallop_merge(
+    const scalar_t* vals,
+    const int64_t* idxs,
+    int64_t a_begin,
+    int64_t a_end,
+    int64_t b_begin,
+    int64_t b_end,
+    scalar_t* buf_v,
+    int64_t* buf_i,
+    int64_t out,
+    const comp_t& lt) {
+  int64_t a = a_begin;
+  int64_t b = b_begin;
+  int wins_a = 0;
+  int wins_b = 0;
+  while (a < a_end && b < b_end) {
+    if (lt(vals[b], vals[a])) {
+      buf_v[out] = vals[b];
+      buf_i[out] = idxs[b];
+      ++out;
+      ++b;
+      wins_a = 0;
+      if (++wins_b >= kMinGallop && b < b_end) {
+        // Copy every remaining right element that still sorts strictly
+        // before vals[a].
+        int64_t hi = b;
+        int64_t step = 1;
+        while (hi < b_end && lt(vals[hi], vals[a])) {
+          hi = std::min(b_end, hi + step);
+          step *= 2;
+        }
+        int64_t lo = std::max(b, hi - step / 2);
+        while (lo < hi) {
+          const int64_t mid = lo + (hi - lo) / 2;
+          if (lt(vals[mid], vals[a])) {
+            lo = mid + 1;
+          } else {
+            hi = mid;
+          }
+        }
+        for (; b < lo; ++b, ++out) {
+          buf_v[out] = vals[b];
+          buf_i[out] = idxs[b];
+        }
+        wins_b = 0;
+      }
+    } else {
+      buf_v[out] = vals[a];
+      buf_i[out] = idxs[a];
+      ++out;
+      ++a;
+      wins_b = 0;
+      if (++wins_a >= kMinGallop && a < a_end) {
+        // Copy every remaining left element not after vals[b] (ties stay
+        // left).
+        int64_t hi = a;
+        int64_t step = 1;
+        while (hi < a_end && !lt(vals[b], vals[hi])) {
+          hi = std::min(a_end, hi + step);
+          step *= 2;
+        }
+        int64_t lo = std::max(a, hi - step / 2);
+        while (lo < hi) {
+          const int64_t mid = lo + (hi - lo) / 2;
+          if (!lt(vals[b], vals[mid])) {
+            lo = mid + 1;
+          } else {
+            hi = mid;
+          }
+        }
+        for (; a < lo; ++a, ++out) {
+          buf_v[out] = vals[a];
+          buf_i[out] = idxs[a];
+        }
+        wins_a = 0;
+      }
+    }
+  }
+  for (; a < a_end; ++a, ++out) {
+    buf_v[out] = vals[a];
+    buf_i[out] = idxs[a];
+  }
+  for (; b < b_end; ++b, ++out) {
+    buf_v[out] = vals[b];
+    buf_i[out] = idxs[b];
+  }
+}
+
+// Sorts one contiguous row. `vals` already holds a copy of the input;
+// `idxs` is written here. `buf_v`/`buf_i` are scratch of length n, reused
+// across the rows a thread owns.
+template <typename scalar_t, typename comp_t>
+void sort_row(
+    scalar_t* vals,
+    int64_t* idxs,
+    scalar_t* buf_v,
+    int64_t* buf_i,
+    int64_t n,
+    const comp_t& lt,
+    bool allow_parallel_merge) {
+  for (int64_t i = 0; i < n; ++i) {
+    idxs[i] = i;
+  }
+  if (n <= kSmallRowSort) {
+    insertion_sort(vals, idxs, n, lt);
+    return;
+  }
+
+  // Detect the leading sorted run. Appending to an already sorted array is
+  // the case this kernel exists for, so the common outcomes are "the whole
+  // row" and "almost the whole row".
+  int64_t run = 1;
+  while (run < n && !lt(vals[run], vals[run - 1])) {
+    ++run;
+  }
+  if (run == n) {
+    return;
+  }
+
+  if (run >= n / 2) {
+    // Sort the short tail, then gallop-merge it with the sorted prefix:
+    // O(tail log tail + n) instead of O(n log n).
+    std::stable_sort(idxs + run, idxs + n, [&](int64_t a, int64_t b) {
+      return lt(vals[a], vals[b]);
+    });
+    for (int64_t i = run; i < n; ++i) {
+      buf_v[i] = vals[idxs[i]];
+    }
+    std::copy(buf_v + run, buf_v + n, vals + run);
+
+    if (allow_parallel_merge && n >= 2 * internal::GRAIN_SIZE) {
+      // Single long row: split both runs at a pivot so the two halves of
+      // the output can be merged independently. Everything left of a_mid
+      // and every tail element strictly before the pivot lands in the
+      // first half; ties keep going to the prefix, so the split preserves
+      // stability.
+      const int64_t a_mid = run / 2;
+      const scalar_t pivot = vals[a_mid];
+      int64_t lo = run;
+      int64_t hi = n;
+      while (lo < hi) {
+        const int64_t mid = lo + (hi - lo) / 2;
+        if (lt(vals[mid], pivot)) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      const int64_t b_mid = lo;
+      const int64_t out_mid = a_mid + (b_mid - run);
+      parallel_for(0, 2, 1, [&](int64_t part_begin, int64_t part_end) {
+        for (int64_t part = part_begin; part < part_end; ++part) {
+          if (part == 0) {
+            gallop_merge(
+                vals, idxs, int64_t(0), a_mid, run, b_mid, buf_v, buf_i,
+                int64_t(0), lt);
+          } else {
+            gallop_merge(
+                vals, idxs, a_mid, run, b_mid, n, buf_v, buf_i, out_mid,
+                lt);
+          }
+        }
+      });
+    } else {
+      gallop_merge(
+          vals, idxs, int64_t(0), run, run, n, buf_v, buf_i, int64_t(0),
+          lt);
+    }
+    std::copy(buf_v, buf_v + n, vals);
+    std::copy(buf_i, buf_i + n, idxs);
+    return;
+  }
+
+  // Not meaningfully presorted: full stable sort of the index array, then
+  // one permutation pass for the values.
+  std::copy(vals, vals + n, buf_v);
+  std::stable_sort(idxs, idxs + n, [&](int64_t a, int64_t b) {
+    return lt(buf_v[a], buf_v[b]);
+  });
+  for (int64_t i = 0; i < n; ++i) {
+    vals[i] = buf_v[idxs[i]];
+  }
+}
+
+template <typename scalar_t, typename comp_t>
+void sort_rows(
+    const scalar_t* self_data,
+    scalar_t* values_data,
+    int64_t* indices_data,
+    int64_t rows,
+    int64_t n,
+    const comp_t& lt) {
+  if (rows == 1) {
+    std::copy(self_data, self_data + n, values_data);
+    std::vector<scalar_t> buf_v(n);
+    std::vector<int64_t> buf_i(n);
+    sort_row(
+        values_data, indices_data, buf_v.data(), buf_i.data(), n, lt,
+        /*allow_parallel_merge=*/true);
+    return;
+  }
+  const int64_t grain = std::max(
+      int64_t(1), internal::GRAIN_SIZE / std::max(int64_t(1), n));
+  parallel_for(0, rows, grain, [&](int64_t row_begin, int64_t row_end) {
+    std::vector<scalar_t> buf_v(n);
+    std::vector<int64_t> buf_i(n);
+    for (int64_t row = row_begin; row < row_end; ++row) {
+      scalar_t* vals = values_data + row * n;
+      std::copy(self_data + row * n, self_data + (row + 1) * n, vals);
+      sort_row(
+          vals, indices_data + row * n, buf_v.data(), buf_i.data(), n, lt,
+          /*allow_parallel_merge=*/false);
+    }
+  });
+}
+
+static void adaptive_sort_kernel(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    bool descending) {
+  const int64_t n = self.size(self.dim() - 1);
+  const int64_t rows = self.numel() / n;
+  values.resize_(self.sizes());
+  indices.resize_(self.sizes());
+
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "adaptive_sort_cpu", [&] {
+    const scalar_t* self_data = self.data<scalar_t>();
+    scalar_t* values_data = values.data<scalar_t>();
+    int64_t* indices_data = indices.data<int64_t>();
+    if (descending) {
+      sort_rows(
+          self_data, values_data, indices_data, rows, n,
+          DescendingComp<scalar_t>());
+    } else {
+      sort_rows(
+          self_data, values_data, indices_data, rows, n,
+          AscendingComp<scalar_t>());
+    }
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(adaptive_sort_stub, &adaptive_sort_kernel);
+
+}} // namespace at::native
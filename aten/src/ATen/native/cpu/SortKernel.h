@@ -0,0 +1,16 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+using adaptive_sort_fn = void (*)(Tensor&, Tensor&, const Tensor&, bool);
+
+DECLARE_DISPATCH(adaptive_sort_fn, adaptive_sort_stub);
+
+// True when sort(self, dim) can be served by the adaptive CPU kernel: a
+// contiguous sort along the last dimension. Implemented in Sorting.cpp.
+CAFFE2_API bool can_use_adaptive_sort(const Tensor& self, int64_t dim);
+
+}} // namespace at::native
@@ -0,0 +1,136 @@
+#include <ATen/native/cpu/StreamCompactionKernel.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+
+#include <cstring>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+// Elements per counting/scatter chunk. Chunks are the unit of parallelism
+// and of the offset scan, so they are kept large enough that the serial
+// scan over chunk counts is negligible.
+constexpr int64_t kCompactionChunk = 32768;
+
+inline int64_t num_chunks(int64_t numel) {
+  return (numel + kCompactionChunk - 1) / kCompactionChunk;
+}
+
+// Counts selected elements per chunk, then turns the counts into exclusive
+// offsets. Returns the total. `is_selected` must be cheap: it is called once
+// per element in both passes. The count loop is branch-free so the
+// vectorizer can keep it at memory bandwidth.
+template <typename selected_t>
+int64_t count_and_scan(
+    int64_t numel,
+    std::vector<int64_t>& offsets,
+    const selected_t& is_selected) {
+  const int64_t chunks = num_chunks(numel);
+  offsets.assign(chunks + 1, 0);
+  at::parallel_for(0, chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      const int64_t start = chunk * kCompactionChunk;
+      const int64_t stop = std::min(start + kCompactionChunk, numel);
+      int64_t count = 0;
+      for (int64_t i = start; i < stop; i++) {
+        count += is_selected(i) ? 1 : 0;
+      }
+      offsets[chunk + 1] = count;
+    }
+  });
+  for (int64_t chunk = 0; chunk < chunks; chunk++) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+  return offsets[chunks];
+}
+
+void masked_select_compact_kernel(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask) {
+  const int64_t numel = self.numel();
+  const uint8_t* mask_data = mask.data<uint8_t>();
+
+  std::vector<int64_t> offsets;
+  const int64_t total = count_and_scan(
+      numel, offsets, [mask_data](int64_t i) { return mask_data[i] != 0; });
+  result.resize_({total});
+  if (total == 0) {
+    return;
+  }
+
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "masked_select_compact", [&] {
+    const scalar_t* self_data = self.data<scalar_t>();
+    scalar_t* result_data = result.data<scalar_t>();
+    at::parallel_for(0, num_chunks(numel), 1, [&](int64_t begin, int64_t end) {
+      // Branch-free compaction: always store, advance the cursor by the
+      // mask bit, so an unselected element's value is overwritten by the
+      // next hit. The dead store after a chunk's last hit would land one
+      // past its output slice - in the neighboring chunk's region - so
+      // compaction goes through a per-thread buffer with one slot of
+      // slack, and the counted prefix is copied out.
+      std::vector<scalar_t> local(kCompactionChunk + 1);
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        const int64_t start = chunk * kCompactionChunk;
+        const int64_t stop = std::min(start + kCompactionChunk, numel);
+        scalar_t* buffer = local.data();
+        int64_t out = 0;
+        for (int64_t i = start; i < stop; i++) {
+          buffer[out] = self_data[i];
+          out += mask_data[i] != 0 ? 1 : 0;
+        }
+        AT_ASSERT(out == offsets[chunk + 1] - offsets[chunk]);
+        std::memcpy(
+            result_data + offsets[chunk], buffer, out * sizeof(scalar_t));
+      }
+    });
+  });
+}
+
+void nonzero_compact_kernel(Tensor& result, const Tensor& self) {
+  const int64_t numel = self.numel();
+  const int64_t ndim = self.dim();
+
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "nonzero_compact", [&] {
+    const scalar_t* self_data = self.data<scalar_t>();
+
+    std::vector<int64_t> offsets;
+    const int64_t total = count_and_scan(
+        numel, offsets,
+        [self_data](int64_t i) { return self_data[i] != scalar_t(0); });
+    result.resize_({total, ndim});
+    if (total == 0) {
+      return;
+    }
+
+    const auto sizes = self.sizes();
+    int64_t* result_data = result.data<int64_t>();
+    at::parallel_for(0, num_chunks(numel), 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        const int64_t start = chunk * kCompactionChunk;
+        const int64_t stop = std::min(start + kCompactionChunk, numel);
+        int64_t* out = result_data + offsets[chunk] * ndim;
+        for (int64_t i = start; i < stop; i++) {
+          if (self_data[i] != scalar_t(0)) {
+            // unravel the flat index; hits are rare enough that the
+            // divisions stay off the scan's critical path
+            int64_t remainder = i;
+            for (int64_t d = ndim - 1; d >= 0; d--) {
+              out[d] = remainder % sizes[d];
+              remainder /= sizes[d];
+            }
+            out += ndim;
+          }
+        }
+      }
+    });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(masked_select_compact_stub, &masked_select_compact_kernel);
+REGISTER_DISPATCH(nonzero_compact_stub, &nonzero_compact_kernel);
+
+}} // namespace at::native
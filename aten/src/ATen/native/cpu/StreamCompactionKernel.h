@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Stream compaction kernels backing the fast paths for masked_select and
+// nonzero; see Note [Parallel stream compaction] in StreamCompaction.cpp.
+// Inputs are contiguous and CPU-resident; the kernels resize `result` to
+// the number of selected elements themselves, since only the counting pass
+// knows it.
+using masked_select_compact_fn =
+    void (*)(Tensor& result, const Tensor& self, const Tensor& mask);
+DECLARE_DISPATCH(masked_select_compact_fn, masked_select_compact_stub);
+
+using nonzero_compact_fn = void (*)(Tensor& result, const Tensor& self);
+DECLARE_DISPATCH(nonzero_compact_fn, nonzero_compact_stub);
+
+}} // namespace at::native
@@ -4,15 +4,119 @@
 #include <iterator>
 #include <algorithm>
 
+#include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/NumericUtils.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <c10/util/Optional.h>
 
 namespace at { namespace native { namespace {
 
 template <typename scalar_t, typename index_t>
 struct Reduction {
+  // Vectorized value+index reduction over one contiguous run. Each lane
+  // tracks its running best value and the block it came from, updated with
+  // a single blendv per load; the eight (or four) lane winners are resolved
+  // at the end. Tie and NaN behavior matches the scalar loop below: ties go
+  // to the larger index ("last wins", since the scalar loop only keeps the
+  // old value on a strict compare), and the first NaN freezes the result --
+  // per lane via the `best != best` mask, globally by picking the
+  // smallest-index NaN among the lane winners.
+  //
+  // Only enabled for float and double: smaller types have no precise lane
+  // representation for block numbers. Returns false to request the scalar
+  // fallback.
+  template <
+      typename T = scalar_t,
+      typename std::enable_if<
+          std::is_same<T, float>::value || std::is_same<T, double>::value,
+          int>::type = 0>
+  static bool reduce_contiguous(
+      const scalar_t* data,
+      int64_t n,
+      bool greater,
+      scalar_t* out_value,
+      index_t* out_index) {
+    using Vec = vec256::Vec256<scalar_t>;
+    constexpr int64_t W = Vec::size();
+    // Block numbers are tracked in scalar_t lanes; past 2^24 blocks a float
+    // lane can no longer hold them exactly.
+    if (n < 2 * W ||
+        (std::is_same<scalar_t, float>::value && n > (int64_t(1) << 24))) {
+      return false;
+    }
+    int64_t blocks = n / W;
+    Vec best = Vec::loadu(data);
+    Vec best_block((scalar_t)0);
+    for (int64_t b = 1; b < blocks; b++) {
+      Vec value = Vec::loadu(data + b * W);
+      Vec keep = greater ? (best > value) : (best < value);
+      Vec nan_mask = best != best;
+      Vec updated = Vec::blendv(value, best, keep);
+      Vec updated_block = Vec::blendv(Vec((scalar_t)b), best_block, keep);
+      best = Vec::blendv(updated, best, nan_mask);
+      best_block = Vec::blendv(updated_block, best_block, nan_mask);
+    }
+    __at_align32__ scalar_t values[W];
+    __at_align32__ scalar_t block_ids[W];
+    best.store(values);
+    best_block.store(block_ids);
+
+    scalar_t result = values[0];
+    index_t result_index = (index_t)block_ids[0] * W;
+    bool found_nan = _isnan<scalar_t>(result);
+    for (int64_t lane = 1; lane < W; lane++) {
+      scalar_t value = values[lane];
+      index_t index = (index_t)block_ids[lane] * W + lane;
+      if (_isnan<scalar_t>(value)) {
+        if (!found_nan || index < result_index) {
+          result = value;
+          result_index = index;
+          found_nan = true;
+        }
+        continue;
+      }
+      if (found_nan) {
+        continue;
+      }
+      bool cmp = greater ? (result > value) : (result < value);
+      if (!cmp && (value != result || index > result_index)) {
+        result = value;
+        result_index = index;
+      }
+    }
+    // Leftover elements have the largest indices, so the scalar rule applies
+    // to them sequentially, unless a NaN already froze the result.
+    if (!found_nan) {
+      for (int64_t k = blocks * W; k < n; k++) {
+        scalar_t value = data[k];
+        bool cmp = greater ? (result > value) : (result < value);
+        result = cmp ? result : value;
+        result_index = cmp ? result_index : k;
+        if (_isnan<scalar_t>(result)) {
+          break;
+        }
+      }
+    }
+    *out_value = result;
+    *out_index = result_index;
+    return true;
+  }
+
+  template <
+      typename T = scalar_t,
+      typename std::enable_if<
+          !(std::is_same<T, float>::value || std::is_same<T, double>::value),
+          int>::type = 0>
+  static bool reduce_contiguous(
+      const scalar_t*,
+      int64_t,
+      bool,
+      scalar_t*,
+      index_t*) {
+    return false;
+  }
   static void apply(
       Tensor& res,
       Tensor& res_indices,
@@ -38,6 +142,9 @@ struct Reduction {
       parallel_for(0, batch, 1, [=](int64_t begin, int64_t end) {
         for (int64_t b = begin; b < end; b++) {
           const scalar_t* data = &data_[b * n];
+          if (reduce_contiguous(data, n, greater, &out_[b], &indices_[b])) {
+            continue;
+          }
           scalar_t result = data[0];
           index_t result_index = 0;
           for (int64_t k = 0; k < n; k++) {
@@ -98,9 +205,136 @@ static void min_kernel_impl(
   });
 }
 
+// Predicated select over one contiguous run: out[i] = cond[i] ? a[i] : b[i].
+// The condition bytes are widened into value lanes and the select is a
+// single blendv per load, so no value-width boolean intermediate is ever
+// materialized. Only float and double take the vector path (matching
+// Reduction above); other types run the scalar loop.
+template <
+    typename scalar_t,
+    typename cond_t,
+    typename std::enable_if<
+        std::is_same<scalar_t, float>::value ||
+            std::is_same<scalar_t, double>::value,
+        int>::type = 0>
+void select_contiguous(
+    scalar_t* out,
+    const cond_t* cond,
+    const scalar_t* a,
+    const scalar_t* b,
+    int64_t n) {
+  using Vec = vec256::Vec256<scalar_t>;
+  constexpr int64_t W = Vec::size();
+  const Vec zero((scalar_t)0);
+  int64_t i = 0;
+  for (; i + W <= n; i += W) {
+    __at_align32__ scalar_t lanes[W];
+    for (int64_t j = 0; j < W; j++) {
+      lanes[j] = cond[i + j] ? (scalar_t)1 : (scalar_t)0;
+    }
+    Vec mask = Vec::loadu(lanes) != zero;
+    Vec result = Vec::blendv(Vec::loadu(b + i), Vec::loadu(a + i), mask);
+    result.store(out + i);
+  }
+  for (; i < n; i++) {
+    out[i] = cond[i] ? a[i] : b[i];
+  }
+}
+
+template <
+    typename scalar_t,
+    typename cond_t,
+    typename std::enable_if<
+        !(std::is_same<scalar_t, float>::value ||
+          std::is_same<scalar_t, double>::value),
+        int>::type = 0>
+void select_contiguous(
+    scalar_t* out,
+    const cond_t* cond,
+    const scalar_t* a,
+    const scalar_t* b,
+    int64_t n) {
+  for (int64_t i = 0; i < n; i++) {
+    out[i] = cond[i] ? a[i] : b[i];
+  }
+}
+
+template <typename scalar_t, typename cond_t>
+void where_contiguous(
+    Tensor& ret,
+    const Tensor& condition,
+    const Tensor& self,
+    const Tensor& other) {
+  scalar_t* out = ret.data<scalar_t>();
+  const cond_t* cond = condition.data<cond_t>();
+  const scalar_t* a = self.data<scalar_t>();
+  const scalar_t* b = other.data<scalar_t>();
+  parallel_for(
+      0, ret.numel(), internal::GRAIN_SIZE, [=](int64_t begin, int64_t end) {
+        select_contiguous(
+            out + begin, cond + begin, a + begin, b + begin, end - begin);
+      });
+}
+
+// Strided fallback; the condition dtype split mirrors the one in
+// where_kernel_impl below.
+template <typename scalar_t>
+void where_strided(
+    Tensor& ret,
+    const Tensor& condition,
+    const Tensor& self,
+    const Tensor& other) {
+  if (condition.scalar_type() == at::ScalarType::Byte) {
+    at::CPU_tensor_apply4<scalar_t, uint8_t, scalar_t, scalar_t>(
+        ret,
+        condition,
+        self,
+        other,
+        [](scalar_t& ret_val,
+           const uint8_t& cond_val,
+           const scalar_t& self_val,
+           const scalar_t& other_val) {
+          ret_val = cond_val ? self_val : other_val;
+        });
+  } else {
+    at::CPU_tensor_apply4<scalar_t, bool, scalar_t, scalar_t>(
+        ret,
+        condition,
+        self,
+        other,
+        [](scalar_t& ret_val,
+           const bool& cond_val,
+           const scalar_t& self_val,
+           const scalar_t& other_val) {
+          ret_val = cond_val ? self_val : other_val;
+        });
+  }
+}
+
+static void where_kernel_impl(
+    Tensor& ret,
+    const Tensor& condition,
+    const Tensor& self,
+    const Tensor& other) {
+  // The inputs arrive broadcast-expanded, which can introduce zero strides;
+  // the vectorized path requires plain contiguous layouts.
+  bool contiguous = ret.is_contiguous() && condition.is_contiguous() &&
+      self.is_contiguous() && other.is_contiguous();
+  AT_DISPATCH_ALL_TYPES(ret.scalar_type(), "where_cpu", [&] {
+    if (!contiguous) {
+      where_strided<scalar_t>(ret, condition, self, other);
+    } else if (condition.scalar_type() == at::ScalarType::Byte) {
+      where_contiguous<scalar_t, uint8_t>(ret, condition, self, other);
+    } else {
+      where_contiguous<scalar_t, bool>(ret, condition, self, other);
+    }
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(max_kernel, &max_kernel_impl);
 REGISTER_DISPATCH(min_kernel, &min_kernel_impl);
+REGISTER_DISPATCH(where_kernel, &where_kernel_impl);
 
 }} // namespace at::native
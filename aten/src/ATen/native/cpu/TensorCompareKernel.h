@@ -12,4 +12,9 @@ using reduce_fn =
 DECLARE_DISPATCH(reduce_fn, max_kernel);
 DECLARE_DISPATCH(reduce_fn, min_kernel);
 
+using where_fn =
+    void (*)(Tensor&, const Tensor&, const Tensor&, const Tensor&);
+
+DECLARE_DISPATCH(where_fn, where_kernel);
+
 }} // namespace at::native
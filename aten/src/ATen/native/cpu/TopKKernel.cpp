@@ -0,0 +1,215 @@
+#include <ATen/native/cpu/TopKKernel.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+template <typename scalar_t>
+struct Candidate {
+  scalar_t value;
+  int64_t index;
+};
+
+// Matches the ordering of quick_select_template in Sorting.cpp: NaN ranks
+// above every number, for numpy compatibility.
+template <typename scalar_t>
+inline bool gt_or_nan(scalar_t x, scalar_t y) {
+  return (_isnan<scalar_t>(x) && !_isnan<scalar_t>(y)) || (x > y);
+}
+
+// "x is a stronger result than y" for the requested direction.
+template <typename scalar_t>
+inline bool stronger(scalar_t x, scalar_t y, bool largest) {
+  return largest ? gt_or_nan(x, y) : gt_or_nan(y, x);
+}
+
+// Branch-free block prefilter: returns false only if no element of the
+// block can beat the current cutoff, letting the scan skip the block
+// wholesale. The generic version always scans; the float version tests a
+// whole vector per compare, which is where almost all of the time goes for
+// large score vectors whose cutoff stabilizes early.
+template <typename scalar_t>
+inline bool block_may_contain(
+    const scalar_t* /*data*/,
+    int64_t /*n*/,
+    scalar_t /*thresh*/,
+    bool /*largest*/) {
+  return true;
+}
+
+template <>
+inline bool block_may_contain<float>(
+    const float* data,
+    int64_t n,
+    float thresh,
+    bool largest) {
+  using Vec = vec256::Vec256<float>;
+  const Vec vthresh(thresh);
+  Vec acc(0.f);
+  int64_t d = 0;
+  for (; d + Vec::size() <= n; d += Vec::size()) {
+    const Vec v = Vec::loadu(data + d);
+    // NaN compares false against the cutoff but ranks above everything,
+    // so it must count as a candidate in the largest direction.
+    acc = acc | (largest ? ((v > vthresh) | (v != v)) : (v < vthresh));
+  }
+  float buf[Vec::size()];
+  acc.store(buf);
+  for (int j = 0; j < Vec::size(); ++j) {
+    // Comparison lanes are all-ones (NaN as float) or all-zeros.
+    if (buf[j] != 0.f) {
+      return true;
+    }
+  }
+  for (; d < n; ++d) {
+    if (stronger(data[d], thresh, largest)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Appends the top-k candidates of data[begin, end) to `heap`, which must
+// start out empty. The heap keeps its weakest kept candidate at the front,
+// so in steady state an element costs one compare against the cutoff.
+template <typename scalar_t>
+void select_range(
+    const scalar_t* data,
+    int64_t begin,
+    int64_t end,
+    int64_t k,
+    bool largest,
+    std::vector<Candidate<scalar_t>>& heap) {
+  const auto comp = [largest](
+      const Candidate<scalar_t>& a, const Candidate<scalar_t>& b) {
+    return stronger(a.value, b.value, largest);
+  };
+
+  int64_t i = begin;
+  for (; i < end && static_cast<int64_t>(heap.size()) < k; ++i) {
+    heap.push_back({data[i], i});
+    std::push_heap(heap.begin(), heap.end(), comp);
+  }
+  if (static_cast<int64_t>(heap.size()) < k) {
+    return;
+  }
+
+  constexpr int64_t kScanBlock = 128;
+  scalar_t thresh = heap.front().value;
+  while (i < end) {
+    const int64_t block_end = std::min(end, i + kScanBlock);
+    if (!block_may_contain(data + i, block_end - i, thresh, largest)) {
+      i = block_end;
+      continue;
+    }
+    for (; i < block_end; ++i) {
+      const scalar_t v = data[i];
+      if (stronger(v, thresh, largest)) {
+        std::pop_heap(heap.begin(), heap.end(), comp);
+        heap.back() = {v, i};
+        std::push_heap(heap.begin(), heap.end(), comp);
+        thresh = heap.front().value;
+      }
+    }
+  }
+}
+
+// Sorts the candidates (strongest first, ties by lower index) and writes
+// the first k to the output row.
+template <typename scalar_t>
+void emit_row(
+    std::vector<Candidate<scalar_t>>& candidates,
+    int64_t k,
+    bool largest,
+    scalar_t* values_out,
+    int64_t* indices_out) {
+  const auto before = [largest](
+      const Candidate<scalar_t>& a, const Candidate<scalar_t>& b) {
+    if (stronger(a.value, b.value, largest)) {
+      return true;
+    }
+    if (stronger(b.value, a.value, largest)) {
+      return false;
+    }
+    return a.index < b.index;
+  };
+  std::partial_sort(
+      candidates.begin(), candidates.begin() + k, candidates.end(), before);
+  for (int64_t j = 0; j < k; ++j) {
+    values_out[j] = candidates[j].value;
+    indices_out[j] = candidates[j].index;
+  }
+}
+
+static void topk_small_k_kernel(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t k,
+    bool largest,
+    bool sorted) {
+  const int64_t n = self.size(self.dim() - 1);
+  const int64_t rows = self.numel() / n;
+
+  auto result_sizes = self.sizes().vec();
+  result_sizes[self.dim() - 1] = k;
+  values.resize_(result_sizes);
+  indices.resize_(result_sizes);
+  // The selection below always produces sorted rows, which satisfies both
+  // settings of `sorted`.
+  (void)sorted;
+
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "topk_small_k_cpu", [&] {
+    const scalar_t* self_data = self.data<scalar_t>();
+    scalar_t* values_data = values.data<scalar_t>();
+    int64_t* indices_data = indices.data<int64_t>();
+
+    if (rows > 1) {
+      // Batched case: one thread per group of rows.
+      at::parallel_for(0, rows, 1, [&](int64_t row_begin, int64_t row_end) {
+        std::vector<Candidate<scalar_t>> heap;
+        heap.reserve(k);
+        for (int64_t row = row_begin; row < row_end; ++row) {
+          heap.clear();
+          select_range(self_data + row * n, 0, n, k, largest, heap);
+          emit_row(heap, k, largest, values_data + row * k,
+                   indices_data + row * k);
+        }
+      });
+    } else {
+      // Single long row: split it across threads, each selecting its own
+      // candidates, then merge. The union always holds at least k entries
+      // because every chunk of at least k elements contributes k.
+      const int64_t chunk =
+          std::max<int64_t>(at::internal::GRAIN_SIZE, k * 4);
+      const int64_t nchunks = (n + chunk - 1) / chunk;
+      std::vector<std::vector<Candidate<scalar_t>>> parts(nchunks);
+      at::parallel_for(0, nchunks, 1, [&](int64_t c_begin, int64_t c_end) {
+        for (int64_t c = c_begin; c < c_end; ++c) {
+          parts[c].reserve(k);
+          select_range(
+              self_data, c * chunk, std::min(n, (c + 1) * chunk), k, largest,
+              parts[c]);
+        }
+      });
+      std::vector<Candidate<scalar_t>> merged;
+      merged.reserve(nchunks * k);
+      for (auto& part : parts) {
+        merged.insert(merged.end(), part.begin(), part.end());
+      }
+      emit_row(merged, k, largest, values_data, indices_data);
+    }
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(topk_small_k_stub, &topk_small_k_kernel);
+
+}} // namespace at::native
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+using topk_small_k_fn =
+    void (*)(Tensor&, Tensor&, const Tensor&, int64_t, bool, bool);
+
+DECLARE_DISPATCH(topk_small_k_fn, topk_small_k_stub);
+
+// Largest k served by the selection kernel; beyond this the per-thread
+// candidate heap stops fitting comfortably in cache and the legacy sort
+// path wins.
+constexpr int64_t kMaxSmallTopK = 256;
+
+// True when topk(self, k, dim) can be served by the small-k CPU kernel:
+// a contiguous reduction over the last dimension with a small k.
+// Implemented in Sorting.cpp.
+CAFFE2_API bool can_use_small_k_topk(
+    const Tensor& self,
+    int64_t k,
+    int64_t dim);
+
+}} // namespace at::native
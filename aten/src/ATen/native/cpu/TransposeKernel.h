@@ -0,0 +1,16 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// Materializes a transposed (or batch-transposed) `src` into the
+// contiguous `self`; see the transpose special case in Copy.cpp.
+using transpose_copy_fn = void (*)(Tensor&, const Tensor&);
+
+DECLARE_DISPATCH(transpose_copy_fn, transpose_copy_kernel);
+
+} // namespace native
+} // namespace at
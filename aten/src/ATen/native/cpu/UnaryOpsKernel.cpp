@@ -17,6 +17,9 @@
 
 #include <ATen/native/cpu/Loops.h>
 
+#include <ATen/core/fast_math_mode.h>
+#include <ATen/native/cpu/FastMath.h>
+
 
 #if AT_MKL_ENABLED()
 #include <mkl.h>
@@ -30,7 +33,17 @@ namespace {
 
 using namespace vec256;
 
+// See Note [Fast math tier] in ATen/core/fast_math_mode.h. The fast
+// variants only exist for float; double keeps full precision.
+static bool use_fast_math(TensorIterator& iter) {
+  return FastMathMode::is_enabled() && iter.dtype() == kFloat;
+}
+
 static void sigmoid_kernel(TensorIterator& iter) {
+  if (use_fast_math(iter)) {
+    unary_kernel(iter, [](float a) { return fastmath::fast_sigmoidf(a); });
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "sigmoid_cpu", [&]() {
     unary_kernel_vec(
         iter,
@@ -152,8 +165,8 @@ static void rsqrt_kernel(TensorIterator& iter) {
 
 // TODO: Disable cont. branch to test more risky code
 
-#define IMPLEMENT_FLOAT_KERNEL(dispatchtypes, op)                             \
-  static void op##_kernel(TensorIterator& iter) {                             \
+#define IMPLEMENT_VML_BODY(op)                                                \
+  static void op##_vml_kernel(TensorIterator& iter) {                         \
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), op##_vml_cpu, [&]() {            \
       iter.serial_for_each(                                                   \
           [&](int ntensor, char** data_, const int64_t* strides, int64_t n) { \
@@ -180,6 +193,23 @@ static void rsqrt_kernel(TensorIterator& iter) {
           },                                                                  \
           {0, iter.numel()});                                                 \
     });                                                                       \
+  }
+
+#define IMPLEMENT_FLOAT_KERNEL(dispatchtypes, op)                             \
+  IMPLEMENT_VML_BODY(op)                                                      \
+  REGISTER_DISPATCH(op##_stub, &op##_vml_kernel)
+
+// Ops with a reduced-accuracy float variant consult the fast math tier
+// before falling back to the full-precision VML path; see Note
+// [Fast math tier] in ATen/core/fast_math_mode.h.
+#define IMPLEMENT_FLOAT_KERNEL_WITH_FAST(dispatchtypes, op, fastfn)           \
+  IMPLEMENT_VML_BODY(op)                                                      \
+  static void op##_kernel(TensorIterator& iter) {                             \
+    if (use_fast_math(iter)) {                                                \
+      unary_kernel(iter, [](float a) { return fastmath::fastfn(a); });        \
+      return;                                                                 \
+    }                                                                         \
+    op##_vml_kernel(iter);                                                    \
   }                                                                           \
   REGISTER_DISPATCH(op##_stub, &op##_kernel)
 
@@ -202,7 +232,7 @@ IMPLEMENT_FLOAT_KERNEL(FLOATING, cos)
 // IMPLEMENT_FLOAT_KERNEL(FLOATING, cosh)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, erf)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, erfc)
-IMPLEMENT_FLOAT_KERNEL(FLOATING, exp)
+IMPLEMENT_FLOAT_KERNEL_WITH_FAST(FLOATING, exp, fast_expf)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, expm1)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, floor)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, log)
@@ -214,7 +244,7 @@ IMPLEMENT_FLOAT_KERNEL(FLOATING, sin)
 // IMPLEMENT_FLOAT_KERNEL(FLOATING, sinh)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, sqrt)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, tan)
-IMPLEMENT_FLOAT_KERNEL(FLOATING, tanh)
+IMPLEMENT_FLOAT_KERNEL_WITH_FAST(FLOATING, tanh, fast_tanhf)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, trunc)
 
 }} // namespace at::native
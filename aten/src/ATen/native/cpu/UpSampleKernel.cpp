@@ -0,0 +1,241 @@
+#include <ATen/native/cpu/UpSampleKernel.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/UpSample.h>
+
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+using namespace vec256;
+
+// Note [Separable upsampling on CPU]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// 2d interpolation separates into a horizontal and a vertical 1d pass,
+// and with NCHW data the width axis is the contiguous one. Each task
+// therefore owns whole output rows of one channel plane: the horizontal
+// pass interpolates the source rows that the output row needs into
+// stack buffers using the precomputed per-column tables (see
+// Note [Precomputed interpolation tables] in UpSample.h), and the
+// vertical pass blends those buffers with Vec256 using the per-row
+// weight broadcast across the lane. This touches each needed input row
+// once per output row instead of recomputing indices and weights per
+// output pixel, keeps every access contiguous, and parallelizes over
+// (channel, output row) pairs with no sharing between tasks.
+
+int64_t row_grain_size(int64_t output_width) {
+  return std::max(
+      static_cast<int64_t>(1), internal::GRAIN_SIZE / (4 * output_width));
+}
+
+template <typename scalar_t>
+void copy_planes(
+    scalar_t* odata,
+    const scalar_t* idata,
+    int64_t channels,
+    int64_t plane_size) {
+  parallel_for(0, channels, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; ++c) {
+      std::memcpy(
+          odata + c * plane_size,
+          idata + c * plane_size,
+          plane_size * sizeof(scalar_t));
+    }
+  });
+}
+
+template <typename scalar_t>
+void bilinear2d_frame(
+    scalar_t* odata,
+    const scalar_t* idata,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t channels,
+    bool align_corners) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t input_plane = input_height * input_width;
+  const int64_t output_plane = output_height * output_width;
+
+  if (input_height == output_height && input_width == output_width) {
+    copy_planes(odata, idata, channels, input_plane);
+    return;
+  }
+
+  const auto htable = linear_upsample_table<scalar_t>(
+      input_height, output_height, align_corners, input_width);
+  const auto wtable = linear_upsample_table<scalar_t>(
+      input_width, output_width, align_corners, 1);
+
+  parallel_for(
+      0,
+      channels * output_height,
+      row_grain_size(output_width),
+      [&](int64_t begin, int64_t end) {
+        std::vector<scalar_t> row0(output_width);
+        std::vector<scalar_t> row1(output_width);
+        for (int64_t index = begin; index < end; ++index) {
+          const int64_t c = index / output_height;
+          const int64_t h2 = index % output_height;
+          const scalar_t* plane = idata + c * input_plane;
+          const scalar_t* line0 = plane + htable.offset0[h2];
+          const scalar_t* line1 = plane + htable.offset1[h2];
+
+          for (int64_t w2 = 0; w2 < output_width; ++w2) {
+            const int64_t w0 = wtable.offset0[w2];
+            const int64_t w1 = wtable.offset1[w2];
+            const scalar_t lambda0 = wtable.lambda0[w2];
+            const scalar_t lambda1 = wtable.lambda1[w2];
+            row0[w2] = lambda0 * line0[w0] + lambda1 * line0[w1];
+            row1[w2] = lambda0 * line1[w0] + lambda1 * line1[w1];
+          }
+
+          scalar_t* out = odata + c * output_plane + h2 * output_width;
+          const scalar_t h0lambda = htable.lambda0[h2];
+          const scalar_t h1lambda = htable.lambda1[h2];
+          const Vec h0vec(h0lambda);
+          const Vec h1vec(h1lambda);
+          int64_t w2 = 0;
+          for (; w2 + Vec::size() <= output_width; w2 += Vec::size()) {
+            const Vec blended = fmadd(
+                Vec::loadu(row1.data() + w2),
+                h1vec,
+                Vec::loadu(row0.data() + w2) * h0vec);
+            blended.store(out + w2);
+          }
+          for (; w2 < output_width; ++w2) {
+            out[w2] = h0lambda * row0[w2] + h1lambda * row1[w2];
+          }
+        }
+      });
+}
+
+template <typename scalar_t>
+void bicubic2d_frame(
+    scalar_t* odata,
+    const scalar_t* idata,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t channels,
+    bool align_corners) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t input_plane = input_height * input_width;
+  const int64_t output_plane = output_height * output_width;
+
+  if (input_height == output_height && input_width == output_width) {
+    copy_planes(odata, idata, channels, input_plane);
+    return;
+  }
+
+  const auto htable = cubic_upsample_table<scalar_t>(
+      input_height, output_height, align_corners, input_width);
+  const auto wtable = cubic_upsample_table<scalar_t>(
+      input_width, output_width, align_corners, 1);
+
+  parallel_for(
+      0,
+      channels * output_height,
+      row_grain_size(output_width),
+      [&](int64_t begin, int64_t end) {
+        std::array<std::vector<scalar_t>, 4> rows;
+        for (auto& row : rows) {
+          row.resize(output_width);
+        }
+        for (int64_t index = begin; index < end; ++index) {
+          const int64_t c = index / output_height;
+          const int64_t h2 = index % output_height;
+          const scalar_t* plane = idata + c * input_plane;
+
+          for (int64_t tap = 0; tap < 4; ++tap) {
+            const scalar_t* line = plane + htable.offsets[tap][h2];
+            scalar_t* row = rows[tap].data();
+            for (int64_t w2 = 0; w2 < output_width; ++w2) {
+              row[w2] = line[wtable.offsets[0][w2]] * wtable.coeffs[0][w2] +
+                  line[wtable.offsets[1][w2]] * wtable.coeffs[1][w2] +
+                  line[wtable.offsets[2][w2]] * wtable.coeffs[2][w2] +
+                  line[wtable.offsets[3][w2]] * wtable.coeffs[3][w2];
+            }
+          }
+
+          scalar_t* out = odata + c * output_plane + h2 * output_width;
+          const Vec c0(htable.coeffs[0][h2]);
+          const Vec c1(htable.coeffs[1][h2]);
+          const Vec c2(htable.coeffs[2][h2]);
+          const Vec c3(htable.coeffs[3][h2]);
+          int64_t w2 = 0;
+          for (; w2 + Vec::size() <= output_width; w2 += Vec::size()) {
+            Vec blended = Vec::loadu(rows[0].data() + w2) * c0;
+            blended = fmadd(Vec::loadu(rows[1].data() + w2), c1, blended);
+            blended = fmadd(Vec::loadu(rows[2].data() + w2), c2, blended);
+            blended = fmadd(Vec::loadu(rows[3].data() + w2), c3, blended);
+            blended.store(out + w2);
+          }
+          for (; w2 < output_width; ++w2) {
+            out[w2] = rows[0][w2] * htable.coeffs[0][h2] +
+                rows[1][w2] * htable.coeffs[1][h2] +
+                rows[2][w2] * htable.coeffs[2][h2] +
+                rows[3][w2] * htable.coeffs[3][h2];
+          }
+        }
+      });
+}
+
+void upsample_bilinear2d_cpu_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    int64_t output_height,
+    int64_t output_width,
+    bool align_corners) {
+  AT_DISPATCH_FLOATING_TYPES(
+      input.scalar_type(), "upsample_bilinear2d_cpu_kernel_impl", [&] {
+        bilinear2d_frame<scalar_t>(
+            output.data<scalar_t>(),
+            input.data<scalar_t>(),
+            input.size(2),
+            input.size(3),
+            output_height,
+            output_width,
+            input.size(0) * input.size(1),
+            align_corners);
+      });
+}
+
+void upsample_bicubic2d_cpu_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    int64_t output_height,
+    int64_t output_width,
+    bool align_corners) {
+  AT_DISPATCH_FLOATING_TYPES(
+      input.scalar_type(), "upsample_bicubic2d_cpu_kernel_impl", [&] {
+        bicubic2d_frame<scalar_t>(
+            output.data<scalar_t>(),
+            input.data<scalar_t>(),
+            input.size(2),
+            input.size(3),
+            output_height,
+            output_width,
+            input.size(0) * input.size(1),
+            align_corners);
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(
+    upsample_bilinear2d_cpu_kernel,
+    &upsample_bilinear2d_cpu_kernel_impl);
+REGISTER_DISPATCH(
+    upsample_bicubic2d_cpu_kernel,
+    &upsample_bicubic2d_cpu_kernel_impl);
+
+} // namespace native
+} // namespace at
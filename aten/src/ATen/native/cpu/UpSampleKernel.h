@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Forward upsampling over contiguous NCHW data; `output` must already be
+// resized to (N, C, output_height, output_width). See
+// Note [Separable upsampling on CPU] in UpSampleKernel.cpp.
+using upsample_2d_fn = void (*)(
+    Tensor& output,
+    const Tensor& input,
+    int64_t output_height,
+    int64_t output_width,
+    bool align_corners);
+DECLARE_DISPATCH(upsample_2d_fn, upsample_bilinear2d_cpu_kernel);
+DECLARE_DISPATCH(upsample_2d_fn, upsample_bicubic2d_cpu_kernel);
+
+}}  // namespace at::native
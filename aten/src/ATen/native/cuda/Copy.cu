@@ -8,11 +8,127 @@
 #include <c10/cuda/CUDAStream.h>
 #include <ATen/native/Copy.h>
 
+#include <cstring>
+#include <memory>
+#include <mutex>
+
 namespace {
 
 using namespace at;
 using namespace at::cuda;
 
+// Note [Pinned staging ring]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// For pageable host memory, cudaMemcpyAsync degenerates to a synchronous
+// copy through the driver's internal staging buffer, which runs well below
+// pinned bandwidth. With PYTORCH_CUDA_STAGED_COPY=1, large pageable H2D
+// copies instead stream through a small per-device ring of pinned chunks:
+// the host-side memcpy into chunk i overlaps the in-flight async transfer
+// out of chunk i-1, so pageable sources approach pinned bandwidth without
+// the caller managing pinning. Each chunk carries an event recorded after
+// its transfer; a chunk is only refilled once that event has drained, and
+// a mutex serializes ring users per device. The pinned chunks live for the
+// lifetime of the process, like the caching allocators.
+constexpr size_t kStagingChunkBytes = 2 * 1024 * 1024;
+constexpr size_t kStagingChunks = 4;
+// Below this size a single staged pass cannot overlap anything; let the
+// driver handle it.
+constexpr size_t kStagedCopyMinBytes = 2 * kStagingChunkBytes;
+
+struct StagingRing {
+  std::mutex mutex;
+  void* chunks[kStagingChunks] = {nullptr};
+  CUDAEvent events[kStagingChunks];
+  bool initialized = false;
+  bool available = false;
+};
+
+StagingRing& stagingRing(DeviceIndex device) {
+  static std::once_flag once;
+  static std::unique_ptr<StagingRing[]> rings;
+  std::call_once(once, [] {
+    rings.reset(new StagingRing[c10::cuda::device_count()]);
+  });
+  return rings[device];
+}
+
+bool staged_copy_enabled() {
+  static const char* env = getenv("PYTORCH_CUDA_STAGED_COPY");
+  static const bool enabled = env != nullptr && env[0] != '0';
+  return enabled;
+}
+
+// Pinned (or otherwise registered) host memory already transfers at full
+// bandwidth asynchronously; staging it would only add a memcpy.
+bool is_pinned_ptr(const void* ptr) {
+  cudaPointerAttributes attr;
+  cudaError_t err = cudaPointerGetAttributes(&attr, ptr);
+  if (err == cudaErrorInvalidValue) {
+    // Plain pageable memory the driver has never seen.
+    cudaGetLastError();
+    return false;
+  }
+  AT_CUDA_CHECK(err);
+  return attr.memoryType == cudaMemoryTypeHost;
+}
+
+// Returns true if the copy was performed; false means the caller should
+// fall back to the plain cudaMemcpyAsync path. The copy is ordered on
+// `stream` but not synchronized here.
+bool staged_copy_from_cpu(
+    void* dst,
+    const void* src,
+    size_t nbytes,
+    CUDAStream stream) {
+  if (!staged_copy_enabled() || nbytes < kStagedCopyMinBytes ||
+      is_pinned_ptr(src)) {
+    return false;
+  }
+
+  StagingRing& ring = stagingRing(stream.device_index());
+  std::lock_guard<std::mutex> lock(ring.mutex);
+  if (!ring.initialized) {
+    ring.initialized = true;
+    ring.available = true;
+    for (size_t i = 0; i < kStagingChunks; ++i) {
+      cudaError_t err =
+          cudaHostAlloc(&ring.chunks[i], kStagingChunkBytes, cudaHostAllocDefault);
+      if (err != cudaSuccess) {
+        // Pinned memory is a scarce resource; if we cannot get the ring,
+        // silently keep using the plain path.
+        cudaGetLastError();
+        ring.available = false;
+        break;
+      }
+    }
+  }
+  if (!ring.available) {
+    return false;
+  }
+
+  size_t offset = 0;
+  size_t chunk_idx = 0;
+  while (offset < nbytes) {
+    const size_t n = std::min(kStagingChunkBytes, nbytes - offset);
+    const size_t slot = chunk_idx % kStagingChunks;
+    // Refilling the chunk must wait for its previous transfer to drain;
+    // with kStagingChunks in flight this only blocks when the host memcpy
+    // outruns the copy engine.
+    ring.events[slot].synchronize();
+    std::memcpy(ring.chunks[slot], static_cast<const char*>(src) + offset, n);
+    AT_CUDA_CHECK(cudaMemcpyAsync(
+        static_cast<char*>(dst) + offset,
+        ring.chunks[slot],
+        n,
+        cudaMemcpyHostToDevice,
+        stream));
+    ring.events[slot].record(stream);
+    offset += n;
+    ++chunk_idx;
+  }
+  return true;
+}
+
 // Copy operator for the pointwise apply kernel
 template <typename dst_T, typename src_T>
 struct CopyOp {
@@ -172,12 +288,17 @@ void copy_from_cpu(Tensor& dst, const Tensor& src) {
 
   CUDAStream stream = getCurrentCUDAStream();
 
-  AT_CUDA_CHECK(cudaMemcpyAsync(
-      dst_contig.data_ptr(),
-      src_contig.data_ptr(),
-      src.numel() * src.element_size(),
-      cudaMemcpyHostToDevice,
-      stream));
+  const size_t nbytes = src.numel() * src.element_size();
+  // See Note [Pinned staging ring].
+  if (!staged_copy_from_cpu(
+          dst_contig.data_ptr(), src_contig.data_ptr(), nbytes, stream)) {
+    AT_CUDA_CHECK(cudaMemcpyAsync(
+        dst_contig.data_ptr(),
+        src_contig.data_ptr(),
+        nbytes,
+        cudaMemcpyHostToDevice,
+        stream));
+  }
   AT_CUDA_CHECK(cudaStreamSynchronize(stream));
   AT_DISPATCH_ALL_TYPES_AND2(at::ScalarType::Half, at::ScalarType::Bool, src.scalar_type(), "copy_from_cpu", [&]() {
     copy_device_to_device<scalar_t, scalar_t>(dst, dst_contig);
@@ -5,6 +5,8 @@
 #include <ATen/native/utils/ParamsHash.h>
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <stdexcept>
@@ -329,10 +331,17 @@ public:
 
   int64_t workspace_size() const { return ws_size; }
 
+  // Serializes execution of this plan: setting the stream and work area
+  // mutates the shared cufftHandle, so two streams may not execute the same
+  // plan concurrently. Distinct plans execute in parallel; see
+  // Note [Sharded cuFFT plan cache].
+  std::mutex& exec_mutex() const { return exec_mutex_; }
+
 private:
   std::unique_ptr<cufftHandle, CuFFTHandleDeleter> plan_ptr;
   bool clone_input;
   int64_t ws_size;
+  mutable std::mutex exec_mutex_;
 };
 
 #if CUDA_VERSION < 10000
@@ -359,7 +368,7 @@ static_assert(CUFFT_DEFAULT_CACHE_SIZE >= 0 && CUFFT_DEFAULT_CACHE_SIZE <= CUFFT
 // used when the max_size is positive.
 class CuFFTParamsLRUCache {
 public:
-  using kv_t = typename std::pair<CuFFTParams, CuFFTConfig>;
+  using kv_t = typename std::pair<CuFFTParams, std::shared_ptr<const CuFFTConfig>>;
   using map_t = typename std::unordered_map<std::reference_wrapper<CuFFTParams>,
                                             typename std::list<kv_t>::iterator,
                                             ParamsHash<CuFFTParams>,
@@ -387,11 +396,12 @@ public:
 
   // If key is in this cache, return the cached config. Otherwise, emplace the
   // config in this cache using value_args and return it.
-  // Return const reference because CuFFTConfig shouldn't be tampered with once
-  // created.
+  // Configs are held by shared_ptr so a caller can release this cache's mutex
+  // before executing the plan: LRU eviction then destroys an in-flight plan
+  // only after its last user is done. See Note [Sharded cuFFT plan cache].
   // This is similar to c++ 17 try_emplace.
   template<typename K, class ...VArgs>
-  const CuFFTConfig &try_emplace_value(K&& key, VArgs&&... value_args) {
+  std::shared_ptr<const CuFFTConfig> try_emplace_value(K&& key, VArgs&&... value_args) {
     AT_ASSERT(_max_size > 0);
 
     map_kkv_iter_t map_it = _cache_map.find(key);
@@ -411,9 +421,9 @@ public:
     }
 
     // construct new plan at list front, then insert into _cache_map
-    _usage_list.emplace_front(std::piecewise_construct,
-                       std::forward_as_tuple(key),
-                       std::forward_as_tuple(value_args...));
+    _usage_list.emplace_front(
+        std::forward<K>(key),
+        std::make_shared<const CuFFTConfig>(std::forward<VArgs>(value_args)...));
     auto kv_it = _usage_list.begin();
     _cache_map.emplace(std::piecewise_construct,
                 std::forward_as_tuple(kv_it->first),
@@ -463,6 +473,97 @@ private:
   size_t _max_size;
 };
 
+// Note [Sharded cuFFT plan cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A single per-device cache mutex makes every FFT on the device rendezvous
+// at one lock, and (worse) executing the plan while holding it serializes
+// work that was issued on different streams. Workloads with many small
+// transforms (e.g. STFT-heavy audio pipelines) spend more time queueing on
+// that mutex than in cuFFT.
+//
+// The per-device cache is therefore split into CUFFT_CACHE_SHARDS
+// independent LRU shards selected by the params hash; lookups for distinct
+// plans take distinct locks. A lookup only copies out a shared_ptr, so the
+// shard lock is never held across plan execution, and eviction of a plan
+// another stream is still executing merely defers its destruction.
+// Execution itself serializes per plan on CuFFTConfig::exec_mutex(),
+// because cufftSetStream/cufftSetWorkArea mutate the shared handle - two
+// streams running *different* plans proceed fully in parallel, which is
+// the common case once each stream's working set is cached.
+constexpr size_t CUFFT_CACHE_SHARDS = 8;
+
+class CuFFTShardedPlanCache {
+public:
+  CuFFTShardedPlanCache() {
+    resize(CUFFT_DEFAULT_CACHE_SIZE);
+  }
+
+  // Movable for the same reason CuFFTParamsLRUCache is: the per-device
+  // vector of caches grows on first use. The shard mutexes are not moved.
+  CuFFTShardedPlanCache(CuFFTShardedPlanCache&& other) noexcept :
+    _max_size(other._max_size) {
+    for (size_t i = 0; i < CUFFT_CACHE_SHARDS; i++) {
+      shards_[i] = std::move(other.shards_[i]);
+    }
+  }
+
+  CuFFTShardedPlanCache& operator=(CuFFTShardedPlanCache&& other) noexcept {
+    for (size_t i = 0; i < CUFFT_CACHE_SHARDS; i++) {
+      shards_[i] = std::move(other.shards_[i]);
+    }
+    _max_size = other._max_size;
+    return *this;
+  }
+
+  // The shard responsible for params. Callers lock the shard's mutex around
+  // try_emplace_value and release it before executing the returned plan.
+  CuFFTParamsLRUCache& shard(const CuFFTParams& params) {
+    return shards_[ParamsHash<CuFFTParams>()(params) % CUFFT_CACHE_SHARDS];
+  }
+
+  // Unlocked read, mirroring the old single-cache fast path; callers
+  // re-check under the shard lock before inserting.
+  size_t max_size() const noexcept { return _max_size; }
+
+  void resize(int64_t new_size) {
+    // The budget is distributed evenly across shards, rounding down (but
+    // never below one plan per shard) so the total stays within new_size
+    // and, on CUDA < 10, within CUFFT_MAX_PLAN_NUM.
+    AT_CHECK(new_size >= 0,
+             "cuFFT plan cache size must be non-negative, but got ", new_size);
+    AT_CHECK(new_size <= CUFFT_MAX_PLAN_NUM,
+             "cuFFT plan cache size can not be larger than ", CUFFT_MAX_PLAN_NUM, ", but got ", new_size);
+    int64_t per_shard = new_size == 0
+        ? 0
+        : std::max<int64_t>(1, new_size / CUFFT_CACHE_SHARDS);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> guard(shard.mutex);
+      shard.resize(per_shard);
+    }
+    _max_size = static_cast<size_t>(new_size);
+  }
+
+  size_t size() {
+    size_t total = 0;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> guard(shard.mutex);
+      total += shard.size();
+    }
+    return total;
+  }
+
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> guard(shard.mutex);
+      shard.clear();
+    }
+  }
+
+private:
+  CuFFTParamsLRUCache shards_[CUFFT_CACHE_SHARDS];
+  size_t _max_size;
+};
+
 // Since ATen is separated into CPU build and CUDA build, we need a way to call
 // these functions only when CUDA is loaded. We use CUDA hooks for this purpose
 // (at cuda/detail/CUDAHooks.cpp), and call the hooked functions from the actual
@@ -0,0 +1,67 @@
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+
+namespace at { namespace native {
+
+// Residency hints for managed (unified) memory; see Note [Managed
+// memory mode] in c10/cuda/CUDACachingAllocator.cpp. The hints operate
+// on the tensor's whole storage -- residency is a property of the
+// allocation, not of a view -- and are silent no-ops unless
+// PYTORCH_CUDA_MANAGED_MEMORY=1, so hinted model code also runs
+// unchanged with the ordinary allocator.
+
+namespace {
+
+void storage_range(const Tensor& self, void*& ptr, size_t& nbytes) {
+  const auto& storage = self.storage();
+  ptr = storage.data();
+  nbytes = storage.size() * self.element_size();
+}
+
+} // namespace
+
+Tensor& managed_prefetch__cuda(Tensor& self) {
+  // Prefetch to the device the tensor lives on: the common case of
+  // streaming paged-out weights back in ahead of use.
+  void* ptr;
+  size_t nbytes;
+  storage_range(self, ptr, nbytes);
+  c10::cuda::CUDACachingAllocator::prefetchAsync(
+      ptr,
+      nbytes,
+      self.get_device(),
+      at::cuda::getCurrentCUDAStream(self.get_device()));
+  return self;
+}
+
+Tensor& managed_prefetch_to__cuda(Tensor& self, Device device) {
+  AT_CHECK(
+      device.is_cuda() || device.type() == DeviceType::CPU,
+      "_managed_prefetch_to_: expected a CUDA or CPU target device, got ",
+      device);
+  void* ptr;
+  size_t nbytes;
+  storage_range(self, ptr, nbytes);
+  // Prefetching to the CPU is the explicit-eviction hint: it frees
+  // device pages ahead of the driver's LRU having to reclaim them.
+  const int target = device.is_cuda()
+      ? (device.has_index() ? device.index() : self.get_device())
+      : -1;
+  c10::cuda::CUDACachingAllocator::prefetchAsync(
+      ptr,
+      nbytes,
+      target,
+      at::cuda::getCurrentCUDAStream(self.get_device()));
+  return self;
+}
+
+Tensor& managed_advise_read_mostly__cuda(Tensor& self, bool enable) {
+  void* ptr;
+  size_t nbytes;
+  storage_range(self, ptr, nbytes);
+  c10::cuda::CUDACachingAllocator::adviseReadMostly(ptr, nbytes, enable);
+  return self;
+}
+
+}} // namespace at::native
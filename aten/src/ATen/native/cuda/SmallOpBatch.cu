@@ -0,0 +1,201 @@
+#include <ATen/native/cuda/SmallOpBatch.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAStream.h>
+
+namespace at {
+namespace native {
+namespace smallop {
+
+namespace {
+
+// Note [Deferred small-op launches]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Control-flow-heavy graphs run long chains of elementwise ops on
+// KB-sized tensors, where the ~10us launch latency of one grid per op
+// through gpu_kernel exceeds the kernel time an order of magnitude. In
+// that regime the fix is to launch less, not compute faster: the calls
+// below record each op as a plain descriptor (opcode, pointers, numel,
+// alpha) into a per-thread batch and replay the whole batch with a
+// single kernel launch.
+//
+// The batch rides in the kernel's parameter space -- kMaxOps descriptors
+// fit comfortably under the 4KB argument limit -- so a flush is exactly
+// one launch with no staging copy. Adjacent ops in a chain depend on
+// each other, so the megakernel must order them; it runs as a single
+// block and places __syncthreads() between descriptors, which is a
+// device-wide barrier when there is only one block. One block is plenty
+// for the tensors this path accepts (<= kMaxNumel elements); anything
+// larger is better off with its own grid and is declined by enqueue().
+//
+// Batched ops are restricted to contiguous float tensors on the current
+// device with exactly matching element counts (no broadcasting, no type
+// promotion), because the descriptor carries nothing but raw pointers.
+// enqueue() flushes before declining an op so that the batch never
+// reorders with respect to ops that bypass it.
+
+constexpr int kMaxOps = 48;
+constexpr int kMaxNumel = 16384;
+constexpr int kThreads = 512;
+
+struct OpDesc {
+  int32_t op;
+  int32_t numel;
+  float* out;
+  const float* a;
+  const float* b;
+  float alpha;
+};
+
+// Passed to the kernel by value; sized to stay under the 4KB kernel
+// argument limit.
+struct OpBatch {
+  int32_t count;
+  OpDesc descs[kMaxOps];
+};
+static_assert(sizeof(OpBatch) <= 4000, "OpBatch must fit in kernel arguments");
+
+__global__ void small_op_megakernel(OpBatch batch) {
+  for (int32_t i = 0; i < batch.count; i++) {
+    const OpDesc d = batch.descs[i];
+    for (int32_t idx = threadIdx.x; idx < d.numel; idx += blockDim.x) {
+      const float a = d.a[idx];
+      float value;
+      switch (static_cast<BatchedOp>(d.op)) {
+        case BatchedOp::Copy:
+          value = a;
+          break;
+        case BatchedOp::Neg:
+          value = -a;
+          break;
+        case BatchedOp::Relu:
+          value = a > 0.0f ? a : 0.0f;
+          break;
+        case BatchedOp::Sigmoid:
+          value = 1.0f / (1.0f + ::expf(-a));
+          break;
+        case BatchedOp::Tanh:
+          value = ::tanhf(a);
+          break;
+        case BatchedOp::Exp:
+          value = ::expf(a);
+          break;
+        case BatchedOp::Add:
+          value = a + d.alpha * d.b[idx];
+          break;
+        case BatchedOp::Sub:
+          value = a - d.alpha * d.b[idx];
+          break;
+        case BatchedOp::Mul:
+          value = a * d.b[idx];
+          break;
+        case BatchedOp::Div:
+          value = a / d.b[idx];
+          break;
+      }
+      d.out[idx] = value;
+    }
+    // Single-block launch, so this orders descriptor i's writes before
+    // descriptor i+1's reads device-wide.
+    __syncthreads();
+  }
+}
+
+struct PendingBatch {
+  OpBatch batch{};
+  cudaStream_t stream = nullptr;
+  int64_t device = -1;
+};
+
+thread_local PendingBatch pending;
+thread_local bool enabled = false;
+
+bool is_batchable(const Tensor& t, int64_t device) {
+  return t.defined() && t.is_cuda() && !t.is_sparse() &&
+      t.scalar_type() == kFloat && t.is_contiguous() &&
+      t.get_device() == device;
+}
+
+bool op_is_binary(BatchedOp op) {
+  switch (op) {
+    case BatchedOp::Add:
+    case BatchedOp::Sub:
+    case BatchedOp::Mul:
+    case BatchedOp::Div:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+bool batched_launch_enabled() {
+  return enabled;
+}
+
+void set_batched_launch_enabled(bool e) {
+  enabled = e;
+}
+
+void flush() {
+  if (pending.batch.count == 0) {
+    return;
+  }
+  small_op_megakernel<<<1, kThreads, 0, pending.stream>>>(pending.batch);
+  AT_CUDA_CHECK(cudaGetLastError());
+  pending.batch.count = 0;
+  pending.stream = nullptr;
+  pending.device = -1;
+}
+
+bool enqueue(
+    BatchedOp op,
+    Tensor& out,
+    const Tensor& a,
+    const Tensor& b,
+    double alpha) {
+  if (!enabled) {
+    return false;
+  }
+  const int64_t device = c10::cuda::current_device();
+  const bool binary = op_is_binary(op);
+  bool ok = is_batchable(out, device) && is_batchable(a, device) &&
+      a.numel() == out.numel() && out.numel() <= kMaxNumel;
+  if (binary) {
+    ok = ok && is_batchable(b, device) && b.numel() == out.numel();
+  } else {
+    ok = ok && !b.defined();
+  }
+  if (!ok) {
+    // The declined op runs through the regular dispatch next; flush so
+    // it cannot observe stale batched outputs.
+    flush();
+    return false;
+  }
+
+  auto stream = at::cuda::getCurrentCUDAStream().stream();
+  if (pending.batch.count == kMaxOps ||
+      (pending.batch.count > 0 &&
+       (pending.stream != stream || pending.device != device))) {
+    flush();
+  }
+  if (pending.batch.count == 0) {
+    pending.stream = stream;
+    pending.device = device;
+  }
+
+  OpDesc& d = pending.batch.descs[pending.batch.count++];
+  d.op = static_cast<int32_t>(op);
+  d.numel = static_cast<int32_t>(out.numel());
+  d.out = out.data<float>();
+  d.a = a.data<float>();
+  d.b = binary ? b.data<float>() : nullptr;
+  d.alpha = static_cast<float>(alpha);
+  return true;
+}
+
+} // namespace smallop
+} // namespace native
+} // namespace at
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at {
+namespace native {
+namespace smallop {
+
+// Deferred small-op launches. See Note [Deferred small-op launches] in
+// SmallOpBatch.cu. An interpreter running a dispatch-bound region opts
+// in with a BatchedLaunchGuard, offers each elementwise op to enqueue(),
+// and falls back to the regular kernel when it returns false; the batch
+// is flushed as one packed kernel when it fills, when the stream or
+// device changes, when an op cannot be batched, and at guard exit. The
+// caller must flush() before any stream synchronization or any read of
+// a batched output outside the batch.
+enum class BatchedOp : int32_t {
+  Copy,
+  Neg,
+  Relu,
+  Sigmoid,
+  Tanh,
+  Exp,
+  Add, // out = a + alpha * b
+  Sub, // out = a - alpha * b
+  Mul,
+  Div,
+};
+
+CAFFE2_API bool batched_launch_enabled();
+CAFFE2_API void set_batched_launch_enabled(bool enabled);
+
+// Appends the op to the calling thread's pending batch. Returns false --
+// after flushing whatever is pending, so ordering is preserved -- when
+// batching is off or the operands do not qualify (see the note). For
+// unary ops, pass an undefined tensor as `b`.
+CAFFE2_API bool enqueue(
+    BatchedOp op,
+    Tensor& out,
+    const Tensor& a,
+    const Tensor& b = Tensor(),
+    double alpha = 1.0);
+
+// Launches the pending batch, if any, on the stream it was recorded for.
+CAFFE2_API void flush();
+
+// Scoped opt-in; flushes on exit.
+struct CAFFE2_API BatchedLaunchGuard {
+  BatchedLaunchGuard() : prev_(batched_launch_enabled()) {
+    set_batched_launch_enabled(true);
+  }
+  ~BatchedLaunchGuard() {
+    flush();
+    set_batched_launch_enabled(prev_);
+  }
+  BatchedLaunchGuard(const BatchedLaunchGuard&) = delete;
+  BatchedLaunchGuard& operator=(const BatchedLaunchGuard&) = delete;
+
+ private:
+  bool prev_;
+};
+
+} // namespace smallop
+} // namespace native
+} // namespace at
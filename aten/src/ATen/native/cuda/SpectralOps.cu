@@ -15,6 +15,8 @@
 #include <thrust/unique.h>
 #include <cufft.h>
 #include <cufftXt.h>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <cmath>
 
@@ -188,6 +190,11 @@ static inline Tensor _run_cufft(
   // set output
   auto output = at::empty(output_sizes, input.options());
 
+  // The stream and work area are set on the shared handle, so execution of
+  // one plan serializes even across streams; distinct plans run in
+  // parallel. See Note [Sharded cuFFT plan cache] in CuFFTPlanCache.h.
+  std::unique_lock<std::mutex> exec_lock(config.exec_mutex());
+
   // set to current stream
   CUFFT_CHECK(cufftSetStream(plan, at::cuda::getCurrentCUDAStream()));
 
@@ -235,6 +242,10 @@ static inline Tensor _run_cufft(
     inverse ? CUFFT_INVERSE : CUFFT_FORWARD));
 #endif
 
+  // The exec call is asynchronous but enqueued; the handle can be handed to
+  // the next stream now.
+  exec_lock.unlock();
+
   // rescale if needed by normalized flag or inverse transform
   auto size_last_signal_dim = checked_signal_sizes[signal_ndim - 1];
   if (normalized || inverse) {
@@ -261,12 +272,12 @@ static inline Tensor _run_cufft(
   return output;
 }
 
-// The cuFFT plan cache, defined in CuFFTUtils.h
-std::vector<optional<CuFFTParamsLRUCache>> plan_caches;
+// The cuFFT plan cache, defined in CuFFTPlanCache.h
+std::vector<optional<CuFFTShardedPlanCache>> plan_caches;
 std::mutex plan_caches_mutex;
 
 static inline
-CuFFTParamsLRUCache &cufft_get_plan_cache(int64_t device_index) {
+CuFFTShardedPlanCache &cufft_get_plan_cache(int64_t device_index) {
   std::lock_guard<std::mutex> guard(plan_caches_mutex);
 
   AT_ASSERT(device_index >= 0);
@@ -369,13 +380,22 @@ Tensor _fft_cufft(const Tensor& self, int64_t signal_ndim,
     CuFFTParams params;
     setCuFFTParams(&params, input, signal_ndim, complex_input,
       complex_output, checked_signal_sizes, onesided);
-    std::lock_guard<std::mutex> guard(plan_cache.mutex);
-    if (plan_cache.max_size() > 0) {  // check again after acquiring the lock
-      const CuFFTConfig &config = plan_cache.try_emplace_value(std::move(params),
-                                             input, signal_ndim, complex_input,
-                                             complex_output, checked_signal_sizes,
-                                             onesided, output_sizes);
-      return _run_cufft(config, input, signal_ndim, complex_input,
+    // Only the owning shard's lock is taken, and only around the lookup -
+    // the plan executes after it is released, so FFTs issued on different
+    // streams overlap. See Note [Sharded cuFFT plan cache].
+    auto& shard = plan_cache.shard(params);
+    std::shared_ptr<const CuFFTConfig> config;
+    {
+      std::lock_guard<std::mutex> guard(shard.mutex);
+      if (plan_cache.max_size() > 0) {  // check again after acquiring the lock
+        config = shard.try_emplace_value(std::move(params),
+                                         input, signal_ndim, complex_input,
+                                         complex_output, checked_signal_sizes,
+                                         onesided, output_sizes);
+      }
+    }
+    if (config) {
+      return _run_cufft(*config, input, signal_ndim, complex_input,
                         complex_output, inverse, checked_signal_sizes, normalized,
                         onesided, output_sizes, input_was_cloned);
     }
@@ -10,6 +10,10 @@
 #include <ATen/cuda/Exceptions.h>
 #include <c10/util/Exception.h>
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 #if !AT_CUDNN_ENABLED()
 
 namespace at { namespace native {
@@ -357,6 +361,84 @@ namespace {
     }
   };
 
+  // Note [Cached RNN descriptors]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // RNNDescriptors builds one TensorDescriptor per timestep, and the
+  // forward pass follows it with a cudnnGetRNNWorkspaceSize query; on
+  // short-sequence inference this descriptor churn is a double-digit
+  // percentage of the call. The geometry the descriptors encode is fully
+  // determined by the RNN configuration and the input shape, so the built
+  // descriptors (and the workspace size) are memoized here, keyed by the
+  // raw bytes of that configuration. The cache is thread-local because
+  // cuDNN handles are: descriptors are created against this thread's
+  // handle and are only ever used with it again. The dropout state
+  // pointer participates in the key, so a descriptor never outlives the
+  // (globally cached, per-device) state buffer it references.
+  struct CachedRNNPlan {
+    std::unique_ptr<RNNDescriptors> descs;
+    size_t workspace_size;
+  };
+
+  constexpr size_t kRNNPlanCacheMaxEntries = 64;
+
+  std::string rnn_plan_key(const RNNParams& fn, const Tensor& x) {
+    std::string key;
+    auto append_int = [&](int64_t v) {
+      key.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+    append_int(static_cast<int64_t>(fn.rnn.mode));
+    append_int(fn.rnn.hidden_size);
+    append_int(fn.rnn.num_layers);
+    append_int(static_cast<int64_t>(fn.rnn.bidirectional));
+    append_int(static_cast<int64_t>(fn.rnn.datatype));
+    append_int(static_cast<int64_t>(fn.rnn.input_datatype));
+    append_int(static_cast<int64_t>(fn.rnn.algo));
+    append_int(fn.dropout.train ? 1 : 0);
+    key.append(
+        reinterpret_cast<const char*>(&fn.dropout.dropout),
+        sizeof(fn.dropout.dropout));
+    append_int(reinterpret_cast<int64_t>(
+        fn.dropout.dropout_state.defined() ? fn.dropout.dropout_state.data_ptr()
+                                           : nullptr));
+    append_int(x.get_device());
+    for (auto s : x.sizes()) {
+      append_int(s);
+    }
+    for (auto s : x.strides()) {
+      append_int(s);
+    }
+    for (auto b : fn.tensors.batch_sizes) {
+      append_int(b);
+    }
+    return key;
+  }
+
+  // See Note [Cached RNN descriptors]
+  CachedRNNPlan& get_rnn_plan(
+      const RNNParams& fn, cudnnHandle_t handle, const Tensor& x,
+      const Tensor& y, const Tensor& hx, const Tensor& cx) {
+    static thread_local std::unordered_map<std::string, CachedRNNPlan> cache;
+    std::string key = rnn_plan_key(fn, x);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+    CachedRNNPlan plan;
+    plan.descs.reset(new RNNDescriptors(fn, handle, x, y, hx, cx));
+    auto x_descs_arr = plan.descs->get_x_descs();
+    AT_CUDNN_CHECK(cudnnGetRNNWorkspaceSize(
+        handle,
+        plan.descs->rnn_desc.desc(),
+        fn.tensors.seq_length,
+        x_descs_arr.data(),
+        &plan.workspace_size));
+    if (cache.size() >= kRNNPlanCacheMaxEntries) {
+      cache.clear();
+    }
+    auto r = cache.emplace(std::move(key), std::move(plan));
+    return r.first->second;
+  }
+
   int64_t get_num_weights(cudnnHandle_t handle, const RNNDescriptor& rnn_desc,
                           const TensorDescriptor& x_desc, cudnnDataType_t datatype) {
     size_t weight_size;
@@ -733,7 +815,9 @@ std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> _cudnn_rnn(
   auto handle = getCudnnHandle();
   cudnnRNNAlgo_t algo = get_algo(fn.rnn, fn.tensors, input);
   fn.rnn.set_algo(algo);
-  RNNDescriptors descs(fn, handle, x, y, hx, cx);
+  // See Note [Cached RNN descriptors]
+  auto& plan = get_rnn_plan(fn, handle, x, y, hx, cx);
+  RNNDescriptors& descs = *plan.descs;
 
   FilterDescriptor w_desc;
   if (!weight_buf.defined()) {
@@ -753,17 +837,12 @@ std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> _cudnn_rnn(
   AT_CHECK(!cx.defined() || cx.sizes().equals(hidden_size),
            "Expected cell size ", IntArrayRef{hidden_size}, ", got ", cx.sizes());
 
-  size_t workspace_size;
   auto x_descs_arr = descs.get_x_descs();
   auto y_descs_arr = descs.get_y_descs();
-  AT_CUDNN_CHECK(cudnnGetRNNWorkspaceSize(
-        handle,
-        descs.rnn_desc.desc(),
-        fn.tensors.seq_length,
-        x_descs_arr.data(),
-        &workspace_size
-        ));
-  Tensor workspace = at::empty(workspace_size, input.options().dtype(kByte));
+  // The workspace size was queried when the plan was built; the buffer
+  // itself comes from the caching allocator, so this is cheap per call.
+  Tensor workspace =
+      at::empty(plan.workspace_size, input.options().dtype(kByte));
 
   Tensor reserve;
   // NB: Previously, the test was for fn.requires_grad, but we don't have
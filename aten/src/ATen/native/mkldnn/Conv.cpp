@@ -36,10 +36,102 @@ std::tuple<at::Tensor,at::Tensor,at::Tensor> mkldnn_convolution_backward(
 
 #include <ATen/mkldnn/Runtime.h>
 
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 using namespace mkldnn;
 
 namespace at { namespace native {
 
+namespace {
+
+// Note [MKL-DNN weight prepack cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The convolution forward reorders the weight from oihw into MKL-DNN's
+// blocked layout on every call; with static inference weights that is the
+// same reorder of the same bytes over and over, and can account for a
+// large share of convolution time in small-batch serving.
+//
+// With PYTORCH_MKLDNN_PREPACK_WEIGHTS=1, the blocked weight is instead
+// cached keyed by the weight's data pointer, sizes and the convolution
+// parameters, so each filter is reordered once per process. The cache
+// reads the weight bytes at prepack time only: it is an inference-mode
+// switch, because an in-place weight update (an optimizer step) would not
+// be observed by the cached copy. Entries are dropped when the cache is
+// over capacity, oldest first; static serving weights settle once.
+
+bool prepack_weights_enabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("PYTORCH_MKLDNN_PREPACK_WEIGHTS");
+    return env != nullptr && env[0] == '1';
+  }();
+  return enabled;
+}
+
+std::string prepack_cache_key(
+    const at::Tensor& weight,
+    IntArrayRef padding,
+    IntArrayRef stride,
+    IntArrayRef dilation,
+    int64_t groups) {
+  std::string key;
+  auto append = [&key](const void* data, size_t nbytes) {
+    key.append(static_cast<const char*>(data), nbytes);
+  };
+  const void* data_ptr = weight.data_ptr();
+  append(&data_ptr, sizeof(data_ptr));
+  for (const auto size : weight.sizes()) {
+    append(&size, sizeof(size));
+  }
+  for (const auto p : padding) {
+    append(&p, sizeof(p));
+  }
+  for (const auto s : stride) {
+    append(&s, sizeof(s));
+  }
+  for (const auto d : dilation) {
+    append(&d, sizeof(d));
+  }
+  append(&groups, sizeof(groups));
+  return key;
+}
+
+constexpr size_t kPrepackCacheMaxEntries = 1024;
+
+memory prepacked_weight_memory(
+    const std::string& key,
+    const memory& weight_usr_memory,
+    const memory::primitive_desc& weight_pd) {
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, std::shared_ptr<memory>> cache;
+  static std::vector<std::string> insertion_order;
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    return *it->second;
+  }
+
+  auto packed = std::make_shared<memory>(weight_pd);
+  std::vector<primitive> reorder_net;
+  reorder_net.push_back(reorder(weight_usr_memory, *packed));
+  Stream::Instance().get_stream().submit(reorder_net);
+
+  if (cache.size() >= kPrepackCacheMaxEntries) {
+    cache.erase(insertion_order.front());
+    insertion_order.erase(insertion_order.begin());
+  }
+  cache.emplace(key, packed);
+  insertion_order.push_back(key);
+  return *packed;
+}
+
+} // namespace
+
 constexpr int input_batch_size_dim = 0;  // also grad_input
 constexpr int input_channels_dim = 1;
 constexpr int output_batch_size_dim = 0;  // also grad_output
@@ -146,8 +238,16 @@ at::Tensor mkldnn_convolution(
   auto weight_pd = conv_forward_pd->weights_primitive_desc();
   auto weight_memory = weight_usr_memory;
   if (weight_usr_memory.get_primitive_desc() != memory::primitive_desc(weight_pd)) {
-    weight_memory = memory(weight_pd);
-    net.push_back(reorder(weight_usr_memory, weight_memory));
+    if (prepack_weights_enabled()) {
+      // See Note [MKL-DNN weight prepack cache]
+      weight_memory = prepacked_weight_memory(
+          prepack_cache_key(weight, padding, stride, dilation, groups),
+          weight_usr_memory,
+          weight_pd);
+    } else {
+      weight_memory = memory(weight_pd);
+      net.push_back(reorder(weight_usr_memory, weight_memory));
+    }
   }
 
   auto output_pd = conv_forward_pd->dst_primitive_desc();
@@ -8,6 +8,11 @@
 #include <ATen/SparseTensorUtils.h>
 
 #include <TH/THBlasUtils.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
 
 namespace at { namespace native {
 
@@ -335,6 +340,150 @@ SparseTensor& copy_sparse_(SparseTensor& self, const SparseTensor& src, bool non
   return self._coalesced_(src.is_coalesced());
 }
 
+namespace {
+
+// Note [Parallel coalesce]
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// coalesce() runs implicitly in front of most sparse math, and the serial
+// sort + merge loop above nnz in the tens of millions dominates sparse
+// optimizer steps (e.g. embedding gradients). The parallel path below does
+// the same job in three phases:
+//
+//   1. Sort (flattened index, original position) pairs. The keys are first
+//      partitioned by their high bits into buckets, then each bucket is
+//      sorted concurrently; since the buckets pre-partition the key range,
+//      concatenating them yields a globally sorted order.
+//   2. Scan the sorted keys once to find segment boundaries (positions
+//      where the flattened index changes).
+//   3. Reduce each segment of values concurrently. Every segment owns a
+//      distinct output slot, so the writes are disjoint.
+//
+// Ties between duplicate indices are broken by the original position, so
+// the floating point summation order within a segment is deterministic
+// regardless of the thread count.
+
+struct IndexPosPair {
+  int64_t key;
+  int64_t pos;
+};
+
+constexpr int64_t kParallelCoalesceMinNnz = 1 << 15;
+constexpr int64_t kNumCoalesceBuckets = 256;
+
+void sort_index_pos_pairs(std::vector<IndexPosPair>& pairs) {
+  const int64_t n = pairs.size();
+  int64_t max_key = 0;
+  for (const auto& p : pairs) {
+    max_key = std::max(max_key, p.key);
+  }
+  // Choose a shift so that key >> shift lands in [0, kNumCoalesceBuckets).
+  int shift = 0;
+  while ((max_key >> shift) >= kNumCoalesceBuckets) {
+    shift++;
+  }
+
+  std::array<int64_t, kNumCoalesceBuckets + 1> offsets{};
+  for (const auto& p : pairs) {
+    offsets[(p.key >> shift) + 1]++;
+  }
+  for (int64_t b = 0; b < kNumCoalesceBuckets; b++) {
+    offsets[b + 1] += offsets[b];
+  }
+
+  std::vector<IndexPosPair> bucketed(n);
+  std::array<int64_t, kNumCoalesceBuckets> cursor;
+  std::copy(offsets.begin(), offsets.begin() + kNumCoalesceBuckets, cursor.begin());
+  for (const auto& p : pairs) {
+    bucketed[cursor[p.key >> shift]++] = p;
+  }
+
+  at::parallel_for(0, kNumCoalesceBuckets, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      std::sort(
+          bucketed.begin() + offsets[b],
+          bucketed.begin() + offsets[b + 1],
+          [](const IndexPosPair& a, const IndexPosPair& b) {
+            return a.key != b.key ? a.key < b.key : a.pos < b.pos;
+          });
+    }
+  });
+  pairs.swap(bucketed);
+}
+
+SparseTensor coalesce_sparse_cpu_parallel(
+    const SparseTensor& self,
+    const LongTensor& indices,
+    const Tensor& values,
+    const LongTensor& indices_scalar) {
+  int64_t sparse_dim = self.sparse_dim();
+  int64_t dense_dim = self.dense_dim();
+  int64_t nnz = self._nnz();
+
+  auto flat_accessor = indices_scalar.accessor<int64_t, 1>();
+  std::vector<IndexPosPair> pairs(nnz);
+  at::parallel_for(0, nnz, 4096, [&](int64_t begin, int64_t end) {
+    for (int64_t j = begin; j < end; j++) {
+      pairs[j] = {flat_accessor[j], j};
+    }
+  });
+  sort_index_pos_pairs(pairs);
+
+  std::vector<int64_t> segment_starts;
+  for (int64_t j = 0; j < nnz; j++) {
+    if (j == 0 || pairs[j].key != pairs[j - 1].key) {
+      segment_starts.push_back(j);
+    }
+  }
+  const int64_t newNnz = segment_starts.size();
+
+  SparseTensor dst = new_sparse(self.options());
+  get_sparse_impl(dst)->resize_(sparse_dim, dense_dim, self.sizes());
+  LongTensor newIndices = at::empty(indices.sizes(), indices.options());
+  Tensor newValues = at::empty(values.sizes(), values.options());
+  alias_into_sparse(dst, newIndices, newValues);
+
+  auto newIndicesAccessor = newIndices.accessor<int64_t, 2>();
+  auto indicesAccessor = indices.accessor<int64_t, 2>();
+
+  AT_DISPATCH_ALL_TYPES(
+      values.scalar_type(), "coalesce", [&] {
+        int64_t blockSize = values.stride(0);
+        scalar_t* values_ptr = values.data<scalar_t>();
+        scalar_t* newValues_ptr = newValues.data<scalar_t>();
+        const bool has_values = values.numel() > 0;
+        at::parallel_for(0, newNnz, 64, [&](int64_t begin, int64_t end) {
+          for (int64_t s = begin; s < end; s++) {
+            const int64_t segBegin = segment_starts[s];
+            const int64_t segEnd = s + 1 < newNnz ? segment_starts[s + 1] : nnz;
+            const int64_t first_pos = pairs[segBegin].pos;
+            for (int64_t d = 0; d < sparse_dim; d++) {
+              newIndicesAccessor[d][s] = indicesAccessor[d][first_pos];
+            }
+            if (!has_values) {
+              continue;
+            }
+            scalar_t* out = newValues_ptr + s * blockSize;
+            const scalar_t* in = values_ptr + first_pos * blockSize;
+            for (int64_t k = 0; k < blockSize; k++) {
+              out[k] = in[k];
+            }
+            for (int64_t j = segBegin + 1; j < segEnd; j++) {
+              in = values_ptr + pairs[j].pos * blockSize;
+              for (int64_t k = 0; k < blockSize; k++) {
+                out[k] += in[k];
+              }
+            }
+          }
+        });
+      });
+
+  dst._coalesced_(true);
+  get_sparse_impl(dst)->set_nnz_and_narrow(newNnz);
+  return dst;
+}
+
+} // namespace
+
 SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
   AT_ASSERT(self.defined());
   AT_ASSERT(!self.is_variable());  // TODO: change this to check `.requires_grad()` and `GradMode::is_enabled()` when Variable and Tensor are merged
@@ -359,6 +508,11 @@ SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
 
   LongTensor indices_scalar = flatten_indices(indices, self.sizes());
 
+  // See Note [Parallel coalesce]
+  if (nnz >= kParallelCoalesceMinNnz && at::get_num_threads() != 1) {
+    return coalesce_sparse_cpu_parallel(self, indices, values, indices_scalar);
+  }
+
   SparseTensor dst = new_sparse(self.options());
   get_sparse_impl(dst)->resize_(sparse_dim, dense_dim, self.sizes());
   // TODO: is there a more idiomatic way to do this?
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+#include <tuple>
+
+using namespace at;
+
+// Sanity checks for the native alias sampler (see Note [Alias method
+// sampling] in native/Distributions.cpp): the setup and draw must agree
+// on the q/J convention, and the empirical distribution must match probs.
+
+TEST(AliasMultinomialTest, TableEncodesTheDistribution) {
+  manual_seed(52);
+  const int64_t K = 50;
+  auto probs = rand({K}, kDouble) + 0.01; // unnormalized is allowed
+  Tensor J, q;
+  std::tie(J, q) = _multinomial_alias_setup(probs);
+
+  // Under the draw's convention -- keep bucket i with probability q[i],
+  // otherwise emit J[i] -- category c is drawn with probability
+  // (q[c] + sum_{J[i]==c} (1 - q[i])) / K. That must reconstruct probs.
+  auto q_a = q.accessor<double, 1>();
+  auto J_a = J.accessor<int64_t, 1>();
+  std::vector<double> reconstructed(K, 0.0);
+  for (int64_t i = 0; i < K; i++) {
+    ASSERT_GE(q_a[i], 0.0);
+    ASSERT_LE(q_a[i], 1.0);
+    ASSERT_GE(J_a[i], 0);
+    ASSERT_LT(J_a[i], K);
+    reconstructed[i] += q_a[i];
+    reconstructed[J_a[i]] += 1.0 - q_a[i];
+  }
+  const double sum = probs.sum().item<double>();
+  auto probs_a = probs.accessor<double, 1>();
+  for (int64_t i = 0; i < K; i++) {
+    ASSERT_NEAR(reconstructed[i], probs_a[i] * K / sum, 1e-6);
+  }
+}
+
+TEST(AliasMultinomialTest, EmpiricalDistributionMatchesProbs) {
+  manual_seed(53);
+  auto probs = tensor({2.0, 5.0, 1.0, 2.0}, kDouble);
+  const int64_t K = probs.numel();
+  const int64_t n = 200000;
+  Tensor J, q;
+  std::tie(J, q) = _multinomial_alias_setup(probs);
+  auto samples = _multinomial_alias_draw(q, J, n, nullptr);
+
+  auto counts = bincount(samples, {}, K);
+  ASSERT_EQ(counts.sum().item<int64_t>(), n);
+
+  // Pearson chi-squared against the expected counts; 25 is far beyond
+  // the p=1e-4 critical value for 3 degrees of freedom, so only a
+  // genuinely broken sampler trips it.
+  double chi2 = 0;
+  auto counts_a = counts.accessor<int64_t, 1>();
+  auto probs_a = probs.accessor<double, 1>();
+  const double sum = probs.sum().item<double>();
+  for (int64_t i = 0; i < K; i++) {
+    const double expected = n * probs_a[i] / sum;
+    const double diff = counts_a[i] - expected;
+    chi2 += diff * diff / expected;
+  }
+  ASSERT_LT(chi2, 25.0);
+}
+
+TEST(AliasMultinomialTest, DegenerateDistributions) {
+  manual_seed(54);
+  // Single category: every draw is 0
+  Tensor J, q;
+  std::tie(J, q) = _multinomial_alias_setup(ones({1}, kDouble));
+  auto samples = _multinomial_alias_draw(q, J, 1000, nullptr);
+  ASSERT_EQ(samples.min().item<int64_t>(), 0);
+  ASSERT_EQ(samples.max().item<int64_t>(), 0);
+
+  // A zero-probability category is never kept and never aliased to, so
+  // it must never be emitted
+  std::tie(J, q) = _multinomial_alias_setup(tensor({0.5, 0.0, 0.5}, kDouble));
+  samples = _multinomial_alias_draw(q, J, 10000, nullptr);
+  ASSERT_EQ(bincount(samples, {}, 3).accessor<int64_t, 1>()[1], 0);
+}
+
+TEST(AliasMultinomialTest, DrawsAreSeedDeterministic) {
+  auto probs = rand({17}, kDouble);
+  Tensor J, q;
+  std::tie(J, q) = _multinomial_alias_setup(probs);
+  manual_seed(55);
+  auto first = _multinomial_alias_draw(q, J, 4096, nullptr);
+  manual_seed(55);
+  auto second = _multinomial_alias_draw(q, J, 4096, nullptr);
+  ASSERT_TRUE(first.equal(second));
+}
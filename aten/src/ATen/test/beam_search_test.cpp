@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+#include <tuple>
+
+using namespace at;
+
+// The beam search primitives (see Note [Beam search decoding primitives]
+// in native/BeamSearch.cpp) each replace a decomposed graph; every test
+// compares against that decomposition.
+
+TEST(BeamSearchTest, BeamTopkMatchesDecomposition) {
+  manual_seed(48);
+  for (int64_t batch : {1, 4}) {
+    for (int64_t beam : {1, 5}) {
+      const int64_t vocab = 97;
+      for (int64_t k : {int64_t(1), beam, 2 * beam}) {
+        auto scores = rand({batch, beam, vocab});
+        Tensor values, tokens, beams;
+        std::tie(values, tokens, beams) = _beam_topk(scores, k);
+
+        // reference: flatten + topk + decompose the flat indices
+        Tensor ref_values, ref_indices;
+        std::tie(ref_values, ref_indices) =
+            scores.view({batch, beam * vocab}).topk(k, -1);
+        ASSERT_TRUE(values.equal(ref_values));
+        ASSERT_TRUE(tokens.equal(ref_indices.fmod(vocab)));
+        ASSERT_TRUE(beams.equal(ref_indices.div(vocab)));
+      }
+    }
+  }
+}
+
+TEST(BeamSearchTest, BeamTopkBreaksTiesLikeTopk) {
+  manual_seed(49);
+  // Heavy ties: topk's contract is that the lower flat index wins
+  auto scores = (rand({3, 4, 61}) * 3).floor();
+  Tensor values, tokens, beams;
+  std::tie(values, tokens, beams) = _beam_topk(scores, 4);
+  Tensor ref_values, ref_indices;
+  std::tie(ref_values, ref_indices) = scores.view({3, 4 * 61}).topk(4, -1);
+  ASSERT_TRUE(values.equal(ref_values));
+  ASSERT_TRUE(tokens.equal(ref_indices.fmod(61)));
+  ASSERT_TRUE(beams.equal(ref_indices.div(61)));
+
+  // All-equal scores: selection must be the first k flat indices
+  std::tie(values, tokens, beams) = _beam_topk(ones({2, 3, 7}), 5);
+  std::tie(ref_values, ref_indices) = ones({2, 21}).topk(5, -1);
+  ASSERT_TRUE(tokens.equal(ref_indices.fmod(7)));
+  ASSERT_TRUE(beams.equal(ref_indices.div(7)));
+}
+
+TEST(BeamSearchTest, BeamGatherCacheMatchesIndexSelect) {
+  manual_seed(50);
+  const int64_t batch = 3;
+  const int64_t beam = 5;
+  auto cache = rand({batch, beam, 4, 6});
+
+  // Random selections with repeats -- several beams surviving from the
+  // same parent is the case the scratch staging exists for
+  auto beams = (rand({batch, beam}) * beam).toType(kLong);
+  // force a repeated parent and an identity batch
+  beams[0][0] = 2;
+  beams[0][1] = 2;
+  for (int64_t k = 0; k < beam; ++k) {
+    beams[1][k] = k;
+  }
+
+  auto expected = cache.clone();
+  for (int64_t b = 0; b < batch; ++b) {
+    expected[b] = cache[b].index_select(0, beams[b]);
+  }
+
+  _beam_gather_cache_(cache, beams);
+  ASSERT_TRUE(cache.equal(expected));
+
+  // out-of-range beam indices throw (validated before any row moves)
+  auto bad = zeros({batch, beam}, kLong);
+  bad[0][0] = beam;
+  ASSERT_THROW(_beam_gather_cache_(cache, bad), std::exception);
+}
+
+TEST(BeamSearchTest, BeamCacheAppendWrapsAround) {
+  manual_seed(51);
+  const int64_t batch = 2;
+  const int64_t beam = 3;
+  const int64_t capacity = 4;
+  auto cache = zeros({batch, beam, capacity, 5});
+
+  // reference cache maintained with narrow().copy_ at the same slot
+  auto expected = cache.clone();
+  for (int64_t pos = 0; pos < 2 * capacity + 1; ++pos) {
+    auto step = rand({batch, beam, 5});
+    _beam_cache_append_(cache, step, pos);
+    expected.narrow(2, pos % capacity, 1).copy_(step.unsqueeze(2));
+    ASSERT_TRUE(cache.equal(expected));
+  }
+}
@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/OpHandle.h>
+
+using namespace at;
+
+TEST(OpHandleTest, MatchesDispatchedResult) {
+  auto a = rand({4, 4});
+  auto b = rand({4, 4});
+  auto add = OpHandle<Tensor(const Tensor&, const Tensor&, Scalar)>::bind(
+      &Type::add, a);
+  ASSERT_TRUE(add(a, b, 1).equal(a + b));
+  // The handle is reusable across calls with fresh inputs.
+  auto c = rand({4, 4});
+  ASSERT_TRUE(add(b, c, 1).equal(b + c));
+}
+
+TEST(OpHandleTest, BindByBackendAndDtype) {
+  auto add = OpHandle<Tensor(const Tensor&, Scalar, Scalar)>::bind(
+      &Type::add, Backend::CPU, kFloat);
+  auto a = ones({2, 2});
+  ASSERT_TRUE(add(a, 2, 1).equal(a + 2));
+}
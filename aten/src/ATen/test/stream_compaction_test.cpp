@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace at;
+
+namespace {
+
+// The compaction kernels count and scatter in fixed-size chunks, so the
+// interesting lengths sit on both sides of a chunk boundary. Keep in sync
+// with kCompactionChunk in native/cpu/StreamCompactionKernel.cpp.
+constexpr int64_t kChunk = 32768;
+
+const std::vector<int64_t> kBoundarySizes = {
+    0, 1, 5, kChunk - 1, kChunk, kChunk + 1, 3 * kChunk + 17};
+
+Tensor naiveMaskedSelect(const Tensor& self, const Tensor& mask) {
+  auto self_c = self.contiguous().view(-1);
+  auto mask_c = mask.contiguous().view(-1);
+  const float* self_data = self_c.data<float>();
+  const uint8_t* mask_data = mask_c.data<uint8_t>();
+  std::vector<float> selected;
+  for (int64_t i = 0; i < self_c.numel(); i++) {
+    if (mask_data[i] != 0) {
+      selected.push_back(self_data[i]);
+    }
+  }
+  auto result = at::empty({static_cast<int64_t>(selected.size())}, kFloat);
+  std::memcpy(
+      result.data<float>(), selected.data(), selected.size() * sizeof(float));
+  return result;
+}
+
+Tensor naiveNonzero(const Tensor& self) {
+  auto flat = self.contiguous().view(-1);
+  const float* data = flat.data<float>();
+  const int64_t ndim = self.dim();
+  const auto sizes = self.sizes();
+  std::vector<int64_t> indices;
+  for (int64_t i = 0; i < flat.numel(); i++) {
+    if (data[i] != 0) {
+      // unravel the flat index in row-major order, as TH does
+      size_t base = indices.size();
+      indices.resize(base + ndim);
+      int64_t remainder = i;
+      for (int64_t d = ndim - 1; d >= 0; d--) {
+        indices[base + d] = remainder % sizes[d];
+        remainder /= sizes[d];
+      }
+    }
+  }
+  auto result = at::empty(
+      {static_cast<int64_t>(indices.size()) / ndim, ndim}, kLong);
+  std::memcpy(
+      result.data<int64_t>(),
+      indices.data(),
+      indices.size() * sizeof(int64_t));
+  return result;
+}
+
+} // namespace
+
+TEST(StreamCompactionTest, MaskedSelectMatchesReference) {
+  manual_seed(42);
+  for (int64_t size : kBoundarySizes) {
+    auto self = rand({size});
+    // all-out, random, and all-in masks; the extremes hit the empty
+    // result and full-copy paths
+    std::vector<Tensor> masks = {
+        zeros({size}, kByte), rand({size}).lt(0.5), ones({size}, kByte)};
+    for (const auto& mask : masks) {
+      auto expected = naiveMaskedSelect(self, mask);
+      ASSERT_TRUE(masked_select(self, mask).equal(expected));
+    }
+  }
+
+  // Multi-dimensional inputs flatten in row-major order
+  {
+    auto self = rand({123, 257});
+    auto mask = rand({123, 257}).lt(0.3);
+    ASSERT_TRUE(masked_select(self, mask).equal(naiveMaskedSelect(self, mask)));
+
+    // A non-contiguous input takes the fallback path but must select the
+    // same elements in the same order
+    auto self_t = self.t();
+    auto mask_t = mask.t();
+    ASSERT_TRUE(
+        masked_select(self_t, mask_t).equal(naiveMaskedSelect(self_t, mask_t)));
+  }
+}
+
+TEST(StreamCompactionTest, NonzeroMatchesReference) {
+  manual_seed(43);
+  for (int64_t size : kBoundarySizes) {
+    for (double density : {0.0, 0.3, 1.0}) {
+      auto self = rand({size}).lt(density).toType(kFloat);
+      ASSERT_TRUE(nonzero(self).equal(naiveNonzero(self)));
+    }
+  }
+
+  // Multi-dimensional input spanning several chunks: rows must come out
+  // sorted by flat index with row-major coordinates
+  {
+    auto self = rand({5, 7013}).lt(0.2).toType(kFloat);
+    ASSERT_TRUE(nonzero(self).equal(naiveNonzero(self)));
+  }
+  {
+    auto self = rand({7, 11, 13}).lt(0.4).toType(kFloat);
+    ASSERT_TRUE(nonzero(self).equal(naiveNonzero(self)));
+  }
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace at;
+
+namespace {
+
+// Parses a single token through the op and returns the resulting double.
+double parseOne(const std::string& token) {
+  auto out = empty({1, 1}, kDouble);
+  csv_to_tensor_out(out, token, ",");
+  return out.accessor<double, 2>()[0][0];
+}
+
+} // namespace
+
+TEST(TextIngestionTest, CsvBasicParsing) {
+  auto out = empty({2, 3}, kDouble);
+  csv_to_tensor_out(out, "1,2,3\n4.5, -6 ,7e1\n", ",");
+  auto a = out.accessor<double, 2>();
+  ASSERT_EQ(a[0][0], 1.0);
+  ASSERT_EQ(a[0][1], 2.0);
+  ASSERT_EQ(a[0][2], 3.0);
+  ASSERT_EQ(a[1][0], 4.5);
+  ASSERT_EQ(a[1][1], -6.0);
+  ASSERT_EQ(a[1][2], 70.0);
+
+  // CRLF line endings and an alternate delimiter
+  csv_to_tensor_out(out, "1;2;3\r\n4;5;6", ";");
+  ASSERT_TRUE(out.equal(
+      tensor({1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, kDouble).view({2, 3})));
+
+  // Values survive the cast to a float output
+  auto outf = empty({1, 2}, kFloat);
+  csv_to_tensor_out(outf, "0.25,1e10", ",");
+  ASSERT_EQ(outf.accessor<float, 2>()[0][0], 0.25f);
+  ASSERT_EQ(outf.accessor<float, 2>()[0][1], 1e10f);
+}
+
+TEST(TextIngestionTest, CsvMatchesStrtodAtFastPathBoundaries) {
+  // Tokens on both sides of the fast path's limits: 15 vs 16 significant
+  // digits, scale +/-22 vs beyond, and the inf/nan spellings that always
+  // take the strtod path. Every result must be bit-for-bit strtod's.
+  const std::vector<std::string> tokens = {
+      "0",
+      "-0",
+      "0.1",
+      "3.14159",
+      "123456789012345", // 15 digits: last mantissa on the fast path
+      "1234567890123456", // 16 digits: falls back
+      "999999999999999e22",
+      "1.23456789012345e-22",
+      "1e22",
+      "1e23",
+      "1e-22",
+      "1e-23",
+      "12345.000000000000001", // long but mostly-zero mantissa
+      "2.2250738585072014e-308", // smallest normal double
+      "1.7976931348623157e308", // largest finite double
+      "inf",
+      "-inf",
+  };
+  for (const auto& token : tokens) {
+    const double expected = std::strtod(token.c_str(), nullptr);
+    const double actual = parseOne(token);
+    ASSERT_EQ(actual, expected) << "token: " << token;
+  }
+  ASSERT_TRUE(std::isnan(parseOne("nan")));
+}
+
+TEST(TextIngestionTest, CsvRejectsMalformedInput) {
+  auto out = empty({1, 3}, kDouble);
+  // junk in a field
+  ASSERT_THROW(csv_to_tensor_out(out, "1,abc,3", ","), std::exception);
+  ASSERT_THROW(csv_to_tensor_out(out, "1,2.5.6,3", ","), std::exception);
+  // empty field
+  ASSERT_THROW(csv_to_tensor_out(out, "1,,3", ","), std::exception);
+  // too few / too many columns
+  ASSERT_THROW(csv_to_tensor_out(out, "1,2", ","), std::exception);
+  ASSERT_THROW(csv_to_tensor_out(out, "1,2,3,4", ","), std::exception);
+  // record count does not match the output rows
+  ASSERT_THROW(csv_to_tensor_out(out, "1,2,3\n4,5,6", ","), std::exception);
+  // delimiter must be a single character
+  ASSERT_THROW(csv_to_tensor_out(out, "1,2,3", ",,"), std::exception);
+  // output must be 2-d
+  auto flat = empty({3}, kDouble);
+  ASSERT_THROW(csv_to_tensor_out(flat, "1,2,3", ","), std::exception);
+}
+
+TEST(TextIngestionTest, JsonBasicParsing) {
+  auto out = empty({2, 3}, kDouble);
+  json_to_tensor_out(out, "[1, 2, 3]\n  [ 4.5 , -6 , 7e1 ]  ");
+  auto a = out.accessor<double, 2>();
+  ASSERT_EQ(a[0][0], 1.0);
+  ASSERT_EQ(a[1][0], 4.5);
+  ASSERT_EQ(a[1][2], 70.0);
+}
+
+TEST(TextIngestionTest, JsonRejectsMalformedInput) {
+  auto out = empty({1, 3}, kDouble);
+  // missing brackets
+  ASSERT_THROW(json_to_tensor_out(out, "1,2,3"), std::exception);
+  ASSERT_THROW(json_to_tensor_out(out, "[1,2,3"), std::exception);
+  // nested arrays are not flat rows
+  ASSERT_THROW(json_to_tensor_out(out, "[[1,2,3]]"), std::exception);
+  // wrong arity
+  ASSERT_THROW(json_to_tensor_out(out, "[1,2]"), std::exception);
+  ASSERT_THROW(json_to_tensor_out(out, "[1,2,3,4]"), std::exception);
+}
@@ -94,12 +94,12 @@ void THTensor_resizeNd(THTensor *self, int nDimension, const int64_t *size, cons
 // 2. newshape must be able to be separated into same number of chunks as oldshape was separated into,
 //    where each chunk of newshape has matching ``numel'', i.e., number of subspaces,
 //    as the corresponding chunk of oldshape.
-c10::optional<std::vector<int64_t>> THTensor_compute_stride(
+c10::optional<at::DimVector> THTensor_compute_stride(
     at::IntArrayRef oldshape,
     at::IntArrayRef oldstride,
     at::IntArrayRef newshape) {
   if (oldshape.empty()) {
-    return std::vector<int64_t>(newshape.size(), 1);
+    return at::DimVector(newshape.size(), 1);
   }
 
   // NOTE: stride is arbitrary is somewhat arbitrary in the numel() == 0 case;
@@ -108,10 +108,10 @@ c10::optional<std::vector<int64_t>> THTensor_compute_stride(
   // This could perhaps be combined with the below code, but the complexity didn't seem worth it.
   int64_t numel = std::accumulate(oldshape.begin(), oldshape.end(), 1, std::multiplies<int64_t>());
   if (numel == 0 && oldshape.equals(newshape)) {
-    return oldstride.vec();
+    return at::DimVector(oldstride.begin(), oldstride.end());
   }
 
-  std::vector<int64_t> newstride(newshape.size());
+  at::DimVector newstride(newshape.size());
   if (numel == 0) {
     int64_t view_numel = 1;
     for (int64_t view_d = newshape.size() - 1; view_d >= 0; view_d--) {
@@ -8,6 +8,7 @@
 
 #include <atomic>
 #include <ATen/ATen.h>
+#include <ATen/core/DimVector.h>
 
 // Returns a Tensor given a TensorImpl. The TensorImpl remains valid after the
 // the Tensor is destroyed.
@@ -117,7 +118,7 @@ TH_API void THTensor_resizeNd(THTensor *self, int nDimension, const int64_t *siz
 
 TH_CPP_API void THTensor_resize(THTensor *self, at::IntArrayRef size, at::IntArrayRef stride);
 TH_CPP_API void THTensor_setStorage(THTensor *self, THStorage *storage_, ptrdiff_t storageOffset_, at::IntArrayRef size_, at::IntArrayRef stride_);
-TH_CPP_API c10::optional<std::vector<int64_t>> THTensor_compute_stride(
+TH_CPP_API c10::optional<at::DimVector> THTensor_compute_stride(
     at::IntArrayRef oldshape,
     at::IntArrayRef oldstride,
     at::IntArrayRef newshape);
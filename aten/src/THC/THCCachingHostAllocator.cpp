@@ -1,5 +1,6 @@
 #include <THC/THCCachingHostAllocator.h>
 
+#include <c10/util/Optional.h>
 
 #include <cuda_runtime_api.h>
 #include <deque>
@@ -27,6 +28,11 @@ struct Block : public BlockSize
   int   event_count;  // number of outstanding cuda events
   std::unordered_set<at::cuda::CUDAStream> streams;
 
+  // The stream the block was last consumed on, when that was a single
+  // stream; decides which free list the block returns to. See
+  // Note [Stream-affine host blocks].
+  c10::optional<at::cuda::CUDAStream> affinity;
+
   Block(size_t size, void* ptr, bool allocated) :
       BlockSize(size, ptr), allocated(allocated), event_count(0), streams() {}
 };
@@ -40,6 +46,26 @@ static bool BlockComparator(const BlockSize& a, const BlockSize& b)
   return (uintptr_t)a.ptr < (uintptr_t)b.ptr;
 }
 
+// Note [Stream-affine host blocks]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With a single free pool, a host buffer last consumed on GPU k's copy
+// stream can be handed to a thread feeding GPU j, and reclamation was
+// gated on one global event queue: events complete in order per stream
+// but arbitrarily across streams, so a single busy stream delayed the
+// reuse of every buffer behind it in the queue. On multi-GPU loader
+// pipelines that shows up as periodic stalls whenever buffers recycle
+// across streams.
+//
+// Blocks whose pending work all ran on one stream therefore return to a
+// free list segmented by that stream, and malloc prefers the list of the
+// caller's current stream, so each pipeline leg recycles its own
+// buffers. Pending events live in per-stream queues drained up to the
+// first incomplete event of each stream, which keeps reclamation
+// O(completed) and never lets one stream hold up another's buffers.
+// Blocks with no or mixed stream history stay in the shared pool, and
+// allocation falls back shared pool -> fresh cudaHostAlloc -> stealing
+// from other streams' lists, so segmentation can never fail an
+// allocation that the old design would have satisfied.
 struct HostAllocator
 {
   typedef bool (*Comparison)(const BlockSize&, const BlockSize&);
@@ -50,11 +76,19 @@ struct HostAllocator
   // blocks by pointer
   std::unordered_map<void*, Block> blocks;
 
-  // pointers that are ready to be allocated (event_count=0)
+  // pointers that are ready to be allocated (event_count=0) with no or
+  // mixed stream history
   std::set<BlockSize, Comparison> available;
 
-  // outstanding cuda events
-  std::deque<std::pair<cudaEvent_t, void*>> cuda_events;
+  // ready pointers whose pending work all drained on a single stream
+  std::unordered_map<at::cuda::CUDAStream, std::set<BlockSize, Comparison>>
+      stream_available;
+
+  // outstanding cuda events, in issue order per recording stream
+  std::unordered_map<
+      at::cuda::CUDAStream,
+      std::deque<std::pair<cudaEvent_t, void*>>>
+      cuda_events;
 
   HostAllocator() : available(BlockComparator) {}
 
@@ -68,15 +102,22 @@ struct HostAllocator
       return err;
     }
 
-    // search for the smallest block which can hold this allocation
     BlockSize search_key(size);
+
+    // Prefer blocks whose pending work drained on the stream this thread
+    // is feeding; see Note [Stream-affine host blocks].
+    auto pool_it = stream_available.find(c10::cuda::getCurrentCUDAStream());
+    if (pool_it != stream_available.end()) {
+      auto it = pool_it->second.lower_bound(search_key);
+      if (it != pool_it->second.end()) {
+        takeBlock(pool_it->second, it, ptr);
+        return cudaSuccess;
+      }
+    }
+
     auto it = available.lower_bound(search_key);
     if (it != available.end()) {
-      Block& block = blocks.at(it->ptr);
-      THAssert(!block.allocated && block.event_count == 0);
-      block.allocated = true;
-      *ptr = block.ptr;
-      available.erase(it);
+      takeBlock(available, it, ptr);
       return cudaSuccess;
     }
 
@@ -85,6 +126,28 @@ struct HostAllocator
 
     // allocate a new block if no cached allocation is found
     err = cudaHostAlloc(ptr, size, cudaHostAllocDefault);
+    if (err == cudaErrorMemoryAllocation) {
+      // Pinned memory is exhausted; recycling across streams beats
+      // failing the allocation.
+      cudaGetLastError();
+      std::set<BlockSize, Comparison>* best_pool = NULL;
+      std::set<BlockSize, Comparison>::iterator best;
+      for (auto& pool : stream_available) {
+        auto candidate = pool.second.lower_bound(search_key);
+        if (candidate == pool.second.end()) {
+          continue;
+        }
+        if (best_pool == NULL || candidate->size < best->size) {
+          best_pool = &pool.second;
+          best = candidate;
+        }
+      }
+      if (best_pool != NULL) {
+        takeBlock(*best_pool, best, ptr);
+        return cudaSuccess;
+      }
+      return cudaErrorMemoryAllocation;
+    }
     if (err != cudaSuccess) {
       return err;
     }
@@ -117,6 +180,13 @@ struct HostAllocator
     // we process the streams.
     block.allocated = false;
 
+    // the affinity for this use cycle; insertEvents consumes the stream set
+    if (block.streams.size() == 1) {
+      block.affinity = *block.streams.begin();
+    } else {
+      block.affinity = c10::nullopt;
+    }
+
     // insert CUDA events for each stream on which this block was used. This
     err = insertEvents(block);
     if (err != cudaSuccess) {
@@ -125,7 +195,7 @@ struct HostAllocator
 
     if (block.event_count == 0) {
       // the block can be re-used if there are no outstanding cuda events
-      available.insert(block);
+      insertAvailable(block);
     }
     return cudaSuccess;
   }
@@ -151,30 +221,39 @@ struct HostAllocator
   {
     // Process outstanding cudaEvents. Events that are completed are removed
     // from the queue, and the 'event_count' for the corresponding allocation
-    // is decremented. Stops at the first event which has not been completed.
-    // Since events on different devices or streams may occur out of order,
-    // the processing of some events may be delayed.
-    while (!cuda_events.empty()) {
-      auto& e = cuda_events.front();
-      cudaEvent_t event = e.first;
-
-      cudaError_t err = cudaEventQuery(event);
-      if (err == cudaErrorNotReady) {
-        break;
-      } else if (err != cudaSuccess) {
-        return err;
-      }
-      err = cudaEventDestroy(event);
-      if (err != cudaSuccess) {
-        return err;
+    // is decremented. Each stream's queue is in issue order, so processing
+    // stops at its first incomplete event; one stream's backlog never
+    // delays reclaiming blocks recorded on another stream.
+    for (auto queue_it = cuda_events.begin(); queue_it != cuda_events.end();) {
+      auto& queue = queue_it->second;
+      while (!queue.empty()) {
+        auto& e = queue.front();
+        cudaEvent_t event = e.first;
+
+        cudaError_t err = cudaEventQuery(event);
+        if (err == cudaErrorNotReady) {
+          cudaGetLastError();
+          break;
+        } else if (err != cudaSuccess) {
+          return err;
+        }
+        err = cudaEventDestroy(event);
+        if (err != cudaSuccess) {
+          return err;
+        }
+
+        Block& block = blocks.at(e.second);
+        block.event_count--;
+        if (block.event_count == 0 && !block.allocated) {
+          insertAvailable(block);
+        }
+        queue.pop_front();
       }
-
-      Block& block = blocks.at(e.second);
-      block.event_count--;
-      if (block.event_count == 0 && !block.allocated) {
-        available.insert(block);
+      if (queue.empty()) {
+        queue_it = cuda_events.erase(queue_it);
+      } else {
+        ++queue_it;
       }
-      cuda_events.pop_front();
     }
     return cudaSuccess;
   }
@@ -184,20 +263,23 @@ struct HostAllocator
     std::lock_guard<std::mutex> lock(mutex);
 
     // remove events for freed blocks
-    for (auto it = cuda_events.begin(); it != cuda_events.end(); ++it) {
-      cudaEvent_t event = it->first;
-      Block& block = blocks.at(it->second);
-      if (!block.allocated) {
-        THCudaCheckWarn(cudaEventDestroy(event));
-        block.event_count--;
+    for (auto& queue : cuda_events) {
+      for (auto it = queue.second.begin(); it != queue.second.end(); ++it) {
+        cudaEvent_t event = it->first;
+        Block& block = blocks.at(it->second);
+        if (!block.allocated) {
+          THCudaCheckWarn(cudaEventDestroy(event));
+          block.event_count--;
+        }
       }
     }
 
     // all cuda_events have been processed
     cuda_events.clear();
 
-    // clear list of available blocks
+    // clear lists of available blocks
     available.clear();
+    stream_available.clear();
 
     // free and erase non-allocated blocks
     for (auto it = blocks.begin(); it != blocks.end();) {
@@ -232,12 +314,46 @@ struct HostAllocator
       if (err != cudaSuccess) break;
 
       block.event_count++;
-      cuda_events.emplace_back(event, block.ptr);
+      cuda_events[*it].emplace_back(event, block.ptr);
     }
 
     cudaSetDevice(prev_device);
     return err;
   }
+
+ private:
+  // Removes the block behind `it` from its free list and hands it out.
+  void takeBlock(
+      std::set<BlockSize, Comparison>& pool,
+      std::set<BlockSize, Comparison>::iterator it,
+      void** ptr)
+  {
+    Block& block = blocks.at(it->ptr);
+    THAssert(!block.allocated && block.event_count == 0);
+    block.allocated = true;
+    *ptr = block.ptr;
+    pool.erase(it);
+  }
+
+  void insertAvailable(Block& block)
+  {
+    if (block.affinity) {
+      streamPool(*block.affinity).insert(block);
+    } else {
+      available.insert(block);
+    }
+  }
+
+  std::set<BlockSize, Comparison>& streamPool(at::cuda::CUDAStream stream)
+  {
+    auto it = stream_available.find(stream);
+    if (it == stream_available.end()) {
+      it = stream_available
+               .emplace(stream, std::set<BlockSize, Comparison>(BlockComparator))
+               .first;
+    }
+    return it->second;
+  }
 };
 
 }  // namespace
@@ -249,6 +365,12 @@ cudaError_t THCCachingHostAllocator_recordEvent(void *ptr, at::cuda::CUDAStream
   return allocator.recordEvent(ptr, stream);
 }
 
+void THCCachingHostAllocator_processEvents()
+{
+  std::lock_guard<std::mutex> lock(allocator.mutex);
+  THCudaCheckWarn(allocator.processEvents());
+}
+
 void THCCachingHostAllocator_emptyCache()
 {
   allocator.emptyCache();
@@ -27,6 +27,11 @@ THC_API c10::Allocator* getTHCCachingHostAllocator(void);
 // re-used until the event has occurred.
 THC_API cudaError_t THCCachingHostAllocator_recordEvent(void *ptr, at::cuda::CUDAStream stream);
 
+// Reclaims every block whose pending events have completed. Reclamation
+// also happens incrementally on each malloc/free; this entry point lets
+// loader pipelines batch it at a quiet moment (e.g. once per epoch).
+THC_API void THCCachingHostAllocator_processEvents(void);
+
 // Releases cached pinned memory allocations via cudaHostFree
 THC_API void THCCachingHostAllocator_emptyCache(void);
 
@@ -0,0 +1,78 @@
+"""Compares a Google Benchmark JSON report against a baseline report.
+
+Usage:
+    tensor_iterator_benchmark --benchmark_out=contender.json \
+        --benchmark_out_format=json
+    python compare_with_baseline.py baseline.json contender.json \
+        [--threshold 0.05]
+
+Exits non-zero if any benchmark regressed by more than the threshold,
+so this can gate CI. Benchmarks present in only one of the two reports
+are listed but do not fail the comparison.
+"""
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load_times(path):
+    with open(path) as f:
+        report = json.load(f)
+    times = {}
+    for bench in report.get('benchmarks', []):
+        # Aggregate rows (mean/median/stddev from --benchmark_repetitions)
+        # would double count; prefer them over raw rows when present.
+        name = bench['name']
+        if name.endswith('_mean'):
+            times[name[:-len('_mean')]] = bench['real_time']
+        elif name.endswith('_median') or name.endswith('_stddev'):
+            continue
+        elif name not in times:
+            times[name] = bench['real_time']
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', help='baseline benchmark JSON report')
+    parser.add_argument('contender', help='contender benchmark JSON report')
+    parser.add_argument(
+        '--threshold',
+        type=float,
+        default=0.05,
+        help='relative slowdown treated as a regression (default: 0.05)')
+    args = parser.parse_args()
+
+    baseline = load_times(args.baseline)
+    contender = load_times(args.contender)
+
+    regressions = []
+    width = max(len(name) for name in baseline) if baseline else 0
+    for name in sorted(baseline):
+        if name not in contender:
+            print('{:<{}}  missing from contender'.format(name, width))
+            continue
+        old, new = baseline[name], contender[name]
+        ratio = (new - old) / old if old > 0 else 0.0
+        flag = ''
+        if ratio > args.threshold:
+            flag = '  REGRESSED'
+            regressions.append((name, ratio))
+        print('{:<{}}  {:>12.1f}ns  {:>12.1f}ns  {:>+7.1%}{}'.format(
+            name, width, old, new, ratio, flag))
+    for name in sorted(set(contender) - set(baseline)):
+        print('{:<{}}  missing from baseline'.format(name, width))
+
+    if regressions:
+        print('\n{} benchmark(s) regressed more than {:.1%}:'.format(
+            len(regressions), args.threshold))
+        for name, ratio in regressions:
+            print('  {}  {:+.1%}'.format(name, ratio))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,186 @@
+// Microbenchmarks over the ATen CPU kernel layer.
+//
+// Each benchmark drives a native kernel through the public at:: entry
+// point so that it measures exactly what eager mode dispatches to: the
+// TensorIterator loop families in Loops.h (contiguous, strided,
+// broadcasting) and Reduce.h (full, innermost and outermost dim
+// reductions), plus the copy/cast kernels. The process pins itself to a
+// single core and forces the intra-op thread count to one by default so
+// that runs are comparable across machines; see the README for the
+// fixed-frequency setup and the baseline comparison workflow.
+
+#include "benchmark/benchmark.h"
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+// Sizes are chosen so that the working set walks from L1-resident up to
+// memory-bound; SetBytesProcessed makes the roofline visible in the output.
+const int64_t kMinSize = 1 << 6;
+const int64_t kMaxSize = 1 << 22;
+
+void BM_UnaryOpContiguous(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n});
+  at::Tensor out = at::empty_like(a);
+  while (state.KeepRunning()) {
+    at::exp_out(out, a);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * 2 * sizeof(float));
+}
+BENCHMARK(BM_UnaryOpContiguous)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Transposed input: TensorIterator cannot coalesce the innermost
+// dimension, so this hits the strided (non-vectorized) loop.
+void BM_UnaryOpStrided(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n, n}).t();
+  at::Tensor out = at::empty({n, n});
+  while (state.KeepRunning()) {
+    at::exp_out(out, a);
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_UnaryOpStrided)->RangeMultiplier(4)->Range(1 << 4, 1 << 11);
+
+void BM_BinaryOpContiguous(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n});
+  at::Tensor b = at::randn({n});
+  at::Tensor out = at::empty_like(a);
+  while (state.KeepRunning()) {
+    at::add_out(out, a, b);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(float));
+}
+BENCHMARK(BM_BinaryOpContiguous)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Row-vector broadcast: exercises the dimension-collapsing and stride-0
+// handling in TensorIterator rather than the flat contiguous loop.
+void BM_BinaryOpBroadcast(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n, n});
+  at::Tensor b = at::randn({n});
+  at::Tensor out = at::empty_like(a);
+  while (state.KeepRunning()) {
+    at::add_out(out, a, b);
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_BinaryOpBroadcast)->RangeMultiplier(4)->Range(1 << 4, 1 << 11);
+
+void BM_CopyCastByteToFloat(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randint(0, 256, {n}, at::kByte);
+  at::Tensor out = at::empty({n}, at::kFloat);
+  while (state.KeepRunning()) {
+    out.copy_(a);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CopyCastByteToFloat)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_CopyCastFloatToHalf(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n});
+  at::Tensor out = at::empty({n}, at::kHalf);
+  while (state.KeepRunning()) {
+    out.copy_(a);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CopyCastFloatToHalf)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void BM_ReduceAll(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n});
+  while (state.KeepRunning()) {
+    at::Tensor out = at::sum(a);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * sizeof(float));
+}
+BENCHMARK(BM_ReduceAll)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+// Innermost-dim reduction: unit-stride accumulation, one output per row.
+void BM_ReduceLastDim(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n, n});
+  at::Tensor out = at::empty({n});
+  while (state.KeepRunning()) {
+    at::sum_out(out, a, {1});
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_ReduceLastDim)->RangeMultiplier(4)->Range(1 << 4, 1 << 11);
+
+// Outermost-dim reduction: strided accumulation with a vectorizable
+// output row; the other major code path in Reduce.h.
+void BM_ReduceFirstDim(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n, n});
+  at::Tensor out = at::empty({n});
+  while (state.KeepRunning()) {
+    at::sum_out(out, a, {0});
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_ReduceFirstDim)->RangeMultiplier(4)->Range(1 << 4, 1 << 11);
+
+// Matrix multiply as a compute-bound canary: if this moves, suspect the
+// toolchain or the machine setup rather than an ATen kernel.
+void BM_MatMul(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  at::Tensor a = at::randn({n, n});
+  at::Tensor b = at::randn({n, n});
+  at::Tensor out = at::empty({n, n});
+  while (state.KeepRunning()) {
+    at::mm_out(out, a, b);
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * n * n * n);
+}
+BENCHMARK(BM_MatMul)->RangeMultiplier(2)->Range(1 << 5, 1 << 9);
+
+} // namespace
+
+int main(int argc, char** argv) {
+#ifdef __linux__
+  // Pin to a single core so the scheduler does not migrate us across
+  // cores with different cache or frequency state mid-run.
+  // PYTORCH_BENCHMARK_CPU selects the core (default 0).
+  int cpu = 0;
+  if (const char* env = std::getenv("PYTORCH_BENCHMARK_CPU")) {
+    cpu = std::atoi(env);
+  }
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  sched_setaffinity(0, sizeof(cpuset), &cpuset);
+#endif
+  at::init_num_threads();
+  // Single-threaded by default: intra-op scaling is a separate question
+  // from kernel efficiency, and multi-threaded timings are too noisy to
+  // gate on. Override via PYTORCH_BENCHMARK_THREADS to study scaling.
+  size_t num_threads = 1;
+  if (const char* env = std::getenv("PYTORCH_BENCHMARK_THREADS")) {
+    const int value = std::atoi(env);
+    if (value > 0) {
+      num_threads = value;
+    }
+  }
+  at::set_num_threads(num_threads);
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
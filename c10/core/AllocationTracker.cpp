@@ -0,0 +1,196 @@
+#include <c10/core/AllocationTracker.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace c10 {
+namespace allocation_tracker {
+
+namespace detail {
+std::atomic<bool> tracker_enabled{false};
+std::atomic<int64_t> live_allocations{0};
+} // namespace detail
+
+namespace {
+
+struct Stats {
+  int64_t live_bytes = 0;
+  int64_t peak_bytes = 0;
+  int64_t alloc_count = 0;
+};
+
+struct Node {
+  int64_t parent = -1;
+  std::string name;
+  // Ordered map: DeviceType is a small enum and nodes rarely see more
+  // than one device.
+  std::map<DeviceType, Stats> stats;
+};
+
+struct LiveAlloc {
+  int64_t node;
+  DeviceType device;
+  int64_t nbytes;
+};
+
+struct Tracker {
+  std::mutex mutex;
+  std::vector<Node> nodes; // nodes[0] is the root ("no scope") node
+  std::map<std::pair<int64_t, std::string>, int64_t> children;
+  std::unordered_map<void*, LiveAlloc> live;
+
+  Tracker() {
+    nodes.emplace_back();
+  }
+
+  // Caller holds mutex.
+  int64_t internChild(int64_t parent, const char* name) {
+    auto key = std::make_pair(parent, std::string(name));
+    auto it = children.find(key);
+    if (it != children.end()) {
+      return it->second;
+    }
+    const int64_t id = static_cast<int64_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.back().parent = parent;
+    nodes.back().name = key.second;
+    children.emplace(std::move(key), id);
+    return id;
+  }
+
+  // Caller holds mutex.
+  std::string pathOf(int64_t node) const {
+    if (node == 0) {
+      return "<unattributed>";
+    }
+    std::vector<const std::string*> parts;
+    for (int64_t cur = node; cur != 0; cur = nodes[cur].parent) {
+      parts.push_back(&nodes[cur].name);
+    }
+    std::string path;
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+      if (!path.empty()) {
+        path += ';';
+      }
+      path += **it;
+    }
+    return path;
+  }
+};
+
+Tracker& tracker() {
+  static Tracker t;
+  return t;
+}
+
+thread_local std::vector<int64_t> scope_stack;
+
+} // namespace
+
+void enable() {
+  detail::tracker_enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() {
+  detail::tracker_enabled.store(false, std::memory_order_relaxed);
+}
+
+void reset() {
+  auto& t = tracker();
+  std::lock_guard<std::mutex> guard(t.mutex);
+  detail::live_allocations.store(
+      0, std::memory_order_relaxed);
+  t.live.clear();
+  t.children.clear();
+  t.nodes.clear();
+  t.nodes.emplace_back();
+}
+
+void pushScope(const char* name) {
+  auto& t = tracker();
+  std::lock_guard<std::mutex> guard(t.mutex);
+  const int64_t parent = scope_stack.empty() ? 0 : scope_stack.back();
+  scope_stack.push_back(t.internChild(parent, name));
+}
+
+void popScope() {
+  // Tolerates being enabled mid-scope: a pop without a matching push is
+  // dropped.
+  if (!scope_stack.empty()) {
+    scope_stack.pop_back();
+  }
+}
+
+void recordAlloc(DeviceType device, void* ptr, size_t nbytes) {
+  if (!enabled() || ptr == nullptr || nbytes == 0) {
+    return;
+  }
+  auto& t = tracker();
+  std::lock_guard<std::mutex> guard(t.mutex);
+  const int64_t node = scope_stack.empty() ? 0 : scope_stack.back();
+  t.live[ptr] = {node, device, static_cast<int64_t>(nbytes)};
+  detail::live_allocations.fetch_add(1, std::memory_order_relaxed);
+  Stats& stats = t.nodes[node].stats[device];
+  stats.live_bytes += static_cast<int64_t>(nbytes);
+  stats.peak_bytes = std::max(stats.peak_bytes, stats.live_bytes);
+  stats.alloc_count += 1;
+}
+
+void recordFree(void* ptr) {
+  if (ptr == nullptr ||
+      detail::live_allocations.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  auto& t = tracker();
+  std::lock_guard<std::mutex> guard(t.mutex);
+  auto it = t.live.find(ptr);
+  if (it == t.live.end()) {
+    return;
+  }
+  t.nodes[it->second.node].stats[it->second.device].live_bytes -=
+      it->second.nbytes;
+  t.live.erase(it);
+  detail::live_allocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::vector<ScopeStats> snapshot() {
+  auto& t = tracker();
+  std::lock_guard<std::mutex> guard(t.mutex);
+  std::vector<ScopeStats> result;
+  for (size_t i = 0; i < t.nodes.size(); i++) {
+    if (t.nodes[i].stats.empty()) {
+      continue;
+    }
+    const std::string path = t.pathOf(static_cast<int64_t>(i));
+    for (const auto& entry : t.nodes[i].stats) {
+      result.push_back(ScopeStats{
+          path,
+          entry.first,
+          entry.second.live_bytes,
+          entry.second.peak_bytes,
+          entry.second.alloc_count});
+    }
+  }
+  return result;
+}
+
+std::string flameReport(bool peak_bytes) {
+  std::ostringstream out;
+  for (const auto& scope : snapshot()) {
+    const int64_t value = peak_bytes ? scope.peak_bytes : scope.live_bytes;
+    if (value == 0) {
+      continue;
+    }
+    out << DeviceTypeName(scope.device, /*lower_case=*/true) << ';'
+        << scope.path << ' ' << value << '\n';
+  }
+  return out.str();
+}
+
+} // namespace allocation_tracker
+} // namespace c10
@@ -1,4 +1,5 @@
 #include <c10/core/CPUAllocator.h>
+#include <c10/core/AllocationTracker.h>
 #include <c10/util/typeid.h>
 #include <c10/core/DeviceType.h>
 
@@ -107,6 +108,10 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
       getMemoryAllocationReporter().New(data, nbytes);
       return {data, data, &ReportAndDelete, at::Device(at::DeviceType::CPU)};
     }
+    if (allocation_tracker::enabled() && nbytes > 0) {
+      allocation_tracker::recordAlloc(DeviceType::CPU, data, nbytes);
+      return {data, data, &TrackAndDelete, at::Device(at::DeviceType::CPU)};
+    }
     return {data, data, &free_cpu, at::Device(at::DeviceType::CPU)};
   }
 
@@ -118,10 +123,21 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
     free_cpu(ptr);
   }
 
+  static void TrackAndDelete(void* ptr) {
+    if (!ptr) {
+      return;
+    }
+    allocation_tracker::recordFree(ptr);
+    free_cpu(ptr);
+  }
+
   at::DeleterFnPtr raw_deleter() const override {
     if (FLAGS_caffe2_report_cpu_memory_usage) {
       return &ReportAndDelete;
     }
+    if (allocation_tracker::enabled()) {
+      return &TrackAndDelete;
+    }
     return &free_cpu;
   }
 
@@ -0,0 +1,358 @@
+#include <c10/core/CachingCPUAllocator.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/Flags.h>
+#include <c10/util/numa.h>
+
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+C10_DEFINE_int(
+    caffe2_cpu_caching_allocator_decay_ms,
+    10000,
+    "Idle cached CPU blocks older than this many milliseconds are returned "
+    "to the system; zero or negative disables decay");
+
+namespace c10 {
+
+namespace {
+
+// Minimum size class. Requests below this all share one free list, so tiny
+// metadata allocations do not fragment the cache.
+constexpr size_t kMinBlockSize = 4096;
+
+// Default cap on idle cached bytes when EnableCachingCPUAllocator is called
+// without an explicit limit.
+constexpr size_t kDefaultMaxCachedBytes = 1073741824; // 1 GiB
+
+// Size classes at or above this are backed by anonymous mappings and
+// advised onto transparent huge pages.
+constexpr size_t kHugeBlockSize = 2097152; // 2 MiB
+
+// Per-thread ring bounds: a handful of blocks, capped in bytes so one
+// thread cannot park the whole cache budget in its ring.
+constexpr size_t kThreadCacheSlots = 8;
+constexpr size_t kThreadCacheMaxBytes = 67108864; // 64 MiB
+
+// Round a request up to its size class: kMinBlockSize for small requests,
+// the next power of two otherwise. Successive batches whose sizes jitter
+// slightly therefore land in the same free list.
+size_t roundSize(size_t nbytes) {
+  size_t size = kMinBlockSize;
+  while (size < nbytes) {
+    size *= 2;
+  }
+  return size;
+}
+
+// Arena key for the calling thread: its current NUMA node (so recycled
+// blocks stay local to the socket that last touched them), or -1 when NUMA
+// is not available.
+int currentNode() {
+  return IsNUMAEnabled() ? GetCurrentNUMANode() : -1;
+}
+
+bool decayEnabled() {
+  return FLAGS_caffe2_cpu_caching_allocator_decay_ms > 0;
+}
+
+std::chrono::steady_clock::duration decayWindow() {
+  return std::chrono::milliseconds(
+      FLAGS_caffe2_cpu_caching_allocator_decay_ms);
+}
+
+#ifndef _WIN32
+
+struct HugeBlock {
+  void* addr;
+  size_t size;
+};
+
+void deleteHugeBlock(void* ctx) {
+  auto* block = static_cast<HugeBlock*>(ctx);
+  munmap(block->addr, block->size);
+  delete block;
+}
+
+// mmap so the block is page-aligned (the base allocator's 64-byte
+// alignment cannot be madvise'd) and ask for transparent huge pages.
+// Both the mapping and the advice are best effort; failure falls back to
+// the base allocator.
+at::DataPtr allocHugeBlock(size_t size) {
+  void* addr = mmap(
+      nullptr,
+      size,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      /*fd=*/-1,
+      /*offset=*/0);
+  if (addr == MAP_FAILED) {
+    return at::DataPtr();
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(addr, size, MADV_HUGEPAGE);
+#endif
+  return {
+      addr,
+      new HugeBlock{addr, size},
+      &deleteHugeBlock,
+      at::Device(at::DeviceType::CPU)};
+}
+
+#endif // !_WIN32
+
+} // namespace
+
+// Heap-allocated per-allocation context. Owns the DataPtr handed out by the
+// base allocator so that dropping a block (cap exceeded, decay, emptyCache)
+// runs the underlying deleter.
+struct CachingCPUAllocator::Context {
+  const CachingCPUAllocator* pool;
+  int node;
+  size_t size;
+  at::DataPtr base_ptr;
+};
+
+// The lock-free first tier: a small ring of blocks this thread recently
+// freed. Eager inference threads free and reallocate the same handful of
+// intermediate sizes every step, so most requests are served here without
+// touching the shared mutex. At namespace scope (befriended by the
+// allocator) rather than in the anonymous namespace.
+struct ThreadCache {
+  struct Entry {
+    int node;
+    size_t size;
+    at::DataPtr ptr;
+    std::chrono::steady_clock::time_point freed;
+  };
+
+  const CachingCPUAllocator* owner = nullptr;
+  size_t bytes = 0;
+  std::vector<Entry> entries;
+
+  at::DataPtr take(const CachingCPUAllocator* pool, int node, size_t size) {
+    if (owner != pool) {
+      return at::DataPtr();
+    }
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (entries[i].size == size && entries[i].node == node) {
+        at::DataPtr ptr = std::move(entries[i].ptr);
+        bytes -= size;
+        entries.erase(entries.begin() + i);
+        return ptr;
+      }
+    }
+    return at::DataPtr();
+  }
+
+  // Returns false when the ring cannot take the block (full, or it was
+  // allocated by a different pool); the caller stashes it shared.
+  bool put(
+      const CachingCPUAllocator* pool,
+      int node,
+      size_t size,
+      at::DataPtr& ptr,
+      std::chrono::steady_clock::time_point now) {
+    if (owner == nullptr) {
+      owner = pool;
+    }
+    if (owner != pool) {
+      return false;
+    }
+    expire(now);
+    if (entries.size() >= kThreadCacheSlots ||
+        bytes + size > kThreadCacheMaxBytes) {
+      return false;
+    }
+    entries.push_back(Entry{node, size, std::move(ptr), now});
+    bytes += size;
+    return true;
+  }
+
+  // Hands entries idle past the decay window to the shared lists, where
+  // the shared trim decides their fate.
+  void expire(std::chrono::steady_clock::time_point now) {
+    if (!decayEnabled() || owner == nullptr) {
+      return;
+    }
+    const auto window = decayWindow();
+    for (size_t i = 0; i < entries.size();) {
+      if (now - entries[i].freed > window) {
+        bytes -= entries[i].size;
+        owner->stashShared(
+            entries[i].node, entries[i].size, std::move(entries[i].ptr), now);
+        entries.erase(entries.begin() + i);
+      } else {
+        i++;
+      }
+    }
+  }
+
+  ~ThreadCache() {
+    // The process-wide allocator installed by EnableCachingCPUAllocator is
+    // never destroyed, so handing blocks back at thread exit is safe.
+    for (auto& entry : entries) {
+      owner->stashShared(
+          entry.node,
+          entry.size,
+          std::move(entry.ptr),
+          std::chrono::steady_clock::now());
+    }
+  }
+};
+
+namespace {
+thread_local ThreadCache thread_cache;
+} // namespace
+
+CachingCPUAllocator::CachingCPUAllocator(
+    at::Allocator* base,
+    size_t max_cached_bytes)
+    : base_(base), max_cached_bytes_(max_cached_bytes) {
+  AT_ASSERT(base_ != nullptr);
+}
+
+CachingCPUAllocator::~CachingCPUAllocator() {
+  emptyCache();
+}
+
+at::DataPtr CachingCPUAllocator::allocate(size_t nbytes) const {
+  if (nbytes == 0) {
+    return base_->allocate(0);
+  }
+  const size_t size = roundSize(nbytes);
+  const int node = currentNode();
+  at::DataPtr base_ptr = thread_cache.take(this, node, size);
+  if (!base_ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = free_lists_.find({node, size});
+    if (it != free_lists_.end() && !it->second.empty()) {
+      base_ptr = std::move(it->second.back().ptr);
+      it->second.pop_back();
+      cached_bytes_ -= size;
+    }
+  }
+#ifndef _WIN32
+  if (!base_ptr && size >= kHugeBlockSize) {
+    base_ptr = allocHugeBlock(size);
+  }
+#endif
+  if (!base_ptr) {
+    // The base allocator places fresh blocks on the calling thread's node
+    // (see NUMAMove in alloc_cpu), so the block starts out local as well.
+    base_ptr = base_->allocate(size);
+  }
+  void* data = base_ptr.get();
+  auto device = base_ptr.device();
+  auto* ctx = new Context{this, node, size, std::move(base_ptr)};
+  return {data, ctx, &returnToCache, device};
+}
+
+void CachingCPUAllocator::returnToCache(void* ctx) {
+  if (!ctx) {
+    return;
+  }
+  auto* context = static_cast<Context*>(ctx);
+  context->pool->free(context);
+}
+
+void CachingCPUAllocator::free(Context* ctx) const {
+  const auto now = std::chrono::steady_clock::now();
+  if (!thread_cache.put(this, ctx->node, ctx->size, ctx->base_ptr, now)) {
+    stashShared(ctx->node, ctx->size, std::move(ctx->base_ptr), now);
+  }
+  delete ctx;
+}
+
+void CachingCPUAllocator::stashShared(
+    int node,
+    size_t size,
+    at::DataPtr ptr,
+    std::chrono::steady_clock::time_point now) const {
+  std::vector<at::DataPtr> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    trimLocked(now, dropped);
+    if (cached_bytes_ + size <= max_cached_bytes_) {
+      // Return the block to the arena of the node it was allocated on, not
+      // the node of the freeing thread: the pages still live there.
+      free_lists_[{node, size}].push_back(CachedBlock{std::move(ptr), now});
+      cached_bytes_ += size;
+    }
+  }
+  // If the cache was full, `ptr` still owns the block here, and trimmed
+  // blocks sit in `dropped`; both release outside the lock.
+}
+
+void CachingCPUAllocator::trimLocked(
+    std::chrono::steady_clock::time_point now,
+    std::vector<at::DataPtr>& dropped) const {
+  if (!decayEnabled()) {
+    return;
+  }
+  const auto window = decayWindow();
+  // Amortize: a full sweep at most every quarter window.
+  if (now - last_trim_ < window / 4) {
+    return;
+  }
+  last_trim_ = now;
+  for (auto& entry : free_lists_) {
+    auto& blocks = entry.second;
+    for (size_t i = 0; i < blocks.size();) {
+      if (now - blocks[i].freed > window) {
+        dropped.push_back(std::move(blocks[i].ptr));
+        cached_bytes_ -= entry.first.second;
+        // Order within a free list does not matter.
+        blocks[i] = std::move(blocks.back());
+        blocks.pop_back();
+      } else {
+        i++;
+      }
+    }
+  }
+}
+
+at::DeleterFnPtr CachingCPUAllocator::raw_deleter() const {
+  // Raw allocations carry no context to route them back to the free lists,
+  // so they bypass the cache and go straight through the base allocator.
+  return base_->raw_deleter();
+}
+
+void CachingCPUAllocator::emptyCache() {
+  std::map<std::pair<int, size_t>, std::vector<CachedBlock>> to_free;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    to_free.swap(free_lists_);
+    cached_bytes_ = 0;
+  }
+  // Blocks are released when to_free goes out of scope, outside the lock.
+}
+
+size_t CachingCPUAllocator::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cached_bytes_;
+}
+
+void EnableCachingCPUAllocator(size_t max_cached_bytes) {
+  static std::mutex enable_mutex;
+  static bool enabled = false;
+  std::lock_guard<std::mutex> lock(enable_mutex);
+  if (enabled) {
+    return;
+  }
+  if (max_cached_bytes == 0) {
+    max_cached_bytes = kDefaultMaxCachedBytes;
+  }
+  // SetCPUAllocator takes ownership; the wrapped base allocator has static
+  // lifetime, so holding on to it inside the wrapper is safe.
+  SetCPUAllocator(new CachingCPUAllocator(GetCPUAllocator(), max_cached_bytes));
+  enabled = true;
+}
+
+} // namespace c10
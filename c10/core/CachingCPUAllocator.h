@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <c10/core/Allocator.h>
+#include <c10/core/CPUAllocator.h>
+
+namespace c10 {
+
+// A recycling allocator that sits in front of another allocator and keeps
+// freed blocks around for reuse instead of returning them immediately.
+//
+// This is aimed at workloads that allocate similarly-sized host buffers in a
+// steady rhythm -- data loading, and eager inference where every op frees
+// its intermediates back to malloc between steps. With the default allocator
+// each step pays for page faults on first touch (and for glibc arena churn
+// under many threads); with this cache the second and later steps are served
+// from the free lists.
+//
+// Requests are rounded up to a small set of size classes so that slightly
+// varying batch sizes still hit the cache. Reuse happens in two tiers: each
+// thread first consults a small thread-local ring of blocks it recently
+// freed -- no lock, which is what matters under tens of eager inference
+// threads -- and falls back to shared per-(NUMA node, size class) free
+// lists under a mutex. Large size classes are backed by anonymous mappings
+// advised MADV_HUGEPAGE, so steadily recycled big blocks sit on transparent
+// huge pages instead of faulting 4K at a time.
+//
+// The total number of idle cached bytes is capped; blocks freed beyond the
+// cap go back to the base allocator. Idle blocks also decay: any block
+// unused for caffe2_cpu_caching_allocator_decay_ms is returned to the
+// system, so a one-off burst does not pin its high-water mark as RSS.
+class C10_API CachingCPUAllocator final : public at::Allocator {
+ public:
+  // The caller retains ownership of `base`, which must outlive this
+  // allocator. `max_cached_bytes` bounds idle memory held in the cache.
+  explicit CachingCPUAllocator(at::Allocator* base, size_t max_cached_bytes);
+  ~CachingCPUAllocator() override;
+
+  at::DataPtr allocate(size_t nbytes) const override;
+  at::DeleterFnPtr raw_deleter() const override;
+
+  // Returns all idle blocks in the shared free lists to the base
+  // allocator. Blocks parked in other threads' rings drain via decay.
+  void emptyCache();
+
+  // Number of idle bytes currently held in the shared free lists.
+  size_t cachedBytes() const;
+
+ private:
+  struct Context;
+  friend struct ThreadCache;
+  struct CachedBlock {
+    at::DataPtr ptr;
+    std::chrono::steady_clock::time_point freed;
+  };
+
+  static void returnToCache(void* ctx);
+  void free(Context* ctx) const;
+  // Parks a block in the shared free lists (or drops it when over the
+  // cap) and opportunistically trims decayed blocks.
+  void stashShared(
+      int node,
+      size_t size,
+      at::DataPtr ptr,
+      std::chrono::steady_clock::time_point now) const;
+  // Caller holds mutex_; moves blocks idle past the decay window into
+  // `dropped` so they are released outside the lock.
+  void trimLocked(
+      std::chrono::steady_clock::time_point now,
+      std::vector<at::DataPtr>& dropped) const;
+
+  at::Allocator* base_;
+  size_t max_cached_bytes_;
+
+  mutable std::mutex mutex_;
+  mutable size_t cached_bytes_ = 0;
+  mutable std::chrono::steady_clock::time_point last_trim_;
+  // (NUMA node, size class) -> idle blocks of exactly that (rounded) size.
+  // Keeping one arena per node means a block recycled by a thread pinned to
+  // node 1 is never handed to a thread on node 0, where every access would
+  // cross the socket interconnect. Node is -1 when NUMA is unavailable.
+  mutable std::map<std::pair<int, size_t>, std::vector<CachedBlock>>
+      free_lists_;
+};
+
+// Installs a process-wide CachingCPUAllocator in front of the current CPU
+// allocator (see SetCPUAllocator). `max_cached_bytes` of zero picks a
+// default cap. Calling this more than once is a no-op.
+C10_API void EnableCachingCPUAllocator(size_t max_cached_bytes = 0);
+
+} // namespace c10
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <c10/util/ArrayRef.h>
+#include <c10/util/BFloat16.h>
 #include <c10/util/Half.h>
 #include <c10/util/Optional.h>
 #include <c10/util/typeid.h>
@@ -29,7 +30,8 @@ namespace c10 {
   _(std::complex<float>, ComplexFloat, z) /* 9 */    \
   _(std::complex<double>, ComplexDouble, z) /* 10 */ \
   _(bool, Bool, i) /* 11 */                          \
-  _(c10::qint8, QInt8, i) /* 12 */
+  _(c10::qint8, QInt8, i) /* 12 */                   \
+  _(at::BFloat16, BFloat16, d) /* 13 */
 
 // If you want to support ComplexHalf for real, replace occurrences
 // of this macro with AT_FORALL_SCALAR_TYPES_WITH_COMPLEX.  But
@@ -212,7 +214,7 @@ static inline bool isIntegralType(ScalarType t) {
 static inline bool isFloatingType(ScalarType t) {
   return (
       t == ScalarType::Double || t == ScalarType::Float ||
-      t == ScalarType::Half);
+      t == ScalarType::Half || t == ScalarType::BFloat16);
 }
 
 static inline bool isComplexType(ScalarType t) {
@@ -256,6 +258,17 @@ static inline ScalarType promoteTypes(ScalarType a, ScalarType b) {
         "promoteTypes with quantized numbers is not handled yet; figure out what the correct rules should be");
   }
 
+  // BFloat16 only promotes with itself for now; mixed bfloat16 arithmetic
+  // should go through explicit casts until the promotion rules are settled.
+  if (a == ScalarType::BFloat16 && b == ScalarType::BFloat16) {
+    return a;
+  }
+
+  if (a == ScalarType::BFloat16 || b == ScalarType::BFloat16) {
+    AT_ERROR(
+        "promoteTypes with bfloat16 is only supported when both operands are bfloat16");
+  }
+
   // this matrix has to be consistent with AT_FORALL_SCALAR_TYPES_WITH_COMPLEX
   // so that's why we have to add undefined as we are not sure what is the
   // corrent values for the type promotions in complex type cases.
@@ -0,0 +1,73 @@
+#include <c10/core/thread_budget.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+namespace c10 {
+namespace thread_budget {
+
+// Note [Cooperative thread budget]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Inter-op tasks (at::launch) and intra-op parallel regions size themselves
+// independently: every task that reaches a parallel op forks a full OpenMP
+// team, so 8 concurrent tasks on a 32-core box produce 256 runnable threads
+// and the machine thrashes. Deployments work around this by hand-tuning
+// OMP_NUM_THREADS per host, which is wrong whenever the task mix changes.
+//
+// With PYTORCH_THREAD_BUDGET=1, ThreadPool workers register each running
+// task in this ledger and parallel_for/parallel_reduce divide their
+// configured team size by the number of active tasks, so the total thread
+// count stays near the core count regardless of load. The split is
+// cooperative and instantaneous - a region sized while three tasks run
+// keeps its team even if two finish - but regions are short relative to
+// tasks, so the steady state is an even split.
+//
+// Only the OpenMP backend needs this: the taskpool backend
+// (ATEN_PARALLEL_BACKEND=taskpool) already runs all regions on one shared
+// pool, so concurrent tasks interleave there instead of multiplying teams.
+
+namespace {
+
+std::atomic<size_t> active_task_count{0};
+
+} // namespace
+
+bool enabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("PYTORCH_THREAD_BUDGET");
+    return env != nullptr && env[0] == '1';
+  }();
+  return enabled;
+}
+
+void task_started() {
+  active_task_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void task_finished() {
+  active_task_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+size_t active_tasks() {
+  return active_task_count.load(std::memory_order_relaxed);
+}
+
+size_t recommended_team_size(size_t configured) {
+  if (!enabled()) {
+    return configured;
+  }
+  const size_t tasks = active_tasks();
+  if (tasks <= 1) {
+    return configured;
+  }
+  // A region issued from outside the pool (tasks counts only pool workers)
+  // still scales down: it competes with those tasks for the same cores.
+  const size_t cores = std::thread::hardware_concurrency();
+  const size_t share = (cores > 0 ? cores : configured) / tasks;
+  const size_t budget = share > 0 ? share : 1;
+  return budget < configured ? budget : configured;
+}
+
+} // namespace thread_budget
+} // namespace c10
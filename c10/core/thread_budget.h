@@ -0,0 +1,46 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <cstddef>
+
+namespace c10 {
+namespace thread_budget {
+
+// Process-wide core reservation ledger shared by the inter-op and intra-op
+// thread pools; see Note [Cooperative thread budget] in thread_budget.cpp.
+// Enabled with PYTORCH_THREAD_BUDGET=1.
+
+C10_API bool enabled();
+
+// Registers/unregisters a running inter-op task with the ledger. Called by
+// ThreadPool::main_loop around task execution; cheap (relaxed atomics) and
+// unconditional, so the ledger is accurate if budgeting is enabled later.
+C10_API void task_started();
+C10_API void task_finished();
+
+// Number of inter-op tasks currently executing.
+C10_API size_t active_tasks();
+
+// The intra-op team size a parallel region should use: `configured` (the
+// value OpenMP would pick on its own) scaled down by the number of
+// concurrently active inter-op tasks, never below 1. When budgeting is
+// disabled, returns `configured` unchanged.
+C10_API size_t recommended_team_size(size_t configured);
+
+// RAII registration for a task's lifetime; exception-safe counterpart of
+// task_started()/task_finished().
+struct C10_API TaskGuard {
+  TaskGuard() {
+    task_started();
+  }
+  ~TaskGuard() {
+    task_finished();
+  }
+
+  TaskGuard(const TaskGuard&) = delete;
+  TaskGuard& operator=(const TaskGuard&) = delete;
+};
+
+} // namespace thread_budget
+} // namespace c10
@@ -1,5 +1,8 @@
+#include <c10/core/thread_budget.h>
 #include <c10/core/thread_pool.h>
 
+#include <cstdlib>
+
 namespace c10 {
 
 ThreadPool::ThreadPool(std::size_t pool_size, int numa_node_id)
@@ -92,8 +95,11 @@ void ThreadPool::main_loop(std::size_t index) {
 
       lock.unlock();
 
-      // Run the task.
+      // Run the task, registered with the core reservation ledger so
+      // intra-op regions it opens size themselves against the other
+      // running tasks; see Note [Cooperative thread budget].
       try {
+        thread_budget::TaskGuard guard;
         if (tasks.run_with_id) {
           tasks.with_id(index);
         } else {
@@ -121,16 +127,46 @@ void ThreadPool::main_loop(std::size_t index) {
 }
 
 // constexpr initialization guaranteed to be before any static initialization
-std::atomic<int> num_threads{1};
+// 0 means "unset": size the pool when it is first needed, see below
+std::atomic<int> num_threads{0};
 void setNumThreads(size_t v) {
   if(-1  == num_threads.exchange(v)) {
    throw std::runtime_error("Error: cannot set num threads after pool has started");
   }
 }
 
+namespace {
+
+// The global work queue runs the inter-op work: forked TorchScript
+// functions and resumed interpreter continuations. Those tasks never block
+// a worker (waits suspend and requeue through future callbacks), so the
+// pool size caps how many forks actually overlap. Unless overridden by
+// setNumThreads or PYTORCH_INTEROP_THREADS, size it to the hardware so
+// prim::fork expresses real parallelism out of the box.
+size_t defaultNumInteropThreads() {
+  const char* env = std::getenv("PYTORCH_INTEROP_THREADS");
+  if (env != nullptr) {
+    const int value = std::atoi(env);
+    if (value > 0) {
+      return value;
+    }
+  }
+  const auto hardware = std::thread::hardware_concurrency();
+  return hardware > 0 ? hardware : 1;
+}
+
+} // namespace
+
 TaskThreadPoolBase& global_work_queue() {
-  static std::shared_ptr<TaskThreadPoolBase> pool =
-      ThreadPoolRegistry()->Create("C10", 0, num_threads.exchange(-1), false);
+  static std::shared_ptr<TaskThreadPoolBase> pool = ThreadPoolRegistry()->Create(
+      "C10",
+      0,
+      [] {
+        const int requested = num_threads.exchange(-1);
+        return requested > 0 ? requested
+                             : static_cast<int>(defaultNumInteropThreads());
+      }(),
+      false);
   return *pool;
 }
 
@@ -1,5 +1,6 @@
 #include <c10/cuda/CUDACachingAllocator.h>
 
+#include <c10/core/AllocationTracker.h>
 #include <c10/cuda/CUDAGuard.h>
 #include <c10/cuda/CUDAException.h>
 #include <c10/cuda/CUDAFunctions.h>
@@ -7,11 +8,17 @@
 
 #include <cuda_runtime_api.h>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <deque>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -62,6 +69,68 @@ constexpr size_t kSmallBuffer = 2097152;    // "small" allocations are packed in
 constexpr size_t kLargeBuffer = 20971520;   // "large" allocations may be packed in 20 MiB blocks
 constexpr size_t kMinLargeAlloc = 10485760; // allocations between 1 and 10 MiB may use kLargeBuffer
 constexpr size_t kRoundLarge = 2097152;     // round up large allocs to 2 MiB
+constexpr size_t kEventBatchBlocks = 64;    // freed blocks sharing one event; see
+                                            // Note [Stream-ordered frees]
+
+// Note [Managed memory mode]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With PYTORCH_CUDA_MANAGED_MEMORY=1, device blocks are obtained with
+// cudaMallocManaged instead of cudaMalloc. Managed allocations can
+// exceed the physical device memory: the driver pages data between host
+// and device on demand, evicting least-recently-used pages, so a model
+// slightly larger than the card still runs instead of failing with OOM
+// -- at the cost of page faults on first touch of non-resident data.
+// Everything else about the allocator (caching, splitting, stream
+// bookkeeping, cudaFree on release) is unchanged; managed pointers are
+// freed with cudaFree like ordinary device pointers.
+//
+// Demand paging alone leaves performance on the table, so residency
+// hints are exposed alongside the mode: prefetchAsync enqueues
+// migration of a range ahead of use on a stream (cudaMemPrefetchAsync),
+// and adviseReadMostly marks ranges that are read and rarely written --
+// weights, typically -- so the driver keeps a read-duplicated copy on
+// every accessing processor instead of bouncing pages
+// (cudaMemAdviseSetReadMostly). Both are no-ops unless the mode is
+// enabled, so call sites need no guards. The JIT can insert prefetches
+// automatically ahead of a graph's execution order; see
+// PYTORCH_JIT_MANAGED_PREFETCH in torch/csrc/jit/graph_executor.cpp.
+static bool managed_memory_enabled() {
+  static const bool enabled = []() -> bool {
+    const char* env = getenv("PYTORCH_CUDA_MANAGED_MEMORY");
+    return env != nullptr && strtol(env, nullptr, 10) > 0;
+  }();
+  return enabled;
+}
+
+static cudaError_t alloc_device_memory(void** devPtr, size_t size) {
+  // See Note [Managed memory mode]
+  if (managed_memory_enabled()) {
+    return cudaMallocManaged(devPtr, size, cudaMemAttachGlobal);
+  }
+  return cudaMalloc(devPtr, size);
+}
+
+// Blocks at least this large are never split when
+// PYTORCH_CUDA_MAX_SPLIT_SIZE_MB is set; see Note [Large block mode] below.
+static size_t max_split_size() {
+  static size_t size = []() -> size_t {
+    const char* env = getenv("PYTORCH_CUDA_MAX_SPLIT_SIZE_MB");
+    if (!env) {
+      return std::numeric_limits<size_t>::max();
+    }
+    size_t mb = strtoul(env, nullptr, 10);
+    if (mb == 0) {
+      return std::numeric_limits<size_t>::max();
+    }
+    return mb * 1024 * 1024;
+  }();
+  return size;
+}
+
+struct StreamStats {
+  uint64_t amount_allocated = 0;      // amount allocated on this stream in bytes
+  uint64_t max_amount_allocated = 0;  // max amount allocated on this stream in bytes
+};
 
 struct DeviceStats {
   uint64_t   amount_allocated;      // total amount allocated in bytes
@@ -69,17 +138,26 @@ struct DeviceStats {
   uint64_t   amount_cached;         // total amount in cache in bytes
   uint64_t   max_amount_cached;     // max total amount in cache in bytes
 
+  // Per-stream breakdown of amount_allocated. Useful for multi-stream
+  // workloads, where a single device-wide number can't tell which stream's
+  // allocations are responsible for memory growth.
+  std::unordered_map<cudaStream_t, StreamStats> stream_stats;
+
   DeviceStats() :
       amount_allocated(0), max_amount_allocated(0),
       amount_cached(0), max_amount_cached(0) { }
 
-  void increaseAllocated(size_t delta) {
+  void increaseAllocated(size_t delta, cudaStream_t stream) {
     amount_allocated += delta;
     max_amount_allocated = std::max(max_amount_allocated, amount_allocated);
+    auto& ss = stream_stats[stream];
+    ss.amount_allocated += delta;
+    ss.max_amount_allocated = std::max(ss.max_amount_allocated, ss.amount_allocated);
   }
 
-  void decreaseAllocated(size_t delta) {
+  void decreaseAllocated(size_t delta, cudaStream_t stream) {
     amount_allocated -= delta;
+    stream_stats[stream].amount_allocated -= delta;
   }
 
   void increaseCached(size_t delta) {
@@ -107,15 +185,43 @@ struct Block {
   Block*        prev;        // prev block if split from a larger allocation
   Block*        next;        // next block if split from a larger allocation
   int           event_count; // number of outstanding CUDA events
+  uint64_t      gen;         // cache generation at last insertion into a pool;
+                             // used by the idle trim thread to spot cold blocks
 
   Block(int device, cudaStream_t stream, size_t size, BlockPool* pool, void* ptr) :
     device(device), stream(stream), stream_uses(), size(size), pool(pool),
-    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    gen(0) { }
 
   // constructor for search key
   Block(int device, cudaStream_t stream, size_t size) :
     device(device), stream(stream), stream_uses(), size(size), pool(nullptr),
-    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    gen(0) { }
+};
+
+// Note [Stream-ordered frees]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Frees are stream-ordered by construction: a block freed on its allocation
+// stream goes straight back to that stream's pool and is reusable by
+// subsequent work on the same stream with no synchronization at all, because
+// any later kernel on the stream is ordered after the work that used the
+// block. Only blocks handed to another stream via recordStream() need a
+// fence before reuse.
+//
+// Those fences used to be one CUDA event per block per recorded stream,
+// which is measurable at high launch rates with many short-lived
+// cross-stream temporaries. Instead, freed blocks now share events: each
+// stream with pending cross-stream frees keeps one open EventBatch, every
+// such free re-records the batch's event on the stream (pushing the shared
+// fence past the latest free, which is conservative for the earlier blocks
+// in the batch) and appends the block. A batch is closed once it covers
+// kEventBatchBlocks blocks or its event is observed complete, so the event
+// create/record/destroy cost is amortized over the whole batch.
+struct EventBatch {
+  cudaEvent_t event;
+  int device;                 // device of the recording stream
+  std::vector<Block*> blocks; // blocks fenced by `event`
 };
 
 static bool BlockComparator(const Block* a, const Block* b)
@@ -151,6 +257,26 @@ static std::string format_size(uint64_t size) {
   return os.str();
 }
 
+// Total global memory per device, queried once and cached. Returns 0 if the
+// query fails, in which case pressure watermarks are simply never crossed.
+static uint64_t device_capacity(int device) {
+  static std::mutex capacity_mutex;
+  static std::vector<uint64_t> capacities;
+  std::lock_guard<std::mutex> lock(capacity_mutex);
+  if ((size_t)device >= capacities.size()) {
+    capacities.resize(device + 1, 0);
+  }
+  if (capacities[device] == 0) {
+    cudaDeviceProp prop;
+    if (cudaGetDeviceProperties(&prop, device) == cudaSuccess) {
+      capacities[device] = prop.totalGlobalMem;
+    } else {
+      cudaGetLastError();  // clear CUDA error
+    }
+  }
+  return capacities[device];
+}
+
 } // namespace
 
 struct THCCachingAllocator
@@ -173,8 +299,46 @@ struct THCCachingAllocator
   // allocated blocks by device pointer
   std::unordered_map<void*, Block*> allocated_blocks;
 
-  // outstanding cuda events
-  std::deque<std::pair<cudaEvent_t, Block*>> cuda_events;
+  // closed event batches awaiting completion, oldest first; see
+  // Note [Stream-ordered frees]
+  std::deque<EventBatch> cuda_events;
+
+  // one open batch per stream still accepting cross-stream frees
+  std::unordered_map<cudaStream_t, EventBatch> open_batches;
+
+  // Note [Memory pressure callbacks]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // By the time the OOM recovery path in cuda_malloc_retry runs, the damage
+  // is done: the allocating stream stalls while cached blocks are returned
+  // to the driver, and if that is not enough the program dies. Serving
+  // systems would rather act earlier - shed batch size, flush their own
+  // caches - while there is still headroom. Two mechanisms support that:
+  //
+  // 1. Pressure watchers. attachMemoryPressureCallback registers a callback
+  //    with a utilization watermark; when an allocation pushes
+  //    amount_allocated / device capacity across the watermark, the callback
+  //    fires once and stays disarmed until utilization drops back below it.
+  //    Crossings are detected under the allocator lock, but the callbacks
+  //    themselves run after it is released (see malloc below) so they are
+  //    free to release memory or call emptyCache.
+  //
+  // 2. Idle trimming. Every pool insertion stamps the block with the current
+  //    cache generation, which advances on every malloc. When enabled via
+  //    setIdleTrimInterval, a detached background thread wakes on that
+  //    period and returns non-split cached blocks to the driver if they
+  //    have not been touched for at least one full interval, so steady-state
+  //    idle processes shrink without paying the cost on the allocation path.
+  struct PressureWatcher {
+    uint64_t id;
+    double watermark;
+    MemoryPressureCallback callback;
+    std::unordered_set<int> above;  // devices currently over the watermark
+  };
+  std::vector<PressureWatcher> pressure_watchers;
+  uint64_t next_pressure_id = 1;
+
+  // advances on every malloc; see Note [Memory pressure callbacks]
+  uint64_t cache_generation = 0;
 
   THCCachingAllocator() :
       large_blocks(BlockComparator),
@@ -190,6 +354,26 @@ struct THCCachingAllocator
 
   /** allocates a block which is safe to use from the provided stream */
   void malloc(void** devPtr, size_t size, cudaStream_t stream)
+  {
+    std::vector<std::function<void()>> pressure_events;
+    malloc_impl(devPtr, size, stream, pressure_events);
+    if (allocation_tracker::enabled()) {
+      // Attribute the requested size; the rounded block size is an
+      // allocator detail the per-op report should not depend on.
+      allocation_tracker::recordAlloc(DeviceType::CUDA, *devPtr, size);
+    }
+    // Fired only after the allocator lock has been released, so callbacks
+    // may allocate, free, or call emptyCache without deadlocking.
+    for (auto& fire : pressure_events) {
+      fire();
+    }
+  }
+
+  void malloc_impl(
+      void** devPtr,
+      size_t size,
+      cudaStream_t stream,
+      std::vector<std::function<void()>>& pressure_events)
   {
     std::lock_guard<std::recursive_mutex> lock(mutex);
 
@@ -211,6 +395,16 @@ struct THCCachingAllocator
       if (it != pool.end() && (*it)->device == device &&
           (*it)->stream == stream) {
         Block* block = *it;
+        // Note [Large block mode]
+        // When a split-size cap is configured, blocks at or above the cap
+        // stay unsplit and are reserved for requests of comparable size.
+        // Handing such a block to a much smaller request would pin the whole
+        // block and recreate exactly the fragmentation the cap is meant to
+        // avoid, so prefer a fresh cudaMalloc instead.
+        if (block->size >= max_split_size() && size < max_split_size() &&
+            block->size - size > kLargeBuffer) {
+          return nullptr;
+        }
         pool.erase(it);
         return block;
       }
@@ -297,11 +491,15 @@ struct THCCachingAllocator
 
     *devPtr = block->ptr;
 
-    stats.increaseAllocated(block->size);
+    stats.increaseAllocated(block->size, stream);
+
+    cache_generation++;
+    collect_pressure_events(device, stats, pressure_events);
   }
 
   void free(void* ptr)
   {
+    allocation_tracker::recordFree(ptr);
     std::lock_guard<std::recursive_mutex> lock(mutex);
     if (!ptr) {
       return;
@@ -316,7 +514,9 @@ struct THCCachingAllocator
     allocated_blocks.erase(it);
     block->allocated = false;
 
-    get_stats_for_device(block->device).decreaseAllocated(block->size);
+    DeviceStats& stats = get_stats_for_device(block->device);
+    stats.decreaseAllocated(block->size, block->stream);
+    rearm_pressure_watchers(block->device, stats);
     if (!block->stream_uses.empty()) {
       insert_events(block);
     } else {
@@ -398,9 +598,89 @@ struct THCCachingAllocator
     auto& pool = *block->pool;
     try_merge_blocks(block, block->prev, pool);
     try_merge_blocks(block, block->next, pool);
+    block->gen = cache_generation;
     pool.insert(block);
   }
 
+  // See Note [Memory pressure callbacks]. Called with `mutex` held; the
+  // events it collects are invoked by malloc once the lock is dropped.
+  void collect_pressure_events(
+      int device,
+      const DeviceStats& stats,
+      std::vector<std::function<void()>>& pressure_events)
+  {
+    if (pressure_watchers.empty()) {
+      return;
+    }
+    const uint64_t capacity = device_capacity(device);
+    if (capacity == 0) {
+      return;
+    }
+    const double utilization =
+        static_cast<double>(stats.amount_allocated) / capacity;
+    for (auto& watcher : pressure_watchers) {
+      const bool above = utilization >= watcher.watermark;
+      const bool was_above = watcher.above.count(device) > 0;
+      if (above && !was_above) {
+        watcher.above.insert(device);
+        auto callback = watcher.callback;
+        const uint64_t allocated = stats.amount_allocated;
+        pressure_events.emplace_back([callback, device, allocated, capacity]() {
+          callback(device, allocated, capacity);
+        });
+      } else if (!above && was_above) {
+        watcher.above.erase(device);
+      }
+    }
+  }
+
+  // Re-arms watchers whose watermark the device has dropped back below.
+  // Fires nothing; downward crossings are not reported.
+  void rearm_pressure_watchers(int device, const DeviceStats& stats)
+  {
+    if (pressure_watchers.empty()) {
+      return;
+    }
+    const uint64_t capacity = device_capacity(device);
+    if (capacity == 0) {
+      return;
+    }
+    const double utilization =
+        static_cast<double>(stats.amount_allocated) / capacity;
+    for (auto& watcher : pressure_watchers) {
+      if (utilization < watcher.watermark) {
+        watcher.above.erase(device);
+      }
+    }
+  }
+
+  /** returns non-split cached blocks older than `horizon` to the driver;
+      returns the current cache generation for the trim thread's next sweep */
+  uint64_t trim_cold_blocks(uint64_t horizon)
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    trim_pool(large_blocks, horizon);
+    trim_pool(small_blocks, horizon);
+    return cache_generation;
+  }
+
+  void trim_pool(BlockPool& blocks, uint64_t horizon)
+  {
+    std::lock_guard<std::mutex> lock(cuda_free_mutex);
+    auto it = blocks.begin();
+    while (it != blocks.end()) {
+      Block* block = *it;
+      if (!block->prev && !block->next && block->gen <= horizon) {
+        C10_CUDA_CHECK(cudaFree((void*)block->ptr));
+        get_stats_for_device(block->device).decreaseCached(block->size);
+        it = blocks.erase(it);
+        delete block;
+      } else {
+        ++it;
+      }
+    }
+  }
+
   /** combine previously split blocks */
   void try_merge_blocks(Block* dst, Block* src, BlockPool& pool)
   {
@@ -437,6 +717,10 @@ struct THCCachingAllocator
     if (block->pool == &small_blocks) {
       return remaining >= kMinBlockSize;
     } else if (block->pool == &large_blocks) {
+      // See Note [Large block mode]
+      if (block->size >= max_split_size()) {
+        return false;
+      }
       return remaining > kSmallSize;
     } else {
       AT_ERROR("should_split: invalid pool");
@@ -463,13 +747,13 @@ struct THCCachingAllocator
 
   cudaError_t cuda_malloc_retry(int device, void** devPtr, size_t size)
   {
-    // Try cudaMalloc. If cudaMalloc fails, frees all non-split cached blocks
-    // and retries.
-    cudaError_t err = cudaMalloc(devPtr, size);
+    // Try cudaMalloc (or cudaMallocManaged; see Note [Managed memory
+    // mode]). If it fails, frees all non-split cached blocks and retries.
+    cudaError_t err = alloc_device_memory(devPtr, size);
     if (err != cudaSuccess) {
       cudaGetLastError();  // reset the last CUDA error
       free_cached_blocks(device);
-      err = cudaMalloc(devPtr, size);
+      err = alloc_device_memory(devPtr, size);
       if (err != cudaSuccess) {
         return err;
       }
@@ -517,29 +801,42 @@ struct THCCachingAllocator
   }
 
   void synchronize_and_free_events(optional<int> device) {
-    // Synchronize on outstanding events and then free associated blocks.
-    // Limited to blocks on the given device if specified.
+    // Synchronize on outstanding event batches and free their blocks.
+    // Limited to batches holding at least one block on the given device if
+    // specified; a synchronized event covers the whole batch, so every
+    // block in a matching batch is safe to free regardless of its device.
+    auto batch_matches = [&](const EventBatch& batch) {
+      if (!device.has_value()) {
+        return true;
+      }
+      for (Block* block : batch.blocks) {
+        if (block->device == *device) {
+          return true;
+        }
+      }
+      return false;
+    };
 
     auto remaining_events = decltype(cuda_events)();
-
-    for (auto& e : cuda_events) {
-      cudaEvent_t event = e.first;
-      Block* block = e.second;
-      if (device.has_value() && block->device != *device) {
-        remaining_events.push_back(e);
+    for (auto& batch : cuda_events) {
+      if (!batch_matches(batch)) {
+        remaining_events.push_back(std::move(batch));
         continue;
       }
+      C10_CUDA_CHECK(cudaEventSynchronize(batch.event));
+      retire_batch(batch);
+    }
+    std::swap(cuda_events, remaining_events);
 
-      C10_CUDA_CHECK(cudaEventSynchronize(event));
-      C10_CUDA_CHECK(cudaEventDestroy(event));
-
-      block->event_count--;
-      if (block->event_count == 0) {
-        free_block(block);
+    for (auto it = open_batches.begin(); it != open_batches.end();) {
+      if (!batch_matches(it->second)) {
+        ++it;
+        continue;
       }
+      C10_CUDA_CHECK(cudaEventSynchronize(it->second.event));
+      retire_batch(it->second);
+      it = open_batches.erase(it);
     }
-
-    std::swap(cuda_events, remaining_events);
   }
 
   Block* find_allocated_block(void *ptr) {
@@ -550,6 +847,8 @@ struct THCCachingAllocator
     return it->second;
   }
 
+  // See Note [Stream-ordered frees]: each used stream charges the block to
+  // its open batch instead of creating a per-block event.
   void insert_events(Block* block)
   {
     int prev_device;
@@ -560,30 +859,50 @@ struct THCCachingAllocator
     for (auto it = streams.begin(); it != streams.end(); ++it) {
       C10_CUDA_CHECK(cudaSetDevice(it->device_index()));
 
-      cudaEvent_t event;
-      C10_CUDA_CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
-      C10_CUDA_CHECK(cudaEventRecord(event, it->stream()));
-
+      auto batch_it = open_batches.find(it->stream());
+      if (batch_it == open_batches.end()) {
+        EventBatch batch;
+        batch.device = it->device_index();
+        C10_CUDA_CHECK(
+            cudaEventCreateWithFlags(&batch.event, cudaEventDisableTiming));
+        batch_it = open_batches.emplace(it->stream(), std::move(batch)).first;
+      }
+      EventBatch& batch = batch_it->second;
+      // Re-recording pushes the shared fence past this free; the earlier
+      // blocks in the batch just wait a little longer, which is safe.
+      C10_CUDA_CHECK(cudaEventRecord(batch.event, it->stream()));
+      batch.blocks.push_back(block);
       block->event_count++;
-      cuda_events.emplace_back(event, block);
+      if (batch.blocks.size() >= kEventBatchBlocks) {
+        cuda_events.push_back(std::move(batch));
+        open_batches.erase(batch_it);
+      }
     }
 
     C10_CUDA_CHECK(cudaSetDevice(prev_device));
   }
 
+  // Destroys a completed (or synchronized) batch's event and frees every
+  // block whose last outstanding batch this was.
+  void retire_batch(EventBatch& batch)
+  {
+    C10_CUDA_CHECK(cudaEventDestroy(batch.event));
+    for (Block* block : batch.blocks) {
+      block->event_count--;
+      if (block->event_count == 0) {
+        free_block(block);
+      }
+    }
+  }
+
   void process_events()
   {
-    // Process outstanding cudaEvents. Events that are completed are removed
-    // from the queue, and the 'event_count' for the corresponding allocation
-    // is decremented. Stops at the first event which has not been completed.
-    // Since events on different devices or streams may occur out of order,
-    // the processing of some events may be delayed.
+    // Closed batches complete roughly in FIFO order; stop at the first that
+    // has not. Since batches on different devices or streams may complete
+    // out of order, the processing of some may be delayed.
     while (!cuda_events.empty()) {
-      auto& e = cuda_events.front();
-      cudaEvent_t event = e.first;
-      Block* block = e.second;
-
-      cudaError_t err = cudaEventQuery(event);
+      EventBatch& batch = cuda_events.front();
+      cudaError_t err = cudaEventQuery(batch.event);
       if (err == cudaErrorNotReady) {
         // ignore and clear the error if not ready
         cudaGetLastError();
@@ -591,20 +910,63 @@ struct THCCachingAllocator
       } else if (err != cudaSuccess) {
         C10_CUDA_CHECK(err);
       }
+      retire_batch(batch);
+      cuda_events.pop_front();
+    }
 
-      C10_CUDA_CHECK(cudaEventDestroy(event));
-
-      block->event_count--;
-      if (block->event_count == 0) {
-        free_block(block);
+    // Poll open batches too, so blocks on streams that see no further
+    // cross-stream frees do not linger until the batch fills up.
+    for (auto it = open_batches.begin(); it != open_batches.end();) {
+      cudaError_t err = cudaEventQuery(it->second.event);
+      if (err == cudaErrorNotReady) {
+        cudaGetLastError();
+        ++it;
+        continue;
+      } else if (err != cudaSuccess) {
+        C10_CUDA_CHECK(err);
       }
-      cuda_events.pop_front();
+      retire_batch(it->second);
+      it = open_batches.erase(it);
     }
   }
 };
 
 THCCachingAllocator caching_allocator;
 
+// Idle trim thread; see Note [Memory pressure callbacks]. Started lazily by
+// the first setIdleTrimInterval(>0) call, then parked on the condition
+// variable whenever trimming is disabled. The thread is detached and never
+// joined, like other process-lifetime worker threads.
+namespace {
+
+std::mutex trim_mutex;
+std::condition_variable trim_cv;
+int64_t trim_interval_seconds = 0;
+bool trim_thread_started = false;
+
+void trim_loop() {
+  // Blocks inserted before this generation have been cold for at least one
+  // full interval by the time the next sweep runs.
+  uint64_t trim_horizon = 0;
+  std::unique_lock<std::mutex> lock(trim_mutex);
+  while (true) {
+    if (trim_interval_seconds == 0) {
+      trim_cv.wait(lock);
+      trim_horizon = 0;
+      continue;
+    }
+    trim_cv.wait_for(lock, std::chrono::seconds(trim_interval_seconds));
+    if (trim_interval_seconds == 0) {
+      continue;
+    }
+    lock.unlock();
+    trim_horizon = caching_allocator.trim_cold_blocks(trim_horizon);
+    lock.lock();
+  }
+}
+
+} // namespace
+
 static void CudaCachingDeleter(void* ptr) {
   caching_allocator.free(ptr);
 }
@@ -638,6 +1000,32 @@ void emptyCache(void) {
   caching_allocator.emptyCache();
 }
 
+bool managedMemoryEnabled() {
+  return managed_memory_enabled();
+}
+
+void prefetchAsync(void* ptr, size_t nbytes, int device, cudaStream_t stream) {
+  // See Note [Managed memory mode]. Hints are advisory: without the
+  // managed mode there is nothing to migrate, so this is a no-op.
+  if (!managed_memory_enabled() || ptr == nullptr || nbytes == 0) {
+    return;
+  }
+  const int dstDevice = device >= 0 ? device : cudaCpuDeviceId;
+  C10_CUDA_CHECK(cudaMemPrefetchAsync(ptr, nbytes, dstDevice, stream));
+}
+
+void adviseReadMostly(void* ptr, size_t nbytes, bool enable) {
+  if (!managed_memory_enabled() || ptr == nullptr || nbytes == 0) {
+    return;
+  }
+  // The device argument of cudaMemAdvise is ignored for ReadMostly.
+  C10_CUDA_CHECK(cudaMemAdvise(
+      ptr,
+      nbytes,
+      enable ? cudaMemAdviseSetReadMostly : cudaMemAdviseUnsetReadMostly,
+      0));
+}
+
 void cacheInfo(int dev_id, size_t* cachedAndFree, size_t* largestBlock) {
   caching_allocator.cacheInfo(dev_id, cachedAndFree, largestBlock);
 }
@@ -652,6 +1040,46 @@ void recordStream(void *ptr, cuda::CUDAStream stream)
   caching_allocator.recordStream(ptr, stream);
 }
 
+uint64_t attachMemoryPressureCallback(
+    double watermark,
+    MemoryPressureCallback callback) {
+  AT_CHECK(
+      watermark > 0.0 && watermark <= 1.0,
+      "watermark must be a utilization fraction in (0, 1], got ", watermark);
+  AT_CHECK(callback != nullptr, "callback must not be empty");
+  std::lock_guard<std::recursive_mutex> lock(caching_allocator.mutex);
+  const uint64_t id = caching_allocator.next_pressure_id++;
+  THCCachingAllocator::PressureWatcher watcher;
+  watcher.id = id;
+  watcher.watermark = watermark;
+  watcher.callback = std::move(callback);
+  caching_allocator.pressure_watchers.push_back(std::move(watcher));
+  return id;
+}
+
+void detachMemoryPressureCallback(uint64_t id) {
+  std::lock_guard<std::recursive_mutex> lock(caching_allocator.mutex);
+  auto& watchers = caching_allocator.pressure_watchers;
+  for (auto it = watchers.begin(); it != watchers.end(); ++it) {
+    if (it->id == id) {
+      watchers.erase(it);
+      return;
+    }
+  }
+  AT_ERROR("no memory pressure callback with id ", id);
+}
+
+void setIdleTrimInterval(int64_t seconds) {
+  AT_CHECK(seconds >= 0, "trim interval must be non-negative, got ", seconds);
+  std::lock_guard<std::mutex> lock(trim_mutex);
+  trim_interval_seconds = seconds;
+  if (seconds > 0 && !trim_thread_started) {
+    trim_thread_started = true;
+    std::thread(trim_loop).detach();
+  }
+  trim_cv.notify_all();
+}
+
 std::mutex* getFreeMutex()
 {
   return &caching_allocator.cuda_free_mutex;
@@ -677,6 +1105,25 @@ void resetMaxMemoryAllocated(int device) {
   assertValidDevice(device);
   DeviceStats& stats = caching_allocator.get_stats_for_device(device);
   stats.max_amount_allocated = stats.amount_allocated;
+  for (auto& kv : stats.stream_stats) {
+    kv.second.max_amount_allocated = kv.second.amount_allocated;
+  }
+}
+
+uint64_t currentMemoryAllocated(int device, CUDAStream stream) {
+  assertValidDevice(device);
+  auto& stream_stats =
+      caching_allocator.get_stats_for_device(device).stream_stats;
+  auto it = stream_stats.find(stream.stream());
+  return it == stream_stats.end() ? 0 : it->second.amount_allocated;
+}
+
+uint64_t maxMemoryAllocated(int device, CUDAStream stream) {
+  assertValidDevice(device);
+  auto& stream_stats =
+      caching_allocator.get_stats_for_device(device).stream_stats;
+  auto it = stream_stats.find(stream.stream());
+  return it == stream_stats.end() ? 0 : it->second.max_amount_allocated;
 }
 
 uint64_t currentMemoryCached(int device)
@@ -761,6 +1208,15 @@ void* raw_alloc(size_t nbytes) {
   return r;
 }
 
+void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream) {
+  if (nbytes == 0) {
+    return nullptr;
+  }
+  void* r = nullptr;
+  caching_allocator.malloc(&r, nbytes, stream);
+  return r;
+}
+
 void raw_delete(void* ptr) {
   caching_allocator.free(ptr);
 }
@@ -6,6 +6,8 @@
 #include <c10/cuda/CUDAMacros.h>
 #include <c10/util/Registry.h>
 
+#include <cstdint>
+#include <functional>
 #include <mutex>
 
 namespace c10 {
@@ -40,20 +42,63 @@ namespace cuda {
 namespace CUDACachingAllocator {
 
 C10_CUDA_API void* raw_alloc(size_t nbytes);
+// Stream-ordered allocation for kernel temporaries: the block is owned by
+// `stream` rather than the current stream, and raw_delete returns it to
+// that stream's pool where later work on the same stream may reuse it with
+// no synchronization. Uses on any other stream must be announced with
+// recordStream() before the free; see Note [Stream-ordered frees] in
+// CUDACachingAllocator.cpp.
+C10_CUDA_API void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream);
 C10_CUDA_API void raw_delete(void* ptr);
 
 C10_CUDA_API Allocator* get();
 C10_CUDA_API void emptyCache();
+// Managed (unified) memory mode and residency hints; see
+// Note [Managed memory mode] in CUDACachingAllocator.cpp. The hint
+// functions are no-ops unless PYTORCH_CUDA_MANAGED_MEMORY=1.
+C10_CUDA_API bool managedMemoryEnabled();
+// device -1 prefetches to the host.
+C10_CUDA_API void prefetchAsync(
+    void* ptr,
+    size_t nbytes,
+    int device,
+    cudaStream_t stream);
+C10_CUDA_API void adviseReadMostly(void* ptr, size_t nbytes, bool enable);
 C10_CUDA_API void cacheInfo(int dev_id, size_t* cachedAndFree, size_t* largestBlock);
 C10_CUDA_API void* getBaseAllocation(void *ptr, size_t *size);
 C10_CUDA_API void recordStream(void *ptr, CUDAStream stream);
 C10_CUDA_API uint64_t currentMemoryAllocated(int device);
 C10_CUDA_API uint64_t maxMemoryAllocated(int device);
 C10_CUDA_API void     resetMaxMemoryAllocated(int device);
+// Per-stream breakdown of the allocated counters. Streams the allocator has
+// never allocated on report zero.
+C10_CUDA_API uint64_t currentMemoryAllocated(int device, CUDAStream stream);
+C10_CUDA_API uint64_t maxMemoryAllocated(int device, CUDAStream stream);
 C10_CUDA_API uint64_t currentMemoryCached(int device);
 C10_CUDA_API uint64_t maxMemoryCached(int device);
 C10_CUDA_API void     resetMaxMemoryCached(int device);
 
+// Fired when an allocation pushes a device's utilization (bytes allocated
+// through the caching allocator over total device capacity) across a
+// registered watermark; see Note [Memory pressure callbacks] in
+// CUDACachingAllocator.cpp. Callbacks run on the allocating thread after
+// the allocator lock has been released, so they may free tensors or call
+// emptyCache. A callback re-arms once utilization drops back below its
+// watermark.
+using MemoryPressureCallback =
+    std::function<void(int device, uint64_t allocated, uint64_t capacity)>;
+// `watermark` is a utilization fraction in (0, 1]. Returns an id usable
+// with detachMemoryPressureCallback.
+C10_CUDA_API uint64_t attachMemoryPressureCallback(
+    double watermark,
+    MemoryPressureCallback callback);
+C10_CUDA_API void detachMemoryPressureCallback(uint64_t id);
+
+// Periodically returns cached blocks that have gone cold - untouched for at
+// least one full interval - to the driver from a background thread. Zero
+// (the default) disables trimming. See Note [Memory pressure callbacks].
+C10_CUDA_API void setIdleTrimInterval(int64_t seconds);
+
 C10_CUDA_API std::mutex* getFreeMutex();
 
 C10_CUDA_API std::shared_ptr<void> getIpcDevPtr(std::string handle);
@@ -5,8 +5,13 @@
 
 #include <array>
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include <iostream>
@@ -35,6 +40,8 @@ struct LeakyStreamInternals {
   DeviceIndex device_index = -1;
   int32_t stream_id = -1;
   cudaStream_t stream = nullptr;
+  // See Note [Host callbacks and pending-work depth]
+  std::atomic<int64_t> pending_depth{0};
 };
 
 // Global stream state and constants
@@ -68,10 +75,14 @@ static LeakyStreamInternals default_streams[C10_COMPILE_TIME_MAX_GPUS];
 static std::once_flag device_flags[C10_COMPILE_TIME_MAX_GPUS];
 static std::atomic<uint32_t> low_priority_counters[C10_COMPILE_TIME_MAX_GPUS];
 static std::atomic<uint32_t> high_priority_counters[C10_COMPILE_TIME_MAX_GPUS];
+static std::atomic<uint32_t>
+    critical_priority_counters[C10_COMPILE_TIME_MAX_GPUS];
 static std::array<LeakyStreamInternals, kStreamsPerPool>
     low_priority_streams[C10_COMPILE_TIME_MAX_GPUS];
 static std::array<LeakyStreamInternals, kStreamsPerPool>
     high_priority_streams[C10_COMPILE_TIME_MAX_GPUS];
+static std::array<LeakyStreamInternals, kStreamsPerPool>
+    critical_priority_streams[C10_COMPILE_TIME_MAX_GPUS];
 
 // Note [StreamId assignment]
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -84,6 +95,7 @@ static std::array<LeakyStreamInternals, kStreamsPerPool>
 //  00 = default stream
 //  01 = low priority stream
 //  10 = high priority stream
+//  11 = critical priority stream
 //
 // This is not really for efficiency; it's just easier to write the code
 // to extract the index if we do this with bitmasks :)
@@ -104,6 +116,7 @@ enum class StreamIdType : uint8_t {
   DEFAULT = 0x0,
   LOW = 0x1,
   HIGH = 0x2,
+  CRITICAL = 0x3,
 };
 
 std::ostream& operator<<(std::ostream& stream, StreamIdType s) {
@@ -117,6 +130,9 @@ std::ostream& operator<<(std::ostream& stream, StreamIdType s) {
     case StreamIdType::HIGH:
       stream << "HIGH";
       break;
+    case StreamIdType::CRITICAL:
+      stream << "CRITICAL";
+      break;
     default:
       stream << static_cast<uint8_t>(s);
       break;
@@ -178,6 +194,14 @@ static StreamId CUDAStream_getStreamId(const LeakyStreamInternals* ptr) {
         StreamIdType::HIGH, ptr - high_priority_streams[device_index].data());
   }
 
+  // Check if it's a critical priority stream
+  if (pointer_within<LeakyStreamInternals>(
+          ptr, critical_priority_streams[device_index])) {
+    return makeStreamId(
+        StreamIdType::CRITICAL,
+        ptr - critical_priority_streams[device_index].data());
+  }
+
   AT_ASSERTM(
       0,
       "Could not compute stream ID for ",
@@ -212,6 +236,7 @@ static void initGlobalStreamState() {
     default_streams[i].device_index = i;
     low_priority_counters[i] = 0;
     high_priority_counters[i] = 0;
+    critical_priority_counters[i] = 0;
   }
 }
 
@@ -222,23 +247,39 @@ static void initDeviceStreamState(DeviceIndex device_index) {
   // with it.
   CUDAGuard device_guard{device_index};
 
+#ifndef __HIP_PLATFORM_HCC__
+  // The critical pool uses the greatest priority the device exposes, which
+  // coincides with kHighPriority on hardware with only two levels.
+  int least_priority = 0;
+  int greatest_priority = kHighPriority;
+  C10_CUDA_CHECK(cudaDeviceGetStreamPriorityRange(
+      &least_priority, &greatest_priority));
+  (void)least_priority;
+#endif // __HIP_PLATFORM_HCC__
+
   for (auto i = decltype(kStreamsPerPool){0}; i < kStreamsPerPool; ++i) {
     auto& lowpri_stream = low_priority_streams[device_index][i];
     auto& hipri_stream = high_priority_streams[device_index][i];
+    auto& critpri_stream = critical_priority_streams[device_index][i];
 
     lowpri_stream.device_index = device_index;
     hipri_stream.device_index = device_index;
+    critpri_stream.device_index = device_index;
 
 #ifndef __HIP_PLATFORM_HCC__
     C10_CUDA_CHECK(cudaStreamCreateWithPriority(
         &lowpri_stream.stream, kDefaultFlags, kLowPriority));
     C10_CUDA_CHECK(cudaStreamCreateWithPriority(
         &hipri_stream.stream, kDefaultFlags, kHighPriority));
+    C10_CUDA_CHECK(cudaStreamCreateWithPriority(
+        &critpri_stream.stream, kDefaultFlags, greatest_priority));
 #else
     C10_CUDA_CHECK(
         cudaStreamCreateWithFlags(&lowpri_stream.stream, kDefaultFlags));
     C10_CUDA_CHECK(
         cudaStreamCreateWithFlags(&hipri_stream.stream, kDefaultFlags));
+    C10_CUDA_CHECK(
+        cudaStreamCreateWithFlags(&critpri_stream.stream, kDefaultFlags));
 #endif // __HIP_PLATFORM_HCC__
   }
 }
@@ -293,6 +334,8 @@ LeakyStreamInternals* CUDAStream_internals(CUDAStream s) {
       return &low_priority_streams[device_index][si];
     case StreamIdType::HIGH:
       return &high_priority_streams[device_index][si];
+    case StreamIdType::CRITICAL:
+      return &critical_priority_streams[device_index][si];
     default:
       AT_ASSERTM(
           0,
@@ -313,6 +356,91 @@ CUDAStream CUDAStream_fromInternals(const LeakyStreamInternals* ptr) {
           CUDAStream_getStreamId(ptr)));
 }
 
+// Note [Host callbacks and pending-work depth]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// cudaStreamAddCallback runs callbacks on a CUDA-internal thread, blocks
+// the stream until the callback returns, and forbids CUDA API calls from
+// inside it. The trampoline below therefore does almost nothing on that
+// thread: it decrements the stream's pending-work counter and hands the
+// user's function to a dedicated, lazily created host worker thread. Slow
+// callbacks thus never stall the stream pools, and the callbacks themselves
+// are free to call back into CUDA.
+//
+// The pending-work counter counts trampolines the device has not yet
+// reached, which gives schedulers a cheap per-stream queue-depth signal;
+// markPendingWork enqueues a counting-only trampoline so the depth can
+// track ordinary kernel launches, not just callbacks.
+
+struct HostCallbackQueue {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::function<void()>> work;
+};
+
+static HostCallbackQueue& hostCallbackQueue() {
+  // Leaked, like the streams: the worker may outlive static destruction.
+  static HostCallbackQueue* queue = []() {
+    auto* q = new HostCallbackQueue();
+    std::thread([q]() {
+      while (true) {
+        std::function<void()> fn;
+        {
+          std::unique_lock<std::mutex> lock(q->mutex);
+          q->cv.wait(lock, [q] { return !q->work.empty(); });
+          fn = std::move(q->work.front());
+          q->work.pop_front();
+        }
+        try {
+          fn();
+        } catch (const std::exception& e) {
+          AT_WARN("Exception in CUDA host callback: ", e.what());
+        } catch (...) {
+          AT_WARN("Unknown exception in CUDA host callback");
+        }
+      }
+    }).detach();
+    return q;
+  }();
+  return *queue;
+}
+
+struct HostCallbackContext {
+  LeakyStreamInternals* internals;
+  std::function<void()> fn;
+};
+
+static void CUDART_CB hostCallbackTrampoline(
+    cudaStream_t /* stream */,
+    cudaError_t /* status */,
+    void* user_data) {
+  std::unique_ptr<HostCallbackContext> ctx(
+      static_cast<HostCallbackContext*>(user_data));
+  --ctx->internals->pending_depth;
+  if (!ctx->fn) {
+    return;
+  }
+  auto& queue = hostCallbackQueue();
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.work.push_back(std::move(ctx->fn));
+  }
+  queue.cv.notify_one();
+}
+
+static void enqueueTrampoline(CUDAStream stream, std::function<void()> fn) {
+  auto* internals = CUDAStream_internals(stream);
+  AT_ASSERT(internals);
+  auto* ctx = new HostCallbackContext{internals, std::move(fn)};
+  ++internals->pending_depth;
+  const auto err = cudaStreamAddCallback(
+      internals->stream, &hostCallbackTrampoline, ctx, 0);
+  if (err != cudaSuccess) {
+    --internals->pending_depth;
+    delete ctx;
+  }
+  C10_CUDA_CHECK(err);
+}
+
 } // anonymous namespace
 
 cudaStream_t CUDAStream::stream() const {
@@ -327,6 +455,14 @@ cudaStream_t CUDAStream::stream() const {
 CUDAStream getStreamFromPool(
     const bool isHighPriority,
     DeviceIndex device_index) {
+  return getStreamFromPool(
+      isHighPriority ? StreamPriority::HIGH : StreamPriority::LOW,
+      device_index);
+}
+
+CUDAStream getStreamFromPool(
+    StreamPriority priority,
+    DeviceIndex device_index) {
   initCUDAStreamsOnce();
   if (device_index == -1)
     device_index = current_device();
@@ -336,13 +472,40 @@ CUDAStream getStreamFromPool(
   std::call_once(
       device_flags[device_index], initDeviceStreamState, device_index);
 
-  if (isHighPriority) {
-    const auto idx = get_idx(high_priority_counters[device_index]);
-    return CUDAStream_fromInternals(&high_priority_streams[device_index][idx]);
+  switch (priority) {
+    case StreamPriority::CRITICAL: {
+      const auto idx = get_idx(critical_priority_counters[device_index]);
+      return CUDAStream_fromInternals(
+          &critical_priority_streams[device_index][idx]);
+    }
+    case StreamPriority::HIGH: {
+      const auto idx = get_idx(high_priority_counters[device_index]);
+      return CUDAStream_fromInternals(
+          &high_priority_streams[device_index][idx]);
+    }
+    default: {
+      const auto idx = get_idx(low_priority_counters[device_index]);
+      return CUDAStream_fromInternals(&low_priority_streams[device_index][idx]);
+    }
   }
+}
+
+void addHostCallback(CUDAStream stream, std::function<void()> callback) {
+  initCUDAStreamsOnce();
+  AT_CHECK(callback, "addHostCallback: expected a callable");
+  enqueueTrampoline(stream, std::move(callback));
+}
 
-  const auto idx = get_idx(low_priority_counters[device_index]);
-  return CUDAStream_fromInternals(&low_priority_streams[device_index][idx]);
+void markPendingWork(CUDAStream stream) {
+  initCUDAStreamsOnce();
+  enqueueTrampoline(stream, nullptr);
+}
+
+int64_t pendingWorkDepth(CUDAStream stream) {
+  initCUDAStreamsOnce();
+  auto* internals = CUDAStream_internals(stream);
+  AT_ASSERT(internals);
+  return internals->pending_depth.load();
 }
 
 CUDAStream getDefaultCUDAStream(DeviceIndex device_index) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <utility>
 
 #include <cuda_runtime_api.h>
@@ -37,6 +38,13 @@
 * The third pool is the "high priority" streams. The third pool acts like
 * the second pool except the streams are created with a higher priority.
 *
+* The fourth pool is the "critical priority" streams, created at the
+* greatest priority the device exposes. On hardware with only two priority
+* levels (and in HIP builds, which do not support priorities) these share
+* the high priority level, but they remain a separate pool so that
+* latency-critical work never round-robins onto the same stream as
+* ordinary high priority work.
+*
 * These pools suggest that stream users should prefer many short-lived streams,
 * as the cost of acquiring and releasing streams is effectively zero. If
 * many longer-lived streams are required in performance critical scenarios
@@ -184,6 +192,51 @@ private:
 CAFFE2_API CUDAStream
 getStreamFromPool(const bool isHighPriority = false, DeviceIndex device = -1);
 
+/**
+ * Priority tiers for getStreamFromPool. LOW is the default-priority pool,
+ * HIGH the high-priority pool the bool overload exposes, and CRITICAL a
+ * pool created at the greatest stream priority the device supports (see
+ * the stream pool note above).
+ */
+enum class StreamPriority : uint8_t {
+  LOW = 0,
+  HIGH = 1,
+  CRITICAL = 2,
+};
+
+/**
+ * Get a new stream from the pool of the requested priority tier; otherwise
+ * identical to the bool overload above.
+ */
+CAFFE2_API CUDAStream
+getStreamFromPool(StreamPriority priority, DeviceIndex device = -1);
+
+/**
+ * Enqueues callback to run once the work currently submitted to stream
+ * completes. Unlike raw cudaStreamAddCallback, the callback runs on a
+ * dedicated host worker thread: the stream (and the CUDA runtime's shared
+ * callback thread) is released as soon as completion is observed, so
+ * long-running callbacks never stall the stream pools, and the callback is
+ * free to call back into CUDA. See Note [Host callbacks and pending-work
+ * depth] in CUDAStream.cpp.
+ */
+CAFFE2_API void addHostCallback(CUDAStream stream, std::function<void()> callback);
+
+/**
+ * Records a pending-work marker on stream, counted by pendingWorkDepth
+ * until the device reaches it. Record one after submitting a batch of work
+ * to keep the depth signal meaningful for streams that don't otherwise use
+ * host callbacks.
+ */
+CAFFE2_API void markPendingWork(CUDAStream stream);
+
+/**
+ * The number of host callbacks and pending-work markers enqueued on stream
+ * that the device has not yet reached. Schedulers can route new requests
+ * to the stream with the shallowest queue.
+ */
+CAFFE2_API int64_t pendingWorkDepth(CUDAStream stream);
+
 /**
  * Get the default CUDA stream, for the passed CUDA device, or for the
  * current device if no device index is passed.  The default stream is
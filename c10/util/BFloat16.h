@@ -0,0 +1,69 @@
+#pragma once
+
+/// Defines the BFloat16 type (brain floating-point). This representation uses
+/// 1 bit for the sign, 8 bits for the exponent and 7 bits for the mantissa.
+/// It is assumed that conversions to/from float32 are cheap (a shift plus a
+/// rounding increment), which is what makes bfloat16 attractive for
+/// memory-bound CPU kernels: it shares the float32 exponent range, so unlike
+/// Half there is no risk of overflow when truncating activations, and
+/// arithmetic is performed by upconverting to float32.
+
+#include <c10/macros/Macros.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <limits>
+
+namespace c10 {
+
+namespace detail {
+
+inline C10_HOST_DEVICE float f32_from_bits(uint16_t src) {
+  float res = 0;
+  uint32_t tmp = src;
+  tmp <<= 16;
+  std::memcpy(&res, &tmp, sizeof(tmp));
+  return res;
+}
+
+inline C10_HOST_DEVICE uint16_t bits_from_f32(float src) {
+  uint32_t res = 0;
+  std::memcpy(&res, &src, sizeof(res));
+  return res >> 16;
+}
+
+inline C10_HOST_DEVICE uint16_t round_to_nearest_even(float src) {
+  if (std::isnan(src)) {
+    return UINT16_C(0x7FC0);
+  }
+  uint32_t U32 = 0;
+  std::memcpy(&U32, &src, sizeof(U32));
+  uint32_t rounding_bias = ((U32 >> 16) & 1) + UINT32_C(0x7FFF);
+  return static_cast<uint16_t>((U32 + rounding_bias) >> 16);
+}
+
+} // namespace detail
+
+struct alignas(2) BFloat16 {
+  uint16_t x;
+
+  BFloat16() = default;
+
+  struct from_bits_t {};
+  static constexpr from_bits_t from_bits() {
+    return from_bits_t();
+  }
+
+  constexpr C10_HOST_DEVICE BFloat16(unsigned short bits, from_bits_t)
+      : x(bits){};
+  inline C10_HOST_DEVICE BFloat16(float value);
+  inline C10_HOST_DEVICE operator float() const;
+};
+
+C10_API std::ostream& operator<<(std::ostream& out, const BFloat16& value);
+
+} // namespace c10
+
+#include <c10/util/BFloat16-inl.h>
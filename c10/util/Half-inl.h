@@ -12,6 +12,10 @@
 #include <hip/hip_fp16.h>
 #endif
 
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
 namespace c10 {
 
 /// Constructors
@@ -19,6 +23,10 @@ namespace c10 {
 inline C10_HOST_DEVICE Half::Half(float value) {
 #if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
   x = __half_as_short(__float2half(value));
+#elif defined(__F16C__)
+  // Single-instruction conversion (VCVTPS2PH); matches the bit-twiddling
+  // fallback below exactly, including denormals and round-to-nearest-even.
+  x = _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
 #else
   x = detail::fp16_ieee_from_fp32_value(value);
 #endif
@@ -29,6 +37,8 @@ inline C10_HOST_DEVICE Half::Half(float value) {
 inline C10_HOST_DEVICE Half::operator float() const {
 #if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
   return __half2float(*reinterpret_cast<const __half*>(&x));
+#elif defined(__F16C__)
+  return _cvtsh_ss(x);
 #else
   return detail::fp16_ieee_to_fp32_value(x);
 #endif
@@ -267,6 +267,25 @@ class intrusive_ptr final {
     return *this;
   }
 
+  /**
+   * Releases `count` strong references to `self` at once, paying a single
+   * atomic subtraction for all but the last one. The caller must own all
+   * `count` references (e.g. collected via release()); they are all
+   * invalid afterwards. When the refcount reaches zero this follows the
+   * usual destruction path. Unlike reclaim(), it is NOT valid to pass
+   * NullType::singleton() other than through the no-op null/zero cases.
+   */
+  static void unsafe_release_batch(TTarget* self, size_t count) noexcept {
+    if (self == NullType::singleton() || count == 0) {
+      return;
+    }
+    if (count > 1) {
+      self->refcount_.fetch_sub(count - 1);
+    }
+    // The temporary's destructor releases the final reference.
+    intrusive_ptr tmp(self);
+  }
+
   TTarget* get() const noexcept {
     return target_;
   }
@@ -707,6 +726,16 @@ namespace intrusive_ptr {
     // If you want more safety, used the actual c10::intrusive_ptr class
   }
 
+  // Releases `count` strong references with one atomic subtraction for
+  // all but the last; the JIT interpreter uses this to retire a register
+  // file holding many copies of the same TensorImpl. The caller must own
+  // all `count` references, and as with decref, 'self' is invalid after
+  // the call (null is allowed here and is a no-op).
+  inline void decref_n(intrusive_ptr_target* self, size_t count) {
+    c10::intrusive_ptr<intrusive_ptr_target>::unsafe_release_batch(
+        self, count);
+  }
+
   template <typename T>
   inline T* make_weak(T* self) {
     // NB: 'this' is a strong pointer, but we return a weak pointer
@@ -20,6 +20,7 @@
 #include "c10/macros/Macros.h"
 #include "c10/util/Backtrace.h"
 #include "c10/util/C++17.h"
+#include "c10/util/BFloat16.h"
 #include "c10/util/Exception.h"
 #include "c10/util/Half.h"
 #include "c10/util/IdWrapper.h"
@@ -47,6 +48,8 @@
 namespace std {
 template <>
 struct is_fundamental<at::Half> : std::true_type {};
+template <>
+struct is_fundamental<at::BFloat16> : std::true_type {};
 } // namespace std
 
 namespace caffe2 {
@@ -624,6 +627,7 @@ CAFFE_DECLARE_PREALLOCATED_KNOWN_TYPE(
     detail::_guard_long_unique<std::vector<long>>)
 
 CAFFE_DECLARE_PREALLOCATED_KNOWN_TYPE(27, c10::qint8);
+CAFFE_DECLARE_PREALLOCATED_KNOWN_TYPE(28, at::BFloat16);
 
-CAFFE_DECLARE_PREALLOCATED_KNOWN_TYPE(28, _CaffeHighestPreallocatedTypeId)
+CAFFE_DECLARE_PREALLOCATED_KNOWN_TYPE(29, _CaffeHighestPreallocatedTypeId)
 } // namespace caffe2
@@ -209,6 +209,19 @@ size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
   return stat.m_local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
 }
 
+std::tuple<size_t, size_t, bool> PyTorchStreamReader::getRecordInfo(
+    const std::string& name) {
+  mz_zip_archive_file_stat stat;
+  mz_zip_reader_file_stat(ar_.get(), getFileID(name), &stat);
+  valid("retriving file meta-data");
+  // method 0 is "stored": the payload is the raw bytes, so in-place access
+  // is possible. Archives produced by foreign zip tools may be deflated,
+  // in which case callers must fall back to getRecord.
+  bool stored = (stat.m_method == 0);
+  return std::make_tuple(
+      getRecordOffset(name), (size_t)stat.m_uncomp_size, stored);
+}
+
 
 PyTorchStreamReader::~PyTorchStreamReader() {
   mz_zip_reader_end(ar_.get());
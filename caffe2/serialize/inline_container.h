@@ -109,6 +109,13 @@ class CAFFE2_API PyTorchStreamReader final {
 
   size_t getRecordOffset(const std::string& name);
 
+  // Returns (offset, uncompressed size, stored) for the record, where
+  // `offset` is the position of the payload in the underlying file and
+  // `stored` is true when the record is uncompressed. Stored records
+  // written by PyTorchStreamWriter are 64-byte aligned and can be read or
+  // mmapped in place instead of going through getRecord's copy.
+  std::tuple<size_t, size_t, bool> getRecordInfo(const std::string& name);
+
   ~PyTorchStreamReader();
 
  private:
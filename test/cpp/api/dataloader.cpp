@@ -369,6 +369,37 @@ TEST(DataTest, RandomSamplerResetsWithNewSizeWell) {
   ASSERT_FALSE(sampler.next(2).has_value());
 }
 
+TEST(DataTest, LengthBucketSamplerSortsEachBucketByDecreasingLength) {
+  std::vector<int64_t> lengths = {3, 9, 1, 7, 5, 2, 8, 4};
+  samplers::LengthBucketSampler sampler(
+      lengths, /*bucket_size=*/4, /*shuffle=*/false);
+
+  // Without shuffling, buckets cover the original order, so each bucket of
+  // four indices comes back sorted by decreasing length.
+  std::vector<size_t> first = sampler.next(4).value();
+  std::vector<size_t> second = sampler.next(4).value();
+  ASSERT_EQ(first, std::vector<size_t>({1, 3, 0, 2}));
+  ASSERT_EQ(second, std::vector<size_t>({6, 4, 7, 5}));
+  ASSERT_FALSE(sampler.next(1).has_value());
+}
+
+TEST(DataTest, LengthBucketSamplerCoversAllIndices) {
+  std::vector<int64_t> lengths = {5, 3, 8, 1, 9, 2, 7, 4, 6, 10};
+  samplers::LengthBucketSampler sampler(lengths, /*bucket_size=*/4);
+
+  std::vector<bool> seen(lengths.size(), false);
+  while (auto batch = sampler.next(3)) {
+    for (auto i : *batch) {
+      ASSERT_LT(i, lengths.size());
+      ASSERT_FALSE(seen[i]);
+      seen[i] = true;
+    }
+  }
+  for (auto s : seen) {
+    ASSERT_TRUE(s);
+  }
+}
+
 TEST(DataTest, SavingAndLoadingRandomSamplerYieldsSameSequence) {
   {
     samplers::RandomSampler a(10);
@@ -1020,6 +1051,7 @@ TEST(DataLoaderTest, DataLoaderOptionsDefaultAsExpected) {
   ASSERT_FALSE(full_options.drop_last);
   ASSERT_EQ(full_options.workers, 0);
   ASSERT_EQ(full_options.max_jobs, 0);
+  ASSERT_FALSE(full_options.max_outstanding_bytes.has_value());
   ASSERT_FALSE(full_options.timeout.has_value());
   ASSERT_TRUE(full_options.enforce_ordering);
 }
@@ -1447,6 +1479,57 @@ TEST(DataLoaderTest, TestExceptionsArePropagatedFromWorkers) {
   }
 }
 
+TEST(DataLoaderTest, RespectsOutstandingBytesBudget) {
+  const size_t kDatasetSize = 16;
+  // Each example is 64 floats = 256 bytes, so a budget of 300 bytes forces
+  // the loader to throttle prefetching rather than fill all of max_jobs.
+  struct D : datasets::Dataset<D> {
+    torch::data::Example<> get(size_t index) override {
+      return {torch::full({64}, static_cast<float>(index)), torch::ones(1)};
+    }
+    torch::optional<size_t> size() const override {
+      return kDatasetSize;
+    }
+  };
+
+  auto data_loader = torch::data::make_data_loader(
+      D{}.map(transforms::Stack<>()),
+      samplers::SequentialSampler(kDatasetSize),
+      DataLoaderOptions(1).workers(2).max_outstanding_bytes(300));
+
+  // Despite the tight budget, every batch must still arrive exactly once.
+  size_t count = 0;
+  for (auto& batch : *data_loader) {
+    ASSERT_EQ(batch.data[0].item<float>(), static_cast<float>(count));
+    ++count;
+  }
+  ASSERT_EQ(count, kDatasetSize);
+
+  const auto stats = data_loader->stats();
+  ASSERT_EQ(stats.batches_popped, kDatasetSize);
+  ASSERT_GT(stats.peak_outstanding_bytes, 0);
+  // Everything handed out; nothing may still be counted against the budget.
+  ASSERT_EQ(stats.outstanding_host_bytes, 0);
+  ASSERT_EQ(stats.outstanding_device_bytes, 0);
+}
+
+TEST(DataLoaderTest, TracksPipelineStatsWithoutBudget) {
+  DummyDataset dataset;
+  auto data_loader = torch::data::make_data_loader(
+      dataset, DataLoaderOptions(10).workers(2));
+  size_t count = 0;
+  for (auto& batch : *data_loader) {
+    (void)batch;
+    ++count;
+  }
+  const auto stats = data_loader->stats();
+  ASSERT_EQ(stats.batches_popped, count);
+  // `int` batches have invisible memory use and must count as zero bytes.
+  ASSERT_EQ(stats.peak_outstanding_bytes, 0);
+  ASSERT_EQ(stats.throttled_jobs, 0);
+  ASSERT_EQ(stats.in_flight_jobs, 0);
+}
+
 TEST(DataLoaderTest, StatefulDatasetWithNoWorkers) {
   const int kNumberOfExamplesAfterWhichTheDatasetExhausts = 10;
 
@@ -67,6 +67,26 @@ TEST(SerializeTest, BasicToFile) {
   ASSERT_TRUE(x.allclose(y));
 }
 
+TEST(SerializeTest, SaveAsyncSnapshotsBeforeReturning) {
+  torch::manual_seed(0);
+
+  Linear model(5, 2);
+  auto expected_weight = model->weight.clone();
+
+  auto tempfile = c10::make_tempfile();
+  auto done = torch::save_async(model, tempfile.name);
+  {
+    // Mutations after save_async returns must not leak into the checkpoint.
+    torch::NoGradGuard no_grad;
+    model->weight.add_(1);
+  }
+  done.get();
+
+  Linear loaded(5, 2);
+  torch::load(loaded, tempfile.name);
+  ASSERT_TRUE(loaded->weight.allclose(expected_weight));
+}
+
 TEST(SerializeTest, Resized) {
   torch::manual_seed(0);
 
@@ -16,6 +16,8 @@
 #include <test/cpp/jit/test_create_autodiff_subgraphs.h>
 #include <test/cpp/jit/test_custom_operators.h>
 #include <test/cpp/jit/test_dynamic_dag.h>
+#include <test/cpp/jit/test_fold_conv_bn.h>
+#include <test/cpp/jit/test_freeze_module.h>
 #include <test/cpp/jit/test_fuser.h>
 #include <test/cpp/jit/test_graph_executor.h>
 #include <test/cpp/jit/test_interpreter.h>
@@ -46,6 +48,8 @@ namespace jit {
   _(Differentiate)                 \
   _(DifferentiateWithRequiresGrad) \
   _(DynamicDAG)                    \
+  _(FoldConvBatchNorm)             \
+  _(FreezeModule)                  \
   _(FromQualString)                \
   _(InternedStrings)               \
   _(IValue)                        \
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <test/cpp/jit/test_base.h>
+
+#include <torch/csrc/jit/passes/fold_conv_bn.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/script/module.h>
+#include <torch/csrc/jit/testing/file_check.h>
+
+namespace torch {
+namespace jit {
+namespace test {
+
+void testFoldConvBatchNorm() {
+  auto m = std::make_shared<script::Module>();
+  m->register_parameter("weight", torch::randn({4, 3, 3, 3}), false);
+  m->register_parameter("bias", torch::randn({4}), false);
+  m->register_parameter("bn_weight", torch::randn({4}), false);
+  m->register_parameter("bn_bias", torch::randn({4}), false);
+  m->register_parameter("running_mean", torch::randn({4}), /*is_buffer*/ true);
+  m->register_parameter(
+      "running_var", torch::rand({4}) + 0.1, /*is_buffer*/ true);
+  m->define(R"(
+    def forward(self, x):
+      y = torch.conv2d(x, self.weight, self.bias, [1, 1], [0, 0], [1, 1], 1)
+      return torch.batch_norm(y, self.bn_weight, self.bn_bias, self.running_mean, self.running_var, False, 0.1, 1e-5, True)
+  )");
+  auto input = torch::randn({2, 3, 8, 8});
+  auto expected = m->run_method("forward", input).toTensor();
+
+  // Freezing turns the parameters into constants and then runs
+  // FoldConvBatchNorm, which absorbs the batch norm into the conv.
+  FreezeModule(*m);
+
+  auto graph = m->get_method("forward").graph();
+  testing::FileCheck()
+      .check("aten::conv2d")
+      ->check_not("aten::batch_norm")
+      ->run(*graph);
+  // Nothing left to fold on a second run.
+  AT_ASSERT(!FoldConvBatchNorm(graph));
+
+  // The folded conv must match the unfused graph numerically.
+  auto folded = m->run_method("forward", input).toTensor();
+  AT_ASSERT(folded.allclose(expected, /*rtol*/ 1e-4, /*atol*/ 1e-5));
+}
+
+} // namespace test
+} // namespace jit
+} // namespace torch
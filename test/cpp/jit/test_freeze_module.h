@@ -0,0 +1,43 @@
+#pragma once
+
+#include <test/cpp/jit/test_base.h>
+
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/script/module.h>
+#include <torch/csrc/jit/testing/file_check.h>
+
+namespace torch {
+namespace jit {
+namespace test {
+
+void testFreezeModule() {
+  auto m = std::make_shared<script::Module>();
+  m->register_parameter("weight", 2 * torch::ones({2, 2}), false);
+  m->define(R"(
+    def forward(self, x):
+      return self.weight * x + self.weight
+  )");
+  auto input = torch::rand({2, 2});
+  auto expected = m->run_method("forward", input).toTensor();
+
+  FreezeModule(*m);
+
+  // The parameter input is now dead: every use was redirected to a
+  // constant holding the frozen value.
+  auto& method = m->get_method("forward");
+  auto graph = method.graph();
+  size_t params_begin =
+      graph->inputs().size() - method.initial_ivalues().size();
+  for (size_t i = params_begin; i < graph->inputs().size(); ++i) {
+    AT_ASSERT(graph->inputs()[i]->uses().empty());
+  }
+  testing::FileCheck().check("prim::Constant")->run(*graph);
+
+  // Freezing must not change what the method computes.
+  auto frozen = m->run_method("forward", input).toTensor();
+  AT_ASSERT(frozen.allclose(expected));
+}
+
+} // namespace test
+} // namespace jit
+} // namespace torch
@@ -18,11 +18,22 @@ struct ${op} : public ${superclass} {
     ${release_variables}
   }
   ${will_release_variables}
+  ${cse_fingerprint}
   ${saved_variables}
   ${saved_list_sizes}
 };
 """)
 
+# Emitted when every saved member of the function has an exact word
+# encoding (see torch/csrc/autograd/cse.h); functions with opaque state
+# simply keep the base-class override and stay out of backward CSE.
+CSE_FINGERPRINT = CodeTemplate("""\
+bool cse_fingerprint(std::vector<uint64_t>& words) const override {
+  ${cse_appends}
+  return true;
+}
+""")
+
 WILL_RELEASE_VARIABLES = CodeTemplate("""\
 bool retain_variables = true;
 void will_release_variables() override {
@@ -132,6 +143,9 @@ def process_function(func):
             size = '1'
         env['compute_index_ranges'].append('auto {}_ix = gen.range({});'.format(arg['name'], size))
 
+    cse_appends = []
+    cse_supported = [True]
+
     def save_arg(arg, is_output):
         name = arg['name']
         if arg['type'] == 'Tensor' or (arg['type'] == 'Scalar' and is_output):
@@ -140,16 +154,24 @@ def process_function(func):
             release_variables.append('{}_.reset_grad_function();'.format(name))
             ptr = 'shared_from_this()' if is_output else ''
             unpack.append('auto {} = {}_.unpack({});'.format(name, name, ptr))
+            cse_appends.append('detail::cse_append(words, {}_);'.format(name))
         elif arg['type'] == 'TensorList':
             saved_variables.append('std::vector<SavedVariable> {}_;'.format(name))
             release_variables.append('{}_.clear();'.format(name))
             unpack.append('auto {} = unpack_list({}_);'.format(name, name))
+            cse_appends.append('detail::cse_append(words, {}_);'.format(name))
         elif arg['type'] == 'IntArrayRef':
             saved_variables.append('std::vector<int64_t> {};'.format(name))
+            cse_appends.append('detail::cse_append(words, {});'.format(name))
         elif arg['type'] == 'int64_t':
             saved_variables.append('{} {} = 0;'.format(arg['type'], name))
+            cse_appends.append('detail::cse_append(words, {});'.format(name))
         else:
             saved_variables.append('{} {};'.format(arg['type'], name))
+            if arg['type'] in ('Scalar', 'double', 'bool', 'ScalarType'):
+                cse_appends.append('detail::cse_append(words, {});'.format(name))
+            else:
+                cse_supported[0] = False
 
     for arg in func['saved_inputs']:
         save_arg(arg, is_output=False)
@@ -164,6 +186,11 @@ def process_function(func):
     else:
         env['will_release_variables'] = ''
 
+    if cse_supported[0]:
+        env['cse_fingerprint'] = CSE_FINGERPRINT.substitute(cse_appends=cse_appends)
+    else:
+        env['cse_fingerprint'] = ''
+
     body = []
 
     if uses_single_grad(func):
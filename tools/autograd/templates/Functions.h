@@ -7,6 +7,7 @@
 #include <ATen/TensorGeometry.h>
 
 #include "torch/csrc/THP_export.h"
+#include "torch/csrc/autograd/cse.h"
 #include "torch/csrc/autograd/function.h"
 #include "torch/csrc/autograd/variable.h"
 #include "torch/csrc/autograd/saved_variable.h"
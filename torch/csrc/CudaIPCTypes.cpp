@@ -1,6 +1,7 @@
 #ifdef USE_CUDA
 #include <torch/csrc/CudaIPCTypes.h>
 #include <TH/THAllocator.h>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <random>
@@ -52,6 +53,69 @@ struct CudaIPCGlobalEntities {
 
 CudaIPCGlobalEntities cuda_ipc_global_entities;
 
+// Note [CUDA IPC event pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Every shared tensor used to create and destroy its interprocess sync
+// event: two driver calls per handoff on the hot path of multi-process
+// serving. Interprocess events are reusable -- recording again and
+// re-exporting the handle is legal, and by the time a CudaIPCSentData is
+// destroyed every consumer has already issued its wait -- so retired events
+// are parked in a fixed array of per-device slots and new sends take one
+// from there first. Slot claims are single atomic exchanges, so neither
+// path takes a lock; an empty pool falls through to
+// cudaEventCreateWithFlags exactly as before, and a full pool destroys the
+// event as before. Pooled events stay recorded and thus keep their charge
+// against sync_events_used_; the budget is only returned when an event is
+// actually destroyed. Events still pooled at shutdown are deliberately
+// leaked, since the CUDA context may already be gone during static
+// destruction.
+
+constexpr int kEventPoolMaxDevices = 64;
+constexpr int kEventPoolSlotsPerDevice = 64;
+
+struct CudaIPCEventPool {
+  std::atomic<cudaEvent_t> slots_[kEventPoolMaxDevices]
+                                 [kEventPoolSlotsPerDevice];
+
+  CudaIPCEventPool() {
+    for (auto& device_slots : slots_) {
+      for (auto& slot : device_slots) {
+        slot.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool acquire(int64_t device, cudaEvent_t* out) {
+    if (device < 0 || device >= kEventPoolMaxDevices) {
+      return false;
+    }
+    for (auto& slot : slots_[device]) {
+      cudaEvent_t event = slot.exchange(nullptr, std::memory_order_acq_rel);
+      if (event != nullptr) {
+        *out = event;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool release(int64_t device, cudaEvent_t event) {
+    if (device < 0 || device >= kEventPoolMaxDevices) {
+      return false;
+    }
+    for (auto& slot : slots_[device]) {
+      cudaEvent_t expected = nullptr;
+      if (slot.compare_exchange_strong(
+              expected, event, std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+CudaIPCEventPool cuda_ipc_event_pool;
+
 CudaIPCSentDataLimbo::~CudaIPCSentDataLimbo() {
   collect();
   if (shared_blocks_.size() > 0) {
@@ -139,11 +203,15 @@ CudaIPCSentData::CudaIPCSentData(
     // the moment of the queue.put). The reason this is more efficient is
     // because the main thread may have queued extra work on the stream, which
     // this event will consequently wait for (uselessly).
-    cuda_ipc_global_entities.sync_events_used_ ++;
-    C10_CUDA_CHECK(cudaEventCreateWithFlags(
-        &event_,
-        cudaEventDisableTiming | cudaEventInterprocess |
-            cudaEventBlockingSync));
+    // See Note [CUDA IPC event pool]: steady-state sends reuse a retired
+    // event instead of creating one.
+    if (!cuda_ipc_event_pool.acquire(device.index(), &event_)) {
+      cuda_ipc_global_entities.sync_events_used_ ++;
+      C10_CUDA_CHECK(cudaEventCreateWithFlags(
+          &event_,
+          cudaEventDisableTiming | cudaEventInterprocess |
+              cudaEventBlockingSync));
+    }
     C10_CUDA_CHECK(cudaEventRecord(
         event_, c10::cuda::getCurrentCUDAStream(device.index())));
     event_sync_required_ = true;
@@ -167,8 +235,12 @@ CudaIPCSentData::~CudaIPCSentData() {
   try {
     if (event_sync_required_) {
       at::cuda::CUDAGuard device_guard(device_.index());
-      cudaEventDestroy(event_);
-      cuda_ipc_global_entities.sync_events_used_ --;
+      // See Note [CUDA IPC event pool]: park the event for reuse; only
+      // destroy (and return the event budget) when the pool is full.
+      if (!cuda_ipc_event_pool.release(device_.index(), event_)) {
+        cudaEventDestroy(event_);
+        cuda_ipc_global_entities.sync_events_used_ --;
+      }
     }
   } catch (...) { /* No throw */
   }
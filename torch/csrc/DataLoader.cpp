@@ -209,10 +209,211 @@ static PyObject *THPModule_errorIfAnyWorkerFails(PyObject *module, PyObject *_ig
 
 #endif
 
+// Note [DataLoader shm arena ring]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Passing a tensor from a DataLoader worker to the main process normally
+// allocates a fresh shared-memory segment per storage (shm_open + mmap +
+// unlink), which at high batch rates is a measurable slice of the input
+// pipeline. The functions below maintain a ring of persistent, pre-sized
+// shared-memory arenas instead: the main process creates the ring once,
+// workers attach (or simply inherit the mappings over fork), batches are
+// written in place, and only (arena index, offset, dtype, sizes) crosses
+// the worker queue. Ownership of an arena slot is by convention: a worker
+// writes a slot and the main process reads it before the ring wraps, which
+// the Python side enforces by keeping the ring at least one batch deeper
+// than the prefetch depth.
+
+#include <ATen/ATen.h>
+#include <TH/THAllocator.h>
+#include <torch/csrc/Exceptions.h>
+#include <torch/csrc/autograd/python_variable.h>
+#include <torch/csrc/utils/object_ptr.h>
+#include <torch/csrc/utils/python_numbers.h>
+#include <torch/csrc/utils/python_strings.h>
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct ShmArena {
+  at::DataPtr data;
+  size_t size;
+  std::string name;
+};
+
+// Offsets handed back to Python are rounded up to this, so every tensor
+// written into an arena is serviceable by vectorized kernels in the reader.
+constexpr size_t kShmArenaAlignment = 64;
+
+std::mutex shm_arena_mutex;
+std::vector<std::shared_ptr<ShmArena>> shm_arenas;
+
+std::shared_ptr<ShmArena> getShmArena(int64_t index) {
+  std::lock_guard<std::mutex> lock(shm_arena_mutex);
+  if (index < 0 || static_cast<size_t>(index) >= shm_arenas.size()) {
+    throw torch::ValueError("shm arena index %lld out of range", (long long)index);
+  }
+  return shm_arenas[index];
+}
+
+} // namespace
+
+// _create_shm_arenas(name_prefix, arena_bytes, count) -> list of names
+static PyObject *THPModule_createShmArenas(PyObject *module, PyObject *args) {
+  HANDLE_TH_ERRORS
+  PyObject* prefix_obj = nullptr;
+  Py_ssize_t arena_bytes = 0;
+  Py_ssize_t count = 0;
+  if (!PyArg_ParseTuple(args, "Onn", &prefix_obj, &arena_bytes, &count)) {
+    return nullptr;
+  }
+  const auto prefix = THPUtils_unpackString(prefix_obj);
+  if (arena_bytes <= 0 || count <= 0) {
+    throw torch::ValueError("arena size and count must be positive");
+  }
+
+  THPObjectPtr names(PyList_New(count));
+  if (!names) return nullptr;
+  std::lock_guard<std::mutex> lock(shm_arena_mutex);
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    auto arena = std::make_shared<ShmArena>();
+    arena->name = prefix + "_" + std::to_string(i);
+    arena->data = THMapAllocator::makeDataPtr(
+        arena->name.c_str(),
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+        arena_bytes,
+        /*actual_size_out=*/nullptr);
+    arena->size = arena_bytes;
+    shm_arenas.emplace_back(std::move(arena));
+    PyList_SET_ITEM(names.get(), i, THPUtils_packString(shm_arenas.back()->name));
+  }
+  return names.release();
+  END_HANDLE_TH_ERRORS
+}
+
+// _attach_shm_arenas(names, arena_bytes); used by spawned workers. Forked
+// workers inherit the mappings and need not call this.
+static PyObject *THPModule_attachShmArenas(PyObject *module, PyObject *args) {
+  HANDLE_TH_ERRORS
+  PyObject* names_obj = nullptr;
+  Py_ssize_t arena_bytes = 0;
+  if (!PyArg_ParseTuple(args, "On", &names_obj, &arena_bytes)) {
+    return nullptr;
+  }
+  THPObjectPtr names(PySequence_Fast(names_obj, "expected a sequence of arena names"));
+  if (!names) return nullptr;
+  const auto count = PySequence_Fast_GET_SIZE(names.get());
+  std::lock_guard<std::mutex> lock(shm_arena_mutex);
+  shm_arenas.clear();
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    auto arena = std::make_shared<ShmArena>();
+    arena->name = THPUtils_unpackString(PySequence_Fast_GET_ITEM(names.get(), i));
+    arena->data = THMapAllocator::makeDataPtr(
+        arena->name.c_str(),
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE,
+        arena_bytes,
+        /*actual_size_out=*/nullptr);
+    arena->size = arena_bytes;
+    shm_arenas.emplace_back(std::move(arena));
+  }
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+// _release_shm_arenas(); tensors still viewing an arena keep it mapped.
+static PyObject *THPModule_releaseShmArenas(PyObject *module, PyObject *_ignored) {
+  HANDLE_TH_ERRORS
+  std::lock_guard<std::mutex> lock(shm_arena_mutex);
+  shm_arenas.clear();
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+// _shm_arena_write(index, offset, tensor) -> (next_offset, dtype_code)
+// Copies the tensor's bytes into the arena and returns the aligned offset
+// one past them, plus the dtype code _shm_arena_read expects back.
+static PyObject *THPModule_shmArenaWrite(PyObject *module, PyObject *args) {
+  HANDLE_TH_ERRORS
+  Py_ssize_t index = 0;
+  Py_ssize_t offset = 0;
+  PyObject* tensor_obj = nullptr;
+  if (!PyArg_ParseTuple(args, "nnO", &index, &offset, &tensor_obj)) {
+    return nullptr;
+  }
+  if (!THPVariable_Check(tensor_obj)) {
+    throw torch::TypeError("expected a Tensor to write");
+  }
+  auto arena = getShmArena(index);
+  auto tensor = ((THPVariable*)tensor_obj)->cdata.data();
+  if (tensor.device().type() != at::kCPU || tensor.is_sparse()) {
+    throw torch::ValueError("only dense CPU tensors can be written to a shm arena");
+  }
+  auto contiguous = tensor.contiguous();
+  const size_t nbytes = contiguous.numel() * contiguous.element_size();
+  if (offset < 0 || static_cast<size_t>(offset) % kShmArenaAlignment != 0 ||
+      static_cast<size_t>(offset) + nbytes > arena->size) {
+    throw torch::ValueError(
+        "tensor of %zu bytes does not fit in arena at offset %lld",
+        nbytes, (long long)offset);
+  }
+  memcpy(static_cast<char*>(arena->data.get()) + offset, contiguous.data_ptr(), nbytes);
+  const size_t next = (static_cast<size_t>(offset) + nbytes + kShmArenaAlignment - 1) /
+      kShmArenaAlignment * kShmArenaAlignment;
+  return Py_BuildValue(
+      "(ni)", static_cast<Py_ssize_t>(next), static_cast<int>(tensor.scalar_type()));
+  END_HANDLE_TH_ERRORS
+}
+
+// _shm_arena_read(index, offset, dtype_code, sizes) -> Tensor
+// Returns a tensor viewing the arena in place (zero-copy); the view keeps
+// the arena mapped even after _release_shm_arenas.
+static PyObject *THPModule_shmArenaRead(PyObject *module, PyObject *args) {
+  HANDLE_TH_ERRORS
+  Py_ssize_t index = 0;
+  Py_ssize_t offset = 0;
+  int dtype_code = 0;
+  PyObject* sizes_obj = nullptr;
+  if (!PyArg_ParseTuple(args, "nniO", &index, &offset, &dtype_code, &sizes_obj)) {
+    return nullptr;
+  }
+  auto arena = getShmArena(index);
+  THPObjectPtr sizes_fast(PySequence_Fast(sizes_obj, "expected a sequence of sizes"));
+  if (!sizes_fast) return nullptr;
+  std::vector<int64_t> sizes(PySequence_Fast_GET_SIZE(sizes_fast.get()));
+  int64_t numel = 1;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    sizes[i] = THPUtils_unpackLong(PySequence_Fast_GET_ITEM(sizes_fast.get(), i));
+    numel *= sizes[i];
+  }
+  const auto dtype = static_cast<at::ScalarType>(dtype_code);
+  const size_t nbytes = numel * c10::elementSize(dtype);
+  if (offset < 0 || static_cast<size_t>(offset) + nbytes > arena->size) {
+    throw torch::ValueError(
+        "tensor of %zu bytes is out of arena bounds at offset %lld",
+        nbytes, (long long)offset);
+  }
+  auto tensor = at::from_blob(
+      static_cast<char*>(arena->data.get()) + offset,
+      sizes,
+      [arena](void*) {},
+      at::device(at::kCPU).dtype(dtype));
+  return THPVariable_Wrap(torch::autograd::make_variable(
+      std::move(tensor), /*requires_grad=*/false));
+  END_HANDLE_TH_ERRORS
+}
+
 PyMethodDef DataLoaderMethods[] = {
   {"_set_worker_signal_handlers",  (PyCFunction)THPModule_setWorkerSignalHandlers,  METH_NOARGS,   nullptr},
   {"_set_worker_pids",             (PyCFunction)THPModule_setWorkerPIDs,            METH_VARARGS,  nullptr},
   {"_remove_worker_pids",          (PyCFunction)THPModule_removeWorkerPIDs,         METH_O,        nullptr},
   {"_error_if_any_worker_fails",   (PyCFunction)THPModule_errorIfAnyWorkerFails,    METH_NOARGS,   nullptr},
+  {"_create_shm_arenas",           (PyCFunction)THPModule_createShmArenas,          METH_VARARGS,  nullptr},
+  {"_attach_shm_arenas",           (PyCFunction)THPModule_attachShmArenas,          METH_VARARGS,  nullptr},
+  {"_release_shm_arenas",          (PyCFunction)THPModule_releaseShmArenas,         METH_NOARGS,   nullptr},
+  {"_shm_arena_write",             (PyCFunction)THPModule_shmArenaWrite,            METH_VARARGS,  nullptr},
+  {"_shm_arena_read",              (PyCFunction)THPModule_shmArenaRead,             METH_VARARGS,  nullptr},
   {nullptr, nullptr, 0, nullptr}
 };
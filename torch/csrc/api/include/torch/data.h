@@ -2,6 +2,7 @@
 
 #include <torch/data/dataloader.h>
 #include <torch/data/datasets.h>
+#include <torch/data/device_reader.h>
 #include <torch/data/samplers.h>
 #include <torch/data/transforms.h>
 
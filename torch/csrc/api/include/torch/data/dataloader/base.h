@@ -1,6 +1,7 @@
 #pragma once
 
 #include <torch/data/dataloader_options.h>
+#include <torch/data/detail/batch_bytes.h>
 #include <torch/data/detail/data_shuttle.h>
 #include <torch/data/detail/sequencers.h>
 #include <torch/data/iterator.h>
@@ -13,6 +14,8 @@
 
 #include <c10/util/Exception.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <memory>
@@ -23,6 +26,28 @@
 
 namespace torch {
 namespace data {
+
+/// Counters describing the state of a DataLoader's prefetch pipeline,
+/// obtained from `DataLoaderBase::stats()`. All values reset at the start of
+/// each epoch.
+struct DataLoaderStats {
+  /// Jobs that have been scheduled but whose batch was not yet consumed.
+  size_t in_flight_jobs = 0;
+  /// CPU memory held by fetched but not yet consumed batches.
+  size_t outstanding_host_bytes = 0;
+  /// GPU memory held by fetched but not yet consumed batches.
+  size_t outstanding_device_bytes = 0;
+  /// High-water mark of `outstanding_host_bytes + outstanding_device_bytes`.
+  size_t peak_outstanding_bytes = 0;
+  /// Number of prefetches deferred because the byte budget was exceeded.
+  size_t throttled_jobs = 0;
+  /// Number of batches handed out so far.
+  size_t batches_popped = 0;
+  /// Cumulative time the consumer spent waiting for the next batch. Dividing
+  /// by `batches_popped` gives the mean per-batch latency.
+  std::chrono::microseconds total_wait_time{0};
+};
+
 template <typename Dataset, typename Batch, typename BatchRequest>
 class DataLoaderBase {
  public:
@@ -96,6 +121,20 @@ class DataLoaderBase {
     return options_;
   }
 
+  /// Returns a snapshot of the prefetch pipeline's queue-depth and latency
+  /// counters. May only be invoked from the main thread.
+  DataLoaderStats stats() const noexcept {
+    DataLoaderStats stats;
+    stats.in_flight_jobs = shuttle_.in_flight_jobs();
+    stats.outstanding_host_bytes = outstanding_host_bytes_;
+    stats.outstanding_device_bytes = outstanding_device_bytes_;
+    stats.peak_outstanding_bytes = peak_outstanding_bytes_;
+    stats.throttled_jobs = throttled_jobs_;
+    stats.batches_popped = batches_popped_;
+    stats.total_wait_time = total_wait_time_;
+    return stats;
+  }
+
  protected:
   /// Simple mix-in to give something a sequence number.
   struct Sequenced {
@@ -126,6 +165,8 @@ class DataLoaderBase {
         : Sequenced(sqn), exception(std::move(exception)) {}
     optional<Batch> batch;
     std::exception_ptr exception;
+    /// Memory kept alive by `batch`, measured by the worker that fetched it.
+    detail::BatchBytes bytes;
   };
 
   /// Subclass hook for getting the next batch request. The stateless case will
@@ -137,6 +178,15 @@ class DataLoaderBase {
   /// new jobs.
   virtual void reset() {
     shuttle_.drain();
+    // All workers are idle once the shuttle is drained, so the byte
+    // accounting (which drain() bypasses) can simply be zeroed.
+    outstanding_host_bytes_ = 0;
+    outstanding_device_bytes_ = 0;
+    peak_outstanding_bytes_ = 0;
+    deferred_jobs_ = 0;
+    throttled_jobs_ = 0;
+    batches_popped_ = 0;
+    total_wait_time_ = std::chrono::microseconds(0);
     sequence_number_ = 0;
     sequencer_ = new_sequencer();
     prefetch();
@@ -168,11 +218,26 @@ class DataLoaderBase {
         if (result->exception) {
           throw WorkerException(result->exception);
         } else if (result->batch) {
-          prefetch(1);
+          // This batch leaves the loader, so its memory no longer counts
+          // against the budget.
+          outstanding_host_bytes_ -= result->bytes.host;
+          outstanding_device_bytes_ -= result->bytes.device;
+          ++batches_popped_;
+          if (over_byte_budget()) {
+            // Backpressure: don't refill the pipeline while fetched batches
+            // are piling up; the deferred jobs are scheduled as soon as the
+            // consumer has drained back under the budget.
+            ++deferred_jobs_;
+            ++throttled_jobs_;
+          } else {
+            prefetch(1 + deferred_jobs_);
+            deferred_jobs_ = 0;
+          }
           return std::move(result->batch);
         }
       }
     } else if (auto batch_request = get_batch_request()) {
+      ++batches_popped_;
       return this->main_thread_dataset_->get_batch(std::move(*batch_request));
     }
     return nullopt;
@@ -187,7 +252,10 @@ class DataLoaderBase {
       }
       try {
         auto batch = dataset.get_batch(std::move(*job.batch_request));
-        shuttle_.push_result({std::move(batch), job.sequence_number});
+        Result result(std::move(batch), job.sequence_number);
+        result.bytes = detail::batch_bytes(*result.batch);
+        charge_bytes(result.bytes);
+        shuttle_.push_result(std::move(result));
       } catch (...) {
         shuttle_.push_result({std::current_exception(), job.sequence_number});
       }
@@ -203,8 +271,33 @@ class DataLoaderBase {
 
   /// Convenience method that gets the next result from the sequencer.
   optional<Result> pop_result() {
-    return sequencer_->next(
+    const auto start = std::chrono::steady_clock::now();
+    auto result = sequencer_->next(
         [this] { return this->shuttle_.pop_result(this->options_.timeout); });
+    total_wait_time_ += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    return result;
+  }
+
+  /// True if a byte budget is configured and currently exceeded.
+  bool over_byte_budget() const noexcept {
+    return options_.max_outstanding_bytes &&
+        (outstanding_host_bytes_ + outstanding_device_bytes_ >
+         *options_.max_outstanding_bytes);
+  }
+
+  /// Adds a finished batch's memory to the outstanding-byte counters. Called
+  /// by worker threads just before the result is pushed.
+  void charge_bytes(const detail::BatchBytes& bytes) {
+    outstanding_host_bytes_ += bytes.host;
+    outstanding_device_bytes_ += bytes.device;
+    // The two loads are not one atomic snapshot, which is fine for a
+    // high-water mark.
+    size_t total = outstanding_host_bytes_ + outstanding_device_bytes_;
+    size_t peak = peak_outstanding_bytes_.load();
+    while (total > peak &&
+           !peak_outstanding_bytes_.compare_exchange_weak(peak, total)) {
+    }
   }
 
   /// Convenience method that creates a new sequencer based on the
@@ -239,6 +332,23 @@ class DataLoaderBase {
   /// The `Sequencer`, which handles optional ordering of batches.
   std::unique_ptr<detail::sequencers::Sequencer<Result>> sequencer_;
 
+  /// Bytes held by batches that were fetched but not yet consumed. Incremented
+  /// by worker threads and decremented by the main thread, hence atomic; all
+  /// decisions based on them are made by the main thread only.
+  std::atomic<size_t> outstanding_host_bytes_{0};
+  std::atomic<size_t> outstanding_device_bytes_{0};
+  std::atomic<size_t> peak_outstanding_bytes_{0};
+
+  /// Prefetches postponed because the byte budget was exceeded; scheduled in
+  /// one batch once the consumer drains back under the budget.
+  /// NOTE: Not atomic because only manipulated by the main thread.
+  size_t deferred_jobs_ = 0;
+
+  /// Statistics reported by `stats()`; main thread only.
+  size_t throttled_jobs_ = 0;
+  size_t batches_popped_ = 0;
+  std::chrono::microseconds total_wait_time_{0};
+
   /// True if the DataLoader has joined its worker threads.
   bool joined_ = false;
 };
@@ -26,6 +26,14 @@ struct DataLoaderOptions {
   /// Defaults to two times the number of worker threads.
   TORCH_ARG(optional<size_t>, max_jobs);
 
+  /// An optional budget, in bytes, for batches that have been fetched but not
+  /// yet consumed (host and device memory combined). When the outstanding
+  /// bytes exceed this budget, the DataLoader stops scheduling new prefetch
+  /// jobs until the consumer catches up, instead of filling `max_jobs`
+  /// unconditionally. Batches whose memory cannot be inspected count as zero
+  /// bytes. Unset means no budget.
+  TORCH_ARG(optional<size_t>, max_outstanding_bytes);
+
   /// An optional limit on the time to wait for the next batch.
   TORCH_ARG(optional<std::chrono::milliseconds>, timeout);
 
@@ -50,6 +58,7 @@ struct FullDataLoaderOptions {
       : batch_size(options.batch_size_),
         workers(options.workers_),
         max_jobs(options.max_jobs_.value_or(2 * workers)),
+        max_outstanding_bytes(options.max_outstanding_bytes_),
         timeout(options.timeout_),
         enforce_ordering(options.enforce_ordering_),
         drop_last(options.drop_last_) {}
@@ -57,6 +66,7 @@ struct FullDataLoaderOptions {
   size_t batch_size;
   size_t workers;
   size_t max_jobs;
+  optional<size_t> max_outstanding_bytes;
   optional<std::chrono::milliseconds> timeout;
   bool enforce_ordering;
   bool drop_last;
@@ -2,8 +2,10 @@
 
 #include <torch/data/datasets/base.h>
 #include <torch/data/datasets/chunk.h>
+#include <torch/data/datasets/chunk_record.h>
 #include <torch/data/datasets/map.h>
 #include <torch/data/datasets/mnist.h>
 #include <torch/data/datasets/shared.h>
+#include <torch/data/datasets/shared_cache.h>
 #include <torch/data/datasets/stateful.h>
 #include <torch/data/datasets/tensor.h>
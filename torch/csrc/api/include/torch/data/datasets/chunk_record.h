@@ -0,0 +1,97 @@
+#pragma once
+
+#include <torch/data/datasets/chunk.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+namespace detail {
+struct MappedRecordFile;
+} // namespace detail
+
+/// Writes a chunk record file: an indexed, append-only container of
+/// serialized `Example`s, grouped into chunks.
+///
+/// Each example's `(data, target)` pair is serialized with the JIT `Pickler`
+/// wire format; the raw tensor payloads are written alongside the pickle
+/// stream, aligned so that a memory-mapped reader can view them in place.
+/// A footer index of chunk offsets is written by `finish()`, so a record
+/// file is only valid once the writer has been finished (or destroyed).
+///
+/// The resulting file is read back with `ChunkRecordReader`, typically
+/// behind a `ChunkDataset` that prefetches and shuffles chunks on
+/// background threads.
+class TORCH_API ChunkRecordWriter {
+ public:
+  /// Opens `path` for writing, truncating any existing file.
+  explicit ChunkRecordWriter(const std::string& path);
+
+  ChunkRecordWriter(const ChunkRecordWriter&) = delete;
+  ChunkRecordWriter& operator=(const ChunkRecordWriter&) = delete;
+
+  ~ChunkRecordWriter();
+
+  /// Appends one chunk of examples to the file. A chunk is the unit of
+  /// prefetching and shuffling on the read side, so it should be large
+  /// enough to amortize per-chunk overhead (thousands of examples).
+  void write_chunk(const std::vector<Example<>>& examples);
+
+  /// Writes the footer index and closes the file. Called by the destructor
+  /// if not called explicitly; call it directly to surface write errors.
+  void finish();
+
+ private:
+  std::string path_;
+  std::ofstream stream_;
+  std::vector<uint64_t> chunk_offsets_;
+  std::vector<uint64_t> chunk_sizes_;
+  std::vector<uint64_t> chunk_example_counts_;
+  bool finished_ = false;
+};
+
+/// Reads a chunk record file written by `ChunkRecordWriter`.
+///
+/// The file is memory-mapped once; `read_chunk` decodes examples directly
+/// out of the mapping, and the returned tensors alias the mapped pages
+/// (zero-copy), so reading a chunk costs no data copies and no read
+/// syscalls beyond the page faults. The mapping stays alive for as long as
+/// any tensor produced from it does.
+///
+/// `read_chunk` is thread-safe and may be called concurrently from the
+/// `ChunkDataset` preloader threads.
+class TORCH_API ChunkRecordReader
+    : public ChunkDataReader<std::vector<Example<>>> {
+ public:
+  explicit ChunkRecordReader(const std::string& path);
+  ~ChunkRecordReader() override;
+
+  /// Decodes and returns the examples of chunk `chunk_index`.
+  ChunkType read_chunk(size_t chunk_index) override;
+
+  /// Returns the number of chunks in the file.
+  size_t chunk_count() override;
+
+  /// Resets the reader; reading is stateless, so this is a no-op.
+  void reset() override;
+
+ private:
+  std::shared_ptr<detail::MappedRecordFile> file_;
+  std::vector<uint64_t> chunk_offsets_;
+  std::vector<uint64_t> chunk_sizes_;
+};
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
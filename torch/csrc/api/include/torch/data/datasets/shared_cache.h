@@ -0,0 +1,142 @@
+#pragma once
+
+#include <torch/data/datasets/base.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+/// A read-mostly cache of serialized examples, shared by every process on a
+/// host that attaches to the same backing file.
+///
+/// The cache is a file-backed, memory-mapped array of fixed-size slots. A key
+/// (the example index) hashes to exactly one slot; a store overwrites that
+/// slot, so there is no eviction policy beyond hash collisions. Each slot is
+/// protected by a seqlock: readers copy the payload and validate the slot's
+/// sequence number around the copy, writers bump it to odd while writing, so
+/// lookups never take a lock and a torn read is detected and reported as a
+/// miss. Payloads larger than the slot size are simply not cached.
+///
+/// This trades strict LRU behavior for zero cross-process coordination: with
+/// a sampler that revisits a small hot set, the hot examples are decoded once
+/// per host instead of once per worker per epoch. Not available on Windows
+/// (requires mmap).
+class TORCH_API SharedExampleCache {
+ public:
+  /// Creates the cache file at `path` (sized for `slot_count` slots of
+  /// `slot_bytes` payload each) or attaches to it if it already exists, in
+  /// which case the geometry must match.
+  SharedExampleCache(const std::string& path, size_t slot_count, size_t slot_bytes);
+
+  SharedExampleCache(const SharedExampleCache&) = delete;
+  SharedExampleCache& operator=(const SharedExampleCache&) = delete;
+
+  ~SharedExampleCache();
+
+  /// Copies the payload cached for `key` into `payload` and returns true, or
+  /// returns false if the slot holds another key, is empty, or was being
+  /// written to.
+  bool lookup(uint64_t key, std::vector<char>& payload);
+
+  /// Caches `size` bytes for `key`, overwriting whatever the slot held.
+  /// Silently does nothing if the payload does not fit in a slot or another
+  /// writer holds the slot.
+  void store(uint64_t key, const char* data, size_t size);
+
+  /// Lookups served from the cache by this handle.
+  uint64_t hits() const noexcept {
+    return hits_.load();
+  }
+  /// Lookups that missed (wrong key, empty, torn, or oversized store).
+  uint64_t misses() const noexcept {
+    return misses_.load();
+  }
+
+ private:
+  char* slot_at(size_t slot) const;
+
+  std::string path_;
+  size_t slot_count_;
+  size_t slot_bytes_;
+  size_t slot_stride_ = 0;
+  size_t map_size_ = 0;
+  void* base_ = nullptr;
+  int fd_ = -1;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+namespace detail {
+/// Serializes an example's tensors (dtype, shape, and raw contiguous
+/// payload) into a flat buffer suitable for a `SharedExampleCache` slot.
+/// Both tensors must live on the CPU.
+TORCH_API std::vector<char> encode_example(const Example<>& example);
+/// Inverse of `encode_example`.
+TORCH_API Example<> decode_example(const char* data, size_t size);
+} // namespace detail
+
+/// A dataset adapter that consults a `SharedExampleCache` before decoding.
+///
+/// `get` first looks the example index up in the cache; on a hit the example
+/// is rebuilt from the cached bytes, on a miss the underlying dataset decodes
+/// it and the encoded result is stored for every other worker (and process)
+/// attached to the same cache file. The underlying dataset's examples must be
+/// `Example<>` with CPU tensors.
+template <typename SourceDataset>
+class SharedCacheDataset
+    : public Dataset<SharedCacheDataset<SourceDataset>, Example<>> {
+ public:
+  SharedCacheDataset(
+      SourceDataset source,
+      std::shared_ptr<SharedExampleCache> cache)
+      : source_(std::move(source)), cache_(std::move(cache)) {}
+
+  Example<> get(size_t index) override {
+    std::vector<char> payload;
+    if (cache_->lookup(index, payload)) {
+      return detail::decode_example(payload.data(), payload.size());
+    }
+    Example<> example = source_.get(index);
+    auto encoded = detail::encode_example(example);
+    cache_->store(index, encoded.data(), encoded.size());
+    return example;
+  }
+
+  optional<size_t> size() const override {
+    return source_.size();
+  }
+
+  /// The underlying dataset.
+  SourceDataset& source() {
+    return source_;
+  }
+
+ private:
+  SourceDataset source_;
+  std::shared_ptr<SharedExampleCache> cache_;
+};
+
+/// Wraps `dataset` so its decoded examples are shared through `cache`.
+template <typename SourceDataset>
+SharedCacheDataset<SourceDataset> share_decoded_examples(
+    SourceDataset dataset,
+    std::shared_ptr<SharedExampleCache> cache) {
+  return SharedCacheDataset<SourceDataset>(
+      std::move(dataset), std::move(cache));
+}
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace detail {
+
+/// The memory held by a fetched batch, split by where it lives.
+///
+/// The `DataLoader` sums these over all batches that have been fetched but
+/// not yet consumed in order to apply backpressure to prefetching; see
+/// `DataLoaderOptions::max_outstanding_bytes`.
+struct BatchBytes {
+  size_t host = 0;
+  size_t device = 0;
+
+  size_t total() const noexcept {
+    return host + device;
+  }
+};
+
+/// Catch-all for batch types whose memory use we cannot inspect (e.g. `int`
+/// batches in tests, or user-defined types). Such batches count as zero
+/// bytes, which makes a byte budget inert for them rather than wrong.
+template <typename T>
+void count_batch_bytes(const T& /* batch */, BatchBytes& /* bytes */) {}
+
+inline void count_batch_bytes(const at::Tensor& tensor, BatchBytes& bytes) {
+  if (!tensor.defined()) {
+    return;
+  }
+  if (tensor.is_cuda()) {
+    bytes.device += tensor.nbytes();
+  } else {
+    bytes.host += tensor.nbytes();
+  }
+}
+
+template <typename Data, typename Target>
+void count_batch_bytes(
+    const Example<Data, Target>& example,
+    BatchBytes& bytes) {
+  count_batch_bytes(example.data, bytes);
+  count_batch_bytes(example.target, bytes);
+}
+
+template <typename Data>
+void count_batch_bytes(
+    const Example<Data, example::NoTarget>& example,
+    BatchBytes& bytes) {
+  count_batch_bytes(example.data, bytes);
+}
+
+template <typename T>
+void count_batch_bytes(const std::vector<T>& batch, BatchBytes& bytes) {
+  for (const auto& element : batch) {
+    count_batch_bytes(element, bytes);
+  }
+}
+
+/// Returns the (approximate) number of bytes `batch` keeps alive.
+template <typename Batch>
+BatchBytes batch_bytes(const Batch& batch) {
+  BatchBytes bytes;
+  count_batch_bytes(batch, bytes);
+  return bytes;
+}
+
+} // namespace detail
+} // namespace data
+} // namespace torch
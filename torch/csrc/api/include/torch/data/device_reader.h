@@ -0,0 +1,37 @@
+#pragma once
+
+#include <torch/types.h>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstddef>
+#include <string>
+
+namespace torch {
+namespace data {
+
+/// Reads the contents of `path` into a one-dimensional `kByte` tensor on
+/// `device`, without bouncing the payload through pageable host memory.
+///
+/// For CPU targets this is an ordinary buffered read. For CUDA targets the
+/// file is read with O_DIRECT (when the filesystem supports it) in
+/// `chunk_bytes`-sized pieces into a small ring of pinned staging buffers,
+/// and each piece is copied to the device asynchronously on a stream drawn
+/// from the pool, so reads from disk overlap the H2D copies and every byte
+/// is touched at most once on the host. The returned tensor is ready to use
+/// on the current stream.
+///
+/// This is the device-targeted load path for decode-on-GPU pipelines: a
+/// `ChunkDataReader` whose decoding runs on the device can land raw chunk
+/// bytes directly in device memory here instead of materializing them on
+/// the host first.
+///
+/// `chunk_bytes` is rounded up to a multiple of 4096 (the strictest
+/// O_DIRECT alignment in common use).
+TORCH_API Tensor read_file_to_tensor(
+    const std::string& path,
+    Device device,
+    size_t chunk_bytes = 1 << 22);
+
+} // namespace data
+} // namespace torch
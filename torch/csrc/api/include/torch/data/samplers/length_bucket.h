@@ -0,0 +1,69 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/data/samplers/base.h>
+#include <torch/types.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace torch {
+namespace serialize {
+class OutputArchive;
+class InputArchive;
+} // namespace serialize
+} // namespace torch
+
+namespace torch {
+namespace data {
+namespace samplers {
+
+/// A `Sampler` that groups samples of similar sequence length.
+///
+/// Padding a batch to its longest sequence wastes compute on every shorter
+/// sequence, so RNN pipelines want batches whose lengths are close together.
+/// This sampler shuffles the dataset, partitions the shuffled order into
+/// buckets of `bucket_size` consecutive indices, and sorts each bucket by
+/// length in decreasing order. Batches drawn from the result are near-sorted
+/// (ready for `pack_padded_sequence`) while the shuffle between epochs keeps
+/// batch composition random. Choose `bucket_size` as a multiple of the batch
+/// size so batches do not straddle bucket boundaries; a common choice is
+/// 100x the batch size.
+class LengthBucketSampler : public Sampler<> {
+ public:
+  /// Constructs a `LengthBucketSampler` from the per-sample sequence
+  /// lengths. If `shuffle` is false, buckets are formed over the original
+  /// dataset order (deterministic, e.g. for evaluation).
+  TORCH_API explicit LengthBucketSampler(
+      std::vector<int64_t> lengths,
+      size_t bucket_size,
+      bool shuffle = true);
+
+  /// Re-shuffles and re-buckets the indices. The size of the dataset cannot
+  /// change, since every sample needs a known length.
+  TORCH_API void reset(optional<size_t> new_size = nullopt) override;
+
+  /// Returns the next batch of indices.
+  TORCH_API optional<std::vector<size_t>> next(size_t batch_size) override;
+
+  /// Serializes the `LengthBucketSampler` to the `archive`.
+  TORCH_API void save(serialize::OutputArchive& archive) const override;
+
+  /// Deserializes the `LengthBucketSampler` from the `archive`.
+  TORCH_API void load(serialize::InputArchive& archive) override;
+
+  /// Returns the current index of the `LengthBucketSampler`.
+  TORCH_API size_t index() const noexcept;
+
+ private:
+  std::vector<int64_t> lengths_;
+  size_t bucket_size_;
+  bool shuffle_;
+  /// The bucketed iteration order over the dataset.
+  std::vector<size_t> order_;
+  size_t index_ = 0;
+};
+
+} // namespace samplers
+} // namespace data
+} // namespace torch
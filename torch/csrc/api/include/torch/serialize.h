@@ -3,6 +3,10 @@
 #include <torch/serialize/archive.h>
 #include <torch/serialize/tensor.h>
 
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
 #include <utility>
 
 namespace torch {
@@ -70,6 +74,42 @@ void save(const std::vector<torch::Tensor>& tensor_vec, SaveToArgs&&... args) {
   archive.save_to(std::forward<SaveToArgs>(args)...);
 }
 
+/// Serializes the given `value` to a file at `filename` on a background
+/// thread, returning a future that completes when the file has been
+/// written (or rethrows the serialization error on `get()`).
+///
+/// The state is snapshotted before this function returns: the archive is
+/// built on the calling thread and every tensor is replaced by a detached
+/// clone (device-side for CUDA tensors), so the training loop may keep
+/// mutating the model and optimizer while the previous checkpoint is
+/// still being serialized and written. Works for any `Value` accepted by
+/// `torch::save`, including `torch::nn::Module` subclasses and
+/// `torch::optim::Optimizer` state.
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   auto model_done = torch::save_async(model, "model.pt");
+///   auto optim_done = torch::save_async(sgd, "sgd.pt");
+///   // ... keep training ...
+///   model_done.get();
+///   optim_done.get();
+/// \endrst
+template <typename Value>
+std::future<void> save_async(const Value& value, std::string filename) {
+  auto archive = std::make_shared<serialize::OutputArchive>();
+  *archive << value;
+  archive->snapshot_tensors();
+  std::packaged_task<void()> task([archive, filename]() {
+    archive->save_to(filename);
+  });
+  auto future = task.get_future();
+  // The future from a packaged_task does not block on destruction, so a
+  // caller that drops it simply fires-and-forgets the checkpoint.
+  std::thread(std::move(task)).detach();
+  return future;
+}
+
 /// Deserializes the given `value`.
 /// There must be an overload of `operator>>` between `serialize::InputArchive`
 /// and `Value` for this method to be well-formed. Currently, such an overload
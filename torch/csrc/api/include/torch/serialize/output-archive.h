@@ -46,6 +46,14 @@ class TORCH_API OutputArchive final {
   /// `OutputArchive`.
   void write(const std::string& key, OutputArchive& nested_archive);
 
+  /// Replaces every tensor written so far (including ones in nested
+  /// archives) with a detached clone, so that subsequent mutation of the
+  /// originals -- an optimizer step, say -- does not affect what `save_to`
+  /// writes. CUDA tensors are cloned on the device. Used by
+  /// `torch::save_async` to snapshot state before serializing on a
+  /// background thread.
+  void snapshot_tensors();
+
   /// Saves the `OutputArchive` into a serialized representation in a file at
   /// `filename`.
   void save_to(const std::string& filename);
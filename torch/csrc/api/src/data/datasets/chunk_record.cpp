@@ -0,0 +1,341 @@
+#include <torch/data/datasets/chunk_record.h>
+
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <torch/csrc/jit/pickler.h>
+
+#include <ATen/core/ivalue.h>
+#include <c10/util/Exception.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace data {
+namespace datasets {
+namespace {
+
+// File layout:
+//
+//   [8 byte magic][u32 version]
+//   chunk 0, chunk 1, ...
+//   index: per chunk {u64 offset, u64 size, u64 example count}
+//   [u64 chunk count][u64 index offset][8 byte magic]
+//
+// Each chunk is [u64 example count] followed by the examples. An example is
+// its pickle stream ([u64 size][bytes]) and the tensor table it refers to;
+// each table entry is {i32 dtype, i32 ndim, i64 sizes..., u64 nbytes} with
+// the raw payload padded out to kPayloadAlignment relative to the start of
+// the file, so the mapped payload is usable in place by vectorized kernels.
+constexpr const char kMagic[8] = {'T', 'O', 'R', 'C', 'H', 'C', 'R', '\n'};
+constexpr uint32_t kVersion = 1;
+constexpr uint64_t kPayloadAlignment = 64;
+
+template <typename T>
+void write_value(std::ostream& stream, T value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_value(const uint8_t*& bytes, const uint8_t* end) {
+  AT_CHECK(
+      bytes + sizeof(T) <= end,
+      "Record file is truncated or corrupt (overran a chunk while reading)");
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  bytes += sizeof(T);
+  return value;
+}
+
+} // namespace
+
+namespace detail {
+
+/// A whole record file, mapped read-only. Tensors decoded out of the file
+/// alias the mapping and keep it alive through their deleters.
+struct MappedRecordFile {
+  MappedRecordFile() = default;
+  MappedRecordFile(const MappedRecordFile&) = delete;
+  MappedRecordFile& operator=(const MappedRecordFile&) = delete;
+
+  ~MappedRecordFile() {
+#ifndef _WIN32
+    if (mapped_ && base_ != nullptr) {
+      munmap(base_, size_);
+    }
+#endif
+    if (!mapped_) {
+      delete[] static_cast<uint8_t*>(base_);
+    }
+  }
+
+  static std::shared_ptr<MappedRecordFile> open(const std::string& path) {
+    auto result = std::make_shared<MappedRecordFile>();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    AT_CHECK(fd != -1, "Error opening record file at ", path);
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+      ::close(fd);
+      AT_ERROR("Error stat-ing record file at ", path);
+    }
+    void* base =
+        mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, /*offset=*/0);
+    // The mapping holds its own reference to the file.
+    ::close(fd);
+    AT_CHECK(base != MAP_FAILED, "Error mapping record file at ", path);
+    result->base_ = base;
+    result->size_ = st.st_size;
+    result->mapped_ = true;
+#else
+    // No mmap on Windows; fall back to reading the file into memory.
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    AT_CHECK(stream, "Error opening record file at ", path);
+    const auto size = static_cast<size_t>(stream.tellg());
+    auto* buffer = new uint8_t[size];
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char*>(buffer), size);
+    AT_CHECK(stream, "Error reading record file at ", path);
+    result->base_ = buffer;
+    result->size_ = size;
+#endif
+    return result;
+  }
+
+  const uint8_t* data() const {
+    return static_cast<const uint8_t*>(base_);
+  }
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  void* base_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+};
+
+} // namespace detail
+
+ChunkRecordWriter::ChunkRecordWriter(const std::string& path)
+    : path_(path), stream_(path, std::ios::binary | std::ios::trunc) {
+  AT_CHECK(stream_, "Error opening record file for writing at ", path_);
+  stream_.write(kMagic, sizeof(kMagic));
+  write_value<uint32_t>(stream_, kVersion);
+}
+
+ChunkRecordWriter::~ChunkRecordWriter() {
+  if (!finished_) {
+    try {
+      finish();
+    } catch (...) {
+      // Errors from the implicit finish are swallowed; call finish()
+      // explicitly to observe them.
+    }
+  }
+}
+
+void ChunkRecordWriter::write_chunk(const std::vector<Example<>>& examples) {
+  AT_CHECK(!finished_, "write_chunk called on a finished ChunkRecordWriter");
+  const auto chunk_offset = static_cast<uint64_t>(stream_.tellp());
+  write_value<uint64_t>(stream_, examples.size());
+
+  std::vector<at::Tensor> tensor_table;
+  for (const auto& example : examples) {
+    tensor_table.clear();
+    jit::Pickler pickler(&tensor_table);
+    pickler.start();
+    // `Unpickler::parse_ivalue_list` expects a generic list at the top
+    // level, so an example is stored as the list [data, target].
+    pickler.addIValue(
+        std::vector<c10::IValue>{example.data, example.target});
+    pickler.finish();
+
+    const auto& pickle = pickler.stack();
+    write_value<uint64_t>(stream_, pickle.size());
+    stream_.write(pickle.data(), pickle.size());
+
+    write_value<uint64_t>(stream_, tensor_table.size());
+    for (const auto& entry : tensor_table) {
+      AT_CHECK(
+          entry.device().type() == at::kCPU && !entry.is_sparse(),
+          "ChunkRecordWriter only supports dense CPU tensors, got ",
+          entry.type());
+      // Payloads are stored contiguously so the reader can view them
+      // in place without a stride table.
+      auto tensor = entry.contiguous();
+      write_value<int32_t>(
+          stream_, static_cast<int32_t>(tensor.scalar_type()));
+      write_value<int32_t>(stream_, static_cast<int32_t>(tensor.dim()));
+      for (const auto size : tensor.sizes()) {
+        write_value<int64_t>(stream_, size);
+      }
+      const uint64_t nbytes = tensor.numel() * tensor.element_size();
+      write_value<uint64_t>(stream_, nbytes);
+      const auto position = static_cast<uint64_t>(stream_.tellp());
+      for (uint64_t pad = position % kPayloadAlignment;
+           pad != 0 && pad < kPayloadAlignment;
+           ++pad) {
+        stream_.put('\0');
+      }
+      stream_.write(static_cast<const char*>(tensor.data_ptr()), nbytes);
+    }
+  }
+
+  chunk_offsets_.push_back(chunk_offset);
+  chunk_sizes_.push_back(
+      static_cast<uint64_t>(stream_.tellp()) - chunk_offset);
+  chunk_example_counts_.push_back(examples.size());
+  AT_CHECK(stream_, "Error writing record file at ", path_);
+}
+
+void ChunkRecordWriter::finish() {
+  AT_CHECK(!finished_, "finish called twice on a ChunkRecordWriter");
+  finished_ = true;
+  const auto index_offset = static_cast<uint64_t>(stream_.tellp());
+  for (size_t i = 0; i < chunk_offsets_.size(); ++i) {
+    write_value<uint64_t>(stream_, chunk_offsets_[i]);
+    write_value<uint64_t>(stream_, chunk_sizes_[i]);
+    write_value<uint64_t>(stream_, chunk_example_counts_[i]);
+  }
+  write_value<uint64_t>(stream_, chunk_offsets_.size());
+  write_value<uint64_t>(stream_, index_offset);
+  stream_.write(kMagic, sizeof(kMagic));
+  stream_.flush();
+  AT_CHECK(stream_, "Error finishing record file at ", path_);
+  stream_.close();
+}
+
+ChunkRecordReader::ChunkRecordReader(const std::string& path)
+    : file_(detail::MappedRecordFile::open(path)) {
+  constexpr size_t kFooterSize = 2 * sizeof(uint64_t) + sizeof(kMagic);
+  AT_CHECK(
+      file_->size() >= sizeof(kMagic) + sizeof(uint32_t) + kFooterSize &&
+          std::memcmp(file_->data(), kMagic, sizeof(kMagic)) == 0 &&
+          std::memcmp(
+              file_->data() + file_->size() - sizeof(kMagic),
+              kMagic,
+              sizeof(kMagic)) == 0,
+      "File at ", path, " is not a chunk record file");
+
+  const uint8_t* header = file_->data() + sizeof(kMagic);
+  const auto version =
+      read_value<uint32_t>(header, file_->data() + file_->size());
+  AT_CHECK(
+      version == kVersion,
+      "Unsupported record file version ", version, " in file at ", path);
+
+  const uint8_t* footer = file_->data() + file_->size() - kFooterSize;
+  const uint8_t* end = file_->data() + file_->size();
+  const auto chunk_count = read_value<uint64_t>(footer, end);
+  const auto index_offset = read_value<uint64_t>(footer, end);
+  AT_CHECK(
+      index_offset + chunk_count * 3 * sizeof(uint64_t) + kFooterSize ==
+          file_->size(),
+      "Record file index at ", path, " is corrupt");
+
+  const uint8_t* index = file_->data() + index_offset;
+  for (uint64_t i = 0; i < chunk_count; ++i) {
+    const auto offset = read_value<uint64_t>(index, end);
+    const auto size = read_value<uint64_t>(index, end);
+    // The per-chunk example count is only needed by the writer's index; the
+    // chunk payload repeats it, so it is skipped here.
+    read_value<uint64_t>(index, end);
+    AT_CHECK(
+        offset + size <= index_offset,
+        "Record file chunk ", i, " at ", path, " is out of bounds");
+    chunk_offsets_.push_back(offset);
+    chunk_sizes_.push_back(size);
+  }
+}
+
+ChunkRecordReader::~ChunkRecordReader() = default;
+
+ChunkRecordReader::ChunkType ChunkRecordReader::read_chunk(
+    size_t chunk_index) {
+  AT_CHECK(
+      chunk_index < chunk_offsets_.size(),
+      "Chunk index ", chunk_index, " out of range (have ",
+      chunk_offsets_.size(), " chunks)");
+  const uint8_t* bytes = file_->data() + chunk_offsets_[chunk_index];
+  const uint8_t* end = bytes + chunk_sizes_[chunk_index];
+
+  ChunkType examples;
+  const auto example_count = read_value<uint64_t>(bytes, end);
+  examples.reserve(example_count);
+
+  // The deleter of every decoded tensor carries a reference to the mapping.
+  auto file = file_;
+  std::vector<at::Tensor> tensor_table;
+  for (uint64_t i = 0; i < example_count; ++i) {
+    const auto pickle_size = read_value<uint64_t>(bytes, end);
+    AT_CHECK(
+        bytes + pickle_size <= end,
+        "Record file is truncated or corrupt (overran a pickle stream)");
+    const uint8_t* pickle = bytes;
+    bytes += pickle_size;
+
+    tensor_table.clear();
+    const auto tensor_count = read_value<uint64_t>(bytes, end);
+    for (uint64_t t = 0; t < tensor_count; ++t) {
+      const auto dtype =
+          static_cast<at::ScalarType>(read_value<int32_t>(bytes, end));
+      const auto ndim = read_value<int32_t>(bytes, end);
+      std::vector<int64_t> sizes(ndim);
+      int64_t numel = 1;
+      for (auto& size : sizes) {
+        size = read_value<int64_t>(bytes, end);
+        numel *= size;
+      }
+      const auto nbytes = read_value<uint64_t>(bytes, end);
+      AT_CHECK(
+          nbytes == numel * c10::elementSize(dtype),
+          "Record file tensor payload size does not match its shape");
+      const auto position =
+          static_cast<uint64_t>(bytes - file_->data()) % kPayloadAlignment;
+      if (position != 0) {
+        bytes += kPayloadAlignment - position;
+      }
+      AT_CHECK(
+          bytes + nbytes <= end,
+          "Record file is truncated or corrupt (overran a tensor payload)");
+      tensor_table.push_back(at::from_blob(
+          const_cast<uint8_t*>(bytes),
+          sizes,
+          [file](void*) {},
+          at::device(at::kCPU).dtype(dtype)));
+      bytes += nbytes;
+    }
+
+    jit::Unpickler unpickler(
+        const_cast<uint8_t*>(pickle), pickle_size, &tensor_table);
+    auto ivalues = unpickler.parse_ivalue_list();
+    AT_CHECK(
+        ivalues.size() == 2,
+        "Record file example does not decode to a (data, target) pair");
+    examples.emplace_back(ivalues[0].toTensor(), ivalues[1].toTensor());
+  }
+  return examples;
+}
+
+size_t ChunkRecordReader::chunk_count() {
+  return chunk_offsets_.size();
+}
+
+void ChunkRecordReader::reset() {}
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
@@ -0,0 +1,272 @@
+#include <torch/data/datasets/shared_cache.h>
+
+#include <c10/util/Exception.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace data {
+namespace datasets {
+namespace {
+
+// File layout:
+//
+//   Header { u64 magic, u64 slot_count, u64 slot_bytes }
+//   slot 0, slot 1, ...
+//
+// Each slot is Slot { atomic u64 sequence, u64 key, u64 size } followed by
+// slot_bytes of payload. The sequence is the slot's seqlock: even while the
+// slot is stable, odd while a writer is filling it. A freshly created file
+// is zero-filled, so every slot starts stable and empty (size == 0).
+constexpr uint64_t kCacheMagic = 0x5843455845485354ULL; // "TSHEXEXC"
+
+struct Header {
+  uint64_t magic;
+  uint64_t slot_count;
+  uint64_t slot_bytes;
+};
+
+struct Slot {
+  std::atomic<uint64_t> sequence;
+  uint64_t key;
+  uint64_t size;
+};
+
+static_assert(
+    sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+    "the slot seqlock must be a plain word in shared memory");
+
+// Spreads consecutive example indices over the slot table so strided
+// samplers do not pile onto a few slots (splitmix64 finalizer).
+uint64_t mix_key(uint64_t key) {
+  key += 0x9e3779b97f4a7c15ULL;
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+  return key ^ (key >> 31);
+}
+
+// How often a torn read is retried before it counts as a miss; the writer
+// holding the slot copies at most one slot worth of bytes, so one or two
+// retries normally suffice.
+constexpr int kLookupRetries = 3;
+
+} // namespace
+
+SharedExampleCache::SharedExampleCache(
+    const std::string& path,
+    size_t slot_count,
+    size_t slot_bytes)
+    : path_(path), slot_count_(slot_count), slot_bytes_(slot_bytes) {
+#ifndef _WIN32
+  AT_CHECK(slot_count_ > 0, "SharedExampleCache needs at least one slot");
+  slot_stride_ = sizeof(Slot) + slot_bytes_;
+  map_size_ = sizeof(Header) + slot_count_ * slot_stride_;
+
+  fd_ = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  AT_CHECK(fd_ != -1, "Error opening shared example cache at ", path);
+
+  // First process to hold the lock sizes and stamps the file; later ones
+  // validate that they agree on the geometry.
+  AT_CHECK(
+      flock(fd_, LOCK_EX) == 0,
+      "Error locking shared example cache at ",
+      path);
+  struct stat st;
+  AT_CHECK(
+      fstat(fd_, &st) == 0, "Error stat-ing shared example cache at ", path);
+  const bool fresh = st.st_size == 0;
+  if (fresh) {
+    AT_CHECK(
+        ftruncate(fd_, map_size_) == 0,
+        "Error sizing shared example cache at ",
+        path);
+  } else {
+    AT_CHECK(
+        static_cast<size_t>(st.st_size) == map_size_,
+        "Shared example cache at ",
+        path,
+        " has a different geometry than requested (",
+        slot_count,
+        " slots of ",
+        slot_bytes,
+        " bytes)");
+  }
+
+  base_ = mmap(
+      nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, /*offset=*/0);
+  AT_CHECK(
+      base_ != MAP_FAILED, "Error mapping shared example cache at ", path);
+
+  auto* header = static_cast<Header*>(base_);
+  if (fresh) {
+    header->slot_count = slot_count_;
+    header->slot_bytes = slot_bytes_;
+    header->magic = kCacheMagic;
+  } else {
+    AT_CHECK(
+        header->magic == kCacheMagic && header->slot_count == slot_count_ &&
+            header->slot_bytes == slot_bytes_,
+        "File at ",
+        path,
+        " is not a shared example cache with the requested geometry");
+  }
+  flock(fd_, LOCK_UN);
+#else
+  AT_ERROR("SharedExampleCache requires mmap and is not supported on Windows");
+#endif
+}
+
+SharedExampleCache::~SharedExampleCache() {
+#ifndef _WIN32
+  if (base_ != nullptr) {
+    munmap(base_, map_size_);
+  }
+  if (fd_ != -1) {
+    close(fd_);
+  }
+#endif
+}
+
+char* SharedExampleCache::slot_at(size_t slot) const {
+  return static_cast<char*>(base_) + sizeof(Header) + slot * slot_stride_;
+}
+
+bool SharedExampleCache::lookup(uint64_t key, std::vector<char>& payload) {
+  auto* slot = reinterpret_cast<Slot*>(slot_at(mix_key(key) % slot_count_));
+  for (int attempt = 0; attempt < kLookupRetries; ++attempt) {
+    const uint64_t before = slot->sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      continue; // a writer holds the slot
+    }
+    const uint64_t slot_key = slot->key;
+    const uint64_t size = slot->size;
+    if (size == 0 || slot_key != key || size > slot_bytes_) {
+      break;
+    }
+    payload.resize(size);
+    std::memcpy(
+        payload.data(), reinterpret_cast<char*>(slot + 1), size);
+    if (slot->sequence.load(std::memory_order_acquire) == before) {
+      hits_++;
+      return true;
+    }
+  }
+  misses_++;
+  return false;
+}
+
+void SharedExampleCache::store(uint64_t key, const char* data, size_t size) {
+  if (size == 0 || size > slot_bytes_) {
+    return;
+  }
+  auto* slot = reinterpret_cast<Slot*>(slot_at(mix_key(key) % slot_count_));
+  uint64_t before = slot->sequence.load(std::memory_order_acquire);
+  if (before & 1) {
+    return; // another writer holds the slot; this store is redundant
+  }
+  if (!slot->sequence.compare_exchange_strong(
+          before, before + 1, std::memory_order_acq_rel)) {
+    return;
+  }
+  slot->key = key;
+  slot->size = size;
+  std::memcpy(reinterpret_cast<char*>(slot + 1), data, size);
+  slot->sequence.store(before + 2, std::memory_order_release);
+}
+
+namespace detail {
+namespace {
+
+// A tensor is serialized as {i32 defined, i32 dtype, i32 ndim, i64 sizes...,
+// u64 nbytes, raw bytes}; an example is its two tensors back to back.
+
+template <typename T>
+void append(std::vector<char>& out, const T& value) {
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T consume(const char*& data, const char* end) {
+  T value;
+  AT_CHECK(
+      data + sizeof(T) <= end, "Truncated cached example payload");
+  std::memcpy(&value, data, sizeof(T));
+  data += sizeof(T);
+  return value;
+}
+
+void encode_tensor(std::vector<char>& out, const Tensor& tensor) {
+  append<int32_t>(out, tensor.defined() ? 1 : 0);
+  if (!tensor.defined()) {
+    return;
+  }
+  AT_CHECK(
+      !tensor.is_cuda(),
+      "SharedExampleCache can only hold CPU tensors");
+  Tensor contiguous = tensor.contiguous();
+  append<int32_t>(out, static_cast<int32_t>(contiguous.scalar_type()));
+  append<int32_t>(out, static_cast<int32_t>(contiguous.dim()));
+  for (int64_t size : contiguous.sizes()) {
+    append<int64_t>(out, size);
+  }
+  const uint64_t nbytes = contiguous.numel() * contiguous.element_size();
+  append<uint64_t>(out, nbytes);
+  const char* bytes = static_cast<const char*>(contiguous.data_ptr());
+  out.insert(out.end(), bytes, bytes + nbytes);
+}
+
+Tensor decode_tensor(const char*& data, const char* end) {
+  if (consume<int32_t>(data, end) == 0) {
+    return Tensor();
+  }
+  const auto dtype =
+      static_cast<at::ScalarType>(consume<int32_t>(data, end));
+  const auto ndim = consume<int32_t>(data, end);
+  std::vector<int64_t> sizes(ndim);
+  for (auto& size : sizes) {
+    size = consume<int64_t>(data, end);
+  }
+  const uint64_t nbytes = consume<uint64_t>(data, end);
+  Tensor tensor = torch::empty(sizes, at::TensorOptions(dtype));
+  AT_CHECK(
+      static_cast<uint64_t>(tensor.numel() * tensor.element_size()) == nbytes &&
+          data + nbytes <= end,
+      "Truncated cached example payload");
+  std::memcpy(tensor.data_ptr(), data, nbytes);
+  data += nbytes;
+  return tensor;
+}
+
+} // namespace
+
+std::vector<char> encode_example(const Example<>& example) {
+  std::vector<char> out;
+  encode_tensor(out, example.data);
+  encode_tensor(out, example.target);
+  return out;
+}
+
+Example<> decode_example(const char* data, size_t size) {
+  const char* end = data + size;
+  Example<> example;
+  example.data = decode_tensor(data, end);
+  example.target = decode_tensor(data, end);
+  return example;
+}
+
+} // namespace detail
+} // namespace datasets
+} // namespace data
+} // namespace torch
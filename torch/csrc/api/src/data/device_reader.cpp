@@ -0,0 +1,156 @@
+#include <torch/data/device_reader.h>
+
+#include <c10/util/Exception.h>
+
+#ifdef USE_CUDA
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <cuda_runtime.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+namespace torch {
+namespace data {
+namespace {
+
+constexpr size_t kDirectIOAlignment = 4096;
+
+Tensor read_file_to_cpu(const std::string& path) {
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  AT_CHECK(stream, "read_file_to_tensor: failed to open '", path, "'");
+  const auto size = static_cast<int64_t>(stream.tellg());
+  stream.seekg(0);
+  auto result = torch::empty({size}, torch::kByte);
+  stream.read(static_cast<char*>(result.data_ptr()), size);
+  AT_CHECK(
+      stream.gcount() == size,
+      "read_file_to_tensor: short read from '", path, "'");
+  return result;
+}
+
+#if defined(USE_CUDA) && !defined(_WIN32)
+
+// Opens the file for unbuffered reads when the filesystem allows it;
+// O_DIRECT fails with EINVAL on filesystems that do not support it (tmpfs,
+// some network mounts), in which case page-cache reads are the best we can
+// do and the staging ring still keeps the copy path pinned and overlapped.
+int open_for_read(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+  if (fd < 0 && errno == EINVAL) {
+    fd = ::open(path.c_str(), O_RDONLY);
+  }
+  AT_CHECK(
+      fd >= 0,
+      "read_file_to_tensor: failed to open '", path, "': ", strerror(errno));
+  return fd;
+}
+
+Tensor read_file_to_cuda(
+    const std::string& path,
+    Device device,
+    size_t chunk_bytes) {
+  chunk_bytes =
+      (chunk_bytes + kDirectIOAlignment - 1) / kDirectIOAlignment *
+      kDirectIOAlignment;
+
+  int fd = open_for_read(path);
+  struct stat file_stat;
+  AT_CHECK(
+      ::fstat(fd, &file_stat) == 0,
+      "read_file_to_tensor: failed to stat '", path, "'");
+  const auto size = static_cast<int64_t>(file_stat.st_size);
+
+  at::cuda::CUDAGuard device_guard(device);
+  auto result = torch::empty({size}, torch::device(device).dtype(torch::kByte));
+  auto* dst = static_cast<char*>(result.data_ptr());
+
+  // Reads land in a two-deep ring of pinned staging buffers: while chunk i
+  // is in flight to the device, chunk i+1 is being read from disk. The
+  // event on each buffer fences its reuse.
+  constexpr size_t kRingDepth = 2;
+  at::cuda::CUDAStream copy_stream = at::cuda::getStreamFromPool();
+  Tensor staging[kRingDepth];
+  cudaEvent_t events[kRingDepth];
+  for (size_t i = 0; i < kRingDepth; i++) {
+    // cudaHostAlloc returns page-aligned memory, which satisfies O_DIRECT.
+    staging[i] = torch::empty({static_cast<int64_t>(chunk_bytes)}, torch::kByte)
+                     .pin_memory();
+    AT_CUDA_CHECK(cudaEventCreateWithFlags(&events[i], cudaEventDisableTiming));
+  }
+
+  int64_t offset = 0;
+  size_t chunk_index = 0;
+  while (offset < size) {
+    const size_t slot = chunk_index % kRingDepth;
+    if (chunk_index >= kRingDepth) {
+      AT_CUDA_CHECK(cudaEventSynchronize(events[slot]));
+    }
+    auto* buffer = static_cast<char*>(staging[slot].data_ptr());
+    // Always request a full aligned chunk; the read comes back short at
+    // end of file, which O_DIRECT permits as long as the offset and buffer
+    // stay aligned.
+    size_t wanted = std::min<int64_t>(chunk_bytes, size - offset);
+    size_t got = 0;
+    while (got < wanted) {
+      ssize_t n = ::pread(fd, buffer + got, chunk_bytes - got, offset + got);
+      AT_CHECK(
+          n > 0,
+          "read_file_to_tensor: read failed on '", path, "': ",
+          n < 0 ? strerror(errno) : "unexpected end of file");
+      got += n;
+    }
+    AT_CUDA_CHECK(cudaMemcpyAsync(
+        dst + offset,
+        buffer,
+        wanted,
+        cudaMemcpyHostToDevice,
+        copy_stream.stream()));
+    AT_CUDA_CHECK(cudaEventRecord(events[slot], copy_stream.stream()));
+    offset += wanted;
+    chunk_index++;
+  }
+
+  // The staging buffers go away when this frame does, so the host must not
+  // return while copies out of them are still in flight.
+  AT_CUDA_CHECK(cudaStreamSynchronize(copy_stream.stream()));
+  for (size_t i = 0; i < kRingDepth; i++) {
+    AT_CUDA_CHECK(cudaEventDestroy(events[i]));
+  }
+  ::close(fd);
+  return result;
+}
+
+#endif // USE_CUDA && !_WIN32
+
+} // namespace
+
+Tensor read_file_to_tensor(
+    const std::string& path,
+    Device device,
+    size_t chunk_bytes) {
+  AT_CHECK(chunk_bytes > 0, "read_file_to_tensor: chunk_bytes must be positive");
+  if (device.is_cpu()) {
+    return read_file_to_cpu(path);
+  }
+#if defined(USE_CUDA) && !defined(_WIN32)
+  return read_file_to_cuda(path, device, chunk_bytes);
+#else
+  // No direct path on this build; fall back to a host read plus a single
+  // device copy.
+  return read_file_to_cpu(path).to(device);
+#endif
+}
+
+} // namespace data
+} // namespace torch
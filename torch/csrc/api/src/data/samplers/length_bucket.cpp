@@ -0,0 +1,105 @@
+#include <torch/data/samplers/length_bucket.h>
+#include <torch/serialize/archive.h>
+#include <torch/types.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace samplers {
+
+LengthBucketSampler::LengthBucketSampler(
+    std::vector<int64_t> lengths,
+    size_t bucket_size,
+    bool shuffle)
+    : lengths_(std::move(lengths)),
+      bucket_size_(bucket_size),
+      shuffle_(shuffle) {
+  AT_CHECK(bucket_size_ > 0, "bucket_size must be positive");
+  reset();
+}
+
+void LengthBucketSampler::reset(optional<size_t> new_size) {
+  const auto size = lengths_.size();
+  AT_CHECK(
+      new_size.value_or(size) == size,
+      "LengthBucketSampler cannot change the dataset size, since every "
+      "sample needs a known length (have ",
+      size,
+      " lengths, requested size ",
+      new_size.value_or(size),
+      ")");
+  order_.resize(size);
+  if (shuffle_) {
+    // Use the torch RNG (as RandomSampler does) so runs are reproducible
+    // under torch::manual_seed.
+    auto perm = torch::randperm(size, torch::kInt64);
+    const auto* perm_data = perm.data<int64_t>();
+    std::copy(perm_data, perm_data + size, order_.begin());
+  } else {
+    std::iota(order_.begin(), order_.end(), 0);
+  }
+  // Sort each bucket of consecutive (shuffled) indices by length,
+  // longest first, so batches come out ready for pack_padded_sequence.
+  // stable_sort keeps equal lengths in shuffled order.
+  for (size_t begin = 0; begin < size; begin += bucket_size_) {
+    const auto end = std::min(begin + bucket_size_, size);
+    std::stable_sort(
+        order_.begin() + begin,
+        order_.begin() + end,
+        [this](size_t a, size_t b) { return lengths_[a] > lengths_[b]; });
+  }
+  index_ = 0;
+}
+
+optional<std::vector<size_t>> LengthBucketSampler::next(size_t batch_size) {
+  AT_ASSERT(index_ <= order_.size());
+  const size_t remaining = order_.size() - index_;
+  if (remaining == 0) {
+    return nullopt;
+  }
+  std::vector<size_t> index_batch(
+      order_.begin() + index_,
+      order_.begin() + index_ + std::min(batch_size, remaining));
+  index_ += index_batch.size();
+  return index_batch;
+}
+
+void LengthBucketSampler::save(serialize::OutputArchive& archive) const {
+  archive.write(
+      "index",
+      torch::tensor(static_cast<int64_t>(index_), torch::kInt64),
+      /*is_buffer=*/true);
+  std::vector<int64_t> order(order_.begin(), order_.end());
+  archive.write(
+      "order",
+      torch::tensor(order, torch::kInt64),
+      /*is_buffer=*/true);
+}
+
+void LengthBucketSampler::load(serialize::InputArchive& archive) {
+  auto tensor = torch::empty(1, torch::kInt64);
+  archive.read(
+      "index",
+      tensor,
+      /*is_buffer=*/true);
+  index_ = tensor.item<int64_t>();
+  auto order = torch::empty(static_cast<int64_t>(lengths_.size()), torch::kInt64);
+  archive.read(
+      "order",
+      order,
+      /*is_buffer=*/true);
+  const auto* order_data = order.data<int64_t>();
+  order_.assign(order_data, order_data + order.numel());
+}
+
+size_t LengthBucketSampler::index() const noexcept {
+  return index_;
+}
+
+} // namespace samplers
+} // namespace data
+} // namespace torch
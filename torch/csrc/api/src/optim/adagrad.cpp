@@ -23,6 +23,30 @@ void Adagrad::step() {
       continue;
     }
 
+    if (p.grad().is_sparse()) {
+      AT_CHECK(
+          options.weight_decay_ == 0,
+          "weight_decay option is not compatible with sparse gradients");
+      buffer_at(step_buffers, i) += 1.0;
+      const auto clr = options.learning_rate_ /
+          (1.0 + (buffer_at(step_buffers, i) - 1.0) * options.lr_decay_);
+      // The fused step groups duplicate indices itself, so the gradient does
+      // not need to be coalesced first.
+      auto grad = p.grad();
+      AT_CHECK(
+          grad.sparse_dim() == 1 && p.dim() == 2,
+          "sparse gradients are only supported for 2-d parameters");
+      NoGradGuard guard;
+      torch::sparse_adagrad_step_(
+          p,
+          buffer_at(sum_buffers, i),
+          grad._indices().reshape({-1}),
+          grad._values(),
+          clr,
+          1e-10);
+      continue;
+    }
+
     if (options.weight_decay_ > 0) {
       p.grad() = p.grad() + options.weight_decay_ * p;
     }
@@ -30,6 +30,29 @@ void OutputArchive::write(
   module_->register_module(key, nested_archive.module_);
 }
 
+namespace {
+void snapshot_module_tensors(jit::script::Module& module) {
+  NoGradGuard no_grad;
+  for (auto slot : module.get_parameters()) {
+    slot.setValue(slot.value().toTensor().detach().clone());
+  }
+  for (auto slot : module.get_attributes()) {
+    auto value = slot.value();
+    if (value.isTensor()) {
+      slot.setValue(value.toTensor().detach().clone());
+    }
+  }
+  for (const auto& submodule : module.get_modules()) {
+    snapshot_module_tensors(*submodule);
+  }
+}
+} // namespace
+
+void OutputArchive::snapshot_tensors() {
+  AT_ASSERT(module_ != nullptr);
+  snapshot_module_tensors(*module_);
+}
+
 void OutputArchive::save_to(const std::string& filename) {
   AT_ASSERT(module_ != nullptr);
   jit::ExportModule(*module_, filename);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <torch/csrc/autograd/saved_variable.h>
+
+#include <ATen/ATen.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace torch {
+namespace autograd {
+namespace detail {
+
+// Encoders for Function::cse_fingerprint; see Note [Backward CSE] in
+// engine.cpp. Each overload appends an exact encoding of one piece of
+// saved state to the word sequence. The engine compares full sequences
+// for equality -- nothing here is a hash -- so a collision can never
+// produce a wrong gradient, only the per-type member order needs to be
+// fixed, which the generated overrides guarantee.
+
+inline void cse_append(std::vector<uint64_t>& words, const SavedVariable& v) {
+  const auto stamp = v.stamp();
+  words.push_back(reinterpret_cast<uint64_t>(stamp.first));
+  words.push_back(stamp.second);
+}
+
+inline void cse_append(
+    std::vector<uint64_t>& words,
+    const std::vector<SavedVariable>& vs) {
+  words.push_back(vs.size());
+  for (const auto& v : vs) {
+    cse_append(words, v);
+  }
+}
+
+inline void cse_append(std::vector<uint64_t>& words, int64_t v) {
+  words.push_back(static_cast<uint64_t>(v));
+}
+
+inline void cse_append(std::vector<uint64_t>& words, bool v) {
+  words.push_back(v ? 1 : 0);
+}
+
+inline void cse_append(std::vector<uint64_t>& words, double v) {
+  uint64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  words.push_back(bits);
+}
+
+inline void cse_append(
+    std::vector<uint64_t>& words,
+    const std::vector<int64_t>& v) {
+  words.push_back(v.size());
+  for (const auto e : v) {
+    words.push_back(static_cast<uint64_t>(e));
+  }
+}
+
+inline void cse_append(std::vector<uint64_t>& words, const at::Scalar& v) {
+  if (v.isFloatingPoint()) {
+    words.push_back(1);
+    cse_append(words, v.toDouble());
+  } else {
+    words.push_back(0);
+    words.push_back(static_cast<uint64_t>(v.toLong()));
+  }
+}
+
+inline void cse_append(std::vector<uint64_t>& words, at::ScalarType v) {
+  words.push_back(static_cast<uint64_t>(v));
+}
+
+} // namespace detail
+} // namespace autograd
+} // namespace torch
@@ -11,10 +11,13 @@
 #include <ATen/ExpandUtils.h>
 #include <ATen/Parallel.h>
 #include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
+#include <c10/util/numa.h>
 
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -80,11 +83,24 @@ struct CompareFunctionTaskTime {
 };
 
 struct ReadyQueue {
-  std::priority_queue<FunctionTask, std::vector<FunctionTask>, CompareFunctionTaskTime> heap;
+  using Heap =
+      std::priority_queue<FunctionTask, std::vector<FunctionTask>, CompareFunctionTaskTime>;
+  // Tasks pushed by threads other than the owning worker; guarded by mutex.
+  Heap heap;
+  // Tasks pushed by the owning worker for itself. Most pushes in a backward
+  // pass come from the worker that will also pop them (successors of the
+  // function it just ran), so they bypass the mutex and condition variable
+  // entirely and only the owner ever touches this heap.
+  Heap local_heap;
+  // Number of items in `heap`; lets pop() skip taking the mutex when no
+  // cross-thread work has arrived.
+  std::atomic<size_t> shared_size{0};
   std::condition_variable not_empty;
   std::mutex mutex;
 
-  void push(FunctionTask item);
+  // owner_thread must only be set to true when called from the worker thread
+  // that pops from this queue.
+  void push(FunctionTask item, bool owner_thread = false);
   FunctionTask pop();
 };
 
@@ -164,6 +180,46 @@ struct GraphTask {
   std::unordered_map<Function*, ExecInfo> exec_info;
   std::vector<Variable> captured_vars;
 
+  // Note [Backward CSE]
+  // ~~~~~~~~~~~~~~~~~~~
+  // Sibling backward nodes frequently compute identical expressions: the
+  // same broadcast mask expanded in every layer produces one structurally
+  // identical node per layer, and each recomputes the same reduction of
+  // the same gradient. When TORCH_AUTOGRAD_CSE=1, call_function memoizes
+  // node outputs for the duration of one backward execution, keyed on the
+  // node's dynamic type, an exact word encoding of its saved state
+  // (Function::cse_fingerprint -- tensors enter as identity + version, so
+  // any in-place change between saves changes the key), the identity and
+  // version of every incoming gradient, and the metadata of the receiving
+  // edges. Keys compare by full equality, never by hash alone, so a
+  // collision cannot fabricate a gradient; a duplicate node is simply
+  // served the cached outputs instead of re-running apply(). Nodes with
+  // hooks, nodes that cannot encode their state, and executions that
+  // build a higher-order graph (create_graph) bypass the cache -- in the
+  // last case outputs must stay connected to their own node's recorded
+  // graph. The cache pins its tensors until the GraphTask dies, trading
+  // memory for the skipped recomputation.
+  struct CseKey {
+    const std::type_info* type;
+    std::vector<uint64_t> words;
+
+    bool operator==(const CseKey& other) const {
+      return *type == *other.type && words == other.words;
+    }
+  };
+  struct CseKeyHash {
+    size_t operator()(const CseKey& key) const {
+      size_t seed = key.type->hash_code();
+      for (const auto word : key.words) {
+        seed ^= std::hash<uint64_t>()(word) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+      }
+      return seed;
+    }
+  };
+  std::mutex cse_mutex;
+  std::unordered_map<CseKey, variable_list, CseKeyHash> cse_cache;
+
   void init_to_execute(Function& graph_root, const edge_list& outputs);
 
   // The value of worker_device in the thread that created this task.
@@ -182,20 +238,47 @@ struct GraphTask {
     , owner(NO_DEVICE) {}
 };
 
-auto ReadyQueue::push(FunctionTask item) -> void {
+auto ReadyQueue::push(FunctionTask item, bool owner_thread) -> void {
+  if (owner_thread) {
+    // The owner is by definition not blocked in pop(), so no lock and no
+    // notification are needed; it will see this task on its next pop().
+    ++item.base->outstanding_tasks;
+    local_heap.push(std::move(item));
+    return;
+  }
   {
     std::lock_guard<std::mutex> lock(mutex);
     ++item.base->outstanding_tasks;
     heap.push(std::move(item));
+    shared_size.store(heap.size(), std::memory_order_release);
   }
   not_empty.notify_one();
 }
 
 auto ReadyQueue::pop() -> FunctionTask {
+  // Only ever called by the owning worker thread.
+  if (!local_heap.empty()) {
+    // Merge any cross-thread arrivals so priority ordering is preserved
+    // across both heaps, then serve from the local heap without blocking.
+    if (shared_size.load(std::memory_order_acquire) > 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      while (!heap.empty()) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        local_heap.push(std::move(const_cast<FunctionTask&>(heap.top())));
+        heap.pop();
+      }
+      shared_size.store(0, std::memory_order_relaxed);
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    auto task = std::move(const_cast<FunctionTask&>(local_heap.top()));
+    local_heap.pop();
+    return task;
+  }
   std::unique_lock<std::mutex> lock(mutex);
   not_empty.wait(lock, [this]{ return !heap.empty(); });
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
   auto task = std::move(const_cast<FunctionTask&>(heap.top())); heap.pop();
+  shared_size.store(heap.size(), std::memory_order_relaxed);
   return task;
 }
 
@@ -204,8 +287,95 @@ Engine::Engine() = default;
 // This Engine's ReadyQueues and their corresponding threads are leaked here
 Engine::~Engine() = default;
 
+// Note [NUMA-aware engine threads]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// On multi-socket machines the scheduler is free to migrate the engine
+// workers between sockets, and the CPU worker in particular drags the
+// cache lines of every gradient buffer it accumulates across the
+// interconnect each time it moves. Under the Numa placement policy
+// (opt-in via set_engine_thread_placement or
+// PYTORCH_AUTOGRAD_NUMA_BIND=1) every worker binds to one NUMA node as
+// it starts: the CPU worker to the node of the thread that first
+// invoked the engine - under first-touch allocation that is where the
+// parameters and their gradient buffers live - and each device worker
+// to its device index modulo the node count, which matches the
+// interleaved GPU-to-socket wiring of common multi-GPU boards.
+// Deployments whose topology differs can pin individual workers with
+// set_engine_thread_numa_node. Binding is to a node, not a core, so a
+// worker still floats across that node's cores; on single-node
+// machines, or when libnuma support is compiled out or disabled, all
+// of this is a no-op.
+namespace {
+
+struct ThreadPlacement {
+  std::mutex mutex;
+  c10::optional<EngineThreadPlacement> policy;
+  std::unordered_map<int, int> node_overrides; // device -> NUMA node
+  // Node of the thread that triggered start_threads; the CPU worker's
+  // target under the Numa policy.
+  int creator_node = -1;
+};
+
+ThreadPlacement& thread_placement() {
+  static ThreadPlacement placement;
+  return placement;
+}
+
+EngineThreadPlacement default_thread_placement() {
+  static const EngineThreadPlacement policy = []() {
+    const char* env = std::getenv("PYTORCH_AUTOGRAD_NUMA_BIND");
+    return (env != nullptr && env[0] == '1') ? EngineThreadPlacement::Numa
+                                             : EngineThreadPlacement::None;
+  }();
+  return policy;
+}
+
+// See Note [NUMA-aware engine threads]. `device` is -1 for the CPU
+// worker, matching thread_init.
+void bind_worker_to_numa_node(int device) {
+  auto& placement = thread_placement();
+  int node = -1;
+  {
+    std::lock_guard<std::mutex> lock(placement.mutex);
+    auto it = placement.node_overrides.find(device);
+    if (it != placement.node_overrides.end()) {
+      node = it->second;
+    } else {
+      const auto policy = placement.policy ? *placement.policy
+                                           : default_thread_placement();
+      if (policy != EngineThreadPlacement::Numa || !c10::IsNUMAEnabled()) {
+        return;
+      }
+      const int num_nodes = c10::GetNumNUMANodes();
+      if (num_nodes <= 1) {
+        return;
+      }
+      node = device == -1 ? placement.creator_node : device % num_nodes;
+    }
+  }
+  if (node >= 0) {
+    c10::NUMABind(node);
+  }
+}
+
+} // namespace
+
+void set_engine_thread_placement(EngineThreadPlacement policy) {
+  auto& placement = thread_placement();
+  std::lock_guard<std::mutex> lock(placement.mutex);
+  placement.policy = policy;
+}
+
+void set_engine_thread_numa_node(int device, int numa_node_id) {
+  auto& placement = thread_placement();
+  std::lock_guard<std::mutex> lock(placement.mutex);
+  placement.node_overrides[device] = numa_node_id;
+}
+
 auto Engine::thread_init(int device) -> void {
   at::init_num_threads();
+  // See Note [NUMA-aware engine threads]
+  bind_worker_to_numa_node(device);
   // Note [Allocating GPUs to autograd threads]
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
   // What's our strategy here?  Originally, the autograd engine was written
@@ -320,6 +490,15 @@ auto Engine::thread_on_exception(FunctionTask& task, std::exception& e) -> void
   }
 }
 
+// See Note [Backward CSE]
+static bool backward_cse_enabled() {
+  static const bool enabled = []() {
+    const char* env = getenv("TORCH_AUTOGRAD_CSE");
+    return env != nullptr && env[0] == '1';
+  }();
+  return enabled;
+}
+
 static variable_list call_pre_hooks(Function& fn, variable_list inputs) {
   for (const auto& hook : fn.pre_hooks()) {
     inputs = (*hook)(inputs);
@@ -401,6 +580,52 @@ static variable_list call_function(FunctionTask& task) {
   const auto has_post_hooks = !fn.post_hooks().empty();
   variable_list outputs;
 
+  // See Note [Backward CSE]
+  c10::optional<GraphTask::CseKey> cse_key;
+  if (backward_cse_enabled() && !task.base->grad_mode && !has_post_hooks &&
+      fn.pre_hooks().empty()) {
+    std::vector<uint64_t> words;
+    if (fn.cse_fingerprint(words)) {
+      for (const auto& edge : fn.next_edges()) {
+        if (!edge.is_valid()) {
+          words.push_back(0);
+          continue;
+        }
+        // The receiving edge's metadata participates in validate_outputs
+        // (broadcast gradients are reduced to its shape), so it is part
+        // of what the cached outputs were shaped against.
+        const auto& metadata = edge.function->input_metadata(edge.input_nr);
+        words.push_back(1);
+        words.push_back(reinterpret_cast<uint64_t>(&metadata.type()));
+        const auto device = metadata.device();
+        words.push_back(
+            (static_cast<uint64_t>(device.type()) << 8) |
+            static_cast<uint8_t>(device.index()));
+        words.push_back(metadata.shape().size());
+        for (const auto dim : metadata.shape()) {
+          words.push_back(static_cast<uint64_t>(dim));
+        }
+      }
+      for (const auto& var : inputs) {
+        if (var.defined()) {
+          words.push_back(reinterpret_cast<uint64_t>(var.unsafeGetTensorImpl()));
+          words.push_back(var.current_version());
+        } else {
+          words.push_back(0);
+          words.push_back(0);
+        }
+      }
+      cse_key = GraphTask::CseKey{&typeid(fn), std::move(words)};
+      std::lock_guard<std::mutex> lock(task.base->cse_mutex);
+      auto it = task.base->cse_cache.find(*cse_key);
+      if (it != task.base->cse_cache.end()) {
+        // Cached outputs were validated when they were produced.
+        checkpoint_valid = prev_checkpoint_valid_state;
+        return it->second;
+      }
+    }
+  }
+
   if(has_post_hooks){
     // In functions/accumulate_grad.cpp, there is some logic to check the conditions under which
     // the incoming gradient can be stolen directly (which elides a deep copy) instead of cloned.
@@ -427,6 +652,11 @@ static variable_list call_function(FunctionTask& task) {
   });
   checkpoint_valid = prev_checkpoint_valid_state;
 
+  if (cse_key) {
+    std::lock_guard<std::mutex> lock(task.base->cse_mutex);
+    task.base->cse_cache.emplace(std::move(*cse_key), outputs);
+  }
+
   if(has_post_hooks){
     // NOLINTNEXTLINE(bugprone-use-after-move)
     return call_post_hooks(fn, std::move(outputs), inputs);
@@ -505,7 +735,9 @@ auto Engine::evaluate_function(FunctionTask& task) -> void {
       input_buffer.add(next.input_nr, std::move(output));
       if (is_ready) {
         auto& queue = ready_queue(input_buffer.device());
-        queue.push(FunctionTask(task.base, next.function, std::move(input_buffer)));
+        queue.push(
+            FunctionTask(task.base, next.function, std::move(input_buffer)),
+            is_current_worker_queue(queue));
       } else {
         not_ready.emplace(next.function.get(), std::move(input_buffer));
       }
@@ -515,7 +747,9 @@ auto Engine::evaluate_function(FunctionTask& task) -> void {
       input_buffer.add(next.input_nr, std::move(output));
       if (is_ready) {
         auto& queue = ready_queue(input_buffer.device());
-        queue.push(FunctionTask(task.base, next.function, std::move(input_buffer)));
+        queue.push(
+            FunctionTask(task.base, next.function, std::move(input_buffer)),
+            is_current_worker_queue(queue));
         not_ready.erase(not_ready_it);
       }
     }
@@ -609,6 +843,11 @@ auto Engine::execute(const edge_list& roots,
     throw std::runtime_error("could not compute gradients for some functions");
   }
 
+  // This backward pass consumed (and, without keep_graph, freed) the
+  // current generation of nodes; seal the active slab so the next forward
+  // allocates into a fresh one. See Note [Generation-tagged node slabs].
+  Function::start_new_generation();
+
   // Unlocking is necessary, because the callback can register
   // more callbacks (or they can be registered from other threads
   // while it's waiting.
@@ -669,7 +908,22 @@ auto Engine::ready_queue_by_index(int device_index) -> ReadyQueue& {
   return *ready_queues.at(device_index + 1);
 }
 
+// True if `queue` is the one the calling worker thread pops from, in which
+// case pushes may take the lock-free owner fast path in ReadyQueue::push.
+auto Engine::is_current_worker_queue(ReadyQueue& queue) -> bool {
+  return worker_device != NO_DEVICE &&
+      &queue == ready_queues[worker_device + 1].get();
+}
+
 auto Engine::start_threads() -> void {
+  {
+    // See Note [NUMA-aware engine threads]: the thread that triggers
+    // engine start is the one that built the model, so under first-touch
+    // allocation its node is where the gradient buffers will live.
+    auto& placement = thread_placement();
+    std::lock_guard<std::mutex> lock(placement.mutex);
+    placement.creator_node = c10::GetCurrentNUMANode();
+  }
   // See Note [Allocating GPUs to autograd threads]
   c10::DeviceIndex num_devices = 0;
   for (const auto& impl_atomic : c10::impl::device_guard_impl_registry) {
@@ -56,6 +56,7 @@ protected:
   void evaluate_function(FunctionTask& task);
   ReadyQueue& ready_queue(at::Device device);
   ReadyQueue& ready_queue_by_index(int device_index);
+  bool is_current_worker_queue(ReadyQueue& queue);
   void start_threads();
   virtual void thread_init(int device);
   virtual void thread_main(GraphTask *graph_task);
@@ -71,4 +72,19 @@ protected:
 using EngineStub = Engine& (*)();
 TORCH_API void set_default_engine_stub(EngineStub stub);
 
+// See Note [NUMA-aware engine threads] in engine.cpp.
+enum class EngineThreadPlacement {
+  None, // leave workers unbound (historical behavior)
+  Numa, // bind each worker to a NUMA node on multi-node machines
+};
+// Selects the placement policy for engine worker threads. Workers bind
+// when they start, so this must be called before the first backward;
+// PYTORCH_AUTOGRAD_NUMA_BIND=1 selects Numa without a code change.
+TORCH_API void set_engine_thread_placement(EngineThreadPlacement policy);
+// Pins one worker (device index, or -1 for the CPU worker) to an
+// explicit NUMA node, overriding what the policy would pick, for
+// machines whose device-to-socket wiring the default heuristic gets
+// wrong. Also only effective before the first backward.
+TORCH_API void set_engine_thread_numa_node(int device, int numa_node_id);
+
 }} // namespace torch::autograd
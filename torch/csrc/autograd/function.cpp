@@ -7,8 +7,12 @@
 #include <ATen/ATen.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -29,6 +33,168 @@ uint64_t& Function::get_next_sequence_nr() {
   return Function_next_sequence_nr_;
 }
 
+// Note [Generation-tagged node slabs]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Every differentiable op allocates a Function node on the forward hot
+// path, and backward() tears the whole graph down again node by node.
+// Doing both through malloc/free costs more than the math for small-tensor
+// training, and the teardown shows up as a pause after backward() on big
+// models. Node storage therefore comes from 64 KiB slabs owned by the
+// allocating thread: allocation bumps the active slab's offset, and every
+// block carries a back-pointer to its slab. Ownership of the nodes
+// themselves is untouched -- they are still held by shared_ptrs and their
+// destructors still run one by one (iteratively; see deleteFunction
+// below) -- but the underlying memory is only returned once a slab's
+// outstanding-block count drops to zero, so an entire generation of nodes
+// is released in one step instead of a million frees.
+//
+// The engine seals the calling thread's active slab when a backward pass
+// completes (start_new_generation), so consecutive iterations do not share
+// slabs and the common case -- graph built in forward, dropped right after
+// backward -- frees exactly that generation's slabs. A graph retained with
+// keep_graph simply keeps its slabs' counts positive across the seal;
+// nothing requires the absence of cross-generation references. Nodes are
+// freed on engine worker threads while the user thread allocates, which is
+// fine: the bump offset is touched only by the owning thread and the
+// outstanding count is atomic. Drained slabs are recycled through a small
+// global cache.
+namespace {
+
+constexpr size_t kSlabDataBytes = 1 << 16;
+// Slab* back-pointer in front of each block, padded to keep blocks
+// 16-byte aligned.
+constexpr size_t kNodeHeaderBytes = 16;
+// Nodes too big to amortize a slab fall through to plain malloc.
+constexpr size_t kNodeMaxSlabBytes = 1024;
+constexpr size_t kMaxCachedSlabs = 16;
+
+struct Slab {
+  // Blocks handed out and not yet deleted, plus one reference held by the
+  // owning thread while this is its active allocation target.
+  std::atomic<size_t> outstanding;
+  // Offset of the next block; touched only by the owning thread.
+  size_t bump;
+
+  Slab() : outstanding(1), bump(0) {}
+
+  char* data() {
+    return reinterpret_cast<char*>(this) + sizeof(Slab);
+  }
+};
+
+std::mutex& slab_cache_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Heap-allocated so blocks freed during static destruction (e.g. by a
+// global's destructor) never race slab teardown; bounded to
+// kMaxCachedSlabs, so the leak on exit is at most ~1 MiB.
+std::vector<Slab*>& slab_cache() {
+  static std::vector<Slab*>* cache = new std::vector<Slab*>();
+  return *cache;
+}
+
+Slab* acquire_slab() {
+  {
+    std::lock_guard<std::mutex> lock(slab_cache_mutex());
+    auto& cache = slab_cache();
+    if (!cache.empty()) {
+      Slab* slab = cache.back();
+      cache.pop_back();
+      slab->outstanding.store(1, std::memory_order_relaxed);
+      slab->bump = 0;
+      return slab;
+    }
+  }
+  void* memory = std::malloc(sizeof(Slab) + kSlabDataBytes);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return new (memory) Slab();
+}
+
+void release_slab_ref(Slab* slab) {
+  if (slab->outstanding.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  // Last block of the generation is gone and the slab is retired; the
+  // whole slab goes back in one step.
+  {
+    std::lock_guard<std::mutex> lock(slab_cache_mutex());
+    auto& cache = slab_cache();
+    if (cache.size() < kMaxCachedSlabs) {
+      cache.push_back(slab);
+      return;
+    }
+  }
+  std::free(slab);
+}
+
+struct ActiveSlab {
+  Slab* slab = nullptr;
+
+  ~ActiveSlab() {
+    if (slab != nullptr) {
+      release_slab_ref(slab);
+    }
+  }
+};
+
+ActiveSlab& active_slab() {
+  static thread_local ActiveSlab active;
+  return active;
+}
+
+} // namespace
+
+void* Function::operator new(size_t size) {
+  const size_t rounded = (size + kNodeHeaderBytes + 15) / 16 * 16;
+  if (rounded > kNodeMaxSlabBytes) {
+    void* block = std::malloc(rounded);
+    if (block == nullptr) {
+      throw std::bad_alloc();
+    }
+    *reinterpret_cast<Slab**>(block) = nullptr;
+    return static_cast<char*>(block) + kNodeHeaderBytes;
+  }
+  auto& active = active_slab();
+  if (active.slab == nullptr ||
+      active.slab->bump + rounded > kSlabDataBytes) {
+    if (active.slab != nullptr) {
+      // Retire the full slab; it dies when its last node does.
+      release_slab_ref(active.slab);
+      active.slab = nullptr;
+    }
+    active.slab = acquire_slab();
+  }
+  Slab* slab = active.slab;
+  char* block = slab->data() + slab->bump;
+  slab->bump += rounded;
+  slab->outstanding.fetch_add(1, std::memory_order_relaxed);
+  *reinterpret_cast<Slab**>(block) = slab;
+  return block + kNodeHeaderBytes;
+}
+
+void Function::operator delete(void* ptr, size_t size) {
+  (void)size;
+  char* block = static_cast<char*>(ptr) - kNodeHeaderBytes;
+  Slab* slab = *reinterpret_cast<Slab**>(block);
+  if (slab == nullptr) {
+    std::free(block);
+    return;
+  }
+  release_slab_ref(slab);
+}
+
+void Function::start_new_generation() {
+  auto& active = active_slab();
+  if (active.slab != nullptr) {
+    release_slab_ref(active.slab);
+    active.slab = nullptr;
+  }
+}
+
 auto Function::name() const -> std::string {
   return c10::demangle(typeid(*this).name());
 }
@@ -12,6 +12,7 @@
 
 #include <ATen/ATen.h>
 #include <c10/util/Exception.h>
+#include <c10/util/SmallVector.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -29,7 +30,9 @@ struct FunctionPreHook;
 
 using tensor_list = std::vector<at::Tensor>;
 using variable_list = std::vector<Variable>;
-using edge_list = std::vector<Edge>;
+// Almost every node has one or two next edges, so keeping them inline saves
+// a heap allocation per differentiable op on the forward hot path.
+using edge_list = c10::SmallVector<Edge, 2>;
 using saved_variable_list = std::vector<SavedVariable>;
 using IndexRange = std::pair<size_t, size_t>;
 
@@ -109,6 +112,19 @@ struct TORCH_API Function : std::enable_shared_from_this<Function> {
   Function& operator=(Function&& other) = delete;
   virtual ~Function() = default;
 
+  /// Nodes are allocated when a differentiable op runs and freed when the
+  /// graph dies, so their storage comes from generation-tagged slabs that
+  /// are returned wholesale once every node in them is gone; see
+  /// Note [Generation-tagged node slabs] in function.cpp.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
+  /// Seals the calling thread's active allocation slab, so that nodes
+  /// created afterwards belong to a new generation. The engine calls this
+  /// when a backward pass completes; see
+  /// Note [Generation-tagged node slabs].
+  static void start_new_generation();
+
   /// Evaluates the function on the given inputs and returns the result of the
   /// function call.
   variable_list operator()(variable_list&& inputs) {
@@ -304,6 +320,18 @@ struct TORCH_API Function : std::enable_shared_from_this<Function> {
     return false;
   }
 
+  /// Appends an exact encoding of this node's type-specific saved state
+  /// to `words` and returns true, or returns false when the node cannot
+  /// describe itself structurally (which excludes it from backward CSE).
+  /// Two nodes of the same dynamic type whose encodings are equal must
+  /// compute identical outputs from identical input gradients. The
+  /// generated functions override this where all their saved members are
+  /// encodable; see Note [Backward CSE] in engine.cpp.
+  virtual bool cse_fingerprint(std::vector<uint64_t>& words) const {
+    (void)words;
+    return false;
+  }
+
   static uint64_t peek_at_next_sequence_nr();
 
  protected:
@@ -62,7 +62,10 @@ auto AccumulateGrad::apply(variable_list&& grads) -> variable_list {
     // slightly more efficient and, what's more important, more predictable for
     // the users. Thanks to this case we can avoid changing the grad tensor,
     // a thing never promised and documented, but used in some hacks seen
-    // on the internet.
+    // on the internet. It is also what keeps .grad allocations stable across
+    // iterations: zero_grad() zeroes the same storage in place and this branch
+    // accumulates into it, so steady-state training allocates no new grad
+    // storage per step.
     if (grad_variable.is_sparse() && !new_grad.is_sparse()) {
       grad_variable.set_data(new_grad.data() + grad_variable.data());
     } else {
@@ -0,0 +1,126 @@
+#include <torch/csrc/autograd/functions/checkpoint.h>
+
+#include <torch/csrc/autograd/edge.h>
+#include <torch/csrc/autograd/engine.h>
+#include <torch/csrc/autograd/functions/utils.h>
+#include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/autograd/variable.h>
+
+#include <ATen/ATen.h>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+auto CheckpointBackward::apply(variable_list&& grads) -> variable_list {
+  AT_CHECK(
+      fn_,
+      "CheckpointBackward can only be applied once "
+      "(its segment was already released)");
+  // Whether the surrounding backward was started with create_graph; the
+  // engine runs us under the GraphTask's grad mode. Capture it before the
+  // recompute overrides the mode.
+  const bool create_graph = GradMode::is_enabled();
+
+  // Rebuild the segment inputs as leaves of a fresh local graph.
+  variable_list inputs;
+  inputs.reserve(saved_inputs_.size());
+  for (const auto& saved : saved_inputs_) {
+    auto var = saved.unpack(shared_from_this());
+    if (!var.defined()) {
+      inputs.emplace_back();
+      continue;
+    }
+    auto detached = var.detach();
+    if (var.requires_grad()) {
+      detached.set_requires_grad(true);
+    }
+    inputs.push_back(std::move(detached));
+  }
+
+  variable_list outputs;
+  {
+    AutoGradMode grad_mode(true);
+    outputs = fn_(inputs);
+  }
+  AT_CHECK(
+      outputs.size() == grads.size(),
+      "checkpointed segment produced ",
+      outputs.size(),
+      " outputs when recomputed, but ",
+      grads.size(),
+      " gradients flowed in");
+
+  // Roots of the local backward: recomputed outputs that require grad and
+  // actually received a gradient.
+  edge_list roots;
+  variable_list root_grads;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    const auto& output = outputs[i];
+    if (!output.defined() || !output.requires_grad() || !grads[i].defined()) {
+      continue;
+    }
+    roots.push_back(output.gradient_edge());
+    root_grads.push_back(grads[i]);
+  }
+
+  variable_list result(saved_inputs_.size());
+  if (roots.empty()) {
+    return result;
+  }
+
+  // Capture gradients at the detached input leaves.
+  edge_list input_edges;
+  std::vector<size_t> input_order;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i].defined() && inputs[i].requires_grad()) {
+      input_edges.push_back(inputs[i].gradient_edge());
+      input_order.push_back(i);
+    }
+  }
+
+  // This runs right here, on the engine's worker thread: the reentrant call
+  // pushes the local graph onto the current thread's queue and drains it
+  // before returning (see Note [Reentrant backwards] in engine.cpp).
+  auto partials = Engine::get_default_engine().execute(
+      roots,
+      root_grads,
+      /*keep_graph=*/create_graph,
+      /*create_graph=*/create_graph,
+      input_edges);
+  for (size_t i = 0; i < input_order.size(); ++i) {
+    result[input_order[i]] = partials[i];
+  }
+  return result;
+}
+
+void CheckpointBackward::release_variables() {
+  saved_inputs_.clear();
+  fn_ = nullptr;
+}
+
+variable_list checkpoint(const checkpoint_fn& fn, const variable_list& inputs) {
+  AT_CHECK(fn, "checkpoint() requires a callable segment");
+  variable_list outputs;
+  {
+    // Run the segment without recording: its intermediates are dropped here
+    // and rebuilt inside CheckpointBackward::apply.
+    AutoGradMode grad_mode(false);
+    outputs = fn(inputs);
+  }
+  tensor_list output_data;
+  output_data.reserve(outputs.size());
+  for (const auto& output : outputs) {
+    output_data.emplace_back(output.defined() ? output.data() : at::Tensor());
+  }
+  return wrap_outputs(
+      inputs, std::move(output_data), [&](edge_list&& next_edges) {
+        return std::make_shared<CheckpointBackward>(
+            fn, inputs, std::move(next_edges));
+      });
+}
+
+}} // namespace torch::autograd
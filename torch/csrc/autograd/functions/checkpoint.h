@@ -0,0 +1,61 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/saved_variable.h>
+#include <torch/csrc/autograd/variable.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+// A checkpointed segment: a callable that maps the segment's inputs to its
+// outputs and can be replayed during backward.
+using checkpoint_fn = std::function<variable_list(const variable_list&)>;
+
+// Note [Native segment checkpointing]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// checkpoint() runs `fn` under no-grad, so none of the segment's intermediate
+// activations are ever saved; only the segment inputs are retained (as
+// SavedVariables on the CheckpointBackward node that connects the segment's
+// outputs to its inputs). When the gradient for the segment arrives,
+// CheckpointBackward::apply re-runs `fn` with grad enabled to rebuild a fresh
+// local graph and immediately backwards through it with a reentrant
+// Engine::execute call (see Note [Reentrant backwards] in engine.cpp), so the
+// recomputation and the local backward run on the engine's own device
+// threads, interleaved with the rest of the backward pass. The local graph is
+// freed as it is consumed (keep_graph=false), so peak memory is one segment's
+// activations rather than the whole model's.
+struct TORCH_API CheckpointBackward : public Function {
+  CheckpointBackward(
+      checkpoint_fn fn,
+      const variable_list& inputs,
+      edge_list&& next_edges)
+      : Function(std::move(next_edges)), fn_(std::move(fn)) {
+    saved_inputs_.reserve(inputs.size());
+    for (const auto& input : inputs) {
+      saved_inputs_.emplace_back(input, /*is_output=*/false);
+    }
+  }
+
+  variable_list apply(variable_list&& grads) override;
+
+  void release_variables() override;
+
+ private:
+  checkpoint_fn fn_;
+  std::vector<SavedVariable> saved_inputs_;
+};
+
+// Runs `fn` on `inputs` without recording a graph and returns its outputs,
+// wired to `inputs` through a single CheckpointBackward node. The segment's
+// backward recomputes `fn` on demand; see Note [Native segment checkpointing].
+// `fn` must be safe to call a second time with equal inputs (no RNG or other
+// side effects that the replay would repeat differently).
+TORCH_API variable_list checkpoint(
+    const checkpoint_fn& fn,
+    const variable_list& inputs);
+
+}} // namespace torch::autograd
@@ -1,14 +1,4 @@
 #include <torch/csrc/autograd/grad_mode.h>
 
-namespace torch { namespace autograd {
-
-thread_local bool GradMode_enabled = true;
-
-bool GradMode::is_enabled() {
-  return GradMode_enabled;
-}
-
-void GradMode::set_enabled(bool enabled) {
-  GradMode_enabled = enabled;
-}
-}}
+// GradMode's state and accessors moved to ATen (ATen/core/grad_mode.cpp)
+// so native kernels and the autograd layer share one thread-local flag.
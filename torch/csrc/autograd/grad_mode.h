@@ -1,24 +1,13 @@
 #pragma once
 
-#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <ATen/core/grad_mode.h>
 
 namespace torch { namespace autograd {
 
-struct TORCH_API GradMode {
-  static bool is_enabled();
-  static void set_enabled(bool enabled);
-};
-
-// A RAII, thread local (!) guard that enables or disables grad mode upon
-// construction, and sets it back to the original value upon destruction.
-struct TORCH_API AutoGradMode {
-  AutoGradMode(bool enabled) : prev_mode(GradMode::is_enabled()) {
-    GradMode::set_enabled(enabled);
-  }
-  ~AutoGradMode() {
-    GradMode::set_enabled(prev_mode);
-  }
-  bool prev_mode;
-};
+// Grad mode state lives in ATen so that native kernels (which pick
+// inference-only fast paths when the tape is off) read the same flag the
+// variable dispatch layer writes.
+using GradMode = at::GradMode;
+using AutoGradMode = at::AutoGradMode;
 
 }}
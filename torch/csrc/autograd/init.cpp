@@ -50,6 +50,25 @@ PyObject * THPAutograd_initExtension(PyObject *_unused)
   });
   m.def("_pop_range", []() { torch::autograd::profiler::popRange(); });
 
+  py::class_<torch::autograd::profiler::RegionEvent>(m, "ProfilerRegionEvent")
+      .def(
+          "name",
+          [](const torch::autograd::profiler::RegionEvent& e) {
+            return std::string(e.name ? e.name : "");
+          })
+      .def_readonly(
+          "start_ns", &torch::autograd::profiler::RegionEvent::start_ns)
+      .def_readonly("end_ns", &torch::autograd::profiler::RegionEvent::end_ns)
+      .def_readonly(
+          "thread_id", &torch::autograd::profiler::RegionEvent::thread_id)
+      .def_readonly("depth", &torch::autograd::profiler::RegionEvent::depth);
+
+  m.def("_enable_region_ring", torch::autograd::profiler::enableRegionRing);
+  m.def("_disable_region_ring", torch::autograd::profiler::disableRegionRing);
+  m.def(
+      "_snapshot_region_ring",
+      torch::autograd::profiler::snapshotRegionRing);
+
   Py_RETURN_TRUE;
 }
 
@@ -34,6 +34,16 @@ void InputBuffer::add(size_t pos, Variable var) {
     } else {
       if (var.is_sparse() && !old_var.is_sparse() && old_var.is_contiguous() && old_var.storage().use_count() == 1) {
           buffer[pos] = old_var.add_(var);
+      } else if (!var.is_sparse() && !old_var.is_sparse() &&
+                 old_var.is_contiguous() && !old_var.requires_grad() &&
+                 old_var.use_count() == 1 && old_var.storage().use_count() == 1) {
+          // Dense fan-in in steady-state training: the buffer holds the only
+          // reference to old_var and its storage and no graph records it, so
+          // nothing can observe an in-place update. Accumulating into it
+          // instead of allocating `old_var + var` keeps use_count at 1, which
+          // also lets AccumulateGrad later steal this exact buffer into .grad
+          // instead of cloning.
+          buffer[pos] = old_var.add_(var);
       } else {
           buffer[pos] = old_var + var;
       }
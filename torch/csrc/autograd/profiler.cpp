@@ -1,9 +1,22 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/function.h>
 
+#include <c10/core/AllocationTracker.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
 #include <fstream>
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
 namespace torch { namespace autograd { namespace profiler {
 
 CUDAStubs default_stubs;
@@ -88,6 +101,405 @@ void popRange() {
   }
 }
 
+namespace {
+
+// See Note [Region scopes and the region ring] in profiler.h.
+struct RingSlot {
+  // Seqlock: odd while a writer is mid-update, bumped again when it is done.
+  std::atomic<uint32_t> seq{0};
+  RegionEvent ev;
+};
+
+struct RegionRing {
+  std::mutex config_mutex;
+  std::unique_ptr<RingSlot[]> slots;
+  size_t capacity = 0;
+  std::atomic<uint64_t> head{0}; // total regions ever recorded
+  std::atomic<bool> enabled{false};
+};
+
+RegionRing& regionRing() {
+  static RegionRing ring;
+  return ring;
+}
+
+thread_local uint16_t region_depth = 0;
+
+void recordRegion(
+    const char* name,
+    int64_t start_ns,
+    int64_t end_ns,
+    uint16_t depth) {
+  auto& ring = regionRing();
+  if (!ring.enabled.load(std::memory_order_acquire)) {
+    return;
+  }
+  // Writers claim distinct slots, so the only contention is with a snapshot
+  // (handled by the seqlock) or a writer that lapped the whole ring.
+  const size_t idx =
+      ring.head.fetch_add(1, std::memory_order_relaxed) % ring.capacity;
+  RingSlot& slot = ring.slots[idx];
+  slot.seq.fetch_add(1, std::memory_order_acq_rel);
+  slot.ev.name = name;
+  slot.ev.start_ns = start_ns;
+  slot.ev.end_ns = end_ns;
+  slot.ev.thread_id = thread_id;
+  slot.ev.depth = depth;
+  slot.seq.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace
+
+RecordRegion::RecordRegion(const char* name)
+    : name_(name), start_ns_(getTime()), depth_(region_depth++) {
+  // StringView over the caller's literal: no copy on entry.
+  pushRangeImpl(StringView(name));
+  if (regionRing().enabled.load(std::memory_order_acquire)) {
+    // Assigns this thread's id on its first region; the ring itself never
+    // allocates at record time.
+    getEventList();
+  }
+}
+
+RecordRegion::~RecordRegion() {
+  region_depth--;
+  popRange();
+  recordRegion(name_, start_ns_, getTime(), depth_);
+}
+
+void enableRegionRing(size_t capacity) {
+  AT_CHECK(capacity > 0, "region ring capacity must be positive");
+  auto& ring = regionRing();
+  std::lock_guard<std::mutex> guard(ring.config_mutex);
+  ring.slots.reset(new RingSlot[capacity]);
+  ring.capacity = capacity;
+  ring.head.store(0, std::memory_order_relaxed);
+  ring.enabled.store(true, std::memory_order_release);
+}
+
+void disableRegionRing() {
+  auto& ring = regionRing();
+  std::lock_guard<std::mutex> guard(ring.config_mutex);
+  // The slots are kept so snapshotRegionRing() can still drain them; a
+  // writer that already passed the enabled check finishes harmlessly.
+  ring.enabled.store(false, std::memory_order_release);
+}
+
+std::vector<RegionEvent> snapshotRegionRing() {
+  auto& ring = regionRing();
+  std::lock_guard<std::mutex> guard(ring.config_mutex);
+  std::vector<RegionEvent> result;
+  if (!ring.slots) {
+    return result;
+  }
+  const uint64_t head = ring.head.load(std::memory_order_acquire);
+  const uint64_t retained = std::min<uint64_t>(head, ring.capacity);
+  result.reserve(retained);
+  for (uint64_t i = head - retained; i < head; i++) {
+    RingSlot& slot = ring.slots[i % ring.capacity];
+    const uint32_t seq_before = slot.seq.load(std::memory_order_acquire);
+    RegionEvent ev = slot.ev;
+    const uint32_t seq_after = slot.seq.load(std::memory_order_acquire);
+    if ((seq_before & 1) || seq_before != seq_after || ev.name == nullptr) {
+      continue; // mid-update or never written; this is a sampling facility
+    }
+    result.push_back(ev);
+  }
+  return result;
+}
+
+#ifdef __linux__
+
+namespace {
+
+// See Note [Hardware counters at op boundaries] in profiler.h.
+
+// Running sums for one op name on one thread; sums follows the event
+// order produced by perfEventIds().
+struct PerfAccum {
+  uint64_t calls = 0;
+  std::vector<uint64_t> sums;
+};
+
+struct PerfThreadState {
+  std::vector<int> fds; // fds[0] leads the counter group
+  // Group snapshots taken by start callbacks of ops still on the stack.
+  std::vector<std::vector<uint64_t>> depth_stack;
+  std::unordered_map<std::string, PerfAccum> totals;
+  // Set after a failed open so we warn once, not once per op.
+  bool failed = false;
+};
+
+struct PerfCounters {
+  std::mutex mutex;
+  std::list<std::shared_ptr<PerfThreadState>> all_states;
+  PerfCounterConfig config;
+  std::atomic<bool> enabled{false};
+};
+
+PerfCounters& perfCounters() {
+  static PerfCounters counters;
+  return counters;
+}
+
+thread_local std::shared_ptr<PerfThreadState> perf_state;
+
+// (perf event type, event config) pairs in the order counters are read.
+std::vector<std::pair<uint32_t, uint64_t>> perfEventIds(
+    const PerfCounterConfig& config) {
+  std::vector<std::pair<uint32_t, uint64_t>> events;
+  if (config.cycles)
+    events.emplace_back(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  if (config.instructions)
+    events.emplace_back(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  if (config.cache_references)
+    events.emplace_back(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES);
+  if (config.cache_misses)
+    events.emplace_back(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  if (config.branch_instructions)
+    events.emplace_back(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+  if (config.branch_misses)
+    events.emplace_back(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  for (const auto raw : config.raw_events) {
+    events.emplace_back(PERF_TYPE_RAW, raw);
+  }
+  return events;
+}
+
+void closePerfGroup(PerfThreadState& state) {
+  for (const int fd : state.fds) {
+    close(fd);
+  }
+  state.fds.clear();
+}
+
+// Opens the calling thread's counter group. On failure everything opened
+// so far is closed and errno describes the first failure.
+bool openPerfGroup(PerfThreadState& state) {
+  const auto events = perfEventIds(perfCounters().config);
+  for (const auto& event : events) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.first;
+    attr.config = event.second;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = state.fds.empty();
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    const int group_fd = state.fds.empty() ? -1 : state.fds[0];
+    const long fd = syscall(
+        __NR_perf_event_open, &attr, 0 /* this thread */, -1, group_fd, 0);
+    if (fd < 0) {
+      const int err = errno;
+      closePerfGroup(state);
+      errno = err;
+      return false;
+    }
+    state.fds.push_back(static_cast<int>(fd));
+  }
+  ioctl(state.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(state.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return true;
+}
+
+// Group read layout with PERF_FORMAT_GROUP: u64 nr, then u64 values[nr]
+// in creation order.
+bool readPerfGroup(const PerfThreadState& state, std::vector<uint64_t>& out) {
+  const size_t nevents = state.fds.size();
+  std::vector<uint64_t> buffer(nevents + 1);
+  const ssize_t want =
+      static_cast<ssize_t>((nevents + 1) * sizeof(uint64_t));
+  if (read(state.fds[0], buffer.data(), want) != want ||
+      buffer[0] != nevents) {
+    return false;
+  }
+  out.assign(buffer.begin() + 1, buffer.end());
+  return true;
+}
+
+PerfThreadState& perfThreadState() {
+  if (!perf_state) {
+    auto& counters = perfCounters();
+    std::lock_guard<std::mutex> guard(counters.mutex);
+    perf_state = std::make_shared<PerfThreadState>();
+    counters.all_states.emplace_front(perf_state);
+  }
+  return *perf_state;
+}
+
+void perfOpStart() {
+  auto& counters = perfCounters();
+  if (!counters.enabled.load(std::memory_order_acquire)) {
+    return;
+  }
+  auto& state = perfThreadState();
+  if (state.fds.empty() && !state.failed) {
+    if (!openPerfGroup(state)) {
+      state.failed = true;
+      AT_WARN(
+          "could not open a perf counter group on this thread: ",
+          strerror(errno),
+          "; its ops will not be counted");
+    }
+  }
+  // Push even on failure so starts and ends stay paired.
+  std::vector<uint64_t> values;
+  if (!state.fds.empty()) {
+    readPerfGroup(state, values);
+  }
+  state.depth_stack.push_back(std::move(values));
+}
+
+void perfOpEnd(const RecordFunction& fn) {
+  auto& counters = perfCounters();
+  if (!counters.enabled.load(std::memory_order_acquire) || !perf_state) {
+    return;
+  }
+  auto& state = *perf_state;
+  if (state.depth_stack.empty()) {
+    // The op began before collection was enabled on this thread.
+    return;
+  }
+  std::vector<uint64_t> start_values = std::move(state.depth_stack.back());
+  state.depth_stack.pop_back();
+  if (state.fds.empty() || start_values.empty()) {
+    return;
+  }
+  std::vector<uint64_t> end_values;
+  if (!readPerfGroup(state, end_values) ||
+      end_values.size() != start_values.size()) {
+    return;
+  }
+  auto& accum = state.totals[fn.name().str()];
+  accum.calls++;
+  if (accum.sums.size() < end_values.size()) {
+    accum.sums.resize(end_values.size(), 0);
+  }
+  for (size_t i = 0; i < end_values.size(); i++) {
+    accum.sums[i] += end_values[i] - start_values[i];
+  }
+}
+
+// Scatters one thread's running sums back into the named fields, in the
+// same order perfEventIds() programmed them.
+void accumToStats(
+    const PerfCounterConfig& config,
+    const PerfAccum& accum,
+    PerfOpStats& stats) {
+  stats.calls += accum.calls;
+  size_t idx = 0;
+  auto take = [&]() -> uint64_t {
+    return idx < accum.sums.size() ? accum.sums[idx++] : 0;
+  };
+  if (config.cycles)
+    stats.cycles += take();
+  if (config.instructions)
+    stats.instructions += take();
+  if (config.cache_references)
+    stats.cache_references += take();
+  if (config.cache_misses)
+    stats.cache_misses += take();
+  if (config.branch_instructions)
+    stats.branch_instructions += take();
+  if (config.branch_misses)
+    stats.branch_misses += take();
+  stats.raw_events.resize(config.raw_events.size(), 0);
+  for (size_t i = 0; i < config.raw_events.size(); i++) {
+    stats.raw_events[i] += take();
+  }
+}
+
+} // namespace
+
+void enablePerfCounters(const PerfCounterConfig& config) {
+  auto& counters = perfCounters();
+  AT_CHECK(
+      !counters.enabled.load(std::memory_order_acquire),
+      "perf counters are already enabled");
+  AT_CHECK(
+      !perfEventIds(config).empty(),
+      "perf counter config selects no events");
+  {
+    std::lock_guard<std::mutex> guard(counters.mutex);
+    counters.config = config;
+  }
+  // Open the calling thread's group eagerly so configuration problems
+  // (unsupported events, perf_event_paranoid) surface here rather than
+  // as per-op warnings on worker threads.
+  auto& state = perfThreadState();
+  if (state.fds.empty() && !openPerfGroup(state)) {
+    AT_ERROR(
+        "could not open a perf counter group: ",
+        strerror(errno),
+        " (check /proc/sys/kernel/perf_event_paranoid and whether the "
+        "requested events exist on this machine)");
+  }
+  counters.enabled.store(true, std::memory_order_release);
+  pushCallback(
+      [](const RecordFunction& /* unused */) { perfOpStart(); },
+      [](const RecordFunction& fn) { perfOpEnd(fn); });
+}
+
+perf_op_stats disablePerfCounters() {
+  auto& counters = perfCounters();
+  AT_CHECK(
+      counters.enabled.load(std::memory_order_acquire),
+      "can't disable perf counters when they are not enabled");
+  popCallback();
+  counters.enabled.store(false, std::memory_order_release);
+
+  perf_op_stats result;
+  std::lock_guard<std::mutex> guard(counters.mutex);
+  for (auto it = counters.all_states.begin();
+       it != counters.all_states.end();) {
+    auto& state = *it;
+    for (const auto& kv : state->totals) {
+      accumToStats(counters.config, kv.second, result[kv.first]);
+    }
+    state->totals.clear();
+    state->depth_stack.clear();
+    state->failed = false;
+    closePerfGroup(*state);
+    // GC states whose threads have exited, as disableProfiler does for
+    // event lists; live threads reopen their group on the next enable.
+    if (state.use_count() == 1) {
+      it = counters.all_states.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return result;
+}
+
+#else // __linux__
+
+void enablePerfCounters(const PerfCounterConfig& /* unused */) {
+  AT_ERROR("perf counter collection requires Linux perf_event support");
+}
+
+perf_op_stats disablePerfCounters() {
+  AT_ERROR("perf counter collection requires Linux perf_event support");
+}
+
+#endif // __linux__
+
+void enableMemoryTracking() {
+  c10::allocation_tracker::enable();
+  pushCallback(
+      [](const RecordFunction& fn) {
+        c10::allocation_tracker::pushScope(fn.name().str());
+      },
+      [](const RecordFunction& /* unused */) {
+        c10::allocation_tracker::popScope();
+      });
+}
+
+void disableMemoryTracking() {
+  popCallback();
+  c10::allocation_tracker::disable();
+}
+
 void enableProfiler(ProfilerState new_state) {
   AT_ASSERT(new_state != ProfilerState::Disabled);
   if (new_state == ProfilerState::NVTX && !cuda_stubs->enabled())
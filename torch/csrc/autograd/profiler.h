@@ -11,6 +11,7 @@
 #include <sstream>
 #include <forward_list>
 #include <tuple>
+#include <unordered_map>
 #include <ATen/ATen.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #ifndef _WIN32
@@ -201,6 +202,132 @@ using thread_event_lists = std::vector<std::vector<Event>>;
 TORCH_API void enableProfiler(ProfilerState new_state);
 TORCH_API thread_event_lists disableProfiler();
 
+// Note [Region scopes and the region ring]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// RECORD_FUNCTION covers operators, but serving pipelines also want to
+// annotate their own stages (featurization, model call, postprocess) onto
+// the same timeline. RecordRegion is a RAII scope for that: while the
+// profiler is enabled it pushes/pops a range exactly like an op does, so
+// regions nest with ops and each other and show up in the usual event
+// export. The name must be a string literal (or otherwise outlive the
+// profiling session): only the pointer is kept, so entering or leaving a
+// region never allocates.
+//
+// Independently of the full profiler, a fixed-capacity "region ring" can
+// stay enabled in production. Each completed region is written as a plain
+// binary record into a preallocated ring, overwriting the oldest record
+// once full, and the ring can be sampled at any time with
+// snapshotRegionRing(). Memory use is bounded by the capacity passed to
+// enableRegionRing(), unlike the grow-until-disabled event lists the full
+// profiler accumulates.
+
+// A completed region as stored in the ring. Plain data, so recording is a
+// handful of stores and a snapshot is a copy.
+struct TORCH_API RegionEvent {
+  const char* name = nullptr;
+  int64_t start_ns = 0;
+  int64_t end_ns = 0;
+  uint16_t thread_id = 0;
+  uint16_t depth = 0; // nesting depth at entry; 0 for an outermost region
+};
+
+// NOTE: like changing profiler modes, enabling or disabling the region ring
+// is **NOT THREAD SAFE**; do it while no regions are being entered.
+TORCH_API void enableRegionRing(size_t capacity);
+// Stops recording but retains the current contents for a final snapshot.
+TORCH_API void disableRegionRing();
+// Returns the retained regions, oldest first. Safe to call while other
+// threads keep recording; records mid-update during the copy are skipped.
+TORCH_API std::vector<RegionEvent> snapshotRegionRing();
+
+struct TORCH_API RecordRegion {
+  explicit RecordRegion(const char* name);
+  ~RecordRegion();
+
+  RecordRegion(const RecordRegion&) = delete;
+  RecordRegion& operator=(const RecordRegion&) = delete;
+
+ private:
+  const char* name_;
+  int64_t start_ns_;
+  uint16_t depth_;
+};
+
+#define RECORD_REGION(name) \
+  torch::autograd::profiler::RecordRegion region_guard(name);
+
+// Note [Hardware counters at op boundaries]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Wall time alone cannot say whether a TensorIterator loop is bandwidth-
+// bound or compute-bound. On Linux, enablePerfCounters() programs a
+// per-thread perf_event counter group and samples it at RecordFunction
+// boundaries: the start callback snapshots the group, the end callback
+// reads it again and charges the delta to the op's name. Counts are
+// inclusive (a parent op's counts contain its callees') and are
+// aggregated per op name across every thread that ran ops while the mode
+// was enabled.
+//
+// The predefined fields in PerfCounterConfig map to the portable
+// PERF_COUNT_HW_* events. FLOP counts have no portable event; program
+// them through raw_events with the PMU event code for the machine at
+// hand (e.g. the FP_ARITH_INST_RETIRED umasks on recent Intel parts).
+// Keep the enabled set within the PMU's programmable counter width
+// (typically 4-8 counters) or the kernel will time-multiplex the group
+// and the deltas become estimates.
+//
+// Reading the group costs a syscall on each side of every op, so this
+// mode is meant for dedicated tuning runs, not for always-on production
+// use like the region ring above. Opening the group requires
+// perf_event_paranoid to permit per-thread counting (<= 2 on stock
+// kernels); enablePerfCounters() throws when the group cannot be opened.
+
+// Selects the events programmed into the per-thread counter group. Each
+// enabled field contributes one PERF_COUNT_HW_* event, in field order;
+// raw_events are appended as PERF_TYPE_RAW events for PMU-specific
+// counters (such as retired-FLOP events) that have no portable name.
+struct TORCH_API PerfCounterConfig {
+  bool cycles = true;
+  bool instructions = true;
+  bool cache_references = true;
+  bool cache_misses = true;
+  bool branch_instructions = false;
+  bool branch_misses = false;
+  std::vector<uint64_t> raw_events;
+};
+
+// Aggregated counts for one op name. Fields whose event was not enabled
+// stay zero; raw_events lines up with PerfCounterConfig::raw_events.
+struct TORCH_API PerfOpStats {
+  uint64_t calls = 0;
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t cache_references = 0;
+  uint64_t cache_misses = 0;
+  uint64_t branch_instructions = 0;
+  uint64_t branch_misses = 0;
+  std::vector<uint64_t> raw_events;
+};
+
+using perf_op_stats = std::unordered_map<std::string, PerfOpStats>;
+
+// NOTE: like changing profiler modes, enabling or disabling perf counter
+// collection is **NOT THREAD SAFE**; do it while no ops are executing.
+// Linux only; throws elsewhere. See Note [Hardware counters at op
+// boundaries].
+TORCH_API void enablePerfCounters(
+    const PerfCounterConfig& config = PerfCounterConfig());
+// Stops collection and returns the counts aggregated per op name across
+// all threads that ran ops while the mode was enabled.
+TORCH_API perf_op_stats disablePerfCounters();
+
+// Attributes allocator traffic to ops: pushes a RecordFunction hook that
+// opens a c10::allocation_tracker scope named after each dispatched op,
+// so the tracker's per-scope live/peak byte counters (see Note [Scoped
+// allocation tracking] in c10/core/AllocationTracker.h) break down by op.
+// Query results through c10::allocation_tracker::snapshot() or
+// flameReport(). NOT THREAD SAFE to enable/disable, like the modes above.
+TORCH_API void enableMemoryTracking();
+TORCH_API void disableMemoryTracking();
 
 // Usage:
 //   {
@@ -0,0 +1,178 @@
+#include <torch/csrc/autograd/profiler_histogram.h>
+
+#include <torch/csrc/autograd/record_function.h>
+
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+namespace {
+
+struct LatencyHistogram {
+  std::array<std::atomic<uint64_t>, kLatencyHistogramBuckets> buckets{};
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> total_ns{0};
+
+  void record(int64_t ns) {
+    if (ns < 1) {
+      ns = 1;
+    }
+    size_t index = 0;
+    for (uint64_t v = static_cast<uint64_t>(ns) >> 1; v != 0; v >>= 1) {
+      ++index;
+    }
+    index = std::min(index, kLatencyHistogramBuckets - 1);
+    buckets[index].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+  }
+};
+
+// Histograms are created once per op name and never destroyed, so the
+// per-thread pointer caches below can skip the registry lock in steady
+// state without lifetime concerns.
+std::mutex registry_mutex;
+std::unordered_map<std::string, std::unique_ptr<LatencyHistogram>>& registry() {
+  static auto* map =
+      new std::unordered_map<std::string, std::unique_ptr<LatencyHistogram>>();
+  return *map;
+}
+
+LatencyHistogram& histogramFor(const char* name) {
+  thread_local std::unordered_map<std::string, LatencyHistogram*> cache;
+  auto cached = cache.find(name);
+  if (cached != cache.end()) {
+    return *cached->second;
+  }
+  std::string key(name);
+  LatencyHistogram* histogram = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& slot = registry()[key];
+    if (slot == nullptr) {
+      slot.reset(new LatencyHistogram());
+    }
+    histogram = slot.get();
+  }
+  cache.emplace(std::move(key), histogram);
+  return *histogram;
+}
+
+std::atomic<uint64_t> sample_every{1};
+bool callback_installed = false;
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Start times of the currently nested (sampled) RecordFunctions on this
+// thread; -1 marks a call that the sampler skipped. RecordFunction
+// begin/end pairs nest properly per thread, so a stack lines them up.
+thread_local std::vector<int64_t> start_times;
+thread_local uint64_t sample_counter = 0;
+
+void onFunctionStart(const RecordFunction& /*rf*/) {
+  const auto every = sample_every.load(std::memory_order_relaxed);
+  if (every > 1 && (sample_counter++ % every) != 0) {
+    start_times.push_back(-1);
+    return;
+  }
+  start_times.push_back(now_ns());
+}
+
+void onFunctionEnd(const RecordFunction& rf) {
+  if (start_times.empty()) {
+    // Enabled while this op was already in flight; nothing to pair with.
+    return;
+  }
+  const int64_t started = start_times.back();
+  start_times.pop_back();
+  if (started < 0 || rf.name().str() == nullptr) {
+    return;
+  }
+  histogramFor(rf.name().str()).record(now_ns() - started);
+}
+
+} // namespace
+
+uint64_t OpLatencyStats::percentile_ns(double p) const {
+  if (count == 0) {
+    return 0;
+  }
+  p = std::min(std::max(p, 0.0), 1.0);
+  const uint64_t target = static_cast<uint64_t>(p * (count - 1)) + 1;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= target) {
+      return i + 1 < 64 ? (uint64_t(1) << (i + 1)) - 1 : UINT64_MAX;
+    }
+  }
+  return UINT64_MAX;
+}
+
+void enableLatencyHistograms(uint64_t every) {
+  AT_CHECK(every > 0, "sample_every_n must be positive, got ", every);
+  AT_CHECK(
+      !callback_installed,
+      "latency histograms are already enabled");
+  sample_every.store(every, std::memory_order_relaxed);
+  pushCallback(&onFunctionStart, &onFunctionEnd, /*needs_inputs=*/false);
+  callback_installed = true;
+}
+
+void disableLatencyHistograms() {
+  AT_CHECK(callback_installed, "latency histograms are not enabled");
+  // pushCallback/popCallback form a stack: like any profiler, this must be
+  // disabled before (or after) other callbacks pushed around it.
+  popCallback();
+  callback_installed = false;
+}
+
+std::vector<OpLatencyStats> latencyHistogramSnapshot() {
+  std::vector<OpLatencyStats> result;
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  result.reserve(registry().size());
+  for (const auto& entry : registry()) {
+    OpLatencyStats stats;
+    stats.name = entry.first;
+    stats.count = entry.second->count.load(std::memory_order_relaxed);
+    stats.total_ns = entry.second->total_ns.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kLatencyHistogramBuckets; ++i) {
+      stats.buckets[i] =
+          entry.second->buckets[i].load(std::memory_order_relaxed);
+    }
+    result.push_back(std::move(stats));
+  }
+  std::sort(
+      result.begin(), result.end(), [](const auto& a, const auto& b) {
+        return a.name < b.name;
+      });
+  return result;
+}
+
+void resetLatencyHistograms() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  for (auto& entry : registry()) {
+    for (auto& bucket : entry.second->buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    entry.second->count.store(0, std::memory_order_relaxed);
+    entry.second->total_ns.store(0, std::memory_order_relaxed);
+  }
+}
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
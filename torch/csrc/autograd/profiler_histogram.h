@@ -0,0 +1,55 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+// Always-on operator latency histograms.
+//
+// Unlike the start/stop profiler, which allocates an event per call and is
+// meant for offline traces, this mode keeps one fixed-size histogram of
+// power-of-two latency buckets per operator name, updated with relaxed
+// atomic increments from the RecordFunction hooks. Overhead per recorded
+// op is two clock reads and one atomic add, and sampling can thin that
+// further, so it is suitable for continuous visibility on live traffic.
+
+constexpr size_t kLatencyHistogramBuckets = 48;
+
+struct TORCH_API OpLatencyStats {
+  std::string name;
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+  // buckets[i] counts samples with latency in [2^i, 2^(i+1)) nanoseconds
+  // (bucket 0 also absorbs sub-nanosecond readings).
+  std::array<uint64_t, kLatencyHistogramBuckets> buckets{};
+
+  // Upper bound of the bucket containing the p-th percentile (p in [0, 1]),
+  // in nanoseconds; 0 if the histogram is empty.
+  uint64_t percentile_ns(double p) const;
+};
+
+// Installs the histogram RecordFunction callback. Only every
+// `sample_every_n`-th call per thread is timed; 1 records everything.
+// Like pushCallback, not safe to call concurrently with running ops.
+TORCH_API void enableLatencyHistograms(uint64_t sample_every_n = 1);
+
+// Removes the callback installed by enableLatencyHistograms. Collected
+// histograms survive and remain visible to snapshots.
+TORCH_API void disableLatencyHistograms();
+
+// Returns a copy of all histograms collected so far, sorted by name.
+TORCH_API std::vector<OpLatencyStats> latencyHistogramSnapshot();
+
+// Resets all collected histograms to empty.
+TORCH_API void resetLatencyHistograms();
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
@@ -0,0 +1,425 @@
+#include <torch/csrc/autograd/profiler_roofline.h>
+
+#include <torch/csrc/autograd/profiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+namespace {
+
+double tensorBytes(const at::Tensor& t) {
+  if (!t.defined()) {
+    return 0;
+  }
+  return static_cast<double>(t.numel()) * t.element_size();
+}
+
+// Sum of bytes over the tensor inputs, and the element count / element size
+// of the largest one (a serviceable stand-in for the output of an
+// elementwise op, whose shape is not recorded).
+void scanTensorInputs(
+    const std::vector<c10::IValue>& inputs,
+    double* total_bytes,
+    double* largest_numel,
+    double* largest_element_size) {
+  *total_bytes = 0;
+  *largest_numel = 0;
+  *largest_element_size = 0;
+  for (const auto& input : inputs) {
+    if (!input.isTensor()) {
+      continue;
+    }
+    const auto& t = input.toTensor();
+    if (!t.defined()) {
+      continue;
+    }
+    *total_bytes += tensorBytes(t);
+    if (t.numel() > *largest_numel) {
+      *largest_numel = static_cast<double>(t.numel());
+      *largest_element_size = static_cast<double>(t.element_size());
+    }
+  }
+}
+
+cost_formula makeStreamingFormula(double flops_per_element) {
+  return [flops_per_element](const std::vector<c10::IValue>& inputs)
+             -> c10::optional<RooflineCost> {
+    double total_bytes, largest_numel, largest_element_size;
+    scanTensorInputs(inputs, &total_bytes, &largest_numel, &largest_element_size);
+    if (largest_numel == 0) {
+      return c10::nullopt;
+    }
+    RooflineCost cost;
+    cost.flops = flops_per_element * largest_numel;
+    // Every input is read once; one output the size of the largest input
+    // is written.
+    cost.bytes = total_bytes + largest_numel * largest_element_size;
+    return cost;
+  };
+}
+
+// mat1 [m, k] x mat2 [k, n]: the classic 2*m*k*n, plus streaming both
+// operands in and the result out.
+c10::optional<RooflineCost> gemmCost(
+    const at::Tensor& mat1,
+    const at::Tensor& mat2) {
+  if (!mat1.defined() || !mat2.defined() || mat1.dim() != 2 ||
+      mat2.dim() != 2) {
+    return c10::nullopt;
+  }
+  const double m = mat1.size(0);
+  const double k = mat1.size(1);
+  const double n = mat2.size(1);
+  RooflineCost cost;
+  cost.flops = 2.0 * m * k * n;
+  cost.bytes = tensorBytes(mat1) + tensorBytes(mat2) +
+      m * n * mat1.element_size();
+  return cost;
+}
+
+struct RooflineRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, cost_formula> formulas;
+  double peak_flops_per_second = 0;
+  double peak_bytes_per_second = 0;
+  bool seeded = false;
+  std::atomic<bool> enabled{false};
+};
+
+RooflineRegistry& registry() {
+  static RooflineRegistry r;
+  return r;
+}
+
+// Must be called with the registry mutex held.
+void seedDefaultFormulasLocked(RooflineRegistry& reg) {
+  if (reg.seeded) {
+    return;
+  }
+  reg.seeded = true;
+  auto put = [&](const char* name, cost_formula formula) {
+    // Seeds never replace a formula the user registered first.
+    reg.formulas.emplace(name, std::move(formula));
+  };
+
+  put("mm", [](const std::vector<c10::IValue>& inputs)
+              -> c10::optional<RooflineCost> {
+    if (inputs.size() < 2 || !inputs[0].isTensor() || !inputs[1].isTensor()) {
+      return c10::nullopt;
+    }
+    return gemmCost(inputs[0].toTensor(), inputs[1].toTensor());
+  });
+  put("addmm", [](const std::vector<c10::IValue>& inputs)
+                 -> c10::optional<RooflineCost> {
+    if (inputs.size() < 3 || !inputs[1].isTensor() || !inputs[2].isTensor()) {
+      return c10::nullopt;
+    }
+    auto cost = gemmCost(inputs[1].toTensor(), inputs[2].toTensor());
+    if (cost) {
+      // The bias add is one extra FLOP (and one read) per result element.
+      const auto& mat1 = inputs[1].toTensor();
+      const auto& mat2 = inputs[2].toTensor();
+      const double mn =
+          static_cast<double>(mat1.size(0)) * mat2.size(1);
+      cost->flops += mn;
+      cost->bytes += mn * mat1.element_size();
+    }
+    return cost;
+  });
+  put("bmm", [](const std::vector<c10::IValue>& inputs)
+               -> c10::optional<RooflineCost> {
+    if (inputs.size() < 2 || !inputs[0].isTensor() || !inputs[1].isTensor()) {
+      return c10::nullopt;
+    }
+    const auto& a = inputs[0].toTensor();
+    const auto& b = inputs[1].toTensor();
+    if (!a.defined() || !b.defined() || a.dim() != 3 || b.dim() != 3) {
+      return c10::nullopt;
+    }
+    const double batch = a.size(0);
+    const double m = a.size(1);
+    const double k = a.size(2);
+    const double n = b.size(2);
+    RooflineCost cost;
+    cost.flops = 2.0 * batch * m * k * n;
+    cost.bytes =
+        tensorBytes(a) + tensorBytes(b) + batch * m * n * a.element_size();
+    return cost;
+  });
+
+  // Streaming families: one (or a handful of) FLOPs per element, traffic
+  // dominated by reading the inputs and writing one output.
+  for (const char* name : {"add", "sub", "mul", "div", "relu", "threshold",
+                           "clamp", "where", "copy_"}) {
+    put(name, makeStreamingFormula(1));
+  }
+  // Transcendental families; the per-element count is a rough polynomial
+  // equivalent, which is what a roofline needs (these are bandwidth bound
+  // anyway at any reasonable vector width).
+  for (const char* name : {"exp", "log", "sigmoid", "tanh", "erf", "sqrt",
+                           "rsqrt", "pow"}) {
+    put(name, makeStreamingFormula(10));
+  }
+  // Reductions read everything once and perform one combine per element.
+  for (const char* name : {"sum", "mean", "prod", "max", "min", "norm",
+                           "dot"}) {
+    put(name, makeStreamingFormula(1));
+  }
+}
+
+// Per-thread accumulation, mirroring the perf counter mode: a depth stack
+// pairs start and end events, totals merge on disable.
+struct RooflineThreadState {
+  std::vector<int64_t> start_stack;
+  roofline_stats totals;
+};
+
+struct RooflineCollector {
+  std::mutex mutex;
+  std::list<std::shared_ptr<RooflineThreadState>> all_states;
+};
+
+RooflineCollector& collector() {
+  static RooflineCollector c;
+  return c;
+}
+
+thread_local std::shared_ptr<RooflineThreadState> roofline_state;
+
+RooflineThreadState& rooflineThreadState() {
+  if (!roofline_state) {
+    auto& c = collector();
+    std::lock_guard<std::mutex> guard(c.mutex);
+    roofline_state = std::make_shared<RooflineThreadState>();
+    c.all_states.emplace_front(roofline_state);
+  }
+  return *roofline_state;
+}
+
+void rooflineOpStart() {
+  if (!registry().enabled.load(std::memory_order_acquire)) {
+    return;
+  }
+  rooflineThreadState().start_stack.push_back(getTime());
+}
+
+void rooflineOpEnd(const RecordFunction& fn) {
+  auto& reg = registry();
+  if (!reg.enabled.load(std::memory_order_acquire) || !roofline_state) {
+    return;
+  }
+  auto& state = *roofline_state;
+  if (state.start_stack.empty()) {
+    // The op began before collection was enabled on this thread.
+    return;
+  }
+  const int64_t start_ns = state.start_stack.back();
+  state.start_stack.pop_back();
+  const int64_t end_ns = getTime();
+
+  auto& stats = state.totals[fn.name().str()];
+  stats.calls++;
+
+  c10::optional<RooflineCost> cost;
+  {
+    std::lock_guard<std::mutex> guard(reg.mutex);
+    auto it = reg.formulas.find(fn.name().str());
+    if (it != reg.formulas.end()) {
+      cost = it->second(fn.inputs());
+    }
+  }
+  if (!cost) {
+    return;
+  }
+  stats.costed_calls++;
+  stats.flops += cost->flops;
+  stats.bytes += cost->bytes;
+  stats.total_us += (end_ns - start_ns) / 1000.0;
+}
+
+// "add_" and "add_out" report as "add".
+std::string opFamily(const std::string& name) {
+  std::string family = name;
+  const char* suffixes[] = {"_out", "_"};
+  for (const char* suffix : suffixes) {
+    const size_t len = std::strlen(suffix);
+    if (family.size() > len &&
+        family.compare(family.size() - len, len, suffix) == 0) {
+      family.erase(family.size() - len);
+      break;
+    }
+  }
+  return family;
+}
+
+} // namespace
+
+void registerCostFormula(std::string op_name, cost_formula formula) {
+  auto& reg = registry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  reg.formulas[std::move(op_name)] = std::move(formula);
+}
+
+void registerStreamingCostFormula(
+    std::string op_name,
+    double flops_per_element) {
+  registerCostFormula(
+      std::move(op_name), makeStreamingFormula(flops_per_element));
+}
+
+void setRooflinePeaks(
+    double peak_flops_per_second,
+    double peak_bytes_per_second) {
+  AT_CHECK(
+      peak_flops_per_second > 0 && peak_bytes_per_second > 0,
+      "roofline peaks must be positive");
+  auto& reg = registry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  reg.peak_flops_per_second = peak_flops_per_second;
+  reg.peak_bytes_per_second = peak_bytes_per_second;
+}
+
+void enableRooflineProfiler() {
+  auto& reg = registry();
+  AT_CHECK(
+      !reg.enabled.load(std::memory_order_acquire),
+      "the roofline profiler is already enabled");
+  {
+    std::lock_guard<std::mutex> guard(reg.mutex);
+    seedDefaultFormulasLocked(reg);
+  }
+  reg.enabled.store(true, std::memory_order_release);
+  pushCallback(
+      [](const RecordFunction& /* unused */) { rooflineOpStart(); },
+      [](const RecordFunction& fn) { rooflineOpEnd(fn); },
+      /*needs_inputs=*/true);
+}
+
+roofline_stats disableRooflineProfiler() {
+  auto& reg = registry();
+  AT_CHECK(
+      reg.enabled.load(std::memory_order_acquire),
+      "can't disable the roofline profiler when it is not enabled");
+  popCallback();
+  reg.enabled.store(false, std::memory_order_release);
+
+  roofline_stats result;
+  auto& c = collector();
+  std::lock_guard<std::mutex> guard(c.mutex);
+  for (auto it = c.all_states.begin(); it != c.all_states.end();) {
+    auto& state = *it;
+    for (const auto& kv : state->totals) {
+      auto& merged = result[kv.first];
+      merged.calls += kv.second.calls;
+      merged.costed_calls += kv.second.costed_calls;
+      merged.flops += kv.second.flops;
+      merged.bytes += kv.second.bytes;
+      merged.total_us += kv.second.total_us;
+    }
+    state->totals.clear();
+    state->start_stack.clear();
+    // GC states whose threads have exited, as disableProfiler does for
+    // event lists.
+    if (state.use_count() == 1) {
+      it = c.all_states.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return result;
+}
+
+std::string rooflineReport(const roofline_stats& stats) {
+  double peak_flops, peak_bytes;
+  {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> guard(reg.mutex);
+    peak_flops = reg.peak_flops_per_second;
+    peak_bytes = reg.peak_bytes_per_second;
+  }
+  AT_CHECK(
+      peak_flops > 0 && peak_bytes > 0,
+      "call setRooflinePeaks() before rendering a roofline report");
+
+  roofline_stats families;
+  for (const auto& kv : stats) {
+    auto& family = families[opFamily(kv.first)];
+    family.calls += kv.second.calls;
+    family.costed_calls += kv.second.costed_calls;
+    family.flops += kv.second.flops;
+    family.bytes += kv.second.bytes;
+    family.total_us += kv.second.total_us;
+  }
+
+  struct Row {
+    std::string family;
+    uint64_t calls;
+    uint64_t costed_calls;
+    double flops_pct;
+    double bytes_pct;
+    double total_us;
+  };
+  std::vector<Row> rows;
+  std::vector<std::pair<std::string, uint64_t>> uncovered;
+  for (const auto& kv : families) {
+    if (kv.second.costed_calls == 0) {
+      uncovered.emplace_back(kv.first, kv.second.calls);
+      continue;
+    }
+    const double seconds = kv.second.total_us * 1e-6;
+    Row row;
+    row.family = kv.first;
+    row.calls = kv.second.calls;
+    row.costed_calls = kv.second.costed_calls;
+    row.flops_pct =
+        seconds > 0 ? 100.0 * kv.second.flops / seconds / peak_flops : 0;
+    row.bytes_pct =
+        seconds > 0 ? 100.0 * kv.second.bytes / seconds / peak_bytes : 0;
+    row.total_us = kv.second.total_us;
+    rows.push_back(std::move(row));
+  }
+  // The family closest to either ceiling first: those are well scheduled;
+  // the ones at the bottom with real time are the optimization worklist.
+  std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+    return std::max(a.flops_pct, a.bytes_pct) >
+        std::max(b.flops_pct, b.bytes_pct);
+  });
+
+  std::ostringstream out;
+  out << std::fixed;
+  out << std::setw(24) << std::left << "op family" << std::right
+      << std::setw(12) << "calls" << std::setw(14) << "time (us)"
+      << std::setw(14) << "% peak flop" << std::setw(14) << "% peak bw"
+      << "\n";
+  for (const auto& row : rows) {
+    out << std::setw(24) << std::left << row.family << std::right
+        << std::setw(12) << row.calls << std::setw(14)
+        << std::setprecision(1) << row.total_us << std::setw(13)
+        << std::setprecision(2) << row.flops_pct << "%" << std::setw(13)
+        << row.bytes_pct << "%"
+        << "\n";
+  }
+  if (!uncovered.empty()) {
+    std::sort(uncovered.begin(), uncovered.end());
+    out << "uncovered (no cost formula):";
+    for (const auto& kv : uncovered) {
+      out << " " << kv.first << " (" << kv.second << ")";
+    }
+    out << "\n";
+  }
+  return out.str();
+}
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <ATen/core/ivalue.h>
+#include <c10/util/Optional.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+// Roofline cost annotations for operator events.
+//
+// A registry maps operator names (as they appear in RecordFunction events,
+// i.e. the native_functions.yaml names) to formulas that derive the FLOPs
+// and bytes of one invocation from its recorded input IValues. While the
+// roofline mode is enabled, every op end event evaluates the registered
+// formula on the inputs the dispatcher recorded and charges the result --
+// together with the op's wall time -- to its name. The report then turns
+// the totals into achieved-vs-peak percentages per op family, so a trace
+// directly ranks which families are furthest from the machine's compute or
+// bandwidth ceiling. Formulas for the common GEMM and elementwise families
+// are seeded automatically; register your own to cover custom ops or to
+// override a seed. Counts are inclusive, like the perf counter mode: a
+// parent op's time contains its callees'.
+
+// Work performed by one op invocation, derived from its recorded inputs.
+struct TORCH_API RooflineCost {
+  double flops = 0; // floating-point operations
+  double bytes = 0; // bytes moved to and from memory (reads plus writes)
+};
+
+// Derives the cost of one invocation from the positional IValues the
+// dispatcher recorded for it. Return nullopt when the invocation cannot be
+// costed (unexpected arity, undefined tensors, and so on); such calls are
+// counted but contribute no work.
+using cost_formula =
+    std::function<c10::optional<RooflineCost>(const std::vector<c10::IValue>&)>;
+
+// Registers (or replaces) the formula for `op_name`.
+TORCH_API void registerCostFormula(std::string op_name, cost_formula formula);
+
+// Convenience: registers a streaming formula for an elementwise op --
+// `flops_per_element` FLOPs per element of the largest tensor input, bytes
+// equal to all tensor inputs read plus one output written.
+TORCH_API void registerStreamingCostFormula(
+    std::string op_name,
+    double flops_per_element);
+
+// Machine ceilings used to turn accumulated FLOPs and bytes into
+// achieved-vs-peak percentages in rooflineReport().
+TORCH_API void setRooflinePeaks(
+    double peak_flops_per_second,
+    double peak_bytes_per_second);
+
+struct TORCH_API RooflineOpStats {
+  uint64_t calls = 0; // all invocations seen
+  uint64_t costed_calls = 0; // invocations a formula could cost
+  double flops = 0;
+  double bytes = 0;
+  double total_us = 0; // wall time of costed invocations
+};
+
+using roofline_stats = std::unordered_map<std::string, RooflineOpStats>;
+
+// NOTE: like changing profiler modes, enabling or disabling the roofline
+// mode is **NOT THREAD SAFE**; do it while no ops are executing.
+TORCH_API void enableRooflineProfiler();
+// Stops collection and returns the totals aggregated per op name across
+// all threads that ran ops while the mode was enabled.
+TORCH_API roofline_stats disableRooflineProfiler();
+
+// Renders achieved GFLOP/s and GB/s per op family as percentages of the
+// configured peaks, largest share of peak first. In-place and out= variants
+// are folded into their base family; families without a formula are listed
+// as uncovered so the registry's gaps are visible.
+TORCH_API std::string rooflineReport(const roofline_stats& stats);
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
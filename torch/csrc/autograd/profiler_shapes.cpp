@@ -0,0 +1,359 @@
+#include <torch/csrc/autograd/profiler_shapes.h>
+
+#include <torch/csrc/autograd/record_function.h>
+
+#include <ATen/core/ivalue.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+namespace {
+
+// splitmix64 finalizer; turns the incrementally combined signature into a
+// well-mixed 64-bit value for the HyperLogLog.
+uint64_t mix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+uint64_t combine(uint64_t seed, uint64_t value) {
+  return seed * 0x100000001b3ULL ^ mix64(value);
+}
+
+// Position of the first set bit in the hash bits left over after register
+// selection, as HyperLogLog defines it (1-based, capped by the number of
+// bits available).
+uint8_t hllRank(uint64_t bits, int width) {
+  uint8_t rank = 1;
+  uint64_t mask = 1ULL << (width - 1);
+  while (rank <= width && (bits & mask) == 0) {
+    rank++;
+    mask >>= 1;
+  }
+  return rank;
+}
+
+void hllInsert(std::array<uint8_t, kShapeHllRegisters>& registers,
+               uint64_t hash) {
+  // 6 bits pick the register; the remaining 58 feed the rank.
+  const size_t index = hash >> 58;
+  const uint8_t rank = hllRank(hash << 6, 58);
+  if (rank > registers[index]) {
+    registers[index] = rank;
+  }
+}
+
+size_t numelBucket(uint64_t total_numel) {
+  if (total_numel == 0) {
+    return 0;
+  }
+  size_t bucket = 1;
+  while (total_numel > 1 && bucket < kShapeNumelBuckets - 1) {
+    total_numel >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+struct RingEntry {
+  uint64_t seq;
+  ShapeSample sample;
+};
+
+// Per-thread accumulation, mirroring the roofline mode: each thread owns
+// its ring and sketches outright and they merge on disable, so recording
+// never takes a lock. The global sequence counter is the only shared
+// write, and it exists solely to interleave the rings chronologically in
+// the merged result.
+struct ShapeThreadState {
+  std::vector<RingEntry> ring;
+  size_t ring_head = 0;
+  uint64_t dropped = 0;
+  shape_telemetry_stats totals;
+  std::unordered_map<std::string, uint64_t> last_signature;
+};
+
+struct ShapeCollector {
+  std::mutex mutex;
+  std::list<std::shared_ptr<ShapeThreadState>> all_states;
+};
+
+ShapeCollector& collector() {
+  static ShapeCollector c;
+  return c;
+}
+
+struct ShapeRegistry {
+  std::atomic<bool> enabled{false};
+  ObserverHandle handle = 0;
+  size_t ring_capacity = 0;
+  std::atomic<uint64_t> next_seq{0};
+};
+
+ShapeRegistry& registry() {
+  static ShapeRegistry r;
+  return r;
+}
+
+thread_local std::shared_ptr<ShapeThreadState> shape_state;
+
+ShapeThreadState& shapeThreadState() {
+  if (!shape_state) {
+    auto& c = collector();
+    std::lock_guard<std::mutex> guard(c.mutex);
+    shape_state = std::make_shared<ShapeThreadState>();
+    c.all_states.emplace_front(shape_state);
+  }
+  return *shape_state;
+}
+
+void ringPush(ShapeThreadState& state, size_t capacity, RingEntry entry) {
+  if (capacity == 0) {
+    return;
+  }
+  if (state.ring.size() < capacity) {
+    // The growable phase: the vector doubles on its own schedule, so a
+    // thread that records ten samples never pays for four thousand slots.
+    state.ring.push_back(std::move(entry));
+    return;
+  }
+  state.ring[state.ring_head] = std::move(entry);
+  state.ring_head = (state.ring_head + 1) % capacity;
+  state.dropped++;
+}
+
+void recordShapes(const RecordFunction& fn) {
+  auto& reg = registry();
+  if (!reg.enabled.load(std::memory_order_acquire)) {
+    return;
+  }
+  const char* name = fn.name().str();
+  if (name == nullptr) {
+    return;
+  }
+
+  ShapeSample sample;
+  sample.op = name;
+  uint64_t signature = 0;
+  uint64_t total_numel = 0;
+  auto add_tensor = [&](const at::Tensor& t) {
+    if (!t.defined()) {
+      signature = combine(signature, ~0ULL);
+      sample.shapes.emplace_back();
+      return;
+    }
+    auto sizes = t.sizes();
+    signature = combine(signature, static_cast<uint64_t>(sizes.size()));
+    for (int64_t size : sizes) {
+      signature = combine(signature, static_cast<uint64_t>(size));
+    }
+    total_numel += static_cast<uint64_t>(t.numel());
+    sample.shapes.emplace_back(sizes.vec());
+  };
+  for (const auto& input : fn.inputs()) {
+    if (input.isTensor()) {
+      add_tensor(input.toTensor());
+    } else if (input.isTensorList()) {
+      for (const auto& t : input.toTensorListRef()) {
+        add_tensor(t);
+      }
+    }
+  }
+
+  auto& state = shapeThreadState();
+  auto& stats = state.totals[sample.op];
+  stats.calls++;
+  hllInsert(stats.hll_registers, mix64(signature));
+  stats.numel_buckets[numelBucket(total_numel)]++;
+
+  auto it = state.last_signature.find(sample.op);
+  if (it != state.last_signature.end()) {
+    if (it->second != signature) {
+      stats.shape_changes++;
+      it->second = signature;
+    }
+  } else {
+    state.last_signature.emplace(sample.op, signature);
+  }
+
+  RingEntry entry;
+  entry.seq = reg.next_seq.fetch_add(1, std::memory_order_relaxed);
+  entry.sample = std::move(sample);
+  ringPush(state, reg.ring_capacity, std::move(entry));
+}
+
+} // namespace
+
+double ShapeTelemetryOpStats::distinctShapes() const {
+  constexpr double m = static_cast<double>(kShapeHllRegisters);
+  constexpr double alpha = 0.709; // alpha_m for m = 64
+  double inverse_sum = 0;
+  size_t zero_registers = 0;
+  for (uint8_t rank : hll_registers) {
+    inverse_sum += std::ldexp(1.0, -static_cast<int>(rank));
+    if (rank == 0) {
+      zero_registers++;
+    }
+  }
+  double estimate = alpha * m * m / inverse_sum;
+  if (estimate <= 2.5 * m && zero_registers > 0) {
+    // Linear counting is more accurate in the small-cardinality regime.
+    estimate = m * std::log(m / static_cast<double>(zero_registers));
+  }
+  return estimate;
+}
+
+void enableShapeTelemetry(ShapeTelemetryOptions options) {
+  auto& reg = registry();
+  AT_CHECK(
+      !reg.enabled.load(std::memory_order_acquire),
+      "shape telemetry is already enabled");
+  reg.ring_capacity = options.ring_capacity;
+  reg.enabled.store(true, std::memory_order_release);
+  reg.handle = addOpObserver(
+      [](const RecordFunction& fn) { recordShapes(fn); },
+      [](const RecordFunction& /* unused */) {},
+      options.sampling_rate,
+      std::move(options.op_filter),
+      /*needs_inputs=*/true);
+}
+
+ShapeTelemetryResults disableShapeTelemetry() {
+  auto& reg = registry();
+  AT_CHECK(
+      reg.enabled.load(std::memory_order_acquire),
+      "can't disable shape telemetry when it is not enabled");
+  removeOpObserver(reg.handle);
+  reg.enabled.store(false, std::memory_order_release);
+
+  ShapeTelemetryResults results;
+  std::vector<RingEntry> entries;
+  auto& c = collector();
+  std::lock_guard<std::mutex> guard(c.mutex);
+  for (auto it = c.all_states.begin(); it != c.all_states.end();) {
+    auto& state = *it;
+    for (const auto& kv : state->totals) {
+      auto& merged = results.per_op[kv.first];
+      merged.calls += kv.second.calls;
+      merged.shape_changes += kv.second.shape_changes;
+      // HyperLogLog registers merge exactly by taking the maximum.
+      for (size_t i = 0; i < kShapeHllRegisters; i++) {
+        merged.hll_registers[i] =
+            std::max(merged.hll_registers[i], kv.second.hll_registers[i]);
+      }
+      for (size_t i = 0; i < kShapeNumelBuckets; i++) {
+        merged.numel_buckets[i] += kv.second.numel_buckets[i];
+      }
+    }
+    results.dropped_samples += state->dropped;
+    for (auto& entry : state->ring) {
+      entries.push_back(std::move(entry));
+    }
+    state->ring.clear();
+    state->ring_head = 0;
+    state->dropped = 0;
+    state->totals.clear();
+    state->last_signature.clear();
+    // GC states whose threads have exited, as disableProfiler does for
+    // event lists.
+    if (state.use_count() == 1) {
+      it = c.all_states.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  std::sort(
+      entries.begin(), entries.end(), [](const RingEntry& a, const RingEntry& b) {
+        return a.seq < b.seq;
+      });
+  results.samples.reserve(entries.size());
+  for (auto& entry : entries) {
+    results.samples.push_back(std::move(entry.sample));
+  }
+  reg.next_seq.store(0, std::memory_order_relaxed);
+  return results;
+}
+
+std::string shapeTelemetryReport(const ShapeTelemetryResults& results) {
+  struct Row {
+    std::string op;
+    uint64_t calls;
+    double distinct;
+    double change_pct;
+    size_t min_bucket;
+    size_t max_bucket;
+  };
+  std::vector<Row> rows;
+  for (const auto& kv : results.per_op) {
+    Row row;
+    row.op = kv.first;
+    row.calls = kv.second.calls;
+    row.distinct = kv.second.distinctShapes();
+    row.change_pct = kv.second.calls > 0
+        ? 100.0 * kv.second.shape_changes / kv.second.calls
+        : 0;
+    row.min_bucket = kShapeNumelBuckets;
+    row.max_bucket = 0;
+    for (size_t i = 0; i < kShapeNumelBuckets; i++) {
+      if (kv.second.numel_buckets[i] != 0) {
+        row.min_bucket = std::min(row.min_bucket, i);
+        row.max_bucket = std::max(row.max_bucket, i);
+      }
+    }
+    rows.push_back(std::move(row));
+  }
+  // The most shape-dynamic ops first: the top of this table is the
+  // argument for (or against) investing in shape bucketing.
+  std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+    return a.distinct > b.distinct;
+  });
+
+  auto bucket_label = [](size_t bucket) -> std::string {
+    if (bucket == 0) {
+      return "0";
+    }
+    std::ostringstream label;
+    label << "2^" << (bucket - 1);
+    return label.str();
+  };
+
+  std::ostringstream out;
+  out << std::fixed;
+  out << std::setw(24) << std::left << "op" << std::right << std::setw(12)
+      << "calls" << std::setw(16) << "distinct shapes" << std::setw(12)
+      << "changed" << std::setw(16) << "input numel"
+      << "\n";
+  for (const auto& row : rows) {
+    std::string range = row.min_bucket > row.max_bucket
+        ? "-"
+        : bucket_label(row.min_bucket) + ".." + bucket_label(row.max_bucket);
+    out << std::setw(24) << std::left << row.op << std::right << std::setw(12)
+        << row.calls << std::setw(16) << std::setprecision(1) << row.distinct
+        << std::setw(11) << row.change_pct << "%" << std::setw(16) << range
+        << "\n";
+  }
+  out << results.samples.size() << " samples retained";
+  if (results.dropped_samples > 0) {
+    out << ", " << results.dropped_samples << " dropped to ring wraparound";
+  }
+  out << "\n";
+  return out.str();
+}
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+// Shape telemetry for operator events.
+//
+// Answers "which ops see dynamic shapes, and how dynamic are they?"
+// without the overhead (and measurement distortion) of Python-side hooks.
+// While the mode is enabled, an op observer (see Note [Operator observers]
+// in record_function.h) records every sampled invocation's input shapes
+// into two structures:
+//
+//  - a per-thread ring of recent (op, input shapes) samples, so the exact
+//    shapes an op saw can be inspected. Each thread's ring starts small
+//    and grows geometrically up to the configured capacity before it
+//    wraps, so idle threads stay cheap. A thread's ring has a single
+//    writer and is only read after the observer is detached, so the
+//    recording path takes no locks;
+//
+//  - per-op sketches: a HyperLogLog over shape signatures estimating the
+//    number of distinct input shapes, a histogram of total input element
+//    counts bucketed by power of two, and a count of calls whose shapes
+//    differed from the thread's previous call of the same op.
+//
+// The report ranks ops by estimated distinct shapes, which is exactly the
+// worklist for shape bucketing: an op with thousands of calls but a
+// handful of shapes is a specialization candidate, one with a new shape
+// every call is not.
+
+// Number of HyperLogLog registers per op. 64 registers keep the sketch at
+// 64 bytes per op with ~13% relative error, plenty to separate "a few
+// shapes" from "a new shape every call".
+constexpr size_t kShapeHllRegisters = 64;
+
+// Histogram buckets over the total input element count of one call:
+// bucket 0 holds empty inputs, bucket k holds [2^(k-1), 2^k).
+constexpr size_t kShapeNumelBuckets = 44;
+
+struct TORCH_API ShapeTelemetryOpStats {
+  uint64_t calls = 0;
+  // Calls whose shape signature differed from the same thread's previous
+  // call of this op. Tracked per thread and summed, so it is a lower
+  // bound on cross-thread shape churn.
+  uint64_t shape_changes = 0;
+  std::array<uint8_t, kShapeHllRegisters> hll_registers{};
+  std::array<uint64_t, kShapeNumelBuckets> numel_buckets{};
+
+  // HyperLogLog estimate of the number of distinct input-shape tuples.
+  double distinctShapes() const;
+};
+
+using shape_telemetry_stats =
+    std::unordered_map<std::string, ShapeTelemetryOpStats>;
+
+// One recorded invocation: the op name and the shape of each tensor
+// input, in positional order (tensor list inputs contribute one shape per
+// element).
+struct TORCH_API ShapeSample {
+  std::string op;
+  std::vector<std::vector<int64_t>> shapes;
+};
+
+struct TORCH_API ShapeTelemetryOptions {
+  // Per-thread ring capacity; rings grow geometrically up to this before
+  // overwriting their oldest samples.
+  size_t ring_capacity = 4096;
+  // Observe 1 of every `sampling_rate` calls (forwarded to the observer).
+  int64_t sampling_rate = 1;
+  // Restrict collection to these op names; empty means all ops.
+  std::vector<std::string> op_filter;
+};
+
+// NOTE: like changing profiler modes, enabling or disabling shape
+// telemetry is **NOT THREAD SAFE**; do it while no ops are executing.
+TORCH_API void enableShapeTelemetry(
+    ShapeTelemetryOptions options = ShapeTelemetryOptions());
+
+struct TORCH_API ShapeTelemetryResults {
+  shape_telemetry_stats per_op;
+  // Retained ring samples across all threads, oldest first.
+  std::vector<ShapeSample> samples;
+  // Samples overwritten by ring wraparound.
+  uint64_t dropped_samples = 0;
+};
+
+// Detaches the observer and returns the sketches merged across all
+// threads that ran ops while the mode was enabled.
+TORCH_API ShapeTelemetryResults disableShapeTelemetry();
+
+// Renders per-op shape dynamics, most distinct shapes first: call count,
+// estimated distinct shapes, the fraction of calls that changed shape,
+// and the input size range covered.
+TORCH_API std::string shapeTelemetryReport(
+    const ShapeTelemetryResults& results);
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
@@ -1,24 +1,125 @@
 #include <torch/csrc/autograd/record_function.h>
 #include <torch/csrc/autograd/function.h>
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace torch { namespace autograd { namespace profiler {
 
+namespace detail {
+std::atomic<uint64_t> record_function_active{0};
+} // namespace detail
+
 namespace {
 std::vector<RecordFunctionCallback> start_callbacks;
 std::vector<RecordFunctionCallback> end_callbacks;
-size_t callback_needs_inputs = 0;
+std::atomic<int64_t> callback_needs_inputs{0};
 thread_local RecordFunction* thread_local_func_ = nullptr;
+
+// See Note [Operator observers] in record_function.h.
+
+constexpr size_t kMaxObservers = 64;
+
+struct ObserverEntry {
+  ObserverHandle handle = 0;
+  RecordFunctionCallback start;
+  RecordFunctionCallback end;
+  int64_t sampling_rate = 1;
+  bool needs_inputs = false;
+  // Bitset over interned op-name ids; empty means observe every op.
+  std::vector<uint64_t> filter;
+};
+
+struct ObserverTable {
+  uint64_t epoch = 0;
+  std::vector<ObserverEntry> entries;
+};
+
+std::mutex observer_mutex;
+std::shared_ptr<const ObserverTable> observer_table; // writes hold the mutex
+std::atomic<uint64_t> observer_epoch{0};
+ObserverHandle next_observer_handle = 1;
+
+thread_local std::shared_ptr<const ObserverTable> cached_table;
+thread_local uint64_t cached_epoch = 0;
+
+const ObserverTable* currentObserverTable() {
+  const uint64_t epoch = observer_epoch.load(std::memory_order_acquire);
+  if (epoch == 0) {
+    return nullptr;
+  }
+  if (cached_epoch != epoch) {
+    std::lock_guard<std::mutex> guard(observer_mutex);
+    cached_table = observer_table;
+    cached_epoch = cached_table ? cached_table->epoch : 0;
+  }
+  return cached_table.get();
+}
+
+// Publishes a new table; callers hold observer_mutex.
+void publishObserverTable(std::vector<ObserverEntry> entries) {
+  auto table = std::make_shared<ObserverTable>();
+  table->epoch = observer_epoch.load(std::memory_order_relaxed) + 1;
+  table->entries = std::move(entries);
+  observer_table = std::move(table);
+  observer_epoch.store(observer_table->epoch, std::memory_order_release);
+}
+
+// Interned op names, shared by every filter so a bitset indexes them.
+// Only names some filter mentioned are ever interned: an op missing from
+// the table cannot pass any filter, so lookups never insert.
+std::mutex intern_mutex;
+std::unordered_map<std::string, size_t> interned_ops;
+
+size_t internOpName(const std::string& name) {
+  std::lock_guard<std::mutex> guard(intern_mutex);
+  auto it = interned_ops.find(name);
+  if (it != interned_ops.end()) {
+    return it->second;
+  }
+  const size_t id = interned_ops.size();
+  interned_ops.emplace(name, id);
+  return id;
+}
+
+int64_t lookupOpName(const char* name) {
+  std::lock_guard<std::mutex> guard(intern_mutex);
+  auto it = interned_ops.find(name);
+  return it == interned_ops.end() ? -1 : static_cast<int64_t>(it->second);
+}
+
+bool testFilterBit(const std::vector<uint64_t>& filter, int64_t id) {
+  const size_t word = static_cast<size_t>(id) >> 6;
+  return word < filter.size() &&
+      (filter[word] & (uint64_t(1) << (id & 63))) != 0;
+}
+
+// Per-thread xorshift for sampling decisions: no shared state, a few
+// cycles per call.
+uint64_t samplingRand() {
+  thread_local uint64_t state =
+      std::chrono::steady_clock::now().time_since_epoch().count() ^
+      reinterpret_cast<uintptr_t>(&state);
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
 }
 
+} // namespace
+
 void pushCallback(
     RecordFunctionCallback start,
     RecordFunctionCallback end,
     bool needs_inputs) {
   start_callbacks.push_back(start);
   end_callbacks.push_back(end);
-  if (callback_needs_inputs > 0 || needs_inputs) {
-    ++callback_needs_inputs;
+  if (needs_inputs) {
+    callback_needs_inputs.fetch_add(1, std::memory_order_relaxed);
   }
+  detail::record_function_active.fetch_add(1, std::memory_order_relaxed);
 }
 
 void popCallback() {
@@ -27,17 +128,78 @@ void popCallback() {
   }
   start_callbacks.pop_back();
   end_callbacks.pop_back();
-  if (callback_needs_inputs > 0) {
-    --callback_needs_inputs;
+  if (callback_needs_inputs.load(std::memory_order_relaxed) > 0) {
+    callback_needs_inputs.fetch_sub(1, std::memory_order_relaxed);
   }
+  detail::record_function_active.fetch_sub(1, std::memory_order_relaxed);
 }
 
-bool hasCallbacks() {
-  return !start_callbacks.empty();
+bool needsInputs() {
+  return callback_needs_inputs.load(std::memory_order_relaxed) > 0;
 }
 
-bool needsInputs() {
-  return callback_needs_inputs > 0;
+ObserverHandle addOpObserver(
+    RecordFunctionCallback start,
+    RecordFunctionCallback end,
+    int64_t sampling_rate,
+    std::vector<std::string> op_filter,
+    bool needs_inputs) {
+  if (sampling_rate < 1) {
+    throw std::runtime_error("sampling_rate must be at least 1");
+  }
+  ObserverEntry entry;
+  entry.start = std::move(start);
+  entry.end = std::move(end);
+  entry.sampling_rate = sampling_rate;
+  entry.needs_inputs = needs_inputs;
+  for (const auto& name : op_filter) {
+    const size_t id = internOpName(name);
+    if ((id >> 6) >= entry.filter.size()) {
+      entry.filter.resize((id >> 6) + 1, 0);
+    }
+    entry.filter[id >> 6] |= uint64_t(1) << (id & 63);
+  }
+
+  std::lock_guard<std::mutex> guard(observer_mutex);
+  std::vector<ObserverEntry> entries =
+      observer_table ? observer_table->entries : std::vector<ObserverEntry>();
+  if (entries.size() >= kMaxObservers) {
+    throw std::runtime_error("too many op observers registered");
+  }
+  const ObserverHandle handle = next_observer_handle++;
+  entry.handle = handle;
+  entries.push_back(std::move(entry));
+  publishObserverTable(std::move(entries));
+  if (needs_inputs) {
+    callback_needs_inputs.fetch_add(1, std::memory_order_relaxed);
+  }
+  detail::record_function_active.fetch_add(1, std::memory_order_relaxed);
+  return handle;
+}
+
+void removeOpObserver(ObserverHandle handle) {
+  std::lock_guard<std::mutex> guard(observer_mutex);
+  if (!observer_table) {
+    return;
+  }
+  std::vector<ObserverEntry> entries;
+  bool removed = false;
+  bool removed_needs_inputs = false;
+  for (const auto& entry : observer_table->entries) {
+    if (entry.handle == handle) {
+      removed = true;
+      removed_needs_inputs = entry.needs_inputs;
+    } else {
+      entries.push_back(entry);
+    }
+  }
+  if (removed) {
+    publishObserverTable(std::move(entries));
+    if (removed_needs_inputs) {
+      callback_needs_inputs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    detail::record_function_active.fetch_sub(1, std::memory_order_relaxed);
+  }
 }
 
 void RecordFunction::before(const char* name, int64_t sequence_nr) {
@@ -84,6 +246,55 @@ void RecordFunction::processCallbacks() {
   for (const auto& cb : start_callbacks) {
     cb(*this);
   }
+  runStartObservers();
+}
+
+void RecordFunction::runStartObservers() {
+  const auto* table = currentObserverTable();
+  if (table == nullptr || table->entries.empty()) {
+    return;
+  }
+  observer_epoch_ = table->epoch;
+  uint64_t bits = 0;
+  for (size_t i = 0; i < table->entries.size(); i++) {
+    const auto& entry = table->entries[i];
+    if (entry.sampling_rate > 1 &&
+        samplingRand() % static_cast<uint64_t>(entry.sampling_rate) != 0) {
+      continue;
+    }
+    if (!entry.filter.empty()) {
+      const int64_t id = lookupOpName(name_.str());
+      if (id < 0 || !testFilterBit(entry.filter, id)) {
+        continue;
+      }
+    }
+    bits |= uint64_t(1) << i;
+    if (entry.start) {
+      entry.start(*this);
+    }
+  }
+  observer_bits_ = bits;
+}
+
+void RecordFunction::runEndObservers() {
+  if (observer_bits_ == 0) {
+    return;
+  }
+  const auto* table = currentObserverTable();
+  if (table == nullptr || table->epoch != observer_epoch_) {
+    // The table was swapped while this op was in flight; its end
+    // observation is dropped rather than delivered to the wrong entry.
+    return;
+  }
+  for (size_t i = 0; i < table->entries.size(); i++) {
+    if ((observer_bits_ & (uint64_t(1) << i)) == 0) {
+      continue;
+    }
+    const auto& entry = table->entries[i];
+    if (entry.end) {
+      entry.end(*this);
+    }
+  }
 }
 
 RecordFunction::~RecordFunction() {
@@ -91,6 +302,7 @@ RecordFunction::~RecordFunction() {
     for (const auto& cb : end_callbacks) {
       cb(*this);
     }
+    runEndObservers();
     thread_local_func_ = parent_;
   }
 }
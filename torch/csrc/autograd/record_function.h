@@ -4,6 +4,8 @@
 #include <c10/util/SmallVector.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 
+#include <atomic>
+
 namespace torch { namespace autograd {
 
 struct Function;
@@ -79,6 +81,8 @@ struct TORCH_API RecordFunction {
 
  private:
   void processCallbacks();
+  void runStartObservers();
+  void runEndObservers();
 
   Function* fn_ = nullptr;
   StringView name_;
@@ -86,10 +90,25 @@ struct TORCH_API RecordFunction {
   std::vector<c10::IValue> inputs_;
   RecordFunction* parent_ = nullptr;
 
+  // Which observers sampled this call at entry, and under which table
+  // epoch; see Note [Operator observers].
+  uint64_t observer_bits_ = 0;
+  uint64_t observer_epoch_ = 0;
+
   bool initialized_ = false;
 };
 
-TORCH_API bool hasCallbacks();
+namespace detail {
+// Number of pushed callbacks plus registered observers. Kept as one
+// counter so the RECORD_FUNCTION fast path is a single relaxed load when
+// nothing is listening.
+TORCH_API extern std::atomic<uint64_t> record_function_active;
+} // namespace detail
+
+inline bool hasCallbacks() {
+  return detail::record_function_active.load(std::memory_order_relaxed) != 0;
+}
+
 TORCH_API bool needsInputs();
 
 // optional argument - function's seq_no
@@ -112,5 +131,36 @@ TORCH_API void pushCallback(
     bool needs_inputs = false);
 TORCH_API void popCallback();
 
+// Note [Operator observers]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The pushCallback stack above suits scoped profiling sessions, but
+// production telemetry (op counts, shape distributions, dtype mix) needs
+// observers that can be attached and detached at runtime, from any
+// thread, without rebuilding and at near-zero cost when disabled.
+//
+// Observers live in an immutable, epoch-tagged table: registration
+// builds a new table and publishes it with a bumped epoch, and each
+// reader thread re-fetches its cached table only when it sees a new
+// epoch, so steady-state dispatch touches no locks. When nothing is
+// listening the whole machinery is behind hasCallbacks()'s single
+// relaxed atomic load. Each observer can sample (observe 1 of every
+// sampling_rate calls, decided by a thread-local RNG, no shared state)
+// and can restrict itself to an op-name filter, which is compiled at
+// registration into a bitset over interned op names so the per-call
+// check is a lookup plus a bit test. Which observers sampled a call is
+// latched into the RecordFunction at entry, so start/end pairs stay
+// consistent; if the table is swapped while an op is in flight, its end
+// observation is dropped (sampling semantics make this benign).
+//
+// At most 64 observers may be registered at once.
+using ObserverHandle = uint64_t;
+TORCH_API ObserverHandle addOpObserver(
+    RecordFunctionCallback start,
+    RecordFunctionCallback end = [](const RecordFunction&) {},
+    int64_t sampling_rate = 1,
+    std::vector<std::string> op_filter = {},
+    bool needs_inputs = false);
+TORCH_API void removeOpObserver(ObserverHandle handle);
+
 } // namespace profiler
 }} // namespace torch::autograd
@@ -33,6 +33,18 @@ class TORCH_API SavedVariable {
     return data_.reset();
   }
 
+  /// Identity of the saved snapshot: the underlying TensorImpl and the
+  /// version it was saved at. Two SavedVariables with equal stamps unpack
+  /// to the same values. Used by backward CSE; see Note [Backward CSE] in
+  /// engine.cpp.
+  std::pair<const void*, uint64_t> stamp() const {
+    return std::make_pair(
+        data_.defined()
+            ? static_cast<const void*>(data_.unsafeGetTensorImpl())
+            : nullptr,
+        static_cast<uint64_t>(saved_version_));
+  }
+
   void reset_grad_function() {
     grad_fn_.reset();
   }
@@ -140,7 +140,7 @@ void Variable::backward(
     bool keep_graph,
     bool create_graph) const {
   auto autograd_meta = get_autograd_meta();
-  std::vector<Edge> edges;
+  edge_list edges;
   edges.emplace_back(autograd_meta->grad_fn_, autograd_meta->output_nr_);
 
   std::vector<Variable> inputs;
@@ -60,6 +60,11 @@ PyObject* c10d_init(PyObject* _unused) {
           [](::c10d::Reducer& reducer, const torch::autograd::Variable& output)
               -> void { reducer.prepare_for_backward({output}); },
           py::call_guard<py::gil_scoped_release>())
+      .def(
+          "rebuild_buckets",
+          &::c10d::Reducer::rebuild_buckets,
+          py::call_guard<py::gil_scoped_release>())
+      .def("get_grad_ready_order", &::c10d::Reducer::get_grad_ready_order)
       .def("get_backward_stats", &::c10d::Reducer::get_backward_stats);
 
   py::enum_<::c10d::ReduceOp>(module, "ReduceOp", R"(
@@ -132,6 +137,24 @@ They are used in specifying strategies for reduction collectives, e.g.,
                     reinterpret_cast<char*>(value.data()), value.size());
               },
               py::call_guard<py::gil_scoped_release>())
+          .def(
+              "multi_get",
+              [](::c10d::Store& store, const std::vector<std::string>& keys)
+                  -> std::vector<py::bytes> {
+                std::vector<std::vector<uint8_t>> values;
+                {
+                  py::gil_scoped_release release;
+                  values = store.multiGet(keys);
+                }
+                std::vector<py::bytes> result;
+                result.reserve(values.size());
+                for (const auto& value : values) {
+                  result.emplace_back(
+                      reinterpret_cast<const char*>(value.data()),
+                      value.size());
+                }
+                return result;
+              })
           .def(
               "add",
               &::c10d::Store::add,
@@ -426,7 +449,22 @@ They are used in specifying strategies for reduction collectives, e.g.,
           py::arg("store"),
           py::arg("rank"),
           py::arg("size"),
-          py::arg("groupName") = "");
+          py::arg("groupName") = "")
+      .def_static(
+          "remap_rank",
+          &::c10d::ProcessGroupNCCL::remapRank,
+          py::arg("old_rank"),
+          py::arg("failed_ranks"))
+      .def(
+          "reconfigure",
+          &::c10d::ProcessGroupNCCL::reconfigure,
+          py::arg("rank"),
+          py::arg("size"),
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "rebuild_communicators",
+          &::c10d::ProcessGroupNCCL::rebuildCommunicators,
+          py::call_guard<py::gil_scoped_release>());
 #endif
 
 #ifdef USE_C10D_MPI
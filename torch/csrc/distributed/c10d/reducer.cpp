@@ -160,6 +160,9 @@ void Reducer::mark_variable_ready(
       "Out of range variable index.");
   backward_stats_[replica_index][variable_index] =
       current_time_in_nanos() - backward_stats_base_;
+  if (replica_index == 0) {
+    grad_ready_order_.push_back(variable_index);
+  }
 
   const auto& bucket_index = variable_locators_[variable_index];
   auto& bucket = buckets_[bucket_index.bucket_index];
@@ -381,6 +384,7 @@ void Reducer::prepare_for_backward(
   has_marked_unused_parameters_ = true;
   expect_autograd_hooks_ = true;
   next_bucket_ = 0;
+  grad_ready_order_.clear();
   backward_stats_base_ = current_time_in_nanos();
   for (auto& bucket : buckets_) {
     for (auto& replica : bucket.replicas) {
@@ -434,6 +438,41 @@ void Reducer::prepare_for_backward(
   }
 }
 
+void Reducer::rebuild_buckets(std::vector<size_t> bucket_size_limits) {
+  std::vector<size_t> order;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AT_ASSERTM(
+        !expect_autograd_hooks_,
+        "`rebuild_buckets` must NOT be called during autograd execution.");
+    AT_CHECK(
+        grad_ready_order_.size() == replicas_[0].size(),
+        "Cannot rebuild buckets before a backward pass has produced ",
+        "a gradient for every parameter.");
+    order = grad_ready_order_;
+  }
+
+  // Bucket variables in the order their gradients became ready, so the
+  // first buckets to fill up during the next backward pass are also the
+  // first ones to be reduced, maximizing communication overlap. The
+  // assignment function buckets in list order, so feed it the tensors
+  // permuted by ready order and translate the returned positions back into
+  // variable indices.
+  std::vector<at::Tensor> tensors;
+  tensors.reserve(order.size());
+  for (const auto variable_index : order) {
+    tensors.push_back(replicas_[0][variable_index]);
+  }
+  auto bucket_indices =
+      compute_bucket_assignment_by_size(tensors, std::move(bucket_size_limits));
+  for (auto& bucket : bucket_indices) {
+    for (auto& position : bucket) {
+      position = order[position];
+    }
+  }
+  initialize_buckets(std::move(bucket_indices));
+}
+
 void Reducer::finalize_backward() {
   std::lock_guard<std::mutex> lock(mutex_);
 
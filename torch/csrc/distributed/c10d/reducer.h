@@ -44,6 +44,19 @@ class Reducer {
     return backward_stats_;
   }
 
+  // Returns the variable indices in the order their gradients became ready
+  // during the most recent backward pass (observed on the first replica).
+  std::vector<size_t> get_grad_ready_order() const {
+    return grad_ready_order_;
+  }
+
+  // Re-buckets the variables based on the order in which their gradients
+  // became ready during the most recent backward pass, so that buckets fill
+  // up (and their allreduce can be kicked off) as early as possible. Requires
+  // at least one completed backward pass in which every parameter produced a
+  // gradient. Must not be called during autograd execution.
+  void rebuild_buckets(std::vector<size_t> bucket_size_limits);
+
  protected:
   std::mutex mutex_;
   std::vector<std::vector<torch::autograd::Variable>> replicas_;
@@ -58,6 +71,10 @@ class Reducer {
   bool has_marked_unused_parameters_;
   size_t next_bucket_;
 
+  // Variable indices in the order their gradients became ready, recorded
+  // for the first replica. Used by `rebuild_buckets`.
+  std::vector<size_t> grad_ready_order_;
+
   void mark_variable_ready(
       size_t replica_index,
       size_t variable_index,
@@ -125,6 +125,30 @@ struct ArgumentSpec {
     return hash_code;
   }
 
+  // The raw 32-bit ArgumentInfo words, in argument order. Since every
+  // field of the spec (including the hash, whose seed is the argument
+  // count) is derived from these words, wire()/fromWire() round-trip a
+  // spec exactly; the warm-start snapshot relies on this, see
+  // Note [Warm-start snapshots] in graph_executor.cpp.
+  std::vector<ArgumentInfo::plain_data_type> wire() const {
+    std::vector<ArgumentInfo::plain_data_type> words(args.size());
+    if (!args.empty()) {
+      std::memcpy(
+          words.data(), args.data(), args.size() * sizeof(ArgumentInfo));
+    }
+    return words;
+  }
+  static ArgumentSpec fromWire(
+      const std::vector<ArgumentInfo::plain_data_type>& words) {
+    ArgumentSpec spec(words.size());
+    for (const auto word : words) {
+      spec.args.emplace_back();
+      std::memcpy(&spec.args.back(), &word, sizeof(ArgumentInfo));
+      spec.combineHash(spec.args.back());
+    }
+    return spec;
+  }
+
  private:
   size_t hash_code; // precomputed on construction
   std::vector<ArgumentInfo> args;
@@ -2,6 +2,7 @@
 
 #include <ATen/core/functional.h>
 #include <torch/csrc/jit/operator.h>
+#include <torch/csrc/jit/passes/canonicalize.h>
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
 #include <torch/csrc/jit/passes/constant_pooling.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
@@ -14,6 +15,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 
 namespace torch {
 namespace jit {
@@ -841,6 +845,91 @@ static void lambdaLiftReverse(Gradient& grad_desc, ReverseDetails& rev_info) {
   reverse_block->owningNode()->destroy();
 }
 
+namespace {
+
+// Note [Autodiff graph cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Specialization re-differentiates every autodiff subgraph for each new
+// ArgumentSpec, even though the symbolic derivative only depends on the
+// graph itself. differentiate() therefore keeps a process-wide cache of
+// gradient pairs keyed by the canonicalized graph. Three things make the
+// key sound:
+//  - canonicalization with keep_unique_names=false makes the printed IR
+//    independent of value numbering, so structurally identical subgraphs
+//    from different specializations (or module replicas) collide;
+//  - requires_grad does not appear in printed types but changes which
+//    vjps are emitted, so the per-value flags are appended in
+//    topological order;
+//  - the printer elides tensor constant payloads, so their raw bytes are
+//    hashed in as well.
+// Hits hand out deep copies: callers optimize the forward graph in place
+// and pack both graphs into DifferentiableGraph nodes, so the cached
+// pair itself must stay pristine.
+constexpr size_t kGradientCacheMaxEntries = 256;
+
+uint64_t hashTensorBytes(const at::Tensor& tensor) {
+  auto contig = tensor.cpu().contiguous();
+  const auto* data = static_cast<const unsigned char*>(contig.data_ptr());
+  const size_t nbytes = contig.numel() * contig.element_size();
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < nbytes; ++i) {
+    hash = (hash ^ data[i]) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void appendValueDetails(Block* block, std::ostream& out) {
+  for (Value* input : block->inputs()) {
+    out << (input->requires_grad() ? '1' : '0');
+  }
+  for (Node* node : block->nodes()) {
+    for (Value* output : node->outputs()) {
+      out << (output->requires_grad() ? '1' : '0');
+    }
+    if (node->kind() == prim::Constant) {
+      for (auto name : node->attributeNames()) {
+        if (node->kindOf(name) == AttributeKind::t) {
+          out << " " << hashTensorBytes(node->t(name));
+        } else if (node->kindOf(name) == AttributeKind::ts) {
+          for (const auto& tensor : node->ts(name)) {
+            out << " " << hashTensorBytes(tensor);
+          }
+        }
+      }
+    }
+    for (Block* sub_block : node->blocks()) {
+      appendValueDetails(sub_block, out);
+    }
+  }
+}
+
+std::string gradientCacheKey(const std::shared_ptr<Graph>& graph) {
+  auto canonical = Canonicalize(graph, /*keep_unique_names=*/false);
+  std::ostringstream key;
+  key << *canonical << "\n";
+  appendValueDetails(canonical->block(), key);
+  return key.str();
+}
+
+Gradient copyGradient(const Gradient& cached) {
+  Gradient grad_desc = cached;
+  grad_desc.f = cached.f->copy();
+  grad_desc.df = cached.df->copy();
+  return grad_desc;
+}
+
+struct GradientCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, Gradient> gradients;
+};
+
+GradientCache& gradientCache() {
+  static GradientCache cache;
+  return cache;
+}
+
+} // namespace
+
 Gradient differentiate(std::shared_ptr<Graph>& graph) {
   Gradient grad_desc;
   // Take ownership of the graph
@@ -849,6 +938,20 @@ Gradient differentiate(std::shared_ptr<Graph>& graph) {
       "differentiate will mutate and destroy the graph, so it requires "
       "graph.use_count() == 1, but found %d",
       graph.use_count());
+
+  // See Note [Autodiff graph cache]
+  auto& cache = gradientCache();
+  const auto key = gradientCacheKey(graph);
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.gradients.find(key);
+    if (it != cache.gradients.end()) {
+      // Preserve the take-ownership contract of the miss path.
+      graph.reset();
+      return copyGradient(it->second);
+    }
+  }
+
   std::swap(graph, grad_desc.f);
   // XXX: Take care when handling outputs - they can be duplicated!
 
@@ -865,6 +968,14 @@ Gradient differentiate(std::shared_ptr<Graph>& graph) {
   // It's possible the we've cloned the same constants many times, so
   // de-duplicate them
   ConstantPooling(grad_desc.df);
+
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.gradients.size() < kGradientCacheMaxEntries &&
+        cache.gradients.count(key) == 0) {
+      cache.gradients.emplace(key, copyGradient(grad_desc));
+    }
+  }
   return grad_desc;
 }
 } // namespace jit
@@ -0,0 +1,191 @@
+#include <torch/csrc/jit/batching_executor.h>
+
+#include <c10/util/Exception.h>
+
+#include <exception>
+#include <utility>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Two calls can share a batch when they will take the same code path
+// through the graph: the same number of inputs, every input a tensor with
+// at least a batch dimension, matching dtype/device/trailing dimensions,
+// and a consistent batch size across the inputs of each call.
+bool batchable(const Stack& a, const Stack& b) {
+  if (a.size() != b.size() || a.empty()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (!a[i].isTensor() || !b[i].isTensor()) {
+      return false;
+    }
+    auto ta = a[i].toTensor();
+    auto tb = b[i].toTensor();
+    if (ta.dim() < 1 || tb.dim() < 1) {
+      return false;
+    }
+    if (ta.scalar_type() != tb.scalar_type() || ta.device() != tb.device()) {
+      return false;
+    }
+    if (!ta.sizes().slice(1).equals(tb.sizes().slice(1))) {
+      return false;
+    }
+    if (ta.size(0) != a[0].toTensor().size(0) ||
+        tb.size(0) != b[0].toTensor().size(0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BatchingExecutor::BatchingExecutor(
+    std::shared_ptr<Graph> graph,
+    BatchingExecutorOptions options)
+    : executor_(std::move(graph), /*optimize=*/true),
+      options_(options),
+      worker_([this] { workerLoop(); }) {}
+
+BatchingExecutor::~BatchingExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+std::future<Stack> BatchingExecutor::submit(Stack inputs) {
+  Request request;
+  request.inputs = std::move(inputs);
+  auto future = request.outputs.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AT_CHECK(!done_, "submit called on a destructed BatchingExecutor");
+    pending_.push_back(std::move(request));
+  }
+  cv_.notify_one();
+  return future;
+}
+
+void BatchingExecutor::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [&] { return done_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      if (done_) {
+        return;
+      }
+      continue;
+    }
+
+    // Wait a bounded time for more requests to arrive before running.
+    const auto deadline =
+        std::chrono::steady_clock::now() + options_.max_batch_delay;
+    while (!done_ && pending_.size() < options_.max_batch_size &&
+           cv_.wait_until(lock, deadline) != std::cv_status::timeout) {
+    }
+
+    // Take the oldest request and everything batchable with it; whatever
+    // is left starts the next batch.
+    std::vector<Request> batch;
+    std::vector<Request> rest;
+    batch.push_back(std::move(pending_.front()));
+    for (auto it = pending_.begin() + 1; it != pending_.end(); ++it) {
+      if (batch.size() < options_.max_batch_size &&
+          batchable(batch.front().inputs, it->inputs)) {
+        batch.push_back(std::move(*it));
+      } else {
+        rest.push_back(std::move(*it));
+      }
+    }
+    pending_ = std::move(rest);
+
+    lock.unlock();
+    runBatch(std::move(batch));
+    lock.lock();
+  }
+}
+
+void BatchingExecutor::runSingle(Request& request) {
+  try {
+    Stack stack = std::move(request.inputs);
+    executor_.run(stack);
+    request.outputs.set_value(std::move(stack));
+  } catch (...) {
+    request.outputs.set_exception(std::current_exception());
+  }
+}
+
+void BatchingExecutor::runBatch(std::vector<Request> batch) {
+  if (batch.size() == 1) {
+    runSingle(batch.front());
+    return;
+  }
+
+  // Per-request batch sizes, for slicing the outputs back apart.
+  std::vector<int64_t> splits;
+  int64_t total = 0;
+  for (auto& request : batch) {
+    splits.push_back(request.inputs[0].toTensor().size(0));
+    total += splits.back();
+  }
+
+  Stack stacked;
+  bool scattered = false;
+  try {
+    const size_t num_inputs = batch.front().inputs.size();
+    for (size_t i = 0; i < num_inputs; ++i) {
+      std::vector<at::Tensor> parts;
+      parts.reserve(batch.size());
+      for (auto& request : batch) {
+        parts.push_back(request.inputs[i].toTensor());
+      }
+      stacked.push_back(at::cat(parts, 0));
+    }
+    executor_.run(stacked);
+
+    // Scatter only if every output carries the batch dimension; graphs
+    // that reduce over the batch (or return non-tensors) cannot be
+    // batched this way and fall back below.
+    bool separable = true;
+    for (const auto& output : stacked) {
+      if (!output.isTensor() || output.toTensor().dim() < 1 ||
+          output.toTensor().size(0) != total) {
+        separable = false;
+        break;
+      }
+    }
+    if (separable) {
+      std::vector<Stack> outputs(batch.size());
+      for (const auto& output : stacked) {
+        auto tensor = output.toTensor();
+        int64_t offset = 0;
+        for (size_t j = 0; j < batch.size(); ++j) {
+          outputs[j].push_back(tensor.narrow(0, offset, splits[j]));
+          offset += splits[j];
+        }
+      }
+      for (size_t j = 0; j < batch.size(); ++j) {
+        batch[j].outputs.set_value(std::move(outputs[j]));
+      }
+      scattered = true;
+    }
+  } catch (...) {
+    // Fall through to the per-request path below: a batching-specific
+    // failure must not poison unrelated requests.
+  }
+
+  if (!scattered) {
+    for (auto& request : batch) {
+      runSingle(request);
+    }
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <ATen/core/stack.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/graph_executor.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+struct TORCH_API BatchingExecutorOptions {
+  // Maximum number of requests merged into one execution.
+  size_t max_batch_size = 32;
+  // How long the batching thread waits for additional requests before
+  // running a partial batch.
+  std::chrono::microseconds max_batch_delay{200};
+};
+
+// Merges many concurrent small inference calls against one graph into a
+// single execution. Calls are queued for up to max_batch_delay; compatible
+// inputs (same arity, dtype, device and trailing dimensions) are
+// concatenated along the batch dimension, the graph runs once, and the
+// outputs are sliced back to per-request futures. Requests that cannot be
+// batched, or graphs whose outputs do not carry the batch dimension, run
+// individually, so batching is purely a throughput optimization and never
+// changes results.
+struct TORCH_API BatchingExecutor {
+  explicit BatchingExecutor(
+      std::shared_ptr<Graph> graph,
+      BatchingExecutorOptions options = BatchingExecutorOptions());
+  ~BatchingExecutor();
+
+  BatchingExecutor(const BatchingExecutor&) = delete;
+  BatchingExecutor& operator=(const BatchingExecutor&) = delete;
+
+  // Enqueues one call's inputs. The future is fulfilled with the call's
+  // outputs (or the exception the execution raised) once a batch
+  // containing the call has run.
+  std::future<Stack> submit(Stack inputs);
+
+ private:
+  struct Request {
+    Stack inputs;
+    std::promise<Stack> outputs;
+  };
+
+  void workerLoop();
+  void runBatch(std::vector<Request> batch);
+  void runSingle(Request& request);
+
+  GraphExecutor executor_;
+  const BatchingExecutorOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Request> pending_;
+  bool done_ = false;
+  std::thread worker_;
+};
+
+} // namespace jit
+} // namespace torch
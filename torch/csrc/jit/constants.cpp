@@ -4,9 +4,109 @@
 #include <torch/csrc/jit/custom_operator.h>
 #include <torch/csrc/jit/operator.h>
 
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
 namespace torch {
 namespace jit {
 
+namespace {
+
+// Note [Constant tensor cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A serving process that loads many model variants materializes identical
+// constant tensors (quantization tables, positional encodings, ...) once
+// per module, since constant pooling deduplicates within a single graph
+// only. With PYTORCH_JIT_SHARE_CONSTANTS=1, tensor constants are instead
+// looked up in a process-wide content-addressed cache, so identical
+// constants across script::Module instances share one storage. The cache
+// holds weak references: it never pins a constant beyond the modules using
+// it, and dead entries are scrubbed on collision and when the cache grows.
+//
+// Constants are semantically immutable, so aliasing them across modules is
+// unobservable; the opt-in exists because code that mutates a "constant"
+// through an alias, while already broken within one graph after constant
+// pooling, would now be broken across modules.
+
+bool constantSharingEnabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("PYTORCH_JIT_SHARE_CONSTANTS");
+    return env != nullptr && env[0] == '1';
+  }();
+  return enabled;
+}
+
+size_t hashConstantTensor(const at::Tensor& tensor) {
+  // FNV-1a over the metadata and the raw bytes. Hashing runs once per
+  // constant insertion (module load), not per execution.
+  size_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](const char* data, size_t nbytes) {
+    for (size_t i = 0; i < nbytes; ++i) {
+      hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+    }
+  };
+  const auto dtype = tensor.scalar_type();
+  mix(reinterpret_cast<const char*>(&dtype), sizeof(dtype));
+  for (const auto size : tensor.sizes()) {
+    mix(reinterpret_cast<const char*>(&size), sizeof(size));
+  }
+  mix(
+      static_cast<const char*>(tensor.data_ptr()),
+      tensor.numel() * tensor.element_size());
+  return hash;
+}
+
+bool equalConstantTensors(const at::Tensor& a, const at::Tensor& b) {
+  return a.scalar_type() == b.scalar_type() && a.sizes().equals(b.sizes()) &&
+      std::memcmp(
+          a.data_ptr(),
+          b.data_ptr(),
+          a.numel() * a.element_size()) == 0;
+}
+
+at::Tensor dedupConstantTensor(at::Tensor tensor) {
+  if (!constantSharingEnabled()) {
+    return tensor;
+  }
+  // Only dense contiguous CPU constants participate; comparing device
+  // constants would need device round trips at load time.
+  if (tensor.device().type() != at::kCPU || tensor.is_sparse() ||
+      !tensor.is_contiguous() || tensor.numel() == 0) {
+    return tensor;
+  }
+
+  static std::mutex cache_mutex;
+  static std::unordered_multimap<size_t, at::WeakTensor> cache;
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  const size_t hash = hashConstantTensor(tensor);
+  auto range = cache.equal_range(hash);
+  for (auto it = range.first; it != range.second;) {
+    at::Tensor candidate = it->second.lock();
+    if (!candidate.defined()) {
+      it = cache.erase(it);
+      continue;
+    }
+    if (equalConstantTensors(candidate, tensor)) {
+      return candidate;
+    }
+    ++it;
+  }
+  if (cache.size() >= 4096) {
+    // Scrub entries whose tensors have died; the cap only bounds scrub
+    // frequency, the cache itself can grow with live constants.
+    for (auto it = cache.begin(); it != cache.end();) {
+      it = it->second.lock().defined() ? std::next(it) : cache.erase(it);
+    }
+  }
+  cache.emplace(hash, at::WeakTensor(tensor));
+  return tensor;
+}
+
+} // namespace
+
 // IValue -> Constant node
 Value* insertConstant(
     Graph& g,
@@ -28,6 +128,8 @@ Value* insertConstant(
     } else {
       AT_ASSERT(!ref.requires_grad());
     }
+    // See Note [Constant tensor cache].
+    ref = dedupConstantTensor(std::move(ref));
     n->output()->inferTypeFrom(
         ref); // note: before t_ because of std::move(ref)
     n->t_(attr::value, std::move(ref));
@@ -20,12 +20,19 @@
 #include <ATen/ATen.h>
 #include <c10/util/Optional.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace torch {
@@ -472,6 +479,64 @@ void GraphEncoder::EncodeTensor(
   }
 }
 
+// Note [Differential checkpoints]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Jobs that checkpoint frequently rewrite a lot of bytes that did not
+// change: frozen backbones during fine-tuning, embedding tables with
+// sparse updates, and adapter-style setups where only a small parameter
+// subset trains are mostly identical from one save to the next.
+// ExportModuleDelta exploits this by hashing every tensor payload in
+// fixed-size chunks as it streams into the container and comparing the
+// hashes against the manifest of the previous save. If any chunk of a
+// record is unchanged, the full payload is not rewritten; the TensorDef
+// instead carries a TensorDeltaDef naming the container that physically
+// stores the full payload, plus the changed chunks, concatenated, in a
+// local "deltas/<id>" record.
+//
+// Two properties keep reads cheap and the chain bounded:
+//  - a delta always patches a *fully stored* record. The manifest
+//    tracks, per record, which container last wrote the complete
+//    payload and the chunk hashes of those stored bytes, and current
+//    content is diffed against that stored baseline directly -- not
+//    against the previous delta. Reconstruction therefore touches at
+//    most two files per tensor no matter how many saves are chained.
+//  - the chain is bounded at write time: once depth would exceed
+//    max_chain_depth, ExportModuleDelta ignores the manifest and writes
+//    a full checkpoint, so at most max_chain_depth older containers
+//    ever have to be retained for a file to stay loadable.
+//
+// The manifest is produced as a side effect of writing (full saves
+// included), so taking a delta never re-reads the previous checkpoint.
+// import.cpp resolves a TensorDeltaDef by reading the base record from
+// base_path and overlaying the changed chunks; see loadTensor there.
+
+// 1 MiB chunks: small enough that a touched embedding row does not
+// force the whole table out, large enough that the per-chunk metadata
+// (one hash in memory, one bool in the delta index) stays negligible.
+constexpr int64_t kDeltaChunkSize = 1 << 20;
+
+uint64_t deltaChunkHash(const char* data, size_t size) {
+  // FNV-1a
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    h = (h ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+std::vector<uint64_t> deltaChunkHashes(
+    const char* data,
+    uint64_t size,
+    int64_t chunk_size) {
+  std::vector<uint64_t> hashes;
+  hashes.reserve((size + chunk_size - 1) / chunk_size);
+  for (uint64_t off = 0; off < size; off += chunk_size) {
+    hashes.push_back(deltaChunkHash(
+        data + off, std::min<uint64_t>(chunk_size, size - off)));
+  }
+  return hashes;
+}
+
 // this is a serializer class which saves script modules to pt files. the
 // content of the file is written using PyTorchStreamWriter, for details please
 // check caffe2/serialize/inline_container.h. all the records except the last
@@ -488,6 +553,15 @@ class ScriptModuleSerializer final {
       const script::Module& module,
       const script::ExtraFilesMap& extra_files = script::ExtraFilesMap());
 
+  // differential flavor; see Note [Differential checkpoints]. `delta_base`
+  // may be nullptr (full checkpoint); `delta_manifest` receives the chunk
+  // hashes of this save and must outlive the call.
+  void serialize(
+      const script::Module& module,
+      const script::ExtraFilesMap& extra_files,
+      const CheckpointManifest* delta_base,
+      CheckpointManifest* delta_manifest);
+
  private:
   void convertModel(
       const script::Module& module,
@@ -498,13 +572,27 @@ class ScriptModuleSerializer final {
   // returns the offset into the tensor table
   size_t addTensor(const at::Tensor& tensor);
 
-  // write the content of the tensor to the file/stream, and save the
-  // offset in the storageMap_
+  // a tensor record ready to be streamed into the container; `guard` keeps
+  // the (possibly device-to-host copied) storage alive until the record has
+  // been written
+  struct PendingRecord {
+    std::string name;
+    at::Tensor guard;
+    const void* data;
+    size_t size;
+    // set for delta records, whose bytes are gathered into a buffer the
+    // guard tensor does not cover
+    std::shared_ptr<std::string> owned;
+  };
+
+  // convert the metadata of the tensor and hand its payload to `push` for
+  // writing, deduplicating shared storages through storageMap
   void convertAndWriteTensor(
       size_t tensor_id,
       const at::Tensor& tensor,
       torch::TensorDef* tensor_proto,
-      std::unordered_map<const void*, std::string>& storageMap);
+      std::unordered_map<const void*, std::string>& storageMap,
+      const std::function<void(PendingRecord)>& push);
 
   // dump all the tensors in the tensorTable_ to a ModelDef (metadata) and
   // the file/stream (the content), assuming all the information of the
@@ -531,6 +619,10 @@ class ScriptModuleSerializer final {
   std::ofstream ofs_;
   caffe2::serialize::PyTorchStreamWriter writer_;
 
+  // set only for differential saves; see Note [Differential checkpoints]
+  const CheckpointManifest* delta_base_ = nullptr;
+  CheckpointManifest* delta_manifest_ = nullptr;
+
   // all tensors that will be stored
   std::vector<at::Tensor> tensor_table_;
 
@@ -579,6 +671,16 @@ void ScriptModuleSerializer::serialize(
   writer_.writeEndOfFile();
 }
 
+void ScriptModuleSerializer::serialize(
+    const script::Module& module,
+    const script::ExtraFilesMap& extra_files,
+    const CheckpointManifest* delta_base,
+    CheckpointManifest* delta_manifest) {
+  delta_base_ = delta_base;
+  delta_manifest_ = delta_manifest;
+  serialize(module, extra_files);
+}
+
 void ScriptModuleSerializer::writeLibs(torch::ModelDef* model_def) {
   auto lib_def = model_def->mutable_libs();
   std::ostringstream lib_stream;
@@ -639,6 +741,9 @@ void ScriptModuleSerializer::convertModel(
   model_def->set_producer_version("1.0"); // TODO: set the producer version
                                           // using appropriate function call
   model_def->set_proto_version(torch::ProtoVersion::PROTO_VERSION_NEWEST);
+  if (delta_manifest_) {
+    model_def->set_delta_depth(delta_manifest_->depth);
+  }
 
   convertModule(
       module, "", writer_.archiveName(), model_def->mutable_main_module());
@@ -665,7 +770,8 @@ void ScriptModuleSerializer::convertAndWriteTensor(
     size_t tensor_id,
     const at::Tensor& tensor,
     torch::TensorDef* tensor_proto,
-    std::unordered_map<const void*, std::string>& storageMap) {
+    std::unordered_map<const void*, std::string>& storageMap,
+    const std::function<void(PendingRecord)>& push) {
   for (auto d : tensor.sizes()) {
     tensor_proto->add_dims(d);
   }
@@ -702,7 +808,73 @@ void ScriptModuleSerializer::convertAndWriteTensor(
           record_size);
     }
     std::string name = "tensors/" + std::to_string(tensor_id);
-    writer_.writeRecord(name, storage_tensor.storage().data(), record_size);
+    const char* bytes =
+        static_cast<const char*>(storage_tensor.storage().data());
+    bool stored_as_delta = false;
+    if (delta_manifest_) {
+      // See Note [Differential checkpoints]
+      const int64_t chunk_size = delta_manifest_->chunk_size;
+      std::vector<uint64_t> hashes =
+          deltaChunkHashes(bytes, record_size, chunk_size);
+      const CheckpointManifest::RecordInfo* base_info = nullptr;
+      if (delta_base_) {
+        auto base_it = delta_base_->records.find(name);
+        if (base_it != delta_base_->records.end() &&
+            base_it->second.size == record_size) {
+          base_info = &base_it->second;
+        }
+      }
+      if (base_info) {
+        AT_ASSERT(base_info->chunk_hashes.size() == hashes.size());
+        std::vector<bool> changed(hashes.size());
+        size_t num_changed = 0;
+        for (size_t i = 0; i < hashes.size(); ++i) {
+          changed[i] = hashes[i] != base_info->chunk_hashes[i];
+          num_changed += changed[i] ? 1 : 0;
+        }
+        if (num_changed < hashes.size()) {
+          auto* delta = tensor_proto->mutable_delta();
+          delta->set_base_path(base_info->path);
+          delta->set_chunk_size(chunk_size);
+          for (size_t i = 0; i < changed.size(); ++i) {
+            delta->add_chunk_changed(changed[i]);
+          }
+          if (num_changed > 0) {
+            auto buffer = std::make_shared<std::string>();
+            buffer->reserve(num_changed * chunk_size);
+            for (size_t i = 0; i < changed.size(); ++i) {
+              if (!changed[i]) {
+                continue;
+              }
+              const uint64_t off = i * chunk_size;
+              buffer->append(
+                  bytes + off, std::min<uint64_t>(chunk_size, record_size - off));
+            }
+            std::string delta_name = "deltas/" + std::to_string(tensor_id);
+            delta->mutable_delta_data()->set_key(delta_name);
+            push({delta_name,
+                  storage_tensor,
+                  buffer->data(),
+                  buffer->size(),
+                  buffer});
+          }
+          // the full payload still lives where the base manifest says it
+          // does; the next save diffs against those same stored bytes
+          delta_manifest_->records[name] = *base_info;
+          stored_as_delta = true;
+        }
+      }
+      if (!stored_as_delta) {
+        CheckpointManifest::RecordInfo info;
+        info.path = delta_manifest_->path;
+        info.size = record_size;
+        info.chunk_hashes = std::move(hashes);
+        delta_manifest_->records[name] = std::move(info);
+      }
+    }
+    if (!stored_as_delta) {
+      push({name, storage_tensor, bytes, record_size});
+    }
     storage_it = storageMap.insert({key, name}).first;
   }
 
@@ -717,10 +889,72 @@ void ScriptModuleSerializer::convertAndWriteTensor(
 
 void ScriptModuleSerializer::writeTensorTable(torch::ModelDef* model_def) {
   std::unordered_map<const void*, std::string> storageMap;
+
+  // Pipeline the tensor table: this thread converts tensors (including any
+  // device-to-host copies) while a writer thread streams finished records --
+  // checksumming included -- into the container. Records enter the queue in
+  // table order and are written by a single consumer, so the resulting
+  // archive is byte-identical to the sequential writer's.
+  constexpr size_t kMaxQueuedRecords = 4;
+  std::deque<PendingRecord> queue;
+  std::mutex mutex;
+  std::condition_variable not_empty;
+  std::condition_variable not_full;
+  bool done = false;
+  std::exception_ptr write_error;
+
+  std::thread writer_thread([&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!done || !queue.empty()) {
+      if (queue.empty()) {
+        not_empty.wait(lock);
+        continue;
+      }
+      PendingRecord record = std::move(queue.front());
+      queue.pop_front();
+      not_full.notify_one();
+      lock.unlock();
+      try {
+        writer_.writeRecord(record.name, record.data, record.size);
+      } catch (...) {
+        lock.lock();
+        write_error = std::current_exception();
+        done = true;
+        queue.clear();
+        not_full.notify_all();
+        break;
+      }
+      lock.lock();
+    }
+  });
+
+  auto push = [&](PendingRecord record) {
+    std::unique_lock<std::mutex> lock(mutex);
+    not_full.wait(lock, [&] {
+      return queue.size() < kMaxQueuedRecords || write_error;
+    });
+    if (write_error) {
+      // the error is rethrown below, after the writer thread is joined
+      return;
+    }
+    queue.push_back(std::move(record));
+    not_empty.notify_one();
+  };
+
   size_t tensor_id = 0;
   for (const at::Tensor& t : tensor_table_) {
     auto* tensor_proto = model_def->add_tensors();
-    convertAndWriteTensor(tensor_id++, t, tensor_proto, storageMap);
+    convertAndWriteTensor(tensor_id++, t, tensor_proto, storageMap, push);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  not_empty.notify_one();
+  writer_thread.join();
+  if (write_error) {
+    std::rethrow_exception(write_error);
   }
 }
 
@@ -1033,5 +1267,27 @@ void ExportModule(
   serializer.serialize(module, extra_files);
 }
 
+CheckpointManifest ExportModuleDelta(
+    const script::Module& module,
+    const std::string& filename,
+    const CheckpointManifest& base,
+    const script::ExtraFilesMap& extra_files,
+    int64_t max_chain_depth) {
+  // See Note [Differential checkpoints]. The chain is bounded here, at
+  // write time: a manifest that is empty, was hashed with a different
+  // chunk size, or has already accumulated max_chain_depth deltas forces
+  // a full, self-contained checkpoint.
+  const bool write_delta = !base.path.empty() &&
+      base.chunk_size == kDeltaChunkSize && base.depth + 1 <= max_chain_depth;
+  CheckpointManifest next;
+  next.path = filename;
+  next.depth = write_delta ? base.depth + 1 : 0;
+  next.chunk_size = kDeltaChunkSize;
+  ScriptModuleSerializer serializer(filename);
+  serializer.serialize(
+      module, extra_files, write_delta ? &base : nullptr, &next);
+  return next;
+}
+
 } // namespace jit
 } // namespace torch
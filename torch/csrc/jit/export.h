@@ -48,5 +48,45 @@ TORCH_API void ExportModule(
     const std::string& filename,
     const script::ExtraFilesMap& metadata = script::ExtraFilesMap());
 
+// Chunk hashes of the tensor records of a previously written checkpoint,
+// used by ExportModuleDelta to decide which payload bytes actually have
+// to be rewritten. The manifest is produced as a side effect of writing
+// (payloads are hashed as they stream into the container), so taking a
+// differential checkpoint never re-reads the previous file from disk.
+// See Note [Differential checkpoints] in export.cpp.
+struct CheckpointManifest {
+  struct RecordInfo {
+    // container that physically stores the full payload of this record
+    std::string path;
+    // payload size in bytes
+    uint64_t size = 0;
+    // hash of each chunk_size-byte chunk of the stored payload
+    std::vector<uint64_t> chunk_hashes;
+  };
+  // container this manifest describes; empty means "no usable base", and
+  // the next export writes a full checkpoint
+  std::string path;
+  // differential checkpoints written since the last full one
+  int64_t depth = 0;
+  // chunk size, in bytes, the hashes below were computed with
+  int64_t chunk_size = 0;
+  // record key ("tensors/<id>") -> where/what the stored payload is
+  std::unordered_map<std::string, RecordInfo> records;
+};
+
+// Writes `module` to `filename`, storing only the tensor payload chunks
+// that changed relative to the checkpoint described by `base`, and
+// returns the manifest to pass to the next save. Passing a
+// default-constructed manifest -- or reaching max_chain_depth -- writes
+// a full, self-contained checkpoint instead. Containers referenced by
+// the returned manifest must stay on disk for the produced file to
+// remain loadable.
+TORCH_API CheckpointManifest ExportModuleDelta(
+    const script::Module& module,
+    const std::string& filename,
+    const CheckpointManifest& base,
+    const script::ExtraFilesMap& extra_files = script::ExtraFilesMap(),
+    int64_t max_chain_depth = 8);
+
 } // namespace jit
 } // namespace torch
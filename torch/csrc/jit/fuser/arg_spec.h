@@ -1,5 +1,6 @@
 #pragma once
 #include <ATen/ATen.h>
+#include <ATen/core/fast_math_mode.h>
 #include <ATen/core/functional.h> // fmap
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #include <torch/csrc/jit/fuser/tensor_desc.h>
@@ -18,9 +19,14 @@ namespace fuser {
 // Note: the device to run on is included in the arg spec because kernels
 //  are compiled per-device.
 struct TORCH_API ArgSpec {
+  // The fast math tier (see Note [Fast math tier]) is captured at launch
+  // time: codegen emits different bodies per tier, so kernels compiled
+  // under either tier must key separately.
   ArgSpec(at::TensorList inputs, const int _device)
       : descs_{c10::fmap<TensorDesc>(inputs)},
-        hash_code_{torch::get_hash(_device, inputs.size(), descs_)},
+        fast_math_{at::FastMathMode::is_enabled()},
+        hash_code_{
+            torch::get_hash(_device, inputs.size(), descs_, fast_math_)},
         device_{_device} {}
 
   // (Common) hash function
@@ -30,7 +36,8 @@ struct TORCH_API ArgSpec {
 
   // Comparators
   bool operator==(const ArgSpec& other) const {
-    return (descs_ == other.descs_ && device_ == other.device_);
+    return (descs_ == other.descs_ && device_ == other.device_ &&
+            fast_math_ == other.fast_math_);
   }
 
   bool operator!=(const ArgSpec& spec) const {
@@ -50,6 +57,7 @@ struct TORCH_API ArgSpec {
 
  private:
   std::vector<TensorDesc> descs_;
+  bool fast_math_;
   size_t hash_code_;
   int device_;
 };
@@ -0,0 +1,164 @@
+#include <torch/csrc/jit/fuser/code_cache.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace jit {
+namespace fuser {
+
+// Note [Fusion disk code cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Fused kernels are compiled per process: a fleet of identical workers on
+// one host pays the NVRTC compilation cost once per worker at every deploy,
+// for byte-identical kernel source. When PYTORCH_FUSION_CODE_CACHE names a
+// writable directory, compiled artifacts are published there keyed by a
+// content hash of everything they depend on, so the first worker to compile
+// a kernel warms all the others.
+//
+// Concurrency: writers serialize on an flock'd lock file per key and
+// publish by writing to a process-private temporary file and rename()ing
+// it into place, which is atomic on POSIX filesystems - readers observe
+// either no file or a complete artifact, never a partial write. Readers
+// take a shared lock so they cannot overlap an in-flight publish on
+// filesystems where rename atomicity is weaker. All failures degrade to
+// compiling locally; the cache is never load-bearing. File locking is not
+// portable to Windows, where the cache stays disabled.
+
+namespace {
+
+// FNV-1a, spelled out rather than std::hash so keys are stable across
+// processes and builds.
+uint64_t fnv1a(const std::string& data) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+#ifndef _WIN32
+
+std::string cacheDir() {
+  static const std::string dir = []() -> std::string {
+    const char* env = std::getenv("PYTORCH_FUSION_CODE_CACHE");
+    return (env != nullptr && env[0] != '\0') ? std::string(env)
+                                              : std::string();
+  }();
+  return dir;
+}
+
+std::string artifactPath(const std::string& key) {
+  return cacheDir() + "/" + key;
+}
+
+// RAII flock on <path>.lock. A failed acquisition (e.g. unwritable
+// directory) leaves fd_ at -1 and the caller falls back to compilation.
+struct FileLock {
+  FileLock(const std::string& path, int operation) {
+    fd_ = open((path + ".lock").c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd_ >= 0 && flock(fd_, operation) != 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+  }
+  ~FileLock() {
+    if (fd_ >= 0) {
+      flock(fd_, LOCK_UN);
+      close(fd_);
+    }
+  }
+  bool held() const {
+    return fd_ >= 0;
+  }
+  int fd_ = -1;
+};
+
+#endif // !_WIN32
+
+} // namespace
+
+bool codeCacheEnabled() {
+#ifndef _WIN32
+  return !cacheDir().empty();
+#else
+  return false;
+#endif
+}
+
+std::string codeCacheKey(
+    const std::string& tag,
+    const std::string& contents) {
+  std::ostringstream key;
+  key << tag << "-" << std::hex << fnv1a(contents);
+  return key.str();
+}
+
+bool codeCacheLookup(const std::string& key, std::vector<char>& blob) {
+#ifndef _WIN32
+  if (!codeCacheEnabled()) {
+    return false;
+  }
+  const auto path = artifactPath(key);
+  FileLock lock(path, LOCK_SH);
+  if (!lock.held()) {
+    return false;
+  }
+  std::ifstream artifact(path, std::ios::binary | std::ios::ate);
+  if (!artifact) {
+    return false;
+  }
+  const auto size = artifact.tellg();
+  if (size <= 0) {
+    return false;
+  }
+  blob.resize(size);
+  artifact.seekg(0);
+  artifact.read(blob.data(), size);
+  return static_cast<bool>(artifact);
+#else
+  return false;
+#endif
+}
+
+void codeCacheStore(const std::string& key, const char* data, size_t size) {
+#ifndef _WIN32
+  if (!codeCacheEnabled() || size == 0) {
+    return;
+  }
+  const auto path = artifactPath(key);
+  FileLock lock(path, LOCK_EX);
+  if (!lock.held()) {
+    return;
+  }
+  const auto tmp = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream artifact(tmp, std::ios::binary | std::ios::trunc);
+    if (!artifact) {
+      return;
+    }
+    artifact.write(data, size);
+    if (!artifact) {
+      std::remove(tmp.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+  }
+#endif
+}
+
+} // namespace fuser
+} // namespace jit
+} // namespace torch
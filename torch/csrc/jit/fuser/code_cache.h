@@ -0,0 +1,38 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace fuser {
+
+// Persistent on-disk store for compiled fusion artifacts, shared by every
+// process on the host; see Note [Fusion disk code cache] in code_cache.cpp.
+// Enabled by pointing PYTORCH_FUSION_CODE_CACHE at a writable directory.
+
+TORCH_API bool codeCacheEnabled();
+
+// Stable content-hash key for an artifact. `tag` names the artifact kind
+// (e.g. "ptx") and becomes part of the filename; `contents` must include
+// everything the artifact depends on (source, architecture, compiler
+// version) so stale entries are never picked up.
+TORCH_API std::string codeCacheKey(
+    const std::string& tag,
+    const std::string& contents);
+
+// Fills `blob` and returns true if an artifact for `key` exists.
+TORCH_API bool codeCacheLookup(const std::string& key, std::vector<char>& blob);
+
+// Atomically publishes `blob` under `key`. Failures (full disk, read-only
+// cache directory) are silently ignored; the cache is an optimization.
+TORCH_API void codeCacheStore(
+    const std::string& key,
+    const char* data,
+    size_t size);
+
+} // namespace fuser
+} // namespace jit
+} // namespace torch
@@ -1,6 +1,7 @@
 #include <torch/csrc/jit/fuser/codegen.h>
 
 #include <ATen/ATen.h>
+#include <ATen/core/fast_math_mode.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/jit/code_template.h>
 #include <torch/csrc/jit/fuser/compiler.h>
@@ -29,6 +30,36 @@ size_t ${tensor}_dimIndex${d} = ${tensor}_linearIndex ${mod_sizes};
 ${tensor}_offset += ${tensor}_dimIndex${d} ${times_stride};
 )");
 
+// Note [Fusing the innermost reduction]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A fusion group whose sole output is an aten::sum over the innermost
+// dimension compiles to a kernel whose index space is the *reduced* output
+// space: linearIndex enumerates output elements, and each one runs the loop
+// below over the reduced dimension, evaluating the fused elementwise
+// producers per element and accumulating - no intermediate is ever
+// materialized. Because map size enumeration is row-major with the last
+// dimension fastest, the producers' element index is simply
+// linearIndex * reductionSize + rIdx, and the existing per-tensor offset
+// decomposition applies to it unchanged.
+//
+// Parallelism follows the first stage of TensorIteratorReduce's scheme:
+// threads split the non-reduced dimensions (one output element each) and
+// each accumulates its row serially. The second stage - splitting the
+// reduced dimension itself - is not needed here since only innermost-dim
+// reductions of rank >= 2 tensors are fused, which have ample outer
+// parallelism. reductionSize is a runtime argument (appended after the
+// outputs) so compiled kernels are reused across shapes, like the
+// pointwise ones.
+static auto reduction_loop = CodeTemplate(R"(
+${acc_type} ${acc} = 0;
+for (IndexType rIdx = 0; rIdx < reductionSize; ++rIdx) {
+  IndexType fullIndex = linearIndex * reductionSize + rIdx;
+  ${loopOffsets}
+  ${compute}
+  ${acc} += ${operand};
+}
+)");
+
 static std::string valueName(const Value* n) {
   return "n" + std::to_string(n->unique());
 }
@@ -180,6 +211,9 @@ static std::string encodeRHS(const Node* n) {
   static std::unordered_map<NodeKind, RHSTemplate> simple_map_ops = {
       // unary
       {aten::_cast_Float, "static_cast<float>(${0})"},
+      // In-kernel compute is float even for half tensors; the conversion
+      // happens in the output's __float2half store, so the map is identity.
+      {aten::_cast_Half, "(${0})"},
       {aten::abs, "fabs(${0})"},
       {aten::sigmoid, {"1.f / (1.f + expf(-${0}))", "1. / (1. + exp(-${0}))"}},
       {aten::relu, "${0} < 0 ? 0.f : ${0} "},
@@ -281,6 +315,22 @@ static std::string encodeRHS(const Node* n) {
     const char* str = nullptr;
     if (outtype == at::kFloat) {
       str = templ.for_float;
+      // See Note [Fast math tier] in ATen/core/fast_math_mode.h: while
+      // the tier is active, float transcendentals compile to the
+      // reduced-accuracy helpers defined in the kernel preambles. The
+      // tier is part of the ArgSpec, so kernels generated under either
+      // tier coexist in the specialization cache.
+      if (at::FastMathMode::is_enabled()) {
+        static const std::unordered_map<NodeKind, const char*> fast_map_ops = {
+            {aten::sigmoid, "fast_sigmoidf(${0})"},
+            {aten::exp, "fast_expf(${0})"},
+            {aten::tanh, "fast_tanhf(${0})"},
+        };
+        auto fast_it = fast_map_ops.find(n->kind());
+        if (fast_it != fast_map_ops.end()) {
+          str = fast_it->second;
+        }
+      }
     } else {
       str = templ.for_double;
     }
@@ -292,12 +342,14 @@ static std::string encodeRHS(const Node* n) {
 static void emitIndexingFor(
     std::ostream& out,
     const std::string& tensor,
+    const std::string& index,
     const int ndim,
     const bool last_is_cont) {
   TemplateEnv env;
   env.s("tensor", tensor);
+  env.s("index", index);
   out << format("IndexType ${tensor}_offset = 0;\n", env);
-  out << format("IndexType ${tensor}_linearIndex = linearIndex;\n", env);
+  out << format("IndexType ${tensor}_linearIndex = ${index};\n", env);
   for (int d = ndim - 1; d >= 0; --d) {
     env.d("d", d);
     env.s("mod_sizes", d > 0 ? format("% ${tensor}.sizes[${d}]", env) : "");
@@ -319,20 +371,29 @@ std::string generateKernel(
     const Graph& graph,
     const std::vector<std::pair<const Value*, const c10::optional<TensorDesc>>>& inputs,
     const std::vector<std::pair<const Value*, const TensorDesc>>& outputs,
-    const bool use_cuda) {
+    const bool use_cuda,
+    const Node* reduction) {
   TemplateEnv env;
   env.s("kernelName", name);
   env.s(
       "IndexType",
       "unsigned int"); // Note: not uint32_t to avoid including cstdint
 
+  const bool has_reduction = (reduction != nullptr);
+
   std::stringstream body;
+  // Loads and elementwise computation; for reduction kernels this is the
+  // loop body and the input offset decomposition moves with it (computed
+  // from fullIndex rather than linearIndex).
+  // See Note [Fusing the innermost reduction].
+  std::stringstream compute;
   std::stringstream tensorOffsets;
+  std::stringstream loopOffsets;
   std::vector<std::string> formals;
   std::vector<std::string> argument_loads;
 
   // Lambda for writing arguments
-  auto emitFormal = [&](const Value* n, const TensorDesc& desc) {
+  auto emitFormal = [&](const Value* n, const TensorDesc& desc, bool is_input) {
     env.d(
         "formal_index",
         formals.size() +
@@ -342,7 +403,13 @@ std::string generateKernel(
           std::to_string(
               formals.size()); // can't be unique() because Param may be an output
       const auto nDim = desc.nDim();
-      emitIndexingFor(tensorOffsets, tensor, nDim, desc.lastIsContiguous());
+      const bool in_loop = has_reduction && is_input;
+      emitIndexingFor(
+          in_loop ? loopOffsets : tensorOffsets,
+          tensor,
+          in_loop ? "fullIndex" : "linearIndex",
+          nDim,
+          desc.lastIsContiguous());
       env.s("tensor", tensor);
       env.d("nDim", nDim);
       env.s("scalar_type", scalarTypeName(desc.scalar_type));
@@ -377,7 +444,7 @@ std::string generateKernel(
   // Writes input parameters
   for (const auto& input : inputs) {
     if (input.second.has_value()){
-      emitFormal(input.first, *input.second);
+      emitFormal(input.first, *input.second, /*is_input=*/true);
     } else {
       emitScalarFormal(input.first);
     }
@@ -385,7 +452,7 @@ std::string generateKernel(
 
   // Writes output parameters
   for (const auto& output : outputs) {
-    emitFormal(output.first, output.second);
+    emitFormal(output.first, output.second, /*is_input=*/false);
   }
 
   // Acquires input values
@@ -418,7 +485,7 @@ std::string generateKernel(
       env.s("access", format("s${formal}", env));
       env.s("lhs_type", variableType(input.first->type()));
     }
-    body << format("${lhs_type} ${node} = ${access};\n", env);
+    compute << format("${lhs_type} ${node} = ${access};\n", env);
   }
 
   bool has_random = false;
@@ -436,6 +503,18 @@ std::string generateKernel(
       continue;
     if (n->mustBeNone())
       continue;
+    // The reduction node is emitted specially below; its non-scalar constant
+    // arguments (e.g. the int[] dim list) have no C++ rendering and are only
+    // consumed by it.
+    if (n == reduction)
+      continue;
+    if (n->kind() == prim::Constant) {
+      const auto kind = n->output()->type()->kind();
+      if (kind != TypeKind::IntType && kind != TypeKind::FloatType &&
+          kind != TypeKind::BoolType) {
+        continue;
+      }
+    }
     if (n->kind() == aten::rand_like) {
       AT_ASSERT(use_cuda);
       has_random = true;
@@ -464,7 +543,30 @@ std::string generateKernel(
       env.s("lhs_type", variableType(n->output()->type()));
     }
 
-    body << format("${lhs_type} ${node} = ${rhs};\n", env);
+    compute << format("${lhs_type} ${node} = ${rhs};\n", env);
+  }
+
+  // Assembles the kernel body. Pointwise kernels evaluate the computation
+  // once per index; reduction kernels wrap it in the accumulation loop.
+  // See Note [Fusing the innermost reduction].
+  if (has_reduction) {
+    const auto out_scalar_type = reduction->output()
+                                     ->type()
+                                     ->expect<c10::DimensionedTensorType const>()
+                                     ->scalarType();
+    env.s("acc", valueName(reduction->output()));
+    env.s("acc_type", calcScalarTypeName(out_scalar_type));
+    env.s(
+        "operand",
+        typeCastedValueName(
+            reduction->input(0)->type(),
+            out_scalar_type,
+            valueName(reduction->input(0))));
+    env.s("loopOffsets", loopOffsets.str());
+    env.s("compute", compute.str());
+    body << reduction_loop.format(env);
+  } else {
+    body << compute.str();
   }
 
   // Generates writes to output tensors
@@ -485,6 +587,15 @@ std::string generateKernel(
     }
   }
 
+  // The reduced dimension's length is a runtime argument, appended after the
+  // outputs, so kernels are shape-polymorphic like the pointwise ones.
+  if (has_reduction) {
+    env.d("formal_index", formals.size() + 1);
+    formals.push_back("IndexType reductionSize");
+    argument_loads.push_back(
+        format("*static_cast<IndexType*>(args[${formal_index}])", env));
+  }
+
   // Includes headers
   // Note: CUDA kernels support halfs and random generation, CPU kernels do not
   if (has_half_tensor) {
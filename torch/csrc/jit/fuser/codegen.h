@@ -17,12 +17,16 @@ namespace fuser {
 
 // Creates a CPU or CUDA kernel for the given graph.
 // Returns the C++ or CUDA string implementing the kernel.
+// If reduction is non-null it is the aten::sum node that is the graph's sole
+// output, and the kernel accumulates over the innermost dimension instead of
+// mapping one element per index; see Note [Fusing the innermost reduction].
 TORCH_API std::string generateKernel(
     const std::string& name,
     const Graph& graph,
     const std::vector<std::pair<const Value*, const c10::optional<TensorDesc>>>& inputs,
     const std::vector<std::pair<const Value*, const TensorDesc>>& outputs,
-    const bool use_cuda);
+    const bool use_cuda,
+    const Node* reduction = nullptr);
 
 } // namespace fuser
 } // namespace jit
@@ -278,6 +278,18 @@ std::shared_ptr<FusedKernel> compileKernel(
 
   PropagateInputShapes(graph);
 
+  // A group whose sole output is an innermost-dimension sum compiles into a
+  // reduction kernel; see Note [Fusing the innermost reduction] in codegen.cpp.
+  // The graph fuser only forms such groups with the sum as the single output.
+  const Node* reduction = nullptr;
+  for (const Value* o : graph->outputs()) {
+    if (o->node()->matches(
+            "aten::sum(Tensor self, int[] dim, bool keepdim) -> Tensor")) {
+      AT_ASSERT(graph->outputs().size() == 1);
+      reduction = o->node();
+    }
+  }
+
   // Creates chunk and flattened input descriptions
   std::vector<PartitionDesc> chunk_desc;
   std::vector<std::pair<const Value*, const c10::optional<TensorDesc>>> flat_inputs;
@@ -314,6 +326,10 @@ std::shared_ptr<FusedKernel> compileKernel(
     if (o->node()->kind() == prim::FusedConcat) {
       sizes.at(o->node()->i(attr::dim)) *= o->node()->inputs().size();
     }
+    if (o->node() == reduction) {
+      // The reduced (innermost) dimension is summed away (keepdim=false).
+      sizes.pop_back();
+    }
     auto scalar_type = o->type()->expect<c10::DimensionedTensorType const>()->scalarType();
     auto type = CompleteTensorType::create(scalar_type, device, sizes);
     output_desc.emplace_back(type);
@@ -339,7 +355,7 @@ std::shared_ptr<FusedKernel> compileKernel(
   const bool use_cuda = device.is_cuda();
   const std::string name = "kernel_" + std::to_string(next_kernel_id++);
   std::string code =
-      generateKernel(name, *graph, flat_inputs, flat_outputs, use_cuda);
+      generateKernel(name, *graph, flat_inputs, flat_outputs, use_cuda, reduction);
   const FusedKernelConstructor& kernel_ctor =
       getConstructor(use_cuda ? at::DeviceType::CUDA : at::DeviceType::CPU);
   return kernel_ctor(
@@ -350,7 +366,8 @@ std::shared_ptr<FusedKernel> compileKernel(
       output_desc,
       chunk_desc,
       concat_desc,
-      spec.hasRandom());
+      spec.hasRandom(),
+      reduction != nullptr);
 }
 
 } // namespace fuser
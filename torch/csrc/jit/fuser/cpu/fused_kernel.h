@@ -24,7 +24,8 @@ struct TORCH_API FusedKernelCPU : public ::torch::jit::fuser::FusedKernel {
       std::vector<TensorDesc> output_desc,
       std::vector<PartitionDesc> chunk_desc,
       std::vector<PartitionDesc> concat_desc,
-      bool has_random);
+      bool has_random,
+      bool has_reduction);
 
   at::Backend backend() const override {
     return at::Backend::CPU;
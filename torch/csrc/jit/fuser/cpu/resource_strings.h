@@ -51,19 +51,60 @@ float fracf(float x) {
   return x - truncf(x);
 }
 
+// Reduced-accuracy variants for the fast math tier (see Note
+// [Fast math tier] in ATen/core/fast_math_mode.h). The definitions
+// mirror ATen/native/cpu/FastMath.h so eager and fused results match.
+float fast_expf(float x) {
+  const float t = x * 1.442695041f;
+  if (t <= -126.0f) return 0.0f;
+  if (t >= 128.0f) return INFINITY;
+  const float fi = floorf(t);
+  const float f = t - fi;
+  const float p =
+      1.0f + f * (0.693147180f + f * (0.240226507f + f * 0.066626312f));
+  union { uint32_t i; float f32; } scale;
+  scale.i = (uint32_t)(((int32_t)fi + 127) << 23);
+  return p * scale.f32;
+}
+
+float fast_sigmoidf(float x) {
+  return 1.0f / (1.0f + fast_expf(-x));
+}
+
+float fast_tanhf(float x) {
+  if (x > 9.0f) return 1.0f;
+  if (x < -9.0f) return -1.0f;
+  const float e = fast_expf(2.0f * x);
+  return (e - 1.0f) / (e + 1.0f);
+}
+
 ${type_declarations}
 
-#define OMP_THRESHOLD 100000
+// The outer loop hands out cache-sized chunks to the OpenMP threads and the
+// inner loop is a plain counted loop annotated with `omp simd` so the host
+// compiler can vectorize the pointwise body. For the common all-contiguous
+// case the tensor offsets reduce to `linearIndex` itself and the body
+// vectorizes cleanly; strided tensors fall back to scalar code.
+#define CHUNK_SIZE 2048
+#define OMP_THRESHOLD 32768
 static void ${kernelName}_kernel(IndexType totalElements, ${formals}) {
-  #pragma omp parallel for if(totalElements > OMP_THRESHOLD)
-  for (IndexType linearIndex = 0;
-        linearIndex < totalElements;
-        linearIndex += 1) {
+  #pragma omp parallel for schedule(static) if(totalElements > OMP_THRESHOLD)
+  for (IndexType chunkStart = 0;
+        chunkStart < totalElements;
+        chunkStart += CHUNK_SIZE) {
+    IndexType chunkEnd = (chunkStart + CHUNK_SIZE < totalElements)
+        ? chunkStart + CHUNK_SIZE
+        : totalElements;
+    #pragma omp simd
+    for (IndexType linearIndex = chunkStart;
+          linearIndex < chunkEnd;
+          linearIndex += 1) {
       // Convert `linearIndex` into an offset of tensor:
       ${tensorOffsets}
       // calculate the results
       ${kernelBody}
     }
+  }
 }
 
 extern "C"
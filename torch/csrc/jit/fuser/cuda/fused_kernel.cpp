@@ -2,8 +2,10 @@
 #include <torch/csrc/jit/fuser/compiler.h>
 
 #include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/CUDAEvent.h>
 #include <THC/THC.h>
 #include <c10/cuda/CUDAGuard.h>
+#include <torch/csrc/jit/fuser/code_cache.h>
 #include <torch/csrc/jit/fuser/cpu/dynamic_library.h>
 #include <torch/csrc/jit/fuser/cuda/thnvrtc.h>
 #include <torch/csrc/jit/resource_guard.h>
@@ -17,6 +19,9 @@ THCGenerator* THCRandom_getGenerator(THCState* state);
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
@@ -141,7 +146,8 @@ FusedKernelCUDA::FusedKernelCUDA(
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
-    bool has_random)
+    bool has_random,
+    bool has_reduction)
     : FusedKernel(
           std::move(name),
           std::move(code),
@@ -149,7 +155,8 @@ FusedKernelCUDA::FusedKernelCUDA(
           std::move(output_desc),
           std::move(chunk_desc),
           std::move(concat_desc),
-          has_random),
+          has_random,
+          has_reduction),
       device_(device) {
   // Initializes driver's API context (if necessary)
   CUcontext pctx = 0;
@@ -171,42 +178,66 @@ FusedKernelCUDA::FusedKernelCUDA(
   int major, minor;
   getMajorMinor(prop_, major, minor);
 
-  // Creates the NVRTC program
-  nvrtcProgram program;
-  TORCH_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
-      &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
-
-  const std::string compute = "--gpu-architecture=compute_" +
-      std::to_string(major) + std::to_string(minor);
-  const std::vector<const char*> args = {
-      "--std=c++11", compute.c_str(), "-default-device"};
-  const auto result =
-      nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
-  if (result == NVRTC_ERROR_COMPILATION) {
-    size_t logsize;
-    nvrtc().nvrtcGetProgramLogSize(program, &logsize);
-    std::vector<char> log(logsize);
-    nvrtc().nvrtcGetProgramLog(program, log.data());
-    std::stringstream cu;
-    cu << log.data();
-    throw std::runtime_error(cu.str());
+  // See Note [Fusion disk code cache]: a cached PTX artifact skips NVRTC
+  // entirely. The key covers everything the PTX depends on - source, entry
+  // point, compile architecture, and NVRTC version.
+  std::string cache_key;
+  if (codeCacheEnabled()) {
+    int nvrtc_major, nvrtc_minor;
+    TORCH_NVRTC_CHECK(nvrtc().nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+    cache_key = codeCacheKey(
+        "ptx",
+        code_ + "|" + name_ + "|compute_" + std::to_string(major) +
+            std::to_string(minor) + "|nvrtc" + std::to_string(nvrtc_major) +
+            "." + std::to_string(nvrtc_minor));
+  }
+
+  if (cache_key.empty() || !codeCacheLookup(cache_key, ptx_)) {
+    // Creates the NVRTC program
+    nvrtcProgram program;
+    TORCH_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
+        &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
+
+    const std::string compute = "--gpu-architecture=compute_" +
+        std::to_string(major) + std::to_string(minor);
+    const std::vector<const char*> args = {
+        "--std=c++11", compute.c_str(), "-default-device"};
+    const auto result =
+        nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
+    if (result == NVRTC_ERROR_COMPILATION) {
+      size_t logsize;
+      nvrtc().nvrtcGetProgramLogSize(program, &logsize);
+      std::vector<char> log(logsize);
+      nvrtc().nvrtcGetProgramLog(program, log.data());
+      std::stringstream cu;
+      cu << log.data();
+      throw std::runtime_error(cu.str());
+    }
+    ResourceGuard holdProgram(
+        [&] { TORCH_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
+    TORCH_NVRTC_CHECK(result);
+    size_t ptx_size;
+    TORCH_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
+    ptx_.resize(ptx_size);
+    TORCH_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
+
+    if (!cache_key.empty()) {
+      codeCacheStore(cache_key, ptx_.data(), ptx_.size());
+    }
   }
-  ResourceGuard holdProgram(
-      [&] { TORCH_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
-  TORCH_NVRTC_CHECK(result);
-  size_t ptx_size;
-  TORCH_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
-  ptx_.resize(ptx_size);
-  TORCH_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
 
   TORCH_CU_CHECK(nvrtc().cuModuleLoadData(&module_, ptx_.data()));
   TORCH_CU_CHECK(
       nvrtc().cuModuleGetFunction(&function_, module_, name_.c_str()));
 
-  // Computes max blocks
-  TORCH_CU_CHECK(nvrtc().cuOccupancyMaxActiveBlocksPerMultiprocessor(
-      &maxBlocks_, function_, 128, 0));
-  maxBlocks_ *= prop_->multiProcessorCount;
+  // Computes max blocks for every candidate block size
+  for (int i = 0; i < kNumCandidateBlockSizes; i++) {
+    TORCH_CU_CHECK(nvrtc().cuOccupancyMaxActiveBlocksPerMultiprocessor(
+        &maxBlocks_[i], function_, kCandidateBlockSizes[i], 0));
+    maxBlocks_[i] *= prop_->multiProcessorCount;
+  }
+
+  loadTuningCache();
 
   // Resets device (end of hacked at::DeviceGuard)
   at::cuda::set_device(prior_device);
@@ -216,6 +247,146 @@ static int ceilDiv(const int a, const int b) {
   return (a + b - 1) / b;
 }
 
+// Note [Fused kernel occupancy autotuning]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A fixed 128-thread block is a fine default for memory-bound pointwise
+// kernels, but register-heavy fused kernels can end up at low occupancy
+// where a different block size would hide latency much better. Since a
+// fused kernel is compiled once and launched many times, the first launch
+// for each numel bucket (ceil log2) times the candidate block sizes
+// back-to-back on the current stream and remembers the winner; repeated
+// launches are correctness-neutral because the kernel writes the same
+// outputs from the same inputs. Kernels that consume Philox state are
+// excluded so tuning does not advance the RNG stream. The winners live on
+// this object -- which the kernel cache retains per (spec, arg
+// configuration) -- and can additionally be persisted across processes by
+// pointing PYTORCH_FUSION_TUNING_CACHE at a writable directory.
+const int FusedKernelCUDA::kCandidateBlockSizes[kNumCandidateBlockSizes] = {
+    64,
+    128,
+    256,
+    512};
+
+static int numelBucket(const uint32_t numel) {
+  int bucket = 0;
+  while ((uint64_t(1) << bucket) < numel) {
+    bucket++;
+  }
+  return bucket;
+}
+
+int FusedKernelCUDA::maxBlocksFor(const int block_size) const {
+  for (int i = 0; i < kNumCandidateBlockSizes; i++) {
+    if (kCandidateBlockSizes[i] == block_size) {
+      return maxBlocks_[i];
+    }
+  }
+  AT_ERROR("unsupported fused kernel block size ", block_size);
+}
+
+void FusedKernelCUDA::launchKernel(
+    const int n_blocks,
+    const int block_size,
+    std::vector<void*>& arguments) const {
+  auto stream = at::cuda::getCurrentCUDAStream();
+  TORCH_CU_CHECK(nvrtc().cuLaunchKernel(
+      function_,
+      n_blocks,
+      1,
+      1,
+      block_size,
+      1,
+      1,
+      0,
+      stream,
+      arguments.data(),
+      nullptr));
+}
+
+// Keyed on kernel name, source hash, and compute capability so stale
+// entries from other builds or devices are never picked up. Returns the
+// empty string when persistence is disabled.
+std::string FusedKernelCUDA::tuningCachePath() const {
+  const char* cache_dir = getenv("PYTORCH_FUSION_TUNING_CACHE");
+  if (cache_dir == nullptr || cache_dir[0] == '\0') {
+    return std::string();
+  }
+  return std::string(cache_dir) + "/" + name_ + "-" +
+      std::to_string(std::hash<std::string>()(code_)) + "-sm" +
+      std::to_string(prop_->major) + std::to_string(prop_->minor) + ".tune";
+}
+
+void FusedKernelCUDA::loadTuningCache() {
+  const auto path = tuningCachePath();
+  if (path.empty()) {
+    return;
+  }
+  std::ifstream cache(path);
+  int bucket, block_size;
+  while (cache >> bucket >> block_size) {
+    // Only accept block sizes the launcher can actually use.
+    for (int i = 0; i < kNumCandidateBlockSizes; i++) {
+      if (kCandidateBlockSizes[i] == block_size) {
+        tuned_blocks_[bucket] = block_size;
+        break;
+      }
+    }
+  }
+}
+
+void FusedKernelCUDA::appendTuningCache(
+    const int bucket,
+    const int block_size) const {
+  const auto path = tuningCachePath();
+  if (path.empty()) {
+    return;
+  }
+  std::ofstream cache(path, std::ios::app);
+  cache << bucket << " " << block_size << "\n";
+}
+
+int FusedKernelCUDA::tunedBlockSize(
+    const uint32_t numel,
+    std::vector<void*>& arguments) const {
+  const int bucket = numelBucket(numel);
+  std::lock_guard<std::mutex> lock(tuning_mutex_);
+  const auto it = tuned_blocks_.find(bucket);
+  if (it != tuned_blocks_.end()) {
+    return it->second;
+  }
+
+  auto stream = at::cuda::getCurrentCUDAStream();
+  // Untimed warmup launch so module load / first-touch costs are not
+  // charged to the first candidate.
+  launchKernel(
+      std::min(maxBlocksFor(kBlockSize), ceilDiv(numel, kBlockSize)),
+      kBlockSize,
+      arguments);
+
+  int best_block = kBlockSize;
+  float best_ms = -1.0f;
+  for (int i = 0; i < kNumCandidateBlockSizes; i++) {
+    const int block_size = kCandidateBlockSizes[i];
+    const int n_blocks =
+        std::min(maxBlocks_[i], ceilDiv(numel, block_size));
+    at::cuda::CUDAEvent start(cudaEventDefault);
+    at::cuda::CUDAEvent end(cudaEventDefault);
+    start.record(stream);
+    launchKernel(n_blocks, block_size, arguments);
+    end.record(stream);
+    end.synchronize();
+    const float ms = start.elapsed_time(end);
+    if (best_ms < 0.0f || ms < best_ms) {
+      best_ms = ms;
+      best_block = block_size;
+    }
+  }
+
+  tuned_blocks_.emplace(bucket, best_block);
+  appendTuningCache(bucket, best_block);
+  return best_block;
+}
+
 void FusedKernelCUDA::launch_raw(
     const uint32_t numel,
     std::vector<void*>& arguments) const {
@@ -224,14 +395,19 @@ void FusedKernelCUDA::launch_raw(
   const auto prior_device = at::cuda::current_device();
   at::cuda::set_device(device_);
 
-  const auto nBlocks = std::min(maxBlocks_, ceilDiv(numel, kBlockSize));
+  // See Note [Fused kernel occupancy autotuning]; random kernels keep the
+  // fixed default so tuning launches do not advance the Philox stream.
+  const int blockSize =
+      has_random_ ? kBlockSize : tunedBlockSize(numel, arguments);
+  const auto nBlocks =
+      std::min(maxBlocksFor(blockSize), ceilDiv(numel, blockSize));
 
   // Adds random state to arguments if necessary
   // Note: offset defined here so its lifetime extends to the launch
   uint64_t offset;
   if (has_random_) {
     const auto rand_offset =
-        4 * (std::ceil(numel / (4.0 * kBlockSize * nBlocks)) + 1);
+        4 * (std::ceil(numel / (4.0 * blockSize * nBlocks)) + 1);
     auto gen = THCRandom_getGenerator(at::globalContext().getTHCState());
     offset = gen->state.philox_seed_offset.fetch_add(rand_offset);
     arguments.push_back(&gen->state.initial_seed);
@@ -239,19 +415,7 @@ void FusedKernelCUDA::launch_raw(
   }
 
   // Launches kernel on current stream (device was set by executor)
-  auto stream = at::cuda::getCurrentCUDAStream();
-  TORCH_CU_CHECK(nvrtc().cuLaunchKernel(
-      function_,
-      nBlocks,
-      1,
-      1,
-      kBlockSize,
-      1,
-      1,
-      0,
-      stream,
-      arguments.data(),
-      nullptr));
+  launchKernel(nBlocks, blockSize, arguments);
 
   // Resets device (see at::DeviceGuard notes above)
   at::cuda::set_device(prior_device);
@@ -269,7 +433,8 @@ static std::shared_ptr<FusedKernel> createFusionKernel(
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
-    bool has_random) {
+    bool has_random,
+    bool has_reduction) {
   return std::make_shared<FusedKernelCUDA>(
       device,
       std::move(name),
@@ -278,7 +443,8 @@ static std::shared_ptr<FusedKernel> createFusionKernel(
       std::move(output_desc),
       std::move(chunk_desc),
       std::move(concat_desc),
-      has_random);
+      has_random,
+      has_reduction);
 }
 
 RegisterFusionBackend reg(at::DeviceType::CUDA, createFusionKernel);
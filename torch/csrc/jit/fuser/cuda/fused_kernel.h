@@ -9,7 +9,9 @@
 #include <nvrtc.h>
 
 #include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace torch {
@@ -28,7 +30,8 @@ struct TORCH_API FusedKernelCUDA : public ::torch::jit::fuser::FusedKernel {
       std::vector<TensorDesc> output_desc,
       std::vector<PartitionDesc> chunk_desc,
       std::vector<PartitionDesc> concat_desc,
-      bool has_random);
+      bool has_random,
+      bool has_reduction);
 
   ~FusedKernelCUDA() override;
 
@@ -41,15 +44,34 @@ struct TORCH_API FusedKernelCUDA : public ::torch::jit::fuser::FusedKernel {
 
  private:
   static constexpr auto kBlockSize = 128;
+  static constexpr int kNumCandidateBlockSizes = 4;
+  // See Note [Fused kernel occupancy autotuning] in fused_kernel.cpp.
+  static const int kCandidateBlockSizes[kNumCandidateBlockSizes];
+
+  int maxBlocksFor(int block_size) const;
+  void launchKernel(
+      int n_blocks,
+      int block_size,
+      std::vector<void*>& arguments) const;
+  int tunedBlockSize(uint32_t numel, std::vector<void*>& arguments) const;
+  std::string tuningCachePath() const;
+  void loadTuningCache();
+  void appendTuningCache(int bucket, int block_size) const;
 
   // Note: per device to store device properties and compute launch heuristics
   //  Acquiring these values at launch time would be too slow
   int16_t device_;
-  int maxBlocks_;
+  int maxBlocks_[kNumCandidateBlockSizes];
   cudaDeviceProp* prop_;
   std::vector<char> ptx_;
   CUmodule module_;
   CUfunction function_;
+
+  // Winning block size per numel bucket; filled in by the autotuner the
+  // first time a bucket is launched (and from the on-disk cache, if
+  // enabled). Mutable: launch_raw is const on the cached kernel.
+  mutable std::mutex tuning_mutex_;
+  mutable std::unordered_map<int, int> tuned_blocks_;
 };
 
 } // namespace cuda
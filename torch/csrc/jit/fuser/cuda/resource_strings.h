@@ -145,6 +145,22 @@ constexpr auto rand_init = R"(
 static auto cuda_compilation_unit_template = CodeTemplate(R"(
 ${type_declarations}
 
+// Reduced-accuracy variants for the fast math tier (see Note
+// [Fast math tier] in ATen/core/fast_math_mode.h). __expf is the
+// hardware approximate exp, good to roughly 12 significant bits.
+__device__ __inline__ float fast_expf(float x) {
+  return __expf(x);
+}
+__device__ __inline__ float fast_sigmoidf(float x) {
+  return 1.f / (1.f + __expf(-x));
+}
+__device__ __inline__ float fast_tanhf(float x) {
+  if (x > 9.f) return 1.f;
+  if (x < -9.f) return -1.f;
+  float e = __expf(2.f * x);
+  return (e - 1.f) / (e + 1.f);
+}
+
 extern "C" __global__
 void ${kernelName}(IndexType totalElements, ${formals} ${RandParam}) {
   ${RandInit}
@@ -223,6 +223,18 @@ void launchFusion(
     numel = computeNumel(map_size);
   }
 
+  // A reduction kernel's index space is the reduced output space; the summed
+  // (innermost) dimension's length is passed as the last kernel argument.
+  // See Note [Fusing the innermost reduction] in codegen.cpp.
+  uint32_t reduction_size = 0;
+  std::vector<int64_t> reduced_map_size;
+  if (fusion.hasReduction()) {
+    reduction_size = map_size.back();
+    reduced_map_size.assign(map_size.begin(), map_size.end() - 1);
+    map_size = reduced_map_size;
+    numel = computeNumel(map_size);
+  }
+
   // compute number of scalar inputs and convert them to float
   std::vector<double> scalar_inputs;
   scalar_inputs.reserve(all_inputs.size());
@@ -314,6 +326,10 @@ void launchFusion(
     }
   }
 
+  if (fusion.hasReduction()) {
+    arguments.push_back(&reduction_size);
+  }
+
   fusion.launch_raw(numel, arguments);
 }
 
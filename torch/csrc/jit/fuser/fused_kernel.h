@@ -23,14 +23,16 @@ struct FusedKernel {
       std::vector<TensorDesc> output_desc,
       std::vector<PartitionDesc> chunk_desc,
       std::vector<PartitionDesc> concat_desc,
-      bool has_random)
+      bool has_random,
+      bool has_reduction)
       : name_(std::move(name)),
         code_(std::move(code)),
         input_desc_(std::move(input_desc)),
         output_desc_(std::move(output_desc)),
         chunk_desc_(std::move(chunk_desc)),
         concat_desc_(std::move(concat_desc)),
-        has_random_(has_random) {}
+        has_random_(has_random),
+        has_reduction_(has_reduction) {}
 
   virtual ~FusedKernel() = default;
 
@@ -70,6 +72,12 @@ struct FusedKernel {
   bool hasRandom() const {
     return has_random_;
   }
+  // True if the kernel reduces over the innermost dimension; the launcher
+  // must drop that dimension from the index space and append its length as
+  // the last kernel argument. See Note [Fusing the innermost reduction].
+  bool hasReduction() const {
+    return has_reduction_;
+  }
 
  protected:
   const std::string name_;
@@ -88,6 +96,7 @@ struct FusedKernel {
   const std::vector<PartitionDesc> concat_desc_;
 
   const bool has_random_;
+  const bool has_reduction_;
 };
 
 } // namespace fuser
@@ -5,6 +5,7 @@
 #include <torch/csrc/jit/fuser/fallback.h>
 #include <torch/csrc/jit/fuser/kernel_cache.h>
 
+#include <cstdlib>
 #include <stdexcept>
 
 namespace torch {
@@ -12,8 +13,16 @@ namespace jit {
 
 namespace detail {
 
-// Note: CPU fusion is currently disabled due to test flakiness
-bool cpu_fuser_enabled = false;
+// Note: CPU fusion is disabled by default due to test flakiness, but can be
+// opted into per-process with PYTORCH_FUSION_CPU=1 (or programmatically with
+// overrideCanFuseOnCPU) for CPU inference workloads dominated by pointwise
+// chains.
+static bool initCPUFuserEnabled() {
+  const char* enable_env = getenv("PYTORCH_FUSION_CPU");
+  return enable_env != nullptr && atoi(enable_env) != 0;
+}
+
+bool cpu_fuser_enabled = initCPUFuserEnabled();
 
 } // namespace detail
 
@@ -11,9 +11,11 @@
 #include <ATen/core/stack.h>
 
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace torch {
@@ -145,18 +147,31 @@ struct TORCH_API KernelSpec {
   }
 
   // Cache functions
+  // The map is LRU-bounded: ArgSpecs are already bucketed (dtype, rank,
+  // contiguity, device -- sizes are runtime kernel arguments), so the bound
+  // is generous for steady workloads, but devices cycling through many
+  // stride patterns no longer grow the map without limit.
   c10::optional<std::shared_ptr<FusedKernel>> findKernel(
       const ArgSpec& arg_spec) const {
     std::lock_guard<std::mutex> guard{mutex_};
     const auto it = kernels_.find(arg_spec);
     if (it == kernels_.end())
       return c10::nullopt;
-    return it->second;
+    lru_.splice(lru_.begin(), lru_, it->second.second);
+    return it->second.first;
   }
   void cacheKernel(const ArgSpec& arg_spec, std::shared_ptr<FusedKernel> kernel)
       const {
     std::lock_guard<std::mutex> guard{mutex_};
-    kernels_.emplace(arg_spec, kernel);
+    if (kernels_.count(arg_spec) > 0) {
+      return;
+    }
+    lru_.push_front(arg_spec);
+    kernels_.emplace(arg_spec, std::make_pair(std::move(kernel), lru_.begin()));
+    if (kernels_.size() > kKernelCacheCapacity) {
+      kernels_.erase(lru_.back());
+      lru_.pop_back();
+    }
   }
 
  private:
@@ -173,10 +188,22 @@ struct TORCH_API KernelSpec {
   // number of kernel outputs).
   std::vector<OutputMapAndSize> outputMapAndSizes_;
   bool has_random_;
+
+  // Maximum number of instantiated kernels kept per specification; the
+  // least recently used kernel is dropped when a newly compiled one would
+  // exceed it.
+  static constexpr size_t kKernelCacheCapacity = 128;
+
   mutable std::mutex mutex_;
-  mutable std::
-      unordered_map<ArgSpec, std::shared_ptr<FusedKernel>, torch::hash<ArgSpec>>
-          kernels_;
+  // Most recently used ArgSpecs first; kernels_ holds an iterator into this
+  // list next to each kernel. std::list iterators stay valid across splice
+  // and erasure of other elements.
+  mutable std::list<ArgSpec> lru_;
+  mutable std::unordered_map<
+      ArgSpec,
+      std::pair<std::shared_ptr<FusedKernel>, std::list<ArgSpec>::iterator>,
+      torch::hash<ArgSpec>>
+      kernels_;
 };
 
 } // namespace fuser
@@ -9,19 +9,14 @@
 #include <torch/csrc/jit/interpreter.h>
 #include <torch/csrc/jit/ir.h>
 #include <torch/csrc/jit/pass_manager.h>
-#include <torch/csrc/jit/passes/batch_mm.h>
 #include <torch/csrc/jit/passes/canonicalize_ops.h>
-#include <torch/csrc/jit/passes/common_subexpression_elimination.h>
-#include <torch/csrc/jit/passes/constant_pooling.h>
 #include <torch/csrc/jit/passes/constant_propagation.h>
 #include <torch/csrc/jit/passes/create_autodiff_subgraphs.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
-#include <torch/csrc/jit/passes/graph_fuser.h>
 #include <torch/csrc/jit/passes/inline_autodiff_subgraphs.h>
-#include <torch/csrc/jit/passes/inplace_check.h>
-#include <torch/csrc/jit/passes/loop_unrolling.h>
+#include <torch/csrc/jit/passes/inline_calls.h>
 #include <torch/csrc/jit/passes/lower_grad_of.h>
-#include <torch/csrc/jit/passes/peephole.h>
+#include <torch/csrc/jit/passes/managed_prefetch.h>
 #include <torch/csrc/jit/passes/remove_expands.h>
 #include <torch/csrc/jit/passes/requires_grad_analysis.h>
 #include <torch/csrc/jit/passes/shape_analysis.h>
@@ -35,10 +30,18 @@
 #include <torch/csrc/jit/script/compiler.h>
 #include <torch/csrc/jit/script/logging.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iterator>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <sstream>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -480,6 +483,73 @@ GraphExecutor* getGradExecutor(Operation& op) {
 }
 } // namespace detail
 
+// Note [Warm-start snapshots]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A worker that has been serving for a while has compiled a specialized
+// plan for every hot argument spec; a freshly exec'd replacement starts
+// from nothing and serves its first requests off the generic fallback
+// while the profile-guided thresholds (see Note [Profile-guided
+// specialization]) are met all over again. The compiled artifacts
+// themselves are process-local - Code holds interned symbols and raw
+// function pointers - so they cannot be written to disk, but *which*
+// specs were worth compiling round-trips exactly: a spec is a flat
+// array of 32-bit ArgumentInfo words (see ArgumentSpec::wire), and
+// executors are matched across processes by the same graph-content
+// fingerprint the shared plan cache uses (see
+// Note [Cross-executor plan sharing]).
+//
+// enableWarmStartRecording(true) makes compileSpec log every
+// (fingerprint, spec) pair it compiles; saveWarmStartSnapshot writes
+// the accumulated set to a file, and loadWarmStartSnapshot reads it
+// back in the new process. On the first plan lookup of an executor
+// whose fingerprint has pending snapshot entries, every recorded spec
+// is recompiled up front - bypassing the specialization threshold,
+// since the snapshot *is* the profile - so steady-state traffic lands
+// on specialized plans from the first request. Combined with
+// PYTORCH_JIT_SHARED_PLAN_CACHE=1, module replicas after the first get
+// those plans for free. Snapshots are written in host byte order and
+// are meant to be restored on the same architecture; load them before
+// traffic, since replay triggers on an executor's first lookup only.
+namespace {
+
+constexpr char kWarmStartMagic[] = "PTJIT_WARM_START_V1\n";
+
+struct WarmStartRegistry {
+  std::mutex mutex;
+  std::atomic<bool> recording{false};
+  // graph fingerprint -> wire forms of every spec compiled while
+  // recording was enabled
+  std::unordered_map<
+      std::string,
+      std::set<std::vector<ArgumentInfo::plain_data_type>>>
+      recorded;
+  // graph fingerprint -> specs loaded from a snapshot, awaiting replay
+  std::unordered_map<
+      std::string,
+      std::vector<std::vector<ArgumentInfo::plain_data_type>>>
+      pending;
+  // cheap "anything to replay?" check for the lookup path
+  std::atomic<size_t> pending_graphs{0};
+};
+
+WarmStartRegistry& warmStartRegistry() {
+  static WarmStartRegistry registry;
+  return registry;
+}
+
+void writeWarmStartUint64(std::ostream& out, uint64_t value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+uint64_t readWarmStartUint64(std::istream& in, const std::string& filename) {
+  uint64_t value = 0;
+  in.read(reinterpret_cast<char*>(&value), sizeof(value));
+  AT_CHECK(in, "truncated warm-start snapshot: ", filename);
+  return value;
+}
+
+} // namespace
+
 // a Graph can be created via tracing, or via a language-based frontend
 // GraphExecutor runs it. It can run the same graph on many different sizes
 // and different requires_grad states, and handles specializations for each
@@ -520,9 +590,30 @@ struct GraphExecutorImpl {
       return runTraced(stack);
     }
 
-    auto& execution_plan =
-        optimize ? getOrCompile(stack) : getOrCompileFallback();
-    return execution_plan.run(stack);
+    // See Note [Fixed-shape step replay]
+    if (fixedShapeReplayEnabled() && optimize) {
+      auto& slot = replay_plans[autograd::GradMode::is_enabled() ? 1 : 0];
+      if (const ExecutionPlan* plan =
+              slot.load(std::memory_order_acquire)) {
+        return plan->run(stack);
+      }
+      // The captured entry is pinned so eviction can never invalidate the
+      // raw pointer in the slot.
+      if (auto entry = getOrCompilePlan(stack, /*pin=*/true)) {
+        slot.store(&entry->plan, std::memory_order_release);
+        return entry->plan.run(stack);
+      }
+      return getOrCompileFallback().run(stack);
+    }
+
+    if (optimize) {
+      // Keep the entry alive across the run: under eviction a reference
+      // into the cache could otherwise disappear mid-execution.
+      if (auto entry = getOrCompilePlan(stack, /*pin=*/false)) {
+        return entry->plan.run(stack);
+      }
+    }
+    return getOrCompileFallback().run(stack);
   }
 
   GraphExecutorState getDebugState() {
@@ -531,8 +622,12 @@ struct GraphExecutorImpl {
     if (fallback) {
       state.fallback = fallback.getDebugState();
     }
-    for (auto& entry : plan_cache) {
-      state.execution_plans.emplace(entry.first, entry.second.getDebugState());
+    for (auto& shard : plan_shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (auto& entry : shard.plans) {
+        state.execution_plans.emplace(
+            entry.first, entry.second->plan.getDebugState());
+      }
     }
     return state;
   }
@@ -542,6 +637,11 @@ struct GraphExecutorImpl {
 
   const ExecutionPlan& getOrCompileFallback() {
     std::lock_guard<std::mutex> lock(compile_mutex);
+    return getOrCompileFallbackLocked();
+  }
+
+  // Note: callers must hold compile_mutex.
+  const ExecutionPlan& getOrCompileFallbackLocked() {
     if (!fallback) {
       auto graph_ = graph->copy();
       runRequiredPasses(graph_);
@@ -550,31 +650,321 @@ struct GraphExecutorImpl {
     return fallback;
   }
 
-  const ExecutionPlan& getOrCompile(const Stack& stack) {
+  // Note [Profile-guided specialization]
+  // Compiling a specialized plan runs the full optimization pipeline and is
+  // expensive, so it should only be paid for argument specs that recur.
+  // Instead of compiling eagerly on every cache miss, we count how often
+  // each spec has been observed and compile once a spec proves hot. Specs
+  // that have not met the threshold yet run on the generic fallback plan,
+  // which acts as the cheap bailout path: it is compiled once and handles
+  // any shape. This keeps long-tail shapes from polluting the plan cache
+  // while the dominant shape still gets a fully specialized plan. The
+  // ArgumentSpec hash/equality check on the cache lookup doubles as the
+  // guard that the specialized plan is valid for the incoming inputs.
+  //
+  // Returns nullptr when the spec has not proven hot yet; the caller runs
+  // the fallback plan in that case.
+  std::shared_ptr<PlanEntry> getOrCompilePlan(const Stack& stack, bool pin) {
     // outside lock guard, to minimize the time holding the lock on the fast
     // path ArgumentSpec even computes its hashCode here.
     ArgumentSpec spec =
         arg_spec_creator_.create(autograd::GradMode::is_enabled(), stack);
-    {
-      std::lock_guard<std::mutex> lock(compile_mutex);
-      auto it = plan_cache.find(spec);
-      if (it != plan_cache.end()) {
-        logging::getLogger()->addStatValue(
-            logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
-        return it->second;
+    // See Note [Warm-start snapshots]: the first lookup replays any specs
+    // a loaded snapshot recorded for this graph, ahead of the live spec.
+    if (warmStartRegistry().pending_graphs.load(std::memory_order_acquire) !=
+        0) {
+      std::call_once(warm_start_once_, [this] { replayWarmStart(); });
+    }
+    // See Note [Wait-free cached-plan lookup]. Pinning writes the entry's
+    // pinned flag, which is only safe under the shard lock, so pinning
+    // requests (first replay capture only) take the slow path.
+    auto& memo = localPlanMemo(executor_id_);
+    if (!pin) {
+      auto memo_it = memo.find(spec);
+      if (memo_it != memo.end()) {
+        if (auto entry = memo_it->second.lock()) {
+          logging::getLogger()->addStatValue(
+              logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
+          entry->last_use.store(++use_clock, std::memory_order_relaxed);
+          return entry;
+        }
+        memo.erase(memo_it);
+      }
+    }
+    // See Note [Sharded plan cache]
+    auto& shard = plan_shards[spec.hashCode() % kPlanCacheShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.plans.find(spec);
+    if (it != shard.plans.end()) {
+      logging::getLogger()->addStatValue(
+          logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
+      it->second->last_use.store(
+          ++use_clock, std::memory_order_relaxed);
+      if (pin) {
+        it->second->pinned = true;
       }
-      auto plan = compileSpec(spec);
-      auto r = plan_cache.emplace(std::move(spec), std::move(plan));
+      memoizePlan(memo, spec, it->second);
+      return it->second;
+    }
+    logging::getLogger()->addStatValue(
+        logging::runtime_counters::EXECUTION_PLAN_CACHE_MISS, 1.0);
+    // See Note [Profile-guided specialization]. The very first spec is
+    // compiled eagerly so single-shape workloads keep their current
+    // warmup behavior.
+    if (cached_plans.load(std::memory_order_relaxed) != 0) {
+      if (shard.spec_counts.size() >= kMaxProfiledSpecs) {
+        // The profile table is itself keyed by the long tail; restart
+        // the counts rather than letting it grow without bound.
+        shard.spec_counts.clear();
+      }
+      const auto seen = ++shard.spec_counts[spec];
+      if (seen < kSpecializationThreshold) {
+        return nullptr;
+      }
+      shard.spec_counts.erase(spec);
+    }
+    evictIfNeeded(shard);
+    auto entry = std::make_shared<PlanEntry>();
+    entry->plan = compileSpec(spec);
+    entry->pinned = pin;
+    entry->last_use.store(++use_clock, std::memory_order_relaxed);
+    memoizePlan(memo, spec, entry);
+    shard.plans.emplace(std::move(spec), entry);
+    cached_plans.fetch_add(1, std::memory_order_relaxed);
+    return entry;
+  }
+
+  // Note [Wait-free cached-plan lookup]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Even with the sharded cache, N serving threads hammering one hot spec
+  // all funnel through that spec's shard mutex. Each thread therefore
+  // memoizes the entries it has already used, keyed by the executor's id
+  // and the ArgumentSpec: a memo hit re-validates with the full
+  // ArgumentSpec equality check and touches only thread-local state plus
+  // one relaxed atomic, so the steady-state inference path acquires no
+  // locks at all. This is what makes replicating a module per thread
+  // unnecessary - the ExecutionPlan is immutable once published and every
+  // run builds a fresh InterpreterState, so a single module's plans can be
+  // run from any number of threads.
+  //
+  // Memo entries are weak_ptrs, so neither eviction nor executor
+  // destruction is delayed by thread-local copies; expired entries are
+  // pruned on their next lookup. Executor ids are never reused, so a new
+  // executor allocated at a dead one's address can never observe its
+  // stale memo entries. The per-executor memo is capped (cleared wholesale
+  // when full, like the spec profile table), and memos whose executor is
+  // gone are swept once the thread has touched enough distinct executors.
+  using LocalPlanMemo =
+      std::unordered_map<ArgumentSpec, std::weak_ptr<PlanEntry>>;
+  static constexpr size_t kMaxLocalMemoSpecs = 64;
+  static constexpr size_t kMaxLocalMemoExecutors = 64;
+
+  static LocalPlanMemo& localPlanMemo(uint64_t executor_id) {
+    static thread_local std::unordered_map<uint64_t, LocalPlanMemo> memos;
+    if (memos.size() > kMaxLocalMemoExecutors &&
+        memos.count(executor_id) == 0) {
+      for (auto it = memos.begin(); it != memos.end();) {
+        const bool all_expired = std::all_of(
+            it->second.begin(),
+            it->second.end(),
+            [](const LocalPlanMemo::value_type& entry) {
+              return entry.second.expired();
+            });
+        it = all_expired ? memos.erase(it) : ++it;
+      }
+    }
+    return memos[executor_id];
+  }
+
+  static void memoizePlan(
+      LocalPlanMemo& memo,
+      const ArgumentSpec& spec,
+      const std::shared_ptr<PlanEntry>& entry) {
+    if (memo.size() >= kMaxLocalMemoSpecs) {
+      memo.clear();
+    }
+    memo.emplace(spec, entry);
+  }
+
+  // See Note [Sharded plan cache]: least-recently-used unpinned entries
+  // are dropped once a shard reaches its share of the configured
+  // capacity. With no capacity configured this never runs.
+  void evictIfNeeded(PlanCacheShard& shard) {
+    const size_t capacity = planCacheCapacity();
+    if (capacity == 0) {
+      return;
+    }
+    const size_t shard_capacity =
+        std::max<size_t>(1, capacity / kPlanCacheShards);
+    while (shard.plans.size() >= shard_capacity) {
+      auto victim = shard.plans.end();
+      for (auto it = shard.plans.begin(); it != shard.plans.end(); ++it) {
+        if (it->second->pinned) {
+          continue;
+        }
+        if (victim == shard.plans.end() ||
+            it->second->last_use.load(std::memory_order_relaxed) <
+                victim->second->last_use.load(std::memory_order_relaxed)) {
+          victim = it;
+        }
+      }
+      if (victim == shard.plans.end()) {
+        // Everything left is pinned; let the shard exceed its share.
+        return;
+      }
+      shard.plans.erase(victim);
+      cached_plans.fetch_sub(1, std::memory_order_relaxed);
       logging::getLogger()->addStatValue(
-          logging::runtime_counters::EXECUTION_PLAN_CACHE_MISS, 1.0);
-      return r.first->second;
+          logging::runtime_counters::EXECUTION_PLAN_CACHE_EVICTION, 1.0);
+    }
+  }
+
+  // See Note [Warm-start snapshots]. Runs at most once per executor, on
+  // its first plan lookup: compiles every spec the snapshot recorded for
+  // this graph, skipping the specialization threshold - the snapshot is
+  // the profile.
+  void replayWarmStart() {
+    auto& warm = warmStartRegistry();
+    std::vector<std::vector<ArgumentInfo::plain_data_type>> specs;
+    {
+      std::lock_guard<std::mutex> lock(warm.mutex);
+      auto it = warm.pending.find(graphFingerprint());
+      if (it == warm.pending.end()) {
+        return;
+      }
+      specs = std::move(it->second);
+      warm.pending.erase(it);
+      warm.pending_graphs.fetch_sub(1, std::memory_order_release);
+    }
+    for (auto& words : specs) {
+      ArgumentSpec spec = ArgumentSpec::fromWire(words);
+      auto& shard = plan_shards[spec.hashCode() % kPlanCacheShards];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.plans.count(spec) != 0) {
+        continue;
+      }
+      evictIfNeeded(shard);
+      auto entry = std::make_shared<PlanEntry>();
+      entry->plan = compileSpec(spec);
+      entry->last_use.store(++use_clock, std::memory_order_relaxed);
+      shard.plans.emplace(std::move(spec), entry);
+      cached_plans.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Note [Cross-executor plan sharing]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Loading N instances of the same script::Module builds N distinct
+  // Graph objects with identical content, and each instance's executors
+  // then re-run the full optimization pipeline and rebuild Code. With
+  // PYTORCH_JIT_SHARED_PLAN_CACHE=1, compileSpec first consults a
+  // process-wide cache keyed by the executor's graph content and the
+  // ArgumentSpec; replicas after the first reuse the already-compiled
+  // plan (ExecutionPlan holds its graph and Code by shared_ptr, and
+  // every run builds a fresh InterpreterState, so one plan serves any
+  // number of executors concurrently).
+  //
+  // The key must distinguish graphs by *content*: the printed IR alone
+  // is not enough because imported graphs embed the model's constant
+  // tensors as prim::Constant nodes whose payload the printer elides, so
+  // the fingerprint also hashes the raw bytes of every tensor constant.
+  // Two racing executors may both compile the same key; the second
+  // insert loses and the duplicate work is shed on the next miss.
+  static bool sharedPlanCacheEnabled() {
+    static const bool enabled = []() {
+      const char* env = std::getenv("PYTORCH_JIT_SHARED_PLAN_CACHE");
+      return env != nullptr && env[0] == '1';
+    }();
+    return enabled;
+  }
+
+  struct SharedPlanCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, ExecutionPlan> plans;
+  };
+
+  static SharedPlanCache& sharedPlanCache() {
+    static SharedPlanCache cache;
+    return cache;
+  }
+
+  static uint64_t hashTensorData(const at::Tensor& tensor) {
+    // FNV-1a over the raw bytes; only runs once per executor, so the
+    // device sync for non-CPU constants is acceptable.
+    auto contig = tensor.cpu().contiguous();
+    const auto* data = static_cast<const unsigned char*>(contig.data_ptr());
+    const size_t nbytes = contig.numel() * contig.element_size();
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < nbytes; ++i) {
+      hash = (hash ^ data[i]) * 0x100000001b3ULL;
     }
+    return hash;
+  }
+
+  static void hashTensorConstants(Block* block, std::ostream& out) {
+    for (Node* node : block->nodes()) {
+      if (node->kind() == prim::Constant) {
+        for (auto name : node->attributeNames()) {
+          if (node->kindOf(name) == AttributeKind::t) {
+            out << " " << hashTensorData(node->t(name));
+          } else if (node->kindOf(name) == AttributeKind::ts) {
+            for (const auto& tensor : node->ts(name)) {
+              out << " " << hashTensorData(tensor);
+            }
+          }
+        }
+      }
+      for (Block* sub_block : node->blocks()) {
+        hashTensorConstants(sub_block, out);
+      }
+    }
+  }
+
+  const std::string& graphFingerprint() {
+    std::call_once(fingerprint_once_, [this] {
+      std::ostringstream out;
+      out << *graph;
+      hashTensorConstants(graph->block(), out);
+      graph_fingerprint_ = out.str();
+    });
+    return graph_fingerprint_;
   }
 
   ExecutionPlan compileSpec(const ArgumentSpec& spec) {
+    // See Note [Warm-start snapshots]
+    {
+      auto& warm = warmStartRegistry();
+      if (warm.recording.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(warm.mutex);
+        warm.recorded[graphFingerprint()].insert(spec.wire());
+      }
+    }
+    std::string shared_key;
+    if (sharedPlanCacheEnabled()) {
+      std::ostringstream key;
+      // The schedule participates in the key: a plan compiled under
+      // "fast-load" must not satisfy a "max-opt" process, and vice versa.
+      key << graphFingerprint() << "\n===\n"
+          << spec << "\n===\n"
+          << currentPassScheduleName();
+      shared_key = key.str();
+      auto& cache = sharedPlanCache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      auto it = cache.plans.find(shared_key);
+      if (it != cache.plans.end()) {
+        return it->second;
+      }
+    }
     auto opt_graph = graph->copy();
     arg_spec_creator_.setInputTypes(*opt_graph, spec);
 
+    // Phase 0. If calls were preserved at emission time (see Note
+    //          [Call-preserving compilation] in script/module.cpp), flatten
+    //          the ones whose callee is small and hot. By the time a spec
+    //          proves hot enough to reach here, the fallback runs have
+    //          accumulated invocation counts for every callee.
+    InlineSmallCalls(opt_graph);
+
     // Phase 1. Specialize to input definedness (this is very important for
     //          gradient graphs), and run required passes to bring the graph
     //          to an executable form.
@@ -591,8 +981,12 @@ struct GraphExecutorImpl {
 
     // Phase 3. Run differentiable optimizations (i.e. simple graph rewrites
     // that
-    //          we can still execute using autograd).
-    runOptimization(opt_graph, spec);
+    //          we can still execute using autograd). Which passes run -- and
+    //          how much compile time they may spend -- is governed by the
+    //          selected schedule; see pass_manager.h.
+    const PassSchedule schedule = currentPassSchedule();
+    PassBudget pass_budget;
+    runPassPhase(schedule, schedule.optimization, opt_graph, pass_budget);
 
     // Phase 4. If this graph will be differentiated, we need to slice out the
     //          symbolically differentiable subgraphs for further optimizations.
@@ -605,47 +999,40 @@ struct GraphExecutorImpl {
       for (Node* dnode : diff_nodes) {
         auto diff_graph = std::move(dnode->g(attr::Subgraph));
         Gradient gradient = differentiate(diff_graph);
-        runNondiffOptimization(gradient.f);
+        runPassPhase(
+            schedule, schedule.nondiff_optimization, gradient.f, pass_budget);
         packGradient(gradient, dnode);
       }
       InlineAutodiffSubgraphs(
           opt_graph,
           autodiff_subgraph_inlining ? autodiffSubgraphInlineThreshold : 1);
     } else {
-      runNondiffOptimization(opt_graph);
+      runPassPhase(
+          schedule, schedule.nondiff_optimization, opt_graph, pass_budget);
     }
     // Make sure there are no leftovers from any passes.
     EliminateDeadCode(opt_graph);
-    return ExecutionPlan(opt_graph);
-  }
-
-  void runOptimization(
-      std::shared_ptr<Graph>& graph,
-      const ArgumentSpec& spec) {
-    // Basic graph preprocessing to eliminate noise.
-    EliminateDeadCode(graph);
-    EliminateCommonSubexpression(graph);
-    ConstantPooling(graph);
-
-    PeepholeOptimize(graph);
-    ConstantPropagation(graph);
-
-    // Unroll small loops, and eliminate expressions that are the same at every
-    // iteration.
-    UnrollLoops(graph);
-    EliminateCommonSubexpression(graph);
-
-    // Rewrite subgraphs with many MMs into expressions that batch them.
-    BatchMM(graph);
-
-    CheckInplace(graph);
-  }
-
-  void runNondiffOptimization(std::shared_ptr<Graph>& graph) {
-    for (const auto& pass : getCustomPasses()) {
-      pass(graph);
+    // With PYTORCH_JIT_MANAGED_PREFETCH=<lookahead>, insert residency
+    // hints for CUDA inputs ahead of their first use; must run after the
+    // final DCE. See Note [Managed prefetch insertion].
+    static const size_t managed_prefetch_lookahead = []() -> size_t {
+      const char* env = std::getenv("PYTORCH_JIT_MANAGED_PREFETCH");
+      if (!env) {
+        return 0;
+      }
+      const long long value = std::strtoll(env, nullptr, 10);
+      return value > 0 ? static_cast<size_t>(value) : 0;
+    }();
+    if (managed_prefetch_lookahead > 0) {
+      InsertManagedPrefetch(opt_graph, managed_prefetch_lookahead);
+    }
+    ExecutionPlan plan(opt_graph);
+    if (!shared_key.empty()) {
+      auto& cache = sharedPlanCache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      cache.plans.emplace(std::move(shared_key), plan);
     }
-    FuseGraph(graph);
+    return plan;
   }
 
   static bool needsGradient(const std::shared_ptr<const Graph>& graph) {
@@ -719,17 +1106,99 @@ struct GraphExecutorImpl {
   ArgumentSpecCreator arg_spec_creator_;
   const size_t num_outputs;
 
-  // Populated only when optimize is false (and in that case plan_cache will be
-  // unused). The compiled version of graph.
+  // Populated only when optimize is false (and in that case the plan cache
+  // will be unused). The compiled version of graph.
   ExecutionPlan fallback;
 
-  // Mapping from argument configurations to optimized versions of the graph
-  // that are specialized to the spec.
-  std::unordered_map<ArgumentSpec, ExecutionPlan> plan_cache;
+  // Note [Sharded plan cache]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~
+  // The plan cache used to be one map behind one mutex taken on every
+  // call, which serialized all inference threads of shape-diverse
+  // workloads. Specs now hash to one of kPlanCacheShards shards, each with
+  // its own lock, so concurrent lookups only contend when they collide on
+  // a shard (and a compile only stalls its own shard). Entries are
+  // shared_ptrs: a running plan keeps itself alive even if it is evicted
+  // mid-execution. Eviction is off by default to preserve the historical
+  // never-erase behavior; setting PYTORCH_JIT_PLAN_CACHE_MAX_SPECS caps
+  // the total spec count, with least-recently-used unpinned entries
+  // dropped first. Pinned entries (currently the fixed-shape replay
+  // captures) are never evicted, which is what makes caching raw plan
+  // pointers sound. Hit/miss/eviction rates are published through the
+  // pytorch_runtime.* logging counters.
+  struct PlanEntry {
+    ExecutionPlan plan;
+    bool pinned = false;
+    std::atomic<uint64_t> last_use{0};
+  };
+  static constexpr size_t kPlanCacheShards = 8;
+  struct PlanCacheShard {
+    std::mutex mutex;
+    std::unordered_map<ArgumentSpec, std::shared_ptr<PlanEntry>> plans;
+    // See Note [Profile-guided specialization]. Number of times each
+    // not-yet-specialized spec has been observed; a spec is compiled on
+    // its kSpecializationThreshold-th sighting.
+    std::unordered_map<ArgumentSpec, size_t> spec_counts;
+  };
+  std::array<PlanCacheShard, kPlanCacheShards> plan_shards;
+  std::atomic<uint64_t> use_clock{0};
+  std::atomic<size_t> cached_plans{0};
+
+  // See Note [Wait-free cached-plan lookup]; never reused.
+  static uint64_t nextExecutorId() {
+    static std::atomic<uint64_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+  }
+  const uint64_t executor_id_ = nextExecutorId();
+
+  static constexpr size_t kSpecializationThreshold = 3;
+  static constexpr size_t kMaxProfiledSpecs = 1024;
+
+  static size_t planCacheCapacity() {
+    static const size_t capacity = []() -> size_t {
+      const char* env = std::getenv("PYTORCH_JIT_PLAN_CACHE_MAX_SPECS");
+      if (env == nullptr) {
+        return 0; // unbounded
+      }
+      const long parsed = std::atol(env);
+      return parsed > 0 ? static_cast<size_t>(parsed) : 0;
+    }();
+    return capacity;
+  }
 
-  // GraphExecutors can be accessed from multiple threads, so this thread needs
-  // to be held every time we access the fallback or plan_cache.
+  // GraphExecutors can be accessed from multiple threads, so this mutex
+  // needs to be held every time we access the fallback plan.
   std::mutex compile_mutex;
+
+  // Lazily computed content key for this executor's graph; see
+  // Note [Cross-executor plan sharing].
+  std::once_flag fingerprint_once_;
+  std::string graph_fingerprint_;
+
+  // One-shot snapshot-replay latch; see Note [Warm-start snapshots].
+  std::once_flag warm_start_once_;
+
+  // Note [Fixed-shape step replay]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Training loops that run the identical op sequence every iteration still
+  // pay ArgumentSpec construction, its hash, and the plan-cache lock on
+  // every step, and that overhead is visible at thousands of kernel
+  // launches per iteration. With PYTORCH_JIT_FIXED_SHAPE_REPLAY=1 the
+  // executor records the plan selected by the first run (one slot per
+  // GradMode state, since backward passes legitimately toggle it) and
+  // replays it directly afterwards. This is an explicit promise from the
+  // caller that shapes, dtypes and requires_grad states are fixed across
+  // steps; if they are not, the replayed plan's specializations no longer
+  // match the inputs and results are undefined. The captured entry is
+  // pinned in the plan cache (see Note [Sharded plan cache]), so the raw
+  // pointer stays valid even when eviction is enabled.
+  static bool fixedShapeReplayEnabled() {
+    static const bool enabled = []() {
+      const char* env = std::getenv("PYTORCH_JIT_FIXED_SHAPE_REPLAY");
+      return env != nullptr && env[0] == '1';
+    }();
+    return enabled;
+  }
+  std::atomic<const ExecutionPlan*> replay_plans[2] = {{nullptr}, {nullptr}};
 };
 
 GraphExecutor::GraphExecutor(std::shared_ptr<Graph> graph, bool optimize)
@@ -747,6 +1216,73 @@ GraphExecutorState GraphExecutor::getDebugState() {
   return pImpl->getDebugState();
 }
 
+// See Note [Warm-start snapshots]
+void enableWarmStartRecording(bool enabled) {
+  warmStartRegistry().recording.store(enabled, std::memory_order_relaxed);
+}
+
+void saveWarmStartSnapshot(const std::string& filename) {
+  auto& warm = warmStartRegistry();
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  AT_CHECK(
+      out, "could not open warm-start snapshot for writing: ", filename);
+  out.write(kWarmStartMagic, sizeof(kWarmStartMagic) - 1);
+  std::lock_guard<std::mutex> lock(warm.mutex);
+  writeWarmStartUint64(out, warm.recorded.size());
+  for (const auto& graph_entry : warm.recorded) {
+    writeWarmStartUint64(out, graph_entry.first.size());
+    out.write(graph_entry.first.data(), graph_entry.first.size());
+    writeWarmStartUint64(out, graph_entry.second.size());
+    for (const auto& words : graph_entry.second) {
+      writeWarmStartUint64(out, words.size());
+      out.write(
+          reinterpret_cast<const char*>(words.data()),
+          words.size() * sizeof(ArgumentInfo::plain_data_type));
+    }
+  }
+  AT_CHECK(out, "failed writing warm-start snapshot: ", filename);
+}
+
+void loadWarmStartSnapshot(const std::string& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  AT_CHECK(in, "could not open warm-start snapshot: ", filename);
+  char magic[sizeof(kWarmStartMagic) - 1];
+  in.read(magic, sizeof(magic));
+  AT_CHECK(
+      in && std::memcmp(magic, kWarmStartMagic, sizeof(magic)) == 0,
+      "not a warm-start snapshot: ",
+      filename);
+  auto& warm = warmStartRegistry();
+  const uint64_t num_graphs = readWarmStartUint64(in, filename);
+  for (uint64_t g = 0; g < num_graphs; ++g) {
+    const uint64_t fingerprint_size = readWarmStartUint64(in, filename);
+    std::string fingerprint(fingerprint_size, '\0');
+    in.read(&fingerprint[0], fingerprint_size);
+    AT_CHECK(in, "truncated warm-start snapshot: ", filename);
+    const uint64_t num_specs = readWarmStartUint64(in, filename);
+    std::vector<std::vector<ArgumentInfo::plain_data_type>> specs;
+    specs.reserve(num_specs);
+    for (uint64_t s = 0; s < num_specs; ++s) {
+      const uint64_t num_words = readWarmStartUint64(in, filename);
+      std::vector<ArgumentInfo::plain_data_type> words(num_words);
+      in.read(
+          reinterpret_cast<char*>(words.data()),
+          num_words * sizeof(ArgumentInfo::plain_data_type));
+      AT_CHECK(in, "truncated warm-start snapshot: ", filename);
+      specs.push_back(std::move(words));
+    }
+    std::lock_guard<std::mutex> lock(warm.mutex);
+    auto& pending = warm.pending[fingerprint];
+    if (pending.empty() && !specs.empty()) {
+      warm.pending_graphs.fetch_add(1, std::memory_order_release);
+    }
+    pending.insert(
+        pending.end(),
+        std::make_move_iterator(specs.begin()),
+        std::make_move_iterator(specs.end()));
+  }
+}
+
 void runRequiredPasses(const std::shared_ptr<Graph>& g) {
   specializeAutogradZero(*g);
   LowerGradOf(*g);
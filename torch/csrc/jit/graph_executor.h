@@ -27,6 +27,13 @@ struct GraphExecutorState {
 };
 
 struct GraphExecutorImpl;
+
+// GraphExecutor is safe to call from any number of threads concurrently:
+// compiled ExecutionPlans are immutable once published and every run
+// constructs a fresh InterpreterState, so no state is shared between
+// concurrent invocations of the same plan. Once a thread has run a given
+// argument spec once, subsequent runs with that spec take no locks at all;
+// see Note [Wait-free cached-plan lookup] in graph_executor.cpp.
 struct TORCH_API GraphExecutor {
   GraphExecutor() = default;
   GraphExecutor(std::shared_ptr<Graph> graph, bool optimize = true);
@@ -48,6 +55,15 @@ TORCH_API void runRequiredPasses(const std::shared_ptr<Graph>& g);
 TORCH_API void debugSetAutodiffSubgraphInlining(bool state);
 TORCH_API std::shared_ptr<Graph> lastExecutedOptimizedGraph();
 
+// Warm-start snapshots: record which argument specs each graph compiled
+// specialized plans for, save that set to disk, and load it in a fresh
+// process so the executors recompile their hot specializations ahead of
+// traffic instead of rediscovering them; see
+// Note [Warm-start snapshots] in graph_executor.cpp.
+TORCH_API void enableWarmStartRecording(bool enabled);
+TORCH_API void saveWarmStartSnapshot(const std::string& filename);
+TORCH_API void loadWarmStartSnapshot(const std::string& filename);
+
 namespace detail {
 
 GraphExecutor* getGradExecutor(Operation& op);
@@ -20,11 +20,25 @@
 
 #include <ATen/ATen.h>
 
+#include <c10/core/thread_pool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace torch {
 namespace jit {
 
@@ -34,6 +48,75 @@ using caffe2::serialize::ReadAdapterInterface;
 
 namespace {
 
+// A read-only mapping of an entire model file. Tensor storages can alias
+// into the mapping (see loadTensor), in which case the last storage alive
+// keeps the mapping (and with it the shared page cache across worker
+// processes) around via shared_ptr.
+struct MappedModelFile {
+  ~MappedModelFile() {
+#ifndef _WIN32
+    if (base != nullptr) {
+      munmap(base, size);
+    }
+#endif
+  }
+
+  static std::shared_ptr<MappedModelFile> open(const std::string& filename) {
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size == 0) {
+      ::close(fd);
+      return nullptr;
+    }
+    // MAP_PRIVATE keeps clean pages shared with other processes through the
+    // page cache, while in-place mutation of a loaded parameter transparently
+    // copies just the touched pages instead of faulting.
+    void* base = mmap(
+        nullptr,
+        st.st_size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE,
+        fd,
+        /*offset=*/0);
+    // The mapping holds its own reference to the file.
+    ::close(fd);
+    if (base == MAP_FAILED) {
+      return nullptr;
+    }
+    auto result = std::make_shared<MappedModelFile>();
+    result->base = base;
+    result->size = st.st_size;
+    return result;
+#else
+    return nullptr;
+#endif
+  }
+
+  void* base = nullptr;
+  size_t size = 0;
+};
+
+// Tensor DataPtrs that alias the mapping carry a heap-allocated shared_ptr
+// as their context; releasing the storage drops the reference.
+void dropMappingReference(void* ctx) {
+  delete static_cast<std::shared_ptr<MappedModelFile>*>(ctx);
+}
+
+bool mmapModelLoadingEnabled() {
+  const char* enable_env = getenv("PYTORCH_MMAP_MODEL_LOADING");
+  return enable_env != nullptr && atoi(enable_env) != 0;
+}
+
+// Kill switch for Note [Parallel method import] below.
+bool parallelModuleLoadingEnabled() {
+  const char* enable_env = getenv("TORCH_PARALLEL_MODULE_LOAD");
+  return enable_env == nullptr || atoi(enable_env) != 0;
+}
+
 // this is a deserializer class which loads script modules from pt files. the
 // content of the file is written using PyTorchStreamWriter, for details please
 // check caffe2/serialize/inline_container.h. all the records except the last
@@ -55,7 +138,17 @@ class ScriptModuleDeserializer final {
       const torch::TensorDef& tensor_proto,
       std::unordered_map<std::string, at::Storage>& storageMap);
 
+  // reconstructs the payload of `record_key` from a differential
+  // checkpoint; see Note [Differential checkpoints] in export.cpp
+  std::tuple<at::DataPtr, size_t> loadDeltaRecord(
+      const torch::TensorDeltaDef& delta,
+      const std::string& record_key);
+
+  caffe2::serialize::PyTorchStreamReader& deltaBaseReader(
+      const std::string& path);
+
   void convertModule(const torch::ModuleDef& module_def);
+  void importMethodTasks();
 
   void loadTensorTable(torch::ModelDef* model_def);
   void loadAttributeTable();
@@ -70,11 +163,37 @@ class ScriptModuleDeserializer final {
 
   std::vector<at::Tensor> tensor_table_;
   std::vector<IValue> attribute_table_;
+
+  // Method sources whose compilation was deferred so that independent
+  // modules can be compiled in parallel; see Note [Parallel method import].
+  struct MethodImportTask {
+    std::shared_ptr<script::Module> module;
+    std::string source;
+    size_t depth;
+  };
+  std::vector<MethodImportTask> method_tasks_;
+
+  // Set when loading from a file with PYTORCH_MMAP_MODEL_LOADING=1;
+  // uncompressed tensor records then alias the mapping instead of being
+  // copied into fresh storage.
+  std::shared_ptr<MappedModelFile> mmap_;
+
+  // Readers for the base checkpoints of differential tensor records,
+  // opened lazily and shared across the tensors that patch against the
+  // same container.
+  std::unordered_map<
+      std::string,
+      std::shared_ptr<caffe2::serialize::PyTorchStreamReader>>
+      delta_readers_;
 };
 
 ScriptModuleDeserializer::ScriptModuleDeserializer(const std::string& filename)
     : reader_(filename.c_str()) {
-  // TODO appropriate support for mmap, right now still use stream reader
+  if (mmapModelLoadingEnabled()) {
+    // Failure to map (e.g. on Windows) silently falls back to the copying
+    // reader below.
+    mmap_ = MappedModelFile::open(filename);
+  }
 }
 
 ScriptModuleDeserializer::ScriptModuleDeserializer(std::istream* is)
@@ -139,6 +258,7 @@ void ScriptModuleDeserializer::deserialize(
   // TODO: this can be simplified when C++/Python interop lands,
   // and the submodules would be created as the same in either C++ or Python
   convertModule(module_def);
+  importMethodTasks();
 }
 
 void ScriptModuleDeserializer::loadTensorTable(torch::ModelDef* model_def) {
@@ -189,7 +309,31 @@ at::Tensor ScriptModuleDeserializer::loadTensor(
   if (storage_it == storageMap.end()) {
     at::DataPtr storage_ptr;
     uint64_t record_size;
-    std::tie(storage_ptr, record_size) = reader_.getRecord(record_key);
+    if (tensor_proto.has_delta()) {
+      size_t delta_size;
+      std::tie(storage_ptr, delta_size) =
+          loadDeltaRecord(tensor_proto.delta(), record_key);
+      record_size = delta_size;
+    } else if (mmap_) {
+      size_t record_offset;
+      size_t mapped_size;
+      bool stored;
+      std::tie(record_offset, mapped_size, stored) =
+          reader_.getRecordInfo(record_key);
+      if (stored && record_offset + mapped_size <= mmap_->size) {
+        // PyTorchStreamWriter stores records uncompressed and 64-byte
+        // aligned, so the storage can point straight into the mapping.
+        storage_ptr = at::DataPtr(
+            static_cast<char*>(mmap_->base) + record_offset,
+            new std::shared_ptr<MappedModelFile>(mmap_),
+            &dropMappingReference,
+            at::kCPU);
+        record_size = mapped_size;
+      }
+    }
+    if (!storage_ptr) {
+      std::tie(storage_ptr, record_size) = reader_.getRecord(record_key);
+    }
     auto cpu_storage = at::Storage(
         at::CPU(type).typeMeta(),
         record_size / at::CPU(type).typeMeta().itemsize(),
@@ -239,6 +383,95 @@ at::Tensor ScriptModuleDeserializer::loadTensor(
   return result;
 }
 
+caffe2::serialize::PyTorchStreamReader& ScriptModuleDeserializer::
+    deltaBaseReader(const std::string& path) {
+  auto it = delta_readers_.find(path);
+  if (it == delta_readers_.end()) {
+    std::ifstream probe(path, std::ios::binary);
+    AT_CHECK(
+        probe,
+        "this is a differential checkpoint whose base checkpoint '",
+        path,
+        "' could not be opened; base checkpoints must stay on disk for ",
+        "the lifetime of the deltas written against them");
+    probe.close();
+    it = delta_readers_
+             .emplace(
+                 path,
+                 std::make_shared<caffe2::serialize::PyTorchStreamReader>(
+                     path.c_str()))
+             .first;
+  }
+  return *it->second;
+}
+
+std::tuple<at::DataPtr, size_t> ScriptModuleDeserializer::loadDeltaRecord(
+    const torch::TensorDeltaDef& delta,
+    const std::string& record_key) {
+  // See Note [Differential checkpoints] in export.cpp: `record_key` names
+  // a record physically (and fully) stored in the container at
+  // delta.base_path(), and the changed chunks, if any, live concatenated
+  // in this container's delta_data record. The writer always diffs
+  // against a fully stored record, so reconstruction is a single overlay
+  // -- never a recursive walk, however long the chain of saves is.
+  AT_CHECK(
+      delta.has_base_path() && !delta.base_path().empty(),
+      "malformed tensor delta for record '",
+      record_key,
+      "': no base checkpoint path");
+  at::DataPtr base_ptr;
+  size_t base_size;
+  std::tie(base_ptr, base_size) =
+      deltaBaseReader(delta.base_path()).getRecord(record_key);
+  const int64_t chunk_size = delta.chunk_size();
+  AT_CHECK(
+      chunk_size > 0,
+      "malformed tensor delta for record '",
+      record_key,
+      "': invalid chunk size ",
+      chunk_size);
+  const int64_t num_chunks =
+      (static_cast<int64_t>(base_size) + chunk_size - 1) / chunk_size;
+  AT_CHECK(
+      delta.chunk_changed_size() == num_chunks,
+      "tensor delta for record '",
+      record_key,
+      "' indexes ",
+      delta.chunk_changed_size(),
+      " chunks but the base record has ",
+      num_chunks);
+  if (delta.has_delta_data()) {
+    at::DataPtr changed_ptr;
+    size_t changed_size;
+    std::tie(changed_ptr, changed_size) =
+        reader_.getRecord(delta.delta_data().key());
+    const char* src = static_cast<const char*>(changed_ptr.get());
+    size_t consumed = 0;
+    for (int64_t i = 0; i < num_chunks; ++i) {
+      if (!delta.chunk_changed(i)) {
+        continue;
+      }
+      const size_t off = static_cast<size_t>(i) * chunk_size;
+      const size_t len = std::min<size_t>(chunk_size, base_size - off);
+      AT_CHECK(
+          consumed + len <= changed_size,
+          "tensor delta record '",
+          delta.delta_data().key(),
+          "' is shorter than its chunk index claims");
+      std::memcpy(static_cast<char*>(base_ptr.get()) + off, src + consumed, len);
+      consumed += len;
+    }
+    AT_CHECK(
+        consumed == changed_size,
+        "tensor delta record '",
+        delta.delta_data().key(),
+        "' has ",
+        changed_size - consumed,
+        " trailing bytes its chunk index does not account for");
+  }
+  return std::make_tuple(std::move(base_ptr), base_size);
+}
+
 void ScriptModuleDeserializer::convertModule(
     const torch::ModuleDef& module_def) {
   std::shared_ptr<script::Module> module = moduleLookup_(moduleStack_);
@@ -273,12 +506,89 @@ void ScriptModuleDeserializer::convertModule(
     );
   }
   if (module_def.has_torchscript_arena()) {
+    // The arena record is read here, on the deserializer's thread, because
+    // PyTorchStreamReader seeks and is not safe to share; compilation of
+    // the source is deferred so that independent modules can be compiled
+    // concurrently. See Note [Parallel method import].
     at::DataPtr data;
     size_t size;
     std::tie(data, size) =
         reader_.getRecord(module_def.torchscript_arena().key());
     std::string data_str(static_cast<const char*>(data.get()), size);
-    script::import_methods(module, data_str, tensor_table_);
+    method_tasks_.push_back(
+        {module, std::move(data_str), moduleStack_.size()});
+  }
+}
+
+// Note [Parallel method import]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Compiling method sources dominates load time for modules with many
+// methods, and the work is almost embarrassingly parallel: each arena is
+// compiled into its own module, reading only the shared tensor table, and
+// the global structures the compiler does touch (the operator registry,
+// interned symbols) are already synchronized for concurrent registration.
+// The one ordering constraint is between a module and its submodules: a
+// method may call into self.submodule.method(), which the compiler
+// resolves against the submodule's already-compiled methods. The recursive
+// importer satisfied this by finishing children before parents, so here
+// tasks are grouped by depth in the module tree and levels are compiled
+// deepest-first, with the modules within a level -- which cannot reference
+// one another -- farmed out to the inter-op thread pool.
+//
+// TORCH_PARALLEL_MODULE_LOAD=0 restores the sequential import.
+void ScriptModuleDeserializer::importMethodTasks() {
+  if (method_tasks_.empty()) {
+    return;
+  }
+  // convertModule pushed tasks in post-order (children before parents),
+  // which is exactly the order the recursive importer compiled them in.
+  if (!parallelModuleLoadingEnabled() || method_tasks_.size() == 1 ||
+      c10::global_work_queue().inThreadPool()) {
+    for (const auto& task : method_tasks_) {
+      script::import_methods(task.module, task.source, tensor_table_);
+    }
+    return;
+  }
+
+  size_t max_depth = 0;
+  for (const auto& task : method_tasks_) {
+    max_depth = std::max(max_depth, task.depth);
+  }
+  std::vector<std::vector<const MethodImportTask*>> levels(max_depth + 1);
+  for (const auto& task : method_tasks_) {
+    levels[task.depth].push_back(&task);
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  for (size_t depth = max_depth + 1; depth > 0; --depth) {
+    const auto& level = levels[depth - 1];
+    size_t remaining = level.size();
+    std::exception_ptr error;
+    for (const MethodImportTask* task : level) {
+      c10::global_work_queue().run([&, task]() {
+        std::exception_ptr task_error;
+        try {
+          script::import_methods(task->module, task->source, tensor_table_);
+        } catch (...) {
+          task_error = std::current_exception();
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        if (task_error && !error) {
+          error = task_error;
+        }
+        if (--remaining == 0) {
+          cv.notify_one();
+        }
+      });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return remaining == 0; });
+    if (error) {
+      // Every task of this level has finished and deeper levels are
+      // complete, so it is safe to unwind.
+      std::rethrow_exception(error);
+    }
   }
 }
 
@@ -3,6 +3,9 @@
 #include <torch/csrc/jit/script/parser.h>
 #include <torch/csrc/jit/script/resolver.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace torch {
 namespace jit {
 namespace script {
@@ -105,55 +108,88 @@ struct SourceResolver : public Resolver {
   std::unordered_map<std::string, std::shared_ptr<SugaredValue>> env_;
 };
 
+size_t parseVersionNumber(Lexer& L) {
+  auto range = L.cur().range;
+  auto name = L.expect(TK_IDENT).text();
+  L.expect('=');
+  std::string version_text = L.expect(TK_NUMBER).text();
+  L.expect(TK_NEWLINE);
+  auto version = Const::create(L.cur().range, version_text);
+  if (name != "op_version_set")
+    throw ErrorReport(range) << "expected an assignment to op_version_set";
+  if (!version.isIntegral())
+    throw ErrorReport(range)
+        << "expected an integral version but found " << version.text();
+  return size_t(version.asIntegral());
+}
+
 // Helper that contains the state for a parsing a TorchScript source string.
 struct SourceImporter {
   SourceImporter(
       const std::string& src,
       const std::vector<at::Tensor>& constant_table)
       : parser_(src) {
-    const auto version = parseVersionNumber();
+    const auto version = parseVersionNumber(parser_.lexer());
     resolver_ = std::make_shared<SourceResolver>(version, constant_table);
   }
 
   Parser parser_;
   ResolverPtr resolver_;
+};
 
-  size_t parseVersionNumber() {
-    auto& L = parser_.lexer();
-    auto range = L.cur().range;
-    auto name = L.expect(TK_IDENT).text();
-    L.expect('=');
-    std::string version_text = L.expect(TK_NUMBER).text();
-    L.expect(TK_NEWLINE);
-    auto version = Const::create(L.cur().range, version_text);
-    if (name != "op_version_set")
-      throw ErrorReport(range) << "expected an assignment to op_version_set";
-    if (!version.isIntegral())
-      throw ErrorReport(range)
-          << "expected an integral version but found " << version.text();
-    return size_t(version.asIntegral());
-  }
+// Loading N instances of the same model re-lexes and re-parses the same
+// method source N times. Trees are immutable once built, so the parsed
+// definitions can be shared across loads; compilation still runs per
+// module because the methods bind to each instance's type. The cache is
+// keyed by the full source text and capped; once full, new sources are
+// simply parsed without being cached.
+struct ParsedMethods {
+  size_t version;
+  std::vector<Def> definitions;
 };
 
+constexpr size_t kParseCacheMaxEntries = 64;
+
+ParsedMethods parseMethods(const std::string& src) {
+  static std::mutex parse_mutex;
+  static std::unordered_map<std::string, ParsedMethods> parse_cache;
+  {
+    std::lock_guard<std::mutex> lock(parse_mutex);
+    auto it = parse_cache.find(src);
+    if (it != parse_cache.end()) {
+      // Defs are shared_ptr-backed trees; copying the vector is cheap.
+      return it->second;
+    }
+  }
+
+  Parser p(src);
+  ParsedMethods parsed;
+  parsed.version = parseVersionNumber(p.lexer());
+  while (p.lexer().cur().kind != TK_EOF) {
+    parsed.definitions.emplace_back(Def(p.parseFunction(/*is_method=*/true)));
+  }
+
+  std::lock_guard<std::mutex> lock(parse_mutex);
+  if (parse_cache.size() < kParseCacheMaxEntries) {
+    parse_cache.emplace(src, parsed);
+  }
+  return parsed;
+}
+
 void import_methods(
     const std::shared_ptr<Module>& mod,
     const std::string& src,
     const std::vector<at::Tensor>& constant_table) {
-  SourceImporter importer(src, constant_table);
-  auto& p = importer.parser_;
-
-  std::vector<Def> definitions;
-  std::vector<ResolverPtr> resolvers;
-  while (p.lexer().cur().kind != TK_EOF) {
-    auto def = Def(p.parseFunction(/*is_method=*/true));
-    definitions.emplace_back(def);
-    resolvers.emplace_back(importer.resolver_);
-  }
+  auto parsed = parseMethods(src);
+  auto resolver =
+      std::make_shared<SourceResolver>(parsed.version, constant_table);
+  std::vector<ResolverPtr> resolvers(parsed.definitions.size(), resolver);
   auto self = [&](Value* v) {
     v->setType(mod->module_object()->type());
     return std::make_shared<SimpleValue>(v);
   };
-  mod->module_object()->type()->compilation_unit().define(definitions, resolvers, self);
+  mod->module_object()->type()->compilation_unit().define(
+      parsed.definitions, resolvers, self);
 }
 
 void import_libs(
@@ -16,6 +16,7 @@
 #include <torch/csrc/jit/script/jit_exception.h>
 #include <torch/csrc/jit/script/logging.h>
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <memory>
@@ -327,12 +328,27 @@ struct UseList {
   ListHandle<bool> free_flags;
 };
 
+// Specialized opcodes resolved when the Code is constructed. Instructions
+// tagged with anything other than OP are executed directly on the register
+// table with a precomputed jump offset, skipping both the std::function
+// call through `callback` and the push/pop traffic on the IValue stack.
+// This matters for small graphs where dispatch overhead dominates.
+enum class OpCode : uint8_t {
+  OP, // generic: dispatch through `callback`
+  ASSIGN, // register-to-register move
+  JUMP, // unconditional relative jump
+  JUMP_TRUE, // jump when the condition register is true
+  JUMP_FALSE, // jump when the condition register is false
+};
+
 // one instruction plus meta-data
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
 struct Instruction {
   Operation callback;
   UseList inputs;
   ListHandle<int> outputs;
+  OpCode op = OpCode::OP;
+  int jump_offset = 0; // relative offset for the JUMP* opcodes
   Symbol debug_name; // used in dump to understand the generated code
   std::shared_ptr<SourceLocation> debug_location; // for error reporting
 };
@@ -356,6 +372,8 @@ struct CodeImpl {
       auto t = pop(stack).toBool();
       return t ? 0 : offset;
     };
+    inst.op = OpCode::JUMP_FALSE;
+    inst.jump_offset = offset;
     inst.debug_name = prim::JumpZ;
   }
 
@@ -368,6 +386,8 @@ struct CodeImpl {
       auto t = pop(stack).toBool();
       return t ? offset : 0;
     };
+    inst.op = OpCode::JUMP_TRUE;
+    inst.jump_offset = offset;
     inst.debug_name = prim::JumpNZ;
   }
 
@@ -376,6 +396,8 @@ struct CodeImpl {
     AT_ASSERT(inst.debug_name == prim::Placeholder);
     auto offset = relativeJump(from_inst, to_inst);
     inst.callback = [=](Stack& stack) { return offset; };
+    inst.op = OpCode::JUMP;
+    inst.jump_offset = offset;
     inst.debug_name = prim::Jump;
   }
 
@@ -533,6 +555,7 @@ struct CodeImpl {
     // all inputs are also outputs, and the interpreter will take care of
     // putting them in correct places.
     instructions[inst].callback = [](Stack& stack) { return 0; };
+    instructions[inst].op = OpCode::ASSIGN;
     return inst;
   }
 
@@ -654,13 +677,70 @@ struct CodeImpl {
   std::vector<bool> bool_data;
 };
 
+static std::vector<std::vector<IValue>>& registerBufferPool() {
+  static thread_local std::vector<std::vector<IValue>> pool;
+  return pool;
+}
+
+// Recycled per-thread register buffers. Every interpreter invocation needs
+// an IValue vector sized to the code's register table; reusing retired
+// buffers (capacity intact) keeps the allocator out of per-call setup.
+static std::vector<IValue> acquireRegisterBuffer(size_t size) {
+  auto& spares = registerBufferPool();
+  if (!spares.empty()) {
+    std::vector<IValue> buffer = std::move(spares.back());
+    spares.pop_back();
+    buffer.resize(size);
+    return buffer;
+  }
+  return std::vector<IValue>(size);
+}
+
+static void releaseRegisterBuffer(std::vector<IValue>&& buffer) {
+  // Batched refcount release: at frame teardown the register file often
+  // holds several copies of the same TensorImpl (an input that fans out
+  // is copied into every use's register). Dropping the IValues one by
+  // one would pay an atomic decrement per register; instead take the
+  // references out without touching the counts, group them by target,
+  // and release each distinct target with a single decref_n.
+  static thread_local std::vector<c10::intrusive_ptr_target*> owned;
+  owned.clear();
+  for (auto& v : buffer) {
+    auto* p = v.unsafeReleaseIntrusivePtr();
+    if (p != nullptr) {
+      owned.push_back(p);
+    }
+  }
+  std::sort(owned.begin(), owned.end());
+  for (size_t i = 0; i < owned.size();) {
+    size_t j = i + 1;
+    while (j < owned.size() && owned[j] == owned[i]) {
+      ++j;
+    }
+    c10::raw::intrusive_ptr::decref_n(owned[i], j - i);
+    i = j;
+  }
+  owned.clear();
+
+  constexpr size_t kMaxSpareBuffers = 8;
+  auto& spares = registerBufferPool();
+  if (spares.size() < kMaxSpareBuffers) {
+    buffer.clear();
+    spares.push_back(std::move(buffer));
+  }
+}
+
 // InterpreterState state that and used to compute a Code
 struct InterpreterStateImpl : c10::intrusive_ptr_target {
   InterpreterStateImpl(const Code& code)
       : function(code.pImpl),
         int_data(function->int_data.data()),
         bool_data(function->bool_data),
-        registers(function->register_size) {}
+        registers(acquireRegisterBuffer(function->register_size)) {}
+
+  ~InterpreterStateImpl() override {
+    releaseRegisterBuffer(std::move(registers));
+  }
 
  private:
   c10::intrusive_ptr<InterpreterStateImpl> intrusive_from_this() {
@@ -678,14 +758,51 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
       // std::cout << "\n";
       auto& inst = instructions[pc];
       try {
-        loadTensorsFromRegisters(inst.inputs, stack);
-        size_t new_pc = pc + 1 + inst.callback(stack);
-        for (int i = inst.outputs.size - 1; i >= 0; --i) {
-          int reg = get(inst.outputs, i);
-          registers[reg] = pop(stack);
-          // std::cout << "pop reg[" << reg << "];\n" << registers[reg] << "\n";
+        switch (inst.op) {
+          // The opcodes below were pre-resolved when the Code was built and
+          // operate directly on the register table, bypassing the callback
+          // and the IValue stack entirely.
+          case OpCode::JUMP:
+            pc = pc + 1 + inst.jump_offset;
+            break;
+          case OpCode::JUMP_TRUE:
+          case OpCode::JUMP_FALSE: {
+            bool t = readCondRegister(inst.inputs);
+            bool taken = (inst.op == OpCode::JUMP_TRUE) ? t : !t;
+            pc = pc + 1 + (taken ? inst.jump_offset : 0);
+          } break;
+          case OpCode::ASSIGN: {
+            // Equivalent to pushing all inputs and popping them back into the
+            // outputs: read every input before writing any output so aliased
+            // registers behave the same as they would through the stack.
+            const auto& uses = inst.inputs;
+            for (int i = 0; i < uses.values.size; i++) {
+              int reg = get(uses.values, i);
+              if (get(uses.free_flags, i)) {
+                assign_buffer.emplace_back(std::move(registers[reg]));
+              } else {
+                assign_buffer.emplace_back(registers[reg]);
+              }
+            }
+            for (int i = inst.outputs.size - 1; i >= 0; --i) {
+              registers[get(inst.outputs, i)] =
+                  std::move(assign_buffer[static_cast<size_t>(i)]);
+            }
+            assign_buffer.clear();
+            ++pc;
+          } break;
+          case OpCode::OP: {
+            loadTensorsFromRegisters(inst.inputs, stack);
+            size_t new_pc = pc + 1 + inst.callback(stack);
+            for (int i = inst.outputs.size - 1; i >= 0; --i) {
+              int reg = get(inst.outputs, i);
+              registers[reg] = pop(stack);
+              // std::cout << "pop reg[" << reg << "];\n" << registers[reg] <<
+              // "\n";
+            }
+            pc = new_pc;
+          } break;
         }
-        pc = new_pc;
       } catch (Suspend& e) {
         // wait() expects a single input
         AT_ASSERT(inst.inputs.values.size == 1);
@@ -785,6 +902,17 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
   bool get(const ListHandle<bool>& list, int i) {
     return bool_data[list.start + i];
   }
+  // Read the single condition input of a JUMP_TRUE/JUMP_FALSE instruction
+  // straight from its register, honoring the move flag, without a round trip
+  // through the stack.
+  bool readCondRegister(const UseList& uses) {
+    int reg = get(uses.values, 0);
+    if (get(uses.free_flags, 0)) {
+      IValue v = std::move(registers[reg]);
+      return v.toBool();
+    }
+    return registers[reg].toBool();
+  }
   void loadTensorsFromRegisters(const UseList& uses, Stack& stack) {
     for (int i = 0; i < uses.values.size; i++) {
       int reg = get(uses.values, i);
@@ -820,6 +948,10 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
   // single buffer for input/output calls to ATen functions, so that we do not
   // reallocate
   Stack stack;
+
+  // scratch buffer for OpCode::ASSIGN register moves, kept across
+  // instructions so it does not reallocate
+  std::vector<IValue> assign_buffer;
 };
 
 std::ostream& operator<<(std::ostream& out, const Code& code) {
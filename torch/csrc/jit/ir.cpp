@@ -7,7 +7,9 @@
 #include <torch/csrc/jit/script/schema_matching.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <set>
 #include <sstream>
 #include <stack>
@@ -19,6 +21,90 @@
 namespace torch {
 namespace jit {
 
+namespace {
+
+// Recycled per-thread allocation pool for IR objects. Building a graph
+// during tracing allocates and frees Nodes and Values by the thousands;
+// serving them from size-bucketed freelists keeps malloc/free off the hot
+// path. Blocks are bucketed by their size rounded up to the granularity;
+// oversized or surplus blocks go straight to the system allocator. An
+// object may be freed on a different thread than it was allocated on, in
+// which case the block simply migrates to that thread's pool.
+constexpr size_t kIRPoolGranularity = 64;
+constexpr size_t kIRPoolMaxBlockSize = 1024;
+constexpr size_t kIRPoolMaxFreePerBucket = 1024;
+
+struct IRObjectPool {
+  std::vector<void*> buckets[kIRPoolMaxBlockSize / kIRPoolGranularity];
+
+  ~IRObjectPool() {
+    for (auto& bucket : buckets) {
+      for (void* ptr : bucket) {
+        std::free(ptr);
+      }
+    }
+  }
+
+  void* allocate(size_t size) {
+    size_t rounded = roundUp(size);
+    void* ptr;
+    if (rounded > kIRPoolMaxBlockSize) {
+      ptr = std::malloc(size);
+    } else {
+      auto& bucket = buckets[rounded / kIRPoolGranularity - 1];
+      if (!bucket.empty()) {
+        ptr = bucket.back();
+        bucket.pop_back();
+        return ptr;
+      }
+      ptr = std::malloc(rounded);
+    }
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  void release(void* ptr, size_t size) {
+    size_t rounded = roundUp(size);
+    if (rounded <= kIRPoolMaxBlockSize) {
+      auto& bucket = buckets[rounded / kIRPoolGranularity - 1];
+      if (bucket.size() < kIRPoolMaxFreePerBucket) {
+        bucket.push_back(ptr);
+        return;
+      }
+    }
+    std::free(ptr);
+  }
+
+  static size_t roundUp(size_t size) {
+    return (size + kIRPoolGranularity - 1) & ~(kIRPoolGranularity - 1);
+  }
+};
+
+IRObjectPool& irObjectPool() {
+  static thread_local IRObjectPool pool;
+  return pool;
+}
+
+} // namespace
+
+void* Value::operator new(size_t size) {
+  return irObjectPool().allocate(size);
+}
+
+void Value::operator delete(void* ptr, size_t size) {
+  irObjectPool().release(ptr, size);
+}
+
+void* Node::operator new(size_t size) {
+  return irObjectPool().allocate(size);
+}
+
+void Node::operator delete(void* ptr, size_t size) {
+  irObjectPool().release(ptr, size);
+}
+
 void printQuotedString(std::ostream& stmt, const std::string& str);
 
 // Constants relating to maintaining the topological index of nodes.
@@ -832,6 +918,9 @@ bool Node::hasSideEffects() const {
     case prim::Print:
     case prim::RaiseException:
     case prim::SetAttr:
+    // Conservative: the callee may mutate its arguments or raise, and this
+    // is checked by plain (alias-unaware) dead code elimination.
+    case prim::CallFunction:
     case aten::warn:
     case aten::manual_seed:
     case prim::AddStatValue:
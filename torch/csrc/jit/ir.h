@@ -150,6 +150,12 @@ struct Value {
   TH_DISALLOW_COPY_AND_ASSIGN(Value);
   Value(Node* node_, size_t offset_);
 
+  // Values are created and destroyed at a high rate during tracing and
+  // graph transformation; they are served from a recycled per-thread pool
+  // instead of the system allocator (see ir.cpp).
+  TORCH_API static void* operator new(size_t size);
+  TORCH_API static void operator delete(void* ptr, size_t size);
+
  private:
   friend struct Node;
   friend struct Graph;
@@ -625,6 +631,12 @@ struct Node {
 
   virtual ~Node() = default;
 
+  // Like Value, Nodes come from a recycled per-thread pool (see ir.cpp).
+  // The sized delete receives the most-derived size thanks to the virtual
+  // destructor, so subclasses recycle into the right bucket.
+  TORCH_API static void* operator new(size_t size);
+  TORCH_API static void operator delete(void* ptr, size_t size);
+
   // Methods for accessing attributes
   void copyAttributes(const Node& rhs) {
     values_.clear();
@@ -6,6 +6,8 @@
 #include <torch/csrc/jit/script/edit_distance.h>
 #include <torch/csrc/jit/script/error_report.h>
 
+#include <atomic>
+#include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -37,6 +39,25 @@ struct OperatorRegistry {
   std::unordered_map<const char*, std::shared_ptr<Operator>>
       operators_by_sig_literal;
 
+  // Note [Dense operator table]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // getOperators sits on the dispatch path of every uncached call site, and
+  // taking the registry mutex plus hashing the Symbol there is measurable.
+  // Symbols are interned integers, so once all pending registrations have
+  // been folded in we publish a dense table indexed by the symbol's unique
+  // id; lookups are then a single bounds-checked array index with no lock
+  // and no hashing. Registering an operator invalidates the table (readers
+  // fall back to the locked path), and it is rebuilt on the next lookup.
+  // A symbol interned after the table was built cannot have operators --
+  // registering one would have invalidated the table -- so an out-of-range
+  // index means "no operators". Replaced tables are retired rather than
+  // freed, since a concurrent reader may still hold a pointer into one.
+  struct DenseTable {
+    std::vector<const std::vector<std::shared_ptr<Operator>>*> by_symbol;
+  };
+  std::atomic<DenseTable*> dense_table{nullptr};
+  std::vector<std::unique_ptr<DenseTable>> retired_tables;
+
   // XXX - caller must be holding lock
   void registerPendingOperators() {
     for (const auto& op : to_register) {
@@ -47,10 +68,27 @@ struct OperatorRegistry {
     to_register.clear();
   }
 
+  // XXX - caller must be holding lock; see Note [Dense operator table]
+  void rebuildDenseTable() {
+    std::unique_ptr<DenseTable> table(new DenseTable());
+    size_t num_slots = 0;
+    for (const auto& entry : operators) {
+      num_slots = std::max(
+          num_slots, static_cast<size_t>(static_cast<c10::unique_t>(entry.first)) + 1);
+    }
+    table->by_symbol.resize(num_slots, nullptr);
+    for (const auto& entry : operators) {
+      table->by_symbol[static_cast<c10::unique_t>(entry.first)] = &entry.second;
+    }
+    dense_table.store(table.get(), std::memory_order_release);
+    retired_tables.push_back(std::move(table));
+  }
+
  public:
   void registerOperator(Operator&& op) {
     std::lock_guard<std::mutex> guard(lock);
     to_register.push_back(std::make_shared<Operator>(std::move(op)));
+    dense_table.store(nullptr, std::memory_order_release);
   }
 
   const std::shared_ptr<Operator>& lookupByLiteral(const char* name) {
@@ -79,9 +117,19 @@ struct OperatorRegistry {
   }
 
   const std::vector<std::shared_ptr<Operator>>& getOperators(Symbol name) {
+    static std::vector<std::shared_ptr<Operator>> empty;
+    // Fast path: see Note [Dense operator table].
+    if (auto* table = dense_table.load(std::memory_order_acquire)) {
+      const auto index = static_cast<size_t>(static_cast<c10::unique_t>(name));
+      if (index < table->by_symbol.size() &&
+          table->by_symbol[index] != nullptr) {
+        return *table->by_symbol[index];
+      }
+      return empty;
+    }
     std::lock_guard<std::mutex> guard(lock);
     registerPendingOperators();
-    static std::vector<std::shared_ptr<Operator>> empty;
+    rebuildDenseTable();
     auto it = operators.find(name);
     if (it != operators.end())
       return it->second;
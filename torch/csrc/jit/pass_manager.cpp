@@ -1,5 +1,21 @@
 #include <torch/csrc/jit/pass_manager.h>
 
+#include <torch/csrc/autograd/record_function.h>
+#include <torch/csrc/jit/passes/batch_mm.h>
+#include <torch/csrc/jit/passes/common_subexpression_elimination.h>
+#include <torch/csrc/jit/passes/constant_pooling.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/graph_fuser.h>
+#include <torch/csrc/jit/passes/inplace_check.h>
+#include <torch/csrc/jit/passes/loop_unrolling.h>
+#include <torch/csrc/jit/passes/peephole.h>
+
+#include <c10/util/Exception.h>
+
+#include <chrono>
+#include <mutex>
+
 namespace torch {
 namespace jit {
 
@@ -12,5 +28,180 @@ RegisterPass::RegisterPass(Pass p) {
   getCustomPasses().emplace_back(std::move(p));
 }
 
+namespace {
+
+struct ScheduleRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, PassSchedule> schedules;
+  std::string active = "max-opt";
+  bool seeded = false;
+};
+
+ScheduleRegistry& scheduleRegistry() {
+  static ScheduleRegistry r;
+  return r;
+}
+
+struct TimingRegistry {
+  std::mutex mutex;
+  pass_timings timings;
+};
+
+TimingRegistry& timingRegistry() {
+  static TimingRegistry r;
+  return r;
+}
+
+// The custom-pass hook participates in scheduling (and timing) as one
+// entry, so backends registered through RegisterPass keep running under
+// every schedule.
+ScheduledPass customPassesEntry() {
+  ScheduledPass scheduled;
+  scheduled.name = "custom_passes";
+  scheduled.pass = [](std::shared_ptr<Graph>& graph) {
+    for (const auto& pass : getCustomPasses()) {
+      pass(graph);
+    }
+  };
+  return scheduled;
+}
+
+ScheduledPass make(const char* name, Pass pass, bool expensive) {
+  ScheduledPass scheduled;
+  scheduled.name = name;
+  scheduled.pass = std::move(pass);
+  scheduled.expensive = expensive;
+  return scheduled;
+}
+
+// Must be called with the schedule registry mutex held.
+void seedBuiltinSchedulesLocked(ScheduleRegistry& reg) {
+  if (reg.seeded) {
+    return;
+  }
+  reg.seeded = true;
+
+  auto dce = [](std::shared_ptr<Graph>& g) { EliminateDeadCode(g); };
+  auto cse = [](std::shared_ptr<Graph>& g) {
+    EliminateCommonSubexpression(g);
+  };
+  auto pooling = [](std::shared_ptr<Graph>& g) { ConstantPooling(g); };
+  auto peephole = [](std::shared_ptr<Graph>& g) { PeepholeOptimize(g); };
+  auto constprop = [](std::shared_ptr<Graph>& g) { ConstantPropagation(g); };
+  auto unroll = [](std::shared_ptr<Graph>& g) { UnrollLoops(g); };
+  auto batch_mm = [](std::shared_ptr<Graph>& g) { BatchMM(g); };
+  auto check_inplace = [](std::shared_ptr<Graph>& g) { CheckInplace(g); };
+  auto fuse = [](std::shared_ptr<Graph>& g) { FuseGraph(g); };
+
+  // The historical pipeline, verbatim. The alias-analysis-heavy passes
+  // (CSE, loop unrolling, BatchMM, fusion) are the expensive ones;
+  // CheckInplace is a correctness check and is never skippable.
+  PassSchedule max_opt;
+  max_opt.optimization.push_back(make("dce", dce, false));
+  max_opt.optimization.push_back(make("cse", cse, true));
+  max_opt.optimization.push_back(make("constant_pooling", pooling, false));
+  max_opt.optimization.push_back(make("peephole", peephole, false));
+  max_opt.optimization.push_back(make("constant_propagation", constprop, false));
+  max_opt.optimization.push_back(make("unroll_loops", unroll, true));
+  max_opt.optimization.push_back(make("cse", cse, true));
+  max_opt.optimization.push_back(make("batch_mm", batch_mm, true));
+  max_opt.optimization.push_back(make("check_inplace", check_inplace, false));
+  max_opt.nondiff_optimization.push_back(customPassesEntry());
+  max_opt.nondiff_optimization.push_back(make("fuse_graph", fuse, true));
+  reg.schedules.emplace("max-opt", std::move(max_opt));
+
+  // For load-latency-sensitive deploys: the cheap scalar passes only,
+  // with a budget so even fusion is dropped when compilation runs long.
+  PassSchedule fast_load;
+  fast_load.optimization.push_back(make("dce", dce, false));
+  fast_load.optimization.push_back(make("peephole", peephole, false));
+  fast_load.optimization.push_back(
+      make("constant_propagation", constprop, false));
+  fast_load.optimization.push_back(make("check_inplace", check_inplace, false));
+  fast_load.nondiff_optimization.push_back(customPassesEntry());
+  fast_load.nondiff_optimization.push_back(make("fuse_graph", fuse, true));
+  fast_load.budget_ms = 250;
+  reg.schedules.emplace("fast-load", std::move(fast_load));
+}
+
+} // namespace
+
+void registerPassSchedule(std::string name, PassSchedule schedule) {
+  auto& reg = scheduleRegistry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  seedBuiltinSchedulesLocked(reg);
+  reg.schedules[std::move(name)] = std::move(schedule);
+}
+
+void setPassSchedule(const std::string& name) {
+  auto& reg = scheduleRegistry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  seedBuiltinSchedulesLocked(reg);
+  AT_CHECK(
+      reg.schedules.count(name) != 0, "unknown pass schedule: ", name);
+  reg.active = name;
+}
+
+std::string currentPassScheduleName() {
+  auto& reg = scheduleRegistry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  return reg.active;
+}
+
+PassSchedule currentPassSchedule() {
+  auto& reg = scheduleRegistry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  seedBuiltinSchedulesLocked(reg);
+  return reg.schedules.at(reg.active);
+}
+
+void runPassPhase(
+    const PassSchedule& schedule,
+    const std::vector<ScheduledPass>& phase,
+    std::shared_ptr<Graph>& graph,
+    PassBudget& budget) {
+  for (const auto& scheduled : phase) {
+    const bool over_budget =
+        schedule.budget_ms > 0 && budget.spent_ms > schedule.budget_ms;
+    if (over_budget && scheduled.expensive) {
+      auto& timing_reg = timingRegistry();
+      std::lock_guard<std::mutex> guard(timing_reg.mutex);
+      timing_reg.timings[scheduled.name].skips++;
+      continue;
+    }
+
+    autograd::profiler::RecordFunction guard;
+    if (autograd::profiler::hasCallbacks()) {
+      guard.before("jit::pass::" + scheduled.name);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    scheduled.pass(graph);
+    const double us =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count() /
+        1000.0;
+
+    budget.spent_ms += us / 1000.0;
+    auto& timing_reg = timingRegistry();
+    std::lock_guard<std::mutex> timing_guard(timing_reg.mutex);
+    auto& timing = timing_reg.timings[scheduled.name];
+    timing.runs++;
+    timing.total_us += us;
+  }
+}
+
+pass_timings getPassTimings() {
+  auto& reg = timingRegistry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  return reg.timings;
+}
+
+void clearPassTimings() {
+  auto& reg = timingRegistry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  reg.timings.clear();
+}
+
 } // namespace jit
 } // namespace torch
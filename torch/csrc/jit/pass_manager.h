@@ -2,6 +2,11 @@
 
 #include <torch/csrc/jit/ir.h>
 
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 /* `getCustomPasses()` returns a vector of passes that will be executed after
  * differentiation but before any fusion.  This is the de-facto location
  * for compiler backends to insert passes.
@@ -11,6 +16,16 @@
  *
  * pass_manager.h uses a Meyer's singleton
  * to store a vector of `Pass`es, which modify the IR graph in place.
+ *
+ * Beyond the custom-pass hook, this file owns the executor's optimization
+ * pipeline as named *schedules*. A schedule lists the passes of each
+ * optimization phase together with a wall-time budget, so deployments can
+ * trade compile time for graph quality: the built-in "max-opt" schedule
+ * is the historical pipeline, and "fast-load" drops the
+ * alias-analysis-heavy passes whose cost dwarfs their benefit when load
+ * latency matters. Every pass run is timed; the totals are queryable via
+ * getPassTimings() and each run also reports as a "jit::pass::<name>"
+ * event to whatever profiler mode is active.
  */
 
 namespace torch {
@@ -25,5 +40,67 @@ struct RegisterPass {
   RegisterPass(Pass p);
 };
 
+struct ScheduledPass {
+  std::string name;
+  Pass pass;
+  // Expensive passes are the ones budget-based early exit may skip;
+  // passes the executor needs for correctness (inplace checking and the
+  // like) must not be marked expensive.
+  bool expensive = false;
+};
+
+struct PassSchedule {
+  // Run on the whole graph while it is still differentiable.
+  std::vector<ScheduledPass> optimization;
+  // Run after differentiation, before execution; custom backend passes
+  // and fusion live here.
+  std::vector<ScheduledPass> nondiff_optimization;
+  // Wall-time budget for one compilation, in milliseconds; 0 means
+  // unlimited. Once the passes already run exceed the budget, the
+  // remaining expensive passes of that compilation are skipped.
+  double budget_ms = 0;
+};
+
+// Registers (or replaces) a named schedule. "max-opt" and "fast-load"
+// are built in; "max-opt" is the default.
+TORCH_API void registerPassSchedule(std::string name, PassSchedule schedule);
+
+// Selects the schedule used by subsequent compilations. The selection is
+// read each time a spec is compiled, so a canary deploy can load its
+// modules under "fast-load" and switch back to "max-opt" for steady
+// state without restarting. Throws if no schedule with that name is
+// registered.
+TORCH_API void setPassSchedule(const std::string& name);
+TORCH_API std::string currentPassScheduleName();
+
+// Snapshot of the selected schedule, taken once per compilation by the
+// graph executor.
+TORCH_API PassSchedule currentPassSchedule();
+
+// Wall time already spent compiling one spec; shared across the phases
+// of that compilation so the budget covers it as a whole.
+struct PassBudget {
+  double spent_ms = 0;
+};
+
+// Runs one phase of `schedule` over `graph`: each pass is timed into the
+// cumulative registry (and surfaced to any active profiler mode), and
+// expensive passes are skipped once the budget is exhausted.
+TORCH_API void runPassPhase(
+    const PassSchedule& schedule,
+    const std::vector<ScheduledPass>& phase,
+    std::shared_ptr<Graph>& graph,
+    PassBudget& budget);
+
+// Cumulative per-pass accounting across all compilations.
+struct PassTiming {
+  uint64_t runs = 0;
+  uint64_t skips = 0; // budget-based skips
+  double total_us = 0;
+};
+using pass_timings = std::unordered_map<std::string, PassTiming>;
+TORCH_API pass_timings getPassTimings();
+TORCH_API void clearPassTimings();
+
 } // namespace jit
 } // namespace torch
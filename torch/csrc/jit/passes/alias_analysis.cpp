@@ -363,6 +363,68 @@ void AliasDb::analyze(Node* node) {
   }
 }
 
+// Note [Incremental alias analysis]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Rebuilding the AliasDb after every mutation makes pass pipelines
+// quadratic in graph size, and on large traced graphs the re-analysis
+// dominates optimization time. The hooks below patch the db in place
+// instead. They are conservative rather than exact:
+//
+//  - analyzeNewNode runs the regular per-node analysis, which only appends
+//    to the memory DAG. For a node built from already-tracked values this
+//    is exactly what construction would have done.
+//  - eraseNode removes the node from the write and wildcard indices. The
+//    memory-DAG elements of its outputs stay behind as unreachable
+//    vertices; leftover vertices can only make mayAlias answer true more
+//    often, never less. A value a node writes to is necessarily one of its
+//    uses, so by the time a node is destroyable no surviving write-index
+//    entry can mention its outputs.
+//  - replaceValue points the replacement at everything the original
+//    aliased, a superset of the truth when the replacement was more
+//    precise, and copies the original's write-index entries over so they
+//    survive if the original's element is later dropped with its node.
+//
+// Conservative answers keep every client sound: the db may forbid a
+// transformation it could have allowed, but never allows an invalid one.
+
+void AliasDb::analyzeNewNode(Node* node) {
+  analyze(node);
+  isWriteCacheStale_ = true;
+}
+
+void AliasDb::eraseNode(Node* node) {
+  auto it = writeIndex_.find(node);
+  if (it != writeIndex_.end()) {
+    AT_ASSERT(numWrites_ >= it->second.size());
+    numWrites_ -= it->second.size();
+    writeIndex_.erase(it);
+  }
+  // We can't recover how many of numWrites_ were wildcard writes from
+  // `node`; leaving them counted only makes hasWriters conservative.
+  wildcardWriters_.erase(node);
+  wildcardNodes_.erase(node);
+  for (const auto output : node->outputs()) {
+    // The memory-DAG element (if any) stays behind as an unreachable
+    // vertex; see the note above.
+    elementMap_.erase(output);
+    wildcards_.erase(output);
+  }
+  isWriteCacheStale_ = true;
+}
+
+void AliasDb::replaceValue(const Value* orig, const Value* repl) {
+  if (!shouldAnnotate(orig) || orig == repl) {
+    return;
+  }
+  makePointerTo(repl, orig);
+  for (auto& entry : writeIndex_) {
+    if (entry.second.count(orig)) {
+      entry.second.insert(repl);
+    }
+  }
+  isWriteCacheStale_ = true;
+}
+
 // The basic strategy is:
 //   1. Retrieve alias information for every input.
 //   2. Use the node's schema's alias annotations to propgagate alias/write
@@ -413,6 +475,10 @@ void AliasDb::analyzeImpl(Node* node) {
       return analyzeBroadcastingChunk(node);
     case prim::SetAttr:
       return analyzeSetAttr(node);
+    case prim::CallFunction:
+      // The callee is an arbitrary script function that may mutate any of
+      // its arguments in place; treat the call like a custom op.
+      return analyzeCustomOp(node);
     case aten::add:
     case aten::sub:
     case aten::mul:
@@ -1298,6 +1364,7 @@ TORCH_API bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
       prim::AutogradAdd,
       prim::GetAttr,
       prim::SetAttr,
+      prim::CallFunction,
       aten::wait,
       aten::add,
       aten::sub,
@@ -121,6 +121,24 @@ class AliasDb {
   bool couldMoveAfterTopologically(Node* n, Node* movePoint);
   bool couldMoveBeforeTopologically(Node* n, Node* movePoint);
 
+  /**
+   * Incremental update API
+   *
+   * Passes that mutate the graph can patch the db in place with these hooks
+   * instead of rebuilding it after every change. The patched db is
+   * conservative, never unsound; see Note [Incremental alias analysis].
+   */
+  // Analyze a node inserted after this AliasDb was built. All of `n`s inputs
+  // must already be tracked, i.e. they existed at construction time or were
+  // themselves registered through this hook.
+  TORCH_API void analyzeNewNode(Node* n);
+  // Remove `n` from the db. Must be called before `n` is destroyed.
+  TORCH_API void eraseNode(Node* n);
+  // Record that the uses of `orig` have been replaced by `repl` (i.e. call
+  // this alongside orig->replaceAllUsesWith(repl)). Conservatively makes
+  // `repl` alias everything `orig` did.
+  TORCH_API void replaceValue(const Value* orig, const Value* repl);
+
   // For debugging: print alias db state to stdout
   TORCH_API void dump() const;
 
@@ -0,0 +1,220 @@
+#include <torch/csrc/jit/passes/amp.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Note [Automatic mixed precision]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Hand-placed fp16 casts miss profitable spots and, worse, put reductions in
+// half precision where they overflow. This pass manages the policy instead,
+// classifying ops into three families:
+//
+//  - half-safe: compute-bound ops whose error is dominated by the matmul /
+//    convolution accumulator, which the backends keep in fp32 anyway. Their
+//    fp32 tensor inputs are cast to half and their outputs become half.
+//  - fp32-required: ops that accumulate or amplify (softmax, norms,
+//    reductions, transcendentals). Their half inputs are cast back to fp32.
+//  - precision-neutral: elementwise and data-movement ops that neither help
+//    nor hurt in half. They propagate half when all their floating inputs
+//    already are; on mixed inputs the half side is widened to fp32.
+//
+// Anything unlisted is treated as fp32-required, so an unknown op can never
+// silently compute in half. Casts are emitted as aten::_cast_Half /
+// aten::_cast_Float nodes, which the fuser treats as simple maps: a cast
+// adjacent to a fused elementwise region disappears into the kernel's
+// existing __half2float / __float2half loads and stores instead of costing
+// a memory pass. One cast per value per block is reused by every consumer
+// behind it, and control-flow and graph boundaries always hand back fp32 so
+// callers and sub-blocks observe the dtypes they were built with.
+//
+// The dataflow relies on dtype information from specialization/shape
+// propagation; values without a DimensionedTensorType are never cast.
+
+bool isHalfSafe(Symbol kind) {
+  static const std::unordered_set<Symbol> ops = {
+      aten::mm,
+      aten::addmm,
+      aten::bmm,
+      aten::matmul,
+      aten::conv1d,
+      aten::conv2d,
+      aten::conv3d,
+      aten::_convolution,
+  };
+  return ops.count(kind) > 0;
+}
+
+bool isPrecisionNeutral(Symbol kind) {
+  static const std::unordered_set<Symbol> ops = {
+      aten::relu,      aten::threshold,
+      aten::add,       aten::sub,
+      aten::mul,       aten::div,
+      aten::neg,       aten::clamp,
+      aten::where,     aten::sigmoid,
+      aten::tanh,      aten::dropout,
+      aten::max_pool2d, aten::avg_pool2d,
+      aten::adaptive_avg_pool2d,
+      aten::view,      aten::reshape,
+      aten::transpose, aten::permute,
+      aten::contiguous, aten::flatten,
+      aten::squeeze,   aten::unsqueeze,
+      aten::slice,     aten::select,
+      aten::cat,       aten::t,
+  };
+  return ops.count(kind) > 0;
+}
+
+c10::optional<at::ScalarType> scalarTypeOf(Value* value) {
+  if (auto type = value->type()->cast<DimensionedTensorType>()) {
+    return type->scalarType();
+  }
+  return c10::nullopt;
+}
+
+class AmpRewriter {
+ public:
+  explicit AmpRewriter(Graph* graph) : graph_(graph) {}
+
+  void run() {
+    processBlock(graph_->block());
+  }
+
+ private:
+  bool isHalf(Value* value) const {
+    if (half_values_.count(value) > 0) {
+      return true;
+    }
+    auto st = scalarTypeOf(value);
+    return st && *st == at::kHalf;
+  }
+
+  bool isFloat(Value* value) const {
+    if (half_values_.count(value) > 0) {
+      return false;
+    }
+    auto st = scalarTypeOf(value);
+    return st && *st == at::kFloat;
+  }
+
+  void setCastType(Value* source, Value* casted, at::ScalarType dtype) {
+    if (auto type = source->type()->cast<CompleteTensorType>()) {
+      casted->setType(type->toScalarType(dtype));
+    } else if (auto type = source->type()->cast<DimensionedTensorType>()) {
+      casted->setType(type->toScalarType(dtype));
+    }
+  }
+
+  // Replaces consumer's i-th input with a cast to `dtype`, reusing a cast
+  // already emitted for the same value in this block (it was inserted
+  // before an earlier node, so it dominates every later consumer).
+  void castInputTo(
+      Node* consumer,
+      size_t i,
+      at::ScalarType dtype,
+      std::unordered_map<Value*, Value*>& cache) {
+    Value* value = consumer->input(i);
+    auto it = cache.find(value);
+    if (it != cache.end()) {
+      consumer->replaceInput(i, it->second);
+      return;
+    }
+    WithInsertPoint guard(consumer);
+    Value* non_blocking = graph_->insertConstant(false);
+    Node* cast = graph_->insertNode(graph_->create(
+        dtype == at::kHalf ? aten::_cast_Half : aten::_cast_Float,
+        {value, non_blocking}));
+    setCastType(value, cast->output(), dtype);
+    if (dtype == at::kHalf) {
+      half_values_.insert(cast->output());
+    }
+    cache.emplace(value, cast->output());
+    consumer->replaceInput(i, cast->output());
+  }
+
+  void markOutputsHalf(Node* node) {
+    for (Value* output : node->outputs()) {
+      if (!output->type()->isSubtypeOf(DynamicType::get())) {
+        continue;
+      }
+      setCastType(output, output, at::kHalf);
+      half_values_.insert(output);
+    }
+  }
+
+  void processBlock(Block* block) {
+    // Per-block cast caches; a cast from an enclosing block is not assumed
+    // to dominate uses in here.
+    std::unordered_map<Value*, Value*> to_half;
+    std::unordered_map<Value*, Value*> to_float;
+
+    for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
+      Node* node = *it;
+      for (Block* sub : node->blocks()) {
+        processBlock(sub);
+      }
+      const auto kind = node->kind();
+      if (isHalfSafe(kind)) {
+        for (size_t i = 0; i < node->inputs().size(); ++i) {
+          if (isFloat(node->input(i))) {
+            castInputTo(node, i, at::kHalf, to_half);
+          }
+        }
+        markOutputsHalf(node);
+      } else if (isPrecisionNeutral(kind)) {
+        bool any_half = false;
+        bool any_float = false;
+        for (Value* input : node->inputs()) {
+          if (isHalf(input)) {
+            any_half = true;
+          } else if (isFloat(input)) {
+            any_float = true;
+          }
+        }
+        if (any_half && !any_float) {
+          markOutputsHalf(node);
+        } else if (any_half && any_float) {
+          for (size_t i = 0; i < node->inputs().size(); ++i) {
+            if (isHalf(node->input(i))) {
+              castInputTo(node, i, at::kFloat, to_float);
+            }
+          }
+        }
+      } else {
+        // fp32-required, or unknown and therefore assumed so.
+        for (size_t i = 0; i < node->inputs().size(); ++i) {
+          if (isHalf(node->input(i))) {
+            castInputTo(node, i, at::kFloat, to_float);
+          }
+        }
+      }
+    }
+
+    // Block boundaries hand back fp32, so enclosing control flow and the
+    // graph's caller observe the dtypes the model was built with.
+    Node* ret = block->return_node();
+    for (size_t i = 0; i < ret->inputs().size(); ++i) {
+      if (isHalf(ret->input(i))) {
+        castInputTo(ret, i, at::kFloat, to_float);
+      }
+    }
+  }
+
+  Graph* graph_;
+  // Values this pass decided are half, including those whose static type
+  // could not be rewritten.
+  std::unordered_set<Value*> half_values_;
+};
+
+} // namespace
+
+void AutoMixedPrecision(const std::shared_ptr<Graph>& graph) {
+  AmpRewriter(graph.get()).run();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Rewrites a graph for automatic mixed precision: compute-bound ops run in
+// half precision, accumulation-sensitive ops keep fp32, and the minimal set
+// of cast nodes is inserted at the boundaries. Requires dtype information
+// (DimensionedTensorType), so run it after the executor has specialized and
+// shape-propagated the graph; values without a known dtype are left alone.
+// See Note [Automatic mixed precision] in amp.cpp.
+TORCH_API void AutoMixedPrecision(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -1,5 +1,6 @@
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
 
+#include <torch/csrc/jit/constants.h>
 #include <torch/csrc/jit/ir.h>
 #include <torch/csrc/jit/node_hashing.h>
 #include <torch/csrc/jit/passes/alias_analysis.h>
@@ -10,13 +11,134 @@ namespace torch {
 namespace jit {
 namespace {
 
+using SubexprSet = std::unordered_set<Node*, HashNode, EqualNode>;
+
+// Is v's producing node outside every block owned by `owner`?
+bool definedOutsideOf(const Value* v, const Node* owner) {
+  for (const Block* b = v->node()->owningBlock(); b != nullptr;
+       b = b->owningNode() ? b->owningNode()->owningBlock() : nullptr) {
+    if (b->owningNode() == owner) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A node we may compute unconditionally: pure, deterministic, nothing
+// writes to what it touches, and every input is defined outside `owner`
+// (the If or Loop node it would be hoisted out of). These are the same
+// eligibility conditions CSE itself uses, plus the input check.
+bool isHoistableOutOf(Node* n, Node* owner, const AliasDb& aliasDb) {
+  if (n->hasSideEffects() || n->isNondeterministic() ||
+      aliasDb.hasWriters(n) || !n->blocks().empty()) {
+    return false;
+  }
+  for (const Value* input : n->inputs()) {
+    if (!definedOutsideOf(input, owner)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// An expression computed in both branches of an If runs unconditionally
+// anyway, so hoist the then-branch copy above the If and point the
+// else-branch copy's uses at it. Within-branch duplicates and nodes equal
+// to a dominating parent node are already gone by the time this runs, so
+// only genuinely sibling-only subexpressions are left to pair up.
+void hoistCommonIfExprs(Node* if_node, AliasDb& aliasDb, SubexprSet& subexprs) {
+  AT_ASSERT(if_node->blocks().size() == 2);
+  Block* then_block = if_node->blocks()[0];
+  Block* else_block = if_node->blocks()[1];
+
+  SubexprSet then_exprs;
+  for (Node* n : then_block->nodes()) {
+    if (isHoistableOutOf(n, if_node, aliasDb)) {
+      then_exprs.insert(n);
+    }
+  }
+
+  auto g_out = if_node->owningGraph()->outputs();
+  for (auto it = else_block->nodes().begin(); it != else_block->nodes().end();
+       ++it) {
+    Node* node = *it;
+    if (!isHoistableOutOf(node, if_node, aliasDb)) {
+      continue;
+    }
+    auto existing_it = then_exprs.find(node);
+    if (existing_it == then_exprs.end()) {
+      continue;
+    }
+    Node* existing = *existing_it;
+    // As in the in-block case: don't introduce new aliasing among graph
+    // outputs.
+    if (aliasDb.mayContainAlias(node->outputs(), g_out) &&
+        aliasDb.mayContainAlias(existing->outputs(), g_out)) {
+      continue;
+    }
+    // Moving a node with no writers anywhere does not change any aliasing
+    // facts, so the alias db stays valid without re-analysis.
+    existing->moveBefore(if_node);
+    then_exprs.erase(existing_it);
+    for (size_t i = 0; i < node->outputs().size(); ++i) {
+      aliasDb.replaceValue(node->outputs()[i], existing->outputs()[i]);
+    }
+    node->replaceAllUsesWith(existing);
+    aliasDb.eraseNode(node);
+    it.destroyCurrent();
+    // The hoisted node now lives in the parent block; let the rest of the
+    // parent's sweep dedup against it.
+    subexprs.insert(existing);
+  }
+}
+
+// Does the loop provably execute its body at least once? prim::Loop also
+// encodes while-loops and zero-trip range() loops, so this requires a
+// constant trip count >= 1 and a constant-true initial condition.
+bool loopRunsAtLeastOnce(Node* loop_node) {
+  auto trip_count = constant_as<int64_t>(loop_node->inputs().at(0));
+  auto start_cond = constant_as<bool>(loop_node->inputs().at(1));
+  return trip_count && *trip_count >= 1 && start_cond && *start_cond;
+}
+
+// Hoist loop-invariant subexpressions above the Loop. The body is in
+// topological order, so one forward pass also catches chains: once
+// x = f(invariant) is hoisted, a following g(x) becomes hoistable too.
+//
+// Unlike the If-hoist above - where the expression ran on either branch,
+// so running it before the If is never new work - this is speculative:
+// a pure aten op can still throw (shape/dtype validation), and hoisting
+// out of a loop that never runs would both execute dead code and turn a
+// working program into one that raises. Hence the minimum-trip-count
+// guard.
+void hoistLoopInvariantExprs(
+    Node* loop_node,
+    AliasDb& aliasDb,
+    SubexprSet& subexprs) {
+  if (!loopRunsAtLeastOnce(loop_node)) {
+    return;
+  }
+  Block* body = loop_node->blocks().at(0);
+  for (auto it = body->nodes().begin(); it != body->nodes().end();) {
+    Node* node = *it;
+    ++it;
+    // Loop-carried values are block parameters of the body, so the
+    // defined-outside check rules out anything that varies per iteration.
+    if (!isHoistableOutOf(node, loop_node, aliasDb)) {
+      continue;
+    }
+    node->moveBefore(loop_node);
+    subexprs.insert(node);
+  }
+}
+
 // The function implements common subexpression elimination.
 // Since the nodes are visited in topological order, one pass is enough.
 void EliminateCommonSubexpression(
     Block* block,
-    const AliasDb& aliasDb,
+    AliasDb& aliasDb,
     std::function<Node*(Node*)> parent_lookup_fn) {
-  std::unordered_set<Node*, HashNode, EqualNode> subexprs;
+  SubexprSet subexprs;
   for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
     auto node = *it;
     if (node->hasSideEffects() || node->isNondeterministic() ||
@@ -38,6 +160,15 @@ void EliminateCommonSubexpression(
         });
       }
 
+      // With each block individually deduped, look across blocks: pair up
+      // subexpressions the branches of an If share, and pull
+      // loop-invariant ones out of a Loop body.
+      if (node->kind() == prim::If) {
+        hoistCommonIfExprs(node, aliasDb, subexprs);
+      } else if (node->kind() == prim::Loop) {
+        hoistLoopInvariantExprs(node, aliasDb, subexprs);
+      }
+
       continue;
     }
 
@@ -52,7 +183,11 @@ void EliminateCommonSubexpression(
         continue;
       }
 
+      for (size_t i = 0; i < node->outputs().size(); ++i) {
+        aliasDb.replaceValue(node->outputs()[i], parent_lookup->outputs()[i]);
+      }
       node->replaceAllUsesWith(parent_lookup);
+      aliasDb.eraseNode(node);
       it.destroyCurrent();
       continue;
     }
@@ -70,8 +205,13 @@ void EliminateCommonSubexpression(
         continue;
       }
 
+      for (size_t i = 0; i < node->outputs().size(); ++i) {
+        aliasDb.replaceValue(node->outputs()[i], existing->outputs()[i]);
+      }
       node->replaceAllUsesWith(existing);
-      // Destroy the node.
+      // Destroy the node, keeping the alias db in sync (see Note
+      // [Incremental alias analysis]) instead of letting it go stale.
+      aliasDb.eraseNode(node);
       it.destroyCurrent();
     }
   }
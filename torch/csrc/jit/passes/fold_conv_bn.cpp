@@ -0,0 +1,140 @@
+#include <torch/csrc/jit/passes/fold_conv_bn.h>
+
+#include <ATen/ATen.h>
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Returns the tensor held by a constant, an undefined tensor for a
+// constant None, and nullopt when v is not a constant at all.
+c10::optional<at::Tensor> constantTensorOrNone(Value* v) {
+  auto ivalue = toIValue(v);
+  if (!ivalue) {
+    return c10::nullopt;
+  }
+  if (ivalue->isNone()) {
+    return at::Tensor();
+  }
+  if (!ivalue->isTensor()) {
+    return c10::nullopt;
+  }
+  return ivalue->toTensor();
+}
+
+struct FoldedConvParams {
+  at::Tensor weight;
+  at::Tensor bias;
+};
+
+// With fixed statistics, bn(x) = (x - mean) / sqrt(var + eps) * gamma + beta
+// is per-channel affine, so for y = conv(x, W, b):
+//   bn(y) = conv(x, W * s, (b - mean) * s + beta)  with  s = gamma / sqrt(var + eps)
+// gamma/beta default to 1/0 when the batch norm has no affine parameters,
+// and a missing conv bias is a zero bias.
+FoldedConvParams foldConvParams(
+    const at::Tensor& conv_w,
+    const at::Tensor& conv_b,
+    const at::Tensor& bn_w,
+    const at::Tensor& bn_b,
+    const at::Tensor& running_mean,
+    const at::Tensor& running_var,
+    double eps) {
+  at::Tensor scale =
+      (bn_w.defined() ? bn_w : at::ones_like(running_var)) /
+      at::sqrt(running_var + eps);
+  // Broadcast the per-output-channel scale over the filter's remaining dims.
+  std::vector<int64_t> scale_shape(conv_w.dim(), 1);
+  scale_shape[0] = -1;
+
+  FoldedConvParams folded;
+  folded.weight =
+      (conv_w * scale.reshape(scale_shape)).to(conv_w.scalar_type());
+  at::Tensor bias = conv_b.defined() ? conv_b : at::zeros_like(running_mean);
+  folded.bias = ((bias - running_mean) * scale +
+                 (bn_b.defined() ? bn_b : at::zeros_like(running_mean)))
+                    .to(conv_w.scalar_type());
+  return folded;
+}
+
+bool isFoldableConv(Node* node) {
+  return node->matches(
+             "aten::conv1d(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, int groups) -> Tensor") ||
+      node->matches(
+             "aten::conv2d(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, int groups) -> Tensor") ||
+      node->matches(
+             "aten::conv3d(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, int groups) -> Tensor");
+}
+
+bool foldConvBatchNorm(Block* block) {
+  bool changed = false;
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    Node* bn = *it;
+    ++it;
+    for (Block* sub_block : bn->blocks()) {
+      changed |= foldConvBatchNorm(sub_block);
+    }
+    if (!bn->matches(
+            "aten::batch_norm(Tensor input, Tensor? weight, Tensor? bias, Tensor? running_mean, Tensor? running_var, bool training, float momentum, float eps, bool cudnn_enabled) -> Tensor")) {
+      continue;
+    }
+    Node* conv = bn->inputs()[0]->node();
+    if (!isFoldableConv(conv) || conv->owningBlock() != block) {
+      continue;
+    }
+    if (conv->output()->uses().size() != 1) {
+      // Someone else observes the un-normalized conv output.
+      continue;
+    }
+    auto training = constant_as<bool>(bn->inputs()[5]);
+    if (!training || *training) {
+      // A training-mode batch norm uses batch statistics (and updates the
+      // running ones); it is not a fixed affine transform.
+      continue;
+    }
+    auto eps = constant_as<double>(bn->inputs()[7]);
+    auto conv_w = constantTensorOrNone(conv->inputs()[1]);
+    auto conv_b = constantTensorOrNone(conv->inputs()[2]);
+    auto bn_w = constantTensorOrNone(bn->inputs()[1]);
+    auto bn_b = constantTensorOrNone(bn->inputs()[2]);
+    auto running_mean = constantTensorOrNone(bn->inputs()[3]);
+    auto running_var = constantTensorOrNone(bn->inputs()[4]);
+    if (!eps || !conv_w || !conv_w->defined() || !conv_b || !bn_w || !bn_b ||
+        !running_mean || !running_mean->defined() || !running_var ||
+        !running_var->defined()) {
+      // Not everything is a constant; run freezing first (freeze_module.h).
+      continue;
+    }
+
+    FoldedConvParams folded = foldConvParams(
+        *conv_w, *conv_b, *bn_w, *bn_b, *running_mean, *running_var, *eps);
+
+    WithInsertPoint guard(conv);
+    auto graph = conv->owningGraph();
+    conv->replaceInput(1, insertConstant(*graph, folded.weight));
+    conv->replaceInput(2, insertConstant(*graph, folded.bias));
+    bn->output()->replaceAllUsesWith(conv->output());
+    bn->destroy();
+    changed = true;
+  }
+  return changed;
+}
+
+} // namespace
+
+bool FoldConvBatchNorm(const std::shared_ptr<Graph>& graph) {
+  bool changed = foldConvBatchNorm(graph->block());
+  if (changed) {
+    // Drop the now-unused original weight/bias/stats constants.
+    EliminateDeadCode(graph);
+  }
+  return changed;
+}
+
+} // namespace jit
+} // namespace torch
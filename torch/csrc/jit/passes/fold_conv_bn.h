@@ -0,0 +1,24 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Folds inference-mode aten::batch_norm into a preceding convolution.
+//
+// A batch norm with fixed statistics is an affine transform per output
+// channel, so it can be absorbed entirely into the convolution's filter
+// and bias constants; every folded pair saves two full-tensor passes
+// (normalize + scale/shift) at inference time. The rewrite fires when
+//   - the conv output feeds only the batch norm,
+//   - the batch norm has training=False, and
+//   - the weights, biases, statistics and eps are all graph constants.
+// The last condition means this pass is meant to run after freezing
+// (see freeze_module.h), which turns parameters into constants.
+//
+// Returns true if any pair was folded.
+TORCH_API bool FoldConvBatchNorm(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,92 @@
+#include <torch/csrc/jit/passes/freeze_module.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/common_subexpression_elimination.h>
+#include <torch/csrc/jit/passes/constant_pooling.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/fold_conv_bn.h>
+#include <torch/csrc/jit/passes/peephole.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Replaces the uses of the trailing graph inputs that carry the method's
+// parameters and attributes with constants holding their current values.
+// The inputs themselves stay in place -- the interpreter still pushes the
+// slot values at call time -- they just become dead. Returns true if
+// anything was folded.
+bool foldInitialIValues(script::Method& method) {
+  auto graph = method.graph();
+  const auto& slots = method.initial_ivalues();
+  if (slots.empty()) {
+    return false;
+  }
+  AliasDb aliasDb(graph);
+  bool changed = false;
+  size_t params_begin = graph->inputs().size() - slots.size();
+  WithInsertPoint guard(*graph->nodes().begin());
+  for (size_t i = 0; i < slots.size(); i++) {
+    Value* input = graph->inputs()[params_begin + i];
+    if (input->uses().empty()) {
+      continue;
+    }
+    if (aliasDb.hasWriters(input)) {
+      // The graph mutates this slot (e.g. batch-norm running stats in
+      // training mode); its current value is not a constant.
+      continue;
+    }
+    IValue value = slots[i].value();
+    if (value.isTensor()) {
+      // Constants do not participate in autograd; requiring grad on a
+      // frozen parameter would be a caller error anyway.
+      value = value.toTensor().detach();
+    }
+    try {
+      Value* constant = insertConstant(*graph, value);
+      input->replaceAllUsesWith(constant);
+      changed = true;
+    } catch (constant_not_supported_error&) {
+      // e.g. a submodule object held as a slot; leave it as an input.
+      continue;
+    }
+  }
+  return changed;
+}
+
+} // namespace
+
+void FreezeMethod(script::Method& method) {
+  if (!foldInitialIValues(method)) {
+    return;
+  }
+  auto graph = method.graph();
+  // Propagate the newly constant parameters through the graph: this is
+  // what folds batch-norm scales, shape computations on fixed weights,
+  // and conditionals on frozen flags (whose dead branches then drop).
+  ConstantPropagation(graph);
+  // With the parameters constant, inference-mode conv -> batch_norm pairs
+  // now satisfy FoldConvBatchNorm's preconditions; fold them before the
+  // cleanup passes below sweep up the orphaned statistics constants.
+  FoldConvBatchNorm(graph);
+  PeepholeOptimize(graph);
+  EliminateCommonSubexpression(graph);
+  ConstantPooling(graph);
+  EliminateDeadCode(graph);
+}
+
+void FreezeModule(script::Module& module) {
+  for (auto& method : module.get_methods()) {
+    FreezeMethod(*method);
+  }
+  for (auto& submodule : module.get_modules()) {
+    FreezeModule(*submodule);
+  }
+}
+
+} // namespace jit
+} // namespace torch
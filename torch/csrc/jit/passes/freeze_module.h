@@ -0,0 +1,28 @@
+#pragma once
+
+#include <torch/csrc/jit/script/module.h>
+
+namespace torch {
+namespace jit {
+
+// Freezing declares that a module's parameters and attributes will never
+// change, which lets the optimizer treat them as compile-time constants:
+// parameter graph inputs are replaced with prim::Constant nodes (detached
+// from autograd), constant propagation folds the arithmetic that only
+// depends on them (e.g. batch-norm scale/shift), and the usual cleanup
+// passes remove the dead branches and duplicate constants this exposes.
+//
+// Freeze before the first call to the method: the graph is rewritten in
+// place, and an execution plan compiled earlier would not see the folded
+// constants. Parameters that the graph writes to (e.g. running stats in
+// training mode) are left untouched, so freeze an eval()-mode module to
+// get full folding.
+
+// Freezes a single method.
+TORCH_API void FreezeMethod(script::Method& method);
+
+// Freezes every method of the module and, recursively, its submodules.
+TORCH_API void FreezeModule(script::Module& module);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,82 @@
+#include <torch/csrc/jit/passes/fuse_residual.h>
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool hasConstantAlphaOne(Node* add) {
+  auto alpha = constant_as<at::Scalar>(add->input(2));
+  return alpha && alpha->toDouble() == 1.0;
+}
+
+void FuseResidualOpsImpl(Block* block) {
+  for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
+    Node* node = *it;
+    for (Block* sub_block : node->blocks()) {
+      FuseResidualOpsImpl(sub_block);
+    }
+
+    if (node->matches(
+            "aten::add(Tensor self, Tensor other, *, Scalar alpha) -> Tensor") &&
+        hasConstantAlphaOne(node)) {
+      // Look for dropout feeding either side of the add. The dropout
+      // output must have no other use: the fused op draws a fresh mask,
+      // so a second consumer would see different noise.
+      for (size_t side = 0; side < 2; side++) {
+        Node* dropout = node->input(side)->node();
+        if (!dropout->matches(
+                "aten::dropout(Tensor input, float p, bool train) -> Tensor") ||
+            dropout->output()->uses().size() != 1) {
+          continue;
+        }
+        WithInsertPoint guard(node);
+        Node* fused = block->owningGraph()->create(
+            Symbol::fromQualString("aten::fused_dropout_add"),
+            {dropout->input(0),
+             node->input(1 - side),
+             dropout->input(1),
+             dropout->input(2)});
+        fused->output()->copyMetadata(node->output());
+        block->owningGraph()->insertNode(fused);
+        node->output()->replaceAllUsesWith(fused->output());
+        break;
+      }
+    } else if (
+        node->matches(
+            "aten::layer_norm(Tensor input, int[] normalized_shape, Tensor? weight, Tensor? bias, float eps, bool cudnn_enable) -> Tensor")) {
+      Node* add = node->input(0)->node();
+      if (!add->matches(
+              "aten::add(Tensor self, Tensor other, *, Scalar alpha) -> Tensor") ||
+          !hasConstantAlphaOne(add) || add->output()->uses().size() != 1) {
+        continue;
+      }
+      WithInsertPoint guard(node);
+      Node* fused = block->owningGraph()->create(
+          Symbol::fromQualString("aten::fused_add_layer_norm"),
+          {add->input(0),
+           add->input(1),
+           node->input(1),
+           node->input(2),
+           node->input(3),
+           node->input(4)});
+      fused->output()->copyMetadata(node->output());
+      block->owningGraph()->insertNode(fused);
+      node->output()->replaceAllUsesWith(fused->output());
+    }
+  }
+}
+
+} // namespace
+
+void FuseResidualOps(const std::shared_ptr<Graph>& graph) {
+  FuseResidualOpsImpl(graph->block());
+  // The dropout/add/layer_norm nodes left behind are now dead.
+  EliminateDeadCode(graph);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Rewrites transformer residual patterns onto the fused ATen ops:
+//   add(dropout(x, p, train), r)        -> fused_dropout_add(x, r, p, train)
+//   layer_norm(add(x, r), shape, w, b)  -> fused_add_layer_norm(x, r, ...)
+// Each rewrite removes two full reads and one write of the activation.
+// The fused ops have no derivative formulas, so this pass is for
+// inference graphs; run it explicitly, it is not part of the default
+// optimization pipeline.
+TORCH_API void FuseResidualOps(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
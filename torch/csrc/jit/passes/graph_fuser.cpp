@@ -1,6 +1,7 @@
 #include <torch/csrc/jit/passes/graph_fuser.h>
 
 #include <ATen/ExpandUtils.h>
+#include <ATen/WrapDimUtils.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/jit/autodiff.h>
 #include <torch/csrc/jit/custom_operator.h>
@@ -35,6 +36,7 @@ namespace {
 bool isSimpleMap(Node* node) {
   static OperatorSet simple_mappable{{
       "aten::_cast_Float(Tensor self, bool non_blocking) -> Tensor",
+      "aten::_cast_Half(Tensor self, bool non_blocking) -> Tensor",
 
       "aten::abs(Tensor self) -> Tensor",
       "aten::acos(Tensor self) -> Tensor",
@@ -218,6 +220,11 @@ struct GraphFuser {
     // are not necessarily correct.
     if (node->owningBlock() != block_)
       return false;
+    // Reduction groups run over the reduced output's index space, so they
+    // cannot take part in pointwise fusion; see
+    // Note [Fusing the innermost reduction] in torch/csrc/jit/fuser/codegen.cpp.
+    if (node->kind() == prim::FusionGroup && isReductionGroup(node))
+      return false;
     if (node->kind() == aten::_grad_sum_to_size) {
       // We only fuse _grad_sum_to_size if
       // - we will fuse its input next (checked here)
@@ -229,6 +236,39 @@ struct GraphFuser {
     return node->kind() == prim::FusionGroup || isSimpleMap(node);
   }
 
+  // True if node is an aten::sum over just the innermost dimension with
+  // keepdim=false, operating on a floating-point tensor of rank >= 2. Such
+  // sums compile into a kernel that accumulates over the innermost dimension;
+  // see Note [Fusing the innermost reduction] in torch/csrc/jit/fuser/codegen.cpp.
+  // Integer sums are excluded because ATen promotes them to int64 while the
+  // fused kernel would accumulate in the input type; rank-1 sums are excluded
+  // because the reduced index space would be a single element.
+  bool isFusableReduction(Node* node) {
+    if (node->owningBlock() != block_)
+      return false;
+    if (!node->matches(
+            "aten::sum(Tensor self, int[] dim, bool keepdim) -> Tensor"))
+      return false;
+    auto input_type = node->input(0)->type()->cast<DimensionedTensorType>();
+    if (!input_type || input_type->dim() < 2 ||
+        !at::isFloatingType(input_type->scalarType()))
+      return false;
+    auto dims = node->get<std::vector<int64_t>>(attr::dim);
+    auto keepdim = node->get<bool>(attr::keepdim);
+    if (!dims || dims->size() != 1 || !keepdim || *keepdim)
+      return false;
+    return at::maybe_wrap_dim(dims->at(0), input_type->dim()) ==
+        input_type->dim() - 1;
+  }
+
+  bool isReductionGroup(Node* group) {
+    if (group->kind() != prim::FusionGroup)
+      return false;
+    auto& subgraph = getSubgraph(group);
+    return subgraph.outputs().size() == 1 &&
+        subgraph.outputs()[0]->node()->kind() == aten::sum;
+  }
+
   bool isFusableCatNode(Node* node) {
     if (node->kind() != aten::cat)
       return false;
@@ -626,6 +666,11 @@ struct GraphFuser {
     if (consumer->kind() != prim::FusionGroup) {
       return false;
     }
+    // Chunked inputs would enumerate the full map size, which a reduction
+    // group's reduced index space cannot represent.
+    if (isReductionGroup(consumer)) {
+      return false;
+    }
     // Does the chunk have constant chunks/dim?
     auto* chunk = producer->node();
     if (chunk->kind() != prim::ConstantChunk)
@@ -1124,6 +1169,10 @@ struct GraphFuser {
   void removeOutputsUsedOnlyInSize(Node* fusion_group) {
     if (fusion_group->kind() != prim::FusionGroup)
       return;
+    // buildShapeExpressions assumes every output broadcasts the inputs,
+    // which does not hold for a reduction group's summed-away dimension.
+    if (isReductionGroup(fusion_group))
+      return;
     auto subgraph = fusion_group->g(attr::Subgraph);
 
     auto shape_of = buildShapeExpressions(fusion_group);
@@ -1240,6 +1289,67 @@ struct GraphFuser {
     }
   }
 
+  // Producers may only join a reduction group when the group is their sole
+  // consumer: the fused kernel runs over the reduced output's index space,
+  // so it cannot also materialize a full-size intermediate for other users.
+  bool canFuseReductionProducer(Node* consumer, Value* producer) {
+    Node* node = producer->node();
+    if (node->owningBlock() != block_ || node->kind() == prim::FusionGroup ||
+        !isSimpleMap(node)) {
+      return false;
+    }
+    for (Value* output : node->outputs()) {
+      for (const auto& u : output->uses()) {
+        if (u.user != consumer) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void fuseReductions() {
+    // Collect candidates first: fusing a reduction destroys the sum node and
+    // its producers, and none of those can be another candidate.
+    std::vector<Node*> reductions;
+    for (Node* node : block_->nodes()) {
+      if (isFusableReduction(node) && isFusableDevice(node->output())) {
+        reductions.push_back(node);
+      }
+    }
+    for (Node* node : reductions) {
+      // A lone sum gains nothing from the fuser and would serialize the
+      // accumulation; only form a group if a producer comes along with it.
+      bool any_fusable_producer = false;
+      for (Value* input : node->inputs()) {
+        if (input->type()->isSubtypeOf(TensorType::get()) &&
+            canFuseReductionProducer(node, input)) {
+          any_fusable_producer = true;
+          break;
+        }
+      }
+      if (!any_fusable_producer) {
+        continue;
+      }
+      Node* group = createSingletonFusionGroup(node);
+      auto sorted_inputs = sortReverseTopological(group->inputs());
+      size_t input_idx = 0;
+      while (input_idx < sorted_inputs.size()) {
+        Value* input = sorted_inputs[input_idx++];
+        if (!canFuseReductionProducer(group, input)) {
+          continue;
+        }
+        if (!tryFuse(group, input)) {
+          continue;
+        }
+        // We could have destroyed multiple inputs when performing this fusion,
+        // so we have to recompute the list and iterate over it again.
+        sorted_inputs = sortReverseTopological(group->inputs());
+        input_idx = 0;
+      }
+    }
+  }
+
   void optimizeFusedGraphs() {
     for (Node* node : block_->nodes()) {
       if (node->kind() != prim::FusionGroup) {
@@ -1283,6 +1393,12 @@ struct GraphFuser {
 
     fuseConcats();
 
+    // Innermost-dimension sums become reduction groups that absorb their
+    // exclusively-consumed pointwise producers; see
+    // Note [Fusing the innermost reduction] in torch/csrc/jit/fuser/codegen.cpp.
+    refreshAliasDb();
+    fuseReductions();
+
     optimizeFusedGraphs();
 
     // The graph fuser can add intermediate prim::BroadcastingChunk nodes.
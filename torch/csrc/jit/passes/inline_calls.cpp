@@ -0,0 +1,87 @@
+#include <torch/csrc/jit/passes/inline_calls.h>
+
+#include <torch/csrc/jit/script/compilation_unit.h>
+
+#include <cstdlib>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+size_t inlineSizeThreshold() {
+  static const size_t threshold = []() {
+    const char* env = std::getenv("PYTORCH_JIT_INLINE_THRESHOLD");
+    if (env) {
+      return static_cast<size_t>(std::strtoll(env, nullptr, 10));
+    }
+    return static_cast<size_t>(32);
+  }();
+  return threshold;
+}
+
+uint64_t inlineMinCalls() {
+  static const uint64_t min_calls = []() {
+    const char* env = std::getenv("PYTORCH_JIT_INLINE_MIN_CALLS");
+    if (env) {
+      return static_cast<uint64_t>(std::strtoll(env, nullptr, 10));
+    }
+    return static_cast<uint64_t>(8);
+  }();
+  return min_calls;
+}
+
+size_t graphSize(Block* block) {
+  size_t size = 0;
+  for (Node* node : block->nodes()) {
+    ++size;
+    for (Block* sub : node->blocks()) {
+      size += graphSize(sub);
+    }
+  }
+  return size;
+}
+
+bool shouldInline(script::Function* callee) {
+  return graphSize(callee->graph()->block()) <= inlineSizeThreshold() &&
+      callee->invocations() >= inlineMinCalls();
+}
+
+// Returns true if any call was inlined.
+bool inlineCalls(Block* block, Graph& graph) {
+  bool changed = false;
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    Node* node = *it;
+    ++it; // advance before the node is possibly destroyed
+    for (Block* sub : node->blocks()) {
+      changed |= inlineCalls(sub, graph);
+    }
+    if (node->kind() != prim::CallFunction) {
+      continue;
+    }
+    auto* callee = reinterpret_cast<script::Function*>(node->i(attr::fn));
+    if (!shouldInline(callee)) {
+      continue;
+    }
+    WithInsertPoint guard(node);
+    Value* replacement =
+        inlineCallTo(graph, *callee->graph(), node->inputs()).at(0);
+    node->output()->replaceAllUsesWith(replacement);
+    node->destroy();
+    changed = true;
+  }
+  return changed;
+}
+
+} // namespace
+
+void InlineSmallCalls(const std::shared_ptr<Graph>& graph) {
+  // Inlined bodies may themselves contain preserved calls (to other small
+  // callees), so iterate to a fixpoint. Recursion between script functions
+  // is rejected at definition time, so this terminates.
+  while (inlineCalls(graph->block(), *graph)) {
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Inlines prim::CallFunction nodes (emitted under
+// PYTORCH_JIT_PRESERVE_CALLS=1; see Note [Call-preserving compilation] in
+// script/module.cpp) whose callee has proven both small and hot. Small is
+// measured in callee graph nodes (PYTORCH_JIT_INLINE_THRESHOLD, default 32)
+// and hot in recorded invocations (PYTORCH_JIT_INLINE_MIN_CALLS, default 8),
+// so a cold helper on an error path never pays for inlining while a small
+// activation function called in a loop is flattened into its caller and can
+// participate in fusion there. Calls that stay preserved continue to run
+// through the callee's own executor.
+TORCH_API void InlineSmallCalls(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,111 @@
+#include <torch/csrc/jit/passes/layout_propagation.h>
+
+#include <ATen/ATen.h>
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Values known to hold opaque MKL-DNN tensors. Only ops we can see
+// producing them count; anything else is assumed dense.
+bool producesMKLDNN(Node* node) {
+  if (node->matches("aten::to_mkldnn(Tensor self) -> Tensor")) {
+    return true;
+  }
+  if (node->matches(
+          "aten::mkldnn_convolution(Tensor self, Tensor weight, Tensor? bias, int[] padding, int[] stride, int[] dilation, int groups) -> Tensor")) {
+    return true;
+  }
+  return false;
+}
+
+// A constant weight can be reordered at pass time only when the eager
+// conversion would accept it.
+bool canPreconvertConstant(const at::Tensor& tensor) {
+  return at::hasMKLDNN() && tensor.defined() && !tensor.is_sparse() &&
+      tensor.device().is_cpu() &&
+      tensor.scalar_type() == at::ScalarType::Float;
+}
+
+void PropagateMKLDNNLayoutImpl(
+    Block* block,
+    const AliasDb& db,
+    std::unordered_set<Value*>& mkldnn,
+    bool& changed) {
+  for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
+    Node* node = *it;
+    for (Block* sub_block : node->blocks()) {
+      PropagateMKLDNNLayoutImpl(sub_block, db, mkldnn, changed);
+    }
+
+    if (node->matches("aten::to_mkldnn(Tensor self) -> Tensor")) {
+      Value* input = node->input();
+      Node* input_node = input->node();
+      if (input_node->matches("aten::to_dense(Tensor self) -> Tensor") &&
+          mkldnn.count(input_node->input()) &&
+          !db.hasWriters(node->output()) && !db.hasWriters(input)) {
+        // x -> to_dense -> to_mkldnn round trip: the result is a fresh
+        // reorder of an already-MKL-DNN tensor, so the original value can
+        // stand in for it as long as neither copy is written to.
+        node->output()->replaceAllUsesWith(input_node->input());
+        changed = true;
+        continue;
+      }
+      if (input_node->kind() == prim::Constant &&
+          !db.hasWriters(node->output())) {
+        // Freeze-time weight conversion: reorder the constant once here
+        // instead of on every execution.
+        auto ivalue = toIValue(input);
+        if (ivalue && ivalue->isTensor() &&
+            canPreconvertConstant(ivalue->toTensor())) {
+          WithInsertPoint guard(node);
+          Value* converted = node->owningGraph()->insertConstant(
+              ivalue->toTensor().to_mkldnn());
+          node->output()->replaceAllUsesWith(converted);
+          mkldnn.insert(converted);
+          changed = true;
+          continue;
+        }
+      }
+    } else if (node->matches("aten::to_dense(Tensor self) -> Tensor")) {
+      Value* input = node->input();
+      Node* input_node = input->node();
+      if (input_node->matches("aten::to_mkldnn(Tensor self) -> Tensor") &&
+          !db.hasWriters(node->output()) &&
+          !db.hasWriters(input_node->input())) {
+        // x -> to_mkldnn -> to_dense: both hops copy, so the result has
+        // the same content and layout as the original dense tensor.
+        node->output()->replaceAllUsesWith(input_node->input());
+        changed = true;
+        continue;
+      }
+    }
+
+    if (producesMKLDNN(node)) {
+      for (Value* output : node->outputs()) {
+        mkldnn.insert(output);
+      }
+    }
+  }
+}
+
+} // namespace
+
+void PropagateMKLDNNLayout(const std::shared_ptr<Graph>& graph) {
+  AliasDb db(graph);
+  std::unordered_set<Value*> mkldnn;
+  bool changed = false;
+  PropagateMKLDNNLayoutImpl(graph->block(), db, mkldnn, changed);
+  if (changed) {
+    EliminateDeadCode(graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Minimizes MKL-DNN layout conversions in a graph. Regions of the graph
+// already computing in MKL-DNN layout are tracked, redundant
+// to_dense/to_mkldnn round trips between them are cancelled, and
+// to_mkldnn of constant tensors (typically weights) is folded into a
+// pre-converted constant so the reorder happens once at optimization time
+// instead of on every forward.
+TORCH_API void PropagateMKLDNNLayout(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -6,6 +6,7 @@
 
 #include <torch/csrc/jit/constants.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/profiling_record.h>
 
 namespace torch {
 namespace jit {
@@ -206,6 +207,106 @@ void unroll(Node* loop) {
            graph->insert(aten::mul, {unrolled_iter_count, kUnrollFactor})}));
 }
 
+// Note [Profile-guided unrolling]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// kUnrollFactor and the body-size cap treat every loop identically, but
+// loops are not alike: short feature-engineering loops (trip counts of a
+// handful) unroll fully into straight-line code that constant-folds and
+// fuses across iterations, while loops that iterate thousands of times
+// gain nothing from a factor-8 body. ProfilingRecord instruments every
+// prim::Loop with a profile node that records the distribution of trip
+// counts it actually runs with. For a loop whose observations are
+// dominated by one small count K (dominantTripCount), this pass rewrites
+//
+//   %y... = prim::Loop(%n, ...)
+// into
+//   %hit = aten::eq(%n, K)
+//   %y... = prim::If(%hit)
+//     block0: body fully unrolled K times
+//     block1: the original loop
+//
+// so the dominant count runs the specialized straight-line body while the
+// guard keeps every other count correct (and keeps recording through the
+// fallback's profile nodes). The pass runs on the profiled graph itself,
+// where the node pointers the record collected are valid; callers
+// instrument a graph, run it until profiling_count_ drains, and then
+// re-optimize it with this pass.
+void specializeLoop(Node* loop, int64_t count) {
+  Graph* graph = loop->owningGraph();
+  WithInsertPoint insert_point_guard{loop};
+
+  Value* expected = graph->insertConstant(count);
+  Value* match = graph->insert(aten::eq, {loop->inputs().at(0), expected});
+  Node* versions = graph->insertNode(graph->create(prim::If, 0));
+  versions->addInput(match);
+  Block* unrolled = versions->addBlock();
+  Block* fallback = versions->addBlock();
+
+  if (count == 0) {
+    // The body never runs: the outputs are the initial loop-carried values.
+    for (size_t i = 2; i < loop->inputs().size(); ++i) {
+      unrolled->registerOutput(loop->inputs()[i]);
+    }
+  } else {
+    WithInsertPoint guard{unrolled};
+    Node* clone =
+        graph->insertNode(graph->createClone(loop, [](Value* v) { return v; }));
+    clone->replaceInput(0, expected);
+    Block* body = clone->blocks().at(0);
+    // replaceLoopCounter prepends a counter output; skip it when wiring
+    // the block outputs, which must mirror the original loop's outputs.
+    size_t output_offset = 0;
+    if (body->inputs()[0]->uses().size() > 0) {
+      replaceLoopCounter(clone);
+      output_offset = 1;
+    }
+    repeatBody(body, count);
+    for (size_t i = output_offset; i < clone->outputs().size(); ++i) {
+      unrolled->registerOutput(clone->outputs()[i]);
+    }
+    inlineBody(clone);
+  }
+
+  {
+    WithInsertPoint guard{fallback};
+    Node* clone =
+        graph->insertNode(graph->createClone(loop, [](Value* v) { return v; }));
+    for (Value* output : clone->outputs()) {
+      fallback->registerOutput(output);
+    }
+  }
+
+  for (size_t i = 0; i < loop->outputs().size(); ++i) {
+    Value* out = versions->addOutput()->setType(loop->outputs()[i]->type());
+    loop->outputs()[i]->replaceAllUsesWith(out);
+  }
+  loop->destroy();
+}
+
+void specializeProfiledLoops(Block* block, ProfilingRecord& record) {
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    // XXX: specializeLoop destroys the current node, so pre-increment
+    Node* node = *it;
+    ++it;
+    // Inner loops first: their specializations are cloned along into both
+    // versions of an enclosing loop.
+    for (Block* subblock : node->blocks()) {
+      specializeProfiledLoops(subblock, record);
+    }
+    if (!isForLoop(node) || !isSmallBlock(node->blocks().at(0))) {
+      continue;
+    }
+    // Constant-length loops are already fully handled by UnrollLoops.
+    if (constant_as<int64_t>(node->inputs().at(0))) {
+      continue;
+    }
+    auto count = record.dominantTripCount(node);
+    if (count && *count >= 0 && *count < kMaxBodyRepeats) {
+      specializeLoop(node, *count);
+    }
+  }
+}
+
 void UnrollLoops(Block* block) {
   for (auto it = block->nodes().begin(); it != block->nodes().end();) {
     // XXX: unroll might destroy the current node, so we need to pre-increment
@@ -228,5 +329,14 @@ void UnrollLoops(std::shared_ptr<Graph>& graph) {
   EliminateDeadCode(graph);
 }
 
+// See Note [Profile-guided unrolling]
+void SpecializeProfiledLoops(
+    std::shared_ptr<Graph>& graph,
+    ProfilingRecord& record) {
+  AT_ASSERT(graph == record.profiled_graph_);
+  specializeProfiledLoops(graph->block(), record);
+  EliminateDeadCode(graph);
+}
+
 } // namespace jit
 } // namespace torch
@@ -5,7 +5,17 @@
 namespace torch {
 namespace jit {
 
+struct ProfilingRecord;
+
 TORCH_API void UnrollLoops(std::shared_ptr<Graph>& graph);
 
+// Fully unrolls loops of `record`'s profiled graph whose observed trip
+// counts are dominated by one small value, guarded by a runtime check on
+// the count; see Note [Profile-guided unrolling]. `graph` must be the
+// graph the record instrumented.
+TORCH_API void SpecializeProfiledLoops(
+    std::shared_ptr<Graph>& graph,
+    ProfilingRecord& record);
+
 }
 } // namespace torch
@@ -0,0 +1,86 @@
+#include <torch/csrc/jit/passes/managed_prefetch.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// Note [Managed prefetch insertion]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Under managed-memory oversubscription (see Note [Managed memory mode]
+// in c10/cuda/CUDACachingAllocator.cpp) the driver pages
+// least-recently-used data out to the host, and an op touching paged-out
+// weights stalls on demand faults. A compiled graph knows its execution
+// order ahead of time, so we can do better: for every CUDA tensor input
+// of the graph -- weights and buffers enter the lowered graph as inputs
+// -- this pass inserts an aten::_managed_prefetch_ hint `lookahead`
+// top-level nodes before the input's first use, overlapping the
+// migration with the preceding ops' execution. Eviction needs no
+// counterpart pass: the driver's LRU policy reclaims pages of tensors
+// that have not been touched recently, which under an in-order graph
+// walk is exactly the already-executed layers.
+//
+// The pass runs on specialized graphs (device information comes from
+// DimensionedTensorType, so it must run after shape propagation) and is
+// inserted after the final dead-code elimination: the hint's output is
+// unused, and only its (a!) write annotation keeps DCE from dropping it.
+// The op itself is a no-op when the managed allocator mode is off.
+namespace {
+
+Node* topLevelAncestor(Node* node, Block* top) {
+  while (node->owningBlock() != top) {
+    node = node->owningBlock()->owningNode();
+  }
+  return node;
+}
+
+} // namespace
+
+void InsertManagedPrefetch(
+    const std::shared_ptr<Graph>& graph,
+    size_t lookahead) {
+  Block* block = graph->block();
+  std::vector<Node*> order;
+  for (Node* node : block->nodes()) {
+    order.push_back(node);
+  }
+  if (order.empty()) {
+    return;
+  }
+  std::unordered_map<Node*, size_t> position;
+  for (size_t i = 0; i < order.size(); ++i) {
+    position[order[i]] = i;
+  }
+
+  for (Value* input : graph->inputs()) {
+    auto type = input->type()->cast<DimensionedTensorType>();
+    if (!type || !type->device().is_cuda()) {
+      continue;
+    }
+    // First use in top-level execution order; uses inside sub-blocks
+    // count at their enclosing top-level node.
+    size_t first_use = order.size();
+    for (const Use& use : input->uses()) {
+      Node* user = topLevelAncestor(use.user, block);
+      auto it = position.find(user);
+      if (it != position.end()) {
+        first_use = std::min(first_use, it->second);
+      }
+    }
+    if (first_use == order.size()) {
+      continue;
+    }
+    const size_t at = first_use > lookahead ? first_use - lookahead : 0;
+    WithInsertPoint guard(order[at]);
+    Node* prefetch = graph->create(
+        Symbol::fromQualString("aten::_managed_prefetch_"), {input});
+    prefetch->output()->setType(input->type());
+    graph->insertNode(prefetch);
+  }
+}
+
+} // namespace jit
+} // namespace torch
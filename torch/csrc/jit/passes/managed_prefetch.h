@@ -0,0 +1,19 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Inserts aten::_managed_prefetch_ hints for CUDA tensor graph inputs
+// `lookahead` nodes ahead of their first use, so weights paged out under
+// managed-memory oversubscription stream back in before the op that
+// needs them. See Note [Managed prefetch insertion] in
+// managed_prefetch.cpp. Enabled via PYTORCH_JIT_MANAGED_PREFETCH; see
+// graph_executor.cpp.
+TORCH_API void InsertManagedPrefetch(
+    const std::shared_ptr<Graph>& graph,
+    size_t lookahead);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,164 @@
+#include <torch/csrc/jit/passes/memory_planning.h>
+
+#include <torch/csrc/jit/passes/alias_analysis.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Arena offsets are aligned generously enough for any vectorized kernel.
+constexpr size_t kArenaAlignment = 64;
+
+size_t alignUp(size_t n) {
+  return (n + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+}
+
+// A planned value: the half-open [def, last_use] range of node indices over
+// which its bytes must stay reserved.
+struct Interval {
+  const Value* value;
+  size_t size;
+  size_t def;
+  size_t last_use;
+};
+
+// A byte range of the arena currently reserved by a live interval.
+struct Reservation {
+  size_t offset;
+  size_t size;
+  size_t last_use;
+};
+
+bool isContiguous(
+    const std::vector<int64_t>& sizes,
+    const std::vector<int64_t>& strides) {
+  int64_t expected = 1;
+  for (size_t i = sizes.size(); i > 0; i--) {
+    if (strides[i - 1] != expected) {
+      return false;
+    }
+    expected *= sizes[i - 1];
+  }
+  return true;
+}
+
+// Byte size of a value if it is a complete, contiguous tensor on the CPU;
+// zero if it cannot be planned.
+size_t plannableSize(const Value* v) {
+  auto type = v->type()->cast<CompleteTensorType>();
+  if (!type) {
+    return 0;
+  }
+  if (!type->device().is_cpu()) {
+    return 0;
+  }
+  if (!isContiguous(type->sizes(), type->strides())) {
+    return 0;
+  }
+  size_t nbytes = type->numel() * elementSize(type->scalarType());
+  if (nbytes == 0) {
+    return 0;
+  }
+  return alignUp(nbytes);
+}
+
+} // namespace
+
+MemoryPlan PlanMemory(const std::shared_ptr<Graph>& graph) {
+  MemoryPlan plan;
+  AliasDb aliasDb(graph);
+
+  // Number the top-level nodes. Uses inside sub-blocks (if/loop bodies) are
+  // attributed to their owning top-level node, which conservatively covers
+  // every iteration of a loop.
+  std::unordered_map<const Node*, size_t> node_index;
+  size_t index = 0;
+  for (const Node* node : graph->block()->nodes()) {
+    node_index[node] = index++;
+  }
+  const auto topLevelIndex = [&](const Node* n) -> size_t {
+    while (n->owningBlock() != graph->block()) {
+      n = n->owningBlock()->owningNode();
+    }
+    return node_index.at(n);
+  };
+
+  // Collect the intervals of the values we can safely plan.
+  std::vector<Interval> intervals;
+  for (Node* node : graph->block()->nodes()) {
+    for (Value* output : node->outputs()) {
+      size_t size = plannableSize(output);
+      if (size == 0) {
+        continue;
+      }
+      // Graph outputs escape, and values that may share memory with any
+      // input of their node (views, in-place results) or that are written
+      // to elsewhere cannot be given fresh bytes.
+      if (output->uses().empty()) {
+        continue;
+      }
+      bool escapes = false;
+      size_t last_use = node_index.at(node);
+      for (const Use& use : output->uses()) {
+        if (use.user == graph->block()->return_node()) {
+          escapes = true;
+          break;
+        }
+        last_use = std::max(last_use, topLevelIndex(use.user));
+      }
+      if (escapes || aliasDb.hasWriters(output)) {
+        continue;
+      }
+      bool aliases_input = false;
+      for (Value* input : node->inputs()) {
+        if (aliasDb.mayAlias(output, input)) {
+          aliases_input = true;
+          break;
+        }
+      }
+      if (aliases_input) {
+        continue;
+      }
+      intervals.push_back({output, size, node_index.at(node), last_use});
+    }
+  }
+
+  // Greedy first-fit packing in definition order: expire reservations whose
+  // interval has ended, then place the new value in the lowest gap between
+  // the remaining live reservations that fits it.
+  std::vector<Reservation> live; // kept sorted by offset
+  for (const Interval& interval : intervals) {
+    live.erase(
+        std::remove_if(
+            live.begin(),
+            live.end(),
+            [&](const Reservation& r) { return r.last_use < interval.def; }),
+        live.end());
+    size_t offset = 0;
+    for (const Reservation& r : live) {
+      if (offset + interval.size <= r.offset) {
+        break;
+      }
+      offset = std::max(offset, r.offset + r.size);
+    }
+    live.insert(
+        std::upper_bound(
+            live.begin(),
+            live.end(),
+            offset,
+            [](size_t lhs, const Reservation& rhs) { return lhs < rhs.offset; }),
+        {offset, interval.size, interval.last_use});
+    plan.offsets[interval.value] = offset;
+    plan.arena_size = std::max(plan.arena_size, offset + interval.size);
+  }
+
+  return plan;
+}
+
+} // namespace jit
+} // namespace torch
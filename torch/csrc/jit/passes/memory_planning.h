@@ -0,0 +1,29 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+// The result of statically planning the intermediate tensors of a graph:
+// every planned value gets a byte offset into a single arena allocation of
+// `arena_size` bytes. Values that could not be planned (unknown shapes,
+// possible aliasing, graph outputs) are simply absent from `offsets` and
+// keep going through the regular allocator.
+struct MemoryPlan {
+  size_t arena_size = 0;
+  std::unordered_map<const Value*, size_t> offsets;
+};
+
+// Computes lifetimes of the intermediate tensor values of `graph` from the
+// linearized node order and packs them into arena offsets, reusing the bytes
+// of values whose last use has passed. Only values with complete tensor
+// types (i.e. after shape propagation on fixed-shape inputs) participate,
+// and values that may alias another value or are mutated are excluded, so
+// handing out the planned slices at runtime is safe.
+TORCH_API MemoryPlan PlanMemory(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
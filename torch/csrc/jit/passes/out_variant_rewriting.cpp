@@ -0,0 +1,130 @@
+#include <torch/csrc/jit/passes/out_variant_rewriting.h>
+
+#include <torch/csrc/jit/operator.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
+
+#include <ATen/ATen.h>
+
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Runtime support for the rewritten graphs. The arena is one plain byte
+// tensor allocated per run; ArenaOut wraps a planned slice of it as a
+// tensor of the right shape and dtype. The view's deleter holds a copy of
+// the arena tensor, so the arena stays alive for as long as any view into
+// it does, regardless of when the interpreter drops the arena value itself.
+RegisterOperators reg({
+    Operator(
+        "prim::AllocateArena(int size) -> Tensor",
+        [](Stack& stack) {
+          int64_t size;
+          pop(stack, size);
+          push(
+              stack,
+              at::empty({size}, at::TensorOptions(at::kCPU).dtype(at::kByte)));
+          return 0;
+        }),
+    Operator(
+        "prim::ArenaOut(Tensor arena, int offset, int[] sizes, int dtype) -> Tensor",
+        [](Stack& stack) {
+          int64_t dtype = pop(stack).toInt();
+          std::vector<int64_t> sizes = pop(stack).toIntList()->elements();
+          int64_t offset = pop(stack).toInt();
+          at::Tensor arena = pop(stack).toTensor();
+          void* data = static_cast<char*>(arena.data_ptr()) + offset;
+          auto options = at::TensorOptions(at::kCPU).dtype(
+              static_cast<at::ScalarType>(dtype));
+          push(
+              stack,
+              at::from_blob(data, sizes, [arena](void*) {}, options));
+          return 0;
+        }),
+});
+
+// True if the registry has an overload of this node's op taking the node's
+// current inputs, the last of which is a written-to `out` tensor. Called
+// after the out view has been appended, so `matches` performs the same
+// resolution the interpreter will.
+bool matchesOutVariant(const Node* node) {
+  for (const auto& op : getAllOperatorsFor(node->kind())) {
+    const auto& args = op->schema().arguments();
+    if (args.empty() || args.back().name() != "out") {
+      continue;
+    }
+    const auto& alias = args.back().alias_info();
+    if (!alias || !alias->isWrite()) {
+      continue;
+    }
+    if (op->matches(node)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void RewriteOutVariants(const std::shared_ptr<Graph>& graph) {
+  MemoryPlan plan = PlanMemory(graph);
+  if (plan.offsets.empty()) {
+    return;
+  }
+
+  // The arena is allocated once at the top of the graph; it is removed
+  // again below if no node ends up rewritten.
+  Node* arena_node;
+  {
+    WithInsertPoint guard(*graph->block()->nodes().begin());
+    Value* size = graph->insertConstant(
+        static_cast<int64_t>(plan.arena_size));
+    arena_node = graph->insertNode(graph->create(
+        Symbol::fromQualString("prim::AllocateArena"), {size}));
+  }
+  Value* arena = arena_node->output();
+
+  size_t rewritten = 0;
+  for (Node* node : graph->block()->nodes()) {
+    if (!node->kind().is_aten() || node->outputs().size() != 1) {
+      continue;
+    }
+    Value* output = node->output();
+    auto planned = plan.offsets.find(output);
+    if (planned == plan.offsets.end()) {
+      continue;
+    }
+    // PlanMemory only plans complete types.
+    auto type = output->type()->expect<CompleteTensorType>();
+
+    WithInsertPoint guard(node);
+    Value* offset = graph->insertConstant(
+        static_cast<int64_t>(planned->second));
+    Value* sizes = graph->insertConstant(type->sizes());
+    Value* dtype = graph->insertConstant(
+        static_cast<int64_t>(type->scalarType()));
+    Node* view = graph->insertNode(graph->create(
+        Symbol::fromQualString("prim::ArenaOut"),
+        {arena, offset, sizes, dtype}));
+    view->output()->setType(output->type());
+
+    node->addInput(view->output());
+    if (matchesOutVariant(node)) {
+      rewritten++;
+    } else {
+      // No out overload takes this argument list; undo. The stray
+      // constants are swept up by any later DCE.
+      node->removeInput(node->inputs().size() - 1);
+      view->destroy();
+    }
+  }
+
+  if (rewritten == 0) {
+    arena_node->destroy();
+  }
+}
+
+} // namespace jit
+} // namespace torch
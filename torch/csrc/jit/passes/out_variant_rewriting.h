@@ -0,0 +1,32 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Rewrites eligible ops to their out-variants against buffers carved out of
+// a single planner-owned arena, so fixed-shape graphs stop allocating their
+// intermediates on every run.
+//
+// The pass first runs PlanMemory (see passes/memory_planning.h), which only
+// plans complete, contiguous, non-escaping, non-aliased CPU tensor values,
+// then rewrites each planned value's defining node to the op's out-variant
+// when the operator registry has one: a `prim::AllocateArena` node at the
+// top of the graph produces the arena once per run, `prim::ArenaOut` nodes
+// hand out views at the planned offsets (keeping the arena alive for as
+// long as any view is), and the out view is appended to the node's inputs
+// so schema matching resolves the out-variant overload.
+//
+// Coverage comes from the registry itself -- an op is rewritten exactly
+// when a registered overload with the same name takes one extra trailing
+// written-to `out` Tensor and still matches the node -- so it tracks
+// native_functions.yaml without a generated table.
+//
+// Intended for fixed-shape serving, after shape propagation with complete
+// input types. If a shape does change at runtime, the out-variant resizes
+// the buffer away from the arena; results stay correct, the reuse is lost.
+TORCH_API void RewriteOutVariants(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -4,6 +4,8 @@
 
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 
+#include <cmath>
+
 namespace torch {
 namespace jit {
 
@@ -61,6 +63,41 @@ void PeepholeOptimizeImpl(Block* block, bool addmm_fusion_enabled) {
           self_type->device() == other_type->device()) {
         node->output()->replaceAllUsesWith(node->input(0));
       }
+    } else if (node->matches(
+                   "aten::softmax(Tensor self, int dim) -> Tensor",
+                   /*const_inputs=*/attr::dim)) {
+      // softmax(x.masked_fill(mask, -inf), dim=last) on CPU computes the
+      // same attention weights as _masked_softmax(x, mask) but pays a
+      // full masked_fill pass plus softmax work over the padded
+      // positions; rewrite to the fused padding-aware op. Only sound
+      // when the filled tensor feeds nothing else, the fill value is
+      // -inf, and the softmax runs over the last dimension (all
+      // _masked_softmax supports). NB: fully masked rows come out as
+      // zeros instead of NaNs after the rewrite.
+      Node* fill_node = node->namedInput(attr::self)->node();
+      if (fill_node->matches(
+              "aten::masked_fill(Tensor self, Tensor mask, Scalar value) -> Tensor",
+              /*const_inputs=*/attr::value) &&
+          fill_node->output()->uses().size() == 1) {
+        auto self_type = fill_node->namedInput(attr::self)
+                             ->type()
+                             ->cast<DimensionedTensorType>();
+        const double fill_value =
+            fill_node->get<at::Scalar>(attr::value)->toDouble();
+        const int64_t dim = *node->get<int64_t>(attr::dim);
+        if (self_type && !self_type->device().is_cuda() &&
+            at::isFloatingType(self_type->scalarType()) &&
+            std::isinf(fill_value) && fill_value < 0 &&
+            (dim == -1 || dim == self_type->dim() - 1)) {
+          WithInsertPoint guard(node);
+          Value* fused = node->owningGraph()->insert(
+              Symbol::fromQualString("aten::_masked_softmax"),
+              {fill_node->namedInput(attr::self),
+               fill_node->namedInput(attr::mask)});
+          fused->copyMetadata(node->output());
+          node->output()->replaceAllUsesWith(fused);
+        }
+      }
     } else if (
         node->matches(
             "aten::add(Tensor self, Tensor other, *, Scalar alpha) -> Tensor",
@@ -1258,6 +1258,7 @@ TORCH_API bool printerHasSpecialCaseFor(Symbol sym) {
       prim::DifferentiableGraph, // optimization pass adds it
       prim::BroadcastSizes, // optimization pass (fuser) adds it
       prim::ChunkSizes, // optimization pass (fuser) adds it
+      prim::CallFunction, // runtime-only; see Note [Call-preserving compilation]
       prim::Drop, // used in interpreter only
       prim::FusedConcat, // optimization pass adds it
       prim::FusionGroup, // optimization pass adds it
@@ -1767,7 +1767,7 @@ class ShapePropagator {
             "aten::expand(Tensor self, int[] size, *, bool implicit) -> Tensor",
             /*const_inputs=*/attr::size)) {
       auto tp = tensor_types.at(0);
-      std::vector<int64_t> sizes, strides;
+      at::DimVector sizes, strides;
       std::tie(sizes, strides) = at::inferExpandGeometry(
           tp->sizes(),
           tp->strides(),
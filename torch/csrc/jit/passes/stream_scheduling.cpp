@@ -0,0 +1,284 @@
+#include <torch/csrc/jit/passes/stream_scheduling.h>
+
+#include <ATen/Context.h>
+#include <torch/csrc/jit/operator.h>
+
+#ifdef USE_CUDA
+#include <ATen/cuda/CUDAEvent.h>
+#include <c10/cuda/CUDAStream.h>
+#endif
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// The markers live in their own namespace so Node::hasSideEffects treats
+// them as custom ops with arbitrary side effects, which keeps DCE and
+// reordering passes away from them.
+Symbol forkSym() {
+  return Symbol::fromQualString("streams::fork_regions");
+}
+Symbol enterSym() {
+  return Symbol::fromQualString("streams::enter_region");
+}
+Symbol exitSym() {
+  return Symbol::fromQualString("streams::exit_region");
+}
+Symbol joinSym() {
+  return Symbol::fromQualString("streams::join_regions");
+}
+
+// More regions than this and the streams stop buying occupancy; extra
+// regions are folded into the existing ones round-robin.
+constexpr size_t kMaxStreamRegions = 8;
+
+bool isMutatingOp(Node* node) {
+  const char* name = node->kind().toUnqualString();
+  const size_t len = std::strlen(name);
+  return len > 0 && name[len - 1] == '_';
+}
+
+struct UnionFind {
+  explicit UnionFind(size_t n) : parent(n) {
+    for (size_t i = 0; i < n; ++i) {
+      parent[i] = i;
+    }
+  }
+  size_t find(size_t x) {
+    while (parent[x] != x) {
+      parent[x] = parent[parent[x]];
+      x = parent[x];
+    }
+    return x;
+  }
+  void merge(size_t a, size_t b) {
+    parent[find(a)] = find(b);
+  }
+  std::vector<size_t> parent;
+};
+
+} // namespace
+
+void ScheduleStreams(const std::shared_ptr<Graph>& graph) {
+  // Collect the schedulable top-level nodes. Constants are handled
+  // separately: they are free, pure, and may be shared between regions.
+  std::vector<Node*> nodes;
+  std::unordered_map<Node*, size_t> node_index;
+  for (Node* node : graph->block()->nodes()) {
+    if (node->kind() == prim::Constant) {
+      continue;
+    }
+    // Control flow, side effects, and in-place ops make independence
+    // analysis unsound at this granularity; leave such graphs alone.
+    if (!node->blocks().empty() || node->hasSideEffects() ||
+        isMutatingOp(node)) {
+      return;
+    }
+    node_index[node] = nodes.size();
+    nodes.push_back(node);
+  }
+  if (nodes.size() < 2) {
+    return;
+  }
+
+  // Two nodes belong to the same region iff they are connected through a
+  // value; following producer edges covers every such connection.
+  UnionFind uf(nodes.size());
+  for (Node* node : nodes) {
+    for (Value* input : node->inputs()) {
+      auto it = node_index.find(input->node());
+      if (it != node_index.end()) {
+        uf.merge(node_index[node], it->second);
+      }
+    }
+  }
+
+  // Number the regions by first appearance, folding the overflow beyond
+  // kMaxStreamRegions round-robin so the stream pool is not oversubscribed.
+  std::unordered_map<size_t, size_t> root_to_region;
+  std::vector<std::vector<Node*>> regions;
+  for (Node* node : nodes) {
+    const size_t root = uf.find(node_index[node]);
+    auto it = root_to_region.find(root);
+    if (it == root_to_region.end()) {
+      const size_t region = root_to_region.size() < kMaxStreamRegions
+          ? regions.size()
+          : root_to_region.size() % kMaxStreamRegions;
+      it = root_to_region.emplace(root, region).first;
+      if (region == regions.size()) {
+        regions.emplace_back();
+      }
+    }
+    regions[it->second].push_back(node);
+  }
+  if (regions.size() < 2) {
+    return;
+  }
+
+  // Constants float to the front (they have no inputs), so every region can
+  // be made contiguous behind them without breaking topological order.
+  Node* last_constant = nullptr;
+  for (Node* node : graph->block()->nodes()) {
+    if (node->kind() != prim::Constant) {
+      continue;
+    }
+    if (last_constant == nullptr) {
+      Node* first = *graph->block()->nodes().begin();
+      if (node != first) {
+        node->moveBefore(first);
+      }
+    } else if (node->prev() != last_constant) {
+      node->moveAfter(last_constant);
+    }
+    last_constant = node;
+  }
+
+  // New nodes (index constants and markers) are appended behind `cursor`.
+  WithInsertPoint insert_point(graph->block()->return_node());
+  auto append = [&](Node* node, Node*& cursor) {
+    if (cursor == nullptr) {
+      node->moveBefore(nodes.front());
+    } else {
+      node->moveAfter(cursor);
+    }
+    cursor = node;
+  };
+
+  Node* cursor = last_constant;
+  Value* region_count = graph->insertConstant(
+      static_cast<int64_t>(regions.size()));
+  append(region_count->node(), cursor);
+  append(graph->create(forkSym(), {region_count}, 0), cursor);
+  for (size_t r = 0; r < regions.size(); ++r) {
+    Value* index = graph->insertConstant(static_cast<int64_t>(r));
+    append(index->node(), cursor);
+    append(graph->create(enterSym(), {index}, 0), cursor);
+    for (Node* node : regions[r]) {
+      node->moveAfter(cursor);
+      cursor = node;
+    }
+    append(graph->create(exitSym(), {index}, 0), cursor);
+  }
+  append(graph->create(joinSym(), {}, 0), cursor);
+}
+
+namespace {
+
+#ifdef USE_CUDA
+
+using c10::cuda::CUDAStream;
+using c10::cuda::getCurrentCUDAStream;
+using c10::cuda::getStreamFromPool;
+using c10::cuda::setCurrentCUDAStream;
+
+// Per-thread fork state. The markers are always emitted as a balanced
+// fork / enter / exit / join sequence at the top level, so one level of
+// state per interpreter thread suffices.
+struct StreamRegionState {
+  c10::optional<CUDAStream> base;
+  std::vector<CUDAStream> streams;
+  std::vector<at::cuda::CUDAEvent> events;
+};
+
+StreamRegionState& streamRegionState() {
+  static thread_local StreamRegionState state;
+  return state;
+}
+
+RegisterOperators stream_ops(
+    {Operator(
+         "streams::fork_regions(int n) -> ()",
+         [](Stack& stack) {
+           const auto n = pop(stack).toInt();
+           if (!at::hasCUDA()) {
+             return 0;
+           }
+           auto& state = streamRegionState();
+           state.base = getCurrentCUDAStream();
+           state.streams.clear();
+           state.events = std::vector<at::cuda::CUDAEvent>(n);
+           // Every region stream waits for the work the regions depend on,
+           // which by construction has all been issued on the base stream.
+           at::cuda::CUDAEvent inputs_ready;
+           inputs_ready.record(*state.base);
+           for (int64_t i = 0; i < n; ++i) {
+             state.streams.push_back(getStreamFromPool());
+             inputs_ready.block(state.streams.back());
+           }
+           return 0;
+         }),
+     Operator(
+         "streams::enter_region(int index) -> ()",
+         [](Stack& stack) {
+           const auto index = pop(stack).toInt();
+           if (!at::hasCUDA()) {
+             return 0;
+           }
+           setCurrentCUDAStream(streamRegionState().streams.at(index));
+           return 0;
+         }),
+     Operator(
+         "streams::exit_region(int index) -> ()",
+         [](Stack& stack) {
+           const auto index = pop(stack).toInt();
+           if (!at::hasCUDA()) {
+             return 0;
+           }
+           auto& state = streamRegionState();
+           state.events.at(index).record(state.streams.at(index));
+           setCurrentCUDAStream(*state.base);
+           return 0;
+         }),
+     Operator("streams::join_regions() -> ()", [](Stack& stack) {
+       if (!at::hasCUDA()) {
+         return 0;
+       }
+       auto& state = streamRegionState();
+       setCurrentCUDAStream(*state.base);
+       for (auto& event : state.events) {
+         event.block(*state.base);
+       }
+       state.base = c10::nullopt;
+       state.streams.clear();
+       state.events.clear();
+       return 0;
+     })});
+
+#else // USE_CUDA
+
+// CPU-only build: the markers still have to resolve to operators so a
+// scheduled graph stays loadable; they do nothing.
+RegisterOperators stream_ops(
+    {Operator(
+         "streams::fork_regions(int n) -> ()",
+         [](Stack& stack) {
+           pop(stack);
+           return 0;
+         }),
+     Operator(
+         "streams::enter_region(int index) -> ()",
+         [](Stack& stack) {
+           pop(stack);
+           return 0;
+         }),
+     Operator(
+         "streams::exit_region(int index) -> ()",
+         [](Stack& stack) {
+           pop(stack);
+           return 0;
+         }),
+     Operator("streams::join_regions() -> ()", [](Stack& stack) {
+       return 0;
+     })});
+
+#endif // USE_CUDA
+
+} // namespace
+
+} // namespace jit
+} // namespace torch
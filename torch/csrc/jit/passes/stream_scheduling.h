@@ -0,0 +1,19 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Partitions the top level of the graph into data-independent regions and
+// wraps each region with streams::enter_region / streams::exit_region
+// markers (plus one streams::fork_regions / streams::join_regions pair), so
+// the interpreter runs each region on its own CUDA stream from the pool and
+// joins them with events. Graphs with fewer than two independent regions,
+// with control flow, or with mutating ops at the top level are left
+// untouched. Run this last: the marker ops are opaque to the optimization
+// passes. A no-op on CPU-only builds and for CPU graphs at runtime.
+TORCH_API void ScheduleStreams(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
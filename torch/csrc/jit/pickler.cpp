@@ -1,5 +1,7 @@
 #include <torch/csrc/jit/pickler.h>
 
+#include <algorithm>
+
 namespace torch {
 namespace jit {
 
@@ -32,10 +34,45 @@ const std::string& getModuleName() {
   return module_name;
 }
 
+void writeTensorData(
+    const at::Tensor& tensor,
+    const PickleWriter& writer,
+    size_t chunk_size) {
+  AT_CHECK(
+      tensor.device().is_cpu(),
+      "writeTensorData expects a CPU tensor, got one on ", tensor.device());
+  // Chunks stay multiples of 64 bytes (except the last), so a sink that
+  // places the tensor at an aligned offset keeps chunk boundaries aligned.
+  chunk_size = std::max<size_t>(chunk_size / 64 * 64, 64);
+  at::Tensor contig = tensor.contiguous();
+  const char* data = static_cast<const char*>(contig.data_ptr());
+  const size_t nbytes = contig.numel() * contig.element_size();
+  for (size_t offset = 0; offset < nbytes; offset += chunk_size) {
+    writer(data + offset, std::min(chunk_size, nbytes - offset));
+  }
+}
+
 const std::vector<char>& Pickler::stack() {
+  AT_CHECK(
+      !writer_,
+      "stack() is unavailable on a streaming Pickler; the bytes have "
+      "already been handed to the writer");
   return stack_;
 }
 
+void Pickler::flushIfNeeded() {
+  if (writer_ && stack_.size() >= buffer_limit_) {
+    flush();
+  }
+}
+
+void Pickler::flush() {
+  if (!stack_.empty()) {
+    writer_(stack_.data(), stack_.size());
+    stack_.clear();
+  }
+}
+
 void Pickler::start() {
   push<OpCode>(OpCode::PROTO);
   push<uint8_t>(2);
@@ -49,6 +86,9 @@ void Pickler::start() {
 void Pickler::finish() {
   push<OpCode>(OpCode::APPENDS);
   push<OpCode>(OpCode::STOP);
+  if (writer_) {
+    flush();
+  }
 }
 
 void Pickler::addIValue(const IValue& ivalue) {
@@ -149,6 +189,7 @@ void Pickler::pushMemoizedString(const IValue& ivalue) {
 
 void Pickler::pushString(const std::string& string) {
   stack_.insert(stack_.end(), string.begin(), string.end());
+  flushIfNeeded();
 }
 
 void Pickler::pushClass(PicklerClass cls) {
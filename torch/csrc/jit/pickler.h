@@ -1,8 +1,10 @@
+#include <functional>
 #include <string>
 #include <vector>
 
 #include <ATen/core/ivalue.h>
 #include <c10/util/ArrayRef.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
 #include <torch/csrc/utils/disallow_copy.h>
 
 namespace torch {
@@ -87,6 +89,18 @@ enum PicklerClass : uint8_t { TENSOR = 0, INTLIST = 1 };
 
 using ::c10::IValue;
 
+// A sink for pickled bytes; may be called many times with small pieces.
+using PickleWriter = std::function<void(const char* data, size_t size)>;
+
+// Streams the raw bytes of a (CPU) tensor through `writer` in chunks of at
+// most `chunk_size` bytes, without materializing a second copy. All chunks
+// except the last are multiples of 64 bytes, so a sink that starts the
+// tensor at an aligned offset keeps every chunk boundary aligned.
+TORCH_API void writeTensorData(
+    const at::Tensor& tensor,
+    const PickleWriter& writer,
+    size_t chunk_size = 1 << 20);
+
 class Pickler {
   TH_DISALLOW_COPY_AND_ASSIGN(Pickler);
 
@@ -94,6 +108,20 @@ class Pickler {
   Pickler(std::vector<at::Tensor>* tensor_table)
       : tensor_table_(tensor_table) {}
 
+  // Streaming variant: opcodes and inline data are flushed to `writer`
+  // whenever the internal buffer exceeds `buffer_size`, so pickling memory
+  // stays O(buffer) no matter how large the value is. Tensor payloads stay
+  // out-of-band in `tensor_table` (the stream only references indices);
+  // writers can stream each table entry with writeTensorData. stack() is
+  // unavailable in this mode.
+  Pickler(
+      PickleWriter writer,
+      std::vector<at::Tensor>* tensor_table,
+      size_t buffer_size = 1 << 16)
+      : writer_(std::move(writer)),
+        buffer_limit_(buffer_size),
+        tensor_table_(tensor_table) {}
+
   const std::vector<char>& stack();
   void start();
   void finish();
@@ -115,6 +143,11 @@ class Pickler {
   void pushInt(const IValue& ivalue);
   const void* getPointer(const IValue& ivalue);
 
+  // Hands the buffer to writer_ once it outgrows buffer_limit_; a no-op
+  // when buffering the whole pickle (no writer).
+  void flushIfNeeded();
+  void flush();
+
   // These convert values to bytes and add them to the stack (NB: since T is to
   // the left of a '::', its type cannot be deduced by the compiler so one must
   // explicitly instantiate the template, i.e. push<int>(int) works, push(int)
@@ -123,11 +156,17 @@ class Pickler {
   void push(typename std::common_type<T>::type value) {
     const char* begin = reinterpret_cast<const char*>(&value);
     stack_.insert(stack_.end(), begin, begin + sizeof(T));
+    flushIfNeeded();
   }
 
   // Stack of opcodes/data
   std::vector<char> stack_;
 
+  // Sink and buffer bound for the streaming mode; unset when the whole
+  // pickle is buffered in stack_.
+  PickleWriter writer_;
+  size_t buffer_limit_ = 0;
+
   // Memoization of IValues that have been written (index in table is used for
   // BINPUT opcodes) to enable shared references
   std::unordered_map<const void*, uint32_t> memo_map_;
@@ -46,12 +46,49 @@ void ProfilingRecord::instrumentBlock(Block* block) {
       pn->insertAfter(n);
     }
 
+    if (n->kind() == prim::Loop) {
+      // Record the distribution of trip counts the loop runs with, so the
+      // dominant small counts can be specialized later; see
+      // Note [Profile-guided unrolling] in passes/loop_unrolling.cpp.
+      std::function<void(Stack&)> trip_profiler = [this, n](Stack& stack) {
+        IValue count;
+        pop(stack, count);
+        if (count.isInt()) {
+          std::lock_guard<std::mutex> lock(this->mutex_);
+          loop_trip_counts_[n][count.toInt()]++;
+        }
+      };
+
+      auto pn = createProfileNode(trip_profiler, {n->inputs().at(0)});
+      pn->insertBefore(n);
+    }
+
     for (auto b : n->blocks()) {
       instrumentBlock(b);
     }
   }
 }
 
+c10::optional<int64_t> ProfilingRecord::dominantTripCount(
+    Node* loop,
+    double fraction) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = loop_trip_counts_.find(loop);
+  if (it == loop_trip_counts_.end()) {
+    return c10::nullopt;
+  }
+  size_t total = 0;
+  for (const auto& entry : it->second) {
+    total += entry.second;
+  }
+  for (const auto& entry : it->second) {
+    if (entry.second >= fraction * total) {
+      return entry.first;
+    }
+  }
+  return c10::nullopt;
+}
+
 std::unique_ptr<ProfilingRecord> ProfilingRecord::instrumentGraph(
     const std::shared_ptr<Graph>& graph) {
   auto new_g = graph->copy();
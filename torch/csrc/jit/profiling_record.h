@@ -7,6 +7,7 @@
 #include <torch/csrc/jit/ir.h>
 
 #include <list>
+#include <map>
 #include <vector>
 
 namespace torch {
@@ -24,9 +25,17 @@ struct ProfilingRecord {
   static std::unique_ptr<ProfilingRecord> instrumentGraph(
       const std::shared_ptr<Graph>& graph);
 
+  // Returns the trip count that accounts for at least `fraction` of the
+  // observed executions of `loop` (a prim::Loop of profiled_graph_), if
+  // any count dominates. Consumed by SpecializeProfiledLoops; see
+  // Note [Profile-guided unrolling] in passes/loop_unrolling.cpp.
+  c10::optional<int64_t> dominantTripCount(Node* loop, double fraction = 0.9);
+
   std::shared_ptr<Graph> profiled_graph_;
   std::mutex mutex_;
   size_t profiling_count_;
+  // For each instrumented prim::Loop, how often each trip count was seen.
+  std::map<Node*, std::map<int64_t, size_t>> loop_trip_counts_;
 
  private:
   Node* createProfileNode(
@@ -10,6 +10,7 @@
 #include <torch/csrc/jit/ir.h>
 #include <torch/csrc/jit/operator.h>
 #include <torch/csrc/jit/profiling_record.h>
+#include <torch/csrc/jit/script/compilation_unit.h>
 #include <torch/csrc/jit/script/jit_exception.h>
 #include <torch/csrc/jit/script/logging.h>
 
@@ -426,6 +427,20 @@ RegisterOperators reg(
              return 0;
            };
          }),
+     Operator(
+         prim::CallFunction,
+         [](const Node* node) -> Operation {
+           // See Note [Call-preserving compilation] in script/module.cpp.
+           auto* fn = reinterpret_cast<script::Function*>(node->i(attr::fn));
+           return [fn](Stack& stack) {
+             // The arguments are already on top of the stack in declaration
+             // order; the callee's executor consumes them and leaves the
+             // result in place, so there is no IValue repacking on either
+             // side of the call.
+             fn->run(stack);
+             return 0;
+           };
+         }),
      Operator(
          prim::Print,
          [](const Node* node) {
@@ -663,11 +678,13 @@ RegisterOperators reg(
          [](const Node* node) {
            size_t num_inputs = node->inputs().size();
            return [=](Stack& stack) {
-             std::vector<IValue> elems{
-                 std::make_move_iterator(stack.end() - num_inputs),
-                 std::make_move_iterator(stack.end())};
+             // Moves the inputs straight off the stack; small tuples reuse
+             // pooled storage (see Note [Small tuple recycling]).
+             IValue* inputs =
+                 num_inputs == 0 ? nullptr : &*(stack.end() - num_inputs);
+             auto tuple = Tuple::create(inputs, num_inputs);
              drop(stack, num_inputs);
-             push(stack, Tuple::create(std::move(elems)));
+             push(stack, std::move(tuple));
              return 0;
            };
          }),
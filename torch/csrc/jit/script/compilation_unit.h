@@ -11,6 +11,7 @@
 #include <c10/util/ArrayRef.h>
 #include <c10/util/Optional.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -49,6 +50,9 @@ struct TORCH_API Function {
         function_creator_(std::move(function_creator)) {}
 
   void run(Stack& stack) {
+    // Relaxed: the count is only a profiling hint for the inlining
+    // heuristic; see InlineSmallCalls.
+    invocations_.fetch_add(1, std::memory_order_relaxed);
     get_executor().run(stack);
   }
 
@@ -106,6 +110,13 @@ struct TORCH_API Function {
     return optimize_;
   }
 
+  // Number of times this function has been run, from any call site. Used by
+  // the graph executor to decide which preserved calls are hot enough to be
+  // worth inlining; see Note [Call-preserving compilation].
+  uint64_t invocations() const {
+    return invocations_.load(std::memory_order_relaxed);
+  }
+
   void check_single_output() {
     AT_CHECK(
         graph()->outputs().size() == 1,
@@ -165,6 +176,8 @@ struct TORCH_API Function {
 
   std::once_flag executor_init_;
 
+  std::atomic<uint64_t> invocations_{0};
+
   // an optional function that actually creates the method when
   // emit_call_to(this,...) is first called. this is used by the compiler so
   // that it can construct methods out of order
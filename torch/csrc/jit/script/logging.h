@@ -75,12 +75,15 @@ constexpr const char* EXECUTION_PLAN_CACHE_HIT =
     "pytorch_runtime.execution_plan_cache_hit";
 constexpr const char* EXECUTION_PLAN_CACHE_MISS =
     "pytorch_runtime.execution_plan_cache_miss";
+constexpr const char* EXECUTION_PLAN_CACHE_EVICTION =
+    "pytorch_runtime.execution_plan_cache_eviction";
 
 inline std::vector<const char*> allRuntimeCounters() {
   return {GRAPH_EXECUTORS_CONSTRUCTED,
           GRAPH_EXECUTOR_INVOCATIONS,
           EXECUTION_PLAN_CACHE_HIT,
-          EXECUTION_PLAN_CACHE_MISS};
+          EXECUTION_PLAN_CACHE_MISS,
+          EXECUTION_PLAN_CACHE_EVICTION};
 }
 
 } // namespace runtime_counters
@@ -1,4 +1,5 @@
 #include <torch/csrc/jit/script/module.h>
+#include <ATen/core/grad_mode.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/jit/export.h>
 #include <torch/csrc/jit/operator.h>
@@ -8,6 +9,8 @@
 #include <torch/csrc/jit/script/schema_matching.h>
 #include <torch/csrc/autograd/generated/variable_factories.h>
 
+#include <cstdlib>
+
 namespace torch {
 namespace jit {
 namespace script {
@@ -17,6 +20,37 @@ void placeholderCreator(Function&) {
   throw RecursiveMethodCallError();
 }
 
+namespace {
+// Note [Call-preserving compilation]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// By default every script call is inlined into the caller at emission
+// time, so a model with hundreds of methods compiles to one enormous
+// graph whose optimization dominates load time. When
+// PYTORCH_JIT_PRESERVE_CALLS=1, calls are instead emitted as
+// prim::CallFunction nodes that carry a pointer to the callee Function.
+// The interpreter runs such a node by handing the stack directly to the
+// callee's own executor -- arguments are already on top of the stack in
+// declaration order, so the call is one frame push with no IValue
+// repacking -- and the callee's graph is compiled exactly once no matter
+// how many call sites it has. The graph executor later inlines only
+// callees that have proven both small and hot (see InlineSmallCalls),
+// recovering the fusion wins of inlining where they matter.
+//
+// The Function pointer is stashed as an integer attribute, which relies
+// on the CompilationUnit (and so every callee) outliving graphs that
+// call into it; that holds for methods of one module tree, the only
+// place calls are emitted. Graphs in this form are a runtime-only
+// representation: they cannot be serialized, which is why the flag is
+// opt-in.
+bool callPreservingEnabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("PYTORCH_JIT_PRESERVE_CALLS");
+    return env && env[0] == '1';
+  }();
+  return enabled;
+}
+} // namespace
+
 void Function::ensure_defined() {
   try {
     if (function_creator_) {
@@ -57,6 +91,18 @@ Value* Function::try_emit_call(
     return nullptr;
 
   check_single_output();
+
+  if (callPreservingEnabled()) {
+    // See Note [Call-preserving compilation].
+    Node* call =
+        graph.insertNode(graph.create(prim::CallFunction, matched_schema->inputs, 1));
+    call->setSourceLocation(std::make_shared<SourceRange>(loc));
+    call->s_(attr::name, name_);
+    call->i_(attr::fn, reinterpret_cast<int64_t>(this));
+    call->output()->setType(getSchema().returns().at(0).type());
+    return call->output();
+  }
+
   return inlineCallTo(graph, *fn, matched_schema->inputs).at(0);
 }
 
@@ -355,6 +401,85 @@ void Module::train(bool on) {
  register_buffer("training", torch::tensor(on ? 1 : 0, at::kLong));
 }
 
+namespace detail {
+std::atomic<uint64_t>& parameter_epoch() {
+  static std::atomic<uint64_t> epoch{0};
+  return epoch;
+}
+} // namespace detail
+
+namespace {
+// Serializes staging and publishing across all module trees: the epoch is
+// global, so two publishes must not interleave their odd windows.
+std::mutex& publishMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+} // namespace
+
+void Module::stage_parameter(const std::string& name, at::Tensor v) {
+  size_t offset = get_offset(name, EntityType::PARAMETER);
+  auto current = parameters_[offset].value().toTensor();
+  AT_CHECK(
+      v.sizes().equals(current.sizes()),
+      "staged value for parameter '",
+      name,
+      "' has shape ",
+      v.sizes(),
+      " but the parameter has shape ",
+      current.sizes());
+  AT_CHECK(
+      v.dtype() == current.dtype(),
+      "staged value for parameter '",
+      name,
+      "' has dtype ",
+      v.dtype(),
+      " but the parameter has dtype ",
+      current.dtype());
+  // The back buffer: a fresh storage matching the live parameter, so the
+  // tensor requests are currently reading is never written in place.
+  at::AutoGradMode grad_guard(false);
+  auto fresh = at::empty_like(current);
+  fresh.copy_(v);
+  std::lock_guard<std::mutex> lock(publishMutex());
+  for (auto& staged : staged_parameters_) {
+    if (staged.first == offset) {
+      staged.second = fresh;
+      return;
+    }
+  }
+  staged_parameters_.emplace_back(offset, fresh);
+}
+
+uint64_t Module::publish_parameters() {
+  // Declared before the lock so the tensors retired two publishes ago are
+  // released after the lock is dropped.
+  std::vector<IValue> dropped;
+  std::lock_guard<std::mutex> lock(publishMutex());
+  auto& epoch = detail::parameter_epoch();
+  epoch.fetch_add(1, std::memory_order_acq_rel); // odd: publish in flight
+  apply_staged_parameters(dropped);
+  return epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+void Module::apply_staged_parameters(std::vector<IValue>& dropped) {
+  // Values retired by the previous publish have had a whole publish
+  // interval for the runs that captured them to drain; let go of them.
+  for (auto& retired : retired_parameters_) {
+    dropped.push_back(std::move(retired));
+  }
+  retired_parameters_.clear();
+  for (auto& staged : staged_parameters_) {
+    Slot slot = parameters_[staged.first];
+    retired_parameters_.push_back(slot.value());
+    slot.setValue(std::move(staged.second));
+  }
+  staged_parameters_.clear();
+  for (auto& mod : modules_) {
+    mod->apply_staged_parameters(dropped);
+  }
+}
+
 } // namespace script
 } // namespace jit
 } // namespace torch
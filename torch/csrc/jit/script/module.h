@@ -18,11 +18,13 @@
 #include <c10/util/ArrayRef.h>
 #include <c10/util/Optional.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -54,6 +56,12 @@ struct Module;
 using ModuleLookup =
     std::function<std::shared_ptr<Module>(const std::vector<std::string>&)>;
 
+namespace detail {
+// Global weight epoch: even while weights are stable, odd while a publish
+// is flipping slots. See Note [Hot-swapping parameters] in Module.
+TORCH_API std::atomic<uint64_t>& parameter_epoch();
+} // namespace detail
+
 struct TORCH_API Method {
   Method(Module* owner, Function* function, std::vector<Slot> initial_members)
       : owner_(owner),
@@ -68,9 +76,7 @@ struct TORCH_API Method {
   }
 
   void run(Stack& stack) {
-    for (auto input : initial_ivalues_) {
-      push(stack, input.value());
-    }
+    push_initial_ivalues(stack);
     function_->run(stack);
   }
   void run(Stack&& stack) {
@@ -81,9 +87,7 @@ struct TORCH_API Method {
       std::vector<IValue> stack,
       const Kwargs& kwargs = Kwargs()) {
     getSchema().checkAndNormalizeInputs(stack, kwargs);
-    for (auto input : initial_ivalues_) {
-      push(stack, input.value());
-    }
+    push_initial_ivalues(stack);
     // use run rather than operator() to skip the second schema check.
     function_->run(std::move(stack));
     return stack.front();
@@ -123,6 +127,28 @@ struct TORCH_API Method {
   }
 
  private:
+  // Snapshots the member values this method closes over onto the stack.
+  // See Note [Hot-swapping parameters]: if a publish overlaps the reads,
+  // the snapshot is discarded and retaken, so one run never mixes weight
+  // epochs. When no publish is in flight this costs two atomic loads.
+  void push_initial_ivalues(Stack& stack) {
+    const size_t base = stack.size();
+    auto& epoch = detail::parameter_epoch();
+    for (;;) {
+      const uint64_t observed = epoch.load(std::memory_order_acquire);
+      if ((observed & 1) == 0) {
+        for (auto input : initial_ivalues_) {
+          push(stack, input.value());
+        }
+        if (epoch.load(std::memory_order_acquire) == observed) {
+          return;
+        }
+        stack.resize(base);
+      }
+      std::this_thread::yield();
+    }
+  }
+
   // Methods are uniqued onwed by a single module. This raw pointer allows
   // looking up the module.
   Module* owner_;
@@ -247,6 +273,28 @@ struct TORCH_API Module {
     return autograd::as_variable_ref(parameter_slot(name).value().toTensor());
   }
 
+  // Note [Hot-swapping parameters]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Serving processes push freshly trained weights into a live module
+  // without pausing the interpreter. stage_parameter copies the new value
+  // into a back buffer -- a fresh storage, so the tensor that in-flight
+  // requests are reading is never written in place -- and
+  // publish_parameters then flips every staged value in the module tree
+  // into its slot inside one epoch window. Methods snapshot their member
+  // values at entry under a seqlock on detail::parameter_epoch: publish
+  // makes the epoch odd while it swaps slots, and a run that observes a
+  // mid-publish or changed epoch discards and retakes its snapshot, so
+  // every run sees either all-old or all-new weights. The values a
+  // publish replaces are kept alive until the next publish, so a run that
+  // raced the flip and captured them still holds valid tensors; this
+  // assumes requests finish within one publish interval (minutes in
+  // practice, against second-scale requests).
+  void stage_parameter(const std::string& name, at::Tensor v);
+  // Atomically applies every value staged in this module tree and returns
+  // the new (even) epoch. Typically called on the root module between
+  // request batches.
+  uint64_t publish_parameters();
+
   IValue get_attribute(const std::string& name) const {
     return attributes_[get_offset(name, EntityType::ATTRIBUTE)].value();
   }
@@ -484,6 +532,11 @@ struct TORCH_API Module {
       const c10::optional<at::ScalarType>& dtype,
       bool non_blocking);
 
+  // See Note [Hot-swapping parameters]. Caller holds the publish lock and
+  // has already made the epoch odd; values retired by the previous
+  // publish are moved into `dropped` for release outside the window.
+  void apply_staged_parameters(std::vector<IValue>& dropped);
+
   static const char* toString(EntityType t) {
     switch (t) {
       case EntityType::MODULE:
@@ -587,6 +640,12 @@ struct TORCH_API Module {
   std::vector<Slot> attributes_;
   std::vector<std::unique_ptr<Method>> methods_;
 
+  // See Note [Hot-swapping parameters]: values staged for the next
+  // publish (keyed by offset into parameters_), and the values the last
+  // publish replaced, kept alive for runs that captured them.
+  std::vector<std::pair<size_t, IValue>> staged_parameters_;
+  std::vector<IValue> retired_parameters_;
+
   std::unordered_map<std::string, Entry> dict_;
   std::string name_;
 
@@ -0,0 +1,84 @@
+#include <torch/csrc/jit/trace_variant_cache.h>
+
+#include <torch/csrc/jit/passes/canonicalize.h>
+#include <torch/csrc/jit/passes/shape_analysis.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+struct TraceVariantCacheImpl {
+  std::mutex mutex_;
+
+  // Branch-decision key -> executor.
+  std::unordered_map<std::string, GraphExecutor> byKey_;
+
+  // Canonicalized trace printout -> executor, used to dedupe variants
+  // whose decisions differ but whose traces do not. Structural identity
+  // through the printed canonical form mirrors the fuser's kernel cache.
+  std::unordered_map<std::string, GraphExecutor> byRepr_;
+};
+
+TraceVariantCacheImpl& getCache() {
+  static TraceVariantCacheImpl cache;
+  return cache;
+}
+
+std::string reprForCache(const std::shared_ptr<Graph>& graph) {
+  auto normalized = Canonicalize(graph, /*keep_unique_names=*/false);
+  // Shapes recorded during tracing are input-specific; the executor
+  // re-derives them per ArgumentSpec, so they must not split the cache.
+  EraseShapeInformation(normalized);
+  return normalized->toString();
+}
+
+} // namespace
+
+GraphExecutor lookupTraceVariant(const std::string& key) {
+  auto& cache = getCache();
+  std::lock_guard<std::mutex> guard{cache.mutex_};
+  const auto it = cache.byKey_.find(key);
+  if (it == cache.byKey_.end()) {
+    return GraphExecutor();
+  }
+  return it->second;
+}
+
+GraphExecutor storeTraceVariant(
+    const std::string& key,
+    const std::shared_ptr<Graph>& graph) {
+  auto repr = reprForCache(graph);
+  auto& cache = getCache();
+  std::lock_guard<std::mutex> guard{cache.mutex_};
+
+  const auto key_it = cache.byKey_.find(key);
+  if (key_it != cache.byKey_.end()) {
+    return key_it->second;
+  }
+
+  const auto repr_it = cache.byRepr_.find(repr);
+  if (repr_it != cache.byRepr_.end()) {
+    // A structurally identical trace is already optimized; the new key
+    // shares its executor and accumulated plans.
+    cache.byKey_.emplace(key, repr_it->second);
+    return repr_it->second;
+  }
+
+  GraphExecutor executor(graph);
+  cache.byKey_.emplace(key, executor);
+  cache.byRepr_.emplace(std::move(repr), executor);
+  return executor;
+}
+
+int64_t debugNumCachedTraceVariants() {
+  auto& cache = getCache();
+  std::lock_guard<std::mutex> guard{cache.mutex_};
+  return cache.byRepr_.size();
+}
+
+} // namespace jit
+} // namespace torch
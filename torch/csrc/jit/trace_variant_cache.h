@@ -0,0 +1,42 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/graph_executor.h>
+#include <torch/csrc/jit/ir.h>
+
+#include <memory>
+#include <string>
+
+namespace torch {
+namespace jit {
+
+// A process-wide cache of executors for traced model variants.
+//
+// Models with a few data-dependent branches produce one trace per taken
+// branch combination, and re-tracing plus re-optimizing a variant from
+// scratch costs seconds. The caller encodes its branch decisions into a
+// string key (e.g. "beam=4;postnorm=1") and registers each trace once;
+// variants whose traces canonicalize to the same IR -- common when a
+// branch only changes a region the tracer never saw, or two decision
+// combinations collapse to the same computation -- share a single
+// GraphExecutor, and with it the ArgumentSpec-keyed optimized plans that
+// executor accumulates. Re-registering a known key is free, so eagerly
+// pre-tracing variants at startup only pays for the distinct graphs.
+
+// Returns the executor registered for this branch-decision key, or an
+// unconstructed GraphExecutor (operator bool is false) if the key is
+// unknown.
+TORCH_API GraphExecutor lookupTraceVariant(const std::string& key);
+
+// Registers the trace for `key` and returns its executor. If another
+// key's trace is structurally identical after canonicalization, that
+// key's executor is shared instead of building a new one.
+TORCH_API GraphExecutor storeTraceVariant(
+    const std::string& key,
+    const std::shared_ptr<Graph>& graph);
+
+// Number of distinct executors currently cached; for testing.
+TORCH_API int64_t debugNumCachedTraceVariants();
+
+} // namespace jit
+} // namespace torch
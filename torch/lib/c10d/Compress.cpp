@@ -0,0 +1,128 @@
+#include <c10d/Compress.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace c10d {
+
+namespace {
+
+void checkCompressInputs(
+    const std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  if (tensors.empty()) {
+    throw std::invalid_argument("argument is empty");
+  }
+  if (opts.reduceOp != ReduceOp::SUM) {
+    throw std::invalid_argument(
+        "compressed collectives only support ReduceOp::SUM");
+  }
+  for (const auto& tensor : tensors) {
+    if (tensor.scalar_type() != at::kFloat) {
+      throw std::invalid_argument(
+          "compressed collectives expect fp32 inputs");
+    }
+  }
+}
+
+// Lazily sizes the error feedback to match the inputs. The residuals are
+// flat so that both collectives can share a state.
+void ensureErrorFeedback(
+    CompressionState& state,
+    const std::vector<at::Tensor>& tensors) {
+  if (state.errorFeedback.size() != tensors.size()) {
+    state.errorFeedback.clear();
+    state.errorFeedback.reserve(tensors.size());
+    for (const auto& tensor : tensors) {
+      state.errorFeedback.push_back(
+          at::zeros({tensor.numel()}, tensor.options()));
+    }
+  }
+}
+
+} // namespace
+
+void allreduceHalf(
+    ProcessGroup& pg,
+    std::vector<at::Tensor>& tensors,
+    CompressionState& state,
+    const AllreduceOptions& opts) {
+  checkCompressInputs(tensors, opts);
+  ensureErrorFeedback(state, tensors);
+
+  std::vector<at::Tensor> wire(tensors.size());
+  for (size_t i = 0; i < tensors.size(); i++) {
+    // Compensate with last step's residual, then quantize for the wire.
+    auto compensated =
+        tensors[i].reshape({-1}) + state.errorFeedback[i];
+    wire[i] = compensated.to(at::kHalf);
+    state.errorFeedback[i] = compensated - wire[i].to(at::kFloat);
+  }
+
+  pg.allreduce(wire, opts)->wait();
+
+  for (size_t i = 0; i < tensors.size(); i++) {
+    tensors[i].copy_(wire[i].to(at::kFloat).view(tensors[i].sizes()));
+  }
+}
+
+void allreduceTopK(
+    ProcessGroup& pg,
+    std::vector<at::Tensor>& tensors,
+    int64_t k,
+    CompressionState& state,
+    const AllreduceOptions& opts) {
+  checkCompressInputs(tensors, opts);
+  if (k <= 0) {
+    throw std::invalid_argument("k must be positive");
+  }
+  ensureErrorFeedback(state, tensors);
+
+  const auto worldSize = static_cast<size_t>(pg.getSize());
+
+  // Pack: per tensor, the flat indices and values of the k
+  // largest-magnitude compensated entries. Every rank must contribute the
+  // same element count to the allgather, so k is clamped uniformly.
+  std::vector<at::Tensor> wireIndices(tensors.size());
+  std::vector<at::Tensor> wireValues(tensors.size());
+  for (size_t i = 0; i < tensors.size(); i++) {
+    auto compensated =
+        tensors[i].reshape({-1}) + state.errorFeedback[i];
+    const int64_t kClamped = std::min(k, compensated.numel());
+    auto indices =
+        std::get<1>(compensated.abs().topk(kClamped, /*dim=*/0));
+    wireIndices[i] = indices;
+    wireValues[i] = compensated.gather(0, indices);
+    // The transmitted entries are sent exactly; everything else is the
+    // residual carried into the next step.
+    state.errorFeedback[i] =
+        compensated.scatter(0, indices, at::zeros_like(wireValues[i]));
+  }
+
+  std::vector<std::vector<at::Tensor>> allIndices(tensors.size());
+  std::vector<std::vector<at::Tensor>> allValues(tensors.size());
+  for (size_t i = 0; i < tensors.size(); i++) {
+    allIndices[i].reserve(worldSize);
+    allValues[i].reserve(worldSize);
+    for (size_t r = 0; r < worldSize; r++) {
+      allIndices[i].push_back(at::empty_like(wireIndices[i]));
+      allValues[i].push_back(at::empty_like(wireValues[i]));
+    }
+  }
+
+  pg.allgather(allIndices, wireIndices)->wait();
+  pg.allgather(allValues, wireValues)->wait();
+
+  // Unpack: accumulate every rank's sparse contribution into the dense
+  // result. index_add_ handles indices picked by multiple ranks.
+  for (size_t i = 0; i < tensors.size(); i++) {
+    auto result = at::zeros(
+        {tensors[i].numel()}, tensors[i].options());
+    for (size_t r = 0; r < worldSize; r++) {
+      result.index_add_(0, allIndices[i][r], allValues[i][r]);
+    }
+    tensors[i].copy_(result.view(tensors[i].sizes()));
+  }
+}
+
+} // namespace c10d
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include <ATen/ATen.h>
+
+#include <c10d/ProcessGroup.hpp>
+#include <c10d/Types.hpp>
+
+namespace c10d {
+
+// Compressed gradient collectives for network-bound training.
+//
+// Both collectives below carry an error feedback buffer: whatever the
+// compression discards this step (quantization residual, untransmitted
+// entries) is stashed locally in fp32 and added back into the next step's
+// input, so the compression error accumulates into later updates instead
+// of being lost. The state must be reused across steps for this to work;
+// use one state per (process group, tensor list) pair.
+//
+// These helpers are synchronous: they wait on the underlying collective
+// so they can unpack the wire tensors into the caller's buffers. Only
+// ReduceOp::SUM is supported, and inputs must be fp32.
+struct CompressionState {
+  // Per-tensor fp32 residuals, lazily initialized to zeros on first use.
+  std::vector<at::Tensor> errorFeedback;
+};
+
+// Allreduce that moves fp16 on the wire, halving wire bytes. Inputs are
+// compensated with the error feedback, cast to fp16, summed by the
+// underlying allreduce, and cast back into the fp32 inputs; the
+// quantization residual is kept in the state.
+void allreduceHalf(
+    ProcessGroup& pg,
+    std::vector<at::Tensor>& tensors,
+    CompressionState& state,
+    const AllreduceOptions& opts = AllreduceOptions());
+
+// Sparsified allreduce: each rank contributes only its k
+// largest-magnitude entries per tensor (values and flat indices moved via
+// allgather), and every rank accumulates all contributions into its dense
+// fp32 input. Wire bytes per rank are ~12k per tensor instead of 4*numel;
+// entries that did not make the top k stay in the error feedback.
+void allreduceTopK(
+    ProcessGroup& pg,
+    std::vector<at::Tensor>& tensors,
+    int64_t k,
+    CompressionState& state,
+    const AllreduceOptions& opts = AllreduceOptions());
+
+} // namespace c10d
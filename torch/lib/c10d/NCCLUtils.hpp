@@ -58,6 +58,24 @@ class NCCLComm {
     return ncclComm_;
   }
 
+  // Tears the communicator down without waiting for pending operations
+  // to complete. Used when shrinking an elastic process group: peer
+  // ranks may be dead, so an orderly ncclCommDestroy could block
+  // forever waiting for them. Falls back to destroy on NCCL versions
+  // that do not provide abort.
+  void abort() {
+    if (ncclComm_ == nullptr) {
+      return;
+    }
+#if defined(NCCL_MAJOR) && \
+    (NCCL_MAJOR > 2 || (NCCL_MAJOR == 2 && NCCL_MINOR >= 4))
+    C10D_NCCL_CHECK(ncclCommAbort(ncclComm_));
+#else
+    C10D_NCCL_CHECK(ncclCommDestroy(ncclComm_));
+#endif
+    ncclComm_ = nullptr;
+  }
+
  protected:
   ncclComm_t ncclComm_;
 };
@@ -29,6 +29,12 @@ std::vector<uint8_t> PrefixStore::get(const std::string& key) {
   return store_.get(joinKey(key));
 }
 
+std::vector<std::vector<uint8_t>> PrefixStore::multiGet(
+    const std::vector<std::string>& keys) {
+  auto joinedKeys = joinKeys(keys);
+  return store_.multiGet(joinedKeys);
+}
+
 int64_t PrefixStore::add(const std::string& key, int64_t value) {
   return store_.add(joinKey(key), value);
 }
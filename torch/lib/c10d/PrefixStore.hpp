@@ -14,6 +14,9 @@ class PrefixStore : public Store {
 
   std::vector<uint8_t> get(const std::string& key) override;
 
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys) override;
+
   int64_t add(const std::string& key, int64_t value) override;
 
   bool check(const std::vector<std::string>& keys) override;
@@ -2,6 +2,18 @@
 
 namespace c10d {
 
+namespace {
+
+// Returned by Work::then; completed once the upstream callback has run.
+class ChainedWork : public ProcessGroup::Work {
+ public:
+  void complete(std::exception_ptr eptr) {
+    finish(eptr);
+  }
+};
+
+} // namespace
+
 ProcessGroup::Work::~Work() {}
 
 bool ProcessGroup::Work::isCompleted() {
@@ -36,12 +48,49 @@ void ProcessGroup::Work::wait() {
   synchronize();
 }
 
+void ProcessGroup::Work::addCallback(std::function<void(Work&)> callback) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!completed_) {
+    callbacks_.push_back(std::move(callback));
+    return;
+  }
+  lock.unlock();
+  callback(*this);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroup::Work::then(
+    std::function<void(Work&)> fn) {
+  auto next = std::make_shared<ChainedWork>();
+  addCallback([next, fn](Work& work) {
+    std::exception_ptr eptr;
+    try {
+      fn(work);
+    } catch (...) {
+      eptr = std::current_exception();
+    }
+    next->complete(eptr);
+  });
+  return next;
+}
+
+void ProcessGroup::Work::runCallbacks() {
+  std::vector<std::function<void(Work&)>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks.swap(callbacks_);
+  }
+  for (auto& callback : callbacks) {
+    callback(*this);
+  }
+}
+
 void ProcessGroup::Work::finish(std::exception_ptr exception) {
   std::unique_lock<std::mutex> lock(mutex_);
   completed_ = true;
   exception_ = exception;
   lock.unlock();
   cv_.notify_all();
+  runCallbacks();
 }
 
 ProcessGroup::ProcessGroup(int rank, int size) : rank_(rank), size_(size) {}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -80,13 +81,37 @@ class ProcessGroup {
     //
     virtual void wait();
 
+    // Registers a callback that runs exactly once when this work
+    // completes. If the work has already completed, the callback runs
+    // immediately on the calling thread; otherwise it runs on the thread
+    // that completes the work (a Gloo worker or MPI helper thread), so it
+    // must be brief and must not block. The callback receives this Work
+    // and can inspect isSuccess()/exception(); it is invoked on failure
+    // as well as success.
+    //
+    // Backends whose completion is not observed by any thread may not
+    // support callbacks; WorkNCCL (stream-ordered completion) throws.
+    virtual void addCallback(std::function<void(Work&)> callback);
+
+    // Chains dependent work: returns a Work that completes once `fn` has
+    // run on this work's completion thread. An exception thrown by `fn`
+    // completes the returned work with that exception. This work's own
+    // failure does not short-circuit the chain: `fn` still runs and can
+    // inspect the failed work.
+    std::shared_ptr<Work> then(std::function<void(Work&)> fn);
+
    protected:
     void finish(std::exception_ptr exception = nullptr);
 
+    // Runs and clears the pending callbacks; must be called without
+    // holding mutex_, after completed_ has been set.
+    void runCallbacks();
+
     mutable std::mutex mutex_;
     std::condition_variable cv_;
     bool completed_ = false;
     std::exception_ptr exception_;
+    std::vector<std::function<void(Work&)>> callbacks_;
   };
 
   explicit ProcessGroup(int rank, int size);
@@ -145,8 +170,10 @@ class ProcessGroup {
       const BarrierOptions& opts = BarrierOptions()) = 0;
 
  protected:
-  const int rank_;
-  const int size_;
+  // Not const: elastic process groups rewrite them when the membership
+  // changes. See Note [Elastic process groups] in ProcessGroupNCCL.cpp.
+  int rank_;
+  int size_;
 };
 
 } // namespace c10d
@@ -228,8 +228,11 @@ void ProcessGroupGloo::SendWork::wait() {
   }
 
   completed_ = true;
-  if (exception_) {
-    std::rethrow_exception(exception_);
+  auto exception = exception_;
+  lock.unlock();
+  runCallbacks();
+  if (exception) {
+    std::rethrow_exception(exception);
   }
 }
 
@@ -252,8 +255,11 @@ void ProcessGroupGloo::RecvWork::wait() {
   }
 
   completed_ = true;
-  if (exception_) {
-    std::rethrow_exception(exception_);
+  auto exception = exception_;
+  lock.unlock();
+  runCallbacks();
+  if (exception) {
+    std::rethrow_exception(exception);
   }
 }
 
@@ -608,6 +614,109 @@ class AsyncAllreduceCUDAWork : public AsyncAllreduceWork {
 
 #endif
 
+// Note [Sparse allreduce]
+// Gloo does not have a native sparse collective, so sparse gradients are
+// reduced by exchanging their COO representation. First the per-rank nnz
+// counts are exchanged with a small allgather so every process can size
+// its receive buffers. Then the indices and values are exchanged with two
+// more allgathers, padded to the maximum nnz because gloo requires
+// equal-sized inputs. Finally every rank concatenates the contributions
+// and sums them locally through a single coalesce. Only ReduceOp::SUM is
+// supported: the zero padding entries are folded away by a sum, but would
+// corrupt the result of min/max/product.
+class AsyncSparseAllreduceWork : public ProcessGroupGloo::AsyncWork {
+ public:
+  AsyncSparseAllreduceWork(
+      const std::shared_ptr<gloo::Context>& context,
+      std::vector<at::Tensor>& inputs,
+      uint32_t tag)
+      : context(context), inputs(inputs), tag(tag) {}
+
+  std::shared_ptr<gloo::Context> context;
+  std::vector<at::Tensor> inputs;
+  const uint32_t tag;
+
+  at::Tensor allreduce(at::Tensor& input) {
+    const auto size = context->size;
+    const auto input_ = input.coalesce();
+    const auto sparseDim = input_.sparse_dim();
+    const int64_t nnz = input_._nnz();
+
+    // Exchange the number of non-zero elements of every process.
+    std::vector<int64_t> counts(size);
+    {
+      int64_t tmp = nnz;
+      gloo::AllgatherOptions opts(context);
+      opts.setTag(tag);
+      opts.setInput(&tmp, 1);
+      opts.setOutput(counts.data(), counts.size());
+      gloo::allgather(opts);
+    }
+    int64_t maxNnz = 0;
+    for (const auto count : counts) {
+      maxNnz = std::max(maxNnz, count);
+    }
+    if (maxNnz == 0) {
+      return input_;
+    }
+
+    // Exchange the indices of every process, padded to the maximum nnz.
+    auto indicesOutput =
+        at::empty({size, sparseDim, maxNnz}, input_._indices().options());
+    {
+      auto indicesInput =
+          at::zeros({sparseDim, maxNnz}, input_._indices().options());
+      if (nnz > 0) {
+        indicesInput.narrow(1, 0, nnz).copy_(input_._indices());
+      }
+      gloo::AllgatherOptions opts(context);
+      opts.setTag(tag);
+      setInput<int64_t>(opts, indicesInput);
+      setOutput<int64_t>(opts, indicesOutput);
+      gloo::allgather(opts);
+    }
+
+    // Exchange the values of every process, padded to the maximum nnz.
+    const auto& scalarType = input_.scalar_type();
+    auto valueShape = input_._values().sizes().vec();
+    valueShape[0] = maxNnz;
+    auto valuesInput = at::zeros(valueShape, input_._values().options());
+    if (nnz > 0) {
+      valuesInput.narrow(0, 0, nnz).copy_(input_._values());
+    }
+    valueShape.insert(valueShape.begin(), size);
+    auto valuesOutput = at::empty(valueShape, input_._values().options());
+    {
+      gloo::AllgatherOptions opts(context);
+      opts.setTag(tag);
+      GENERATE_ALL_TYPES(scalarType, setInput, opts, valuesInput);
+      GENERATE_ALL_TYPES(scalarType, setOutput, opts, valuesOutput);
+      gloo::allgather(opts);
+    }
+
+    // Sum the contributions of every process with a single coalesce
+    // over the concatenated (unpadded) indices and values.
+    std::vector<at::Tensor> indices;
+    std::vector<at::Tensor> values;
+    for (auto i = 0; i < size; i++) {
+      if (counts[i] == 0) {
+        continue;
+      }
+      indices.push_back(indicesOutput[i].narrow(1, 0, counts[i]));
+      values.push_back(valuesOutput[i].narrow(0, 0, counts[i]));
+    }
+    return at::sparse_coo_tensor(
+               at::cat(indices, 1), at::cat(values, 0), input.sizes())
+        .coalesce();
+  }
+
+  void run() override {
+    for (size_t i = 0; i < inputs.size(); i++) {
+      inputs[i].copy_(allreduce(inputs[i]));
+    }
+  }
+};
+
 } // namespace
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
@@ -618,9 +727,23 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
   };
 
   assertNonEmpty(invalidArgument, inputs);
-  assertDense(invalidArgument, inputs);
   assertTypeAndSizesMatch(invalidArgument, inputs);
 
+  const auto& layout = inputs[0].layout();
+  if (layout != at::kStrided && layout != at::kSparse) {
+    invalidArgument("unsupported layout");
+  }
+  for (size_t i = 1; i < inputs.size(); i++) {
+    if (inputs[i].layout() != layout) {
+      invalidArgument("tensors with mixed layouts are not supported");
+    }
+  }
+  if (layout == at::kSparse && opts.reduceOp != ReduceOp::SUM) {
+    invalidArgument(
+        "unsupported reduction operation "
+        "(allreduce of sparse tensors only works with ReduceOp.SUM)");
+  }
+
   const auto& device = inputs[0].device();
   switch (device.type()) {
     case at::kCPU:
@@ -632,13 +755,21 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
       invalidArgument("unsupported device type");
   }
 
-  std::shared_ptr<AsyncAllreduceWork> work;
+  std::shared_ptr<AsyncWork> work;
   auto& context = contexts_[0];
   if (device.type() == at::kCPU) {
-    work = std::make_shared<AsyncAllreduceWork>(
-        context, inputs, opts.reduceOp, nextTag());
+    if (layout == at::kSparse) {
+      work = std::make_shared<AsyncSparseAllreduceWork>(
+          context, inputs, nextTag());
+    } else {
+      work = std::make_shared<AsyncAllreduceWork>(
+          context, inputs, opts.reduceOp, nextTag());
+    }
 #ifdef USE_CUDA
   } else if (device.type() == at::kCUDA) {
+    if (layout == at::kSparse) {
+      invalidArgument("sparse allreduce is only supported on CPU tensors");
+    }
     work = std::make_shared<AsyncAllreduceCUDAWork>(
         context, inputs, opts.reduceOp, nextTag());
 #endif
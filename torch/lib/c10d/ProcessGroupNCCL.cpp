@@ -1,9 +1,15 @@
 #include <c10d/ProcessGroupNCCL.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
 #include <map>
+#include <sstream>
 #include <tuple>
 #include <unordered_set>
 
+#include <unistd.h>
+
 #include <THC/THC.h>
 
 #include <ATen/cuda/CUDAContext.h>
@@ -118,6 +124,15 @@ std::exception_ptr ProcessGroupNCCL::WorkNCCL::exception() const {
       "isCompleted() and wait() will either succeed or throw");
 }
 
+void ProcessGroupNCCL::WorkNCCL::addCallback(
+    std::function<void(Work&)> /* unused */) {
+  throw std::runtime_error(
+      "addCallback() is not supported by NCCL process "
+      "group's work; completion is ordered on the NCCL streams and no "
+      "thread observes it. Use wait() or synchronize() to sequence "
+      "dependent work on the current streams instead");
+}
+
 // Helper that checks if the NCCL kernels are completed on the GPUs
 bool ProcessGroupNCCL::WorkNCCL::finishedGPUExecution() {
   for (size_t i = 0; i < devices_.size(); ++i) {
@@ -176,13 +191,170 @@ ProcessGroupNCCL::ProcessGroupNCCL(
   processGroupID_ = std::to_string(processGroupCounterMap_[groupKey]);
   groupPgID_ = groupName_ + "_" + processGroupID_;
   pgUniqueNCCLIDCnt_[groupPgID_] = -1;
+  lock.unlock();
+
+  // See Note [NCCL watchdog].
+  const char* watchdogEnv = getenv("C10D_NCCL_WATCHDOG");
+  if (watchdogEnv != nullptr && strtoll(watchdogEnv, nullptr, 10) > 0) {
+    watchdogEnabled_ = true;
+    const char* timeoutEnv = getenv("C10D_NCCL_DESYNC_TIMEOUT");
+    const auto timeoutSeconds = timeoutEnv != nullptr
+        ? strtoll(timeoutEnv, nullptr, 10)
+        : 120;
+    if (timeoutSeconds > 0) {
+      desyncTimeout_ = std::chrono::seconds(timeoutSeconds);
+    }
+    watchdogThread_ = std::thread(&ProcessGroupNCCL::ncclWatchdog, this);
+  }
 }
 
 ProcessGroupNCCL::~ProcessGroupNCCL() {
+  if (watchdogEnabled_) {
+    {
+      std::lock_guard<std::mutex> lock(watchdogMutex_);
+      watchdogStop_ = true;
+    }
+    watchdogCV_.notify_all();
+    watchdogThread_.join();
+  }
   std::unique_lock<std::mutex> lock(pgTrackingLock_);
   pgUniqueNCCLIDCnt_.erase(groupPgID_);
 }
 
+// Note [NCCL watchdog]
+// ~~~~~~~~~~~~~~~~~~~~
+// With C10D_NCCL_WATCHDOG=1, every issued collective is registered on a
+// queue that a single background thread drains. The thread is cheap by
+// construction: collectives of a process group complete in stream order,
+// so it only ever queries the *oldest* outstanding work's events and, on
+// completion, drains every other finished item in the same sweep --
+// O(completed) event queries per wakeup regardless of how many thousand
+// collectives are in flight. Between sweeps it sleeps with exponential
+// backoff (1ms doubling to 256ms), resetting on progress, so an idle or
+// slowly-progressing queue costs a few wakeups per second rather than a
+// spinning core.
+//
+// The same thread doubles as the desync detector: when the oldest
+// collective has made no progress for C10D_NCCL_DESYNC_TIMEOUT seconds
+// (default 120; 0 disables), the rank publishes its last completed
+// sequence number through the Store and reads what its peers have
+// published, printing a report that names the stalled collective and the
+// lagging rank(s) instead of hanging silently. Ranks only publish when
+// they themselves suspect a desync, so the Store sees no traffic in
+// healthy runs.
+void ProcessGroupNCCL::enqueueWork(
+    const std::shared_ptr<WorkNCCL>& work,
+    const char* opType) {
+  if (!watchdogEnabled_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(watchdogMutex_);
+    outstanding_.push_back(OutstandingWork{work, ++seqIssued_, opType});
+  }
+  watchdogCV_.notify_one();
+}
+
+void ProcessGroupNCCL::ncclWatchdog() {
+  const std::chrono::milliseconds kBackoffMin(1);
+  const std::chrono::milliseconds kBackoffMax(256);
+  std::chrono::milliseconds backoff = kBackoffMin;
+  auto lastProgress = std::chrono::steady_clock::now();
+
+  while (true) {
+    std::shared_ptr<WorkNCCL> oldest;
+    uint64_t oldestSeq = 0;
+    const char* oldestOp = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(watchdogMutex_);
+      watchdogCV_.wait_for(lock, backoff, [&] {
+        return watchdogStop_ || !outstanding_.empty();
+      });
+      if (watchdogStop_) {
+        return;
+      }
+      if (outstanding_.empty()) {
+        lastProgress = std::chrono::steady_clock::now();
+        backoff = kBackoffMin;
+        desyncReported_ = false;
+        continue;
+      }
+      oldest = outstanding_.front().work;
+      oldestSeq = outstanding_.front().seq;
+      oldestOp = outstanding_.front().opType;
+    }
+
+    // Query events outside the lock; issuing threads must not block on a
+    // cudaEventQuery.
+    const bool done = oldest->finishedGPUExecution();
+
+    std::unique_lock<std::mutex> lock(watchdogMutex_);
+    if (done) {
+      // Batched drain: everything that finished since the last sweep goes
+      // in one pass.
+      while (!outstanding_.empty() &&
+             (outstanding_.front().seq == oldestSeq ||
+              outstanding_.front().work->finishedGPUExecution())) {
+        seqCompleted_ = outstanding_.front().seq;
+        outstanding_.pop_front();
+      }
+      lastProgress = std::chrono::steady_clock::now();
+      backoff = kBackoffMin;
+      desyncReported_ = false;
+    } else {
+      backoff = std::min(backoff * 2, kBackoffMax);
+      if (desyncTimeout_.count() > 0 && !desyncReported_ &&
+          std::chrono::steady_clock::now() - lastProgress >= desyncTimeout_) {
+        desyncReported_ = true;
+        lock.unlock();
+        reportDesync(oldestSeq, oldestOp);
+      }
+    }
+  }
+}
+
+void ProcessGroupNCCL::reportDesync(uint64_t stalledSeq, const char* opType) {
+  const std::string keyPrefix = groupPgID_ + "_desync_";
+  try {
+    const auto mine = std::to_string(seqCompleted_);
+    store_->set(
+        keyPrefix + std::to_string(rank_),
+        std::vector<uint8_t>(mine.begin(), mine.end()));
+
+    std::ostringstream report;
+    report << "[c10d] NCCL desync suspected in process group " << groupPgID_
+           << ": rank " << rank_ << " has been waiting on collective #"
+           << stalledSeq << " (" << opType << ") for over "
+           << desyncTimeout_.count() << "s. Last completed collective per "
+           << "rank:";
+    uint64_t minCompleted = seqCompleted_;
+    int laggingRank = rank_;
+    for (int r = 0; r < size_; ++r) {
+      const auto key = keyPrefix + std::to_string(r);
+      if (!store_->check({key})) {
+        // That rank has not (yet) suspected a desync; it may be the one
+        // that raced ahead, or it may simply not run a watchdog.
+        report << " rank " << r << ": no report;";
+        continue;
+      }
+      const auto value = store_->get(key);
+      const auto completed =
+          strtoull(std::string(value.begin(), value.end()).c_str(), nullptr, 10);
+      report << " rank " << r << ": #" << completed << ";";
+      if (completed < minCompleted) {
+        minCompleted = completed;
+        laggingRank = r;
+      }
+    }
+    report << " slowest reporting rank: " << laggingRank << " (collective #"
+           << minCompleted << ")";
+    std::cerr << report.str() << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "[c10d] NCCL desync suspected in process group " << groupPgID_
+              << " but the store exchange failed: " << e.what() << std::endl;
+  }
+}
+
 void ProcessGroupNCCL::broadcastUniqueNCCLID(ncclUniqueId* ncclID) {
   // Every time when we create a new unique NCCL ID, we need to use a new
   // global key to access/update the store.
@@ -194,8 +366,8 @@ void ProcessGroupNCCL::broadcastUniqueNCCLID(ncclUniqueId* ncclID) {
 
   lock.unlock();
 
-  std::string storeKey =
-      processGroupID_ + "_" + std::to_string(uniqueNCCLIDCnt);
+  std::string storeKey = processGroupID_ + generationPrefix_ + "_" +
+      std::to_string(uniqueNCCLIDCnt);
 
   // Rank 0 writes to the store as bcast
   if (rank_ == 0) {
@@ -274,6 +446,9 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
   // Move the NCCL resource to cache
   devNCCLCommMap_.emplace(devicesKey, std::move(ncclComms));
   ncclStreams_.emplace(devicesKey, std::move(streamVal));
+  // Remember the device set so rebuildCommunicators() can re-create this
+  // entry after a reconfigure(); see Note [Elastic process groups].
+  commDevices_[devicesKey] = devices;
 
   // Note: these events are created with the (default) cudaEventDisableTiming
   // flag This flag provides the best performance when used with
@@ -287,6 +462,240 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
   return devNCCLCommMap_[devicesKey];
 }
 
+std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLGroupComm(
+    const std::string& cacheKey,
+    const std::vector<at::Device>& devices,
+    const std::vector<int>& groupRanks,
+    const std::string& groupTag) {
+  if (devNCCLCommMap_.find(cacheKey) != devNCCLCommMap_.end()) {
+    return devNCCLCommMap_[cacheKey];
+  }
+
+  // Position of this process within the sub-group
+  int groupRank = -1;
+  for (size_t i = 0; i < groupRanks.size(); ++i) {
+    if (groupRanks[i] == rank_) {
+      groupRank = i;
+      break;
+    }
+  }
+  if (groupRank < 0) {
+    throw std::runtime_error(
+        "getNCCLGroupComm called on a rank outside of the group");
+  }
+
+  // Exchange the NCCL unique ID through the store. Only the members of this
+  // sub-group rendezvous on the key, so the first member generates the ID.
+  // The per-tag counter keeps a repeated creation (e.g. for a new device
+  // key) from reading a stale store entry.
+  const auto idCnt = ++hierIDCnt_[groupTag];
+  std::string storeKey = processGroupID_ + generationPrefix_ + "_" + groupTag +
+      "_" + std::to_string(idCnt);
+
+  ncclUniqueId ncclID;
+  if (groupRank == 0) {
+    C10D_NCCL_CHECK(ncclGetUniqueId(&ncclID));
+    auto ncclIDVal = std::vector<uint8_t>(
+        reinterpret_cast<uint8_t*>(&ncclID),
+        reinterpret_cast<uint8_t*>(&ncclID) + NCCL_UNIQUE_ID_BYTES);
+    store_->set(storeKey, ncclIDVal);
+  } else {
+    auto ncclIDVal = store_->get(storeKey);
+    if (ncclIDVal.size() != NCCL_UNIQUE_ID_BYTES) {
+      throw std::runtime_error(
+          "Unexpected NCCL unique ID length received "
+          "from the store");
+    }
+    memcpy(&ncclID, ncclIDVal.data(), NCCL_UNIQUE_ID_BYTES);
+  }
+
+  std::vector<std::shared_ptr<NCCLComm>> ncclComms;
+  ncclComms.resize(devices.size());
+
+  at::cuda::OptionalCUDAGuard gpuGuard;
+
+  C10D_NCCL_CHECK(ncclGroupStart());
+
+  for (size_t i = 0; i < devices.size(); ++i) {
+    int numRanks = groupRanks.size() * devices.size();
+    int rank = groupRank * devices.size() + i;
+
+    gpuGuard.set_index(devices[i].index());
+    ncclComms[i] = NCCLComm::create(numRanks, rank, ncclID);
+  }
+
+  C10D_NCCL_CHECK(ncclGroupEnd());
+
+  devNCCLCommMap_.emplace(cacheKey, std::move(ncclComms));
+  return devNCCLCommMap_[cacheKey];
+}
+
+void ProcessGroupNCCL::initHierarchy() {
+  hierarchyInitialized_ = true;
+
+  // See Note [Hierarchical allreduce]. The threshold environment variable
+  // doubles as the feature switch; when it is unset we skip the hostname
+  // exchange entirely.
+  const char* thresholdEnv = getenv("C10D_NCCL_HIERARCHICAL_ALLREDUCE_SIZE");
+  if (thresholdEnv == nullptr) {
+    return;
+  }
+  const auto threshold = strtoll(thresholdEnv, nullptr, 10);
+  if (threshold < 0) {
+    return;
+  }
+  hierarchicalThresholdBytes_ = threshold;
+
+  // Exchange hostnames so every rank can group the others by host.
+  char hostname[256];
+  if (gethostname(hostname, sizeof(hostname) - 1) != 0) {
+    return;
+  }
+  hostname[sizeof(hostname) - 1] = '\0';
+  const std::string hostKeyPrefix =
+      processGroupID_ + generationPrefix_ + "_hier_host_";
+  store_->set(
+      hostKeyPrefix + std::to_string(rank_),
+      std::vector<uint8_t>(hostname, hostname + strlen(hostname)));
+
+  // Batched fetch: one store round trip for all ranks' hostnames instead
+  // of one per rank.
+  std::vector<std::string> hostKeys(size_);
+  for (int r = 0; r < size_; ++r) {
+    hostKeys[r] = hostKeyPrefix + std::to_string(r);
+  }
+  const auto hostVals = store_->multiGet(hostKeys);
+  std::vector<std::string> hosts(size_);
+  for (int r = 0; r < size_; ++r) {
+    hosts[r] = std::string(hostVals[r].begin(), hostVals[r].end());
+  }
+
+  // Group ranks by host in rank order; derive this rank's host-local index
+  // and its cross-host peer group (the ranks sharing that local index).
+  std::map<std::string, int> hostCount;
+  std::vector<int> localIndex(size_);
+  for (int r = 0; r < size_; ++r) {
+    localIndex[r] = hostCount[hosts[r]]++;
+    if (hosts[r] == hosts[rank_]) {
+      localRanks_.push_back(r);
+    }
+  }
+  localSize_ = localRanks_.size();
+  localRank_ = localIndex[rank_];
+  numHosts_ = hostCount.size();
+  for (int r = 0; r < size_; ++r) {
+    if (localIndex[r] == localRank_) {
+      crossRanks_.push_back(r);
+    }
+  }
+
+  bool homogeneous = true;
+  for (const auto& it : hostCount) {
+    homogeneous = homogeneous && it.second == localSize_;
+  }
+  hierarchyAvailable_ = homogeneous && numHosts_ > 1 && localSize_ > 1 &&
+      static_cast<int>(crossRanks_.size()) == numHosts_;
+}
+
+// Note [Elastic process groups]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Losing one node used to mean tearing down the whole job: communicators
+// are keyed by (rank, size) and every collective assumes static
+// membership. reconfigure(newRank, newSize) instead shrinks (or regrows)
+// the group in place on the surviving ranks:
+//  - cached communicators are aborted, not destroyed -- peers of the old
+//    incarnation may be dead, and an orderly ncclCommDestroy would block
+//    on them -- and dropped together with their streams and events;
+//  - the bootstrap key generation is advanced and folded into every
+//    store key used for unique-ID and topology exchange, so the new
+//    incarnation can never read a stale ID published before the failure
+//    (the store itself, typically living on a separate server process,
+//    survives and no re-rendezvous is needed);
+//  - rank_ and size_ are rewritten to the caller-provided dense mapping
+//    (remapRank computes it from the failed-rank list, identically on
+//    every survivor) and the cached host topology is invalidated.
+// Communicators are then rebuilt lazily by the next collective, exactly
+// like on first use; rebuildCommunicators() pays that cost eagerly for
+// every device set that was in use before the failure so the first
+// post-resume step runs at full speed. The store traffic that dominates
+// rebuild time at scale is batched through Store::multiGet (a single
+// round trip per worker on TCPStore; see MULTI_GET there).
+int ProcessGroupNCCL::remapRank(
+    int oldRank,
+    const std::vector<int>& failedRanks) {
+  int newRank = oldRank;
+  for (const auto failed : failedRanks) {
+    if (failed == oldRank) {
+      return -1;
+    }
+    if (failed < oldRank) {
+      --newRank;
+    }
+  }
+  return newRank;
+}
+
+void ProcessGroupNCCL::reconfigure(int newRank, int newSize) {
+  if (newSize <= 0 || newRank < 0 || newRank >= newSize) {
+    throw std::invalid_argument(
+        "ProcessGroupNCCL::reconfigure: invalid rank " +
+        std::to_string(newRank) + " for size " + std::to_string(newSize));
+  }
+  if (watchdogEnabled_) {
+    std::lock_guard<std::mutex> lock(watchdogMutex_);
+    if (!outstanding_.empty()) {
+      throw std::runtime_error(
+          "ProcessGroupNCCL::reconfigure called with collectives still "
+          "outstanding; wait for them (or synchronize the device) first");
+    }
+    desyncReported_ = false;
+  }
+
+  // Abort before dropping: see Note [Elastic process groups].
+  for (auto& entry : devNCCLCommMap_) {
+    for (auto& comm : entry.second) {
+      comm->abort();
+    }
+  }
+  devNCCLCommMap_.clear();
+  ncclStreams_.clear();
+  ncclEvents_.clear();
+
+  pendingRebuild_.clear();
+  for (auto& entry : commDevices_) {
+    pendingRebuild_.push_back(std::move(entry.second));
+  }
+  commDevices_.clear();
+
+  // The cached host topology is keyed by rank and size and is stale now.
+  hierarchyInitialized_ = false;
+  hierarchyAvailable_ = false;
+  localRank_ = -1;
+  localSize_ = 0;
+  numHosts_ = 0;
+  localRanks_.clear();
+  crossRanks_.clear();
+  hierIDCnt_.clear();
+
+  rank_ = newRank;
+  size_ = newSize;
+
+  // New incarnation, fresh bootstrap keys: the unique-ID counter starts
+  // over and every exchange key carries the generation.
+  ++commGeneration_;
+  generationPrefix_ = "_g" + std::to_string(commGeneration_);
+  std::lock_guard<std::mutex> lock(pgTrackingLock_);
+  pgUniqueNCCLIDCnt_[groupPgID_] = -1;
+}
+
+void ProcessGroupNCCL::rebuildCommunicators() {
+  std::vector<std::vector<at::Device>> pending;
+  pending.swap(pendingRebuild_);
+  for (const auto& devices : pending) {
+    getNCCLComm(getKeyFromDevices(devices), devices);
+  }
+}
+
 // Helper function that checks the input and output tensors for validity
 void ProcessGroupNCCL::tensorCheckHelper(
     const std::vector<at::Tensor>& input,
@@ -364,11 +773,147 @@ void ProcessGroupNCCL::tensorCheckHelper(
   }
 }
 
+// Note [Hierarchical allreduce]
+// On multi-host clusters with several GPUs per host, the intra-host links
+// (NVLink/PCIe) offer a large multiple of the network bandwidth, but a flat
+// ring allreduce is bottlenecked by its slowest link. For large messages we
+// can instead run the classic two-level scheme: reduce-scatter inside the
+// host, allreduce each chunk across hosts among the ranks that share a
+// host-local index, then allgather inside the host. Only 1/localSize of the
+// message per rank crosses the network.
+//
+// The path is taken when C10D_NCCL_HIERARCHICAL_ALLREDUCE_SIZE is set (its
+// value is the minimum message size in bytes and must agree on all ranks),
+// the topology is homogeneous (every host contributes the same number of
+// ranks), and the collective uses a single GPU per rank. Everything else
+// falls back to the flat ncclAllReduce.
+std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduceHierarchical(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  auto devices = getDeviceList(tensors);
+  auto key = getKeyFromDevices(devices);
+  // The flat communicator entry owns the NCCL stream and event used for
+  // this device key; make sure it exists.
+  getNCCLComm(key, devices);
+  auto& localComms = getNCCLGroupComm(
+      "local/" + key,
+      devices,
+      localRanks_,
+      "hier_local_" + std::to_string(localRanks_[0]));
+  auto& crossComms = getNCCLGroupComm(
+      "cross/" + key,
+      devices,
+      crossRanks_,
+      "hier_cross_" + std::to_string(localRank_));
+
+  // First let NCCL streams wait for input tensors allocation streams
+  syncStreams(devices, ncclEvents_[key], ncclStreams_[key]);
+
+  // Work itself will create the CUDA events on all GPUs of tensors
+  auto work = std::make_shared<ProcessGroupNCCL::WorkNCCL>(devices);
+
+  at::cuda::OptionalCUDAGuard gpuGuard;
+  gpuGuard.set_index(devices[0].index());
+
+  auto& tensor = tensors[0];
+  at::cuda::CUDAStream& ncclStream = ncclStreams_[key][0];
+
+  const int64_t count = tensor.numel();
+  const int64_t chunkCount = (count + localSize_ - 1) / localSize_;
+  const int64_t paddedCount = chunkCount * localSize_;
+  const auto dataType = getNcclDataType(tensor.scalar_type());
+
+  c10::cuda::CUDACachingAllocator::recordStream(
+      tensor.storage().data(), ncclStream);
+
+  // Stage through a padded buffer when the message does not divide evenly
+  // across the host. The padding cannot contaminate real elements because
+  // every phase is elementwise.
+  //
+  // All allocations must happen before the free mutex is taken below: the
+  // allocator's OOM-retry path locks the same non-recursive mutex to free
+  // cached blocks, so an at::empty under the lock can self-deadlock.
+  at::Tensor flat = tensor;
+  at::Tensor chunk;
+  {
+    at::cuda::OptionalCUDAStreamGuard guard;
+    guard.reset_stream(ncclStream);
+    if (paddedCount != count) {
+      flat = at::empty({paddedCount}, tensor.options());
+      flat.narrow(0, 0, count)
+          .copy_(tensor.view({count}), /* non_blocking */ true);
+      flat.narrow(0, count, paddedCount - count).zero_();
+      c10::cuda::CUDACachingAllocator::recordStream(
+          flat.storage().data(), ncclStream);
+    }
+    chunk = at::empty({chunkCount}, tensor.options());
+    c10::cuda::CUDACachingAllocator::recordStream(
+        chunk.storage().data(), ncclStream);
+  }
+
+  std::unique_lock<std::mutex> cudaFreeMutexLock(
+      *(c10::cuda::CUDACachingAllocator::getFreeMutex()));
+
+  // Phase 1: reduce-scatter inside the host.
+  C10D_NCCL_CHECK(ncclReduceScatter(
+      flat.data_ptr(),
+      chunk.data_ptr(),
+      chunkCount,
+      dataType,
+      ncclOp[opts.reduceOp],
+      localComms[0]->getNcclComm(),
+      ncclStream.stream()));
+
+  // Phase 2: allreduce each chunk across hosts, between the ranks that
+  // share this host-local index.
+  C10D_NCCL_CHECK(ncclAllReduce(
+      chunk.data_ptr(),
+      chunk.data_ptr(),
+      chunkCount,
+      dataType,
+      ncclOp[opts.reduceOp],
+      crossComms[0]->getNcclComm(),
+      ncclStream.stream()));
+
+  // Phase 3: allgather the reduced chunks inside the host.
+  C10D_NCCL_CHECK(ncclAllGather(
+      chunk.data_ptr(),
+      flat.data_ptr(),
+      chunkCount,
+      dataType,
+      localComms[0]->getNcclComm(),
+      ncclStream.stream()));
+
+  cudaFreeMutexLock.unlock();
+
+  if (paddedCount != count) {
+    at::cuda::OptionalCUDAStreamGuard guard;
+    guard.reset_stream(ncclStream);
+    tensor.view({count}).copy_(
+        flat.narrow(0, 0, count), /* non_blocking */ true);
+  }
+
+  work->cudaEvents_[0].record(ncclStream);
+
+  enqueueWork(work, "allreduce_hierarchical");
+  return work;
+}
+
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
     std::vector<at::Tensor>& tensors,
     const AllreduceOptions& opts) {
   tensorCheckHelper(tensors, tensors);
 
+  // See Note [Hierarchical allreduce]
+  if (!hierarchyInitialized_) {
+    initHierarchy();
+  }
+  if (hierarchyAvailable_ && tensors.size() == 1 &&
+      static_cast<size_t>(tensors[0].numel() * tensors[0].element_size()) >=
+          hierarchicalThresholdBytes_) {
+    return allreduceHierarchical(tensors, opts);
+  }
+
   auto devices = getDeviceList(tensors);
   auto key = getKeyFromDevices(devices);
   auto& ncclComms = getNCCLComm(key, devices);
@@ -414,6 +959,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
     work->cudaEvents_[i].record(ncclStream);
   }
 
+  enqueueWork(work, "allreduce");
   return work;
 }
 
@@ -468,6 +1014,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::broadcast(
     work->cudaEvents_[i].record(ncclStream);
   }
 
+  enqueueWork(work, "broadcast");
   return work;
 }
 
@@ -524,6 +1071,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce(
     work->cudaEvents_[i].record(ncclStream);
   }
 
+  enqueueWork(work, "reduce");
   return work;
 }
 
@@ -612,6 +1160,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather(
     at::cuda::CUDAStream& ncclStream = ncclStreams_[key][i];
     work->cudaEvents_[i].record(ncclStream);
   }
+
+  enqueueWork(work, "allgather");
   return work;
 }
 
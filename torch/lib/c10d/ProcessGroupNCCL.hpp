@@ -1,6 +1,10 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 
 #include <c10d/NCCLUtils.hpp>
@@ -80,6 +84,11 @@ class ProcessGroupNCCL : public ProcessGroup {
     // Will always throw because it should not be called (isSuccess() -> true).
     std::exception_ptr exception() const override;
 
+    // Will always throw: NCCL completion is stream-ordered and no thread
+    // observes it, so there is nothing to invoke the callback from.
+    // Synchronize on the stream (via wait()/synchronize()) instead.
+    void addCallback(std::function<void(Work&)> callback) override;
+
     // Helper function that checks if the NCCL kernels have finished
     // execution on the GPUs
     bool finishedGPUExecution();
@@ -164,6 +173,26 @@ class ProcessGroupNCCL : public ProcessGroup {
   std::shared_ptr<ProcessGroup::Work> barrier(
       const BarrierOptions& opts = BarrierOptions()) override;
 
+  // Elastic support; see Note [Elastic process groups] in
+  // ProcessGroupNCCL.cpp.
+  //
+  // Computes the dense rank `oldRank` maps to after removing
+  // `failedRanks` from the group, or -1 if oldRank itself failed.
+  static int remapRank(int oldRank, const std::vector<int>& failedRanks);
+
+  // Shrinks (or regrows) this process group in place for a new
+  // (rank, size) after a membership change: aborts the cached
+  // communicators, advances the bootstrap key generation so the new
+  // incarnation cannot read stale unique IDs from the store, and resets
+  // cached topology. Must be called on every surviving rank, with no
+  // collective outstanding, before any further collective is issued.
+  void reconfigure(int newRank, int newSize);
+
+  // Eagerly re-creates communicators for every device set that was in
+  // use before the last reconfigure(), so the first post-resume
+  // collective does not pay communicator setup.
+  void rebuildCommunicators();
+
  protected:
   // Helper that broadcasts nccl unique ID to all ranks through the store
   void broadcastUniqueNCCLID(ncclUniqueId* ncclID);
@@ -180,6 +209,42 @@ class ProcessGroupNCCL : public ProcessGroup {
       const std::vector<at::Tensor>& output,
       int outputOverInput = 1);
 
+  // Discovers the host topology of the process group through the store.
+  // See Note [Hierarchical allreduce] in ProcessGroupNCCL.cpp.
+  void initHierarchy();
+
+  // Like getNCCLComm, but creates communicators spanning only groupRanks
+  // (a subset of the process group that includes this rank). groupTag must
+  // identify the subset consistently on all of its members.
+  std::vector<std::shared_ptr<NCCLComm>>& getNCCLGroupComm(
+      const std::string& cacheKey,
+      const std::vector<at::Device>& devices,
+      const std::vector<int>& groupRanks,
+      const std::string& groupTag);
+
+  // Two-level allreduce path; see Note [Hierarchical allreduce].
+  std::shared_ptr<ProcessGroup::Work> allreduceHierarchical(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts);
+
+  // A collective being tracked by the watchdog. See Note [NCCL watchdog]
+  // in ProcessGroupNCCL.cpp.
+  struct OutstandingWork {
+    std::shared_ptr<WorkNCCL> work;
+    uint64_t seq;
+    const char* opType;
+  };
+
+  // Registers a just-issued collective with the watchdog (no-op when the
+  // watchdog is disabled).
+  void enqueueWork(
+      const std::shared_ptr<WorkNCCL>& work,
+      const char* opType);
+
+  // Watchdog thread body and its desync report helper.
+  void ncclWatchdog();
+  void reportDesync(uint64_t stalledSeq, const char* opType);
+
   // Store that is used to exchange each Ranks's NCCL unique ID
   std::shared_ptr<Store> store_;
 
@@ -224,6 +289,44 @@ class ProcessGroupNCCL : public ProcessGroup {
   // Device Indexes used for all collectives in this group
   std::set<int> usedDeviceIdxs_;
 
+  // Host topology for hierarchical allreduce, filled in lazily by
+  // initHierarchy(). See Note [Hierarchical allreduce].
+  bool hierarchyInitialized_ = false;
+  bool hierarchyAvailable_ = false;
+  size_t hierarchicalThresholdBytes_ = 0;
+  int localRank_ = -1;
+  int localSize_ = 0;
+  int numHosts_ = 0;
+  std::vector<int> localRanks_;
+  std::vector<int> crossRanks_;
+
+  // Per-tag counter so repeated sub-communicator creations use fresh
+  // store keys when exchanging their NCCL unique IDs
+  std::unordered_map<std::string, ssize_t> hierIDCnt_;
+
+  // Elastic state; see Note [Elastic process groups]. The generation
+  // prefix is folded into every bootstrap store key ("" before the
+  // first reconfigure, so existing key layouts are unchanged);
+  // commDevices_ remembers the device set behind each communicator key
+  // so rebuildCommunicators() can re-create them, and pendingRebuild_
+  // holds the sets dropped by the last reconfigure().
+  int commGeneration_ = 0;
+  std::string generationPrefix_;
+  std::unordered_map<std::string, std::vector<at::Device>> commDevices_;
+  std::vector<std::vector<at::Device>> pendingRebuild_;
+
+  // Watchdog state; see Note [NCCL watchdog] in ProcessGroupNCCL.cpp.
+  bool watchdogEnabled_ = false;
+  std::chrono::seconds desyncTimeout_{0};
+  std::thread watchdogThread_;
+  std::mutex watchdogMutex_;
+  std::condition_variable watchdogCV_;
+  bool watchdogStop_ = false;
+  std::deque<OutstandingWork> outstanding_;
+  uint64_t seqIssued_ = 0;
+  uint64_t seqCompleted_ = 0;
+  bool desyncReported_ = false;
+
   // processGroupID tracking
   static std::mutex pgTrackingLock_;
 
@@ -0,0 +1,245 @@
+#include <c10d/RowShardedKV.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace c10d {
+
+namespace {
+
+void checkIndices(const at::Tensor& indices) {
+  if (indices.scalar_type() != at::kLong) {
+    throw std::invalid_argument("indices must be int64");
+  }
+  if (indices.is_cuda()) {
+    throw std::invalid_argument("indices must be CPU tensors");
+  }
+}
+
+} // namespace
+
+RowShardedKV::RowShardedKV(
+    std::shared_ptr<Store> store,
+    std::string prefix,
+    int rank,
+    int worldSize,
+    int64_t numRows,
+    int64_t rowNumel,
+    at::ScalarType dtype)
+    : store_(std::move(store)),
+      prefix_(std::move(prefix)),
+      rank_(rank),
+      worldSize_(worldSize),
+      numRows_(numRows),
+      rowNumel_(rowNumel),
+      rowBytes_(rowNumel * static_cast<int64_t>(at::elementSize(dtype))) {
+  if (worldSize_ <= 0 || rank_ < 0 || rank_ >= worldSize_) {
+    throw std::invalid_argument("invalid rank / world size");
+  }
+  if (numRows_ < 0 || rowNumel_ <= 0) {
+    throw std::invalid_argument("invalid table geometry");
+  }
+  const int64_t localRows = std::max<int64_t>(
+      0, (numRows_ - rank_ + worldSize_ - 1) / worldSize_);
+  localShard_ =
+      at::zeros({localRows, rowNumel_}, at::TensorOptions().dtype(dtype));
+  worker_ = std::thread([this] { workerLoop(); });
+}
+
+RowShardedKV::~RowShardedKV() {
+  flush();
+  {
+    std::lock_guard<std::mutex> guard(queueMutex_);
+    shutdown_ = true;
+  }
+  queueCv_.notify_all();
+  worker_.join();
+}
+
+std::string RowShardedKV::rowKey(int64_t row) const {
+  return prefix_ + "/" + std::to_string(row);
+}
+
+std::vector<uint8_t> RowShardedKV::rowBytes(const at::Tensor& row) const {
+  auto contig = row.contiguous();
+  std::vector<uint8_t> bytes(rowBytes_);
+  std::memcpy(bytes.data(), contig.data_ptr(), rowBytes_);
+  return bytes;
+}
+
+void RowShardedKV::enqueue(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> guard(queueMutex_);
+    queue_.push_back(std::move(task));
+  }
+  queueCv_.notify_one();
+}
+
+void RowShardedKV::workerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(queueMutex_);
+      queueCv_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return; // shutdown and drained
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task();
+  }
+}
+
+void RowShardedKV::publishLocalRows() {
+  auto shard = localShard_.contiguous();
+  for (int64_t local = 0; local < shard.size(0); local++) {
+    const int64_t row = rank_ + local * worldSize_;
+    store_->set(rowKey(row), rowBytes(shard[local]));
+  }
+}
+
+void RowShardedKV::enqueueFetchLocked(std::vector<int64_t> rows) {
+  if (rows.empty()) {
+    return;
+  }
+  for (const auto row : rows) {
+    inflight_.insert(row);
+  }
+  enqueue([this, rows] {
+    for (const auto row : rows) {
+      auto bytes = store_->get(rowKey(row));
+      if (static_cast<int64_t>(bytes.size()) != rowBytes_) {
+        throw std::runtime_error("row blob has unexpected size");
+      }
+      auto tensor = at::empty({rowNumel_}, localShard_.options());
+      std::memcpy(tensor.data_ptr(), bytes.data(), rowBytes_);
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        cache_.emplace(row, std::move(tensor));
+        inflight_.erase(row);
+      }
+      cv_.notify_all();
+    }
+  });
+}
+
+void RowShardedKV::prefetch(const at::Tensor& indices) {
+  checkIndices(indices);
+  auto contig = indices.contiguous();
+  const int64_t* idx = contig.data<int64_t>();
+  std::vector<int64_t> wanted;
+  std::unordered_set<int64_t> seen;
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (int64_t i = 0; i < contig.numel(); i++) {
+    const int64_t row = idx[i];
+    if (ownerOfRow(row) == rank_ || cache_.count(row) ||
+        inflight_.count(row) || !seen.insert(row).second) {
+      continue;
+    }
+    wanted.push_back(row);
+  }
+  enqueueFetchLocked(std::move(wanted));
+}
+
+at::Tensor RowShardedKV::gather(const at::Tensor& indices) {
+  checkIndices(indices);
+  auto contig = indices.contiguous();
+  const int64_t* idx = contig.data<int64_t>();
+  const int64_t n = contig.numel();
+  auto result = at::empty({n, rowNumel_}, localShard_.options());
+  auto* out = static_cast<uint8_t*>(result.data_ptr());
+  auto shard = localShard_.contiguous();
+  const auto* shardData = static_cast<const uint8_t*>(shard.data_ptr());
+
+  // Request whatever no prefetch covered, then satisfy local rows while
+  // the worker fetches.
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::vector<int64_t> missing;
+    for (int64_t i = 0; i < n; i++) {
+      const int64_t row = idx[i];
+      if (ownerOfRow(row) != rank_ && !cache_.count(row) &&
+          !inflight_.count(row) &&
+          std::find(missing.begin(), missing.end(), row) == missing.end()) {
+        missing.push_back(row);
+      }
+    }
+    enqueueFetchLocked(std::move(missing));
+  }
+
+  std::vector<int64_t> remote;
+  for (int64_t i = 0; i < n; i++) {
+    const int64_t row = idx[i];
+    if (ownerOfRow(row) == rank_) {
+      const int64_t local = row / worldSize_;
+      std::memcpy(
+          out + i * rowBytes_, shardData + local * rowBytes_, rowBytes_);
+    } else {
+      remote.push_back(i);
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (const auto i : remote) {
+    const int64_t row = idx[i];
+    cv_.wait(lock, [&] { return cache_.count(row) != 0; });
+    std::memcpy(
+        out + i * rowBytes_, cache_[row].data_ptr(), rowBytes_);
+  }
+  // Consume the entries this gather used; repeated rows above were
+  // served before anything was erased.
+  for (const auto i : remote) {
+    cache_.erase(idx[i]);
+  }
+  return result;
+}
+
+void RowShardedKV::update(const at::Tensor& indices, const at::Tensor& values) {
+  checkIndices(indices);
+  auto contig = indices.contiguous();
+  auto vals = values.contiguous();
+  if (vals.scalar_type() != localShard_.scalar_type() ||
+      vals.numel() != contig.numel() * rowNumel_) {
+    throw std::invalid_argument("values do not match indices and row size");
+  }
+  const int64_t* idx = contig.data<int64_t>();
+  const auto* data = static_cast<const uint8_t*>(vals.data_ptr());
+  auto shard = localShard_.contiguous();
+
+  for (int64_t i = 0; i < contig.numel(); i++) {
+    const int64_t row = idx[i];
+    if (ownerOfRow(row) == rank_) {
+      std::memcpy(
+          static_cast<uint8_t*>(shard.data_ptr()) +
+              (row / worldSize_) * rowBytes_,
+          data + i * rowBytes_,
+          rowBytes_);
+    }
+    std::vector<uint8_t> bytes(
+        data + i * rowBytes_, data + (i + 1) * rowBytes_);
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      cache_.erase(row); // don't serve a stale prefetch
+      pendingWrites_++;
+    }
+    const auto key = rowKey(row);
+    enqueue([this, key, bytes] {
+      store_->set(key, bytes);
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        pendingWrites_--;
+      }
+      cv_.notify_all();
+    });
+  }
+}
+
+void RowShardedKV::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return pendingWrites_ == 0; });
+}
+
+} // namespace c10d
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+
+#include <ATen/ATen.h>
+
+#include <c10d/Store.hpp>
+
+namespace c10d {
+
+// A tensor-native distributed key-value layer for row-sharded parameter
+// tables (embedding tables) that exceed single-node memory.
+//
+// Rows are assigned round-robin to ranks (owner = row % worldSize); each
+// rank holds its owned rows in one dense local shard tensor, which the
+// optimizer can update in place. All cross-rank traffic goes through the
+// c10d Store as per-row binary blobs, so any Store backend works and no
+// server loop has to be written: the Store is the always-available home
+// location of every row, and the local shard is the owner's fast path.
+//
+// Every Store operation runs on a single background worker thread, which
+// keeps the (not necessarily thread-safe) Store single-threaded and makes
+// get/set asynchronous with respect to the caller: prefetch() enqueues
+// fetches of remote rows and returns immediately, update() enqueues
+// publishes, and gather() consumes prefetched rows, fetching only the
+// ones no prefetch covered. The intended training loop pipelines
+//
+//   kv.prefetch(next_batch_indices);            // remote rows in flight
+//   auto weights = kv.gather(batch_indices);    // local copy + waits
+//   auto out = at::embedding_bag(weights, ...); // overlap with prefetch
+//
+// so remote rows for the next step stream in during local compute.
+//
+// Row blobs use native byte order and the table's dtype; like the rest of
+// c10d, all participants are assumed to run the same build. Consistency
+// is last-writer-wins per row: the usual sharded-optimizer arrangement,
+// where only a row's owner writes it, makes updates race-free.
+//
+// Methods may be called from one caller thread at a time; the worker
+// thread is internal.
+class RowShardedKV {
+ public:
+  RowShardedKV(
+      std::shared_ptr<Store> store,
+      std::string prefix,
+      int rank,
+      int worldSize,
+      int64_t numRows,
+      int64_t rowNumel,
+      at::ScalarType dtype = at::kFloat);
+
+  // Waits for pending publishes, then stops the worker.
+  ~RowShardedKV();
+
+  RowShardedKV(const RowShardedKV&) = delete;
+  RowShardedKV& operator=(const RowShardedKV&) = delete;
+
+  int ownerOfRow(int64_t row) const {
+    return static_cast<int>(row % worldSize_);
+  }
+
+  int64_t numLocalRows() const {
+    return localShard_.size(0);
+  }
+
+  // The dense [numLocalRows, rowNumel] tensor holding this rank's rows;
+  // row r of the table lives at local index r / worldSize. Updates made
+  // directly to the shard are only visible to other ranks after
+  // publishLocalRows() (or update()) republishes them.
+  at::Tensor& localShard() {
+    return localShard_;
+  }
+
+  // Publishes every owned row to the Store. Must run on all ranks after
+  // the shards are initialized and before any rank gathers; blocks until
+  // this rank's rows are published.
+  void publishLocalRows();
+
+  // Starts fetching the remote rows of `indices` (int64, any shape) in
+  // the background. Rows already cached, in flight, or owned locally are
+  // skipped. Returns immediately.
+  void prefetch(const at::Tensor& indices);
+
+  // Returns a [indices.numel(), rowNumel] tensor of the requested rows.
+  // Owned rows are copied from the local shard; remote rows come from the
+  // prefetch cache, with any misses fetched now. Consumes the cache
+  // entries it uses.
+  at::Tensor gather(const at::Tensor& indices);
+
+  // Writes rows ([indices.numel(), rowNumel] values): owned rows update
+  // the local shard, and every row is republished to the Store in the
+  // background. Call flush() before reading the rows on another rank.
+  void update(const at::Tensor& indices, const at::Tensor& values);
+
+  // Blocks until all enqueued publishes have reached the Store.
+  void flush();
+
+ private:
+  std::string rowKey(int64_t row) const;
+  std::vector<uint8_t> rowBytes(const at::Tensor& row) const;
+  void enqueue(std::function<void()> task);
+  void workerLoop();
+  // Enqueues a fetch of `rows` (deduplicated remote rows not yet cached
+  // or in flight). Caller must hold state mutex.
+  void enqueueFetchLocked(std::vector<int64_t> rows);
+
+  std::shared_ptr<Store> store_;
+  const std::string prefix_;
+  const int rank_;
+  const int worldSize_;
+  const int64_t numRows_;
+  const int64_t rowNumel_;
+  const int64_t rowBytes_;
+  at::Tensor localShard_;
+
+  // Caller-facing state, guarded by mutex_.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::unordered_map<int64_t, at::Tensor> cache_;
+  std::unordered_set<int64_t> inflight_;
+  int64_t pendingWrites_ = 0;
+
+  // Worker queue.
+  std::mutex queueMutex_;
+  std::condition_variable queueCv_;
+  std::deque<std::function<void()>> queue_;
+  bool shutdown_ = false;
+  std::thread worker_;
+};
+
+} // namespace c10d
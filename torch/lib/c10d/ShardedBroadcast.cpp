@@ -0,0 +1,80 @@
+#include <c10d/ShardedBroadcast.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace c10d {
+
+std::vector<int> computeShardAssignment(
+    const std::vector<int64_t>& byteSizes,
+    int worldSize) {
+  if (worldSize <= 0) {
+    throw std::invalid_argument("worldSize must be positive");
+  }
+
+  // Visit entries largest-first so big parameters (embeddings) don't end
+  // up stacked on one rank, but keep the output indexed by entry.
+  std::vector<size_t> order(byteSizes.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return byteSizes[a] > byteSizes[b];
+  });
+
+  std::vector<int64_t> load(worldSize, 0);
+  std::vector<int> owners(byteSizes.size(), 0);
+  for (auto i : order) {
+    const int rank = static_cast<int>(std::distance(
+        load.begin(), std::min_element(load.begin(), load.end())));
+    owners[i] = rank;
+    load[rank] += byteSizes[i];
+  }
+  return owners;
+}
+
+void shardedBroadcast(
+    ProcessGroup& pg,
+    std::vector<at::Tensor>& tensors,
+    const std::vector<int>& owners) {
+  if (tensors.empty()) {
+    throw std::invalid_argument("argument is empty");
+  }
+  if (owners.size() != tensors.size()) {
+    throw std::invalid_argument(
+        "owners must have one entry per tensor");
+  }
+  for (auto owner : owners) {
+    if (owner < 0 || owner >= pg.getSize()) {
+      throw std::invalid_argument("owner rank out of range");
+    }
+  }
+
+  // Issue everything before waiting on anything: every collective has a
+  // different root, so the transfers share the fabric instead of
+  // serializing behind rank 0.
+  std::vector<std::shared_ptr<ProcessGroup::Work>> work;
+  work.reserve(tensors.size());
+  std::vector<std::vector<at::Tensor>> entries(tensors.size());
+  for (size_t i = 0; i < tensors.size(); i++) {
+    entries[i] = {tensors[i]};
+    BroadcastOptions opts;
+    opts.rootRank = owners[i];
+    opts.rootTensor = 0;
+    work.push_back(pg.broadcast(entries[i], opts));
+  }
+  for (auto& w : work) {
+    w->wait();
+  }
+}
+
+void shardedBroadcast(ProcessGroup& pg, std::vector<at::Tensor>& tensors) {
+  std::vector<int64_t> byteSizes;
+  byteSizes.reserve(tensors.size());
+  for (const auto& tensor : tensors) {
+    byteSizes.push_back(tensor.numel() * tensor.element_size());
+  }
+  shardedBroadcast(
+      pg, tensors, computeShardAssignment(byteSizes, pg.getSize()));
+}
+
+} // namespace c10d
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ATen/ATen.h>
+
+#include <c10d/ProcessGroup.hpp>
+#include <c10d/Types.hpp>
+
+namespace c10d {
+
+// Sharded parameter initialization for large models.
+//
+// Instead of rank 0 loading the whole checkpoint and broadcasting it,
+// every rank loads only the parameters assigned to it and then acts as
+// the broadcast root for those tensors, with all transfers in flight at
+// once. Checkpoint read time and egress bandwidth are both divided by the
+// world size.
+//
+// The assignment is a pure function of the parameter byte sizes, so every
+// rank computes the same mapping without communication; use it to decide
+// which checkpoint records to read (container formats expose per-record
+// access, so a rank never touches the bytes of records it does not own).
+// Non-owner ranks only need correctly shaped destination tensors.
+
+// Deterministic size-balanced assignment: entries are distributed
+// largest-first onto the currently lightest rank. Ties break toward the
+// lower rank, so the result is identical on every rank.
+std::vector<int> computeShardAssignment(
+    const std::vector<int64_t>& byteSizes,
+    int worldSize);
+
+// Broadcasts every tensor from its assigned owner rank. All broadcasts
+// are issued before any is waited on, so transfers from different roots
+// overlap. Every rank must pass identically ordered tensors and the same
+// assignment.
+void shardedBroadcast(
+    ProcessGroup& pg,
+    std::vector<at::Tensor>& tensors,
+    const std::vector<int>& owners);
+
+// Convenience overload deriving the assignment from the tensor sizes.
+void shardedBroadcast(ProcessGroup& pg, std::vector<at::Tensor>& tensors);
+
+} // namespace c10d
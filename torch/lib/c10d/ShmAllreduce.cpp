@@ -0,0 +1,283 @@
+#include <c10d/ShmAllreduce.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace c10d {
+
+namespace {
+
+constexpr size_t kCacheLine = 64;
+
+size_t roundUp(size_t value, size_t multiple) {
+  return ((value + multiple - 1) / multiple) * multiple;
+}
+
+// Lives at the front of the segment. A single sense-reversing barrier is
+// enough: every phase of allreduce() is separated by one.
+struct SegmentHeader {
+  std::atomic<uint32_t> barrierCount;
+  std::atomic<uint32_t> barrierGeneration;
+};
+
+[[noreturn]] void throwErrno(const std::string& what) {
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Sums the [begin, end) elements of every other slot into slot 0. The
+// chunks assigned to local ranks are disjoint, so slot 0 needs no
+// synchronization beyond the surrounding barriers. The plain loop
+// auto-vectorizes; the adds are bound by memory anyway.
+template <typename T>
+void reduceChunkInto(
+    char* const* slots,
+    size_t numSlots,
+    size_t begin,
+    size_t end) {
+  T* acc = reinterpret_cast<T*>(slots[0]);
+  for (size_t s = 1; s < numSlots; s++) {
+    const T* src = reinterpret_cast<const T*>(slots[s]);
+    for (size_t i = begin; i < end; i++) {
+      acc[i] += src[i];
+    }
+  }
+}
+
+void checkShmInputs(
+    const std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts,
+    size_t maxBytes) {
+  if (tensors.empty()) {
+    throw std::invalid_argument("argument is empty");
+  }
+  if (opts.reduceOp != ReduceOp::SUM) {
+    throw std::invalid_argument(
+        "shared-memory allreduce only supports ReduceOp::SUM");
+  }
+  size_t totalBytes = 0;
+  const auto scalarType = tensors[0].scalar_type();
+  for (const auto& tensor : tensors) {
+    if (tensor.is_sparse() || tensor.device().type() != at::kCPU ||
+        !tensor.is_contiguous()) {
+      throw std::invalid_argument(
+          "shared-memory allreduce expects dense contiguous CPU tensors");
+    }
+    if (tensor.scalar_type() != scalarType ||
+        (scalarType != at::kFloat && scalarType != at::kDouble)) {
+      throw std::invalid_argument(
+          "shared-memory allreduce expects float or double tensors of a "
+          "single dtype");
+    }
+    totalBytes += tensor.numel() * tensor.element_size();
+  }
+  if (totalBytes > maxBytes) {
+    throw std::invalid_argument(
+        "shared-memory allreduce input exceeds the context's maxBytes");
+  }
+}
+
+} // namespace
+
+ShmAllreduceContext::ShmAllreduceContext(
+    ProcessGroup& pg,
+    const std::string& name,
+    size_t maxBytes,
+    ProcessGroup* crossHostGroup)
+    : pg_(pg),
+      crossHostGroup_(crossHostGroup),
+      maxBytes_(roundUp(std::max<size_t>(maxBytes, 1), kCacheLine)),
+      slotBytes_(maxBytes_),
+      localRank_(0) {
+  const int worldSize = pg_.getSize();
+  const int rank = pg_.getRank();
+
+  // Exchange a hostname fingerprint to find co-located ranks.
+  char hostname[256];
+  if (gethostname(hostname, sizeof(hostname)) != 0) {
+    throwErrno("gethostname");
+  }
+  hostname[sizeof(hostname) - 1] = '\0';
+  const int64_t hostId = static_cast<int64_t>(
+      std::hash<std::string>()(std::string(hostname)));
+
+  auto options = at::device(at::kCPU).dtype(at::kLong);
+  std::vector<at::Tensor> input = {at::empty({1}, options)};
+  input[0].data<int64_t>()[0] = hostId;
+  std::vector<std::vector<at::Tensor>> output(1);
+  for (int r = 0; r < worldSize; r++) {
+    output[0].push_back(at::empty({1}, options));
+  }
+  pg_.allgather(output, input)->wait();
+
+  for (int r = 0; r < worldSize; r++) {
+    if (output[0][r].data<int64_t>()[0] == hostId) {
+      if (r == rank) {
+        localRank_ = localRanks_.size();
+      }
+      localRanks_.push_back(r);
+    }
+  }
+
+  const bool isLeader = localRank_ == 0;
+  if (!singleHost() && isLeader && crossHostGroup_ == nullptr) {
+    throw std::invalid_argument(
+        "multi-host shared-memory allreduce requires the per-host leaders "
+        "to pass a process group containing exactly the leaders");
+  }
+
+  // One segment per host, named after the leader's global rank so
+  // concurrent jobs with different contexts do not collide as long as
+  // `name` differs.
+  segmentName_ = "/" + name + "_" + std::to_string(localRanks_[0]);
+  segmentBytes_ =
+      roundUp(sizeof(SegmentHeader), kCacheLine) +
+      localRanks_.size() * slotBytes_;
+
+  if (isLeader) {
+    int fd = shm_open(segmentName_.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0) {
+      throwErrno("shm_open");
+    }
+    if (ftruncate(fd, segmentBytes_) != 0) {
+      close(fd);
+      throwErrno("ftruncate");
+    }
+    segment_ =
+        mmap(nullptr, segmentBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment_ == MAP_FAILED) {
+      throwErrno("mmap");
+    }
+    auto* header = new (segment_) SegmentHeader();
+    header->barrierCount.store(0);
+    header->barrierGeneration.store(0);
+  }
+
+  // The leader must have created and sized the segment before anyone else
+  // opens it.
+  pg_.barrier()->wait();
+
+  if (!isLeader) {
+    int fd = shm_open(segmentName_.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+      throwErrno("shm_open");
+    }
+    segment_ =
+        mmap(nullptr, segmentBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment_ == MAP_FAILED) {
+      throwErrno("mmap");
+    }
+  }
+}
+
+ShmAllreduceContext::~ShmAllreduceContext() {
+  if (segment_ != nullptr && segment_ != MAP_FAILED) {
+    munmap(segment_, segmentBytes_);
+  }
+  if (localRank_ == 0) {
+    shm_unlink(segmentName_.c_str());
+  }
+}
+
+char* ShmAllreduceContext::slotPtr(size_t localIndex) const {
+  return static_cast<char*>(segment_) +
+      roundUp(sizeof(SegmentHeader), kCacheLine) + localIndex * slotBytes_;
+}
+
+void ShmAllreduceContext::intraBarrier() {
+  auto* header = static_cast<SegmentHeader*>(segment_);
+  const uint32_t generation = header->barrierGeneration.load();
+  const uint32_t arrived = header->barrierCount.fetch_add(1) + 1;
+  if (arrived == localRanks_.size()) {
+    header->barrierCount.store(0);
+    header->barrierGeneration.fetch_add(1);
+  } else {
+    while (header->barrierGeneration.load() == generation) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void ShmAllreduceContext::allreduce(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  checkShmInputs(tensors, opts, maxBytes_);
+
+  const size_t numLocal = localRanks_.size();
+  if (numLocal == 1) {
+    // Nothing co-located; the segment would only add copies.
+    pg_.allreduce(tensors, opts)->wait();
+    return;
+  }
+
+  size_t totalElements = 0;
+  for (const auto& tensor : tensors) {
+    totalElements += tensor.numel();
+  }
+
+  // Phase 1: everyone publishes its contribution into its own slot.
+  char* mySlot = slotPtr(localRank_);
+  size_t offset = 0;
+  for (const auto& tensor : tensors) {
+    const size_t bytes = tensor.numel() * tensor.element_size();
+    std::memcpy(mySlot + offset, tensor.data_ptr(), bytes);
+    offset += bytes;
+  }
+  intraBarrier();
+
+  // Phase 2: chunked reduction. Each local rank owns a disjoint chunk of
+  // the flat payload and sums every slot into slot 0 over it, so the
+  // whole segment is reduced in parallel with no traffic between ranks
+  // beyond the cache coherence the reads cost anyway.
+  std::vector<char*> slots(numLocal);
+  for (size_t s = 0; s < numLocal; s++) {
+    slots[s] = slotPtr(s);
+  }
+  const size_t chunk = (totalElements + numLocal - 1) / numLocal;
+  const size_t begin = std::min(localRank_ * chunk, totalElements);
+  const size_t end = std::min(begin + chunk, totalElements);
+  if (tensors[0].scalar_type() == at::kFloat) {
+    reduceChunkInto<float>(slots.data(), numLocal, begin, end);
+  } else {
+    reduceChunkInto<double>(slots.data(), numLocal, begin, end);
+  }
+  intraBarrier();
+
+  // Phase 3: on a multi-host job, the leaders reduce the host partials
+  // across hosts; everyone else waits on the barrier.
+  if (!singleHost()) {
+    if (localRank_ == 0) {
+      auto blob = at::from_blob(
+          slots[0],
+          {static_cast<int64_t>(totalElements)},
+          at::device(at::kCPU).dtype(tensors[0].scalar_type()));
+      std::vector<at::Tensor> crossTensors = {blob};
+      crossHostGroup_->allreduce(crossTensors, opts)->wait();
+    }
+    intraBarrier();
+  }
+
+  // Phase 4: everyone copies the reduced payload back out.
+  offset = 0;
+  for (auto& tensor : tensors) {
+    const size_t bytes = tensor.numel() * tensor.element_size();
+    std::memcpy(tensor.data_ptr(), slots[0] + offset, bytes);
+    offset += bytes;
+  }
+  // Keep slot 0 intact until every rank has copied out; the next call
+  // starts overwriting it in its reduction phase.
+  intraBarrier();
+}
+
+} // namespace c10d
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ATen/ATen.h>
+
+#include <c10d/ProcessGroup.hpp>
+#include <c10d/Types.hpp>
+
+namespace c10d {
+
+// Shared-memory allreduce tier for co-located ranks.
+//
+// ProcessGroupGloo moves same-host traffic through TCP loopback, so an
+// 8-process-per-host CPU job pays the network stack for transfers that
+// could be plain memory. This context maps one POSIX shared-memory
+// segment per host, discovers which ranks are co-located (hostnames are
+// exchanged through the process group at construction), and serves
+// allreduce as: copy into the local slot, chunked in-segment reduction
+// (each local rank sums a disjoint chunk across all slots), then copy
+// out. On a multi-host job the per-host leaders (lowest global rank on
+// each host) additionally allreduce the host partials through
+// `crossHostGroup`, which must contain exactly the leaders; non-leader
+// ranks pass nullptr.
+//
+// The context is meant to be constructed once and reused every step:
+// construction performs the colocation exchange and maps a segment of
+// `maxBytes` payload capacity per rank. allreduce() itself is
+// synchronous and only supports ReduceOp::SUM over dense, contiguous
+// CPU float or double tensors whose total size fits in `maxBytes`.
+class ShmAllreduceContext {
+ public:
+  ShmAllreduceContext(
+      ProcessGroup& pg,
+      const std::string& name,
+      size_t maxBytes,
+      ProcessGroup* crossHostGroup = nullptr);
+  ~ShmAllreduceContext();
+
+  ShmAllreduceContext(const ShmAllreduceContext&) = delete;
+  ShmAllreduceContext& operator=(const ShmAllreduceContext&) = delete;
+
+  void allreduce(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts = AllreduceOptions());
+
+  // Global ranks on this host, ascending.
+  const std::vector<int>& localRanks() const {
+    return localRanks_;
+  }
+
+  bool singleHost() const {
+    return localRanks_.size() == static_cast<size_t>(pg_.getSize());
+  }
+
+ private:
+  void intraBarrier();
+  char* slotPtr(size_t localIndex) const;
+
+  ProcessGroup& pg_;
+  ProcessGroup* crossHostGroup_;
+  std::string segmentName_;
+  size_t maxBytes_;
+  size_t slotBytes_;
+  std::vector<int> localRanks_;
+  size_t localRank_; // index of this rank in localRanks_
+  void* segment_ = nullptr;
+  size_t segmentBytes_ = 0;
+};
+
+} // namespace c10d
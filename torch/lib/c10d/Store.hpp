@@ -25,6 +25,14 @@ class Store {
 
   virtual std::vector<uint8_t> get(const std::string& key) = 0;
 
+  // Blocking batched get: waits until every key is available and returns
+  // their values in order. The default implementation loops over get();
+  // stores with a wire protocol (see TCPStore) override it to fetch all
+  // keys in a single round trip, which is what keeps rendezvous-style
+  // all-to-all exchanges fast at scale.
+  virtual std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys);
+
   virtual int64_t add(const std::string& key, int64_t value) = 0;
 
   virtual bool check(const std::vector<std::string>& keys) = 0;
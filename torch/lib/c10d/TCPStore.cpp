@@ -2,6 +2,10 @@
 
 #include <poll.h>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 #include <unistd.h>
 #include <algorithm>
 #include <system_error>
@@ -10,7 +14,14 @@ namespace c10d {
 
 namespace {
 
-enum class QueryType : uint8_t { SET, GET, ADD, CHECK, WAIT };
+// WAIT_GET is a combined wait + get: the daemon replies with the value as
+// soon as the key is available, so a rendezvous-style "wait for the master
+// to publish, then fetch" costs one round trip per worker instead of two.
+// MULTI_GET generalizes it to a key batch: the daemon replies once, with
+// every value, as soon as the last key becomes available, so an
+// all-to-all bootstrap exchange costs one round trip per worker instead
+// of one per peer.
+enum class QueryType : uint8_t { SET, GET, ADD, CHECK, WAIT, WAIT_GET, MULTI_GET };
 
 enum class CheckResponseType : uint8_t { READY, NOT_READY };
 
@@ -54,6 +65,64 @@ void TCPStoreDaemon::join() {
   daemonThread_.join();
 }
 
+#ifdef __linux__
+
+// The daemon serves every worker from one thread, so the readiness
+// notification has to stay cheap as the job scales. poll(2) hands back the
+// whole fd array and costs a linear scan per wakeup, which at hundreds of
+// workers turns startup into an O(workers^2) affair; epoll reports only the
+// ready connections.
+void TCPStoreDaemon::run() {
+  int epollFd;
+  SYSCHECK_ERR_RETURN_NEG1(epollFd = ::epoll_create1(0));
+
+  auto watchFd = [epollFd](int fd) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    SYSCHECK_ERR_RETURN_NEG1(::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev));
+  };
+  watchFd(storeListenSocket_);
+  // The read end of the control pipe reports EPOLLHUP when the write end is
+  // closed in stop()
+  watchFd(controlPipeFd_[0]);
+
+  std::vector<struct epoll_event> events(64);
+  bool finished = false;
+  while (!finished) {
+    int numReady = ::epoll_wait(epollFd, events.data(), events.size(), -1);
+    if (numReady == -1 && errno == EINTR) {
+      continue;
+    }
+    SYSCHECK_ERR_RETURN_NEG1(numReady);
+
+    for (int i = 0; i < numReady && !finished; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == controlPipeFd_[0]) {
+        finished = true;
+      } else if (fd == storeListenSocket_) {
+        // The listening socket is level-triggered, so a backlog of
+        // connections keeps reporting until it is drained.
+        int sockFd = std::get<0>(tcputil::accept(storeListenSocket_));
+        sockets_.push_back(sockFd);
+        watchFd(sockFd);
+      } else {
+        try {
+          query(fd);
+        } catch (...) {
+          // See the catch block in the poll-based loop below for why a
+          // failed query only tears down its own connection.
+          ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+          removeClient(fd);
+        }
+      }
+    }
+  }
+  ::close(epollFd);
+}
+
+#else // __linux__
+
 void TCPStoreDaemon::run() {
   std::vector<struct pollfd> fds;
   fds.push_back({.fd = storeListenSocket_, .events = POLLIN});
@@ -122,32 +191,8 @@ void TCPStoreDaemon::run() {
         // exception, other connections will get an exception once they try to
         // use the store. We will go ahead and close this connection whenever
         // we hit an exception here.
-        ::close(fds[fdIdx].fd);
-
-        // Remove all the tracking state of the close FD
-        for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
-          for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
-            if (*vecIt == fds[fdIdx].fd) {
-              vecIt = it->second.erase(vecIt);
-            } else {
-              ++vecIt;
-            }
-          }
-          if (it->second.size() == 0) {
-            it = waitingSockets_.erase(it);
-          } else {
-            ++it;
-          }
-        }
-        for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
-          if (it->first == fds[fdIdx].fd) {
-            it = keysAwaited_.erase(it);
-          } else {
-            ++it;
-          }
-        }
+        removeClient(fds[fdIdx].fd);
         fds.erase(fds.begin() + fdIdx);
-        sockets_.erase(sockets_.begin() + fdIdx - 2);
         --fdIdx;
         continue;
       }
@@ -155,6 +200,33 @@ void TCPStoreDaemon::run() {
   }
 }
 
+#endif // __linux__
+
+void TCPStoreDaemon::removeClient(int socket) {
+  ::close(socket);
+
+  // Remove all the tracking state of the closed socket
+  for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
+    for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
+      if (*vecIt == socket) {
+        vecIt = it->second.erase(vecIt);
+      } else {
+        ++vecIt;
+      }
+    }
+    if (it->second.size() == 0) {
+      it = waitingSockets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  keysAwaited_.erase(socket);
+  awaitedGets_.erase(socket);
+  awaitedMultiGets_.erase(socket);
+  sockets_.erase(
+      std::remove(sockets_.begin(), sockets_.end(), socket), sockets_.end());
+}
+
 void TCPStoreDaemon::stop() {
   if (controlPipeFd_[1] != -1) {
     // close the write end of the pipe
@@ -187,6 +259,12 @@ void TCPStoreDaemon::query(int socket) {
   } else if (qt == QueryType::WAIT) {
     waitHandler(socket);
 
+  } else if (qt == QueryType::WAIT_GET) {
+    waitGetHandler(socket);
+
+  } else if (qt == QueryType::MULTI_GET) {
+    multiGetHandler(socket);
+
   } else {
     throw std::runtime_error("Unexpected query type");
   }
@@ -199,6 +277,23 @@ void TCPStoreDaemon::wakeupWaitingClients(const std::string& key) {
       if (--keysAwaited_[socket] == 0) {
         tcputil::sendValue<WaitResponseType>(
             socket, WaitResponseType::STOP_WAITING);
+        // WAIT_GET waiters get the value pushed with the notification, so
+        // one set() broadcasts to every waiter without the per-worker GET
+        // round trips coming back through the event loop.
+        auto awaitedGet = awaitedGets_.find(socket);
+        if (awaitedGet != awaitedGets_.end()) {
+          tcputil::sendVector<uint8_t>(socket, tcpStore_.at(awaitedGet->second));
+          awaitedGets_.erase(awaitedGet);
+        }
+        // MULTI_GET waiters get every value of their batch, in the order
+        // the keys were requested.
+        auto awaitedMultiGet = awaitedMultiGets_.find(socket);
+        if (awaitedMultiGet != awaitedMultiGets_.end()) {
+          for (const auto& awaitedKey : awaitedMultiGet->second) {
+            tcputil::sendVector<uint8_t>(socket, tcpStore_.at(awaitedKey));
+          }
+          awaitedMultiGets_.erase(awaitedMultiGet);
+        }
       }
     }
     waitingSockets_.erase(socketsToWait);
@@ -268,6 +363,49 @@ void TCPStoreDaemon::waitHandler(int socket) {
   }
 }
 
+void TCPStoreDaemon::multiGetHandler(int socket) {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  std::vector<std::string> keys(nargs);
+  for (size_t i = 0; i < nargs; i++) {
+    keys[i] = tcputil::recvString(socket);
+  }
+  if (checkKeys(keys)) {
+    tcputil::sendValue<WaitResponseType>(
+        socket, WaitResponseType::STOP_WAITING);
+    for (const auto& key : keys) {
+      tcputil::sendVector<uint8_t>(socket, tcpStore_.at(key));
+    }
+    return;
+  }
+  // Only the missing keys are awaited: present ones may never be set
+  // again, and the values of the whole batch are sent together once the
+  // last missing key arrives.
+  size_t numMissing = 0;
+  for (const auto& key : keys) {
+    if (tcpStore_.find(key) == tcpStore_.end()) {
+      waitingSockets_[key].push_back(socket);
+      ++numMissing;
+    }
+  }
+  keysAwaited_[socket] = numMissing;
+  awaitedMultiGets_[socket] = std::move(keys);
+}
+
+void TCPStoreDaemon::waitGetHandler(int socket) {
+  std::string key = tcputil::recvString(socket);
+  auto it = tcpStore_.find(key);
+  if (it != tcpStore_.end()) {
+    tcputil::sendValue<WaitResponseType>(
+        socket, WaitResponseType::STOP_WAITING);
+    tcputil::sendVector<uint8_t>(socket, it->second);
+  } else {
+    waitingSockets_[key].push_back(socket);
+    keysAwaited_[socket] = 1;
+    awaitedGets_[socket] = key;
+  }
+}
+
 bool TCPStoreDaemon::checkKeys(const std::vector<std::string>& keys) const {
   return std::all_of(keys.begin(), keys.end(), [this](const std::string& s) {
     return tcpStore_.count(s) > 0;
@@ -347,12 +485,60 @@ std::vector<uint8_t> TCPStore::get(const std::string& key) {
 }
 
 std::vector<uint8_t> TCPStore::getHelper_(const std::string& key) {
-  waitHelper_({key}, timeout_);
-  tcputil::sendValue<QueryType>(storeSocket_, QueryType::GET);
+  // Combined wait + get: the daemon replies with the value as soon as the
+  // key is available, saving a round trip per worker during rendezvous
+  if (timeout_ != kNoTimeout) {
+    struct timeval timeoutTV = {.tv_sec = timeout_.count() / 1000,
+                                .tv_usec = (timeout_.count() % 1000) * 1000};
+    SYSCHECK_ERR_RETURN_NEG1(::setsockopt(
+        storeSocket_,
+        SOL_SOCKET,
+        SO_RCVTIMEO,
+        reinterpret_cast<char*>(&timeoutTV),
+        sizeof(timeoutTV)));
+  }
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::WAIT_GET);
   tcputil::sendString(storeSocket_, key);
+  auto waitResponse = tcputil::recvValue<WaitResponseType>(storeSocket_);
+  if (waitResponse != WaitResponseType::STOP_WAITING) {
+    throw std::runtime_error("Stop_waiting response is expected");
+  }
   return tcputil::recvVector<uint8_t>(storeSocket_);
 }
 
+std::vector<std::vector<uint8_t>> TCPStore::multiGet(
+    const std::vector<std::string>& keys) {
+  // Single round trip for the whole batch; the daemon replies with every
+  // value once the last missing key has been published.
+  if (timeout_ != kNoTimeout) {
+    struct timeval timeoutTV = {.tv_sec = timeout_.count() / 1000,
+                                .tv_usec = (timeout_.count() % 1000) * 1000};
+    SYSCHECK_ERR_RETURN_NEG1(::setsockopt(
+        storeSocket_,
+        SOL_SOCKET,
+        SO_RCVTIMEO,
+        reinterpret_cast<char*>(&timeoutTV),
+        sizeof(timeoutTV)));
+  }
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::MULTI_GET);
+  SizeType nkeys = keys.size();
+  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    std::string regKey = regularPrefix_ + keys[i];
+    tcputil::sendString(storeSocket_, regKey, (i != (nkeys - 1)));
+  }
+  auto waitResponse = tcputil::recvValue<WaitResponseType>(storeSocket_);
+  if (waitResponse != WaitResponseType::STOP_WAITING) {
+    throw std::runtime_error("Stop_waiting response is expected");
+  }
+  std::vector<std::vector<uint8_t>> values;
+  values.reserve(keys.size());
+  for (size_t i = 0; i < nkeys; i++) {
+    values.push_back(tcputil::recvVector<uint8_t>(storeSocket_));
+  }
+  return values;
+}
+
 int64_t TCPStore::add(const std::string& key, int64_t value) {
   std::string regKey = regularPrefix_ + key;
   return addHelper_(regKey, value);
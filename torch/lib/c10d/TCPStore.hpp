@@ -27,9 +27,13 @@ class TCPStoreDaemon {
   void getHandler(int socket) const;
   void checkHandler(int socket) const;
   void waitHandler(int socket);
+  void waitGetHandler(int socket);
+  void multiGetHandler(int socket);
 
   bool checkKeys(const std::vector<std::string>& keys) const;
   void wakeupWaitingClients(const std::string& key);
+  // Closes `socket` and scrubs all the waiting state that refers to it.
+  void removeClient(int socket);
 
   std::thread daemonThread_;
   std::unordered_map<std::string, std::vector<uint8_t>> tcpStore_;
@@ -37,6 +41,12 @@ class TCPStoreDaemon {
   std::unordered_map<std::string, std::vector<int>> waitingSockets_;
   // From socket -> number of keys awaited
   std::unordered_map<int, size_t> keysAwaited_;
+  // Sockets blocked in a WAIT_GET and the key whose value they should be
+  // sent when it becomes available
+  std::unordered_map<int, std::string> awaitedGets_;
+  // Sockets blocked in a MULTI_GET and the full key batch whose values
+  // they should be sent once the last missing key becomes available
+  std::unordered_map<int, std::vector<std::string>> awaitedMultiGets_;
 
   std::vector<int> sockets_;
   int storeListenSocket_;
@@ -57,6 +67,11 @@ class TCPStore : public Store {
 
   std::vector<uint8_t> get(const std::string& key) override;
 
+  // Fetches the whole batch in one round trip; see MULTI_GET in
+  // TCPStore.cpp.
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys) override;
+
   int64_t add(const std::string& key, int64_t value) override;
 
   bool check(const std::vector<std::string>& keys) override;
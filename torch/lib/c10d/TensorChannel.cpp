@@ -0,0 +1,219 @@
+#include <c10d/TensorChannel.hpp>
+
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <c10d/Utils.hpp>
+
+namespace c10d {
+
+namespace {
+
+// A fixed pattern written raw by both sides of the handshake. Reading it
+// back reversed means the peer stores multi-byte values in the opposite
+// byte order.
+constexpr uint32_t kByteOrderMagic = 0x0a0b0c0d;
+
+// Reserved tag for the rendezvous messages sent through the process
+// group during construction.
+constexpr int kRendezvousTag = 0x7e;
+
+// Precedes every payload on the wire, in the sender's byte order.
+struct FrameHeader {
+  uint64_t payloadBytes;
+  uint64_t elementSize;
+};
+
+[[noreturn]] void throwErrno(const std::string& what) {
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void byteSwapValue(uint64_t& value) {
+  auto* bytes = reinterpret_cast<uint8_t*>(&value);
+  std::reverse(bytes, bytes + sizeof(value));
+}
+
+// Swaps every `elementSize`-byte element of the payload in place.
+void byteSwapPayload(void* data, size_t elementSize, size_t count) {
+  if (elementSize <= 1) {
+    return;
+  }
+  auto* bytes = static_cast<uint8_t*>(data);
+  for (size_t i = 0; i < count; i++) {
+    std::reverse(bytes, bytes + elementSize);
+    bytes += elementSize;
+  }
+}
+
+// writev with partial-write handling; mutates the iovec array.
+void sendScatterGather(int socket, struct iovec* iov, int iovcnt) {
+  while (iovcnt > 0) {
+    ssize_t sent;
+    SYSCHECK_ERR_RETURN_NEG1(sent = ::writev(socket, iov, iovcnt));
+    if (sent == 0) {
+      throw std::system_error(ECONNRESET, std::system_category());
+    }
+    size_t remaining = static_cast<size_t>(sent);
+    while (iovcnt > 0 && remaining >= iov->iov_len) {
+      remaining -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + remaining;
+      iov->iov_len -= remaining;
+    }
+  }
+}
+
+void checkChannelTensor(const at::Tensor& tensor, const char* what) {
+  if (tensor.is_sparse() || tensor.device().type() != at::kCPU ||
+      !tensor.is_contiguous()) {
+    throw std::invalid_argument(
+        std::string("TensorChannel ") + what +
+        " expects a dense contiguous CPU tensor");
+  }
+}
+
+} // namespace
+
+TensorChannel::TensorChannel(
+    ProcessGroup& pg,
+    int peerRank,
+    const at::Tensor& prototype,
+    TensorChannelOptions opts)
+    : peerRank_(peerRank) {
+  checkChannelTensor(prototype, "prototype");
+  if (peerRank < 0 || peerRank >= pg.getSize() || peerRank == pg.getRank()) {
+    throw std::invalid_argument("TensorChannel peer rank is out of range");
+  }
+  if (opts.ringSlots < 1) {
+    throw std::invalid_argument("TensorChannel needs at least one ring slot");
+  }
+  slotBytes_ = prototype.numel() * prototype.element_size();
+  elementSize_ = prototype.element_size();
+
+  // Rendezvous: the lower rank listens and ships {hostname, port} to the
+  // peer through the process group, the higher rank connects.
+  auto options = at::device(at::kCPU).dtype(at::kByte);
+  const int64_t kAddrBytes = 256 + sizeof(int64_t);
+  if (pg.getRank() < peerRank) {
+    int listenSocket;
+    PortType port;
+    std::tie(listenSocket, port) = tcputil::listen(0);
+
+    std::vector<at::Tensor> addr = {at::zeros({kAddrBytes}, options)};
+    auto* data = addr[0].data<uint8_t>();
+    if (gethostname(reinterpret_cast<char*>(data), 256) != 0) {
+      ::close(listenSocket);
+      throwErrno("gethostname");
+    }
+    data[255] = '\0';
+    const int64_t port64 = port;
+    std::memcpy(data + 256, &port64, sizeof(port64));
+    try {
+      pg.send(addr, peerRank, kRendezvousTag)->wait();
+      std::tie(socket_, std::ignore) = tcputil::accept(listenSocket);
+    } catch (...) {
+      ::close(listenSocket);
+      throw;
+    }
+    ::close(listenSocket);
+  } else {
+    std::vector<at::Tensor> addr = {at::zeros({kAddrBytes}, options)};
+    pg.recv(addr, peerRank, kRendezvousTag)->wait();
+    const auto* data = addr[0].data<uint8_t>();
+    std::string host(reinterpret_cast<const char*>(data));
+    int64_t port64;
+    std::memcpy(&port64, data + 256, sizeof(port64));
+    socket_ = tcputil::connect(host, static_cast<PortType>(port64));
+  }
+
+  int flag = 1;
+  setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+  // Byte-order handshake: both sides write the magic raw and inspect
+  // what arrives from the peer.
+  tcputil::sendValue<uint32_t>(socket_, kByteOrderMagic);
+  const auto peerMagic = tcputil::recvValue<uint32_t>(socket_);
+  if (peerMagic != kByteOrderMagic) {
+    uint32_t reversed = peerMagic;
+    auto* bytes = reinterpret_cast<uint8_t*>(&reversed);
+    std::reverse(bytes, bytes + sizeof(reversed));
+    if (reversed != kByteOrderMagic) {
+      ::close(socket_);
+      socket_ = -1;
+      throw std::runtime_error("TensorChannel handshake failed");
+    }
+    swap_ = true;
+  }
+
+  ring_.reserve(opts.ringSlots);
+  for (size_t i = 0; i < opts.ringSlots; i++) {
+    ring_.push_back(at::empty_like(prototype));
+  }
+}
+
+TensorChannel::~TensorChannel() {
+  if (socket_ != -1) {
+    ::close(socket_);
+  }
+}
+
+void TensorChannel::send(const at::Tensor& tensor) {
+  checkChannelTensor(tensor, "send");
+  const int64_t payloadBytes = tensor.numel() * tensor.element_size();
+  if (payloadBytes != slotBytes_ || tensor.element_size() != elementSize_) {
+    throw std::invalid_argument(
+        "TensorChannel send expects a tensor matching the prototype");
+  }
+  FrameHeader header;
+  header.payloadBytes = static_cast<uint64_t>(payloadBytes);
+  header.elementSize = static_cast<uint64_t>(elementSize_);
+
+  // One scatter-gather write: the header from the stack, the payload
+  // straight from the tensor's storage.
+  struct iovec iov[2];
+  iov[0].iov_base = &header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = tensor.data_ptr();
+  iov[1].iov_len = static_cast<size_t>(payloadBytes);
+  sendScatterGather(socket_, iov, 2);
+}
+
+at::Tensor TensorChannel::recv() {
+  FrameHeader header;
+  tcputil::recvBytes<FrameHeader>(socket_, &header, 1);
+  if (swap_) {
+    byteSwapValue(header.payloadBytes);
+    byteSwapValue(header.elementSize);
+  }
+  if (header.payloadBytes != static_cast<uint64_t>(slotBytes_) ||
+      header.elementSize != static_cast<uint64_t>(elementSize_)) {
+    throw std::runtime_error(
+        "TensorChannel received a frame that does not match the prototype");
+  }
+
+  at::Tensor& slot = ring_[ringIndex_];
+  ringIndex_ = (ringIndex_ + 1) % ring_.size();
+  tcputil::recvBytes<uint8_t>(
+      socket_,
+      static_cast<uint8_t*>(slot.data_ptr()),
+      static_cast<size_t>(slotBytes_));
+  if (swap_) {
+    byteSwapPayload(
+        slot.data_ptr(),
+        static_cast<size_t>(elementSize_),
+        static_cast<size_t>(slot.numel()));
+  }
+  return slot;
+}
+
+} // namespace c10d
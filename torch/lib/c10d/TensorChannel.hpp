@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <ATen/ATen.h>
+
+#include <c10d/ProcessGroup.hpp>
+
+namespace c10d {
+
+struct TensorChannelOptions {
+  // Number of preallocated receive tensors handed out round-robin. A
+  // tensor returned by recv() is overwritten again after `ringSlots - 1`
+  // further recv() calls, so size the ring to the longest chain of
+  // in-flight activations.
+  size_t ringSlots = 2;
+};
+
+// Persistent point-to-point tensor channel for pipeline parallelism.
+//
+// ProcessGroupGloo's send/recv already transmit from the tensor's own
+// storage, but every call sets up a fresh unbound buffer, the receiver
+// allocates a fresh tensor, and nothing checks byte order. A pipeline
+// stage exchanges same-shaped activations with the same peer every step,
+// so this channel does the setup once: construction opens a dedicated
+// TCP connection to the peer (the rendezvous runs over the process
+// group, so both ranks just construct the channel with each other's
+// rank), performs a byte-order handshake, and preallocates a ring of
+// receive tensors shaped like `prototype`.
+//
+// After that, send() writes the frame header and the tensor payload with
+// a single scatter-gather writev straight out of the tensor's storage --
+// no staging copy and one syscall per message -- and recv() lands the
+// payload directly into the next ring slot and returns it. When the
+// handshake detects that the peer stores multi-byte elements in the
+// opposite byte order, received payloads are swapped in place per
+// element, so mixed-endian stage hosts see correct values.
+//
+// send() accepts dense, contiguous CPU tensors whose byte size and
+// element size match the prototype; recv() throws if the incoming frame
+// disagrees. Both calls are synchronous, and a channel must only be used
+// from one thread at a time per direction.
+class TensorChannel {
+ public:
+  // Collective between this rank and `peerRank`: both sides must
+  // construct the channel, with matching `prototype` shape and dtype.
+  TensorChannel(
+      ProcessGroup& pg,
+      int peerRank,
+      const at::Tensor& prototype,
+      TensorChannelOptions opts = TensorChannelOptions());
+  ~TensorChannel();
+
+  TensorChannel(const TensorChannel&) = delete;
+  TensorChannel& operator=(const TensorChannel&) = delete;
+
+  void send(const at::Tensor& tensor);
+  at::Tensor recv();
+
+  // Whether received payloads are byte-swapped to match this host.
+  bool swapsByteOrder() const {
+    return swap_;
+  }
+
+ private:
+  int peerRank_;
+  int socket_ = -1;
+  bool swap_ = false;
+  int64_t slotBytes_;
+  int64_t elementSize_;
+  std::vector<at::Tensor> ring_;
+  size_t ringIndex_ = 0;
+};
+
+} // namespace c10d
@@ -235,6 +235,25 @@ class AllgatherNCCLTest : public NCCLTest {
   }
 };
 
+void testRemapRank() {
+  using ::c10d::ProcessGroupNCCL;
+  // No failures: identity mapping
+  if (ProcessGroupNCCL::remapRank(3, {}) != 3) {
+    throw std::runtime_error("BOOM!");
+  }
+  // A failed rank maps to -1
+  if (ProcessGroupNCCL::remapRank(2, {2}) != -1) {
+    throw std::runtime_error("BOOM!");
+  }
+  // Survivors shift down by the number of lower failed ranks
+  if (ProcessGroupNCCL::remapRank(0, {1, 3}) != 0 ||
+      ProcessGroupNCCL::remapRank(2, {1, 3}) != 1 ||
+      ProcessGroupNCCL::remapRank(4, {1, 3}) != 2) {
+    throw std::runtime_error("BOOM!");
+  }
+  std::cout << "remapRank test successful" << std::endl;
+}
+
 void testAllreduce(const std::string& path, int rank, int size) {
   auto test = AllreduceNCCLTest(path, size);
   test.initialize(rank, size);
@@ -363,6 +382,7 @@ int main(int argc, char** argv) {
   // TemporaryFile file;
   TemporaryFile file;
 
+  testRemapRank();
   testAllreduce(file.path, rank, size);
   testBroadcast(file.path, rank, size);
   testReduce(file.path, rank, size);
@@ -25,5 +25,25 @@ inline void check(
   }
 }
 
+inline void checkMulti(
+    Store& store,
+    const std::vector<std::string>& keys,
+    const std::vector<std::string>& expected) {
+  auto tmp = store.multiGet(keys);
+  if (tmp.size() != expected.size()) {
+    throw std::runtime_error(
+        "Expected " + std::to_string(expected.size()) + " values, got " +
+        std::to_string(tmp.size()));
+  }
+  for (size_t i = 0; i < expected.size(); i++) {
+    auto actual = std::string((const char*)tmp[i].data(), tmp[i].size());
+    if (actual != expected[i]) {
+      throw std::runtime_error(
+          "Expected " + expected[i] + " for key " + keys[i] + ", got " +
+          actual);
+    }
+  }
+}
+
 } // namespace test
 } // namespace c10d
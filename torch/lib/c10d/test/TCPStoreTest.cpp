@@ -1,5 +1,6 @@
 #include <c10d/test/StoreTestCommon.hpp>
 
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <thread>
@@ -22,6 +23,12 @@ void testHelper(const std::string& prefix = "") {
   c10d::test::check(serverStore, "key1", "value1");
   c10d::test::check(serverStore, "key2", "value2");
 
+  // Batched get: all present keys come back in one round trip, in
+  // request order
+  c10d::test::checkMulti(
+      serverStore, {"key0", "key1", "key2"}, {"value0", "value1", "value2"});
+  c10d::test::checkMulti(serverStore, {"key2"}, {"value2"});
+
   // Hammer on TCPStore
   std::vector<std::thread> threads;
   const auto numIterations = 1000;
@@ -37,6 +44,25 @@ void testHelper(const std::string& prefix = "") {
         new c10d::PrefixStore(prefix, *clientTCPStores[i])));
   }
 
+  // multiGet blocks until every requested key has been published: start a
+  // client fetching a key that does not exist yet, then set it
+  {
+    c10d::test::Semaphore started;
+    std::thread waiter([&started, &clientStores] {
+      started.post();
+      c10d::test::checkMulti(
+          *clientStores[0],
+          {"key0", "pendingKey"},
+          {"value0", "pendingValue"});
+    });
+    started.wait();
+    // Give the MULTI_GET a moment to reach the daemon and register for
+    // the missing key before publishing it
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    c10d::test::set(serverStore, "pendingKey", "pendingValue");
+    waiter.join();
+  }
+
   std::string expectedCounterRes = std::to_string(numThreads * numIterations);
 
   for (auto i = 0; i < numThreads; i++) {
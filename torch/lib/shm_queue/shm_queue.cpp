@@ -0,0 +1,232 @@
+#include <shm_queue/shm_queue.h>
+
+#include <libshm/libshm.h>
+
+#include <c10/util/Exception.h>
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace torch {
+
+namespace {
+
+// Slot payloads are cache-line aligned so producers on different cores
+// do not false-share, and so vectorized kernels can assume alignment.
+constexpr int64_t kShmQueueSlotAlign = 64;
+
+int64_t round_up(int64_t x, int64_t multiple) {
+  return ((x + multiple - 1) / multiple) * multiple;
+}
+
+int64_t header_bytes() {
+  return round_up(sizeof(detail::ShmQueueHeader), kShmQueueSlotAlign);
+}
+
+int64_t slot_header_bytes() {
+  return round_up(sizeof(detail::ShmQueueSlot), kShmQueueSlotAlign);
+}
+
+int64_t slot_stride(int64_t slot_size) {
+  return slot_header_bytes() + round_up(slot_size, kShmQueueSlotAlign);
+}
+
+// Slot lifecycle; transitions are lock-free CAS/store-release.
+constexpr int32_t kSlotFree = 0;       // claimable by a producer
+constexpr int32_t kSlotClaimed = 1;    // producer is writing the payload
+constexpr int32_t kSlotCommitted = 2;  // readable by the consumer
+constexpr int32_t kSlotReading = 3;    // aliased by a popped tensor
+
+} // namespace
+
+int64_t shm_queue_segment_size(int64_t capacity, int64_t slot_size) {
+  return header_bytes() + capacity * slot_stride(slot_size);
+}
+
+ShmTensorQueue::ShmTensorQueue(
+    std::string name,
+    at::DataPtr data,
+    int64_t mapped_size)
+    : name_(std::move(name)),
+      data_(std::move(data)),
+      mapped_size_(mapped_size) {}
+
+ShmTensorQueue ShmTensorQueue::create(
+    const std::string& name,
+    int64_t capacity,
+    int64_t slot_size) {
+  AT_CHECK(capacity > 0, "shm queue capacity must be positive, got ", capacity);
+  AT_CHECK(slot_size > 0, "shm queue slot size must be positive, got ", slot_size);
+  int64_t total = shm_queue_segment_size(capacity, slot_size);
+  int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE;
+  ShmTensorQueue queue(
+      name,
+      THManagedMapAllocator::makeDataPtr("", name.c_str(), flags, total),
+      total);
+
+  auto* header = new (queue.data_.get()) detail::ShmQueueHeader();
+  header->capacity = capacity;
+  header->slot_size = slot_size;
+  header->head.store(0, std::memory_order_relaxed);
+  header->tail.store(0, std::memory_order_relaxed);
+  for (int64_t i = 0; i < capacity; i++) {
+    auto* slot = new (reinterpret_cast<char*>(queue.data_.get()) +
+                      header_bytes() + i * slot_stride(slot_size))
+        detail::ShmQueueSlot();
+    slot->state.store(kSlotFree, std::memory_order_relaxed);
+  }
+  return queue;
+}
+
+ShmTensorQueue ShmTensorQueue::attach(
+    const std::string& manager_handle,
+    const std::string& name) {
+  int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE;
+  // Map the header first to learn the geometry, then remap at full size.
+  auto probe = THManagedMapAllocator::makeDataPtr(
+      manager_handle.c_str(), name.c_str(), flags, sizeof(detail::ShmQueueHeader));
+  auto* header = reinterpret_cast<detail::ShmQueueHeader*>(probe.get());
+  int64_t total = shm_queue_segment_size(header->capacity, header->slot_size);
+  probe.clear();
+  return ShmTensorQueue(
+      name,
+      THManagedMapAllocator::makeDataPtr(
+          manager_handle.c_str(), name.c_str(), flags, total),
+      total);
+}
+
+detail::ShmQueueHeader* ShmTensorQueue::header() const {
+  return reinterpret_cast<detail::ShmQueueHeader*>(data_.get());
+}
+
+detail::ShmQueueSlot* ShmTensorQueue::slot(int64_t index) const {
+  return reinterpret_cast<detail::ShmQueueSlot*>(
+      reinterpret_cast<char*>(data_.get()) + header_bytes() +
+      index * slot_stride(header()->slot_size));
+}
+
+char* ShmTensorQueue::slot_payload(detail::ShmQueueSlot* slot) const {
+  return reinterpret_cast<char*>(slot) + slot_header_bytes();
+}
+
+detail::ShmQueueSlot* ShmTensorQueue::slot_of_payload(void* payload) const {
+  return reinterpret_cast<detail::ShmQueueSlot*>(
+      reinterpret_cast<char*>(payload) - slot_header_bytes());
+}
+
+const char* ShmTensorQueue::manager_handle() const {
+  return THManagedMapAllocator::fromDataPtr(data_)->manager_handle();
+}
+
+int64_t ShmTensorQueue::capacity() const {
+  return header()->capacity;
+}
+
+int64_t ShmTensorQueue::slot_size() const {
+  return header()->slot_size;
+}
+
+at::Tensor ShmTensorQueue::reserve(
+    at::IntArrayRef sizes,
+    at::ScalarType dtype) {
+  auto* h = header();
+  if (sizes.size() > static_cast<size_t>(kShmQueueMaxDims)) {
+    return at::Tensor();
+  }
+  int64_t numel = 1;
+  for (auto s : sizes) {
+    numel *= s;
+  }
+  int64_t nbytes = numel * at::elementSize(dtype);
+  if (nbytes > h->slot_size) {
+    return at::Tensor();
+  }
+
+  // Claim a ticket. Multiple producers race on tail with CAS; the
+  // head/tail distance bounds the number of outstanding tickets by the
+  // ring capacity.
+  int64_t ticket;
+  for (;;) {
+    ticket = h->tail.load(std::memory_order_relaxed);
+    if (ticket - h->head.load(std::memory_order_acquire) >= h->capacity) {
+      return at::Tensor();  // full
+    }
+    if (h->tail.compare_exchange_weak(
+            ticket, ticket + 1, std::memory_order_acq_rel)) {
+      break;
+    }
+  }
+
+  auto* s = slot(ticket % h->capacity);
+  // The ticket guarantees we are the only producer for this slot, but a
+  // consumer-side tensor popped long ago may still alias it; wait for
+  // that tensor to be released. This only spins if the consumer holds
+  // popped tensors across more than `capacity` further pops.
+  int32_t expected = kSlotFree;
+  while (!s->state.compare_exchange_weak(
+      expected, kSlotClaimed, std::memory_order_acq_rel)) {
+    expected = kSlotFree;
+  }
+
+  s->scalar_type = static_cast<int32_t>(dtype);
+  s->ndim = sizes.size();
+  for (size_t d = 0; d < sizes.size(); d++) {
+    s->sizes[d] = sizes[d];
+  }
+  s->nbytes = nbytes;
+
+  // No deleter: the slot is released through commit()/the consumer, not
+  // through the tensor that writes it.
+  return at::from_blob(
+      slot_payload(s), sizes, at::device(at::kCPU).dtype(dtype));
+}
+
+void ShmTensorQueue::commit(const at::Tensor& slot_tensor) {
+  AT_CHECK(slot_tensor.defined(), "cannot commit an undefined tensor");
+  auto* s = slot_of_payload(slot_tensor.data_ptr());
+  AT_CHECK(
+      s->state.load(std::memory_order_relaxed) == kSlotClaimed,
+      "commit() called on a tensor that was not returned by reserve()");
+  s->state.store(kSlotCommitted, std::memory_order_release);
+}
+
+bool ShmTensorQueue::push(const at::Tensor& tensor) {
+  at::Tensor slot_tensor = reserve(tensor.sizes(), tensor.scalar_type());
+  if (!slot_tensor.defined()) {
+    return false;
+  }
+  slot_tensor.copy_(tensor);
+  commit(slot_tensor);
+  return true;
+}
+
+at::Tensor ShmTensorQueue::pop() {
+  auto* h = header();
+  int64_t head = h->head.load(std::memory_order_relaxed);
+  if (head == h->tail.load(std::memory_order_acquire)) {
+    return at::Tensor();  // empty
+  }
+  auto* s = slot(head % h->capacity);
+  // FIFO: if the oldest claimed slot is not committed yet, report empty
+  // rather than skipping ahead of its producer.
+  if (s->state.load(std::memory_order_acquire) != kSlotCommitted) {
+    return at::Tensor();
+  }
+  s->state.store(kSlotReading, std::memory_order_relaxed);
+  h->head.store(head + 1, std::memory_order_release);
+
+  auto dtype = static_cast<at::ScalarType>(s->scalar_type);
+  at::IntArrayRef sizes(s->sizes, s->ndim);
+  // The returned tensor aliases the slot; releasing it recycles the
+  // slot. The queue (and thus the mapping) must outlive popped tensors.
+  return at::from_blob(
+      slot_payload(s),
+      sizes,
+      [s](void* /* payload */) {
+        s->state.store(kSlotFree, std::memory_order_release);
+      },
+      at::device(at::kCPU).dtype(dtype));
+}
+
+} // namespace torch
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// A lock-free multi-producer single-consumer tensor queue in shared
+// memory, built on the libshm manager so the segment is reclaimed even if
+// a participant dies.
+//
+// The segment holds a fixed-size ring of fixed-size slots. Producers
+// claim a slot, write tensor data directly into it (either through
+// reserve()/commit(), which hands back a tensor aliasing the slot so the
+// producing op writes in place, or through push(), which does one copy),
+// and publish it with a release store. The consumer maps the same
+// segment and pop() returns a tensor aliasing the slot payload -- no
+// copy on the consumer side; the slot is recycled when that tensor is
+// released.
+//
+// Wire-up: the creating process constructs ShmTensorQueue::create(name,
+// capacity, slot_size) and sends (manager_handle(), name) to the other
+// participants over its own control channel; they attach with
+// ShmTensorQueue::attach().
+
+namespace torch {
+
+constexpr int64_t kShmQueueMaxDims = 16;
+
+namespace detail {
+
+struct ShmQueueSlot {
+  // 0 = free, 1 = claimed by a producer, 2 = committed (readable),
+  // 3 = owned by a consumer-side tensor.
+  std::atomic<int32_t> state;
+  int32_t scalar_type;
+  int64_t ndim;
+  int64_t sizes[kShmQueueMaxDims];
+  int64_t nbytes;
+  // Payload follows, aligned to kShmQueueSlotAlign.
+};
+
+struct ShmQueueHeader {
+  int64_t capacity;   // number of slots
+  int64_t slot_size;  // payload bytes per slot
+  std::atomic<int64_t> head;  // next slot the consumer will read
+  std::atomic<int64_t> tail;  // next slot a producer will claim
+  // Slots follow.
+};
+
+} // namespace detail
+
+class ShmTensorQueue {
+ public:
+  // Creates a new queue segment registered with the shared memory
+  // manager. `name` must be unique among live segments.
+  static ShmTensorQueue create(
+      const std::string& name,
+      int64_t capacity,
+      int64_t slot_size);
+
+  // Attaches to a queue created by another process.
+  static ShmTensorQueue attach(
+      const std::string& manager_handle,
+      const std::string& name);
+
+  ShmTensorQueue(ShmTensorQueue&&) = default;
+  ShmTensorQueue& operator=(ShmTensorQueue&&) = default;
+
+  // Producer side: claims a slot and returns a CPU tensor aliasing its
+  // payload, so the producing computation writes into shared memory
+  // directly. Returns an undefined tensor if the queue is full or the
+  // tensor does not fit in a slot. The claimed slot is not visible to
+  // the consumer until commit().
+  at::Tensor reserve(at::IntArrayRef sizes, at::ScalarType dtype);
+
+  // Publishes a slot previously returned by reserve().
+  void commit(const at::Tensor& slot_tensor);
+
+  // Convenience producer entry point: reserve + copy + commit. This is
+  // the one-copy path for tensors that already exist; returns false if
+  // the queue is full or the tensor does not fit.
+  bool push(const at::Tensor& tensor);
+
+  // Consumer side: returns a tensor aliasing the oldest committed slot,
+  // or an undefined tensor if the queue is empty. The slot is recycled
+  // when the returned tensor (and its views) are released, so a consumer
+  // that holds results indefinitely will eventually fill the ring.
+  at::Tensor pop();
+
+  // Handle to hand to attach() in other processes.
+  const char* manager_handle() const;
+  const std::string& name() const {
+    return name_;
+  }
+  int64_t capacity() const;
+  int64_t slot_size() const;
+
+ private:
+  ShmTensorQueue(std::string name, at::DataPtr data, int64_t mapped_size);
+
+  detail::ShmQueueHeader* header() const;
+  detail::ShmQueueSlot* slot(int64_t index) const;
+  char* slot_payload(detail::ShmQueueSlot* slot) const;
+  // Inverse of reserve(): recovers the slot a payload pointer lives in.
+  detail::ShmQueueSlot* slot_of_payload(void* payload) const;
+
+  std::string name_;
+  at::DataPtr data_;
+  int64_t mapped_size_;
+};
+
+// Total segment size for a given geometry; exposed for tests.
+int64_t shm_queue_segment_size(int64_t capacity, int64_t slot_size);
+
+} // namespace torch
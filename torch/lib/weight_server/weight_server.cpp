@@ -0,0 +1,167 @@
+#include <weight_server/weight_server.h>
+
+#include <libshm/libshm.h>
+
+#include <TH/THAllocator.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace torch {
+namespace {
+
+constexpr int64_t kArenaMagic = 0x57544152; // "WTAR"
+constexpr int64_t kArenaAlign = 64;
+
+struct ArenaEntry {
+  int64_t offset;
+  int64_t nbytes;
+};
+
+// Fixed header at the start of the segment; an ArenaEntry table follows,
+// then the 64-byte aligned tensor payloads in traversal order.
+struct ArenaHeader {
+  int64_t magic;
+  int64_t count;
+  int64_t total_bytes;
+};
+
+int64_t align_up(int64_t value) {
+  return (value + kArenaAlign - 1) / kArenaAlign * kArenaAlign;
+}
+
+// Tensors in deterministic traversal order -- parameters, then tensor
+// attributes, then submodules depth-first -- identical on the publishing
+// and attaching side as long as both loaded the same module.
+void collect_tensor_slots(
+    jit::script::Module& module,
+    std::vector<jit::script::Slot>& slots) {
+  for (auto slot : module.get_parameters()) {
+    slots.push_back(slot);
+  }
+  for (auto slot : module.get_attributes()) {
+    if (slot.value().isTensor()) {
+      slots.push_back(slot);
+    }
+  }
+  for (const auto& submodule : module.get_modules()) {
+    collect_tensor_slots(*submodule, slots);
+  }
+}
+
+// Repoints `slot` at the arena payload at `payload`, with the shape and
+// dtype of the tensor currently in the slot. The rebound tensor holds a
+// reference to the mapping, so the segment outlives the module.
+void rebind_slot(
+    jit::script::Slot& slot,
+    char* payload,
+    const std::shared_ptr<at::DataPtr>& mapping) {
+  at::Tensor original = slot.value().toTensor();
+  std::shared_ptr<at::DataPtr> keep = mapping;
+  at::Tensor shared = at::from_blob(
+      payload,
+      original.sizes(),
+      [keep](void*) {},
+      original.options());
+  slot.setValue(shared);
+}
+
+} // namespace
+
+std::string publish_module_weights(
+    jit::script::Module& module,
+    const std::string& name) {
+  std::vector<jit::script::Slot> slots;
+  collect_tensor_slots(module, slots);
+
+  // Contiguous, detached copies define the wire layout.
+  std::vector<at::Tensor> tensors;
+  std::vector<ArenaEntry> entries;
+  tensors.reserve(slots.size());
+  entries.reserve(slots.size());
+  int64_t offset = align_up(
+      sizeof(ArenaHeader) + slots.size() * sizeof(ArenaEntry));
+  for (auto& slot : slots) {
+    at::Tensor tensor = slot.value().toTensor();
+    AT_CHECK(
+        tensor.device().is_cpu(),
+        "publish_module_weights only supports CPU modules, got a tensor on ",
+        tensor.device());
+    at::Tensor contig = tensor.detach().contiguous();
+    const int64_t nbytes = contig.numel() * contig.element_size();
+    tensors.push_back(contig);
+    entries.push_back({offset, nbytes});
+    offset = align_up(offset + nbytes);
+  }
+  const int64_t total = offset;
+
+  const int flags =
+      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE;
+  auto mapping = std::make_shared<at::DataPtr>(
+      THManagedMapAllocator::makeDataPtr("", name.c_str(), flags, total));
+  char* base = static_cast<char*>(mapping->get());
+
+  auto* header = reinterpret_cast<ArenaHeader*>(base);
+  header->magic = kArenaMagic;
+  header->count = slots.size();
+  header->total_bytes = total;
+  auto* table = reinterpret_cast<ArenaEntry*>(base + sizeof(ArenaHeader));
+  for (size_t i = 0; i < slots.size(); i++) {
+    table[i] = entries[i];
+    if (entries[i].nbytes > 0) {
+      std::memcpy(
+          base + entries[i].offset, tensors[i].data_ptr(), entries[i].nbytes);
+    }
+    rebind_slot(slots[i], base + entries[i].offset, mapping);
+  }
+
+  return THManagedMapAllocator::fromDataPtr(*mapping)->manager_handle();
+}
+
+void attach_module_weights(
+    jit::script::Module& module,
+    const std::string& manager_handle,
+    const std::string& name) {
+  std::vector<jit::script::Slot> slots;
+  collect_tensor_slots(module, slots);
+
+  const int flags =
+      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE;
+  // Map the header first to learn the full size, then remap.
+  int64_t total;
+  {
+    auto probe = THManagedMapAllocator::makeDataPtr(
+        manager_handle.c_str(), name.c_str(), flags, sizeof(ArenaHeader));
+    auto* header = reinterpret_cast<ArenaHeader*>(probe.get());
+    AT_CHECK(
+        header->magic == kArenaMagic,
+        "shared memory segment '", name, "' is not a weight arena");
+    total = header->total_bytes;
+  }
+  auto mapping = std::make_shared<at::DataPtr>(
+      THManagedMapAllocator::makeDataPtr(
+          manager_handle.c_str(), name.c_str(), flags, total));
+  char* base = static_cast<char*>(mapping->get());
+
+  auto* header = reinterpret_cast<ArenaHeader*>(base);
+  AT_CHECK(
+      header->count == static_cast<int64_t>(slots.size()),
+      "weight arena '", name, "' holds ", header->count,
+      " tensors but the module has ", slots.size(),
+      "; publisher and attacher must load the same model");
+  auto* table = reinterpret_cast<ArenaEntry*>(base + sizeof(ArenaHeader));
+  for (size_t i = 0; i < slots.size(); i++) {
+    at::Tensor original = slots[i].value().toTensor();
+    const int64_t nbytes =
+        original.detach().contiguous().numel() * original.element_size();
+    AT_CHECK(
+        nbytes == table[i].nbytes,
+        "tensor ", i, " in weight arena '", name, "' has ", table[i].nbytes,
+        " bytes but the module expects ", nbytes,
+        "; publisher and attacher must load the same model");
+    rebind_slot(slots[i], base + table[i].offset, mapping);
+  }
+}
+
+} // namespace torch
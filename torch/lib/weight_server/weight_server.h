@@ -0,0 +1,46 @@
+#pragma once
+
+#include <torch/csrc/jit/script/module.h>
+
+#include <string>
+
+// A read-only weight server for multi-process CPU inference: one process
+// publishes a script::Module's parameter and tensor-attribute storages
+// into a single named shared-memory arena registered with the libshm
+// manager, and sibling processes that loaded the same model file attach
+// and repoint their module at the shared pages. N processes then hold one
+// copy of the weights instead of N.
+//
+// The arena is written once by the publisher and must be treated as
+// read-only by everyone afterwards (the mapping itself stays writable
+// because the libshm refcount lives in the segment); mutating an attached
+// parameter in place would silently corrupt every process. Publisher and
+// attachers match tensors by deterministic module-tree traversal order,
+// so both sides must load the same serialized module.
+//
+// Wire-up mirrors ShmTensorQueue: the publisher calls
+// publish_module_weights(module, name) and hands the returned manager
+// handle plus `name` to workers over its own control channel; each worker
+// calls attach_module_weights(module, manager_handle, name) right after
+// torch::jit::load.
+
+namespace torch {
+
+// Copies every parameter and tensor attribute of `module` into the shm
+// arena `name` and repoints `module` at the shared copies, so the
+// publisher itself also serves from the shared pages. `name` must be
+// unique among live segments. Returns the libshm manager handle to send
+// to attaching processes.
+std::string publish_module_weights(
+    jit::script::Module& module,
+    const std::string& name);
+
+// Attaches to an arena published under `name` and repoints `module`'s
+// parameters and tensor attributes at it, dropping this process's
+// private copies.
+void attach_module_weights(
+    jit::script::Module& module,
+    const std::string& manager_handle,
+    const std::string& name);
+
+} // namespace torch